@@ -20,9 +20,11 @@ import clang.*
 import kotlinx.cinterop.*
 import java.io.Closeable
 import java.io.File
+import java.io.IOException
 import java.nio.file.Files
 import java.nio.file.Path
 import java.nio.file.Paths
+import java.nio.file.StandardCopyOption
 import java.security.DigestInputStream
 import java.security.MessageDigest
 
@@ -275,22 +277,88 @@ data class CompilationImpl(
         override val language: Language
 ) : Compilation
 
+private inline fun <R> Compilation.withSerializableTranslationUnit(
+        index: CXIndex,
+        block: (CXTranslationUnit) -> R
+): R {
+    val translationUnit = copyWithArgsForPCH().parse(index, CXTranslationUnit_ForSerialization)
+    return try {
+        translationUnit.ensureNoCompileErrors()
+        block(translationUnit)
+    } finally {
+        clang_disposeTranslationUnit(translationUnit)
+    }
+}
+
 /**
  * Precompiles the headers of this library.
  *
+ * When a PCH cache directory is configured (the `konan.interop.pchCacheDir` system property or the
+ * `KONAN_INTEROP_PCH_CACHE` environment variable), a previously serialized result is reused and the
+ * headers are not parsed at all.
+ *
  * @return the library which includes the precompiled header instead of original ones.
  */
-fun Compilation.precompileHeaders(): CompilationWithPCH = withIndex { index ->
-    val options = CXTranslationUnit_ForSerialization
-    val translationUnit = copyWithArgsForPCH().parse(index, options)
-    try {
-        translationUnit.ensureNoCompileErrors()
-        withPrecompiledHeader(translationUnit)
-    } finally {
-        clang_disposeTranslationUnit(translationUnit)
+fun Compilation.precompileHeaders(): CompilationWithPCH {
+    val cacheDirectory = System.getProperty("konan.interop.pchCacheDir") ?: System.getenv("KONAN_INTEROP_PCH_CACHE")
+    if (cacheDirectory != null) {
+        return precompileHeaders(File(cacheDirectory))
+    }
+    return withIndex { index ->
+        withSerializableTranslationUnit(index) { withPrecompiledHeader(it) }
     }
 }
 
+/**
+ * Precompiles the headers of this library into [cacheDirectory], reusing a previously serialized
+ * result when one exists.
+ *
+ * The cache key covers the clang version, the language, the compiler arguments, the preamble and
+ * the contents of every include that resolves to a file by itself. Headers found through the search
+ * path (e.g. platform headers shipped with a toolchain) are covered indirectly: the toolchain
+ * location is part of the compiler arguments, and shipped headers only change together with it.
+ */
+fun Compilation.precompileHeaders(cacheDirectory: File): CompilationWithPCH {
+    cacheDirectory.mkdirs()
+    val cachedHeader = File(cacheDirectory, "cinterop-${this.pchCacheKey()}.pch")
+    if (!cachedHeader.isFile) {
+        withIndex { index ->
+            withSerializableTranslationUnit(index) { translationUnit ->
+                // Serialize into a temporary and rename, so that concurrent cinterop invocations
+                // never observe a partially written header.
+                val temporary = createTempFile(suffix = ".pch", directory = cacheDirectory)
+                clang_saveTranslationUnit(translationUnit, temporary.absolutePath, 0)
+                try {
+                    Files.move(temporary.toPath(), cachedHeader.toPath(), StandardCopyOption.ATOMIC_MOVE)
+                } catch (e: IOException) {
+                    temporary.delete()
+                    // Another invocation may have won the race; its result is equivalent.
+                    if (!cachedHeader.isFile) throw e
+                }
+            }
+        }
+    }
+    return CompilationWithPCH(this.compilerArgs, cachedHeader.absolutePath, this.language)
+}
+
+private fun Compilation.pchCacheKey(): String {
+    val digest = MessageDigest.getInstance("SHA-256")
+    fun hash(string: String) {
+        digest.update(string.toByteArray())
+        digest.update(0)
+    }
+    hash(clang_getClangVersion().convertAndDispose())
+    hash(language.name)
+    compilerArgs.forEach(::hash)
+    additionalPreambleLines.forEach(::hash)
+    includes.forEach { include ->
+        hash(include)
+        val file = File(include)
+        if (file.isFile) hash(file.sha256())
+    }
+    return digest.digest().toHexString()
+}
+
 internal fun Compilation.withPrecompiledHeader(translationUnit: CXTranslationUnit): CompilationWithPCH {
     val precompiledHeader = createTempFile(suffix = ".pch").apply { this.deleteOnExit() }
     clang_saveTranslationUnit(translationUnit, precompiledHeader.absolutePath, 0)
@@ -671,10 +739,11 @@ fun File.sha256(): String {
         // Read all bytes:
         while (dis.read(buffer, 0, buffer.size) != -1) {}
     }
-    // Convert to hex:
-    return digest.digest().joinToString("") {
-        Integer.toHexString((it.toInt() and 0xff) + 0x100).substring(1)
-    }
+    return digest.digest().toHexString()
+}
+
+internal fun ByteArray.toHexString(): String = this.joinToString("") {
+    Integer.toHexString((it.toInt() and 0xff) + 0x100).substring(1)
 }
 
 fun headerContentsHash(filePath: String) = File(filePath).sha256()
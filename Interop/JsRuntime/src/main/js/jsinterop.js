@@ -79,6 +79,35 @@ konan.libraries.push ({
         var string = toUTF16String(stringPtr, stringLength);
         kotlinObject(arena, obj)[name] = string;
     },
+
+    // Executes a command buffer recorded by kotlinx.wasm.jsinterop.JsBatch with
+    // a single crossing. Opcodes and operand layouts must match jsinterop.kt.
+    Konan_js_dispatchBatch: function (commandsPtr, commandCount) {
+        var env = konan_dependencies.env;
+        var p = commandsPtr;
+        for (var i = 0; i < commandCount; i++) {
+            var op = int32FromHeap(p);
+            switch (op) {
+                case 1: // BATCH_OP_SET_STRING: arena, obj, namePtr, nameLen, stringPtr, stringLen.
+                    env.Konan_js_setString(int32FromHeap(p + 4), int32FromHeap(p + 8),
+                        int32FromHeap(p + 12), int32FromHeap(p + 16),
+                        int32FromHeap(p + 20), int32FromHeap(p + 24));
+                    p += 28;
+                    break;
+                case 2: // BATCH_OP_SET_FUNCTION: arena, obj, namePtr, nameLen, function.
+                    env.Konan_js_setFunction(int32FromHeap(p + 4), int32FromHeap(p + 8),
+                        int32FromHeap(p + 12), int32FromHeap(p + 16), int32FromHeap(p + 20));
+                    p += 24;
+                    break;
+                case 3: // BATCH_OP_PUSH_INT: arena, value.
+                    env.Konan_js_pushIntToArena(int32FromHeap(p + 4), int32FromHeap(p + 8));
+                    p += 12;
+                    break;
+                default:
+                    throw Error("Unknown batch opcode " + op);
+            }
+        }
+    },
 });
 
 // TODO: This is just a shorthand notation.
@@ -140,4 +140,80 @@ fun JsValue.setter(property: String, string: String) {
 object ArenaManager {
     val globalArena = allocateArena()
     var currentArena = globalArena
+}
+
+@RetainForTarget("wasm32")
+@SymbolName("Konan_js_dispatchBatch")
+external public fun dispatchBatch(commandsPtr: Pointer, commandCount: Int)
+
+@RetainForTarget("wasm32")
+@SymbolName("Kotlin_JSInterop_intArrayPointer")
+external public fun intArrayPointer(array: IntArray): Pointer
+
+// Batch command opcodes; must match the decoder in jsinterop.js.
+const val BATCH_OP_SET_STRING = 1
+const val BATCH_OP_SET_FUNCTION = 2
+const val BATCH_OP_PUSH_INT = 3
+
+/**
+ * Records property writes into a linear-memory command buffer and executes them with a single
+ * wasm->JS crossing instead of one import call per operation. String arguments are recorded as
+ * (pointer, length) pairs into their existing UTF-16 backing stores, so nothing is copied per
+ * call; the strings are retained until [flush] to keep those pointers valid.
+ *
+ * Only write operations batch: reads need their result before the next Kotlin statement and
+ * still go through the individual imports. Order a read after the writes it depends on by
+ * calling [flush] first.
+ */
+class JsBatch(capacityCommands: Int = 256) {
+    private val commands = IntArray(capacityCommands * 7)
+    private var size = 0
+    private var count = 0
+    private val retained = arrayListOf<String>()
+
+    private fun ensure(words: Int) {
+        if (size + words > commands.size) flush()
+    }
+
+    fun setString(obj: JsValue, property: String, string: String) {
+        ensure(7)
+        retained.add(property)
+        retained.add(string)
+        commands[size++] = BATCH_OP_SET_STRING
+        commands[size++] = obj.arena
+        commands[size++] = obj.index
+        commands[size++] = stringPointer(property)
+        commands[size++] = stringLengthBytes(property)
+        commands[size++] = stringPointer(string)
+        commands[size++] = stringLengthBytes(string)
+        count++
+    }
+
+    fun setFunction(obj: JsValue, property: String, lambda: KtFunction<Unit>) {
+        ensure(6)
+        retained.add(property)
+        commands[size++] = BATCH_OP_SET_FUNCTION
+        commands[size++] = obj.arena
+        commands[size++] = obj.index
+        commands[size++] = stringPointer(property)
+        commands[size++] = stringLengthBytes(property)
+        commands[size++] = wrapFunction(lambda)
+        count++
+    }
+
+    fun pushInt(arena: Arena, value: Int) {
+        ensure(3)
+        commands[size++] = BATCH_OP_PUSH_INT
+        commands[size++] = arena
+        commands[size++] = value
+        count++
+    }
+
+    fun flush() {
+        if (count == 0) return
+        dispatchBatch(intArrayPointer(commands), count)
+        size = 0
+        count = 0
+        retained.clear()
+    }
 }
\ No newline at end of file
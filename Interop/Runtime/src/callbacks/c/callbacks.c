@@ -134,10 +134,16 @@ JNIEXPORT jlong JNICALL Java_kotlinx_cinterop_JvmCallbacksKt_ffiCreateCif0(JNIEn
 
 static JavaVM *vm = NULL;
 
+// JNIEnv stays valid for as long as the thread remains attached, and threads are attached
+// as daemons and never detached, so the first lookup on a thread is cached in its TLS and
+// every later callback on that thread skips the GetEnv call entirely.
+static __thread JNIEnv* currentEnv = NULL;
+
 // Returns the JNI env which can be used by the caller.
 // If current thread is not attached to JVM, then it gets attached as daemon.
 static JNIEnv* getCurrentEnv() {
-    JNIEnv* env;
+    JNIEnv* env = currentEnv;
+    if (env != NULL) return env;
     assert(vm != NULL);
     jint res = (*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_1);
     if (res != JNI_OK) {
@@ -145,11 +151,22 @@ static JNIEnv* getCurrentEnv() {
         res = (*vm)->AttachCurrentThreadAsDaemon(vm, (void**)&env, NULL);
         assert(res == JNI_OK);
     }
+    currentEnv = env;
     return env;
 }
 
+// Class global ref and method ID used by callback dispatch, resolved once in JNI_OnLoad.
+static jclass longConsumerClass = NULL;
+static jmethodID longConsumerAccept = NULL;
+
+static void initCallbackDispatch(JNIEnv* env);
+
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm_, void *reserved) {
     vm = vm_;
+    JNIEnv* env;
+    if ((*vm_)->GetEnv(vm_, (void**)&env, JNI_VERSION_1_1) == JNI_OK) {
+        initCallbackDispatch(env);
+    }
     return JNI_VERSION_1_1;
 }
 
@@ -161,32 +178,89 @@ static void checkException(JNIEnv *env) {
     }
 }
 
+static void initCallbackDispatch(JNIEnv* env) {
+    // Note: in some cases [FindClass] below may use a classloader different from the one loaded interop classes,
+    // so stick to JVM-provided class:
+    jclass clsLocal = (*env)->FindClass(env, "java/util/function/LongConsumer");
+    checkException(env);
+    assert(clsLocal != NULL);
+
+    longConsumerClass = (jclass) (*env)->NewGlobalRef(env, clsLocal);
+    checkException(env);
+    assert(longConsumerClass != NULL);
+
+    longConsumerAccept = (*env)->GetMethodID(env, longConsumerClass, "accept", "(J)V");
+    checkException(env);
+    assert(longConsumerAccept != NULL);
+}
+
 static void ffi_fun(ffi_cif *cif, void *ret, void **args, void *user_data) {
     JNIEnv* env = getCurrentEnv();
 
-    static jmethodID acceptFun = NULL;
-    static jclass cls = NULL;
-    if (acceptFun == NULL) {
-        // Note: in some cases [FindClass] below may use a classloader different from the one loaded interop classes,
-        // so stick to JVM-provided class:
-        jclass clsLocal = (*env)->FindClass(env, "java/util/function/LongConsumer");
-        checkException(env);
-        assert(clsLocal != NULL);
-
-        cls = (jclass) (*env)->NewGlobalRef(env, clsLocal);
-        checkException(env);
-        assert(cls != NULL);
-
-        acceptFun = (*env)->GetMethodID(env, cls, "accept", "(J)V");
-        checkException(env);
-        assert(acceptFun != NULL);
+    if (longConsumerAccept == NULL) {
+        // JNI_OnLoad could not obtain an env (the library was loaded outside a JVM thread),
+        // resolve on first dispatch instead.
+        initCallbackDispatch(env);
     }
 
     jlong retAndArgs[2] = { (jlong)ret, (jlong)args }; // Unpacked in [ffiClosureImpl].
-    (*env)->CallVoidMethod(env, (jobject) user_data, acceptFun, (jlong)(intptr_t)&retAndArgs[0]);
+    (*env)->CallVoidMethod(env, (jobject) user_data, longConsumerAccept, (jlong)(intptr_t)&retAndArgs[0]);
     checkException(env);
 }
 
+/*
+ * Closures are allocated through a pool: libffi hands out executable closures with an
+ * mmap/mprotect pair per allocation, which dominates callback registration cost. The pool
+ * pre-allocates closures in batches and recycles released ones through a free list, so the
+ * common case is a list pop followed by ffi_prep_closure_loc. A closure can be re-prepared
+ * for any signature, so the pool is shared by all of them.
+ */
+
+#define CLOSURE_POOL_BATCH 16
+#define CLOSURE_REGISTRY_BUCKETS 512
+
+struct PooledClosure {
+    ffi_closure* closure;
+    void* code;
+    jobject userData; // Global ref of the installed callback; NULL while on the free list.
+    struct PooledClosure* next; // Free list or registry chain link.
+};
+
+static struct PooledClosure* closureFreeList = NULL;
+// Maps code addresses of live closures back to their pool entries.
+static struct PooledClosure* closureRegistry[CLOSURE_REGISTRY_BUCKETS];
+static volatile int closurePoolLock = 0;
+
+static void lockClosurePool() {
+    while (__sync_lock_test_and_set(&closurePoolLock, 1)) {}
+}
+
+static void unlockClosurePool() {
+    __sync_lock_release(&closurePoolLock);
+}
+
+static size_t closureRegistryBucket(void* code) {
+    return ((uintptr_t) code >> 4) % CLOSURE_REGISTRY_BUCKETS;
+}
+
+static struct PooledClosure* allocPooledClosure() {
+    void* code;
+    ffi_closure* closure = ffi_closure_alloc(sizeof(ffi_closure), &code);
+    if (closure == NULL) {
+        return NULL;
+    }
+    struct PooledClosure* entry = malloc(sizeof(struct PooledClosure));
+    if (entry == NULL) {
+        ffi_closure_free(closure);
+        return NULL;
+    }
+    entry->closure = closure;
+    entry->code = code;
+    entry->userData = NULL;
+    entry->next = NULL;
+    return entry;
+}
+
 /*
  * Class:     kotlinx_cinterop_JvmCallbacksKt
  * Method:    ffiCreateClosure0
@@ -199,19 +273,88 @@ JNIEXPORT jlong JNICALL Java_kotlinx_cinterop_JvmCallbacksKt_ffiCreateClosure0(J
     }
 
     assert(sizeof(jobject) == sizeof(void*)); // TODO: check statically
-    void* userDataPtr = (void*) userDataGlobalRef;
 
-    void* res;
-    ffi_closure *closure = ffi_closure_alloc(sizeof(ffi_closure), &res);
-    if (closure == NULL) {
-        return (jlong)0;
+    lockClosurePool();
+    struct PooledClosure* entry = closureFreeList;
+    if (entry != NULL) {
+        closureFreeList = entry->next;
     }
-    ffi_status status = ffi_prep_closure_loc(closure, (ffi_cif*)ffiCif, ffi_fun, userDataPtr, res);
+    unlockClosurePool();
+
+    if (entry == NULL) {
+        // Grow by a batch outside the lock, so subsequent registrations are free list pops.
+        entry = allocPooledClosure();
+        if (entry == NULL) {
+            (*env)->DeleteGlobalRef(env, userDataGlobalRef);
+            return (jlong)0;
+        }
+        struct PooledClosure* spares = NULL;
+        for (int i = 1; i < CLOSURE_POOL_BATCH; ++i) {
+            struct PooledClosure* spare = allocPooledClosure();
+            if (spare == NULL) break;
+            spare->next = spares;
+            spares = spare;
+        }
+        if (spares != NULL) {
+            struct PooledClosure* last = spares;
+            while (last->next != NULL) last = last->next;
+            lockClosurePool();
+            last->next = closureFreeList;
+            closureFreeList = spares;
+            unlockClosurePool();
+        }
+    }
+
+    ffi_status status = ffi_prep_closure_loc(entry->closure, (ffi_cif*)ffiCif, ffi_fun, (void*) userDataGlobalRef, entry->code);
     if (status != FFI_OK) {
+        (*env)->DeleteGlobalRef(env, userDataGlobalRef);
+        lockClosurePool();
+        entry->next = closureFreeList;
+        closureFreeList = entry;
+        unlockClosurePool();
         return -(jlong)1;
     }
+    entry->userData = userDataGlobalRef;
 
-    return (jlong) res;
+    lockClosurePool();
+    size_t bucket = closureRegistryBucket(entry->code);
+    entry->next = closureRegistry[bucket];
+    closureRegistry[bucket] = entry;
+    unlockClosurePool();
+
+    return (jlong) entry->code;
+}
+
+/*
+ * Class:     kotlinx_cinterop_JvmCallbacksKt
+ * Method:    ffiFreeClosure0
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_kotlinx_cinterop_JvmCallbacksKt_ffiFreeClosure0(JNIEnv *env, jclass cls, jlong code) {
+    jobject userData = NULL;
+
+    lockClosurePool();
+    struct PooledClosure** link = &closureRegistry[closureRegistryBucket((void*) code)];
+    struct PooledClosure* entry = NULL;
+    while (*link != NULL) {
+        if ((*link)->code == (void*) code) {
+            entry = *link;
+            *link = entry->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+    if (entry != NULL) {
+        userData = entry->userData;
+        entry->userData = NULL;
+        entry->next = closureFreeList;
+        closureFreeList = entry;
+    }
+    unlockClosurePool();
+
+    if (userData != NULL) {
+        (*env)->DeleteGlobalRef(env, userData);
+    }
 }
 
 /*
@@ -399,50 +399,66 @@ private external fun ffiTypePointer(): Long
 
 private external fun ffiTypeStruct0(elements: Long): Long
 
+private val internedStructTypes = ConcurrentHashMap<List<Long>, ffi_type>()
+
 /**
  * Allocates and initializes `ffi_type` describing the struct.
  *
- * @param elements types of the struct elements
+ * The result is interned: equal element lists share one `ffi_type`, which in turn makes
+ * signatures built from the same structs share one prepared cif (see [ffiCreateCif]).
+ *
+ * @param elementTypes types of the struct elements
  */
-private fun ffiTypeStruct(elementTypes: List<ffi_type>): ffi_type {
-    val elements = nativeHeap.allocArrayOfPointersTo(*elementTypes.toTypedArray(), null)
-    val res = ffiTypeStruct0(elements.rawValue)
-    if (res == 0L) {
-        throw OutOfMemoryError()
-    }
-    return interpretPointed(res)
-}
+private fun ffiTypeStruct(elementTypes: List<ffi_type>): ffi_type =
+        internedStructTypes.computeIfAbsent(elementTypes.map { it.rawPtr }) {
+            val elements = nativeHeap.allocArrayOfPointersTo(*elementTypes.toTypedArray(), null)
+            val res = ffiTypeStruct0(elements.rawValue)
+            if (res == 0L) {
+                throw OutOfMemoryError()
+            }
+            interpretPointed<ffi_type>(res)
+        }
 
 private external fun ffiCreateCif0(nArgs: Int, rType: Long, argTypes: Long): Long
 
+private val internedCifs = ConcurrentHashMap<List<Long>, ffi_cif>()
+
 /**
  * Creates and prepares an `ffi_cif`.
  *
+ * The result is interned: signatures with the same return and parameter types share one
+ * prepared cif, so repeated callback registrations don't re-run the libffi ABI classification.
+ *
  * @param returnType native function return value type
  * @param paramTypes native function parameter types
  *
  * @return the initialized `ffi_cif`
  */
-private fun ffiCreateCif(returnType: ffi_type, paramTypes: List<ffi_type>): ffi_cif {
-    val nArgs = paramTypes.size
-    val argTypes = nativeHeap.allocArrayOfPointersTo(*paramTypes.toTypedArray(), null)
-    val res = ffiCreateCif0(nArgs, returnType.rawPtr, argTypes.rawValue)
-
-    when (res) {
-        0L -> throw OutOfMemoryError()
-        -1L -> throw Error("FFI_BAD_TYPEDEF")
-        -2L -> throw Error("FFI_BAD_ABI")
-        -3L -> throw Error("libffi error occurred")
-    }
+private fun ffiCreateCif(returnType: ffi_type, paramTypes: List<ffi_type>): ffi_cif =
+        internedCifs.computeIfAbsent(paramTypes.mapTo(mutableListOf(returnType.rawPtr)) { it.rawPtr }) {
+            val nArgs = paramTypes.size
+            val argTypes = nativeHeap.allocArrayOfPointersTo(*paramTypes.toTypedArray(), null)
+            val res = ffiCreateCif0(nArgs, returnType.rawPtr, argTypes.rawValue)
+
+            when (res) {
+                0L -> throw OutOfMemoryError()
+                -1L -> throw Error("FFI_BAD_TYPEDEF")
+                -2L -> throw Error("FFI_BAD_ABI")
+                -3L -> throw Error("libffi error occurred")
+            }
 
-    return interpretPointed(res)
-}
+            interpretPointed<ffi_cif>(res)
+        }
 
 private external fun ffiCreateClosure0(ffiCif: Long, userData: Any): Long
+private external fun ffiFreeClosure0(code: Long)
 
 /**
  * Uses libffi to allocate a native function which will call [impl] when invoked.
  *
+ * The closure is taken from a pool of pre-allocated executable closures,
+ * so registration is usually a free list pop instead of an mmap.
+ *
  * @param ffiCif describes the type of the function to create
  */
 private fun ffiCreateClosure(ffiCif: ffi_cif, impl: FfiClosureImpl): NativePtr {
@@ -456,6 +472,12 @@ private fun ffiCreateClosure(ffiCif: ffi_cif, impl: FfiClosureImpl): NativePtr {
     return res
 }
 
+/**
+ * Releases a native function created with [ffiCreateClosure], returning its closure to the pool.
+ * The function must not be invoked after this call.
+ */
+internal fun ffiFreeClosure(ptr: NativePtr) = ffiFreeClosure0(ptr)
+
 private external fun newGlobalRef(any: Any): Long
 private external fun derefGlobalRef(ref: Long): Any
 private external fun deleteGlobalRef(ref: Long)
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+package kotlinx.cinterop
+
+import kotlin.native.internal.createCleaner
+
+/**
+ * A runtime-managed off-heap buffer of [size] bytes.
+ *
+ * The storage lives outside the Kotlin heap, so it is never moved or scanned by the
+ * garbage collector and its address can be handed to `read(2)`/`write(2)` without
+ * pinning or copying. Unlike a raw [NativePtr], the buffer knows its length — every
+ * access is bounds-checked — and releases its memory automatically once the buffer
+ * object is collected, via the cleaner machinery.
+ *
+ * The memory is zero-initialized. Accessors read and write in native byte order and
+ * may be unaligned; they compile down to plain loads and stores, with only the bounds
+ * check on top.
+ */
+@OptIn(ExperimentalStdlibApi::class)
+public class DirectByteBuffer(public val size: Long) {
+
+    init {
+        require(size >= 0) { "Buffer size must be non-negative: $size" }
+    }
+
+    @PublishedApi
+    internal val rawPtr: NativePtr = nativeMemUtils.alloc(size, 8).rawPtr
+
+    @Suppress("unused")
+    private val cleaner = createCleaner(rawPtr) { nativeMemUtils.free(it) }
+
+    /**
+     * Returns the address of the byte at [offset], e.g. to pass to C I/O functions.
+     *
+     * The address stays valid only while this buffer is reachable.
+     */
+    public fun addressOf(offset: Long): CPointer<ByteVar> {
+        checkBounds(offset, 1)
+        return interpretCPointer<ByteVar>(rawPtr + offset)!!
+    }
+
+    public inline fun getByte(offset: Long): Byte {
+        checkBounds(offset, 1)
+        return nativeMemUtils.getByte(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putByte(offset: Long, value: Byte) {
+        checkBounds(offset, 1)
+        nativeMemUtils.putByte(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    public inline fun getShort(offset: Long): Short {
+        checkBounds(offset, 2)
+        return nativeMemUtils.getShort(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putShort(offset: Long, value: Short) {
+        checkBounds(offset, 2)
+        nativeMemUtils.putShort(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    public inline fun getInt(offset: Long): Int {
+        checkBounds(offset, 4)
+        return nativeMemUtils.getInt(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putInt(offset: Long, value: Int) {
+        checkBounds(offset, 4)
+        nativeMemUtils.putInt(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    public inline fun getLong(offset: Long): Long {
+        checkBounds(offset, 8)
+        return nativeMemUtils.getLong(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putLong(offset: Long, value: Long) {
+        checkBounds(offset, 8)
+        nativeMemUtils.putLong(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    public inline fun getFloat(offset: Long): Float {
+        checkBounds(offset, 4)
+        return nativeMemUtils.getFloat(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putFloat(offset: Long, value: Float) {
+        checkBounds(offset, 4)
+        nativeMemUtils.putFloat(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    public inline fun getDouble(offset: Long): Double {
+        checkBounds(offset, 8)
+        return nativeMemUtils.getDouble(interpretOpaquePointed(rawPtr + offset))
+    }
+
+    public inline fun putDouble(offset: Long, value: Double) {
+        checkBounds(offset, 8)
+        nativeMemUtils.putDouble(interpretOpaquePointed(rawPtr + offset), value)
+    }
+
+    /**
+     * Copies `endIndex - startIndex` bytes starting at [offset] into `destination[startIndex..]`.
+     */
+    public fun getBytes(offset: Long, destination: ByteArray, startIndex: Int = 0, endIndex: Int = destination.size) {
+        checkCopyBounds(offset, destination.size, startIndex, endIndex)
+        if (startIndex == endIndex) return
+        destination.usePinnedAddress(startIndex) { address ->
+            nativeMemUtils.copyMemory(address.pointed, endIndex - startIndex, interpretOpaquePointed(rawPtr + offset))
+        }
+    }
+
+    /**
+     * Copies `source[startIndex until endIndex]` into this buffer starting at [offset].
+     */
+    public fun putBytes(offset: Long, source: ByteArray, startIndex: Int = 0, endIndex: Int = source.size) {
+        checkCopyBounds(offset, source.size, startIndex, endIndex)
+        if (startIndex == endIndex) return
+        source.usePinnedAddress(startIndex) { address ->
+            nativeMemUtils.copyMemory(interpretOpaquePointed(rawPtr + offset), endIndex - startIndex, address.pointed)
+        }
+    }
+
+    @PublishedApi
+    internal fun checkBounds(offset: Long, accessSize: Int) {
+        if (offset < 0 || offset > size - accessSize)
+            throw IndexOutOfBoundsException("offset: $offset, access size: $accessSize, buffer size: $size")
+    }
+
+    private fun checkCopyBounds(offset: Long, arraySize: Int, startIndex: Int, endIndex: Int) {
+        if (startIndex < 0 || endIndex > arraySize || startIndex > endIndex)
+            throw IndexOutOfBoundsException("startIndex: $startIndex, endIndex: $endIndex, array size: $arraySize")
+        if (offset < 0 || offset > size - (endIndex - startIndex))
+            throw IndexOutOfBoundsException(
+                    "offset: $offset, count: ${endIndex - startIndex}, buffer size: $size")
+    }
+}
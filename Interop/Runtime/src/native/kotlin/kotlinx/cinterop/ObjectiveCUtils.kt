@@ -25,6 +25,57 @@ inline fun <R> autoreleasepool(block: () -> R): R {
     }
 }
 
+/**
+ * Like [autoreleasepool], but for tight Objective-C call loops: the pool is drained and
+ * reopened only every [batchSize] calls to [AutoreleasePoolBatch.next], so the loop pays
+ * pool bookkeeping once per batch instead of once per iteration.
+ *
+ * Objects autoreleased inside the loop stay alive until the drain after at most [batchSize]
+ * further iterations, and at latest until [block] returns.
+ *
+ * ```
+ * autoreleasepoolBatched(1024) { batch ->
+ *     repeat(n) {
+ *         // calls into Objective-C
+ *         batch.next()
+ *     }
+ * }
+ * ```
+ */
+inline fun <R> autoreleasepoolBatched(batchSize: Int, block: (AutoreleasePoolBatch) -> R): R {
+    val batch = AutoreleasePoolBatch(batchSize)
+    return try {
+        block(batch)
+    } finally {
+        batch.close()
+    }
+}
+
+class AutoreleasePoolBatch @PublishedApi internal constructor(private val batchSize: Int) {
+    init {
+        require(batchSize > 0) { "batchSize must be positive: $batchSize" }
+    }
+
+    private var pool: NativePtr = objc_autoreleasePoolPush()
+    private var calls = 0
+
+    /**
+     * Marks the end of one iteration; drains and reopens the pool every [batchSize] calls.
+     */
+    fun next() {
+        if (++calls >= batchSize) {
+            calls = 0
+            objc_autoreleasePoolPop(pool)
+            pool = objc_autoreleasePoolPush()
+        }
+    }
+
+    @PublishedApi
+    internal fun close() {
+        objc_autoreleasePoolPop(pool)
+    }
+}
+
 @Deprecated("Use plain Kotlin cast", ReplaceWith("this as T"), DeprecationLevel.ERROR)
 fun <T : ObjCObject> ObjCObject.reinterpret() = @Suppress("DEPRECATION") this.uncheckedCast<T>()
 
@@ -47,6 +47,23 @@ inline fun <T : Any, R> T.usePinned(block: (Pinned<T>) -> R): R {
 fun Pinned<ByteArray>.addressOf(index: Int): CPointer<ByteVar> = this.get().addressOfElement(index)
 fun ByteArray.refTo(index: Int): CValuesRef<ByteVar> = this.usingPinned { addressOf(index) }
 
+/**
+ * Runs [block] with the address of the [index]-th element of this array, keeping the array
+ * pinned for the duration of the call.
+ *
+ * This is a fast path over [usePinned] + [addressOf] for I/O loops: a single runtime call
+ * takes the pin and returns the element address, and no [Pinned] handle is allocated per
+ * call, so `read(2)`/`write(2)` can target the array's storage directly.
+ */
+inline fun <R> ByteArray.usePinnedAddress(index: Int, block: (CPointer<ByteVar>) -> R): R {
+    val address = pinByteArray(this, index)
+    return try {
+        block(address)
+    } finally {
+        unpinByteArray(this)
+    }
+}
+
 fun Pinned<String>.addressOf(index: Int): CPointer<COpaque> = this.get().addressOfElement(index)
 fun String.refTo(index: Int): CValuesRef<COpaque> = this.usingPinned { addressOf(index) }
 
@@ -95,6 +112,14 @@ private inline fun <T : Any, P : CPointed> T.usingPinned(
 @SymbolName("Kotlin_Arrays_getByteArrayAddressOfElement")
 private external fun ByteArray.addressOfElement(index: Int): CPointer<ByteVar>
 
+@PublishedApi
+@SymbolName("Kotlin_ByteArray_pin")
+internal external fun pinByteArray(array: ByteArray, index: Int): CPointer<ByteVar>
+
+@PublishedApi
+@SymbolName("Kotlin_ByteArray_unpin")
+internal external fun unpinByteArray(array: ByteArray)
+
 @SymbolName("Kotlin_Arrays_getStringAddressOfElement")
 private external fun String.addressOfElement(index: Int): CPointer<COpaque>
 
@@ -244,6 +244,13 @@ class K2NativeCompilerArguments : CommonCompilerArguments() {
     @Argument(value = "-Xcoverage", description = "emit coverage")
     var coverage: Boolean = false
 
+    @Argument(
+            value = "-Xcompact-symbol-table",
+            description = "Link a compact symbol table into the binary, so stripped release builds\n" +
+                    "can symbolize their own Kotlin frames without shipping dSYMs"
+    )
+    var compactSymbolTable: Boolean = false
+
     @Argument(
             value = "-Xlibrary-to-cover",
             valueDescription = "<path>",
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.kotlin.backend.konan
+
+import org.jetbrains.kotlin.konan.exec.Command
+import java.io.ByteArrayOutputStream
+
+/**
+ * Builds the compact on-device symbol table consulted by the runtime's
+ * `AddressToSymbol` (see `runtime/src/main/cpp/ExecFormat.cpp`) and enabled
+ * with `-Xcompact-symbol-table`.
+ *
+ * The function symbols of the freshly linked binary are harvested with
+ * `llvm-nm` and packed into a blob of sorted PC offsets, extents and name
+ * offsets - a few hundred kilobytes even for large applications - which is
+ * assembled into an object file defining `Konan_compactSymtab` and linked in
+ * by a second link pass. All PC values are stored relative to the link-time
+ * address of `AddressToSymbol` itself, so the ASLR slide and any uniform shift
+ * the second link introduces cancel out at lookup time. Unlike dSYMs or native
+ * symbol tables, the blob survives stripping, so release binaries (most
+ * notably iOS ones) symbolize their own Kotlin frames.
+ */
+internal class CompactSymbolTableGenerator(private val context: Context) {
+
+    private val platform = context.config.platform
+    private val isApple = context.config.target.family.isAppleFamily
+
+    private class FunctionSymbol(val address: Long, val name: String)
+
+    private fun readFunctionSymbols(executable: String): List<FunctionSymbol> {
+        val lines = Command("${platform.absoluteLlvmHome}/bin/llvm-nm", "--defined-only", executable)
+                .logWith(context::log)
+                .getOutputLines()
+        val symbols = mutableListOf<FunctionSymbol>()
+        for (line in lines) {
+            // "<address> <type> <name>"; only text symbols are of interest.
+            val parts = line.trim().split(' ', limit = 3)
+            if (parts.size != 3 || (parts[1] != "t" && parts[1] != "T")) continue
+            val address = parts[0].toLongOrNull(16) ?: continue
+            // Mach-O symbol names carry the C underscore prefix; strip it so
+            // reported frames look the same on every target.
+            val name = if (isApple) parts[2].removePrefix("_") else parts[2]
+            if (name.isEmpty()) continue
+            symbols.add(FunctionSymbol(address, name))
+        }
+        return symbols.sortedBy { it.address }
+    }
+
+    /**
+     * Returns an object file defining `Konan_compactSymtab` for [executable],
+     * or null when the table cannot be built.
+     */
+    fun generate(executable: String): ObjectFile? {
+        val symbols = readFunctionSymbols(executable)
+        val anchor = symbols.firstOrNull { it.name == "AddressToSymbol" } ?: return null
+        val codeStart = symbols.first().address
+
+        val starts = mutableListOf<Long>()
+        val sizes = mutableListOf<Long>()
+        val nameOffsets = mutableListOf<Long>()
+        val names = ByteArrayOutputStream()
+        for ((index, symbol) in symbols.withIndex()) {
+            val delta = symbol.address - codeStart
+            if (delta > 0xFFFFFFFFL) break  // Sorted, so the rest is out of range too.
+            // Symbols carry no size on Mach-O; derive each function's extent
+            // from the next function's start, giving the last one a page.
+            val next = symbols.getOrNull(index + 1)
+            val size = (next?.address?.minus(symbol.address) ?: 4096L).coerceIn(0L, 0xFFFFFFFFL)
+            starts.add(delta)
+            sizes.add(size)
+            nameOffsets.add(names.size().toLong())
+            names.write(symbol.name.toByteArray())
+            names.write(0)
+        }
+        if (starts.isEmpty()) return null
+
+        val symbolName = if (isApple) "_Konan_compactSymtab" else "Konan_compactSymtab"
+        val asm = StringBuilder()
+        if (isApple) {
+            asm.appendLine(".section __DATA,__konan_symtab")
+            asm.appendLine(".no_dead_strip $symbolName")
+        } else {
+            asm.appendLine(".section .konan_symtab,\"a\"")
+        }
+        asm.appendLine(".globl $symbolName")
+        asm.appendLine(".p2align 3")
+        asm.appendLine("$symbolName:")
+        // Keep in sync with CompactSymtabHeader in ExecFormat.cpp.
+        asm.appendLine(".long 0x4B53594D")  // "KSYM"
+        asm.appendLine(".long 1")
+        asm.appendLine(".long ${starts.size}")
+        asm.appendLine(".long ${names.size()}")
+        asm.appendLine(".quad ${anchor.address}")
+        asm.appendLine(".quad ${codeStart - anchor.address}")
+        for (list in listOf(starts, sizes, nameOffsets)) {
+            list.forEach { asm.appendLine(".long $it") }
+        }
+        // Symbol names may contain characters unfriendly to .ascii, so emit bytes.
+        names.toByteArray().toList().chunked(16).forEach { chunk ->
+            asm.appendLine(".byte " + chunk.joinToString(",") { (it.toInt() and 0xFF).toString() })
+        }
+
+        val asmFile = context.config.tempFiles.create("compact_symtab", ".s")
+        asmFile.writeLines(listOf(asm.toString()))
+        val objectFile = context.config.tempFiles.create("compact_symtab", ".o").absolutePath
+        Command(platform.clang.clangC("-c", asmFile.absolutePath, "-o", objectFile))
+                .logWith(context::log)
+                .execute()
+        return objectFile
+    }
+}
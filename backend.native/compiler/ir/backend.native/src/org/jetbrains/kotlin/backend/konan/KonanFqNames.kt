@@ -31,4 +31,7 @@ object KonanFqNames {
     val typedIntrinsic = FqName("kotlin.native.internal.TypedIntrinsic")
     val objCMethod = FqName("kotlinx.cinterop.ObjCMethod")
     val hasFinalizer = FqName("kotlin.native.internal.HasFinalizer")
+    val controlFlowException = FqName("kotlin.native.internal.ControlFlowException")
+    val alignedPayload = FqName("kotlin.native.internal.AlignedPayload")
+    val reportsPendingNSError = FqName("kotlin.native.internal.ReportsPendingNSError")
 }
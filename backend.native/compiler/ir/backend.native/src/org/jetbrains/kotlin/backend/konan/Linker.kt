@@ -148,8 +148,8 @@ internal class Linker(val context: Context) {
                     BitcodeEmbedding.getLinkerOptions(context.config) +
                     linkerInput.caches.dynamic +
                     libraryProvidedLinkerFlags + additionalLinkerArgs
-            val finalOutputCommands = linker.finalLinkCommands(
-                    objectFiles = linkerInput.objectFiles,
+            fun finalLinkCommands(objectFiles: List<ObjectFile>) = linker.finalLinkCommands(
+                    objectFiles = objectFiles,
                     executable = executable,
                     libraries = linker.linkStaticLibraries(includedBinaries) + linkerInput.caches.static,
                     linkerArgs = linkerArgs,
@@ -159,10 +159,26 @@ internal class Linker(val context: Context) {
                     outputDsymBundle = context.config.outputFiles.symbolicInfoFile,
                     needsProfileLibrary = needsProfileLibrary,
                     mimallocEnabled = mimallocEnabled)
-            (linkerInput.preLinkCommands + finalOutputCommands).forEach {
+            (linkerInput.preLinkCommands + finalLinkCommands(linkerInput.objectFiles)).forEach {
                 it.logWith(context::log)
                 it.execute()
             }
+            if (config.getBoolean(KonanConfigKeys.COMPACT_SYMBOL_TABLE)
+                    && linkerOutput != LinkerOutputKind.STATIC_LIBRARY) {
+                // Second pass: harvest the symbols of the binary just linked and
+                // relink with the compact table object attached, so stripped
+                // release binaries can symbolize their own Kotlin frames. The
+                // extra object is data-only and does not reorder the text
+                // section; residual uniform shifts cancel in the runtime's
+                // anchor computation (see CompactSymbolTableGenerator).
+                CompactSymbolTableGenerator(context).generate(executable)?.let { tableObject ->
+                    File(executable).delete()
+                    finalLinkCommands(linkerInput.objectFiles + tableObject).forEach {
+                        it.logWith(context::log)
+                        it.execute()
+                    }
+                }
+            }
         } catch (e: KonanExternalToolFailure) {
             val extraUserInfo =
                     if (linkerInput.cachingInvolved)
@@ -956,7 +956,7 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
         }
     }
 
-    fun lookupVirtualImpl(receiver: LLVMValueRef, irFunction: IrFunction): LLVMValueRef {
+    fun lookupVirtualImpl(receiver: LLVMValueRef, irFunction: IrFunction, useCallSiteCache: Boolean = false): LLVMValueRef {
         assert(LLVMTypeOf(receiver) == codegen.kObjHeaderPtr)
 
         val typeInfoPtr: LLVMValueRef = if (irFunction.getObjCMethodInfo() != null)
@@ -990,8 +990,18 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
             else -> {
                 // Essentially: typeInfo.itable[place(interfaceId)].vtable[method]
                 val itablePlace = context.getLayoutBuilder(owner).itablePlace(irFunction)
-                val interfaceTableRecord = lookupInterfaceTableRecord(typeInfoPtr, itablePlace.interfaceId)
-                load(gep(load(structGep(interfaceTableRecord, 2 /* vtable */)), Int32(itablePlace.methodIndex).llvm))
+                if (useCallSiteCache) {
+                    // Monomorphic cache owned by this call site,
+                    // see LookupInterfaceMethodCached in TypeInfo.cpp.
+                    val cache = codegen.staticData.createGlobal(LLVMArrayType(kInt8Ptr, 2)!!, "")
+                    cache.setZeroInitializer()
+                    call(context.llvm.lookupInterfaceMethodCached,
+                            listOf(typeInfoPtr, bitcast(kInt8PtrPtr, cache.llvmGlobal),
+                                    Int32(itablePlace.interfaceId).llvm, Int32(itablePlace.methodIndex).llvm))
+                } else {
+                    val interfaceTableRecord = lookupInterfaceTableRecord(typeInfoPtr, itablePlace.interfaceId)
+                    load(gep(load(structGep(interfaceTableRecord, 2 /* vtable */)), Int32(itablePlace.methodIndex).llvm))
+                }
             }
         }
         val functionPtrType = pointerType(codegen.getLlvmFunctionType(irFunction))
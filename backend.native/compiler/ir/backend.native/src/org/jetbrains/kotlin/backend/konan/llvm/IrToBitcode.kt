@@ -2431,7 +2431,7 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
             initializers.add(it.initializer)
         }
 
-        val ctorFunctions = libraries.map { library ->
+        val ctorFunctions = libraries.mapNotNull { library ->
             val ctorName = if (library != null) {
                 library.moduleConstructorName
             } else {
@@ -2447,20 +2447,34 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
                 val otherInitializers =
                         context.llvm.otherStaticInitializers.takeIf { library == null }.orEmpty()
 
-                appendStaticInitializers(ctorFunction, initializers + otherInitializers)
+                val allInitializers = initializers + otherInitializers
+                appendStaticInitializers(ctorFunction, allInitializers)
+                // A module without initializers still gets its constructor defined
+                // (the symbol may be referenced from other compilations), but there's
+                // no point in calling it at startup.
+                ctorFunction.takeIf { allInitializers.isNotEmpty() }
             } else {
                 check(initializers.isEmpty()) {
                     "found initializer from ${library.libraryFile}, which is not included into compilation"
                 }
+                // Defined in the library's own (cached) module, so its contents aren't
+                // visible here and it has to be called conservatively.
+                ctorFunction
             }
-
-            ctorFunction
         }
 
         appendGlobalCtors(ctorFunctions)
     }
 
     private fun appendStaticInitializers(ctorFunction: LLVMValueRef, initializers: List<LLVMValueRef>) {
+        if (initializers.isEmpty()) {
+            // No work to guard: the caller skips this constructor at startup, and any
+            // external caller gets a plain return without touching a guard variable.
+            generateFunction(codegen, ctorFunction) {
+                ret(null)
+            }
+            return
+        }
         generateFunction(codegen, ctorFunction) {
             val initGuardName = ctorFunction.name.orEmpty() + "_guard"
             val initGuard = LLVMAddGlobal(context.llvmModule, int32Type, initGuardName)
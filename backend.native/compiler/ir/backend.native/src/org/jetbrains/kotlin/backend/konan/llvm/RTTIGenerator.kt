@@ -34,14 +34,26 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
             context.ir.symbols.primitiveArrays.values +
             context.ir.symbols.unsignedArrays.values
 
-    // TODO: extend logic here by taking into account final acyclic classes.
+    // Classes whose acyclicity is currently being computed, to reject type graphs
+    // where a class is reachable from its own fields.
+    private val acyclicInProgress = mutableSetOf<IrClass>()
+
     private fun checkAcyclicFieldType(type: IrType): Boolean = acyclicCache.getOrPut(type) {
         when {
             type.isInterface() -> false
             type.computePrimitiveBinaryTypeOrNull() != null -> true
             else -> {
                 val classifier = type.classifierOrNull
-                (classifier != null && classifier in safeAcyclicFieldTypes)
+                when {
+                    classifier == null -> false
+                    classifier in safeAcyclicFieldTypes -> true
+                    else -> {
+                        // A field of a final class has exactly that dynamic type, so a provably
+                        // acyclic layout of the field's class makes the field acyclic as well.
+                        val fieldClass = classifier.owner as? IrClass
+                        fieldClass != null && fieldClass.isFinalClass && checkAcyclicClass(fieldClass)
+                    }
+                }
             }
         }
     }
@@ -49,8 +61,13 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
     private fun checkAcyclicClass(irClass: IrClass): Boolean = when {
         irClass.symbol == context.ir.symbols.array -> false
         irClass.isArray -> true
-        context.getLayoutBuilder(irClass).fields.all { checkAcyclicFieldType(it.type) } -> true
-        else -> false
+        irClass in acyclicInProgress -> false
+        else -> {
+            acyclicInProgress.add(irClass)
+            val result = context.getLayoutBuilder(irClass).fields.all { checkAcyclicFieldType(it.type) }
+            acyclicInProgress.remove(irClass)
+            result
+        }
     }
 
     private fun flagsFromClass(irClass: IrClass): Int {
@@ -77,6 +94,14 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
             result = result or TF_HAS_FINALIZER
         }
 
+        if (irClass.hasAnnotation(KonanFqNames.controlFlowException)) {
+            result = result or TF_CONTROL_FLOW_EXCEPTION
+        }
+
+        if (irClass.hasAnnotation(KonanFqNames.alignedPayload)) {
+            result = result or TF_ALIGNED_PAYLOAD
+        }
+
         return result
     }
 
@@ -450,6 +475,17 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
             Int32(0)
     }
 
+    // Extended RTTI is only dereferenced on reflective access and debugger queries,
+    // so it goes into its own section: hot TypeInfo pages are not interleaved with
+    // cold metadata, and the section stays unmapped until first use.
+    private val extendedTypeInfoSection =
+            if (context.config.target.family.isAppleFamily) "__TEXT,__kextrtti" else ".kextrtti"
+
+    private fun ConstPointer.placedInExtendedInfoSection(): ConstPointer {
+        (this as? StaticData.Pointer)?.global?.setSection(extendedTypeInfoSection)
+        return this
+    }
+
     private fun makeExtendedInfo(irClass: IrClass): ConstPointer {
         // TODO: shall we actually do that?
         if (context.shouldOptimize())
@@ -476,11 +512,12 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
                         context.getLayoutBuilder(irClass).fields[index].name.asString())
             }
             val offsetsPtr = staticData.placeGlobalConstArray("kextoff:$className", int32Type,
-                    fields.map { Int32(it.offset) })
+                    fields.map { Int32(it.offset) }).placedInExtendedInfoSection()
             val typesPtr = staticData.placeGlobalConstArray("kexttype:$className", int8Type,
-                    fields.map { Int8(it.type.toByte()) })
+                    fields.map { Int8(it.type.toByte()) }).placedInExtendedInfoSection()
             val namesPtr = staticData.placeGlobalConstArray("kextname:$className", kInt8Ptr,
-                    fields.map { staticData.placeCStringLiteral(it.name) })
+                    fields.map { staticData.placeCStringLiteral(it.name).placedInExtendedInfoSection() })
+                    .placedInExtendedInfoSection()
 
             Struct(runtime.extendedTypeInfoType, Int32(fields.size), offsetsPtr, typesPtr, namesPtr,
                     debugOperationsSize, debugOperations)
@@ -488,6 +525,7 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
         }
         val result = staticData.placeGlobal("", value)
         result.setConstant(true)
+        result.setSection(extendedTypeInfoSection)
         return result.pointer
     }
 
@@ -640,4 +678,6 @@ private const val TF_OBJC_DYNAMIC = 8
 private const val TF_LEAK_DETECTOR_CANDIDATE = 16
 private const val TF_SUSPEND_FUNCTION = 32
 private const val TF_HAS_FINALIZER = 64
+private const val TF_CONTROL_FLOW_EXCEPTION = 128
+private const val TF_ALIGNED_PAYLOAD = 512
 
@@ -28,6 +28,7 @@ import org.jetbrains.kotlin.ir.types.*
 import org.jetbrains.kotlin.ir.util.*
 import org.jetbrains.kotlin.konan.target.Family
 import org.jetbrains.kotlin.konan.target.KonanTarget
+import org.jetbrains.kotlin.konan.util.buildPerfectHash
 import org.jetbrains.kotlin.name.Name
 
 internal fun TypeBridge.makeNothing() = when (this) {
@@ -303,9 +304,8 @@ internal class ObjCExportCodeGenerator(
         }
 
         fun emitSortedAdapters(nameToAdapter: Map<String, ConstPointer>, prefix: String) {
-            val sortedAdapters = nameToAdapter.toList().sortedBy { it.first }.map {
-                it.second
-            }
+            val sortedNames = nameToAdapter.keys.sorted()
+            val sortedAdapters = sortedNames.map { nameToAdapter.getValue(it) }
 
             if (sortedAdapters.isNotEmpty()) {
                 val type = sortedAdapters.first().llvmType
@@ -315,6 +315,44 @@ internal class ObjCExportCodeGenerator(
                 val origin = context.standardLlvmSymbolsOrigin
                 replaceExternalWeakOrCommonGlobal(prefix, sortedAdaptersPointer, origin)
                 replaceExternalWeakOrCommonGlobal("${prefix}Num", Int32(sortedAdapters.size), origin)
+
+                // Precomputed hash index over the names: hashes sorted ascending (as unsigned),
+                // with a parallel array mapping each hash back to its position in the name-sorted
+                // adapter array. Lets the runtime find adapters by integer comparisons instead of
+                // a strcmp binary search; see findAdapterByName in ObjCExport.mm.
+                val hashOrder = sortedNames.withIndex()
+                        .sortedWith(compareBy({ adapterNameHash(it.value).toLong() and 0xFFFFFFFFL }, { it.index }))
+                replaceExternalWeakOrCommonGlobal(
+                        "${prefix}NameHashes",
+                        staticData.placeGlobalConstArray("", int32Type, hashOrder.map { Int32(adapterNameHash(it.value)) }),
+                        origin
+                )
+                replaceExternalWeakOrCommonGlobal(
+                        "${prefix}HashIndices",
+                        staticData.placeGlobalConstArray("", int32Type, hashOrder.map { Int32(it.index) }),
+                        origin
+                )
+
+                // CHD perfect hash over the same names: one displacement read, one slot read
+                // and a single strcmp per lookup, no probing. Built over 64-bit hashes whose
+                // halves serve as independent position and displacement step; in the unlikely
+                // case the table cannot be built the globals stay unset and the runtime falls
+                // back to the sorted-hash index above.
+                val perfectHash = buildPerfectHash(LongArray(sortedNames.size) { adapterNameHash64(sortedNames[it]) })
+                if (perfectHash != null) {
+                    replaceExternalWeakOrCommonGlobal(
+                            "${prefix}PhBucketsNum", Int32(perfectHash.displacements.size), origin)
+                    replaceExternalWeakOrCommonGlobal(
+                            "${prefix}PhDisplacements",
+                            staticData.placeGlobalConstArray("", int32Type, perfectHash.displacements.map { Int32(it) }),
+                            origin
+                    )
+                    replaceExternalWeakOrCommonGlobal(
+                            "${prefix}PhIndices",
+                            staticData.placeGlobalConstArray("", int32Type, perfectHash.slotToKey.map { Int32(it) }),
+                            origin
+                    )
+                }
             }
         }
 
@@ -330,6 +368,24 @@ internal class ObjCExportCodeGenerator(
         }
     }
 
+    // Must produce exactly the same values as adapterNameHash in ObjCExport.mm (32-bit FNV-1a).
+    private fun adapterNameHash(name: String): Int {
+        var hash = 0x811C9DC5.toInt()
+        for (byte in name.toByteArray()) {
+            hash = (hash xor (byte.toInt() and 0xFF)) * 16777619
+        }
+        return hash
+    }
+
+    // Must produce exactly the same values as adapterNameHash64 in ObjCExport.mm (64-bit FNV-1a).
+    private fun adapterNameHash64(name: String): Long {
+        var hash = -3750763034362895579L // 0xcbf29ce484222325, the FNV-1a offset basis.
+        for (byte in name.toByteArray()) {
+            hash = (hash xor (byte.toLong() and 0xFF)) * 1099511628211L
+        }
+        return hash
+    }
+
     private fun emitStaticInitializers() {
         if (externalGlobalInitializers.isEmpty()) return
 
@@ -736,7 +792,9 @@ private fun ObjCExportCodeGenerator.generateObjCImp(
         val llvmTarget = if (!isVirtual) {
             codegen.llvmFunction(target)
         } else {
-            lookupVirtualImpl(args.first(), target)
+            // Each virtual adapter is effectively its own call site, and Objective-C clients tend
+            // to call it on one concrete class, so let the lookup cache the resolved entry point.
+            lookupVirtualImpl(args.first(), target, useCallSiteCache = true)
         }
 
         call(llvmTarget, args, resultLifetime, exceptionHandler)
@@ -844,6 +902,33 @@ private fun ObjCExportCodeGenerator.generateObjCImp(
 
     val targetResult = callKotlin(kotlinArgs, Lifetime.ARGUMENT, exceptionHandler)
 
+    if (errorOutPtr != null && baseMethod?.hasAnnotation(KonanFqNames.reportsPendingNSError) == true) {
+        // The callee may have recorded an expected failure instead of throwing;
+        // hand it to the caller through the NSError out-parameter.
+        val pending = callFromBridge(
+                context.llvm.Kotlin_ObjCExport_takePendingNSError,
+                listOf(errorOutPtr!!)
+        )
+        ifThen(icmpNe(pending, Int8(0).llvm)) {
+            val returnValue = when (returnType) {
+                !is MethodBridge.ReturnValue.WithError ->
+                    error("bridge with error parameter has unexpected return type: $returnType")
+
+                MethodBridge.ReturnValue.WithError.Success -> Int8(0).llvm // false
+
+                is MethodBridge.ReturnValue.WithError.ZeroForError -> {
+                    if (returnType.successBridge == MethodBridge.ReturnValue.Instance.InitResult) {
+                        // Release init receiver, as required by convention.
+                        callFromBridge(objcRelease, listOf(param(0)))
+                    }
+                    Zero(returnType.objCType(context)).llvm
+                }
+            }
+
+            ret(returnValue)
+        }
+    }
+
     tailrec fun genReturnValueOnSuccess(returnBridge: MethodBridge.ReturnValue): LLVMValueRef? = when (returnBridge) {
         MethodBridge.ReturnValue.Void -> null
         MethodBridge.ReturnValue.HashCode -> {
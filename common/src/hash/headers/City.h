@@ -28,6 +28,13 @@ extern "C" {
 // Hash function for a byte array.
 uint64_t CityHash64(const void* buf, size_t len);
 
+// Fast 64-bit hash for transient, in-process use only (e.g. hash tables that live
+// within one compiler invocation). On x86-64 it uses the hardware CRC32 instruction
+// when the CPU has it, so the value differs between machines and between runs of
+// the dispatch check; it must never be persisted into artifacts. Falls back to
+// CityHash64 elsewhere.
+uint64_t CityHashCrc64(const void* buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,8 @@ typedef struct SHA1_CTX {
 
 void SHA1Init(SHA1_CTX* context);
 void SHA1Update(SHA1_CTX* context, const unsigned char* data, uint32_t len);
+/* SHA1Update for buffers bigger than 4GB-1; chunks the data internally. */
+void SHA1UpdateLarge(SHA1_CTX* context, const unsigned char* data, uint64_t len);
 void SHA1Final(unsigned char digest[20], SHA1_CTX* context);
 
 #ifdef __cplusplus
@@ -21,6 +21,7 @@
 #include <llvm/Transforms/Instrumentation.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
+#include <algorithm>
 #include <utility>
 #include <string>
 #include <vector>
@@ -175,17 +176,8 @@ static std::string createRawCoverageMapping(struct LLVMFunctionCoverage **functi
     return llvm::join(coverageMappings.begin(), coverageMappings.end(), "");
 }
 
-LLVMValueRef LLVMCoverageEmit(LLVMModuleRef moduleRef,
-        LLVMValueRef *records, size_t recordsSize,
-        const char **filenames, int *filenamesIndices, size_t filenamesSize,
-        struct LLVMFunctionCoverage **functionCoverages, size_t functionCoveragesSize) {
-    LLVMContext &ctx = *unwrap(LLVMGetModuleContext(moduleRef));
-    Module &module = *unwrap(moduleRef);
-
-    std::vector<Constant *> functionRecords;
-    for (size_t i = 0; i < recordsSize; ++i) {
-        functionRecords.push_back(dyn_cast<Constant>(unwrap(records[i])));
-    }
+static llvm::SmallVector<StringRef, 16> resolveFilenameRefs(
+        const char **filenames, int *filenamesIndices, size_t filenamesSize) {
     llvm::SmallVector<StringRef, 16> filenameRefs;
     filenameRefs.resize(filenamesSize);
     for (size_t i = 0; i < filenamesSize; ++i) {
@@ -198,6 +190,21 @@ LLVMValueRef LLVMCoverageEmit(LLVMModuleRef moduleRef,
             filenameRefs[filenamesIndices[i]] = path;
         }
     }
+    return filenameRefs;
+}
+
+LLVMValueRef LLVMCoverageEmit(LLVMModuleRef moduleRef,
+        LLVMValueRef *records, size_t recordsSize,
+        const char **filenames, int *filenamesIndices, size_t filenamesSize,
+        struct LLVMFunctionCoverage **functionCoverages, size_t functionCoveragesSize) {
+    LLVMContext &ctx = *unwrap(LLVMGetModuleContext(moduleRef));
+    Module &module = *unwrap(moduleRef);
+
+    std::vector<Constant *> functionRecords;
+    for (size_t i = 0; i < recordsSize; ++i) {
+        functionRecords.push_back(dyn_cast<Constant>(unwrap(records[i])));
+    }
+    llvm::SmallVector<StringRef, 16> filenameRefs = resolveFilenameRefs(filenames, filenamesIndices, filenamesSize);
     const std::string &rawCoverageMappings = createRawCoverageMapping(functionCoverages, functionCoveragesSize);
     GlobalVariable *coverageGlobal = emitCoverageGlobal(ctx, module, functionRecords, filenameRefs, rawCoverageMappings);
 
@@ -207,6 +214,100 @@ LLVMValueRef LLVMCoverageEmit(LLVMModuleRef moduleRef,
     return wrap(coverageGlobal);
 }
 
+struct LLVMCoverageAccumulator {
+    struct FunctionInfo {
+        std::string name;
+        uint64_t hash;
+        size_t mappingOffset;
+        size_t mappingSize;
+    };
+    std::vector<FunctionInfo> functions;
+    // All encoded per-function mappings, concatenated in insertion order.
+    std::string rawCoverageMappings;
+};
+
+struct LLVMCoverageAccumulator* LLVMCoverageAccumulatorCreate(void) {
+    // Should be disposed with `LLVMCoverageAccumulatorDispose`.
+    return new LLVMCoverageAccumulator();
+}
+
+// Collapse identical regions and directly adjacent regions that share the same
+// counter, so that straight-line code split over many regions encodes as one.
+static std::vector<coverage::CounterMappingRegion> mergeCounterMappingRegions(
+        std::vector<coverage::CounterMappingRegion> regions) {
+    std::stable_sort(regions.begin(), regions.end(),
+            [](const coverage::CounterMappingRegion &lhs, const coverage::CounterMappingRegion &rhs) {
+                if (lhs.FileID != rhs.FileID) return lhs.FileID < rhs.FileID;
+                return lhs.startLoc() < rhs.startLoc();
+            });
+    std::vector<coverage::CounterMappingRegion> merged;
+    for (const auto &region : regions) {
+        if (!merged.empty()) {
+            auto &last = merged.back();
+            bool sameCounter = last.Kind == region.Kind && last.FileID == region.FileID
+                    && last.ExpandedFileID == region.ExpandedFileID && last.Count == region.Count;
+            if (sameCounter && last.startLoc() == region.startLoc() && last.endLoc() == region.endLoc()) {
+                continue;
+            }
+            if (sameCounter && region.Kind == coverage::CounterMappingRegion::RegionKind::CodeRegion
+                    && last.endLoc() == region.startLoc()) {
+                last.LineEnd = region.LineEnd;
+                last.ColumnEnd = region.ColumnEnd;
+                continue;
+            }
+        }
+        merged.push_back(region);
+    }
+    return merged;
+}
+
+void LLVMCoverageAccumulatorAddFunction(struct LLVMCoverageAccumulator* accumulator,
+        const char *name, uint64_t hash,
+        unsigned int *fileIdMapping, size_t fileIdMappingSize,
+        struct LLVMCoverageRegion **mappingRegions, size_t mappingRegionsSize) {
+    std::vector<coverage::CounterMappingRegion> counterMappingRegions;
+    for (size_t i = 0; i < mappingRegionsSize; ++i) {
+        struct LLVMCoverageRegion region = *mappingRegions[i];
+        counterMappingRegions.emplace_back(createCounterMappingRegion(region));
+    }
+    counterMappingRegions = mergeCounterMappingRegions(std::move(counterMappingRegions));
+    CoverageMappingWriter writer(ArrayRef<unsigned int>(fileIdMapping, fileIdMappingSize), None, counterMappingRegions);
+    size_t offset = accumulator->rawCoverageMappings.size();
+    raw_string_ostream OS(accumulator->rawCoverageMappings);
+    writer.write(OS);
+    OS.flush();
+    accumulator->functions.push_back(
+            {name, hash, offset, accumulator->rawCoverageMappings.size() - offset});
+}
+
+LLVMValueRef LLVMCoverageAccumulatorEmit(struct LLVMCoverageAccumulator* accumulator,
+        LLVMModuleRef moduleRef,
+        const char **filenames, int *filenamesIndices, size_t filenamesSize) {
+    LLVMContext &ctx = *unwrap(LLVMGetModuleContext(moduleRef));
+    Module &module = *unwrap(moduleRef);
+
+    std::vector<Constant *> functionRecords;
+    for (const auto &function : accumulator->functions) {
+        // The record only needs the size of this function's mapping, but hand it
+        // the function's own slice to keep that an implementation detail of InstrProfData.inc.
+        std::string coverageMapping =
+                accumulator->rawCoverageMappings.substr(function.mappingOffset, function.mappingSize);
+        functionRecords.push_back(addFunctionMappingRecord(ctx, function.name, function.hash, coverageMapping));
+    }
+    llvm::SmallVector<StringRef, 16> filenameRefs = resolveFilenameRefs(filenames, filenamesIndices, filenamesSize);
+    GlobalVariable *coverageGlobal =
+            emitCoverageGlobal(ctx, module, functionRecords, filenameRefs, accumulator->rawCoverageMappings);
+
+    const std::string &section = getInstrProfSectionName(IPSK_covmap, Triple(module.getTargetTriple()).getObjectFormat());
+    coverageGlobal->setSection(section);
+    coverageGlobal->setAlignment(8);
+    return wrap(coverageGlobal);
+}
+
+void LLVMCoverageAccumulatorDispose(struct LLVMCoverageAccumulator* accumulator) {
+    delete accumulator;
+}
+
 LLVMValueRef LLVMInstrProfIncrement(LLVMModuleRef moduleRef) {
     Module &module = *unwrap(moduleRef);
     return wrap(Intrinsic::getDeclaration(&module, Intrinsic::instrprof_increment, None));
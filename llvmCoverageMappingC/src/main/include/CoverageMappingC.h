@@ -60,6 +60,37 @@ LLVMValueRef LLVMCoverageEmit(LLVMModuleRef moduleRef, LLVMValueRef *records, si
         const char **filenames, int *filenamesIndices, size_t filenamesSize,
         struct LLVMFunctionCoverage** functionCoverages, size_t functionCoveragesSize);
 
+struct LLVMCoverageAccumulator;
+
+/**
+ * Streaming alternative to the LLVMWriteCoverageRegionMapping/LLVMCoverageEmit pair.
+ *
+ * Functions are fed one batch of regions at a time; each batch is merged
+ * (identical and directly adjacent regions with the same counter collapse into
+ * one) and encoded immediately, so the accumulator keeps only the per-function
+ * record metadata and the already-encoded bytes, never the whole module's
+ * region lists.
+ */
+struct LLVMCoverageAccumulator* LLVMCoverageAccumulatorCreate(void);
+
+/**
+ * Encode the regions of one function and append its record. The region array
+ * can be released by the caller as soon as the call returns.
+ */
+void LLVMCoverageAccumulatorAddFunction(struct LLVMCoverageAccumulator* accumulator,
+        const char *name, uint64_t hash,
+        unsigned int *fileIdMapping, size_t fileIdMappingSize,
+        struct LLVMCoverageRegion **mappingRegions, size_t mappingRegionsSize);
+
+/**
+ * Create the __llvm_coverage_mapping global from everything accumulated.
+ */
+LLVMValueRef LLVMCoverageAccumulatorEmit(struct LLVMCoverageAccumulator* accumulator,
+        LLVMModuleRef moduleRef,
+        const char **filenames, int *filenamesIndices, size_t filenamesSize);
+
+void LLVMCoverageAccumulatorDispose(struct LLVMCoverageAccumulator* accumulator);
+
 /**
  * Wrapper for `llvm.instrprof.increment` declaration.
  */
@@ -245,6 +245,78 @@ DIExpressionRef DICreateEmptyExpression(DIBuilderRef builder) {
   return llvm::wrap(llvm::unwrap(builder)->createExpression());
 }
 
+void DICreateFunctions(DIBuilderRef builderRef, const char* stringPool,
+                       const DIFunctionDescriptor* descriptors, uint64_t count,
+                       DISubprogramRef* results) {
+  auto builder = llvm::unwrap(builderRef);
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto& d = descriptors[i];
+    auto subprogram = builder->createFunction(llvm::unwrap(d.scope),
+                                              stringPool + d.nameOffset,
+                                              stringPool + d.linkageNameOffset,
+                                              llvm::unwrap(d.file),
+                                              d.lineNo,
+                                              llvm::unwrap(d.type),
+                                              d.scopeLine, llvm::DINode::DIFlags::FlagZero, llvm::DISubprogram::toSPFlags(false, true, false));
+    auto tmp = subprogram->getRetainedNodes().get();
+    if (!tmp && tmp->isTemporary())
+      llvm::MDTuple::deleteTemporary(tmp);
+
+    builder->finalizeSubprogram(subprogram);
+    results[i] = llvm::wrap(subprogram);
+  }
+}
+
+void DICreateMemberTypes(DIBuilderRef builderRef, const char* stringPool,
+                         const DIMemberTypeDescriptor* descriptors, uint64_t count,
+                         DIDerivedTypeRef* results) {
+  auto builder = llvm::unwrap(builderRef);
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto& d = descriptors[i];
+    results[i] = llvm::wrap(builder->createMemberType(
+                              llvm::unwrap(d.scope),
+                              stringPool + d.nameOffset,
+                              llvm::unwrap(d.file),
+                              d.lineNum,
+                              d.sizeInBits,
+                              d.alignInBits,
+                              d.offsetInBits,
+                              (llvm::DINode::DIFlags)d.flags,
+                              llvm::unwrap(d.type)));
+  }
+}
+
+void DICreateAutoVariables(DIBuilderRef builderRef, const char* stringPool,
+                           const DILocalVariableDescriptor* descriptors, uint64_t count,
+                           DILocalVariableRef* results) {
+  auto builder = llvm::unwrap(builderRef);
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto& d = descriptors[i];
+    results[i] = llvm::wrap(builder->createAutoVariable(
+      llvm::unwrap(d.scope),
+      stringPool + d.nameOffset,
+      llvm::unwrap(d.file),
+      d.line,
+      llvm::unwrap(d.type)));
+  }
+}
+
+void DICreateParameterVariables(DIBuilderRef builderRef, const char* stringPool,
+                                const DILocalVariableDescriptor* descriptors, uint64_t count,
+                                DILocalVariableRef* results) {
+  auto builder = llvm::unwrap(builderRef);
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto& d = descriptors[i];
+    results[i] = llvm::wrap(builder->createParameterVariable(
+      llvm::unwrap(d.scope),
+      stringPool + d.nameOffset,
+      d.argNo,
+      llvm::unwrap(d.file),
+      d.line,
+      llvm::unwrap(d.type)));
+  }
+}
+
 void DIInsertDeclaration(DIBuilderRef builder, LLVMValueRef value, DILocalVariableRef localVariable, DILocationRef location, LLVMBasicBlockRef bb, int64_t *expr, uint64_t exprCount) {
   auto di_builder = llvm::unwrap(builder);
   std::vector<int64_t> expression;
@@ -99,6 +99,59 @@ DISubroutineTypeRef DICreateSubroutineType(DIBuilderRef builder,
 
 DILocalVariableRef DICreateAutoVariable(DIBuilderRef builder, DIScopeOpaqueRef scope, const char *name, DIFileRef file, unsigned line, DITypeOpaqueRef type);
 DILocalVariableRef DICreateParameterVariable(DIBuilderRef builder, DIScopeOpaqueRef scope, const char *name, unsigned argNo, DIFileRef file, unsigned line, DITypeOpaqueRef type);
+
+/**
+ * Batched node creation: one call creates `count` nodes from an array of
+ * descriptors, instead of one boundary crossing per node. Names are passed as
+ * byte offsets of NUL-terminated strings in a caller-built string pool, so a
+ * batch marshals a single char buffer rather than one `const char*` each.
+ * Results are written to the positionally matching slot of `results`.
+ */
+typedef struct {
+  DIScopeOpaqueRef scope;
+  uint32_t nameOffset;
+  uint32_t linkageNameOffset;
+  DIFileRef file;
+  unsigned lineNo;
+  DISubroutineTypeRef type;
+  int isLocal;
+  int isDefinition;
+  unsigned scopeLine;
+} DIFunctionDescriptor;
+
+typedef struct {
+  DIScopeOpaqueRef scope;
+  uint32_t nameOffset;
+  DIFileRef file;
+  unsigned lineNum;
+  uint64_t sizeInBits;
+  uint64_t alignInBits;
+  uint64_t offsetInBits;
+  unsigned flags;
+  DITypeOpaqueRef type;
+} DIMemberTypeDescriptor;
+
+typedef struct {
+  DIScopeOpaqueRef scope;
+  uint32_t nameOffset;
+  unsigned argNo; /* ignored for auto variables */
+  DIFileRef file;
+  unsigned line;
+  DITypeOpaqueRef type;
+} DILocalVariableDescriptor;
+
+void DICreateFunctions(DIBuilderRef builder, const char* stringPool,
+                       const DIFunctionDescriptor* descriptors, uint64_t count,
+                       DISubprogramRef* results);
+void DICreateMemberTypes(DIBuilderRef builder, const char* stringPool,
+                         const DIMemberTypeDescriptor* descriptors, uint64_t count,
+                         DIDerivedTypeRef* results);
+void DICreateAutoVariables(DIBuilderRef builder, const char* stringPool,
+                           const DILocalVariableDescriptor* descriptors, uint64_t count,
+                           DILocalVariableRef* results);
+void DICreateParameterVariables(DIBuilderRef builder, const char* stringPool,
+                                const DILocalVariableDescriptor* descriptors, uint64_t count,
+                                DILocalVariableRef* results);
 void DIInsertDeclaration(DIBuilderRef builder, LLVMValueRef value, DILocalVariableRef localVariable, DILocationRef location, LLVMBasicBlockRef bb, int64_t *expr, uint64_t exprCount);
 DIExpressionRef DICreateEmptyExpression(DIBuilderRef builder);
 void DIFunctionAddSubprogram(LLVMValueRef fn, DISubprogramRef sp);
@@ -0,0 +1,13 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. and Kotlin Programming Language contributors.
+ * Use of this source code is governed by the Apache 2.0 license that can be found in the licenses/LICENSE.txt file.
+ */
+
+import org.jetbrains.benchmarksLauncher.*
+
+actual class MemoryManagerLauncher : Launcher() {
+    // The scenarios target Kotlin/Native memory management specifics (freezing,
+    // worker transfer, deterministic deallocation, GC pause logging) and have
+    // no meaningful JVM counterpart.
+    override val benchmarks = BenchmarksCollection(mutableMapOf())
+}
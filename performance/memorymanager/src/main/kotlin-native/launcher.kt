@@ -0,0 +1,170 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. and Kotlin Programming Language contributors.
+ * Use of this source code is governed by the Apache 2.0 license that can be found in the licenses/LICENSE.txt file.
+ */
+
+import org.jetbrains.benchmarksLauncher.*
+import kotlin.native.concurrent.*
+import kotlin.native.ref.WeakReference
+import kotlin.native.internal.GC
+
+actual class MemoryManagerLauncher : Launcher() {
+    override val benchmarks = BenchmarksCollection(
+            mutableMapOf(
+                    "BurstAllocation" to BenchmarkEntry(::burstAllocation),
+                    "FreezeLargeGraph" to BenchmarkEntry(::freezeLargeGraph),
+                    "CrossWorkerTransfer" to BenchmarkEntry(::crossWorkerTransfer),
+                    "WeakReferenceChurn" to BenchmarkEntry(::weakReferenceChurn),
+                    "SteadyLoadGCPauses" to BenchmarkEntry(::steadyLoadGCPauses)
+            )
+    )
+}
+
+private class Node(var value: Int) {
+    var next: Node? = null
+    var payload: IntArray? = null
+}
+
+// Allocates bursts of short-lived linked objects with occasional array payloads,
+// stressing the allocation fast path and immediate reference-counted reclamation.
+fun burstAllocation() {
+    for (burst in 0 until 64) {
+        var head: Node? = null
+        for (i in 0 until 256) {
+            val node = Node(i)
+            if (i % 16 == 0) node.payload = IntArray(128)
+            node.next = head
+            head = node
+        }
+        Blackhole.consume(head!!.value)
+    }
+}
+
+// Builds a linked graph of ~10k nodes and freezes it through a single root,
+// measuring the recursive freeze traversal on a large subgraph.
+fun freezeLargeGraph() {
+    val nodes = ArrayList<Node>(10_000)
+    for (i in 0 until 10_000) {
+        nodes.add(Node(i))
+    }
+    for (i in 1 until nodes.size) {
+        nodes[i - 1].next = nodes[i]
+    }
+    nodes.freeze()
+    Blackhole.consume(nodes.size)
+}
+
+// Round-trips object graphs to a worker and back with TransferMode.SAFE,
+// measuring detach/attach of subgraphs plus the result transfer.
+fun crossWorkerTransfer() {
+    val worker = Worker.start()
+    var transferred = 0
+    for (round in 0 until 100) {
+        val future = worker.execute(TransferMode.SAFE, { IntArray(1024) { it } }) { array ->
+            var sum = 0
+            for (element in array) sum += element
+            sum
+        }
+        transferred += future.result
+    }
+    worker.requestTermination().result
+    Blackhole.consume(transferred)
+}
+
+// Creates and immediately drops weakly referenced objects, so every iteration
+// exercises weak counter allocation, clearing on deallocation and a weak read.
+fun weakReferenceChurn() {
+    var alive = 0
+    var cleared = 0
+    var lastWeak: WeakReference<Node>? = null
+    for (i in 0 until 8192) {
+        val node = Node(i)
+        val weak = WeakReference(node)
+        if (weak.value != null) alive++
+        lastWeak = weak
+    }
+    // The last referent died with the loop iteration, so its weak must be cleared.
+    if (lastWeak?.value == null) cleared++
+    Blackhole.consume(alive + cleared)
+}
+
+// Power-of-two microsecond buckets are plenty for pauses spanning 1us..30s.
+private const val pauseBuckets = 32
+
+private class PauseHistogram {
+    val buckets = IntArray(pauseBuckets)
+    var count = 0
+    var maxMicros = 0L
+
+    fun record(micros: Long) {
+        var bucket = 0
+        var value = micros
+        while (value > 0 && bucket < pauseBuckets - 1) {
+            value = value shr 1
+            bucket++
+        }
+        buckets[bucket]++
+        count++
+        if (micros > maxMicros) maxMicros = micros
+    }
+
+    // Returns the upper bound of the bucket holding the given percentile.
+    fun percentile(fraction: Double): Long {
+        val rank = (count * fraction).toInt()
+        var seen = 0
+        for (bucket in 0 until pauseBuckets) {
+            seen += buckets[bucket]
+            if (seen > rank) return 1L shl bucket
+        }
+        return maxMicros
+    }
+}
+
+private val pauseHistogram = PauseHistogram()
+private var lastSeenSequence = -1L
+private var lastReportedCount = 0
+
+// Folds fresh total-pause events from the GC log ring into the histogram.
+// Events are 7 longs each; phase 0 is the whole-collection record and its
+// duration (index 4) is in microseconds. Sequence numbers deduplicate events
+// still present from the previous snapshot.
+private fun drainPauseLog() {
+    val events = GC.logSnapshot()
+    var i = 0
+    var maxSequence = lastSeenSequence
+    while (i + 6 < events.size) {
+        val sequence = events[i]
+        if (sequence > lastSeenSequence && events[i + 1] == 0L) {
+            pauseHistogram.record(events[i + 4])
+        }
+        if (sequence > maxSequence) maxSequence = sequence
+        i += 7
+    }
+    lastSeenSequence = maxSequence
+}
+
+private fun reportPausesIfGrown() {
+    if (pauseHistogram.count - lastReportedCount < 512) return
+    lastReportedCount = pauseHistogram.count
+    printStderr("GC pauses (us): p50=${pauseHistogram.percentile(0.5)}" +
+            " p90=${pauseHistogram.percentile(0.9)} p99=${pauseHistogram.percentile(0.99)}" +
+            " max=${pauseHistogram.maxMicros} count=${pauseHistogram.count}\n")
+}
+
+// Allocates steadily while rotating a fixed-size live set, collecting the pause
+// distribution from the structured GC log and reporting it as a histogram.
+fun steadyLoadGCPauses() {
+    val wasLogging = GC.loggingEnabled
+    GC.loggingEnabled = true
+    val liveSet = arrayOfNulls<Node>(512)
+    for (i in 0 until 16384) {
+        val node = Node(i)
+        node.payload = IntArray(32)
+        liveSet[i % liveSet.size] = node
+        if (i % 4096 == 0) GC.collect()
+    }
+    drainPauseLog()
+    GC.loggingEnabled = wasLogging
+    reportPausesIfGrown()
+    Blackhole.consume(pauseHistogram.percentile(0.99))
+}
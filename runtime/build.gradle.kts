@@ -20,6 +20,27 @@ fun CompileToBitcode.includeRuntime() {
     headersDirs += files("../common/src/hash/headers", "src/main/cpp")
 }
 
+// Profile-guided optimization of the runtime itself. Build the runtime with
+// -PruntimeProfileInstrument and run representative workloads: every process
+// writes LLVM profile counters to the file named by the LLVM_PROFILE_FILE
+// environment variable (see also Konan_Profiler_writeLLVMProfile in
+// src/profile_runtime). Merge the raw files with `llvm-profdata merge` and
+// rebuild with -PruntimeProfileData=<merged.profdata>; clang then lays out the
+// hot paths of UpdateHeapRef, AllocInstance, string operations etc. according
+// to the measured behavior.
+fun CompileToBitcode.includeProfileGuidedFlags() {
+    if (project.hasProperty("runtimeProfileInstrument")) {
+        compilerArgs.addAll(listOf("-fprofile-instr-generate", "-DKONAN_PGO_INSTRUMENT=1"))
+    }
+    project.findProperty("runtimeProfileData")?.let {
+        compilerArgs.addAll(listOf(
+            "-fprofile-instr-use=$it",
+            // The profile rarely covers every function of every variant.
+            "-Wno-profile-instr-unprofiled",
+            "-Wno-profile-instr-out-of-date"))
+    }
+}
+
 val hostName: String by project
 val targetList: List<String> by project
 
@@ -42,6 +63,7 @@ bitcode {
             "${target}ExperimentalMemoryManager"
         )
         includeRuntime()
+        includeProfileGuidedFlags()
         linkerArgs.add(project.file("../common/build/bitcode/main/$target/hash.bc").path)
     }
 
@@ -67,7 +89,9 @@ bitcode {
     }
 
     create("std_alloc")
-    create("opt_alloc")
+    create("opt_alloc") {
+        includeProfileGuidedFlags()
+    }
 
     create("exceptionsSupport", file("src/exceptions_support")) {
         includeRuntime()
@@ -79,13 +103,17 @@ bitcode {
 
     create("strict") {
         includeRuntime()
+        includeProfileGuidedFlags()
     }
 
     create("relaxed") {
         includeRuntime()
+        includeProfileGuidedFlags()
     }
 
-    create("profileRuntime", file("src/profile_runtime"))
+    create("profileRuntime", file("src/profile_runtime")) {
+        includeProfileGuidedFlags()
+    }
 
     create("objc") {
         includeRuntime()
@@ -99,10 +127,12 @@ bitcode {
 
     create("legacy_memory_manager", file("src/legacymm")) {
         includeRuntime()
+        includeProfileGuidedFlags()
     }
 
     create("experimental_memory_manager", file("src/mm")) {
         includeRuntime()
+        includeProfileGuidedFlags()
     }
 }
 
@@ -18,6 +18,7 @@
 
 #include <string.h>
 
+#include "Alloc.h"
 #include "KAssert.h"
 #include "KString.h"
 #include "Memory.h"
@@ -61,6 +62,35 @@ constexpr int runtimeTypeAlignment[] = {
     16                   // VECTOR128
 };
 
+// Per-TypeInfo descriptor built on the first debugger inspection of a type and
+// reused afterwards, so stepping repeatedly through values of the same type does
+// not redo metadata work. Today the cached piece is the UTF-8 rendering of the
+// type name, which otherwise gets converted (and never freed) on every request.
+// Entry points run while the inferior is stopped, so no locking is needed.
+struct DebugTypeDescriptor {
+  const TypeInfo* typeInfo;
+  const ExtendedTypeInfo* extendedInfo;
+  const char* typeName;  // Converted from relativeName_ on first request.
+  DebugTypeDescriptor* next;
+};
+
+constexpr int kDescriptorCacheBuckets = 64;  // Power of two.
+DebugTypeDescriptor* descriptorCache[kDescriptorCacheBuckets] = { nullptr };
+
+DebugTypeDescriptor* descriptorFor(const TypeInfo* typeInfo) {
+  auto bucket = (reinterpret_cast<uintptr_t>(typeInfo) >> 4) & (kDescriptorCacheBuckets - 1);
+  for (auto* descriptor = descriptorCache[bucket]; descriptor != nullptr; descriptor = descriptor->next) {
+    if (descriptor->typeInfo == typeInfo) return descriptor;
+  }
+  auto* descriptor = konanConstructInstance<DebugTypeDescriptor>();
+  descriptor->typeInfo = typeInfo;
+  descriptor->extendedInfo = typeInfo->extendedInfo_;
+  descriptor->typeName = nullptr;
+  descriptor->next = descriptorCache[bucket];
+  descriptorCache[bucket] = descriptor;
+  return descriptor;
+}
+
 // Never ever change numbering in this enum, as it will break debugging of older binaries.
 enum Konan_DebugOperation {
   DO_DebugBuffer = 1,
@@ -221,7 +251,10 @@ const char* Konan_DebugGetTypeNameImpl(KRef obj) {
   if (type_info == nullptr)
     return "<unknown>";
 
-  return CreateCStringFromString(type_info->relativeName_);
+  auto* descriptor = descriptorFor(type_info);
+  if (descriptor->typeName == nullptr)
+    descriptor->typeName = CreateCStringFromString(type_info->relativeName_);
+  return descriptor->typeName;
 }
 
 }  // namespace
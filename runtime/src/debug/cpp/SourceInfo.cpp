@@ -21,6 +21,8 @@
 #include <cstdint>
 #include <dlfcn.h>
 #include <limits>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -119,6 +121,65 @@ bool TryInitializeCoreSymbolication() {
   return !CSIsNull(symbolicator);
 }
 
+// Sorted (PC range -> source info) index built lazily from resolved queries.
+// CoreSymbolication walks the debug info per call, which dominates when an
+// error reporter symbolicates thousands of frames per crash batch; once a
+// range is resolved, every later address falling into it is a binary search.
+// Entries are the innermost line records, so all addresses of a range share
+// one file/line/column. File name strings are owned by the symbolicator and
+// live as long as the process.
+typedef struct {
+  unsigned long long start;
+  unsigned long long end;  // Exclusive.
+  SourceInfo info;
+} SourceInfoCacheEntry;
+
+SourceInfoCacheEntry* sourceInfoCache = nullptr;
+size_t sourceInfoCacheSize = 0;
+size_t sourceInfoCacheCapacity = 0;
+pthread_mutex_t sourceInfoCacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Index of the first cached range starting above [address].
+size_t sourceInfoCacheUpperBound(unsigned long long address) {
+  size_t lo = 0, hi = sourceInfoCacheSize;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (sourceInfoCache[mid].start <= address) lo = mid + 1; else hi = mid;
+  }
+  return lo;
+}
+
+bool sourceInfoCacheLookup(unsigned long long address, SourceInfo* result) {
+  pthread_mutex_lock(&sourceInfoCacheLock);
+  size_t upper = sourceInfoCacheUpperBound(address);
+  bool found = upper > 0 && address < sourceInfoCache[upper - 1].end;
+  if (found) *result = sourceInfoCache[upper - 1].info;
+  pthread_mutex_unlock(&sourceInfoCacheLock);
+  return found;
+}
+
+void sourceInfoCacheInsert(unsigned long long start, unsigned long long end, const SourceInfo& info) {
+  pthread_mutex_lock(&sourceInfoCacheLock);
+  size_t upper = sourceInfoCacheUpperBound(start);
+  // Lost a race or got an overlapping record: keep the existing entry.
+  if ((upper > 0 && start < sourceInfoCache[upper - 1].end)
+      || (upper < sourceInfoCacheSize && sourceInfoCache[upper].start < end)) {
+    pthread_mutex_unlock(&sourceInfoCacheLock);
+    return;
+  }
+  if (sourceInfoCacheSize == sourceInfoCacheCapacity) {
+    size_t newCapacity = sourceInfoCacheCapacity == 0 ? 256 : sourceInfoCacheCapacity * 2;
+    sourceInfoCache = static_cast<SourceInfoCacheEntry*>(
+        realloc(sourceInfoCache, newCapacity * sizeof(SourceInfoCacheEntry)));
+    sourceInfoCacheCapacity = newCapacity;
+  }
+  memmove(sourceInfoCache + upper + 1, sourceInfoCache + upper,
+          (sourceInfoCacheSize - upper) * sizeof(SourceInfoCacheEntry));
+  sourceInfoCache[upper] = { start, end, info };
+  sourceInfoCacheSize++;
+  pthread_mutex_unlock(&sourceInfoCacheLock);
+}
+
 } // namespace
 
 typedef struct {
@@ -131,12 +192,16 @@ extern "C" struct SourceInfo Kotlin_getSourceInfo(void* addr) {
   __block SourceInfo result = { .fileName = nullptr, .lineNumber = -1, .column = -1 };
   __block bool continueUpdateResult = true;
   __block SymbolSourceInfoLimits limits = {.start = -1, .end = -1};
+  __block CSRange resolvedRange = { 0, 0 };
 
   static bool csIsAvailable = TryInitializeCoreSymbolication();
 
   if (csIsAvailable) {
     unsigned long long address = static_cast<unsigned long long>((uintptr_t)addr);
 
+    if (sourceInfoCacheLookup(address, &result))
+      return result;
+
     CSSymbolOwnerRef symbolOwner = CSSymbolicatorGetSymbolOwnerWithAddressAtTime(symbolicator, address, kCSNow);
     if (CSIsNull(symbolOwner))
       return result;
@@ -195,19 +260,36 @@ extern "C" struct SourceInfo Kotlin_getSourceInfo(void* addr) {
            * updating high level inlined _at_ source info
            */
           if (continueUpdateResult &&  (address >= range.location
-                                        && address < range.location + range.length))
+                                        && address < range.location + range.length)) {
              continueUpdateResult = false;
+             resolvedRange = range;
+          }
 
           return 0;
    });
+
+    // Remember the innermost range covering the address, so later queries
+    // falling into it resolve without touching CoreSymbolication.
+    if (resolvedRange.length != 0 && result.fileName != nullptr)
+      sourceInfoCacheInsert(resolvedRange.location, resolvedRange.location + resolvedRange.length, result);
   }
   return result;
 }
 
+extern "C" void Kotlin_getSourceInfoBulk(void** addresses, int count, struct SourceInfo* results) {
+  for (int i = 0; i < count; i++)
+    results[i] = Kotlin_getSourceInfo(addresses[i]);
+}
+
 #else // KONAN_CORE_SYMBOLICATION
 
 extern "C" struct SourceInfo Kotlin_getSourceInfo(void* addr) {
   return (SourceInfo) { .fileName = nullptr, .lineNumber = -1, .column = -1 };
 }
 
+extern "C" void Kotlin_getSourceInfoBulk(void** addresses, int count, struct SourceInfo* results) {
+  for (int i = 0; i < count; i++)
+    results[i] = Kotlin_getSourceInfo(addresses[i]);
+}
+
 #endif // KONAN_CORE_SYMBOLICATION
@@ -32,13 +32,16 @@ OBJ_GETTER(setupArgs, int argc, const char** argv) {
   ArrayHeader* array = result->array();
   for (int index = 1; index < argc; index++) {
     ObjHolder result;
-    CreateStringFromCString(argv[index], result.slot());
+    // Interned: command lines repeat the same flag strings across arguments, and the
+    // interned values are frozen, so repeated lookups never convert the bytes again.
+    CreateStringFromCStringInterned(argv[index], result.slot());
     UpdateHeapRef(ArrayAddressOfElementAt(array, index - 1), result.obj());
   }
   return result;
 }
 
 //--- main --------------------------------------------------------------------//
+extern "C" void Kotlin_io_Console_flush();
 extern "C" KInt Konan_start(const ObjHeader*);
 
 extern "C" KInt Konan_run_start(int argc, const char** argv) {
@@ -57,7 +60,10 @@ extern "C" RUNTIME_USED int Init_and_run_start(int argc, const char** argv, int
 
   KInt exitStatus = Konan_run_start(argc, argv);
 
-  if (memoryDeInit) {
+  if (memoryDeInit && Kotlin_fastShutdownEnabled()) {
+      // Fast shutdown: the OS reclaims the heap, only buffered output matters.
+      Kotlin_io_Console_flush();
+  } else if (memoryDeInit) {
       if (Kotlin_cleanersLeakCheckerEnabled()) {
           // Make sure to collect any lingering cleaners.
           PerformFullGC();
@@ -112,6 +112,10 @@ function int32ToHeap(value, pointer) {
     heap[pointer + 3] = (value & 0xff000000) >>> 24;
 }
 
+function int32FromHeap(pointer) {
+    return heap[pointer] | (heap[pointer + 1] << 8) | (heap[pointer + 2] << 16) | (heap[pointer + 3] << 24);
+}
+
 function doubleToReturnSlot(value) {
     const twoInts = doubleToTwoInts(value);
     instance.exports.ReturnSlot_setDouble(twoInts.upper, twoInts.lower);
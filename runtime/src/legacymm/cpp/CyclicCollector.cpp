@@ -20,6 +20,7 @@
 #include "Alloc.h"
 #include "Atomic.h"
 #include "KAssert.h"
+#include "KString.h"
 #include "Memory.h"
 #include "MemoryPrivate.hpp"
 #include "Natives.h"
@@ -106,8 +107,43 @@ inline bool isAtomicReference(ObjHeader* obj) {
   return (obj->type_info()->flags_ & TF_LEAK_DETECTOR_CANDIDATE) != 0;
 }
 
+// An object of a provably acyclic type (strings, boxed primitives, leaf data classes)
+// cannot be part of a shared cycle, and as its fields transitively hold acyclic types
+// only, its subgraph cannot contain or reach an atomic reference either. Such objects
+// make up the bulk of a typical shared heap, so the analysis skips their subtrees.
+inline bool isProvablyAcyclic(ObjHeader* obj) {
+  return (obj->type_info()->flags_ & TF_ACYCLIC) != 0;
+}
+
 #define CHECK_CALL(call, message) RuntimeCheck((call) == 0, message)
 
+// After that many analysis restarts caused by atomic rootset mutations the collector
+// finishes marking in a short stop-the-world fixup (if enabled) instead of retrying.
+constexpr int kMaxRestartsBeforeFixup = 10;
+
+// A per-thread log of atomic rootset registrations. Only the owner thread and the
+// aggregating collector touch a shard, so its spinlock is effectively uncontended and
+// mutator-side root registration never takes the global collector lock. The collector
+// folds all shards into its rootset at the beginning of every analysis epoch.
+struct RootsetShard {
+  int32_t lock;
+  // Roots registered by the owner thread since the last aggregation epoch.
+  KStdVector<ObjHeader*>* pendingAdds;
+  // Set when the owner thread is gone; such shards are reused by new threads.
+  int32_t retired;
+  RootsetShard* next;
+};
+
+THREAD_LOCAL_VARIABLE RootsetShard* currentRootsetShard = nullptr;
+
+inline void shardLock(int32_t* lock) {
+  while (!compareAndSet(lock, 0, 1)) {}
+}
+
+inline void shardUnlock(int32_t* lock) {
+  atomicSet(lock, 0);
+}
+
 class CyclicCollector {
   pthread_mutex_t lock_;
   pthread_mutex_t timestampLock_;
@@ -117,6 +153,8 @@ class CyclicCollector {
   int currentAliveWorkers_;
   int gcRunning_;
   int mutatedAtomics_;
+  int fixupRunning_;
+  int concurrentFixup_;
   int pendingRelease_;
   bool shallRunCollector_;
   bool terminateCollector_;
@@ -126,6 +164,13 @@ class CyclicCollector {
   void* mainWorker_;
   KStdUnorderedSet<ObjHeader*> rootset_;
   KStdUnorderedSet<ObjHeader*> toRelease_;
+  RootsetShard* shards_;
+  int32_t rootsetEpoch_;
+  // Leak detector: 0 means off, otherwise the number of consecutive analysis
+  // passes an externally retained atomic root survives before it is reported.
+  int32_t leakDetectionCycles_;
+  // Per surviving root: how many consecutive passes it stayed retained.
+  KStdUnorderedMap<ObjHeader*, int32_t> survivorPasses_;
 
  public:
   CyclicCollector() {
@@ -137,6 +182,11 @@ class CyclicCollector {
 
   void clear() {
     Locker lock(&lock_);
+    for (auto* shard = atomicGet(&shards_); shard != nullptr; shard = shard->next) {
+      shardLock(&shard->lock);
+      shard->pendingAdds->clear();
+      shardUnlock(&shard->lock);
+    }
     rootset_.clear();
     toRelease_.clear();
   }
@@ -171,6 +221,7 @@ class CyclicCollector {
        KStdDeque<ObjHeader*> toVisit;
        KStdUnorderedSet<ObjHeader*> visited;
        KStdUnorderedMap<ObjHeader*, int> sideRefCounts;
+       KStdVector<ObjHeader*> externallyHeld;
        int restartCount = 0;
        while (!terminateCollector_) {
          CHECK_CALL(pthread_cond_wait(&cond_, &lock_), "Cannot wait collector condition")
@@ -179,12 +230,20 @@ class CyclicCollector {
          restartCount = 0;
         restart:
          COLLECTOR_LOG("start cycle GC\n");
-         if (restartCount > 10 && !terminateCollector_) {
-           COLLECTOR_LOG("wait for some time to avoid GC thrashing\n");
-           uint64_t nsDelta = 1000LL * 1000LL * (restartCount - 10);
-           WaitOnCondVar(&cond_, &lock_, nsDelta);
+         if (restartCount > kMaxRestartsBeforeFixup && !terminateCollector_) {
+           if (atomicGet(&concurrentFixup_) != 0) {
+             // Mutator traffic does not let the analysis finish: complete this pass in a short
+             // stop-the-world fixup, blocking atomic rootset mutations instead of restarting.
+             COLLECTOR_LOG("enter stop-the-world fixup after %d restarts\n", restartCount);
+             atomicSet(&fixupRunning_, 1);
+           } else {
+             COLLECTOR_LOG("wait for some time to avoid GC thrashing\n");
+             uint64_t nsDelta = 1000LL * 1000LL * (restartCount - kMaxRestartsBeforeFixup);
+             WaitOnCondVar(&cond_, &lock_, nsDelta);
+           }
          }
          atomicSet(&mutatedAtomics_, 0);
+         aggregateRootsetLocked();
          visited.clear();
          toVisit.clear();
          sideRefCounts.clear();
@@ -196,7 +255,7 @@ class CyclicCollector {
            sideRefCounts[root] = 0;
          }
          while (toVisit.size() > 0)  {
-           if (atomicGet(&mutatedAtomics_) != 0) {
+           if (atomicGet(&mutatedAtomics_) != 0 && atomicGet(&fixupRunning_) == 0) {
              COLLECTOR_LOG("restarted during rootset visit\n")
              restartCount++;
              goto restart;
@@ -224,7 +283,9 @@ class CyclicCollector {
                     increment = 0;
                   }
                   sideRefCounts[ref] += increment;
-                  toVisit.push_back(ref);
+                  // Account for the edge, but do not scan inside acyclic leaves.
+                  if (!isProvablyAcyclic(ref))
+                    toVisit.push_back(ref);
                 }
              });
            }
@@ -232,8 +293,12 @@ class CyclicCollector {
          // Now find all elements with external references, and mark objects reachable from them as non suitable
          // for collection by setting their side reference count to -1.
          toVisit.clear();
+         externallyHeld.clear();
          for (auto it: sideRefCounts) {
            auto* obj = it.first;
+           // An externally held acyclic leaf cannot retain an atomic root, so there is
+           // nothing to propagate from it.
+           if (isProvablyAcyclic(obj)) continue;
            auto* objContainer = containerFor(obj);
            if (objContainer == nullptr) continue;  // Permanent object.
            int refCount;
@@ -254,6 +319,7 @@ class CyclicCollector {
            if (refCount != objContainer->refCount()) {
              COLLECTOR_LOG("for %p mismatched RC: %d vs %d, adding as possible root\n", obj, refCount, objContainer->refCount())
              toVisit.push_back(it.first);
+             externallyHeld.push_back(it.first);
            }
          }
          visited.clear();
@@ -265,14 +331,14 @@ class CyclicCollector {
            RuntimeCheck(objContainer->shareable(), "Must be shareable");
            sideRefCounts[obj] = -1;
            visited.insert(obj);
-           if (atomicGet(&mutatedAtomics_) != 0) {
+           if (atomicGet(&mutatedAtomics_) != 0 && atomicGet(&fixupRunning_) == 0) {
              COLLECTOR_LOG("restarted during reachable visit\n")
              restartCount++;
              goto restart;
            }
            traverseObjectFields(obj, [&toVisit, &visited](ObjHeader** location) {
               ObjHeader* ref = *location;
-              if (ref != nullptr && (visited.count(ref) == 0)) {
+              if (ref != nullptr && (visited.count(ref) == 0) && !isProvablyAcyclic(ref)) {
                 toVisit.push_back(ref);
               }
            });
@@ -285,7 +351,7 @@ class CyclicCollector {
            if (!isAtomicReference(obj)) {
              continue;
            }
-           if (atomicGet(&mutatedAtomics_) != 0) {
+           if (atomicGet(&mutatedAtomics_) != 0 && atomicGet(&fixupRunning_) == 0) {
              COLLECTOR_LOG("restarted during matching check\n")
              restartCount++;
              goto restart;
@@ -304,6 +370,8 @@ class CyclicCollector {
          }
          if (toRelease_.size() > 0)
            atomicSet(&pendingRelease_, 1);
+         reportLeaksLocked(externallyHeld);
+         atomicSet(&fixupRunning_, 0);
          atomicSet(&gcRunning_, 0);
          shallRunCollector_ = false;
          COLLECTOR_LOG("end cycle GC\n");
@@ -312,6 +380,95 @@ class CyclicCollector {
      atomicSet(&terminateCollector_, false);
   }
 
+  // Writes "package.Relative" of [obj]'s type into [buffer].
+  void typeName(ObjHeader* obj, char* buffer, size_t size) {
+    const TypeInfo* typeInfo = obj->type_info();
+    char* package =
+        typeInfo->packageName_ != nullptr ? CreateCStringFromString(typeInfo->packageName_) : nullptr;
+    char* relative =
+        typeInfo->relativeName_ != nullptr ? CreateCStringFromString(typeInfo->relativeName_) : nullptr;
+    konan::snprintf(buffer, size, "%s%s%s", package != nullptr ? package : "",
+        package != nullptr && package[0] != '\0' ? "." : "",
+        relative != nullptr ? relative : "<object>");
+    DisposeCString(package);
+    DisposeCString(relative);
+  }
+
+  // Leak detector: atomic roots that stay externally retained for [leakDetectionCycles_]
+  // consecutive analysis passes are reported once, together with a shortest retention
+  // path from an externally referenced object, naming what keeps them alive. External
+  // references are whatever the analysis could not attribute to the closure itself:
+  // GC roots, stable pointers handed out by interop, worker queues and the like.
+  // Must be called at the end of an analysis pass with [lock_] held.
+  void reportLeaksLocked(const KStdVector<ObjHeader*>& externallyHeld) {
+    int32_t threshold = atomicGet(&leakDetectionCycles_);
+    if (threshold <= 0) {
+      if (!survivorPasses_.empty()) survivorPasses_.clear();
+      return;
+    }
+    // Age surviving roots; roots gone from the rootset or released drop out.
+    KStdUnorderedMap<ObjHeader*, int32_t> alive;
+    KStdVector<ObjHeader*> toReport;
+    for (auto* root: rootset_) {
+      if (!containerFor(root)->frozen()) continue;
+      if (toRelease_.count(root) != 0) continue;
+      auto it = survivorPasses_.find(root);
+      int32_t passes = (it != survivorPasses_.end() ? it->second : 0) + 1;
+      alive[root] = passes;
+      if (passes == threshold) toReport.push_back(root);
+    }
+    survivorPasses_.swap(alive);
+    if (toReport.empty()) return;
+    // Shortest retention paths: a single BFS from all externally referenced objects
+    // at once, so the parent edges spell a shortest path for every reported root.
+    KStdUnorderedMap<ObjHeader*, ObjHeader*> parents;
+    KStdDeque<ObjHeader*> toVisit;
+    for (auto* holder: externallyHeld) {
+      if (parents.count(holder) == 0) {
+        parents[holder] = nullptr;
+        toVisit.push_back(holder);
+      }
+    }
+    while (!toVisit.empty()) {
+      auto* obj = toVisit.front();
+      toVisit.pop_front();
+      traverseObjectFields(obj, [obj, &parents, &toVisit](ObjHeader** location) {
+        ObjHeader* ref = *location;
+        // Retention paths to atomic roots never pass through acyclic leaves.
+        if (ref != nullptr && parents.count(ref) == 0 && !isProvablyAcyclic(ref)) {
+          parents[ref] = obj;
+          toVisit.push_back(ref);
+        }
+      });
+    }
+    char name[256];
+    for (auto* root: toReport) {
+      typeName(root, name, sizeof(name));
+      konan::consolePrintf("[leak] %p %s: externally retained for %d collector passes\n",
+          root, name, threshold);
+      auto it = parents.find(root);
+      if (it == parents.end()) {
+        // Not reachable from any externally referenced object of the closure, so the
+        // external reference is on the root itself or its retainer was mutated away.
+        konan::consolePrintf("[leak]   held from outside the atomic rootset closure\n");
+        continue;
+      }
+      for (ObjHeader* step = root; step != nullptr; step = parents[step]) {
+        typeName(step, name, sizeof(name));
+        konan::consolePrintf("[leak]   %s %p %s\n",
+            parents[step] == nullptr ? "held by external reference:" : "retained via", step, name);
+      }
+    }
+  }
+
+  void setLeakDetectionCycles(int value) {
+    atomicSet(&leakDetectionCycles_, value);
+  }
+
+  int getLeakDetectionCycles() {
+    return atomicGet(&leakDetectionCycles_);
+  }
+
   void addWorker(void* worker) {
     suggestLockRelease();
     Locker lock(&lock_);
@@ -322,6 +479,14 @@ class CyclicCollector {
   void removeWorker(void* worker, bool enabled) {
     suggestLockRelease();
     Locker lock(&lock_);
+    // The dying thread's pending roots must survive it: fold the shards in and hand
+    // this thread's shard over for reuse.
+    if (currentRootsetShard != nullptr) {
+      aggregateRootsetLocked();
+      auto* shard = currentRootsetShard;
+      currentRootsetShard = nullptr;
+      atomicSet(&shard->retired, 1);
+    }
     // When exiting the worker - we shall collect the cyclic garbage here.
     if (enabled) {
       shallRunCollector_ = true;
@@ -330,13 +495,53 @@ class CyclicCollector {
     currentAliveWorkers_--;
   }
 
+  // Returns this thread's rootset shard, claiming a retired one or linking a new one
+  // into [shards_] on first use. Lock-free, as the collector could be holding [lock_]
+  // for a whole analysis pass.
+  RootsetShard* rootsetShard() {
+    RootsetShard* shard = currentRootsetShard;
+    if (shard != nullptr) return shard;
+    for (shard = atomicGet(&shards_); shard != nullptr; shard = shard->next) {
+      if (atomicGet(&shard->retired) != 0 && compareAndSet(&shard->retired, 1, 0)) {
+        currentRootsetShard = shard;
+        return shard;
+      }
+    }
+    shard = konanConstructInstance<RootsetShard>();
+    shard->pendingAdds = konanConstructInstance<KStdVector<ObjHeader*>>();
+    RootsetShard* head;
+    do {
+      head = atomicGet(&shards_);
+      shard->next = head;
+    } while (!compareAndSet(&shards_, head, shard));
+    currentRootsetShard = shard;
+    return shard;
+  }
+
+  // Folds per-thread shards into [rootset_], starting a new aggregation epoch.
+  // Must be called with [lock_] held.
+  void aggregateRootsetLocked() {
+    rootsetEpoch_++;
+    for (auto* shard = atomicGet(&shards_); shard != nullptr; shard = shard->next) {
+      shardLock(&shard->lock);
+      for (auto* obj: *shard->pendingAdds) {
+        rootset_.insert(obj);
+      }
+      shard->pendingAdds->clear();
+      shardUnlock(&shard->lock);
+    }
+    COLLECTOR_LOG("rootset epoch %d has %d roots\n", rootsetEpoch_, (int)rootset_.size());
+  }
+
   void addRoot(ObjHeader* obj) {
     COLLECTOR_LOG("add root %p\n", obj);
-    // TODO: we can only add root when collector is not processing, which looks like a limitation,
-    //  instead we can add elements to the side buffer or have a separate lock for that.
-    suggestLockRelease();
-    Locker lock(&lock_);
-    rootset_.insert(obj);
+    // Registration only appends to the current thread's shard: the collector picks it
+    // up at the next aggregation epoch. Freshly allocated roots are not frozen yet, so
+    // the running analysis pass cannot miss anything it cares about.
+    auto* shard = rootsetShard();
+    shardLock(&shard->lock);
+    shard->pendingAdds->push_back(obj);
+    shardUnlock(&shard->lock);
   }
 
   void removeRoot(ObjHeader* obj) {
@@ -344,16 +549,29 @@ class CyclicCollector {
     // Note that we can only remove root when the collector is not processing.
     suggestLockRelease();
     Locker lock(&lock_);
+    // Fold pending registrations first, so that a stale one does not resurrect [obj].
+    aggregateRootsetLocked();
     toRelease_.erase(obj);
     rootset_.erase(obj);
   }
 
   void mutateRoot(ObjHeader* newValue) {
+    // While the final stop-the-world fixup is running, atomic rootset mutations shall wait:
+    // the collector relies on the analyzed subgraph staying put to finish in bounded time.
+    while (atomicGet(&fixupRunning_) != 0) {}
     // TODO: consider optimization, when clearing value (setting to null) in atomic reference shall not lead
     //   to invalidation of the collector analysis state.
     atomicSet(&mutatedAtomics_, 1);
   }
 
+  void setConcurrentFixup(bool value) {
+    atomicSet(&concurrentFixup_, value ? 1 : 0);
+  }
+
+  bool getConcurrentFixup() {
+    return atomicGet(&concurrentFixup_) != 0;
+  }
+
   void suggestLockRelease() {
     atomicSet(&mutatedAtomics_, 1);
   }
@@ -526,3 +744,37 @@ void cyclicLocalGC() {
     local->localGC();
 #endif  // WITH_WORKERS
 }
+
+void cyclicSetConcurrentFixup(bool value) {
+#if WITH_WORKERS
+  auto* local = cyclicCollector;
+  if (local)
+    local->setConcurrentFixup(value);
+#endif  // WITH_WORKERS
+}
+
+bool cyclicGetConcurrentFixup() {
+#if WITH_WORKERS
+  auto* local = cyclicCollector;
+  if (local)
+    return local->getConcurrentFixup();
+#endif  // WITH_WORKERS
+  return false;
+}
+
+void cyclicSetLeakDetectionCycles(int value) {
+#if WITH_WORKERS
+  auto* local = cyclicCollector;
+  if (local)
+    local->setLeakDetectionCycles(value);
+#endif  // WITH_WORKERS
+}
+
+int cyclicGetLeakDetectionCycles() {
+#if WITH_WORKERS
+  auto* local = cyclicCollector;
+  if (local)
+    return local->getLeakDetectionCycles();
+#endif  // WITH_WORKERS
+  return 0;
+}
@@ -13,5 +13,9 @@ void cyclicMutateAtomicRoot(ObjHeader* newValue);
 void cyclicCollectorCallback(void* worker);
 void cyclicLocalGC();
 void cyclicScheduleGarbageCollect();
+void cyclicSetConcurrentFixup(bool value);
+bool cyclicGetConcurrentFixup();
+void cyclicSetLeakDetectionCycles(int value);
+int cyclicGetLeakDetectionCycles();
 
 #endif  // RUNTIME_CYCLIC_COLLECTOR_H
\ No newline at end of file
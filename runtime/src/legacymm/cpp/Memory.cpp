@@ -19,6 +19,10 @@
 
 #include <cstddef> // for offsetof
 
+#if !KONAN_NO_THREADS
+#include <pthread.h>
+#endif
+
 // Allow concurrent global cycle collector.
 #define USE_CYCLIC_GC 0
 
@@ -38,12 +42,16 @@
 #include "CyclicCollector.h"
 #endif  // USE_CYCLIC_GC
 #include "Exceptions.h"
+#include "GCLog.h"
 #include "KString.h"
 #include "Memory.h"
 #include "MemoryPrivate.hpp"
 #include "Natives.h"
 #include "Porting.h"
 #include "Runtime.h"
+#include "RuntimeConfig.h"
+#include "RuntimeCounters.h"
+#include "SafePoint.h"
 #include "Utils.h"
 #include "WorkerBoundReference.h"
 #include "Weak.h"
@@ -62,6 +70,30 @@
 #define TRACE_GC 0
 // Collect memory manager events statistics.
 #define COLLECT_STATISTIC 0
+// Serve small container allocations from per-thread bump-pointer nursery chunks.
+#define USE_ALLOC_NURSERY 1
+// mmap() huge containers (large arrays) directly, bypassing the general allocator,
+// so that constantly churning them does not fragment its arena.
+#if !KONAN_WINDOWS && !KONAN_WASM && !KONAN_ZEPHYR && !KONAN_NO_THREADS
+#define USE_MMAP_CONTAINERS 1
+#else
+#define USE_MMAP_CONTAINERS 0
+#endif
+#if USE_MMAP_CONTAINERS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif  // USE_MMAP_CONTAINERS
+// Free long finalizer queues with a small internal thread team. Disabled together
+// with the tracing/statistic modes, which assume single-threaded destruction events.
+#if !KONAN_NO_THREADS && !TRACE_MEMORY && !COLLECT_STATISTIC
+#define USE_PARALLEL_SWEEP 1
+#else
+#define USE_PARALLEL_SWEEP 0
+#endif
 // Define to 1 to print detailed time statistics for GC events.
 #define PROFILE_GC 0
 
@@ -77,6 +109,11 @@ typedef uint32_t container_size_t;
 constexpr container_size_t kContainerAlignment = 1024;
 // Single object alignment.
 constexpr container_size_t kObjectAlignment = 8;
+// Payload alignment for TF_ALIGNED_PAYLOAD containers: one cache line, enough
+// for any current vector width and to keep neighbours off the line.
+constexpr container_size_t kAlignedPayloadAlignment = 64;
+// Explicit alignment requests beyond a page make no sense for heap containers.
+constexpr container_size_t kMaxPayloadAlignment = 4096;
 
 // Required e.g. for object size computations to be correct.
 static_assert(sizeof(ContainerHeader) % kObjectAlignment == 0, "sizeof(ContainerHeader) is not aligned");
@@ -95,6 +132,31 @@ static_assert(sizeof(ContainerHeader) % kObjectAlignment == 0, "sizeof(Container
 #define GC_LOG(...)
 #endif
 
+#if USE_ALLOC_NURSERY
+// Size of a single nursery chunk.
+constexpr container_size_t kNurseryChunkSize = 256 * 1024;
+// Containers bigger than that always go to the main allocator.
+constexpr container_size_t kNurseryMaxBlockSize = 1024;
+#endif  // USE_ALLOC_NURSERY
+
+#if USE_MMAP_CONTAINERS
+// Containers at least this big are mmap()ed directly; their pages are returned to
+// the OS with madvise() on free while the address range is cached for reuse.
+constexpr size_t kMmapContainerThreshold = 1024 * 1024;
+// How many free mmapped ranges to keep around; the rest is munmap()ed right away.
+constexpr size_t kMaxCachedMmapRegions = 4;
+// Mappings at least this big are padded to huge page granularity and advised to be
+// backed by transparent huge pages, where the OS supports the advice.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+#endif  // USE_MMAP_CONTAINERS
+
+#if USE_PARALLEL_SWEEP
+// Helper threads in the sweep team; the GC-ing thread frees its own share as well.
+constexpr int kSweepTeamSize = 3;
+// Queues shorter than this are freed serially: partitioning costs more than it saves.
+constexpr size_t kParallelSweepThreshold = 4096;
+#endif  // USE_PARALLEL_SWEEP
+
 #if USE_GC
 // Collection threshold default (collect after having so many elements in the
 // release candidates set).
@@ -109,8 +171,16 @@ constexpr size_t kMaxErgonomicThreshold = 32 * 1024;
 constexpr size_t kMaxToFreeSizeThreshold = 8 * 1024;
 // Never exceed this value when increasing size for toFree set, triggering actual cycle collector.
 constexpr size_t kMaxErgonomicToFreeSizeThreshold = 8 * 1024 * 1024;
+// Rescan mature cycle candidates (survivors of a previous trial deletion) every Nth
+// cyclic collection; in between, collections scan only the young candidates.
+constexpr uint32_t kMatureScanFrequency = 8;
 // How many elements in finalizer queue allowed before cleaning it up.
 constexpr int32_t kFinalizerQueueThreshold = 32;
+// How many dead box-sized containers a thread keeps for reuse by allocContainer
+// instead of returning them to the allocator.
+constexpr int32_t kBoxPoolMaxSize = 64;
+// Same bound for the pool of dead weak-counter-sized containers.
+constexpr int32_t kCounterPoolMaxSize = 64;
 // If allocated that much memory since last GC - force new GC.
 constexpr size_t kMaxGcAllocThreshold = 8 * 1024 * 1024;
 // If the ratio of GC collection cycles time to program execution time is greater this value,
@@ -118,6 +188,17 @@ constexpr size_t kMaxGcAllocThreshold = 8 * 1024 * 1024;
 constexpr double kGcCollectCyclesLoadRatio = 0.3;
 // Minimum time of cycles collection to change thresholds.
 constexpr size_t kGcCollectCyclesMinimumDuration = 200;
+// Adaptive pacer defaults (see updateGcPacer()).
+// Pause budget a single collection shall fit into, microseconds.
+constexpr uint64_t kGcPacerDefaultPauseBudget = 2000;
+// Allowed heap growth between collections.
+constexpr double kGcPacerDefaultHeapGrowth = 1.5;
+// Never pace the allocation trigger below this, to not collect constantly at idle.
+constexpr uint64_t kGcPacerMinAllocThreshold = 64 * 1024;
+// Time budget of one incremental sweep slice, microseconds. When incremental GC is
+// on, non-forced collections stop draining release candidates once the slice is
+// spent and continue at the next allocation safepoint.
+constexpr uint64_t kGcIncrementalSliceMicros = 500;
 
 #endif  // USE_GC
 
@@ -591,12 +672,36 @@ private:
   }
 };
 
+#if USE_ALLOC_NURSERY
+// A bump-pointer chunk serving small container allocations of a single thread.
+// Allocation only happens on the owner thread, while freeing can come from any thread
+// (frozen and shared containers travel), so the live block counter is atomic and chunks
+// are looked up via a global registry.
+struct NurseryChunk {
+  uint8_t* start;
+  uint8_t* current;
+  uint8_t* end;
+  // Number of live blocks carved from this chunk, plus one reference held by the
+  // owner thread until it retires the chunk. Retirement and block frees all drop
+  // it with the same atomic decrement, so exactly one thread sees zero and
+  // releases the chunk.
+  int32_t live;
+};
+#endif  // USE_ALLOC_NURSERY
+
+struct ArenaScopeRecord;
+
 struct MemoryState {
 #if TRACE_MEMORY
   // Set of all containers.
   ContainerHeaderSet* containers;
 #endif
 
+#if USE_ALLOC_NURSERY
+  // Chunk currently served to small container allocations of this thread.
+  NurseryChunk* nursery;
+#endif
+
   KThreadLocalStorageMap* tlsMap;
   KRef* tlsMapLastStart;
   void* tlsMapLastKey;
@@ -606,6 +711,13 @@ struct MemoryState {
   ContainerHeader* finalizerQueue;
   int finalizerQueueSize;
   int finalizerQueueSuspendCount;
+  // Bounded linked list of dead box-sized containers kept for reuse
+  // by allocContainer, bypassing both the finalizer queue scan and the allocator.
+  ContainerHeader* boxPool;
+  int boxPoolSize;
+  // Ditto for dead weak-counter-sized containers.
+  ContainerHeader* counterPool;
+  int counterPoolSize;
   /*
    * Typical scenario for GC is as following:
    * we have 90% of objects with refcount = 0 which will be deleted during
@@ -616,6 +728,14 @@ struct MemoryState {
    */
   ContainerHeaderList* toFree; // List of all cycle candidates.
   ContainerHeaderList* roots; // Real candidates excluding those with refcount = 0.
+  // Cycle candidates that survived a trial deletion, i.e. the old part of the heap.
+  // The update barrier only sees a field address and cannot name the container owning
+  // it, so instead of an old-to-young location set the generational split lives on
+  // the candidate set itself: a later decrement re-colors a mature container purple
+  // in place (it stays buffered), and the set is rescanned only occasionally.
+  ContainerHeaderList* toFreeMature;
+  // Cyclic collections since the mature candidates were last rescanned.
+  uint32_t cyclicGcsSinceMatureScan;
   // How many GC suspend requests happened.
   int gcSuspendCount;
   // How many candidate elements in toRelease shall trigger collection.
@@ -626,6 +746,12 @@ struct MemoryState {
   bool gcInProgress;
   // Objects to be released.
   ContainerHeaderList* toRelease;
+  // Buffered rc increments of local containers, to be reconciled at the next safepoint.
+  // Only populated when [deferredRefCounting] is on.
+  ContainerHeaderList* toIncrement;
+  // If stack-originated rc updates of local containers shall be buffered in [toIncrement]
+  // instead of eagerly touching ContainerHeader::refCount_.
+  bool deferredRefCounting;
 
   ForeignRefManager* foreignRefManager;
 
@@ -634,6 +760,26 @@ struct MemoryState {
   uint64_t lastCyclicGcTimestamp;
   uint32_t gcEpoque;
 
+  // Adaptive pacer: when enabled it supersedes the coarse [gcErgonomics] tuning and
+  // rescales the thresholds after every collection (see updateGcPacer()).
+  bool gcPacer;
+  // Pause budget a collection shall fit into, microseconds.
+  uint64_t gcPacerPauseBudget;
+  // Allowed heap growth between collections under the observed allocation rate.
+  double gcPacerHeapGrowth;
+  // Exponential moving averages of pause time (microseconds) and of bytes allocated
+  // per GC cycle.
+  uint64_t gcPauseEwma;
+  uint64_t gcAllocPerCycleEwma;
+
+  // Incremental sweep: when on, non-forced collections drain the release candidates
+  // and cycle candidates in bounded time slices instead of running to completion.
+  // Forced collections always run to completion.
+  bool gcIncremental;
+  // Whether a budgeted slice left work behind, so allocation safepoints shall keep
+  // running slices until the backlog is drained (see checkIfGcNeeded()).
+  bool gcSweepPending;
+
   uint64_t allocSinceLastGc;
   uint64_t allocSinceLastGcThreshold;
 #endif // USE_GC
@@ -641,6 +787,26 @@ struct MemoryState {
   // A stack of initializing singletons.
   KStdVector<std::pair<ObjHeader**, ObjHeader*>> initializingSingletons;
 
+  // Innermost explicitly entered arena scope, if any.
+  // See EnterArenaScope/LeaveArenaScope.
+  ArenaScopeRecord* arenaScope;
+
+  // Allocations left on this thread until the allocation profiler takes the
+  // next sample. See profileAlloc().
+  uint32_t allocProfileCountdown;
+
+  // The frame chain of this thread at the moment the state was detached with
+  // SuspendMemory(), restored by ResumeMemory().
+  FrameOverlay* suspendedFrame;
+
+#ifdef KONAN_OBJC_INTEROP
+  // Associated objects of dead instances, whose release is deferred out of the
+  // deallocation hooks and drained in budgeted slices. See processDeferredReleases().
+  KStdVector<void*>* deferredAssociatedObjects;
+  // Guards against reentering the drain from Objective-C deallocation.
+  bool deferredReleaseInProgress;
+#endif
+
 #if COLLECT_STATISTIC
   #define CONTAINER_ALLOC_STAT(state, size, container) state->statistic.incAlloc(size, container);
   #define CONTAINER_DESTROY_STAT(state, container) \
@@ -733,6 +899,7 @@ void freeContainer(ContainerHeader* header) NO_INLINE;
 void garbageCollect(MemoryState* state, bool force) NO_INLINE;
 void cyclicGarbageCollect() NO_INLINE;
 void rememberNewContainer(ContainerHeader* container);
+void processDeferredIncrements(MemoryState* state);
 #endif  // USE_GC
 
 // Class representing arbitrary placement container.
@@ -775,8 +942,13 @@ class ObjectContainer : public Container {
 
 class ArrayContainer : public Container {
  public:
-  ArrayContainer(MemoryState* state, const TypeInfo* type_info, uint32_t elements) {
-    Init(state, type_info, elements);
+  // With zeroBody false the element area has undefined content; see
+  // AllocArrayInstanceUninitialized for the caller contract. A non-zero
+  // payloadAlignment puts the element data on that boundary; zero means the
+  // type's own TF_ALIGNED_PAYLOAD flag decides.
+  ArrayContainer(MemoryState* state, const TypeInfo* type_info, uint32_t elements, bool zeroBody = true,
+                 uint32_t payloadAlignment = 0) {
+    Init(state, type_info, elements, zeroBody, payloadAlignment);
   }
 
   // Array container shalln't have any dtor, as it's being freed by ::Release().
@@ -786,7 +958,8 @@ class ArrayContainer : public Container {
   }
 
  private:
-  void Init(MemoryState* state, const TypeInfo* type_info, uint32_t elements);
+  void Init(MemoryState* state, const TypeInfo* type_info, uint32_t elements, bool zeroBody,
+            uint32_t payloadAlignment);
 };
 
 // Class representing arena-style placement container.
@@ -837,6 +1010,17 @@ class ArenaContainer {
   uint32_t slotsCount_;
 };
 
+}  // namespace
+
+// An explicitly entered arena scope, see EnterArenaScope/LeaveArenaScope.
+// Scopes of one thread form a stack linked via [previous].
+struct ArenaScopeRecord {
+  ArenaContainer arena;
+  ArenaScopeRecord* previous;
+};
+
+namespace {
+
 constexpr int kFrameOverlaySlots = sizeof(FrameOverlay) / sizeof(ObjHeader**);
 
 inline bool isFreeable(const ContainerHeader* header) {
@@ -864,10 +1048,44 @@ inline ContainerHeader* clearRemoved(ContainerHeader* container) {
     reinterpret_cast<uintptr_t>(container) & ~static_cast<uintptr_t>(1));
 }
 
+// GC traversals chase container pointers which are rarely cache resident, so the
+// work queues below keep a short software prefetch horizon: on every pop the entry
+// a fixed distance from the head is prefetched, giving its header and the object
+// behind it time to arrive before their reference fields are chased.
+constexpr size_t kTraversalPrefetchDistance = 8;
+
+inline void prefetchContainer(ContainerHeader* container) {
+  container = clearRemoved(container);
+  __builtin_prefetch(container);
+  // Reference fields of the first object follow the header in the same block.
+  __builtin_prefetch(container + 1);
+}
+
+inline void prefetchQueuedContainers(const ContainerHeaderDeque& toVisit) {
+  if (toVisit.size() > kTraversalPrefetchDistance)
+    prefetchContainer(toVisit[kTraversalPrefetchDistance]);
+}
+
 inline container_size_t alignUp(container_size_t size, int alignment) {
   return (size + alignment - 1) & ~(alignment - 1);
 }
 
+// The dominant small container size: a single object with up to 8 bytes of
+// payload, which covers boxed primitives (Int, Long, Double and alike).
+constexpr container_size_t kBoxContainerSize =
+    (sizeof(ContainerHeader) + sizeof(ObjHeader) + 8 + kObjectAlignment - 1) &
+    ~(kObjectAlignment - 1);
+
+// The container size of a WeakReferenceCounter (see Weak.cpp: an object with a
+// referred pointer, a lock and a cookie). Every object that ever had a weak
+// reference allocates exactly one, so observer-heavy workloads churn through
+// them; they get their own pool. On targets where this coincides with
+// kBoxContainerSize the box pool simply absorbs them (the box size class is
+// checked first on both the pooling and the reuse path).
+constexpr container_size_t kWeakCounterContainerSize =
+    (sizeof(ContainerHeader) + sizeof(ObjHeader) + sizeof(KRef) + 2 * sizeof(KInt) +
+     kObjectAlignment - 1) & ~(kObjectAlignment - 1);
+
 inline ContainerHeader* realShareableContainer(ContainerHeader* container) {
   RuntimeAssert(container->shareable(), "Only makes sense on shareable objects");
   return containerFor(reinterpret_cast<ObjHeader*>(container + 1));
@@ -954,8 +1172,25 @@ inline bool isRefCounted(KConstRef object) {
   return isFreeable(containerFor(object));
 }
 
+inline void spinPause() {
+#if defined(__x86_64__) || defined(__i386__)
+  __asm__ __volatile__("pause");
+#elif defined(__arm__) || defined(__aarch64__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
 inline void lock(KInt* spinlock) {
-  while (compareAndSwap(spinlock, 0, 1) != 0) {}
+  // Test-and-test-and-set with bounded exponential backoff: contending threads
+  // spin on their own cached copy of the lock word and only attempt the CAS when
+  // it reads free, so the owner's line is not stormed by write attempts.
+  uint32_t backoff = 1;
+  while (compareAndSwap(spinlock, 0, 1) != 0) {
+    do {
+      for (uint32_t i = 0; i < backoff; i++) spinPause();
+      if (backoff < 64) backoff <<= 1;
+    } while (atomicGet(spinlock) != 0);
+  }
 }
 
 inline void unlock(KInt* spinlock) {
@@ -981,11 +1216,245 @@ inline bool isFreezableAtomic(ContainerHeader* container) {
   return isFreezableAtomic(obj);
 }
 
-ContainerHeader* allocContainer(MemoryState* state, size_t size) {
+#if USE_ALLOC_NURSERY
+
+// Registry of all nursery chunks, so that a freeing thread can tell nursery blocks
+// from regular allocations. Scanned linearly: there's about one chunk per thread.
+KInt nurseryRegistryLock = 0;
+KStdVector<NurseryChunk*>* nurseryRegistry = nullptr;
+
+NurseryChunk* nurseryChunkFor(void* block) {
+  auto* address = reinterpret_cast<uint8_t*>(block);
+  lock(&nurseryRegistryLock);
+  NurseryChunk* result = nullptr;
+  if (nurseryRegistry != nullptr) {
+    for (auto* chunk : *nurseryRegistry) {
+      if (address >= chunk->start && address < chunk->end) {
+        result = chunk;
+        break;
+      }
+    }
+  }
+  unlock(&nurseryRegistryLock);
+  return result;
+}
+
+NurseryChunk* nurseryNewChunk() {
+  auto* chunk = konanConstructInstance<NurseryChunk>();
+  chunk->start = reinterpret_cast<uint8_t*>(konanAllocMemory(kNurseryChunkSize));
+  chunk->current = chunk->start;
+  chunk->end = chunk->start + kNurseryChunkSize;
+  // The owner's reference, dropped by nurseryRetireChunk.
+  chunk->live = 1;
+  lock(&nurseryRegistryLock);
+  if (nurseryRegistry == nullptr)
+    nurseryRegistry = konanConstructInstance<KStdVector<NurseryChunk*>>();
+  nurseryRegistry->push_back(chunk);
+  unlock(&nurseryRegistryLock);
+  return chunk;
+}
+
+void nurseryReleaseChunk(NurseryChunk* chunk) {
+  lock(&nurseryRegistryLock);
+  for (auto it = nurseryRegistry->begin(); it != nurseryRegistry->end(); ++it) {
+    if (*it == chunk) {
+      nurseryRegistry->erase(it);
+      break;
+    }
+  }
+  unlock(&nurseryRegistryLock);
+  konanFreeMemory(chunk->start);
+  konanDestructInstance(chunk);
+}
+
+// Retires the current nursery chunk of [state]: no more allocations are served from it,
+// and it is released as soon as the last live block is freed. Dropping the owner's
+// reference with the same decrement concurrent freers use guarantees a single release
+// even when the last block is freed from another thread at the same time.
+void nurseryRetireChunk(MemoryState* state) {
+  auto* chunk = state->nursery;
+  if (chunk == nullptr) return;
+  state->nursery = nullptr;
+  if (atomicAdd(&chunk->live, -1) == 0)
+    nurseryReleaseChunk(chunk);
+}
+
+ContainerHeader* nurseryAlloc(MemoryState* state, container_size_t size) {
+  auto* chunk = state->nursery;
+  if (chunk != nullptr && chunk->current + size > chunk->end) {
+    // Overflow: survivors pin the old chunk until they die, new allocations
+    // switch to a fresh one.
+    nurseryRetireChunk(state);
+    chunk = nullptr;
+  }
+  if (chunk == nullptr) {
+    chunk = nurseryNewChunk();
+    state->nursery = chunk;
+  }
+  auto* result = reinterpret_cast<ContainerHeader*>(chunk->current);
+  chunk->current += size;
+  atomicAdd(&chunk->live, 1);
+  memset(result, 0, size);
+  return result;
+}
+
+#endif  // USE_ALLOC_NURSERY
+
+#if USE_MMAP_CONTAINERS
+
+KInt mmapRegistryLock = 0;
+// All currently live mmapped containers with their mapped (page-aligned) sizes.
+KStdUnorderedMap<void*, size_t>* mmapRegistry = nullptr;
+// Free ranges cached for reuse; their pages were handed back with madvise().
+KStdVector<std::pair<void*, size_t>>* mmapFreeRegions = nullptr;
+size_t mmapPageSize = 0;
+// Stats reported via Kotlin_native_internal_GC, separately from the regular heap.
+uint64_t mmappedContainerBytes = 0;
+// How many of those bytes live in ranges advised to use huge pages: one 2MB TLB
+// entry covers what 512 base-page entries would, which is where traversals of
+// multi-gigabyte heaps lose their cycles.
+uint64_t hugePageAdvisedBytes = 0;
+volatile int mmappedContainerCount = 0;
+
+ContainerHeader* mmapContainer(size_t size) {
+  if (mmapPageSize == 0)
+    mmapPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t mappedSize = (size + mmapPageSize - 1) & ~(mmapPageSize - 1);
+  bool huge = false;
+#ifdef MADV_HUGEPAGE
+  // Pad big mappings to huge page granularity, so the kernel can back the whole
+  // range with huge pages; the predicate is recomputable from the size on free.
+  if (mappedSize >= kHugePageSize) {
+    mappedSize = (mappedSize + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    huge = true;
+  }
+#endif
+  void* memory = nullptr;
+  lock(&mmapRegistryLock);
+  if (mmapFreeRegions != nullptr) {
+    for (auto it = mmapFreeRegions->begin(); it != mmapFreeRegions->end(); ++it) {
+      if (it->second == mappedSize) {
+        memory = it->first;
+        mmapFreeRegions->erase(it);
+        break;
+      }
+    }
+  }
+  unlock(&mmapRegistryLock);
+  if (memory != nullptr) {
+    // Replace the cached pages wholesale: this guarantees zero-filled contents
+    // without touching them, whatever the madvise() on free left behind.
+    memory = mmap(memory, mappedSize, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if (memory == MAP_FAILED) memory = nullptr;
+  }
+  if (memory == nullptr) {
+    memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return nullptr;
+  }
+#ifdef MADV_HUGEPAGE
+  // Advise on both paths: the MAP_FIXED replacement above discards any huge pages
+  // the previous tenant of the range had collapsed.
+  if (huge)
+    madvise(memory, mappedSize, MADV_HUGEPAGE);
+#endif
+  lock(&mmapRegistryLock);
+  if (mmapRegistry == nullptr)
+    mmapRegistry = konanConstructInstance<KStdUnorderedMap<void*, size_t>>();
+  (*mmapRegistry)[memory] = mappedSize;
+  mmappedContainerBytes += mappedSize;
+  if (huge) hugePageAdvisedBytes += mappedSize;
+  atomicAdd(&mmappedContainerCount, 1);
+  unlock(&mmapRegistryLock);
+  return reinterpret_cast<ContainerHeader*>(memory);
+}
+
+bool freeMmappedContainer(ContainerHeader* container) {
+  // Cheap prefilter: nothing is mmapped, or the address cannot be a mapping.
+  if (atomicGet(&mmappedContainerCount) == 0) return false;
+  if ((reinterpret_cast<uintptr_t>(container) & (mmapPageSize - 1)) != 0) return false;
+  size_t mappedSize = 0;
+  bool cached = false;
+  lock(&mmapRegistryLock);
+  auto it = mmapRegistry->find(container);
+  if (it == mmapRegistry->end()) {
+    unlock(&mmapRegistryLock);
+    return false;
+  }
+  mappedSize = it->second;
+  mmapRegistry->erase(it);
+  mmappedContainerBytes -= mappedSize;
+#ifdef MADV_HUGEPAGE
+  // Advised mappings were padded to huge page granularity, so the size predicate
+  // reconstructs the decision made at allocation time.
+  if (mappedSize >= kHugePageSize) hugePageAdvisedBytes -= mappedSize;
+#endif
+  atomicAdd(&mmappedContainerCount, -1);
+  if (mmapFreeRegions == nullptr)
+    mmapFreeRegions = konanConstructInstance<KStdVector<std::pair<void*, size_t>>>();
+  if (mmapFreeRegions->size() < kMaxCachedMmapRegions) {
+    mmapFreeRegions->push_back(std::make_pair(reinterpret_cast<void*>(container), mappedSize));
+    cached = true;
+  }
+  unlock(&mmapRegistryLock);
+  if (cached) {
+    // Let the OS reclaim the pages lazily while the range stays reserved for reuse.
+#ifdef MADV_FREE
+    madvise(container, mappedSize, MADV_FREE);
+#else
+    madvise(container, mappedSize, MADV_DONTNEED);
+#endif
+  } else {
+    munmap(container, mappedSize);
+  }
+  return true;
+}
+
+#endif  // USE_MMAP_CONTAINERS
+
+// Returns the underlying memory of a container to where it was carved from.
+void freeContainerMemory(ContainerHeader* container) {
+#if USE_ALLOC_NURSERY
+  auto* chunk = nurseryChunkFor(container);
+  if (chunk != nullptr) {
+    if (atomicAdd(&chunk->live, -1) == 0)
+      nurseryReleaseChunk(chunk);
+    return;
+  }
+#endif  // USE_ALLOC_NURSERY
+#if USE_MMAP_CONTAINERS
+  if (freeMmappedContainer(container)) return;
+#endif  // USE_MMAP_CONTAINERS
+  konanFreeMemory(container);
+}
+
+// With zeroBody false only the container and object headers come out zeroed;
+// the rest of the block has undefined content the caller promised to overwrite.
+// Recycling paths that re-zero whole blocks anyway are unaffected.
+ContainerHeader* allocContainer(MemoryState* state, size_t size, bool zeroBody = true) {
  ContainerHeader* result = nullptr;
+  CounterRecordAllocation(size);
 #if USE_GC
+  // Box- and weak-counter-sized requests are served from the per-thread pools
+  // of dead containers of that size first.
+  if (state != nullptr && state->boxPool != nullptr &&
+      alignUp(size, kObjectAlignment) == kBoxContainerSize) {
+    result = state->boxPool;
+    state->boxPool = result->nextLink();
+    state->boxPoolSize--;
+    memset(result, 0, kBoxContainerSize);
+    MEMORY_LOG("box pool reuse %p for request %d\n", result, size)
+  } else if (state != nullptr && state->counterPool != nullptr &&
+      alignUp(size, kObjectAlignment) == kWeakCounterContainerSize) {
+    result = state->counterPool;
+    state->counterPool = result->nextLink();
+    state->counterPoolSize--;
+    memset(result, 0, kWeakCounterContainerSize);
+    MEMORY_LOG("counter pool reuse %p for request %d\n", result, size)
+  }
   // We recycle elements of finalizer queue for new allocations, to avoid trashing memory manager.
-  ContainerHeader* container = state != nullptr ? state->finalizerQueue : nullptr;
+  ContainerHeader* container = (state != nullptr && result == nullptr) ? state->finalizerQueue : nullptr;
   ContainerHeader* previous = nullptr;
   while (container != nullptr) {
     // TODO: shall it be == instead?
@@ -998,19 +1467,50 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
       else
         previous->setNextLink(container->nextLink());
       state->finalizerQueueSize--;
-      memset(container, 0, size);
+      memset(container, 0, zeroBody ? size : sizeof(ContainerHeader) + sizeof(ArrayHeader));
       break;
     }
     previous = container;
     container = container->nextLink();
   }
 #endif
+#if USE_MMAP_CONTAINERS
+  if (result == nullptr && size >= kMmapContainerThreshold) {
+    result = mmapContainer(alignUp(size, kObjectAlignment));
+    if (result != nullptr) {
+#if USE_GC
+      if (state != nullptr)
+        state->allocSinceLastGc += size;
+#endif
+      atomicAdd(&allocCount, 1);
+    }
+    // On mmap failure fall through to the general allocator.
+  }
+#endif  // USE_MMAP_CONTAINERS
+#if USE_ALLOC_NURSERY
+  if (result == nullptr && state != nullptr && size <= kNurseryMaxBlockSize) {
+#if USE_GC
+    state->allocSinceLastGc += size;
+#endif
+    result = nurseryAlloc(state, alignUp(size, kObjectAlignment));
+    atomicAdd(&allocCount, 1);
+  }
+#endif  // USE_ALLOC_NURSERY
   if (result == nullptr) {
 #if USE_GC
     if (state != nullptr)
         state->allocSinceLastGc += size;
 #endif
-    result = konanConstructSizedInstance<ContainerHeader>(alignUp(size, kObjectAlignment));
+    if (zeroBody) {
+      result = konanConstructSizedInstance<ContainerHeader>(alignUp(size, kObjectAlignment));
+    } else {
+      // This is the branch the elision actually pays off in: fresh memory from
+      // the general allocator without calloc's memset. The mmap and nursery
+      // branches above always hand out already-zeroed memory.
+      result = static_cast<ContainerHeader*>(konanAllocUninitializedMemory(alignUp(size, kObjectAlignment)));
+      if (result != nullptr)
+        memset(result, 0, sizeof(ContainerHeader) + sizeof(ArrayHeader));
+    }
     atomicAdd(&allocCount, 1);
   }
   if (state != nullptr) {
@@ -1022,6 +1522,31 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
   return result;
 }
 
+// Aligned variant of allocContainer: the block is padded to [alignment] and
+// placed so that the address [payloadOffset] bytes in is aligned (0 aligns the
+// container itself, the array element offset aligns the element data). Skips
+// the recycling fronts, whose blocks carry no alignment guarantee; the backing
+// allocator frees offset-aligned blocks through the regular free, so
+// freeContainer needs no special case.
+ContainerHeader* allocAlignedContainer(MemoryState* state, size_t size,
+                                       container_size_t alignment, container_size_t payloadOffset) {
+  CounterRecordAllocation(size);
+#if USE_GC
+  if (state != nullptr)
+    state->allocSinceLastGc += size;
+#endif
+  auto* result = static_cast<ContainerHeader*>(
+      konanAllocAlignedMemory(alignUp(size, alignment), alignment, payloadOffset));
+  atomicAdd(&allocCount, 1);
+  if (state != nullptr) {
+    CONTAINER_ALLOC_EVENT(state, size, result);
+#if TRACE_MEMORY
+    state->containers->insert(result);
+#endif
+  }
+  return result;
+}
+
 ContainerHeader* allocAggregatingFrozenContainer(KStdVector<ContainerHeader*>& containers) {
   auto componentSize = containers.size();
   auto* superContainer = allocContainer(memoryState, sizeof(ContainerHeader) + sizeof(void*) * componentSize);
@@ -1041,17 +1566,153 @@ ContainerHeader* allocAggregatingFrozenContainer(KStdVector<ContainerHeader*>& c
 
 #if USE_GC
 
+#if USE_PARALLEL_SWEEP
+
+// Lazily started team of helper threads freeing shares of the finalizer queue. By the
+// time containers reach the queue all children releases and finalizers already ran, so
+// shares only return memory and can be freed concurrently.
+pthread_mutex_t sweepTeamLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t sweepTeamStartCond = PTHREAD_COND_INITIALIZER;
+pthread_cond_t sweepTeamDoneCond = PTHREAD_COND_INITIALIZER;
+ContainerHeader* sweepTeamWork[kSweepTeamSize] = {};
+int sweepTeamPending = 0;
+bool sweepTeamStarted = false;
+bool sweepTeamFailed = false;
+
+void sweepFreeList(ContainerHeader* head) {
+  while (head != nullptr) {
+    auto* container = head;
+    head = container->nextLink();
+    freeContainerMemory(container);
+    atomicAdd(&allocCount, -1);
+  }
+}
+
+void* sweepTeamRoutine(void* argument) {
+  int index = static_cast<int>(reinterpret_cast<intptr_t>(argument));
+  while (true) {
+    pthread_mutex_lock(&sweepTeamLock);
+    while (sweepTeamWork[index] == nullptr)
+      pthread_cond_wait(&sweepTeamStartCond, &sweepTeamLock);
+    auto* work = sweepTeamWork[index];
+    pthread_mutex_unlock(&sweepTeamLock);
+    sweepFreeList(work);
+    pthread_mutex_lock(&sweepTeamLock);
+    sweepTeamWork[index] = nullptr;
+    if (--sweepTeamPending == 0)
+      pthread_cond_signal(&sweepTeamDoneCond);
+    pthread_mutex_unlock(&sweepTeamLock);
+  }
+  return nullptr;
+}
+
+// Returns false if the queue shall be freed serially instead: the team could not be
+// started, or is still busy with a share handed out by another thread's GC.
+bool parallelProcessFinalizerQueue(MemoryState* state) {
+  pthread_mutex_lock(&sweepTeamLock);
+  if (!sweepTeamStarted && !sweepTeamFailed) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (int i = 0; i < kSweepTeamSize; i++) {
+      pthread_t thread;
+      if (pthread_create(&thread, &attr, sweepTeamRoutine, reinterpret_cast<void*>(static_cast<intptr_t>(i))) != 0) {
+        sweepTeamFailed = true;
+        break;
+      }
+    }
+    pthread_attr_destroy(&attr);
+    if (!sweepTeamFailed) sweepTeamStarted = true;
+  }
+  if (sweepTeamFailed || sweepTeamPending != 0) {
+    pthread_mutex_unlock(&sweepTeamLock);
+    return false;
+  }
+  pthread_mutex_unlock(&sweepTeamLock);
+
+  // Detach the queue and cut equal shares for the team with a single walk; the
+  // remainder, including the division rest, is freed by this thread.
+  size_t total = state->finalizerQueueSize;
+  ContainerHeader* current = state->finalizerQueue;
+  state->finalizerQueue = nullptr;
+  state->finalizerQueueSize = 0;
+  size_t share = total / (kSweepTeamSize + 1);
+  ContainerHeader* shares[kSweepTeamSize];
+  for (int i = 0; i < kSweepTeamSize; i++) {
+    shares[i] = current;
+    for (size_t skipped = 1; skipped < share; skipped++)
+      current = current->nextLink();
+    auto* last = current;
+    current = current->nextLink();
+    last->setNextLink(nullptr);
+  }
+
+  pthread_mutex_lock(&sweepTeamLock);
+  for (int i = 0; i < kSweepTeamSize; i++)
+    sweepTeamWork[i] = shares[i];
+  sweepTeamPending = kSweepTeamSize;
+  pthread_cond_broadcast(&sweepTeamStartCond);
+  pthread_mutex_unlock(&sweepTeamLock);
+
+  sweepFreeList(current);
+
+  pthread_mutex_lock(&sweepTeamLock);
+  while (sweepTeamPending != 0)
+    pthread_cond_wait(&sweepTeamDoneCond, &sweepTeamLock);
+  pthread_mutex_unlock(&sweepTeamLock);
+  return true;
+}
+
+#endif  // USE_PARALLEL_SWEEP
+
+// Returns true if the dead container was kept in one of the per-thread
+// uniform-size pools (boxes or weak counters). Like recycling from the
+// finalizer queue, a pooled container stays accounted as allocated until it is
+// either reused or drained in deinitMemory.
+bool tryPoolSmallContainer(MemoryState* state, ContainerHeader* container) {
+  if (!container->hasContainerSize()) return false;
+  auto alignedSize = alignUp(container->containerSize(), kObjectAlignment);
+  ContainerHeader** pool;
+  int* poolSize;
+  if (alignedSize == kBoxContainerSize && state->boxPoolSize < kBoxPoolMaxSize) {
+    pool = &state->boxPool;
+    poolSize = &state->boxPoolSize;
+  } else if (alignedSize == kWeakCounterContainerSize &&
+             state->counterPoolSize < kCounterPoolMaxSize) {
+    pool = &state->counterPool;
+    poolSize = &state->counterPoolSize;
+  } else {
+    return false;
+  }
+#if USE_ALLOC_NURSERY
+  // Nursery blocks are accounted to their chunk and must be returned through it.
+  if (nurseryChunkFor(container) != nullptr) return false;
+#endif
+  container->setNextLink(*pool);
+  *pool = container;
+  (*poolSize)++;
+  MEMORY_LOG("pool keeps %p of size %d\n", container, alignedSize)
+  return true;
+}
+
 void processFinalizerQueue(MemoryState* state) {
+#if USE_PARALLEL_SWEEP
+  if (state->finalizerQueueSize >= kParallelSweepThreshold && parallelProcessFinalizerQueue(state)) {
+    RuntimeAssert(state->finalizerQueueSize == 0, "Queue must be empty here");
+    return;
+  }
+#endif  // USE_PARALLEL_SWEEP
   // TODO: reuse elements of finalizer queue for new allocations.
   while (state->finalizerQueue != nullptr) {
     auto* container = state->finalizerQueue;
     state->finalizerQueue = container->nextLink();
     state->finalizerQueueSize--;
+    if (tryPoolSmallContainer(state, container)) continue;
 #if TRACE_MEMORY
     state->containers->erase(container);
 #endif
     CONTAINER_DESTROY_EVENT(state, container)
-    konanFreeMemory(container);
+    freeContainerMemory(container);
     atomicAdd(&allocCount, -1);
   }
   RuntimeAssert(state->finalizerQueueSize == 0, "Queue must be empty here");
@@ -1063,6 +1724,7 @@ bool hasExternalRefs(ContainerHeader* start, ContainerHeaderSet* visited) {
   while (!toVisit.empty()) {
     auto* container = toVisit.front();
     toVisit.pop_front();
+    prefetchQueuedContainers(toVisit);
     visited->insert(container);
     if (container->refCount() > 0) {
       MEMORY_LOG("container %p with rc %d blocks transfer\n", container, container->refCount())
@@ -1092,7 +1754,7 @@ void scheduleDestroyContainer(MemoryState* state, ContainerHeader* container) {
     processFinalizerQueue(state);
   }
 #else
-  konanFreeMemory(container);
+  freeContainerMemory(container);
   atomicAdd(&allocCount, -1);
   CONTAINER_DESTROY_EVENT(state, container);
 #endif
@@ -1133,6 +1795,86 @@ NO_INLINE RUNTIME_NOTHROW void runFinalizers(ObjHeader* obj) {
     }
 }
 
+KInt deathHooksLock = 0;
+
+// Runs and frees the death hooks of a dying object. The list is detached under
+// the lock, but the hooks themselves run outside of it, so they may touch the
+// structures that register and remove hooks (e.g. a weak-keyed table clearing
+// its entry for the dying key).
+void runObjectDeathHooks(MetaObjHeader* meta) {
+  if (meta->DeathHooks.head_ == nullptr) return;
+  lock(&deathHooksLock);
+  ObjectDeathHook* node = meta->DeathHooks.head_;
+  meta->DeathHooks.head_ = nullptr;
+  unlock(&deathHooksLock);
+  while (node != nullptr) {
+    node->hook_(node->entry_);
+    ObjectDeathHook* next = node->next_;
+    konanFreeMemory(node);
+    node = next;
+  }
+}
+
+// Like ObjHeader::destroyMetaObject, but hands the associated object to the
+// per-thread deferred list instead of releasing it inline: clearing weak
+// counters must stay prompt, while releasing an associated object runs
+// arbitrary Objective-C deallocation and is drained in budgeted slices outside
+// the hook loop (see processDeferredReleases()), so one slow release does not
+// stall thousands of trivial frees.
+void destroyMetaObjectDeferring(TypeInfo** location) {
+  MetaObjHeader* meta = clearPointerBits(*(reinterpret_cast<MetaObjHeader**>(location)), OBJECT_TAG_MASK);
+  *const_cast<const TypeInfo**>(location) = meta->typeInfo_;
+  if (meta->WeakReference.counter_ != nullptr) {
+    WeakReferenceCounterClear(meta->WeakReference.counter_);
+    ZeroHeapRef(&meta->WeakReference.counter_);
+  }
+  runObjectDeathHooks(meta);
+
+#ifdef KONAN_OBJC_INTEROP
+  if (meta->associatedObject_ != nullptr) {
+    auto* deferred = memoryState->deferredAssociatedObjects;
+    if (deferred != nullptr) {
+      deferred->push_back(meta->associatedObject_);
+      meta->associatedObject_ = nullptr;
+    } else {
+      Kotlin_ObjCExport_releaseAssociatedObject(meta->associatedObject_);
+    }
+  }
+#endif
+
+  konanFreeMemory(meta);
+}
+
+#ifdef KONAN_OBJC_INTEROP
+
+// Time budget one drain slice may spend releasing deferred associated objects.
+constexpr uint64_t kDeferredReleaseBudgetMicros = 500;
+
+// Releases associated objects deferred by the deallocation hooks, at most
+// roughly [budgetMicros] worth per call (0 means drain everything). Reentrant
+// calls are skipped: an Objective-C dealloc may run Kotlin code that frees
+// containers again.
+void processDeferredReleases(MemoryState* state, uint64_t budgetMicros) {
+  auto* deferred = state->deferredAssociatedObjects;
+  if (deferred == nullptr || deferred->empty() || state->deferredReleaseInProgress) return;
+  state->deferredReleaseInProgress = true;
+  uint64_t startTime = konan::getTimeMicros();
+  int sinceClockCheck = 0;
+  while (!deferred->empty()) {
+    void* associatedObject = deferred->back();
+    deferred->pop_back();
+    Kotlin_ObjCExport_releaseAssociatedObject(associatedObject);
+    // Check the clock only every few releases, it is not free either.
+    if (budgetMicros != 0 && ++sinceClockCheck >= 16) {
+      sinceClockCheck = 0;
+      if (konan::getTimeMicros() - startTime >= budgetMicros) break;
+    }
+  }
+  state->deferredReleaseInProgress = false;
+}
+
+#endif  // KONAN_OBJC_INTEROP
+
 // This is called from 2 places where it's unconditionally called,
 // so better be inlined.
 ALWAYS_INLINE void runDeallocationHooks(ContainerHeader* container) {
@@ -1151,7 +1893,7 @@ ALWAYS_INLINE void runDeallocationHooks(ContainerHeader* container) {
     CycleDetector::removeCandidateIfNeeded(obj);
 #endif  // USE_CYCLE_DETECTOR
     if (obj->has_meta_object()) {
-      ObjHeader::destroyMetaObject(&obj->typeInfoOrMeta_);
+      destroyMetaObjectDeferring(&obj->typeInfoOrMeta_);
     }
     obj = reinterpret_cast<ObjHeader*>(reinterpret_cast<uintptr_t>(obj) + objectSize(obj));
   }
@@ -1196,6 +1938,7 @@ void depthFirstTraversal(ContainerHeader* start, bool* hasCycles,
   while (!toVisit.empty()) {
     auto* container = toVisit.front();
     toVisit.pop_front();
+    prefetchQueuedContainers(toVisit);
     if (isMarkedAsRemoved(container)) {
       container = clearRemoved(container);
       // Mark BLACK.
@@ -1246,6 +1989,7 @@ void traverseStronglyConnectedComponent(ContainerHeader* start,
   while (!toVisit.empty()) {
     auto* container = toVisit.front();
     toVisit.pop_front();
+    prefetchQueuedContainers(toVisit);
     component->push_back(container);
     auto it = reversedEdges->find(container);
     RuntimeAssert(it != reversedEdges->end(), "unknown node during condensation building");
@@ -1267,11 +2011,13 @@ inline bool tryIncrementRC(ContainerHeader* container) {
 
 template <bool Atomic>
 inline void incrementRC(ContainerHeader* container) {
+  if (Atomic) CounterIncrement(RTC_RC_ATOMIC_INC);
   container->incRefCount<Atomic>();
 }
 
 template <bool Atomic, bool UseCycleCollector>
 inline void decrementRC(ContainerHeader* container) {
+  if (Atomic) CounterIncrement(RTC_RC_ATOMIC_DEC);
   if (container->decRefCount<Atomic>() == 0) {
     freeContainer(container);
   }
@@ -1289,15 +2035,22 @@ inline void enqueueDecrementRC(ContainerHeader* container) {
   RuntimeCheck(false, "Not yet implemeneted");
 }
 
+template <bool CanCollect>
+inline void enqueueDecrementRC(MemoryState* state, ContainerHeader* container) {
+  RuntimeCheck(false, "Not yet implemeneted");
+}
+
 #else // USE_GC
 
 template <bool Atomic>
 inline void incrementRC(ContainerHeader* container) {
+  if (Atomic) CounterIncrement(RTC_RC_ATOMIC_INC);
   container->incRefCount<Atomic>();
 }
 
 template <bool Atomic, bool UseCycleCollector>
 inline void decrementRC(ContainerHeader* container) {
+  if (Atomic) CounterIncrement(RTC_RC_ATOMIC_DEC);
   // TODO: enable me, once account for inner references in frozen objects correctly.
   // RuntimeAssert(container->refCount() > 0, "Must be positive");
   if (container->decRefCount<Atomic>() == 0) {
@@ -1356,8 +2109,7 @@ inline void decrementRC(ContainerHeader* container) {
 }
 
 template <bool CanCollect>
-inline void enqueueDecrementRC(ContainerHeader* container) {
-  auto* state = memoryState;
+inline void enqueueDecrementRC(MemoryState* state, ContainerHeader* container) {
   if (CanCollect) {
     if (state->toRelease->size() >= state->gcThreshold && state->gcSuspendCount == 0) {
       GC_LOG("Calling GC from EnqueueDecrementRC: %d\n", state->toRelease->size())
@@ -1367,6 +2119,11 @@ inline void enqueueDecrementRC(ContainerHeader* container) {
   state->toRelease->push_back(container);
 }
 
+template <bool CanCollect>
+inline void enqueueDecrementRC(ContainerHeader* container) {
+  enqueueDecrementRC<CanCollect>(memoryState, container);
+}
+
 inline void initGcThreshold(MemoryState* state, uint32_t gcThreshold) {
   state->gcThreshold = gcThreshold;
   state->toRelease->reserve(gcThreshold);
@@ -1391,6 +2148,30 @@ inline void increaseGcCollectCyclesThreshold(MemoryState* state) {
   }
 }
 
+// Proportional pacer, fed with allocation rate and pause history after every
+// collection: the element threshold is scaled towards the pause budget (longer
+// pauses mean smaller, more frequent collections and vice versa), the allocation
+// trigger is scaled so the heap grows at most by the configured factor per cycle
+// at the observed allocation rate. Both adjustments are damped by EWMAs and bounded
+// by the same limits the manual tuning obeys.
+void updateGcPacer(MemoryState* state, uint64_t pauseMicros, uint64_t allocatedBytes) {
+  state->gcPauseEwma = (state->gcPauseEwma * 3 + pauseMicros) / 4;
+  state->gcAllocPerCycleEwma = (state->gcAllocPerCycleEwma * 3 + allocatedBytes) / 4;
+
+  uint64_t newThreshold = state->gcThreshold * state->gcPacerPauseBudget / (state->gcPauseEwma + 1);
+  if (newThreshold < kGcThreshold) newThreshold = kGcThreshold;
+  if (newThreshold > kMaxErgonomicThreshold) newThreshold = kMaxErgonomicThreshold;
+  if (newThreshold != state->gcThreshold) {
+    initGcThreshold(state, newThreshold);
+    GC_LOG("Pacer: threshold %d, pause EWMA %lld\n", state->gcThreshold, state->gcPauseEwma)
+  }
+
+  uint64_t newAllocThreshold = static_cast<uint64_t>(state->gcAllocPerCycleEwma * state->gcPacerHeapGrowth);
+  if (newAllocThreshold < kGcPacerMinAllocThreshold) newAllocThreshold = kGcPacerMinAllocThreshold;
+  if (newAllocThreshold > kMaxGcAllocThreshold) newAllocThreshold = kMaxGcAllocThreshold;
+  state->allocSinceLastGcThreshold = newAllocThreshold;
+}
+
 #endif // USE_GC
 
 #if TRACE_MEMORY && USE_GC
@@ -1463,7 +2244,7 @@ void dumpReachable(const char* prefix, const ContainerHeaderSet* roots) {
 
 void markRoots(MemoryState*);
 void scanRoots(MemoryState*);
-void collectRoots(MemoryState*);
+void collectRoots(MemoryState*, bool tenureSurvivors);
 void scan(ContainerHeader* container);
 
 template <bool useColor>
@@ -1475,6 +2256,7 @@ void markGray(ContainerHeader* start) {
     auto* container = toVisit.front();
     MEMORY_LOG("MarkGray visit %p [%s]\n", container, colorNames[container->color()]);
     toVisit.pop_front();
+    prefetchQueuedContainers(toVisit);
     if (useColor) {
       int color = container->color();
       if (color == CONTAINER_TAG_GC_GRAY) continue;
@@ -1508,6 +2290,7 @@ void scanBlack(ContainerHeader* start) {
     auto* container = toVisit.front();
     MEMORY_LOG("ScanBlack visit %p [%s]\n", container, colorNames[container->color()]);
     toVisit.pop_front();
+    prefetchQueuedContainers(toVisit);
     if (useColor) {
       auto color = container->color();
       if (color == CONTAINER_TAG_GC_GREEN || color == CONTAINER_TAG_GC_BLACK) continue;
@@ -1536,10 +2319,10 @@ void scanBlack(ContainerHeader* start) {
 
 void collectWhite(MemoryState*, ContainerHeader* container);
 
-void collectCycles(MemoryState* state) {
+void collectCycles(MemoryState* state, bool tenureSurvivors) {
   markRoots(state);
   scanRoots(state);
-  collectRoots(state);
+  collectRoots(state, tenureSurvivors);
   state->toFree->clear();
   state->roots->clear();
 }
@@ -1571,11 +2354,19 @@ void scanRoots(MemoryState* state) {
   }
 }
 
-void collectRoots(MemoryState* state) {
+void collectRoots(MemoryState* state, bool tenureSurvivors) {
   // Here we might free some objects and call deallocation hooks on them,
   // which in turn might call DecrementRC and trigger new GC - forbid that.
   state->gcSuspendCount++;
   for (auto* container : *(state->roots)) {
+    if (tenureSurvivors && container->color() == CONTAINER_TAG_GC_BLACK &&
+        container->refCount() != 0) {
+      // The candidate survived the trial deletion: tenure it. It stays buffered, so
+      // later decrements only re-color it purple in place instead of re-queueing it,
+      // and it is rescanned when the mature set is next folded in.
+      state->toFreeMature->push_back(container);
+      continue;
+    }
     container->resetBuffered();
     collectWhite(state, container);
   }
@@ -1589,6 +2380,7 @@ void scan(ContainerHeader* start) {
   while (!toVisit.empty()) {
      auto* container = toVisit.front();
      toVisit.pop_front();
+     prefetchQueuedContainers(toVisit);
      if (container->color() != CONTAINER_TAG_GC_GRAY) continue;
      if (container->refCount() != 0) {
        scanBlack<true>(container);
@@ -1612,6 +2404,7 @@ void collectWhite(MemoryState* state, ContainerHeader* start) {
    while (!toVisit.empty()) {
      auto* container = toVisit.front();
      toVisit.pop_front();
+     prefetchQueuedContainers(toVisit);
      if (container->color() != CONTAINER_TAG_GC_WHITE || container->buffered()) continue;
      container->setColorAssertIfGreen(CONTAINER_TAG_GC_BLACK);
      traverseContainerObjectFields(container, [&toVisit](ObjHeader** location) {
@@ -1641,13 +2434,27 @@ inline bool canBeCyclic(ContainerHeader* container) {
   return true;
 }
 
-inline void addHeapRef(ContainerHeader* container) {
+// The workhorse takes the memory state explicitly so that entry points which
+// already hold it (the WithState family, bulk updates) do not pay for repeated
+// thread-local lookups; the stateless overloads below fetch it once and delegate.
+inline void addHeapRef(MemoryState* state, ContainerHeader* container) {
   MEMORY_LOG("AddHeapRef %p: rc=%d\n", container, container->refCount())
-  UPDATE_ADDREF_STAT(memoryState, container, needAtomicAccess(container), 0)
+  UPDATE_ADDREF_STAT(state, container, needAtomicAccess(container), 0)
   switch (container->tag()) {
     case CONTAINER_TAG_STACK:
       break;
     case CONTAINER_TAG_LOCAL:
+#if USE_GC
+      if (state != nullptr && state->deferredRefCounting) {
+        // Hot path of the deferred mode: do not touch refCount_ at all, just log the increment.
+        // Note: with pending increments actual refCount_ only underestimates the real value,
+        // so the "reclaimed object" assert does not apply here.
+        state->toIncrement->push_back(container);
+        if (state->toIncrement->size() >= state->gcThreshold && !state->gcInProgress)
+          processDeferredIncrements(state);
+        break;
+      }
+#endif  // USE_GC
       RuntimeAssert(container->refCount() > 0, "add ref for reclaimed object");
       incrementRC</* Atomic = */ false>(container);
       break;
@@ -1659,10 +2466,18 @@ inline void addHeapRef(ContainerHeader* container) {
   }
 }
 
-inline void addHeapRef(const ObjHeader* header) {
+inline void addHeapRef(ContainerHeader* container) {
+  addHeapRef(memoryState, container);
+}
+
+inline void addHeapRef(MemoryState* state, const ObjHeader* header) {
   auto* container = containerFor(header);
   if (container != nullptr)
-    addHeapRef(const_cast<ContainerHeader*>(container));
+    addHeapRef(state, const_cast<ContainerHeader*>(container));
+}
+
+inline void addHeapRef(const ObjHeader* header) {
+  addHeapRef(memoryState, header);
 }
 
 inline bool tryAddHeapRef(ContainerHeader* container) {
@@ -1689,22 +2504,32 @@ inline bool tryAddHeapRef(const ObjHeader* header) {
 }
 
 template <bool Strict, bool CanCollect>
-inline void releaseHeapRef(ContainerHeader* container) {
+inline void releaseHeapRef(MemoryState* state, ContainerHeader* container) {
   MEMORY_LOG("ReleaseHeapRef %p: rc=%d\n", container, container->refCount())
-  UPDATE_RELEASEREF_STAT(memoryState, container, needAtomicAccess(container), canBeCyclic(container), 0)
+  UPDATE_RELEASEREF_STAT(state, container, needAtomicAccess(container), canBeCyclic(container), 0)
   if (container->tag() != CONTAINER_TAG_STACK) {
     if (Strict)
-      enqueueDecrementRC</* CanCollect = */ CanCollect>(container);
+      enqueueDecrementRC</* CanCollect = */ CanCollect>(state, container);
     else
       decrementRC(container);
   }
 }
 
+template <bool Strict, bool CanCollect>
+inline void releaseHeapRef(ContainerHeader* container) {
+  releaseHeapRef<Strict, CanCollect>(memoryState, container);
+}
+
 template <bool Strict, bool CanCollect = true>
-inline void releaseHeapRef(const ObjHeader* header) {
+inline void releaseHeapRef(MemoryState* state, const ObjHeader* header) {
   auto* container = containerFor(header);
   if (container != nullptr)
-    releaseHeapRef<Strict, CanCollect>(const_cast<ContainerHeader*>(container));
+    releaseHeapRef<Strict, CanCollect>(state, const_cast<ContainerHeader*>(container));
+}
+
+template <bool Strict, bool CanCollect = true>
+inline void releaseHeapRef(const ObjHeader* header) {
+  releaseHeapRef<Strict, CanCollect>(memoryState, header);
 }
 
 // We use first slot as place to store frame-local arena container.
@@ -1734,6 +2559,25 @@ inline size_t containerSize(const ContainerHeader* container) {
 }
 
 #if USE_GC
+// Reconciles rc increments buffered by the deferred reference counting mode.
+// Must run before any deferred decrement is processed, so that refCount_ is properly
+// upper estimated whenever a free decision is made. Containers are logged while
+// local, but may have been frozen or shared since, so shareability is re-checked
+// here and shareable containers take the atomic increment, as other threads can
+// already be updating their counts.
+void processDeferredIncrements(MemoryState* state) {
+  auto* toIncrement = state->toIncrement;
+  if (toIncrement == nullptr || toIncrement->size() == 0) return;
+  MEMORY_LOG("processDeferredIncrements: %d pending\n", toIncrement->size())
+  for (auto* container : *toIncrement) {
+    if (container->shareable())
+      incrementRC</* Atomic = */ true>(container);
+    else
+      incrementRC</* Atomic = */ false>(container);
+  }
+  toIncrement->clear();
+}
+
 void incrementStack(MemoryState* state) {
   FrameOverlay* frame = currentFrame;
   while (frame != nullptr) {
@@ -1755,13 +2599,26 @@ void incrementStack(MemoryState* state) {
   }
 }
 
-void processDecrements(MemoryState* state) {
+// Drains [toRelease], at most roughly [budgetMicros] worth per call (0 means drain
+// everything). Only safe while the stack is pinned by incrementStack(): entries may
+// hold the last counted reference to objects still reachable from unpinned stack
+// slots. Leftovers simply stay queued for the next slice.
+void processDecrements(MemoryState* state, uint64_t budgetMicros) {
   RuntimeAssert(IsStrictMemoryModel, "Only works in strict model now");
   auto* toRelease = state->toRelease;
   state->gcSuspendCount++;
+  uint64_t startTime = budgetMicros != 0 ? konan::getTimeMicros() : 0;
+  int sinceClockCheck = 0;
   while (toRelease->size() > 0) {
+     // Check the clock only every few releases, it is not free either.
+     if (budgetMicros != 0 && ++sinceClockCheck >= 32) {
+       sinceClockCheck = 0;
+       if (konan::getTimeMicros() - startTime >= budgetMicros) break;
+     }
      auto* container = toRelease->back();
      toRelease->pop_back();
+     if (toRelease->size() > kTraversalPrefetchDistance)
+       prefetchContainer((*toRelease)[toRelease->size() - 1 - kTraversalPrefetchDistance]);
      if (isMarkedAsRemoved(container))
        continue;
      if (container->shareable())
@@ -1800,9 +2657,7 @@ void decrementStack(MemoryState* state) {
 void garbageCollect(MemoryState* state, bool force) {
   RuntimeAssert(!state->gcInProgress, "Recursive GC is disallowed");
 
-#if TRACE_GC
   uint64_t allocSinceLastGc = state->allocSinceLastGc;
-#endif  // TRACE_GC
   state->allocSinceLastGc = 0;
 
   if (!IsStrictMemoryModel) {
@@ -1820,6 +2675,13 @@ void garbageCollect(MemoryState* state, bool force) {
   state->gcInProgress = true;
   state->gcEpoque++;
 
+  // Structured event log, independent of the compile-time GC_LOG tracing: when
+  // enabled each phase lands in the in-memory ring (see GCLog.h).
+  bool gcLogging = GCLogEnabled();
+  auto gcLogEpoque = static_cast<KInt>(state->gcEpoque);
+  auto logPhaseStart = gcStartTime;
+
+  processDeferredIncrements(state);
   incrementStack(state);
 #if USE_CYCLIC_GC
   // Block if the concurrent cycle collector is running.
@@ -1830,12 +2692,22 @@ void garbageCollect(MemoryState* state, bool force) {
 #if PROFILE_GC
   auto processDecrementsStartTime = konan::getTimeMicros();
 #endif
-  processDecrements(state);
+  // In incremental mode a regular collection only sweeps for one slice; the
+  // remainder stays in toRelease and the next slices run at allocation safepoints.
+  bool incremental = !force && state->gcIncremental;
+  processDecrements(state, incremental ? kGcIncrementalSliceMicros : 0);
+  bool sweepLeftover = incremental && state->toRelease->size() > 0;
 #if PROFILE_GC
   auto processDecrementsDuration = konan::getTimeMicros() - processDecrementsStartTime;
   GC_LOG("||| GC: processDecrementsDuration = %lld\n", processDecrementsDuration);
   auto decrementStackStartTime = konan::getTimeMicros();
 #endif
+  if (gcLogging) {
+    auto now = konan::getTimeMicros();
+    GCLogRecord(GCLOG_PHASE_PROCESS_DECREMENTS, gcLogEpoque, logPhaseStart, now - logPhaseStart,
+                0, state->toRelease->size());
+    logPhaseStart = now;
+  }
   size_t beforeDecrements = state->toRelease->size();
   decrementStack(state);
   size_t afterDecrements = state->toRelease->size();
@@ -1845,7 +2717,13 @@ void garbageCollect(MemoryState* state, bool force) {
 #endif
   RuntimeAssert(afterDecrements >= beforeDecrements, "toRelease size must not have decreased");
   size_t stackReferences = afterDecrements - beforeDecrements;
-  if (state->gcErgonomics && stackReferences * 5 > state->gcThreshold) {
+  if (gcLogging) {
+    auto now = konan::getTimeMicros();
+    GCLogRecord(GCLOG_PHASE_DECREMENT_STACK, gcLogEpoque, logPhaseStart, now - logPhaseStart,
+                0, static_cast<KLong>(stackReferences));
+    logPhaseStart = now;
+  }
+  if (!state->gcPacer && state->gcErgonomics && stackReferences * 5 > state->gcThreshold) {
     increaseGcThreshold(state);
     GC_LOG("||| GC: too many stack references, increased threshold to %d\n", state->gcThreshold);
   }
@@ -1854,16 +2732,36 @@ void garbageCollect(MemoryState* state, bool force) {
 #if PROFILE_GC
   auto processFinalizerQueueStartTime = konan::getTimeMicros();
 #endif
+  KLong releasedBeforeFinalizers = state->toRelease->size();
   processFinalizerQueue(state);
 #if PROFILE_GC
   auto processFinalizerQueueDuration = konan::getTimeMicros() - processFinalizerQueueStartTime;
   GC_LOG("||| GC: processFinalizerQueueDuration %lld\n", processFinalizerQueueDuration);
 #endif
+  if (gcLogging) {
+    auto now = konan::getTimeMicros();
+    GCLogRecord(GCLOG_PHASE_FINALIZERS, gcLogEpoque, logPhaseStart, now - logPhaseStart,
+                releasedBeforeFinalizers, 0);
+    logPhaseStart = now;
+  }
 
   if (force || state->toFree->size() > state->gcCollectCyclesThreshold) {
     auto cyclicGcStartTime = konan::getTimeMicros();
+    // Fold the mature candidates back in when forced, when they pile up past the
+    // young threshold, or every kMatureScanFrequency-th cyclic collection; the
+    // collections in between scan only the recently mutated part of the heap.
+    if (force || state->toFreeMature->size() > state->gcCollectCyclesThreshold ||
+        ++state->cyclicGcsSinceMatureScan >= kMatureScanFrequency) {
+      state->cyclicGcsSinceMatureScan = 0;
+      state->toFree->insert(state->toFree->end(),
+          state->toFreeMature->begin(), state->toFreeMature->end());
+      state->toFreeMature->clear();
+    }
+    KLong cycleCandidates = state->toFree->size();
     while (state->toFree->size() > 0) {
-      collectCycles(state);
+      // Forced collections (shutdown, explicit GC) must not tenure: survivors would
+      // linger in the mature set after what the caller expects to be a full drain.
+      collectCycles(state, /* tenureSurvivors = */ !force);
       #if PROFILE_GC
         processFinalizerQueueStartTime = konan::getTimeMicros();
       #endif
@@ -1872,11 +2770,23 @@ void garbageCollect(MemoryState* state, bool force) {
         processFinalizerQueueDuration += konan::getTimeMicros() - processFinalizerQueueStartTime;
         GC_LOG("||| GC: processFinalizerQueueDuration = %lld\n", processFinalizerQueueDuration);
       #endif
+      // A single collectCycles() pass is monolithic, but repeated passes over
+      // freshly surfaced candidates can be postponed to later slices.
+      if (incremental && state->toFree->size() > 0 &&
+          konan::getTimeMicros() - cyclicGcStartTime >= kGcIncrementalSliceMicros) {
+        sweepLeftover = true;
+        break;
+      }
     }
     auto cyclicGcEndTime = konan::getTimeMicros();
     #if PROFILE_GC
       GC_LOG("||| GC: collectCyclesDuration = %lld\n", cyclicGcEndTime - cyclicGcStartTime);
     #endif
+    if (gcLogging) {
+      GCLogRecord(GCLOG_PHASE_COLLECT_CYCLES, gcLogEpoque, cyclicGcStartTime,
+                  cyclicGcEndTime - cyclicGcStartTime, 0, cycleCandidates);
+      logPhaseStart = cyclicGcEndTime;
+    }
     auto cyclicGcDuration = cyclicGcEndTime - cyclicGcStartTime;
     if (!force && state->gcErgonomics && cyclicGcDuration > kGcCollectCyclesMinimumDuration &&
         double(cyclicGcDuration) / (cyclicGcStartTime - state->lastCyclicGcTimestamp + 1) > kGcCollectCyclesLoadRatio) {
@@ -1887,9 +2797,21 @@ void garbageCollect(MemoryState* state, bool force) {
   }
 
   state->gcInProgress = false;
+  state->gcSweepPending = sweepLeftover;
   auto gcEndTime = konan::getTimeMicros();
+  if (gcLogging) {
+    GCLogRecord(GCLOG_PHASE_TOTAL, gcLogEpoque, gcStartTime, gcEndTime - gcStartTime,
+                releasedBeforeFinalizers, static_cast<KLong>(allocSinceLastGc));
+  }
 
-  if (state->gcErgonomics) {
+  CounterIncrement(RTC_GC_COUNT);
+  CounterAdd(RTC_GC_PAUSE_TOTAL_MICROS, gcEndTime - gcStartTime);
+  CounterSet(RTC_GC_LAST_PAUSE_MICROS, gcEndTime - gcStartTime);
+  CounterSet(RTC_GC_LAST_START_MICROS, gcStartTime);
+
+  if (state->gcPacer) {
+    updateGcPacer(state, gcEndTime - gcStartTime, allocSinceLastGc);
+  } else if (state->gcErgonomics) {
     auto gcToComputeRatio = double(gcEndTime - gcStartTime) / (gcStartTime - state->lastGcTimestamp + 1);
     if (!force && gcToComputeRatio > kGcToComputeRatioThreshold) {
       increaseGcThreshold(state);
@@ -1899,13 +2821,20 @@ void garbageCollect(MemoryState* state, bool force) {
   GC_LOG("GC: gcToComputeRatio=%f duration=%lld sinceLast=%lld\n", double(gcEndTime - gcStartTime) / (gcStartTime - state->lastGcTimestamp + 1), (gcEndTime - gcStartTime), gcStartTime - state->lastGcTimestamp);
   state->lastGcTimestamp = gcEndTime;
 
+#ifdef KONAN_OBJC_INTEROP
+  // The pause is over: release a budgeted slice of the associated objects the
+  // deallocation hooks deferred; the rest waits for the next collection.
+  processDeferredReleases(state, kDeferredReleaseBudgetMicros);
+#endif
+
 #if TRACE_MEMORY
   for (auto* obj: *state->toRelease) {
     MEMORY_LOG("toRelease %p\n", obj)
   }
 #endif
 
-  GC_LOG("<<< GC: toFree %d toRelease %d\n", state->toFree->size(), state->toRelease->size())
+  GC_LOG("<<< GC: toFree %d mature %d toRelease %d\n", state->toFree->size(),
+     state->toFreeMature->size(), state->toRelease->size())
 }
 
 void rememberNewContainer(ContainerHeader* container) {
@@ -1992,16 +2921,37 @@ MemoryState* initMemory() {
 #if USE_GC
   memoryState->toFree = konanConstructInstance<ContainerHeaderList>();
   memoryState->roots = konanConstructInstance<ContainerHeaderList>();
+  memoryState->toFreeMature = konanConstructInstance<ContainerHeaderList>();
+  memoryState->cyclicGcsSinceMatureScan = 0;
   memoryState->gcInProgress = false;
   memoryState->gcSuspendCount = 0;
   memoryState->toRelease = konanConstructInstance<ContainerHeaderList>();
-  initGcThreshold(memoryState, kGcThreshold);
+  memoryState->toIncrement = konanConstructInstance<ContainerHeaderList>();
+  // Deployment config can reseed the pacing defaults; every thread state picks
+  // them up here, unlike the GC API setters which act on the calling thread.
+  const KonanRuntimeConfig& runtimeConfig = konanRuntimeConfig();
+  // Increments deferral relies on decrements being queued until GC, so only the
+  // strict model qualifies; see setDeferredRefCounting.
+  memoryState->deferredRefCounting =
+      IsStrictMemoryModel && runtimeConfig.deferredRefCounting > 0;
+  initGcThreshold(memoryState, runtimeConfig.gcThreshold > 0
+      ? static_cast<uint32_t>(runtimeConfig.gcThreshold) : kGcThreshold);
   initGcCollectCyclesThreshold(memoryState, kMaxToFreeSizeThreshold);
-  memoryState->allocSinceLastGcThreshold = kMaxGcAllocThreshold;
+  memoryState->allocSinceLastGcThreshold = runtimeConfig.gcThresholdAllocations > 0
+      ? static_cast<uint64_t>(runtimeConfig.gcThresholdAllocations) : kMaxGcAllocThreshold;
   memoryState->gcErgonomics = true;
+  memoryState->gcPacer = false;
+  memoryState->gcPacerPauseBudget = kGcPacerDefaultPauseBudget;
+  memoryState->gcPacerHeapGrowth = kGcPacerDefaultHeapGrowth;
+  memoryState->gcIncremental = false;
+  memoryState->gcSweepPending = false;
 #endif
   memoryState->tlsMap = konanConstructInstance<KThreadLocalStorageMap>();
+#ifdef KONAN_OBJC_INTEROP
+  memoryState->deferredAssociatedObjects = konanConstructInstance<KStdVector<void*>>();
+#endif
   memoryState->foreignRefManager = ForeignRefManager::create();
+  SafePointRegisterThread();
   bool firstMemoryState = atomicAdd(&aliveMemoryStatesCount, 1) == 1;
   if (firstMemoryState) {
 #if USE_CYCLIC_GC
@@ -2012,6 +2962,8 @@ MemoryState* initMemory() {
 }
 
 void deinitMemory(MemoryState* memoryState) {
+  RuntimeAssert(memoryState->arenaScope == nullptr, "Arena scopes must be left before thread detach");
+  SafePointUnregisterThread();
   static int pendingDeinit = 0;
   atomicAdd(&pendingDeinit, 1);
 #if USE_GC
@@ -2032,19 +2984,53 @@ void deinitMemory(MemoryState* memoryState) {
   // Actual GC only implemented in strict memory model at the moment.
   do {
     GC_LOG("Calling garbageCollect from DeinitMemory()\n")
+#ifdef KONAN_OBJC_INTEROP
+    processDeferredReleases(memoryState, 0);
+#endif
     garbageCollect(memoryState, true);
-  } while (memoryState->toRelease->size() > 0 || !memoryState->foreignRefManager->tryReleaseRefOwned());
+  } while (memoryState->toRelease->size() > 0 || !memoryState->foreignRefManager->tryReleaseRefOwned()
+#ifdef KONAN_OBJC_INTEROP
+      || !memoryState->deferredAssociatedObjects->empty()
+#endif
+  );
   RuntimeAssert(memoryState->toFree->size() == 0, "Some memory have not been released after GC");
+  RuntimeAssert(memoryState->toFreeMature->size() == 0, "Mature candidates must be drained by forced GC");
   RuntimeAssert(memoryState->toRelease->size() == 0, "Some memory have not been released after GC");
+  RuntimeAssert(memoryState->toIncrement->size() == 0, "Deferred increments must be reconciled by GC");
   konanDestructInstance(memoryState->toFree);
   konanDestructInstance(memoryState->roots);
+  konanDestructInstance(memoryState->toFreeMature);
   konanDestructInstance(memoryState->toRelease);
+  konanDestructInstance(memoryState->toIncrement);
   RuntimeAssert(memoryState->tlsMap->size() == 0, "Must be already cleared");
   konanDestructInstance(memoryState->tlsMap);
   RuntimeAssert(memoryState->finalizerQueue == nullptr, "Finalizer queue must be empty");
   RuntimeAssert(memoryState->finalizerQueueSize == 0, "Finalizer queue must be empty");
+#ifdef KONAN_OBJC_INTEROP
+  RuntimeAssert(memoryState->deferredAssociatedObjects->empty(), "Deferred releases must be drained");
+  konanDestructInstance(memoryState->deferredAssociatedObjects);
+  memoryState->deferredAssociatedObjects = nullptr;
+#endif
+  for (auto* pool : {&memoryState->boxPool, &memoryState->counterPool}) {
+    while (*pool != nullptr) {
+      auto* container = *pool;
+      *pool = container->nextLink();
+#if TRACE_MEMORY
+      memoryState->containers->erase(container);
+#endif
+      CONTAINER_DESTROY_EVENT(memoryState, container)
+      freeContainerMemory(container);
+      atomicAdd(&allocCount, -1);
+    }
+  }
+  memoryState->boxPoolSize = 0;
+  memoryState->counterPoolSize = 0;
 #endif // USE_GC
 
+#if USE_ALLOC_NURSERY
+  nurseryRetireChunk(memoryState);
+#endif
+
   atomicAdd(&pendingDeinit, -1);
 
 #if TRACE_MEMORY
@@ -2117,20 +3103,25 @@ void zeroStackRef(ObjHeader** location) {
 }
 
 template <bool Strict>
-void updateHeapRef(ObjHeader** location, const ObjHeader* object) {
-  UPDATE_REF_EVENT(memoryState, *location, object, location, 0);
+void updateHeapRefWithState(MemoryState* state, ObjHeader** location, const ObjHeader* object) {
+  UPDATE_REF_EVENT(state, *location, object, location, 0);
   ObjHeader* old = *location;
   if (old != object) {
     if (object != nullptr) {
-      addHeapRef(object);
+      addHeapRef(state, object);
     }
     *const_cast<const ObjHeader**>(location) = object;
     if (reinterpret_cast<uintptr_t>(old) > 1) {
-      releaseHeapRef<Strict>(old);
+      releaseHeapRef<Strict>(state, old);
     }
   }
 }
 
+template <bool Strict>
+void updateHeapRef(ObjHeader** location, const ObjHeader* object) {
+  updateHeapRefWithState<Strict>(memoryState, location, object);
+}
+
 template <bool Strict>
 void updateStackRef(ObjHeader** location, const ObjHeader* object) {
   UPDATE_REF_EVENT(memoryState, *location, object, location, 1)
@@ -2176,8 +3167,63 @@ void updateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
   }
 }
 
+// Coalesced write barrier for initialization bursts: stores `count` values into distinct
+// fields of one freshly allocated `object`. The caller (i.e. the compiler) guarantees that
+// every target field is still unset, so the release-old half of the barrier is skipped,
+// and that the object has not been published yet. The thread state and the deferred mode
+// flag are read once per burst, and deferred increments are appended with a single
+// threshold check instead of one per store. Values still local to the allocating frame
+// (stack slab containers) skip reference counting entirely via the usual tag dispatch.
+void updateHeapRefsBulk(const ObjHeader* object, ObjHeader** const locations[],
+                        const ObjHeader* const values[], int count) {
+  RuntimeAssert(containerFor(object) == nullptr || !containerFor(object)->shareable(),
+                "Bulk updated object must not be published");
+#if USE_GC
+  MemoryState* state = memoryState;
+  bool deferred = state != nullptr && state->deferredRefCounting;
+  uint32_t deferredCount = 0;
+#endif  // USE_GC
+  for (int index = 0; index < count; ++index) {
+    ObjHeader** location = locations[index];
+    const ObjHeader* value = values[index];
+    UPDATE_REF_EVENT(memoryState, *location, value, location, 0);
+    RuntimeAssert(*location == nullptr, "Bulk updated field must be unset");
+    if (value != nullptr) {
+      auto* container = containerFor(value);
+      if (container != nullptr) {
+#if USE_GC
+        if (deferred && container->tag() == CONTAINER_TAG_LOCAL) {
+          UPDATE_ADDREF_STAT(state, container, needAtomicAccess(container), 0)
+          state->toIncrement->push_back(container);
+          ++deferredCount;
+        } else {
+          addHeapRef(state, container);
+        }
+#else
+        addHeapRef(memoryState, container);
+#endif  // USE_GC
+      }
+    }
+    *const_cast<const ObjHeader**>(location) = value;
+  }
+#if USE_GC
+  if (deferredCount != 0 && state->toIncrement->size() >= state->gcThreshold && !state->gcInProgress)
+    processDeferredIncrements(state);
+#endif  // USE_GC
+}
+
 inline void checkIfGcNeeded(MemoryState* state) {
-  if (state != nullptr && state->allocSinceLastGc > state->allocSinceLastGcThreshold && state->gcSuspendCount == 0) {
+  // Allocation sites double as safepoint polls.
+  Kotlin_native_internal_safePoint();
+  if (state == nullptr) return;
+  // An incremental collection left a sweep backlog: run the next bounded slice
+  // here, without waiting for the allocation threshold or the anti-trashing delay.
+  if (state->gcSweepPending && state->gcSuspendCount == 0) {
+    GC_LOG("Continuing incremental sweep from checkIfGcNeeded: %d\n", state->toRelease->size())
+    garbageCollect(state, false);
+    return;
+  }
+  if (state->allocSinceLastGc > state->allocSinceLastGcThreshold && state->gcSuspendCount == 0) {
     // To avoid GC trashing check that at least 10ms passed since last GC.
     if (konan::getTimeMicros() - state->lastGcTimestamp > 10 * 1000) {
       GC_LOG("Calling GC from checkIfGcNeeded: %d\n", state->toRelease->size())
@@ -2197,25 +3243,164 @@ inline void checkIfForceCyclicGcNeeded(MemoryState* state) {
   }
 }
 
-template <bool Strict>
-OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
-  RuntimeAssert(type_info->instanceSize_ >= 0, "must be an object");
-  auto* state = memoryState;
-#if USE_GC
-  checkIfGcNeeded(state);
-#endif  // USE_GC
-  auto container = ObjectContainer(state, type_info);
-  ObjHeader* obj = container.GetPlace();
-#if USE_GC
-  if (Strict) {
-    rememberNewContainer(container.header());
-  } else {
-    makeShareable(container.header());
+// Allocation-site profiler. When enabled, every [g_allocProfileRate]th allocation
+// of a thread captures a compact frame-pointer stack and aggregates it into a
+// fixed open-addressing table of per-site counts and bytes, dumpable in the pprof
+// heap profile text format. The hot path costs one global flag load and a
+// thread-local countdown decrement; the capture itself runs once per sample.
+constexpr int kAllocProfileMaxFrames = 16;
+// Power of two, so probes wrap with a mask. Samples whose site does not fit are
+// counted as dropped rather than evicting existing sites.
+constexpr uint32_t kAllocProfileTableSize = 4096;
+
+struct AllocProfileSite {
+  void* frames[kAllocProfileMaxFrames];
+  int frameCount;
+  uint64_t count;
+  uint64_t bytes;
+};
+
+int32_t g_allocProfileEnabled = 0;
+int32_t g_allocProfileRate = 512;
+KInt g_allocProfileLock = 0;
+// Allocated lazily on the first sample, never freed.
+AllocProfileSite* g_allocProfileTable = nullptr;
+uint64_t g_allocProfileDroppedSamples = 0;
+
+NO_INLINE void recordAllocProfileSample(uint64_t size) {
+  void* frames[kAllocProfileMaxFrames];
+  // Skip the allocation entry point frame between here and Kotlin code.
+  int frameCount = FramePointerBacktrace(frames, kAllocProfileMaxFrames, 1);
+  uint64_t hash = 14695981039346656037ULL;
+  for (int i = 0; i < frameCount; i++) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ULL;
+  }
+  // Each sample stands for the whole sampling period, so aggregate pre-scaled
+  // values and the dump can declare an exact profile.
+  auto weight = static_cast<uint64_t>(g_allocProfileRate);
+  lock(&g_allocProfileLock);
+  if (g_allocProfileTable == nullptr) {
+    g_allocProfileTable = reinterpret_cast<AllocProfileSite*>(
+        konan::calloc(kAllocProfileTableSize, sizeof(AllocProfileSite)));
+  }
+  for (uint32_t probe = 0; probe < kAllocProfileTableSize; probe++) {
+    auto* site = &g_allocProfileTable[(hash + probe) & (kAllocProfileTableSize - 1)];
+    if (site->count == 0) {
+      ::memcpy(site->frames, frames, frameCount * sizeof(void*));
+      site->frameCount = frameCount;
+    } else if (site->frameCount != frameCount ||
+               ::memcmp(site->frames, frames, frameCount * sizeof(void*)) != 0) {
+      continue;
+    }
+    site->count += weight;
+    site->bytes += size * weight;
+    unlock(&g_allocProfileLock);
+    return;
   }
-#endif  // USE_GC
-#if USE_CYCLE_DETECTOR
-  CycleDetector::insertCandidateIfNeeded(obj);
-#endif  // USE_CYCLE_DETECTOR
+  g_allocProfileDroppedSamples += weight;
+  unlock(&g_allocProfileLock);
+}
+
+ALWAYS_INLINE inline void profileAlloc(MemoryState* state, uint64_t size) {
+  if (atomicGet(&g_allocProfileEnabled) == 0) return;
+  if (state->allocProfileCountdown > 1) {
+    state->allocProfileCountdown--;
+    return;
+  }
+  state->allocProfileCountdown = static_cast<uint32_t>(g_allocProfileRate);
+  recordAllocProfileSample(size);
+}
+
+bool dumpAllocProfile(const char* path) {
+  // Copy the table first: file I/O must not run under the sampling spinlock.
+  KStdVector<AllocProfileSite> sites;
+  uint64_t dropped;
+  lock(&g_allocProfileLock);
+  if (g_allocProfileTable != nullptr) {
+    for (uint32_t i = 0; i < kAllocProfileTableSize; i++) {
+      if (g_allocProfileTable[i].count != 0) sites.push_back(g_allocProfileTable[i]);
+    }
+  }
+  dropped = g_allocProfileDroppedSamples;
+  unlock(&g_allocProfileLock);
+
+  FILE* out = fopen(path, "w");
+  if (out == nullptr) return false;
+  uint64_t totalCount = dropped;
+  uint64_t totalBytes = 0;
+  for (auto& site : sites) {
+    totalCount += site.count;
+    totalBytes += site.bytes;
+  }
+  // Values are pre-scaled by the sampling rate, so the declared period is 1.
+  fprintf(out, "heap profile: %12llu: %12llu [%12llu: %12llu] @ heap_v2/1\n",
+          static_cast<unsigned long long>(totalCount), static_cast<unsigned long long>(totalBytes),
+          static_cast<unsigned long long>(totalCount), static_cast<unsigned long long>(totalBytes));
+  for (auto& site : sites) {
+    fprintf(out, "%12llu: %12llu [%12llu: %12llu] @",
+            static_cast<unsigned long long>(site.count), static_cast<unsigned long long>(site.bytes),
+            static_cast<unsigned long long>(site.count), static_cast<unsigned long long>(site.bytes));
+    for (int i = 0; i < site.frameCount; i++) {
+      fprintf(out, " %p", site.frames[i]);
+    }
+    fprintf(out, "\n");
+  }
+  // pprof symbolizes the raw addresses against the process mappings.
+  fprintf(out, "\nMAPPED_LIBRARIES:\n");
+  FILE* maps = fopen("/proc/self/maps", "r");
+  if (maps != nullptr) {
+    char buffer[512];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+      fwrite(buffer, 1, read, out);
+    }
+    fclose(maps);
+  }
+  return fclose(out) == 0;
+}
+
+// Temporarily hides the active arena scope of the current thread. Used where an
+// allocation must outlive any request scope, such as lazily initialized singletons.
+class SuppressArenaScope {
+ public:
+  SuppressArenaScope() : state_(memoryState), saved_(state_->arenaScope) {
+    state_->arenaScope = nullptr;
+  }
+  ~SuppressArenaScope() {
+    state_->arenaScope = saved_;
+  }
+
+ private:
+  MemoryState* state_;
+  ArenaScopeRecord* saved_;
+};
+
+template <bool Strict>
+OBJ_GETTER(allocInstanceWithState, MemoryState* state, const TypeInfo* type_info) {
+  RuntimeAssert(type_info->instanceSize_ >= 0, "must be an object");
+  profileAlloc(state, static_cast<uint64_t>(type_info->instanceSize_));
+  if (state->arenaScope != nullptr) {
+    // Request-scoped allocation: place into the innermost arena scope. Such objects
+    // bypass reference counting and are released wholesale by LeaveArenaScope, so
+    // no GC bookkeeping or cycle candidate registration applies to them.
+    ObjHeader* obj = state->arenaScope->arena.PlaceObject(type_info);
+    if (obj != nullptr) RETURN_OBJ(obj);
+  }
+#if USE_GC
+  checkIfGcNeeded(state);
+#endif  // USE_GC
+  auto container = ObjectContainer(state, type_info);
+  ObjHeader* obj = container.GetPlace();
+#if USE_GC
+  if (Strict) {
+    rememberNewContainer(container.header());
+  } else {
+    makeShareable(container.header());
+  }
+#endif  // USE_GC
+#if USE_CYCLE_DETECTOR
+  CycleDetector::insertCandidateIfNeeded(obj);
+#endif  // USE_CYCLE_DETECTOR
 #if USE_CYCLIC_GC
   if ((obj->type_info()->flags_ & TF_LEAK_DETECTOR_CANDIDATE) != 0) {
     // Note: this should be performed after [rememberNewContainer] (above).
@@ -2227,15 +3412,84 @@ OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
   RETURN_OBJ(obj);
 }
 
+template <bool Strict>
+OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceWithState<Strict>, memoryState, type_info);
+}
+
+template <bool Strict>
+OBJ_GETTER(allocArrayInstanceWithState, MemoryState* state, const TypeInfo* type_info, int32_t elements) {
+  RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
+  if (elements < 0) ThrowIllegalArgumentException();
+  profileAlloc(state, arrayObjectSize(type_info, elements));
+  if (state->arenaScope != nullptr) {
+    ArrayHeader* array = state->arenaScope->arena.PlaceArray(type_info, elements);
+    if (array != nullptr) RETURN_OBJ(array->obj());
+  }
+#if USE_GC
+  checkIfGcNeeded(state);
+#endif  // USE_GC
+  auto container = ArrayContainer(state, type_info, elements);
+#if USE_GC
+  if (Strict) {
+    rememberNewContainer(container.header());
+  } else {
+    makeShareable(container.header());
+  }
+#endif  // USE_GC
+  RETURN_OBJ(container.GetPlace()->obj());
+}
+
 template <bool Strict>
 OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceWithState<Strict>, memoryState, type_info, elements);
+}
+
+// See AllocArrayInstanceAligned in Memory.h. No arena placement: an aligned
+// request is about the payload address, which the bump arena cannot provide.
+template <bool Strict>
+OBJ_GETTER(allocArrayInstanceAligned, const TypeInfo* type_info, int32_t elements, int32_t alignment) {
+  auto* state = memoryState;
   RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
   if (elements < 0) ThrowIllegalArgumentException();
+  if (alignment <= 0 || (alignment & (alignment - 1)) != 0 ||
+      static_cast<container_size_t>(alignment) > kMaxPayloadAlignment)
+    ThrowIllegalArgumentException();
+  profileAlloc(state, arrayObjectSize(type_info, elements));
+#if USE_GC
+  checkIfGcNeeded(state);
+#endif  // USE_GC
+  auto container = ArrayContainer(state, type_info, elements, /* zeroBody = */ true,
+                                  static_cast<uint32_t>(alignment));
+#if USE_GC
+  if (Strict) {
+    rememberNewContainer(container.header());
+  } else {
+    makeShareable(container.header());
+  }
+#endif  // USE_GC
+  RETURN_OBJ(container.GetPlace()->obj());
+}
+
+// See AllocArrayInstanceUninitialized in Memory.h for the caller contract.
+// Uninitialized chars or bytes are invisible to the GC, but a reference array
+// with garbage elements would be traversed, hence the type assert.
+template <bool Strict>
+OBJ_GETTER(allocArrayInstanceUninitialized, const TypeInfo* type_info, int32_t elements) {
   auto* state = memoryState;
+  RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
+  RuntimeAssert(type_info != theArrayTypeInfo, "must not be an array of references");
+  if (elements < 0) ThrowIllegalArgumentException();
+  profileAlloc(state, arrayObjectSize(type_info, elements));
+  if (state->arenaScope != nullptr) {
+    // Arena chunks are handed out zeroed anyway; nothing to elide here.
+    ArrayHeader* array = state->arenaScope->arena.PlaceArray(type_info, elements);
+    if (array != nullptr) RETURN_OBJ(array->obj());
+  }
 #if USE_GC
   checkIfGcNeeded(state);
 #endif  // USE_GC
-  auto container = ArrayContainer(state, type_info, elements);
+  auto container = ArrayContainer(state, type_info, elements, /* zeroBody = */ false);
 #if USE_GC
   if (Strict) {
     rememberNewContainer(container.header());
@@ -2246,6 +3500,64 @@ OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements) {
   RETURN_OBJ(container.GetPlace()->obj());
 }
 
+// Allocation in the frame-local slab, used when escape analysis proved the object
+// does not outlive its owner frame. Slab objects bypass reference counting, but
+// references they hold are counted, so the referred heap objects stay pinned until
+// leaveFrame() releases the slab wholesale.
+template <bool Strict>
+OBJ_GETTER(allocInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info) {
+  RuntimeAssert(type_info->instanceSize_ >= 0, "must be an object");
+  ObjHeader* obj = initedArena(auxSlot)->PlaceObject(type_info);
+  if (obj == nullptr) {
+    // The slab cannot be grown: fall back to an ordinary heap allocation.
+    RETURN_RESULT_OF(allocInstance<Strict>, type_info);
+  }
+  profileAlloc(memoryState, static_cast<uint64_t>(type_info->instanceSize_));
+  RETURN_OBJ(obj);
+}
+
+template <bool Strict>
+OBJ_GETTER(allocArrayInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info, int32_t elements) {
+  RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
+  if (elements < 0) ThrowIllegalArgumentException();
+  ArrayHeader* array = initedArena(auxSlot)->PlaceArray(type_info, elements);
+  if (array == nullptr) {
+    RETURN_RESULT_OF(allocArrayInstance<Strict>, type_info, elements);
+  }
+  profileAlloc(memoryState, arrayObjectSize(type_info, elements));
+  RETURN_OBJ(array->obj());
+}
+
+// Promotion on escape: copies a stack-allocated object into a fresh heap
+// container. The copy takes its own counted reference to everything it refers to,
+// while the original keeps its references until the owner frame dies. The compiler
+// promotes escaping subgraphs leaf-first and rewrites the aliases it tracks, so by
+// the time an object is promoted its fields only refer to heap objects (checked
+// builds catch violations in CheckLifetimesConstraint once the copy is stored).
+// Identity-bearing state (meta-object, weak counters) must not have been created
+// for the original.
+template <bool Strict>
+OBJ_GETTER(promoteObjectToHeap, ObjHeader* object) {
+  if (object == nullptr || !object->local()) RETURN_OBJ(object);
+  RuntimeAssert(!object->has_meta_object(), "Cannot promote an object with identity-bearing state");
+  const TypeInfo* typeInfo = object->type_info();
+  // The copy escapes by definition, so it must not land in an arena scope.
+  SuppressArenaScope suppressArenaScope;
+  ObjHolder holder;
+  ObjHeader* copy;
+  if (typeInfo->instanceSize_ >= 0) {
+    copy = allocInstance<Strict>(typeInfo, holder.slot());
+    ::memcpy(copy + 1, object + 1, typeInfo->instanceSize_ - sizeof(ObjHeader));
+  } else {
+    uint32_t count = object->array()->count_;
+    copy = allocArrayInstance<Strict>(typeInfo, static_cast<int32_t>(count), holder.slot());
+    ::memcpy(copy->array() + 1, object->array() + 1,
+             arrayObjectSize(typeInfo, count) - sizeof(ArrayHeader));
+  }
+  traverseReferredObjects(copy, [](ObjHeader* field) { addHeapRef(field); });
+  RETURN_OBJ(copy);
+}
+
 template <bool Strict>
 OBJ_GETTER(initInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
@@ -2254,6 +3566,8 @@ OBJ_GETTER(initInstance,
     // OK'ish, inited by someone else.
     RETURN_OBJ(value);
   }
+  // The singleton and everything its constructor allocates must outlive any arena scope.
+  SuppressArenaScope suppressArenaScope;
   ObjHeader* object = allocInstance<Strict>(typeInfo, OBJ_RESULT);
   updateHeapRef<Strict>(location, object);
 #if KONAN_NO_EXCEPTIONS
@@ -2280,6 +3594,7 @@ OBJ_GETTER(initSharedInstance,
     // OK'ish, inited by someone else.
     RETURN_OBJ(value);
   }
+  SuppressArenaScope suppressArenaScope;
   ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
   UpdateHeapRef(location, object);
 #if KONAN_NO_EXCEPTIONS
@@ -2315,6 +3630,7 @@ OBJ_GETTER(initSharedInstance,
     // OK'ish, inited by someone else.
     RETURN_OBJ(value);
   }
+  SuppressArenaScope suppressArenaScope;
   ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
   memoryState->initializingSingletons.push_back(std::make_pair(location, object));
 #if KONAN_NO_EXCEPTIONS
@@ -2466,6 +3782,14 @@ void leaveFrame(ObjHeader** start, int parameters, int count) {
         current++;
       }
   }
+  if (frame->arena != nullptr) {
+    // Bulk invalidation of the frame slab: releases the references held by slab
+    // objects and returns the chunks wholesale, see allocInstanceInFrame().
+    auto* arena = reinterpret_cast<ArenaContainer*>(frame->arena);
+    arena->Deinit();
+    konanDestructInstance(arena);
+    frame->arena = nullptr;
+  }
 }
 
 void suspendGC() {
@@ -2495,9 +3819,11 @@ void stopGC() {
     konanDestructInstance(memoryState->toRelease);
     konanDestructInstance(memoryState->toFree);
     konanDestructInstance(memoryState->roots);
+    konanDestructInstance(memoryState->toFreeMature);
     memoryState->toRelease = nullptr;
     memoryState->toFree = nullptr;
     memoryState->roots = nullptr;
+    memoryState->toFreeMature = nullptr;
   }
 }
 
@@ -2507,6 +3833,8 @@ void startGC() {
     memoryState->toFree = konanConstructInstance<ContainerHeaderList>();
     memoryState->toRelease = konanConstructInstance<ContainerHeaderList>();
     memoryState->roots = konanConstructInstance<ContainerHeaderList>();
+    memoryState->toFreeMature = konanConstructInstance<ContainerHeaderList>();
+    memoryState->cyclicGcsSinceMatureScan = 0;
     memoryState->gcSuspendCount = 0;
   }
 }
@@ -2551,6 +3879,73 @@ KLong getGCThresholdAllocations() {
   return memoryState->allocSinceLastGcThreshold;
 }
 
+void setDeferredRefCounting(KBoolean value) {
+  GC_LOG("setDeferredRefCounting %d\n", value)
+  MemoryState* state = memoryState;
+  if (state->toIncrement == nullptr) return;
+  // Increments deferral relies on decrements being queued until GC, so only the strict model qualifies.
+  if (value && !IsStrictMemoryModel)
+    ThrowIllegalArgumentException();
+  if (!value)
+    processDeferredIncrements(state);
+  state->deferredRefCounting = value;
+}
+
+KBoolean getDeferredRefCounting() {
+  GC_LOG("getDeferredRefCounting\n")
+  return memoryState->deferredRefCounting;
+}
+
+void setGCIncremental(KBoolean value) {
+  GC_LOG("setGCIncremental %d\n", value)
+  // Incremental slices rely on decrements being queued until GC, so only the strict
+  // model qualifies.
+  if (value && !IsStrictMemoryModel)
+    ThrowIllegalArgumentException();
+  memoryState->gcIncremental = value;
+}
+
+KBoolean getGCIncremental() {
+  GC_LOG("getGCIncremental\n")
+  return memoryState->gcIncremental;
+}
+
+void setGCPacer(KBoolean value) {
+  GC_LOG("setGCPacer %d\n", value)
+  memoryState->gcPacer = value;
+}
+
+KBoolean getGCPacer() {
+  GC_LOG("getGCPacer\n")
+  return memoryState->gcPacer;
+}
+
+void setGCPauseBudget(KLong value) {
+  GC_LOG("setGCPauseBudget %lld\n", value)
+  if (value <= 0) {
+    ThrowIllegalArgumentException();
+  }
+  memoryState->gcPacerPauseBudget = value;
+}
+
+KLong getGCPauseBudget() {
+  GC_LOG("getGCPauseBudget\n")
+  return memoryState->gcPacerPauseBudget;
+}
+
+void setGCHeapGrowthFactor(KDouble value) {
+  GC_LOG("setGCHeapGrowthFactor %f\n", value)
+  if (value <= 1.0) {
+    ThrowIllegalArgumentException();
+  }
+  memoryState->gcPacerHeapGrowth = value;
+}
+
+KDouble getGCHeapGrowthFactor() {
+  GC_LOG("getGCHeapGrowthFactor\n")
+  return memoryState->gcPacerHeapGrowth;
+}
+
 void setTuneGCThreshold(KBoolean value) {
   GC_LOG("setTuneGCThreshold %d\n", value)
   memoryState->gcErgonomics = value;
@@ -2603,6 +3998,18 @@ bool clearSubgraphReferences(ObjHeader* root, bool checked) {
     // TODO: assert for that?
     return true;
 
+  // Fast path: a single fresh leaf container is trivially an isolated subgraph.
+  // Leaf types have no outgoing references, and refCount() == 1 means the stable
+  // pointer created by this very transfer is the only accounted reference: anything
+  // else referring to the container, including a pending decrement in toRelease,
+  // would keep its count above one. Not being buffered it is in no GC list either,
+  // so ownership moves with the pointer, no reachability analysis needed.
+  if (container->objectCount() == 1 && !container->stack() && !container->buffered() &&
+      container->refCount() == 1 && root->type_info()->objOffsetsCount_ == 0) {
+    MEMORY_LOG("clearSubgraphReferences %p: single leaf container fast path\n", root)
+    return true;
+  }
+
   // Free cyclic garbage to decrease number of analyzed objects.
   checkIfForceCyclicGcNeeded(state);
 
@@ -2636,13 +4043,15 @@ bool clearSubgraphReferences(ObjHeader* root, bool checked) {
 
   // Remove all no longer owned containers from GC structures.
   // TODO: not very efficient traversal.
-  for (auto it = state->toFree->begin(); it != state->toFree->end(); ++it) {
-    auto container = *it;
-    if (visited.count(container) != 0) {
-      MEMORY_LOG("removing %p from the toFree list\n", container)
-      container->resetBuffered();
-      container->setColorAssertIfGreen(CONTAINER_TAG_GC_BLACK);
-      *it = markAsRemoved(container);
+  for (auto* list : {state->toFree, state->toFreeMature}) {
+    for (auto it = list->begin(); it != list->end(); ++it) {
+      auto container = *it;
+      if (visited.count(container) != 0) {
+        MEMORY_LOG("removing %p from the toFree list\n", container)
+        container->resetBuffered();
+        container->setColorAssertIfGreen(CONTAINER_TAG_GC_BLACK);
+        *it = markAsRemoved(container);
+      }
     }
   }
   for (auto it = state->toRelease->begin(); it != state->toRelease->end(); ++it) {
@@ -2665,6 +4074,89 @@ bool clearSubgraphReferences(ObjHeader* root, bool checked) {
   return true;
 }
 
+#if USE_ALLOC_NURSERY
+// Copies the containers of a detached subgraph into sequential nursery blocks in
+// breadth-first order, children next to their parents. This is safe exactly because
+// the graph is detached: ClearSubgraphReferences verified there are no external
+// references, so every pointer to a moved object lives inside the subgraph (or is
+// the stable pointer itself) and can be rewritten. Containers that cannot move stay
+// in place: shared and frozen ones are not owned by the graph, objects with meta
+// objects are referenced by weak counters or associated objects the runtime cannot
+// retarget, and blocks beyond the nursery limit are page-scale anyway, so packing
+// them buys no locality.
+KNativePtr compactSubgraph(KNativePtr stable) {
+  ObjHeader* root = reinterpret_cast<ObjHeader*>(stable);
+  if (root == nullptr) return stable;
+  auto* state = memoryState;
+
+  KStdUnorderedMap<ObjHeader*, ObjHeader*> moved;
+  KStdVector<ContainerHeader*> owned;    // Containers whose fields may be rewritten.
+  KStdVector<ContainerHeader*> movable;  // Subset that gets copied, in traversal order.
+  ContainerHeaderSet seen;
+  KStdDeque<ObjHeader*> queue;
+  queue.push_back(root);
+  while (!queue.empty()) {
+    ObjHeader* obj = queue.front();
+    queue.pop_front();
+    ContainerHeader* container = containerFor(obj);
+    // Permanent or shared containers are not owned by the detached graph.
+    if (container == nullptr || container->shareable()) continue;
+    if (!seen.insert(container).second) continue;
+    owned.push_back(container);
+    if (container->objectCount() == 1 && !container->stack() && !container->buffered() &&
+        !obj->has_meta_object() &&
+        sizeof(ContainerHeader) + objectSize(obj) <= kNurseryMaxBlockSize) {
+      movable.push_back(container);
+    }
+    traverseContainerReferredObjects(container, [&queue](ObjHeader* ref) {
+      queue.push_back(ref);
+    });
+  }
+  if (movable.size() < 2) return stable;
+
+  // Copy in traversal order; the nursery bump allocator makes the copies adjacent.
+  for (auto* container : movable) {
+    ObjHeader* obj = reinterpret_cast<ObjHeader*>(container + 1);
+    container_size_t size = alignUp(sizeof(ContainerHeader) + objectSize(obj), kObjectAlignment);
+    ContainerHeader* copy = nurseryAlloc(state, size);
+    atomicAdd(&allocCount, 1);
+    CounterRecordAllocation(size);
+    CONTAINER_ALLOC_EVENT(state, size, copy);
+#if USE_GC
+    state->allocSinceLastGc += size;
+#endif
+    ::memcpy(copy, container, size);
+    moved[obj] = reinterpret_cast<ObjHeader*>(copy + 1);
+  }
+
+  // Retarget every edge of the graph that points at a moved object. For moved
+  // containers the copy is rewritten, the original is about to be discarded.
+  for (auto* container : owned) {
+    ContainerHeader* rewritten = container;
+    if (container->objectCount() == 1) {
+      auto it = moved.find(reinterpret_cast<ObjHeader*>(container + 1));
+      if (it != moved.end()) rewritten = containerFor(it->second);
+    }
+    traverseContainerObjectFields(rewritten, [&moved](ObjHeader** location) {
+      ObjHeader* ref = *location;
+      if (ref == nullptr) return;
+      auto it = moved.find(ref);
+      if (it != moved.end()) *location = it->second;
+    });
+  }
+
+  // Release the memory of the originals without touching their (moved) contents.
+  for (auto* container : movable) {
+    CONTAINER_DESTROY_EVENT(state, container);
+    freeContainerMemory(container);
+    atomicAdd(&allocCount, -1);
+  }
+
+  auto it = moved.find(root);
+  return it != moved.end() ? reinterpret_cast<KNativePtr>(it->second) : stable;
+}
+#endif  // USE_ALLOC_NURSERY
+
 void freezeAcyclic(ContainerHeader* rootContainer, ContainerHeaderSet* newlyFrozen) {
   KStdDeque<ContainerHeader*> queue;
   queue.push_back(rootContainer);
@@ -2690,6 +4182,60 @@ void freezeAcyclic(ContainerHeader* rootContainer, ContainerHeaderSet* newlyFroz
   }
 }
 
+// Counting references of a big condensation is read-only and dominates freezeCyclic,
+// so it is sharded over a few extra threads, the freezing thread included.
+constexpr size_t kParallelFreezeThreshold = 1024;
+#if !KONAN_NO_THREADS
+constexpr int kFreezeCountingThreads = 3;
+#endif
+
+struct FreezeCountingState {
+  const KStdVector<KStdVector<ContainerHeader*>>* components;
+  const KStdUnorderedMap<ContainerHeader*, int32_t>* componentOf;
+  int* internalRefsCounts;
+  int* totalCounts;
+  int32_t nextIndex;
+};
+
+void countComponentRefs(FreezeCountingState* state, int32_t index) {
+  auto const& component = (*state->components)[index];
+  auto const* componentOf = state->componentOf;
+  int internalRefsCount = 0;
+  int totalCount = 0;
+  for (auto* container : component) {
+    RuntimeAssert(!isAggregatingFrozenContainer(container), "Must not be called on such containers");
+    totalCount += container->refCount();
+    if (isFreezableAtomic(container)) {
+      RuntimeAssert(component.size() == 1, "Must be trivial condensation");
+      continue;
+    }
+    traverseContainerReferredObjects(container,
+        [index, componentOf, &internalRefsCount](ObjHeader* obj) {
+          auto* objContainer = containerFor(obj);
+          if (!canFreeze(objContainer)) return;
+          // Only edges staying inside the component are internal. Cross-component edges
+          // always lead to a component frozen earlier in the final pass, so this matches
+          // the order-dependent counting the interleaved version did via canFreeze().
+          auto it = componentOf->find(objContainer);
+          if (it != componentOf->end() && it->second == index)
+            ++internalRefsCount;
+        });
+  }
+  state->internalRefsCounts[index] = internalRefsCount;
+  state->totalCounts[index] = totalCount;
+}
+
+void* freezeCountingRoutine(void* argument) {
+  auto* state = reinterpret_cast<FreezeCountingState*>(argument);
+  auto size = static_cast<int32_t>(state->components->size());
+  while (true) {
+    int32_t index = atomicAdd(&state->nextIndex, 1) - 1;
+    if (index >= size) break;
+    countComponentRefs(state, index);
+  }
+  return nullptr;
+}
+
 void freezeCyclic(ObjHeader* root,
                   const KStdVector<ContainerHeader*>& order,
                   ContainerHeaderSet* newlyFrozen) {
@@ -2716,6 +4262,7 @@ void freezeCyclic(ObjHeader* root,
    }
 
    KStdVector<KStdVector<ContainerHeader*>> components;
+   KStdUnorderedMap<ContainerHeader*, int32_t> componentOf;
    MEMORY_LOG("Condensation:\n");
    // Enumerate in the topological order.
    for (auto it = order.rbegin(); it != order.rend(); ++it) {
@@ -2728,27 +4275,41 @@ void freezeCyclic(ObjHeader* root,
      for (auto c: component)
        konan::consolePrintf("    %p\n", c);
   #endif
+     for (auto* c : component)
+       componentOf[c] = static_cast<int32_t>(components.size());
      components.push_back(std::move(component));
    }
 
-  // Enumerate strongly connected components in reversed topological order.
-  for (auto it = components.rbegin(); it != components.rend(); ++it) {
-    auto& component = *it;
-    int internalRefsCount = 0;
-    int totalCount = 0;
-    for (auto* container : component) {
-      RuntimeAssert(!isAggregatingFrozenContainer(container), "Must not be called on such containers");
-      totalCount += container->refCount();
-      if (isFreezableAtomic(container)) {
-        RuntimeAssert(component.size() == 1, "Must be trivial condensation");
-        continue;
-      }
-      traverseContainerReferredObjects(container, [&internalRefsCount](ObjHeader* obj) {
-          auto* container = containerFor(obj);
-          if (canFreeze(container))
-            ++internalRefsCount;
-        });
-    }
+  // Count total and internal references of every component first. This phase only reads
+  // the graph, so for big condensations it is partitioned across a few helper threads.
+  KStdVector<int> internalRefsCounts(components.size());
+  KStdVector<int> totalCounts(components.size());
+  FreezeCountingState countingState = {
+      &components, &componentOf, internalRefsCounts.data(), totalCounts.data(), 0 };
+#if !KONAN_NO_THREADS
+  if (components.size() >= kParallelFreezeThreshold) {
+    pthread_t threads[kFreezeCountingThreads];
+    int started = 0;
+    while (started < kFreezeCountingThreads &&
+           pthread_create(&threads[started], nullptr, freezeCountingRoutine, &countingState) == 0)
+      ++started;
+    // The freezing thread takes its share of components as well.
+    freezeCountingRoutine(&countingState);
+    for (int i = 0; i < started; ++i)
+      pthread_join(threads[i], nullptr);
+  } else {
+    freezeCountingRoutine(&countingState);
+  }
+#else
+  freezeCountingRoutine(&countingState);
+#endif  // !KONAN_NO_THREADS
+
+  // Now perform all the flag flips in one pass, enumerating strongly connected
+  // components in reversed topological order.
+  for (size_t index = components.size(); index-- > 0;) {
+    auto& component = components[index];
+    int internalRefsCount = internalRefsCounts[index];
+    int totalCount = totalCounts[index];
 
     // Freeze component.
     for (auto* container : component) {
@@ -2826,6 +4387,98 @@ void runFreezeHooksRecursive(ObjHeader* root) {
  *  Further reference counting on frozen objects is performed with atomic operations, and so frozen
  * references could be passed across multiple threads.
  */
+// Hash-consing of frozen immutable leaf values, see GC.freezeDeduplication.
+KBoolean g_freezeDeduplication = false;
+
+SimpleMutex freezeDedupLock;
+// Canonical leaf objects bucketed by content hash; each entry holds a strong
+// reference, so canonicals stay alive for the rest of the process.
+KStdUnorderedMap<uint64_t, KStdVector<ObjHeader*>>* freezeDedupTable = nullptr;
+
+// Describes the value payload of a frozen leaf eligible for deduplication:
+// a string or an immutable object with no reference fields, alone in its
+// container. Everything else keeps its identity.
+bool dedupPayload(ObjHeader* obj, const void** data, size_t* size) {
+  const TypeInfo* type = obj->type_info();
+  if (type == theStringTypeInfo) {
+    ArrayHeader* array = obj->array();
+    *data = AddressOfElementAt<KChar>(array, 0);
+    *size = array->count_ * sizeof(KChar);
+    return true;
+  }
+  if ((type->flags_ & TF_IMMUTABLE) != 0 && type->instanceSize_ >= 0 &&
+      type->objOffsetsCount_ == 0 &&
+      static_cast<size_t>(type->instanceSize_) > sizeof(ObjHeader)) {
+    *data = reinterpret_cast<const char*>(obj) + sizeof(ObjHeader);
+    *size = type->instanceSize_ - sizeof(ObjHeader);
+    return true;
+  }
+  return false;
+}
+
+uint64_t dedupHash(const TypeInfo* type, const void* data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ull ^ reinterpret_cast<uintptr_t>(type);
+  auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool sameFrozenValue(ObjHeader* a, ObjHeader* b,
+                     const void* aData, size_t aSize) {
+  if (a->type_info() != b->type_info()) return false;
+  const void* bData;
+  size_t bSize;
+  if (!dedupPayload(b, &bData, &bSize)) return false;
+  return aSize == bSize && memcmp(aData, bData, aSize) == 0;
+}
+
+// Replaces *location with the canonical object of equal value, if one is
+// already known, or records *location as the canonical. Reference counts
+// are adjusted so duplicates can be reclaimed once fully unlinked.
+void canonicalizeLocation(ObjHeader** location) {
+  ObjHeader* obj = *location;
+  const void* data;
+  size_t size;
+  if (!dedupPayload(obj, &data, &size)) return;
+  uint64_t hash = dedupHash(obj->type_info(), data, size);
+  auto& bucket = (*freezeDedupTable)[hash];
+  for (auto* candidate : bucket) {
+    if (candidate == obj) return;
+    if (sameFrozenValue(obj, candidate, data, size)) {
+      *location = candidate;
+      addHeapRef(candidate);
+      ReleaseHeapRef(obj);
+      return;
+    }
+  }
+  addHeapRef(obj);
+  bucket.push_back(obj);
+}
+
+// Walks the freshly frozen containers and hash-conses the immutable leaf
+// values they reference. References from older frozen graphs are left alone:
+// the frozen heap is closed, so they cannot point into this subgraph anyway.
+void dedupFrozenLeaves(ContainerHeaderSet* newlyFrozen) {
+  LockGuard<SimpleMutex> guard(freezeDedupLock);
+  if (freezeDedupTable == nullptr)
+    freezeDedupTable = konanConstructInstance<KStdUnorderedMap<uint64_t, KStdVector<ObjHeader*>>>();
+  for (auto* container : *newlyFrozen) {
+    if (isAggregatingFrozenContainer(container)) continue;
+    traverseContainerObjectFields(container, [](ObjHeader** location) {
+      ObjHeader* obj = *location;
+      if (obj == nullptr) return;
+      auto* objContainer = containerFor(obj);
+      // Permanent objects are deduplicated by the compiler already.
+      if (objContainer == nullptr || !objContainer->frozen() ||
+          objContainer->objectCount() != 1)
+        return;
+      canonicalizeLocation(location);
+    });
+  }
+}
+
 void freezeSubgraph(ObjHeader* root) {
   if (root == nullptr) return;
   // First check that passed object graph has no cycles.
@@ -2866,14 +4519,19 @@ void freezeSubgraph(ObjHeader* root) {
   }
   MEMORY_LOG("Graph of %p is %s with %d elements\n", root, hasCycles ? "cyclic" : "acyclic", newlyFrozen.size())
 
+  if (g_freezeDeduplication && !newlyFrozen.empty())
+    dedupFrozenLeaves(&newlyFrozen);
+
 #if USE_GC
-  // Now remove frozen objects from the toFree list.
+  // Now remove frozen objects from the toFree lists.
   // TODO: optimize it by keeping ignored (i.e. freshly frozen) objects in the set,
   // and use it when analyzing toFree during collection.
-  for (auto& container : *(state->toFree)) {
-    if (!isMarkedAsRemoved(container) && container->frozen()) {
-      RuntimeAssert(newlyFrozen.count(container) != 0, "Must be newly frozen");
-      container = markAsRemoved(container);
+  for (auto* list : {state->toFree, state->toFreeMature}) {
+    for (auto& container : *list) {
+      if (!isMarkedAsRemoved(container) && container->frozen()) {
+        RuntimeAssert(newlyFrozen.count(container) != 0, "Must be newly frozen");
+        container = markAsRemoved(container);
+      }
     }
   }
 #endif
@@ -2895,6 +4553,305 @@ void shareAny(ObjHeader* obj) {
   container->makeShared();
 }
 
+#if USE_MMAP_CONTAINERS
+
+namespace {
+
+// A heap segment is a frozen subgraph serialized into a relocatable file that
+// sibling processes of the same binary map as a block of permanent objects, so
+// a large read-only dataset is built once and its pages shared host-wide.
+// Object images are copied verbatim minus meta-objects; every pointer slot gets
+// a relocation: references between segment objects are stored as offsets into
+// the data section, while type infos and references to permanent objects are
+// stored as writer addresses and shifted by the image ASLR slide at load time.
+
+constexpr uint64_t kHeapSegmentMagic = 0x3147455348534e4bull;  // "KNSHSEG1", little-endian.
+constexpr uint64_t kHeapSegmentVersion = 1;
+
+constexpr uint64_t HEAP_SEGMENT_RELOC_SEGMENT = 0;  // Slot holds an offset into the data section.
+constexpr uint64_t HEAP_SEGMENT_RELOC_IMAGE = 1;    // Slot holds a writer image address; add the slide.
+
+struct HeapSegmentHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t anchor;  // Writer address of an image symbol, the slide base.
+  uint64_t dataSize;
+  uint64_t relocationCount;
+  uint64_t rootOffset;
+};
+
+struct HeapSegmentRelocation {
+  uint64_t offset;  // Byte offset of the pointer slot in the data section.
+  uint64_t kind;
+};
+
+// Any symbol of the executable image works as the anchor: Kotlin binaries are
+// statically linked, so runtime, compiled code and type infos slide as one.
+// Only processes running the very same binary can map each other's segments.
+inline uintptr_t heapSegmentAnchor() {
+  return reinterpret_cast<uintptr_t>(&theStringTypeInfo);
+}
+
+bool writeHeapSegment(ObjHeader* root, const char* path) {
+  if (root == nullptr || root->permanent()) return false;
+  // Collect the subgraph and assign segment offsets in traversal order.
+  KStdUnorderedMap<ObjHeader*, uint64_t> offsets;
+  KStdVector<ObjHeader*> order;
+  KStdDeque<ObjHeader*> toVisit;
+  toVisit.push_back(root);
+  uint64_t dataSize = 0;
+  while (!toVisit.empty()) {
+    ObjHeader* obj = toVisit.front();
+    toVisit.pop_front();
+    if (obj->permanent() || offsets.count(obj) != 0) continue;
+    // Refuse subgraphs with mutable state: the segment bypasses all accounting.
+    if (!isFrozen(obj)) return false;
+    offsets[obj] = dataSize;
+    order.push_back(obj);
+    dataSize += objectSize(obj);
+    traverseReferredObjects(obj, [&toVisit](ObjHeader* field) { toVisit.push_back(field); });
+  }
+
+  FILE* out = fopen(path, "wb");
+  if (out == nullptr) return false;
+  HeapSegmentHeader header = {kHeapSegmentMagic, kHeapSegmentVersion,
+      static_cast<uint64_t>(heapSegmentAnchor()), dataSize, 0, offsets[root]};
+  fwrite(&header, sizeof(header), 1, out);
+
+  KStdVector<HeapSegmentRelocation> relocations;
+  KStdVector<char> image;
+  for (auto* obj : order) {
+    uint64_t base = offsets[obj];
+    container_size_t size = objectSize(obj);
+    image.assign(reinterpret_cast<char*>(obj), reinterpret_cast<char*>(obj) + size);
+    auto* copy = reinterpret_cast<ObjHeader*>(image.data());
+    // Drop a possible meta-object (weak counters et al. are per-process state)
+    // and mark the copy permanent, so readers never touch reference counts.
+    copy->typeInfoOrMeta_ = setPointerBits(
+        const_cast<TypeInfo*>(obj->type_info()), OBJECT_TAG_PERMANENT_CONTAINER);
+    relocations.push_back({base, HEAP_SEGMENT_RELOC_IMAGE});
+    traverseObjectFields(obj, [&](ObjHeader** location) {
+      ObjHeader* ref = *location;
+      if (ref == nullptr) return;
+      uint64_t fieldOffset = static_cast<uint64_t>(
+          reinterpret_cast<char*>(location) - reinterpret_cast<char*>(obj));
+      auto** slot = reinterpret_cast<ObjHeader**>(image.data() + fieldOffset);
+      if (ref->permanent()) {
+        relocations.push_back({base + fieldOffset, HEAP_SEGMENT_RELOC_IMAGE});
+      } else {
+        *slot = reinterpret_cast<ObjHeader*>(static_cast<uintptr_t>(offsets[ref]));
+        relocations.push_back({base + fieldOffset, HEAP_SEGMENT_RELOC_SEGMENT});
+      }
+    });
+    fwrite(image.data(), 1, size, out);
+  }
+  fwrite(relocations.data(), sizeof(HeapSegmentRelocation), relocations.size(), out);
+  header.relocationCount = relocations.size();
+  fseek(out, 0, SEEK_SET);
+  fwrite(&header, sizeof(header), 1, out);
+  return fclose(out) == 0;
+}
+
+OBJ_GETTER(mapHeapSegment, const char* path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) RETURN_OBJ(nullptr);
+  off_t fileSize = lseek(fd, 0, SEEK_END);
+  if (fileSize < static_cast<off_t>(sizeof(HeapSegmentHeader))) {
+    close(fd);
+    RETURN_OBJ(nullptr);
+  }
+  // MAP_PRIVATE over the same file: pages stay shared between sibling processes
+  // until a relocation dirties them, so only pages with pointer slots go private.
+  void* mapping = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) RETURN_OBJ(nullptr);
+  auto* header = static_cast<HeapSegmentHeader*>(mapping);
+  char* data = static_cast<char*>(mapping) + sizeof(HeapSegmentHeader);
+  bool valid = header->magic == kHeapSegmentMagic && header->version == kHeapSegmentVersion &&
+      sizeof(HeapSegmentHeader) + header->dataSize +
+          header->relocationCount * sizeof(HeapSegmentRelocation) <=
+          static_cast<uint64_t>(fileSize) &&
+      header->rootOffset < header->dataSize;
+  auto* relocations = reinterpret_cast<HeapSegmentRelocation*>(data + header->dataSize);
+  uintptr_t slide = heapSegmentAnchor() - static_cast<uintptr_t>(header->anchor);
+  for (uint64_t i = 0; valid && i < header->relocationCount; i++) {
+    if (relocations[i].offset + sizeof(uintptr_t) > header->dataSize) {
+      valid = false;
+      break;
+    }
+    auto* slot = reinterpret_cast<uintptr_t*>(data + relocations[i].offset);
+    if (relocations[i].kind == HEAP_SEGMENT_RELOC_SEGMENT) {
+      *slot = reinterpret_cast<uintptr_t>(data) + *slot;
+    } else {
+      *slot += slide;
+    }
+  }
+  if (!valid) {
+    munmap(mapping, fileSize);
+    RETURN_OBJ(nullptr);
+  }
+  // The segment is permanent: it lives until process exit, like any permanent
+  // object, so the mapping is intentionally never unmapped.
+  mprotect(mapping, fileSize, PROT_READ);
+  RETURN_OBJ(reinterpret_cast<ObjHeader*>(data + header->rootOffset));
+}
+
+}  // namespace
+
+#endif  // USE_MMAP_CONTAINERS
+
+namespace {
+
+// Binary heap dump for offline analysis, in the spirit of Java's hprof: a flat
+// stream of self-describing records with bounded writer memory. Type infos are
+// emitted once on first use with their names, objects carry identity, type,
+// container state, shallow size and the full list of outgoing references, so
+// dominators and retained sizes are computed offline from the reference graph.
+// Roots are what the runtime can enumerate from the calling thread: its
+// thread-local variable slots and the GC candidate queues.
+
+constexpr uint32_t kHeapDumpMagic = 0x504d4448;  // "HDMP", little-endian.
+constexpr uint32_t kHeapDumpVersion = 1;
+
+constexpr uint8_t HEAP_DUMP_RECORD_TYPEINFO = 1;
+constexpr uint8_t HEAP_DUMP_RECORD_OBJECT = 2;
+constexpr uint8_t HEAP_DUMP_RECORD_ROOT = 3;
+
+constexpr uint8_t HEAP_DUMP_ROOT_TLS = 1;
+constexpr uint8_t HEAP_DUMP_ROOT_GC_CANDIDATE = 2;
+
+constexpr uint32_t HEAP_DUMP_OBJECT_PERMANENT = 1;
+constexpr uint32_t HEAP_DUMP_OBJECT_FROZEN = 2;
+constexpr uint32_t HEAP_DUMP_OBJECT_STACK = 4;
+
+class HeapDumpWriter {
+ public:
+  explicit HeapDumpWriter(FILE* out) : out_(out) {}
+
+  void writeHeader() {
+    write(kHeapDumpMagic);
+    write(kHeapDumpVersion);
+    write(static_cast<uint32_t>(sizeof(void*)));
+  }
+
+  void writeRoot(ObjHeader* obj, uint8_t kind) {
+    write(HEAP_DUMP_RECORD_ROOT);
+    write(kind);
+    writeId(obj);
+  }
+
+  void writeObject(ObjHeader* obj) {
+    const TypeInfo* typeInfo = obj->type_info();
+    writeTypeInfo(typeInfo);
+    write(HEAP_DUMP_RECORD_OBJECT);
+    writeId(obj);
+    writeId(typeInfo);
+    uint32_t flags = 0;
+    uint32_t refCount = 0;
+    if (obj->permanent()) {
+      flags |= HEAP_DUMP_OBJECT_PERMANENT;
+    } else {
+      auto* container = containerFor(obj);
+      if (container != nullptr) {
+        if (container->frozen()) flags |= HEAP_DUMP_OBJECT_FROZEN;
+        if (container->stack()) flags |= HEAP_DUMP_OBJECT_STACK;
+        refCount = static_cast<uint32_t>(container->refCount());
+      }
+    }
+    write(flags);
+    write(refCount);
+    write(static_cast<uint32_t>(objectSize(obj)));
+    write(typeInfo->instanceSize_ < 0 ? static_cast<int32_t>(obj->array()->count_)
+                                      : static_cast<int32_t>(-1));
+    references_.clear();
+    traverseReferredObjects(obj, [this](ObjHeader* ref) { references_.push_back(ref); });
+    write(static_cast<uint32_t>(references_.size()));
+    for (auto* ref : references_) writeId(ref);
+  }
+
+ private:
+  void write(const void* data, size_t size) { fwrite(data, 1, size, out_); }
+
+  template <typename T>
+  void write(T value) { write(&value, sizeof(T)); }
+
+  void writeId(const void* pointer) {
+    write(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)));
+  }
+
+  void writeString(const char* string) {
+    uint32_t length = string != nullptr ? ::strlen(string) : 0;
+    write(length);
+    if (length != 0) write(string, length);
+  }
+
+  void writeTypeInfo(const TypeInfo* typeInfo) {
+    if (!dumpedTypes_.insert(typeInfo).second) return;
+    write(HEAP_DUMP_RECORD_TYPEINFO);
+    writeId(typeInfo);
+    write(typeInfo->instanceSize_);
+    char* package =
+        typeInfo->packageName_ != nullptr ? CreateCStringFromString(typeInfo->packageName_) : nullptr;
+    char* relative =
+        typeInfo->relativeName_ != nullptr ? CreateCStringFromString(typeInfo->relativeName_) : nullptr;
+    writeString(package);
+    writeString(relative);
+    DisposeCString(package);
+    DisposeCString(relative);
+  }
+
+  FILE* out_;
+  KStdUnorderedSet<const TypeInfo*> dumpedTypes_;
+  KStdVector<ObjHeader*> references_;
+};
+
+bool dumpHeap(const char* path) {
+  FILE* out = fopen(path, "wb");
+  if (out == nullptr) return false;
+  HeapDumpWriter writer(out);
+  writer.writeHeader();
+
+  auto* state = memoryState;
+  KStdUnorderedSet<ObjHeader*> visited;
+  KStdDeque<ObjHeader*> toVisit;
+  auto addRoot = [&writer, &visited, &toVisit](ObjHeader* obj, uint8_t kind) {
+    if (obj == nullptr || !visited.insert(obj).second) return;
+    writer.writeRoot(obj, kind);
+    toVisit.push_back(obj);
+  };
+  // Thread-local variable slots of the calling thread.
+  for (auto& entry : *state->tlsMap) {
+    KRef* slots = entry.second.first;
+    for (int i = 0; i < entry.second.second; i++) {
+      addRoot(slots[i], HEAP_DUMP_ROOT_TLS);
+    }
+  }
+#if USE_GC
+  // The GC candidate queues, covering the recently mutated part of the heap.
+  auto addContainerRoots = [&addRoot](ContainerHeader* container) {
+    if (container == nullptr || isAggregatingFrozenContainer(container)) return;
+    traverseContainerObjects(container, [&addRoot](ObjHeader* obj) {
+      addRoot(obj, HEAP_DUMP_ROOT_GC_CANDIDATE);
+    });
+  };
+  for (auto* container : *state->toFree) addContainerRoots(container);
+  for (auto* container : *state->toFreeMature) addContainerRoots(container);
+  for (auto* container : *state->toRelease) addContainerRoots(container);
+#endif  // USE_GC
+
+  while (!toVisit.empty()) {
+    ObjHeader* obj = toVisit.front();
+    toVisit.pop_front();
+    writer.writeObject(obj);
+    traverseReferredObjects(obj, [&visited, &toVisit](ObjHeader* ref) {
+      if (ref != nullptr && visited.insert(ref).second) toVisit.push_back(ref);
+    });
+  }
+  return fclose(out) == 0;
+}
+
+}  // namespace
+
 ScopedRefHolder::ScopedRefHolder(KRef obj): obj_(obj) {
   if (obj_) {
     addHeapRef(obj_);
@@ -3053,6 +5010,7 @@ void ObjHeader::destroyMetaObject(TypeInfo** location) {
     WeakReferenceCounterClear(meta->WeakReference.counter_);
     ZeroHeapRef(&meta->WeakReference.counter_);
   }
+  runObjectDeathHooks(meta);
 
 #ifdef KONAN_OBJC_INTEROP
   Kotlin_ObjCExport_releaseAssociatedObject(meta->associatedObject_);
@@ -3064,7 +5022,11 @@ void ObjHeader::destroyMetaObject(TypeInfo** location) {
 void ObjectContainer::Init(MemoryState* state, const TypeInfo* typeInfo) {
   RuntimeAssert(typeInfo->instanceSize_ >= 0, "Must be an object");
   uint32_t allocSize = sizeof(ContainerHeader) + typeInfo->instanceSize_;
-  header_ = allocContainer(state, allocSize);
+  if ((typeInfo->flags_ & TF_ALIGNED_PAYLOAD) != 0)
+    // For plain objects the whole container starts on its own cache line.
+    header_ = allocAlignedContainer(state, allocSize, kAlignedPayloadAlignment, /* payloadOffset = */ 0);
+  else
+    header_ = allocContainer(state, allocSize);
   RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
   // One object in this container, no need to set.
   header_->setContainerSize(allocSize);
@@ -3074,11 +5036,20 @@ void ObjectContainer::Init(MemoryState* state, const TypeInfo* typeInfo) {
   OBJECT_ALLOC_EVENT(memoryState, typeInfo->instanceSize_, GetPlace())
 }
 
-void ArrayContainer::Init(MemoryState* state, const TypeInfo* typeInfo, uint32_t elements) {
+void ArrayContainer::Init(MemoryState* state, const TypeInfo* typeInfo, uint32_t elements, bool zeroBody,
+                          uint32_t payloadAlignment) {
   RuntimeAssert(typeInfo->instanceSize_ < 0, "Must be an array");
   uint32_t allocSize =
       sizeof(ContainerHeader) + arrayObjectSize(typeInfo, elements);
-  header_ = allocContainer(state, allocSize);
+  uint32_t alignment = payloadAlignment != 0
+      ? payloadAlignment
+      : ((typeInfo->flags_ & TF_ALIGNED_PAYLOAD) != 0 ? kAlignedPayloadAlignment : 0);
+  if (alignment > kObjectAlignment)
+    // For arrays the element data itself lands on the boundary.
+    header_ = allocAlignedContainer(state, allocSize, alignment,
+                                    sizeof(ContainerHeader) + sizeof(ArrayHeader));
+  else
+    header_ = allocContainer(state, allocSize, zeroBody);
   RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
   // One object in this container, no need to set.
   header_->setContainerSize(allocSize);
@@ -3097,6 +5068,20 @@ void ArenaContainer::Init() {
 
 void ArenaContainer::Deinit() {
   MEMORY_LOG("Arena::Deinit start: %p\n", this)
+#if USE_GC
+  // The GC stack scan may have queued decrements against our chunks; scrub those
+  // entries before the chunk memory is returned.
+  auto* state = memoryState;
+  if (state != nullptr && state->toRelease != nullptr) {
+    for (auto it = state->toRelease->begin(); it != state->toRelease->end(); ++it) {
+      auto* container = *it;
+      if (!isMarkedAsRemoved(container) && container->stack() &&
+          (reinterpret_cast<ContainerChunk*>(container) - 1)->arena == this) {
+        *it = markAsRemoved(container);
+      }
+    }
+  }
+#endif  // USE_GC
   auto chunk = currentChunk_;
   while (chunk != nullptr) {
     // freeContainer() doesn't release memory when CONTAINER_TAG_STACK is set.
@@ -3182,6 +5167,26 @@ ArrayHeader* ArenaContainer::PlaceArray(const TypeInfo* type_info, uint32_t coun
   return result;
 }
 
+ArenaScopeRecord* enterArenaScope() {
+  auto* state = memoryState;
+  auto* record = konanConstructInstance<ArenaScopeRecord>();
+  record->arena.Init();
+  record->previous = state->arenaScope;
+  state->arenaScope = record;
+  return record;
+}
+
+void leaveArenaScope(ArenaScopeRecord* record) {
+  auto* state = memoryState;
+  RuntimeCheck(record != nullptr && record == state->arenaScope,
+               "Arena scopes must be left in the reverse order of entering");
+  state->arenaScope = record->previous;
+  // Releases references held by scope objects and frees the chunks wholesale,
+  // individual objects are not visited by the garbage collector.
+  record->arena.Deinit();
+  konanDestructInstance(record);
+}
+
 // API of the memory manager.
 extern "C" {
 
@@ -3241,6 +5246,26 @@ void RestoreMemory(MemoryState* memoryState) {
     ::memoryState = memoryState;
 }
 
+MemoryState* SuspendMemory() {
+    MemoryState* result = ::memoryState;
+    if (result != nullptr) {
+      result->suspendedFrame = ::currentFrame;
+    }
+    ::memoryState = nullptr;
+    ::currentFrame = nullptr;
+    return result;
+}
+
+void ResumeMemory(MemoryState* memoryState) {
+    RuntimeAssert(::memoryState == nullptr, "Must not resume a memory state over an active one");
+    ::memoryState = memoryState;
+    ::currentFrame = memoryState != nullptr ? memoryState->suspendedFrame : nullptr;
+}
+
+MemoryState* GetMemoryState() {
+  return ::memoryState;
+}
+
 OBJ_GETTER(AllocInstanceStrict, const TypeInfo* type_info) {
   RETURN_RESULT_OF(allocInstance<true>, type_info);
 }
@@ -3255,6 +5280,82 @@ OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* typeInfo, int32_t elements
   RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements);
 }
 
+OBJ_GETTER(AllocArrayInstanceAlignedStrict, const TypeInfo* typeInfo, int32_t elements, int32_t alignment) {
+  RETURN_RESULT_OF(allocArrayInstanceAligned<true>, typeInfo, elements, alignment);
+}
+OBJ_GETTER(AllocArrayInstanceAlignedRelaxed, const TypeInfo* typeInfo, int32_t elements, int32_t alignment) {
+  RETURN_RESULT_OF(allocArrayInstanceAligned<false>, typeInfo, elements, alignment);
+}
+
+OBJ_GETTER(AllocArrayInstanceUninitializedStrict, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceUninitialized<true>, typeInfo, elements);
+}
+OBJ_GETTER(AllocArrayInstanceUninitializedRelaxed, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceUninitialized<false>, typeInfo, elements);
+}
+
+OBJ_GETTER(AllocInstanceWithStateStrict, MemoryState* state, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceWithState<true>, state, type_info);
+}
+OBJ_GETTER(AllocInstanceWithStateRelaxed, MemoryState* state, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceWithState<false>, state, type_info);
+}
+
+OBJ_GETTER(AllocArrayInstanceWithStateStrict, MemoryState* state, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceWithState<true>, state, typeInfo, elements);
+}
+OBJ_GETTER(AllocArrayInstanceWithStateRelaxed, MemoryState* state, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceWithState<false>, state, typeInfo, elements);
+}
+
+bool TryGrowArrayInPlace(ArrayHeader* array, int32_t newCount) {
+  auto* obj = array->obj();
+  if (newCount < 0 || static_cast<uint32_t>(newCount) < array->count_) return false;
+  if (static_cast<uint32_t>(newCount) == array->count_) return true;
+  // Only a plain single-object heap container can grow: tag bits mean a permanent
+  // or stack object, a meta object may be a weak counter observing the array, and
+  // a shareable container may be read concurrently.
+  if (getPointerBits(obj->typeInfoOrMeta_, OBJECT_TAG_MASK) != 0 || obj->has_meta_object())
+    return false;
+  auto* container = containerFor(obj);
+  if (container == nullptr || container->shareable() || container->stack() ||
+      container->objectCount() != 1)
+    return false;
+#if USE_ALLOC_NURSERY
+  // Nursery blocks are carved from bump chunks back to back; there is no slack.
+  if (nurseryChunkFor(container) != nullptr) return false;
+#endif
+  container_size_t oldSize = sizeof(ContainerHeader) + arrayObjectSize(array);
+  container_size_t newSize = sizeof(ContainerHeader) +
+      arrayObjectSize(array->type_info(), static_cast<uint32_t>(newCount));
+  if (konan::usableSize(container) < newSize) return false;
+  // The allocator's slack behind the originally requested size is not zeroed.
+  memset(reinterpret_cast<uint8_t*>(container) + oldSize, 0, newSize - oldSize);
+  array->count_ = static_cast<uint32_t>(newCount);
+  return true;
+}
+
+OBJ_GETTER(AllocInstanceInFrameStrict, ObjHeader** auxSlot, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceInFrame<true>, auxSlot, type_info);
+}
+OBJ_GETTER(AllocInstanceInFrameRelaxed, ObjHeader** auxSlot, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(allocInstanceInFrame<false>, auxSlot, type_info);
+}
+
+OBJ_GETTER(AllocArrayInstanceInFrameStrict, ObjHeader** auxSlot, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceInFrame<true>, auxSlot, typeInfo, elements);
+}
+OBJ_GETTER(AllocArrayInstanceInFrameRelaxed, ObjHeader** auxSlot, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstanceInFrame<false>, auxSlot, typeInfo, elements);
+}
+
+OBJ_GETTER(PromoteObjectToHeapStrict, ObjHeader* object) {
+  RETURN_RESULT_OF(promoteObjectToHeap<true>, object);
+}
+OBJ_GETTER(PromoteObjectToHeapRelaxed, ObjHeader* object) {
+  RETURN_RESULT_OF(promoteObjectToHeap<false>, object);
+}
+
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(initInstance<true>, location, typeInfo, ctor);
@@ -3312,6 +5413,18 @@ void UpdateHeapRefRelaxed(ObjHeader** location, const ObjHeader* object) {
   updateHeapRef<false>(location, object);
 }
 
+void UpdateHeapRefWithStateStrict(MemoryState* state, ObjHeader** location, const ObjHeader* object) {
+  updateHeapRefWithState<true>(state, location, object);
+}
+void UpdateHeapRefWithStateRelaxed(MemoryState* state, ObjHeader** location, const ObjHeader* object) {
+  updateHeapRefWithState<false>(state, location, object);
+}
+
+void UpdateHeapRefsBulk(const ObjHeader* object, ObjHeader** const locations[],
+                        const ObjHeader* const values[], int count) {
+  updateHeapRefsBulk(object, locations, values, count);
+}
+
 void UpdateReturnRefStrict(ObjHeader** returnSlot, const ObjHeader* value) {
   updateReturnRef<true>(returnSlot, value);
 }
@@ -3442,6 +5555,145 @@ KLong Kotlin_native_internal_GC_getThresholdAllocations(KRef) {
 #endif
 }
 
+KLong Kotlin_native_internal_GC_getMmappedArraysTotalBytes(KRef) {
+#if USE_MMAP_CONTAINERS
+  lock(&mmapRegistryLock);
+  KLong result = static_cast<KLong>(mmappedContainerBytes);
+  unlock(&mmapRegistryLock);
+  return result;
+#else
+  return 0;
+#endif
+}
+
+KLong Kotlin_native_internal_GC_getHugePageAdvisedBytes(KRef) {
+#if USE_MMAP_CONTAINERS && defined(MADV_HUGEPAGE)
+  lock(&mmapRegistryLock);
+  KLong result = static_cast<KLong>(hugePageAdvisedBytes);
+  unlock(&mmapRegistryLock);
+  return result;
+#else
+  return 0;
+#endif
+}
+
+void Kotlin_native_internal_GC_setIncremental(KRef, KBoolean value) {
+#if USE_GC
+  setGCIncremental(value);
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_getIncremental(KRef) {
+#if USE_GC
+  return getGCIncremental();
+#else
+  return false;
+#endif
+}
+
+void Kotlin_native_internal_GC_setPacer(KRef, KBoolean value) {
+#if USE_GC
+  setGCPacer(value);
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_getPacer(KRef) {
+#if USE_GC
+  return getGCPacer();
+#else
+  return false;
+#endif
+}
+
+void Kotlin_native_internal_GC_setPauseBudget(KRef, KLong value) {
+#if USE_GC
+  setGCPauseBudget(value);
+#endif
+}
+
+KLong Kotlin_native_internal_GC_getPauseBudget(KRef) {
+#if USE_GC
+  return getGCPauseBudget();
+#else
+  return -1;
+#endif
+}
+
+void Kotlin_native_internal_GC_setHeapGrowthFactor(KRef, KDouble value) {
+#if USE_GC
+  setGCHeapGrowthFactor(value);
+#endif
+}
+
+KDouble Kotlin_native_internal_GC_getHeapGrowthFactor(KRef) {
+#if USE_GC
+  return getGCHeapGrowthFactor();
+#else
+  return -1.0;
+#endif
+}
+
+KInt Kotlin_native_internal_GC_getMmappedArraysCount(KRef) {
+#if USE_MMAP_CONTAINERS
+  return atomicGet(&mmappedContainerCount);
+#else
+  return 0;
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_writeHeapSegment(KRef, KRef root, KRef path) {
+#if USE_MMAP_CONTAINERS
+  char* cPath = CreateCStringFromString(path);
+  bool result = writeHeapSegment(root, cPath);
+  DisposeCString(cPath);
+  return result;
+#else
+  return false;
+#endif
+}
+
+OBJ_GETTER(Kotlin_native_internal_GC_mapHeapSegment, KRef, KRef path) {
+#if USE_MMAP_CONTAINERS
+  char* cPath = CreateCStringFromString(path);
+  ObjHeader* result = mapHeapSegment(cPath, OBJ_RESULT);
+  DisposeCString(cPath);
+  return result;
+#else
+  RETURN_OBJ(nullptr);
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_dumpHeap(KRef, KRef path) {
+  char* cPath = CreateCStringFromString(path);
+  bool result = dumpHeap(cPath);
+  DisposeCString(cPath);
+  return result;
+}
+
+KBoolean Kotlin_native_internal_GC_getAllocationProfiling(KRef) {
+  return atomicGet(&g_allocProfileEnabled) != 0;
+}
+
+void Kotlin_native_internal_GC_setAllocationProfiling(KRef, KBoolean value) {
+  atomicSet(&g_allocProfileEnabled, value ? 1 : 0);
+}
+
+KInt Kotlin_native_internal_GC_getAllocationProfilingPeriod(KRef) {
+  return g_allocProfileRate;
+}
+
+void Kotlin_native_internal_GC_setAllocationProfilingPeriod(KRef, KInt value) {
+  if (value < 1) ThrowIllegalArgumentException();
+  g_allocProfileRate = value;
+}
+
+KBoolean Kotlin_native_internal_GC_dumpAllocationProfile(KRef, KRef path) {
+  char* cPath = CreateCStringFromString(path);
+  bool result = dumpAllocProfile(cPath);
+  DisposeCString(cPath);
+  return result;
+}
+
 void Kotlin_native_internal_GC_setTuneThreshold(KRef, KInt value) {
 #if USE_GC
   setTuneGCThreshold(value);
@@ -3456,6 +5708,23 @@ KBoolean Kotlin_native_internal_GC_getTuneThreshold(KRef) {
 #endif
 }
 
+void Kotlin_native_internal_GC_setDeferredRefCounting(KRef, KBoolean value) {
+#if USE_GC
+  setDeferredRefCounting(value);
+#else
+  if (value)
+    ThrowIllegalArgumentException();
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_getDeferredRefCounting(KRef) {
+#if USE_GC
+  return getDeferredRefCounting();
+#else
+  return false;
+#endif
+}
+
 OBJ_GETTER(Kotlin_native_internal_GC_detectCycles, KRef) {
 #if USE_CYCLE_DETECTOR
   if (!KonanNeedDebugInfo || !Kotlin_memoryLeakCheckerEnabled()) RETURN_OBJ(nullptr);
@@ -3493,6 +5762,22 @@ bool ClearSubgraphReferences(ObjHeader* root, bool checked) {
   return clearSubgraphReferences(root, checked);
 }
 
+void* CompactSubgraph(void* stable) {
+#if USE_ALLOC_NURSERY
+  return compactSubgraph(stable);
+#else
+  return stable;
+#endif
+}
+
+void* EnterArenaScope() {
+  return enterArenaScope();
+}
+
+void LeaveArenaScope(void* scope) {
+  leaveArenaScope(static_cast<ArenaScopeRecord*>(scope));
+}
+
 void FreezeSubgraph(ObjHeader* root) {
   freezeSubgraph(root);
 }
@@ -3522,6 +5807,37 @@ void Kotlin_Any_share(ObjHeader* obj) {
   shareAny(obj);
 }
 
+void AddObjectDeathHook(ObjHeader* obj, void (*hook)(void*), void* entry) {
+  // Permanent objects never die, so there is nothing to hook.
+  if (obj->permanent()) return;
+  auto* meta = obj->meta_object();
+  auto* node = konanConstructInstance<ObjectDeathHook>();
+  node->hook_ = hook;
+  node->entry_ = entry;
+  lock(&deathHooksLock);
+  node->next_ = meta->DeathHooks.head_;
+  meta->DeathHooks.head_ = node;
+  unlock(&deathHooksLock);
+}
+
+bool RemoveObjectDeathHook(ObjHeader* obj, void* entry) {
+  if (obj->permanent() || !obj->has_meta_object()) return false;
+  auto* meta = obj->meta_object();
+  ObjectDeathHook* node;
+  lock(&deathHooksLock);
+  ObjectDeathHook** prev = &meta->DeathHooks.head_;
+  node = *prev;
+  while (node != nullptr && node->entry_ != entry) {
+    prev = &node->next_;
+    node = node->next_;
+  }
+  if (node != nullptr) *prev = node->next_;
+  unlock(&deathHooksLock);
+  if (node == nullptr) return false;
+  konanFreeMemory(node);
+  return true;
+}
+
 void AddTLSRecord(MemoryState* memory, void** key, int size) {
   auto* tlsMap = memory->tlsMap;
   auto it = tlsMap->find(key);
@@ -3583,6 +5899,35 @@ void GC_CollectorCallback(void* worker) {
 #endif   // USE_CYCLIC_GC
 }
 
+bool GC_PerformIdleSlice() {
+#if USE_GC
+  MemoryState* state = ::memoryState;
+  if (state == nullptr || state->toFree == nullptr || state->gcSuspendCount != 0 || state->gcInProgress)
+    return false;
+  // The reference-count backlog first: one regular collection, which in
+  // incremental mode is bounded to a single slice.
+  if (state->gcSweepPending || state->toRelease->size() > 0 || state->finalizerQueueSize > 0) {
+    GC_LOG("Idle GC slice: toRelease %d finalizer queue %d\n",
+           state->toRelease->size(), state->finalizerQueueSize)
+    garbageCollect(state, false);
+  } else if (state->toFree->size() > 0) {
+    // Only cycle candidates left. Idle time is the cheapest moment for a trial
+    // deletion pass, so run one without waiting for the candidate threshold.
+    GC_LOG("Idle GC cyclic pass: toFree %d mature %d\n",
+           state->toFree->size(), state->toFreeMature->size())
+    auto savedThreshold = state->gcCollectCyclesThreshold;
+    state->gcCollectCyclesThreshold = 0;
+    garbageCollect(state, false);
+    state->gcCollectCyclesThreshold = savedThreshold;
+  }
+  // Surviving cycle candidates are not productive work: reporting them would
+  // make the caller donate slices until something actually becomes garbage.
+  return state->gcSweepPending || state->toRelease->size() > 0 || state->finalizerQueueSize > 0;
+#else
+  return false;
+#endif  // USE_GC
+}
+
 KBoolean Kotlin_native_internal_GC_getCyclicCollector(KRef gc) {
 #if USE_CYCLIC_GC
   return g_hasCyclicCollector;
@@ -3600,6 +5945,49 @@ void Kotlin_native_internal_GC_setCyclicCollector(KRef gc, KBoolean value) {
 #endif  // USE_CYCLIC_GC
 }
 
+KBoolean Kotlin_native_internal_GC_getCyclicCollectorFixup(KRef gc) {
+#if USE_CYCLIC_GC
+  return cyclicGetConcurrentFixup();
+#else
+  return false;
+#endif  // USE_CYCLIC_GC
+}
+
+void Kotlin_native_internal_GC_setCyclicCollectorFixup(KRef gc, KBoolean value) {
+#if USE_CYCLIC_GC
+  cyclicSetConcurrentFixup(value);
+#else
+  if (value)
+    ThrowIllegalArgumentException();
+#endif  // USE_CYCLIC_GC
+}
+
+KInt Kotlin_native_internal_GC_getLeakDetectionCycles(KRef gc) {
+#if USE_CYCLIC_GC
+  return cyclicGetLeakDetectionCycles();
+#else
+  return 0;
+#endif  // USE_CYCLIC_GC
+}
+
+void Kotlin_native_internal_GC_setLeakDetectionCycles(KRef gc, KInt value) {
+#if USE_CYCLIC_GC
+  if (value < 0) ThrowIllegalArgumentException();
+  cyclicSetLeakDetectionCycles(value);
+#else
+  if (value != 0)
+    ThrowIllegalArgumentException();
+#endif  // USE_CYCLIC_GC
+}
+
+KBoolean Kotlin_native_internal_GC_getFreezeDeduplication(KRef gc) {
+  return g_freezeDeduplication;
+}
+
+void Kotlin_native_internal_GC_setFreezeDeduplication(KRef gc, KBoolean value) {
+  g_freezeDeduplication = value;
+}
+
 bool Kotlin_Any_isShareable(KRef thiz) {
     return thiz == nullptr || isShareable(containerFor(thiz));
 }
@@ -295,6 +295,19 @@ struct MetaObjHeader {
     // Strong reference to the counter object.
     ObjHeader* counter_;
   } WeakReference;
+
+  struct {
+    // Intrusive list of parties to notify when this object is deallocated,
+    // see AddObjectDeathHook().
+    struct ObjectDeathHook* head_;
+  } DeathHooks;
+};
+
+// A node of the per-object death notification list.
+struct ObjectDeathHook {
+  void (*hook_)(void*);
+  void* entry_;
+  ObjectDeathHook* next_;
 };
 
 extern "C" {
@@ -309,6 +322,21 @@ OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) RUNTIME_NOTHROW;
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* type_info, int32_t elements);
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* type_info, int32_t elements);
 
+OBJ_GETTER(AllocArrayInstanceUninitializedStrict, const TypeInfo* type_info, int32_t elements);
+OBJ_GETTER(AllocArrayInstanceUninitializedRelaxed, const TypeInfo* type_info, int32_t elements);
+
+OBJ_GETTER(AllocArrayInstanceAlignedStrict, const TypeInfo* type_info, int32_t elements, int32_t alignment);
+OBJ_GETTER(AllocArrayInstanceAlignedRelaxed, const TypeInfo* type_info, int32_t elements, int32_t alignment);
+
+OBJ_GETTER(AllocInstanceInFrameStrict, ObjHeader** auxSlot, const TypeInfo* type_info) RUNTIME_NOTHROW;
+OBJ_GETTER(AllocInstanceInFrameRelaxed, ObjHeader** auxSlot, const TypeInfo* type_info) RUNTIME_NOTHROW;
+
+OBJ_GETTER(AllocArrayInstanceInFrameStrict, ObjHeader** auxSlot, const TypeInfo* type_info, int32_t elements);
+OBJ_GETTER(AllocArrayInstanceInFrameRelaxed, ObjHeader** auxSlot, const TypeInfo* type_info, int32_t elements);
+
+OBJ_GETTER(PromoteObjectToHeapStrict, ObjHeader* object) RUNTIME_NOTHROW;
+OBJ_GETTER(PromoteObjectToHeapRelaxed, ObjHeader* object) RUNTIME_NOTHROW;
+
 OBJ_GETTER(InitInstanceStrict,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitInstanceRelaxed,
@@ -29,6 +29,20 @@ inline void* konanAllocMemory(size_t size) {
   return konan::calloc(1, size);
 }
 
+// Memory with undefined content; the caller overwrites every byte it will ever
+// read. Freed with the same konanFreeMemory() as zeroed allocations.
+inline void* konanAllocUninitializedMemory(size_t size) {
+  return konan::malloc(size);
+}
+
+// Zeroed memory whose address [payloadOffset] bytes in is [alignment]-aligned,
+// for cache-line or vector-boundary payloads behind a fixed-size header. Best
+// effort: only the mimalloc-backed allocator honours the alignment. Freed with
+// the same konanFreeMemory() as ordinary allocations.
+inline void* konanAllocAlignedMemory(size_t size, size_t alignment, size_t payloadOffset) {
+  return konan::calloc_aligned_at(1, size, alignment, payloadOffset);
+}
+
 inline void konanFreeMemory(void* memory) {
   konan::free(memory);
 }
@@ -14,13 +14,19 @@
  * limitations under the License.
  */
 
+#include <limits>
 #include <stdio.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "KAssert.h"
 #include "Exceptions.h"
 #include "Memory.h"
 #include "Natives.h"
+#include "Porting.h"
 #include "Types.h"
 
 extern "C" void checkRangeIndexes(KInt from, KInt to, KInt size);
@@ -43,17 +49,177 @@ ALWAYS_INLINE inline void boundsCheck(const ArrayHeader* array, KInt index) {
   }
 }
 
+// Multi-byte ByteArray accessors: one bounds check covering the whole value,
+// then a single unaligned load or store in the little-endian layout the API
+// promises. memcpy keeps the access legal on targets where unaligned accesses
+// fault and compiles to one plain load or store everywhere else; the swap pins
+// the byte order on big-endian targets, including for Float and Double, whose
+// bytes used to be stored in host order there.
+
+template <size_t size> struct UIntOfSize;
+template <> struct UIntOfSize<2> { typedef uint16_t type; };
+template <> struct UIntOfSize<4> { typedef uint32_t type; };
+template <> struct UIntOfSize<8> { typedef uint64_t type; };
+
+ALWAYS_INLINE inline uint16_t toLittleEndian(uint16_t bits) {
+#if __BIG_ENDIAN__
+  return __builtin_bswap16(bits);
+#else
+  return bits;
+#endif
+}
+
+ALWAYS_INLINE inline uint32_t toLittleEndian(uint32_t bits) {
+#if __BIG_ENDIAN__
+  return __builtin_bswap32(bits);
+#else
+  return bits;
+#endif
+}
+
+ALWAYS_INLINE inline uint64_t toLittleEndian(uint64_t bits) {
+#if __BIG_ENDIAN__
+  return __builtin_bswap64(bits);
+#else
+  return bits;
+#endif
+}
+
+template <typename T>
+ALWAYS_INLINE inline void multiByteBoundsCheck(const ArrayHeader* array, KInt index) {
+  if (index < 0 || static_cast<uint32_t>(index) + sizeof(T) > array->count_) {
+    ThrowArrayIndexOutOfBoundsException();
+  }
+}
+
+template <typename T>
+ALWAYS_INLINE inline T byteArrayGetAt(KConstRef thiz, KInt index) {
+  const ArrayHeader* array = thiz->array();
+  multiByteBoundsCheck<T>(array, index);
+  typename UIntOfSize<sizeof(T)>::type bits;
+  ::memcpy(&bits, ByteArrayAddressOfElementAt(array, index), sizeof(T));
+  bits = toLittleEndian(bits);
+  T result;
+  ::memcpy(&result, &bits, sizeof(T));
+  return result;
+}
+
+template <typename T>
+ALWAYS_INLINE inline void byteArraySetAt(KRef thiz, KInt index, T value) {
+  ArrayHeader* array = thiz->array();
+  multiByteBoundsCheck<T>(array, index);
+  mutabilityCheck(thiz);
+  typename UIntOfSize<sizeof(T)>::type bits;
+  ::memcpy(&bits, &value, sizeof(T));
+  bits = toLittleEndian(bits);
+  ::memcpy(ByteArrayAddressOfElementAt(array, index), &bits, sizeof(T));
+}
+
 template<typename T>
 inline void fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, T value) {
   ArrayHeader* array = thiz->array();
   checkRangeIndexes(fromIndex, toIndex, array->count_);
   mutabilityCheck(thiz);
   T* address = PrimitiveArrayAddressOfElementAt<T>(array, fromIndex);
-  for (KInt index = fromIndex; index < toIndex; ++index) {
-    *address++ = value;
+  size_t count = static_cast<size_t>(toIndex - fromIndex);
+  if (count == 0) return;
+  // memset covers single-byte types and any value whose bytes are all equal,
+  // notably zero - the dominant case for bulk clears.
+  auto* valueBytes = reinterpret_cast<const uint8_t*>(&value);
+  bool sameBytes = true;
+  for (size_t i = 1; i < sizeof(T); ++i) sameBytes &= (valueBytes[i] == valueBytes[0]);
+  if (sameBytes) {
+    memset(address, valueBytes[0], count * sizeof(T));
+    return;
+  }
+  // Seed one element, then double the filled run with memcpy: the libc copy
+  // moves whole cache lines where the scalar loop retired one element per
+  // iteration.
+  *address = value;
+  size_t filled = 1;
+  while (filled < count) {
+    size_t chunk = filled < count - filled ? filled : count - filled;
+    memcpy(address + filled, address, chunk * sizeof(T));
+    filled += chunk;
   }
 }
 
+// Structural equality of primitive arrays. Element equality in contentEquals is
+// bit equality for the integral and boolean types, so one memcmp over the
+// payload is exact for them. Floating point arrays use
+// floatingContentEqualsImpl below. Probe both ends first, as in
+// Kotlin_String_equals: equal-length unequal keys mostly differ there.
+template<typename T>
+inline KBoolean contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  const ArrayHeader* array = thiz->array();
+  const ArrayHeader* otherArray = other->array();
+  const uint32_t count = array->count_;
+  if (count != otherArray->count_) return false;
+  if (array == otherArray || count == 0) return true;
+  const T* a = PrimitiveArrayAddressOfElementAt<T>(array, 0);
+  const T* b = PrimitiveArrayAddressOfElementAt<T>(otherArray, 0);
+  if (memcmp(a, b, sizeof(T)) != 0 ||
+      memcmp(a + count - 1, b + count - 1, sizeof(T)) != 0) return false;
+  return memcmp(a, b, count * sizeof(T)) == 0;
+}
+
+ALWAYS_INLINE inline uint64_t canonicalizedBits(KFloat value) {
+  if (value != value) return 0x7FC00000u;  // Float.NaN.toRawBits()
+  uint32_t bits;
+  ::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+ALWAYS_INLINE inline uint64_t canonicalizedBits(KDouble value) {
+  if (value != value) return 0x7FF8000000000000ull;  // Double.NaN.toRawBits()
+  uint64_t bits;
+  ::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Float.equals/Double.equals compare canonicalized toBits(): every NaN is
+// equal to every other NaN regardless of payload, while +0.0 and -0.0 stay
+// distinct. Raw bytes match only a subset of that relation, so memcmp is a
+// fast accept here and a mismatch falls back to comparing canonicalized bits
+// element-wise.
+template<typename T>
+inline KBoolean floatingContentEqualsImpl(KConstRef thiz, KConstRef other) {
+  const ArrayHeader* array = thiz->array();
+  const ArrayHeader* otherArray = other->array();
+  const uint32_t count = array->count_;
+  if (count != otherArray->count_) return false;
+  if (array == otherArray || count == 0) return true;
+  const T* a = PrimitiveArrayAddressOfElementAt<T>(array, 0);
+  const T* b = PrimitiveArrayAddressOfElementAt<T>(otherArray, 0);
+  if (memcmp(a, b, count * sizeof(T)) == 0) return true;
+  for (uint32_t index = 0; index < count; ++index) {
+    if (canonicalizedBits(a[index]) != canonicalizedBits(b[index])) return false;
+  }
+  return true;
+}
+
+// Polynomial content hash, unrolled four elements per step so the multiply
+// chain no longer serializes the loop. Unsigned arithmetic: Kotlin Int wraps.
+template<typename T, typename Hasher>
+inline KInt contentHashCodeImpl(KConstRef thiz, Hasher elementHash) {
+  const ArrayHeader* array = thiz->array();
+  const uint32_t count = array->count_;
+  const T* data = PrimitiveArrayAddressOfElementAt<T>(array, 0);
+  uint32_t result = 1;
+  uint32_t index = 0;
+  for (; index + 4 <= count; index += 4) {
+    result = result * 923521u  // 31^4
+        + elementHash(data[index]) * 29791u      // 31^3
+        + elementHash(data[index + 1]) * 961u    // 31^2
+        + elementHash(data[index + 2]) * 31u
+        + elementHash(data[index + 3]);
+  }
+  for (; index < count; ++index) {
+    result = result * 31u + elementHash(data[index]);
+  }
+  return static_cast<KInt>(result);
+}
+
 template<typename T>
 inline void copyImpl(KConstRef thiz, KInt fromIndex,
                      KRef destination, KInt toIndex, KInt count) {
@@ -86,6 +252,329 @@ inline T PrimitiveArrayGet(KConstRef thiz, KInt index) {
   return *PrimitiveArrayAddressOfElementAt<T>(array, index);
 }
 
+// Sorting kernels for the Kotlin_*Array_sortImpl entry points: introsort
+// (median-of-three quicksort, insertion sort on short ranges, heap sort once
+// the recursion degenerates), plus a byte-wise LSD radix path for long int,
+// long and floating point ranges. All of them work in place on the array
+// payload; the radix path additionally needs an O(n) scratch buffer and falls
+// back to introsort when that cannot be allocated.
+
+// Ranges at most this long are insertion sorted.
+constexpr KInt kSortInsertionCutoff = 24;
+// 32- and 64-bit ranges at least this long take the O(n) radix path.
+constexpr KInt kSortRadixCutoff = 1 << 12;
+
+template <typename T> ALWAYS_INLINE inline void sortSwap(T* a, T* b) {
+  T tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+template <typename T> void insertionSortKernel(T* begin, T* end) {
+  for (T* cursor = begin + 1; cursor < end; ++cursor) {
+    T value = *cursor;
+    T* slot = cursor;
+    while (slot > begin && value < *(slot - 1)) {
+      *slot = *(slot - 1);
+      --slot;
+    }
+    *slot = value;
+  }
+}
+
+template <typename T> void siftDown(T* heap, KInt root, KInt count) {
+  while (true) {
+    KInt child = 2 * root + 1;
+    if (child >= count) return;
+    if (child + 1 < count && heap[child] < heap[child + 1]) child++;
+    if (!(heap[root] < heap[child])) return;
+    sortSwap(heap + root, heap + child);
+    root = child;
+  }
+}
+
+template <typename T> void heapSortKernel(T* begin, KInt count) {
+  for (KInt root = count / 2 - 1; root >= 0; --root) siftDown(begin, root, count);
+  for (KInt last = count - 1; last > 0; --last) {
+    sortSwap(begin, begin + last);
+    siftDown(begin, 0, last);
+  }
+}
+
+template <typename T> void introSortKernel(T* begin, T* end, int depthLimit) {
+  while (end - begin > kSortInsertionCutoff) {
+    // A run of unlucky pivots means adversarial input; heap sort keeps the
+    // worst case at O(n log n).
+    if (depthLimit-- == 0) {
+      heapSortKernel(begin, static_cast<KInt>(end - begin));
+      return;
+    }
+    T* mid = begin + (end - begin) / 2;
+    // Median of three; as a side effect both ends become sentinels for the
+    // unguarded scans below.
+    if (*mid < *begin) sortSwap(mid, begin);
+    if (*(end - 1) < *begin) sortSwap(end - 1, begin);
+    if (*(end - 1) < *mid) sortSwap(end - 1, mid);
+    T pivot = *mid;
+    // Hoare partition: the scan loops carry no index bounds checks thanks to
+    // the sentinels, so each step is one comparison and one increment.
+    T* i = begin;
+    T* j = end - 1;
+    while (true) {
+      do { ++i; } while (*i < pivot);
+      do { --j; } while (pivot < *j);
+      if (i >= j) break;
+      sortSwap(i, j);
+    }
+    T* split = j + 1;
+    // Recurse into the smaller side and loop on the larger one, bounding the
+    // stack at O(log n).
+    if (split - begin < end - split) {
+      introSortKernel(begin, split, depthLimit);
+      begin = split;
+    } else {
+      introSortKernel(split, end, depthLimit);
+      end = split;
+    }
+  }
+  insertionSortKernel(begin, end);
+}
+
+template <typename T> void sortKernel(T* begin, KInt count) {
+  if (count < 2) return;
+  int depthLimit = 2;
+  for (KInt n = count; n > 1; n >>= 1) depthLimit += 2;
+  introSortKernel(begin, begin + count, depthLimit);
+}
+
+// Byte-wise LSD radix passes over unsigned keys. A pass whose byte is constant
+// across the whole range is skipped, so small-range data pays only the counting
+// scans.
+template <typename U> void radixPasses(U* array, U* buffer, KInt count) {
+  U* from = array;
+  U* to = buffer;
+  for (size_t shift = 0; shift < sizeof(U) * 8; shift += 8) {
+    KInt counts[256] = {};
+    for (KInt i = 0; i < count; i++) counts[(from[i] >> shift) & 0xFF]++;
+    if (counts[(from[0] >> shift) & 0xFF] == count) continue;
+    KInt positions[256];
+    KInt sum = 0;
+    for (int bucket = 0; bucket < 256; bucket++) {
+      positions[bucket] = sum;
+      sum += counts[bucket];
+    }
+    for (KInt i = 0; i < count; i++) to[positions[(from[i] >> shift) & 0xFF]++] = from[i];
+    sortSwap(&from, &to);
+  }
+  if (from != array) memcpy(array, from, count * sizeof(U));
+}
+
+template <typename U> bool radixSortUnsigned(U* array, KInt count) {
+  U* buffer = reinterpret_cast<U*>(konan::calloc(count, sizeof(U)));
+  if (buffer == nullptr) return false;
+  radixPasses(array, buffer, count);
+  konan::free(buffer);
+  return true;
+}
+
+// Flipping the sign bit makes the unsigned byte-wise order match the signed one.
+template <typename U> bool radixSortSigned(U* array, KInt count) {
+  constexpr U signBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+  for (KInt i = 0; i < count; i++) array[i] ^= signBit;
+  bool sorted = radixSortUnsigned(array, count);
+  for (KInt i = 0; i < count; i++) array[i] ^= signBit;
+  return sorted;
+}
+
+// Maps floating point bit patterns to unsigned keys whose natural order is the
+// order of the values, including -0.0 before 0.0: negative values reverse, the
+// rest get the sign bit set. NaNs must be excluded first - their bit patterns
+// would not compare as equal.
+inline uint32_t floatSortKey(uint32_t bits) {
+  return (bits & 0x80000000u) != 0 ? ~bits : bits ^ 0x80000000u;
+}
+
+inline uint32_t floatSortKeyInverse(uint32_t key) {
+  return (key & 0x80000000u) != 0 ? key ^ 0x80000000u : ~key;
+}
+
+inline uint64_t doubleSortKey(uint64_t bits) {
+  return (bits & (1ull << 63)) != 0 ? ~bits : bits ^ (1ull << 63);
+}
+
+inline uint64_t doubleSortKeyInverse(uint64_t key) {
+  return (key & (1ull << 63)) != 0 ? key ^ (1ull << 63) : ~key;
+}
+
+// Moves NaNs - which sort greater than everything else and equal to each other -
+// behind the range; returns the count of remaining elements.
+template <typename T> KInt partitionNansBack(T* begin, KInt count) {
+  KInt last = count;
+  KInt i = 0;
+  while (i < last) {
+    if (begin[i] != begin[i]) {
+      --last;
+      sortSwap(begin + i, begin + last);
+    } else {
+      ++i;
+    }
+  }
+  return last;
+}
+
+template <typename T>
+inline T* sortableRange(KRef thiz, KInt fromIndex, KInt toIndex, KInt* count) {
+  ArrayHeader* array = thiz->array();
+  checkRangeIndexes(fromIndex, toIndex, array->count_);
+  mutabilityCheck(thiz);
+  *count = toIndex - fromIndex;
+  return PrimitiveArrayAddressOfElementAt<T>(array, fromIndex);
+}
+
+// Reduction kernels for the Kotlin_*Array_sum/min/max entry points: the bounds
+// are established once from the array header and the loops then run over the
+// raw payload. Integer reductions are associative, so plain loops vectorize by
+// themselves; the floating point ones get an explicit SSE2 path, since the
+// compiler must not reassociate FP additions on its own.
+
+// Unsigned accumulation gives the same wrapped bits as Kotlin's Int/Long sum
+// without signed overflow.
+template <typename T, typename U> T sumIntegerKernel(const T* data, uint32_t count) {
+  U acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    acc0 += static_cast<U>(data[i]);
+    acc1 += static_cast<U>(data[i + 1]);
+    acc2 += static_cast<U>(data[i + 2]);
+    acc3 += static_cast<U>(data[i + 3]);
+  }
+  U result = acc0 + acc1 + acc2 + acc3;
+  for (; i < count; i++) result += static_cast<U>(data[i]);
+  return static_cast<T>(result);
+}
+
+template <typename T> T minIntegerKernel(const T* data, uint32_t count) {
+  T result = data[0];
+  for (uint32_t i = 1; i < count; i++) {
+    if (data[i] < result) result = data[i];
+  }
+  return result;
+}
+
+template <typename T> T maxIntegerKernel(const T* data, uint32_t count) {
+  T result = data[0];
+  for (uint32_t i = 1; i < count; i++) {
+    if (data[i] > result) result = data[i];
+  }
+  return result;
+}
+
+KDouble sumDoubleKernel(const KDouble* data, uint32_t count) {
+  uint32_t i = 0;
+  KDouble result = 0.0;
+#if defined(__SSE2__)
+  __m128d acc0 = _mm_setzero_pd();
+  __m128d acc1 = _mm_setzero_pd();
+  for (; i + 4 <= count; i += 4) {
+    acc0 = _mm_add_pd(acc0, _mm_loadu_pd(data + i));
+    acc1 = _mm_add_pd(acc1, _mm_loadu_pd(data + i + 2));
+  }
+  acc0 = _mm_add_pd(acc0, acc1);
+  double lanes[2];
+  _mm_storeu_pd(lanes, acc0);
+  result = lanes[0] + lanes[1];
+#endif
+  for (; i < count; i++) result += data[i];
+  return result;
+}
+
+KFloat sumFloatKernel(const KFloat* data, uint32_t count) {
+  uint32_t i = 0;
+  KFloat result = 0.0f;
+#if defined(__SSE2__)
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm_add_ps(acc0, _mm_loadu_ps(data + i));
+    acc1 = _mm_add_ps(acc1, _mm_loadu_ps(data + i + 4));
+  }
+  acc0 = _mm_add_ps(acc0, acc1);
+  float lanes[4];
+  _mm_storeu_ps(lanes, acc0);
+  result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+  for (; i < count; i++) result += data[i];
+  return result;
+}
+
+// Float min/max follow the stdlib contract: NaN anywhere makes the result NaN.
+// The vector min/max instructions drop NaNs, so unordered lanes are collected
+// separately along the way.
+
+KDouble minMaxDoubleKernel(const KDouble* data, uint32_t count, bool isMin) {
+  uint32_t i = 0;
+  bool sawNan = false;
+  KDouble result = data[0];
+#if defined(__SSE2__)
+  if (count >= 2) {
+    __m128d acc = _mm_loadu_pd(data);
+    __m128d nans = _mm_cmpunord_pd(acc, acc);
+    for (i = 2; i + 2 <= count; i += 2) {
+      __m128d chunk = _mm_loadu_pd(data + i);
+      nans = _mm_or_pd(nans, _mm_cmpunord_pd(chunk, chunk));
+      acc = isMin ? _mm_min_pd(acc, chunk) : _mm_max_pd(acc, chunk);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    result = isMin == (lanes[0] < lanes[1]) ? lanes[0] : lanes[1];
+    sawNan = _mm_movemask_pd(nans) != 0;
+  }
+#endif
+  for (; i < count; i++) {
+    KDouble value = data[i];
+    sawNan |= value != value;
+    if (isMin ? value < result : value > result) result = value;
+  }
+  return sawNan ? std::numeric_limits<KDouble>::quiet_NaN() : result;
+}
+
+KFloat minMaxFloatKernel(const KFloat* data, uint32_t count, bool isMin) {
+  uint32_t i = 0;
+  bool sawNan = false;
+  KFloat result = data[0];
+#if defined(__SSE2__)
+  if (count >= 4) {
+    __m128 acc = _mm_loadu_ps(data);
+    __m128 nans = _mm_cmpunord_ps(acc, acc);
+    for (i = 4; i + 4 <= count; i += 4) {
+      __m128 chunk = _mm_loadu_ps(data + i);
+      nans = _mm_or_ps(nans, _mm_cmpunord_ps(chunk, chunk));
+      acc = isMin ? _mm_min_ps(acc, chunk) : _mm_max_ps(acc, chunk);
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    result = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+      if (isMin ? lanes[lane] < result : lanes[lane] > result) result = lanes[lane];
+    }
+    sawNan = _mm_movemask_ps(nans) != 0;
+  }
+#endif
+  for (; i < count; i++) {
+    KFloat value = data[i];
+    sawNan |= value != value;
+    if (isMin ? value < result : value > result) result = value;
+  }
+  return sawNan ? std::numeric_limits<KFloat>::quiet_NaN() : result;
+}
+
+template <typename T>
+inline const T* reductionRange(KConstRef thiz, uint32_t* count) {
+  const ArrayHeader* array = thiz->array();
+  *count = array->count_;
+  return PrimitiveArrayAddressOfElementAt<T>(array, 0);
+}
+
 }  // namespace
 
 extern "C" {
@@ -123,6 +612,17 @@ void Kotlin_Array_fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, KRef value)
   }
 }
 
+// Tries to grow the array in place using allocator slack behind its storage, so
+// that append-heavy callers (see ArrayList.ensureCapacity) skip the allocation
+// and the copy. The caller must be the only owner of the array; the memory
+// manager re-checks what it can and falls back to refusing the growth.
+KBoolean Kotlin_Array_tryGrowInPlace(KRef thiz, KInt newSize) {
+  ArrayHeader* array = thiz->array();
+  RuntimeAssert(array->type_info()->instanceSize_ < 0, "Must be an array");
+  mutabilityCheck(thiz);
+  return TryGrowArrayInPlace(array, newSize);
+}
+
 void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
                            KRef destination, KInt toIndex, KInt count) {
   const ArrayHeader* array = thiz->array();
@@ -133,6 +633,31 @@ void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
     ThrowArrayIndexOutOfBoundsException();
   }
   mutabilityCheck(destination);
+  // A destination range without references yet (freshly allocated arrays are zeroed,
+  // and copyOf-style resizes copy into them) has no old values to release, so slots
+  // can be initialized with the cheaper SetHeapRef instead of the full UpdateHeapRef
+  // protocol. The scan is plain reads and costs far less than the saved bookkeeping.
+  bool destinationIsFresh = true;
+  for (int index = 0; index < count; index++) {
+    if (*ArrayAddressOfElementAt(destinationArray, toIndex + index) != nullptr) {
+      destinationIsFresh = false;
+      break;
+    }
+  }
+  if (destinationIsFresh) {
+    if (fromIndex >= toIndex) {
+      for (int index = 0; index < count; index++) {
+        SetHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
+                     *ArrayAddressOfElementAt(array, fromIndex + index));
+      }
+    } else {
+      for (int index = count - 1; index >= 0; index--) {
+        SetHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
+                     *ArrayAddressOfElementAt(array, fromIndex + index));
+      }
+    }
+    return;
+  }
   if (fromIndex >= toIndex) {
     for (int index = 0; index < count; index++) {
       UpdateHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
@@ -148,7 +673,7 @@ void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
 
 // Arrays.kt
 OBJ_GETTER0(Kotlin_emptyArray) {
-  RETURN_OBJ(const_cast<ObjHeader*>(&theEmptyArray));
+  RETURN_OBJ_ROOTED(const_cast<ObjHeader*>(&theEmptyArray));
 }
 
 KByte Kotlin_ByteArray_get(KConstRef thiz, KInt index) {
@@ -170,272 +695,51 @@ KInt Kotlin_ByteArray_getArrayLength(KConstRef thiz) {
 }
 
 KChar Kotlin_ByteArray_getCharAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 1 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  return (static_cast<KChar>(address[0]) << 0) | (static_cast<KChar>(address[1]) << 8);
-#else
-  auto result = *reinterpret_cast<const KChar*>(ByteArrayAddressOfElementAt(array, index));
-#if __BIG_ENDIAN__
-  return __builtin_bswap16(result);
-#else
-  return result;
-#endif  // __BIG_ENDIAN__
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KChar>(thiz, index);
 }
 
 KShort Kotlin_ByteArray_getShortAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 1 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  return (static_cast<KShort>(address[0]) << 0) | (static_cast<KShort>(address[1]) << 8);
-#else
-  auto result = *reinterpret_cast<const KShort*>(ByteArrayAddressOfElementAt(array, index));
-#if __BIG_ENDIAN__
-  return __builtin_bswap16(result);
-#else
-  return result;
-#endif  // __BIG_ENDIAN__
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KShort>(thiz, index);
 }
 
 KInt Kotlin_ByteArray_getIntAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 3 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  return (static_cast<KInt>(address[0]) << 0) | (static_cast<KInt>(address[1]) << 8) |
-    (static_cast<KInt>(address[2]) << 16) | (static_cast<KInt>(address[3]) << 24);
-#else
-  auto result = *reinterpret_cast<const KInt*>(ByteArrayAddressOfElementAt(array, index));
-#if __BIG_ENDIAN__
-  return __builtin_bswap32(result);
-#else
-  return result;
-#endif  //  __BIG_ENDIAN__
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KInt>(thiz, index);
 }
 
 KLong Kotlin_ByteArray_getLongAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 7 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  return (static_cast<KLong>(address[0]) << 0) | (static_cast<KLong>(address[1]) << 8) |
-    (static_cast<KLong>(address[2]) << 16) | (static_cast<KLong>(address[3]) << 24) |
-    (static_cast<KLong>(address[4]) << 32) | (static_cast<KLong>(address[5]) << 40) |
-    (static_cast<KLong>(address[6]) << 48) | (static_cast<KLong>(address[7]) << 56);
-#else
-  auto result = *reinterpret_cast<const KLong*>(ByteArrayAddressOfElementAt(array, index));
-#if __BIG_ENDIAN__
-  return __builtin_bswap64(result);
-#else
-  return result;
-#endif  // __BIG_ENDIAN__
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KLong>(thiz, index);
 }
 
 KFloat Kotlin_ByteArray_getFloatAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 3 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  union {
-    KFloat f;
-    uint8_t b[4];
-  } u;
-#if __BIG_ENDIAN__
-  u.b[0] = address[3];
-  u.b[1] = address[2];
-  u.b[2] = address[1];
-  u.b[3] = address[0];
-#else
-  u.b[0] = address[0];
-  u.b[1] = address[1];
-  u.b[2] = address[2];
-  u.b[3] = address[3];
-#endif  //  __BIG_ENDIAN__
-  return u.f;
-#else
-  auto result = *reinterpret_cast<const KFloat*>(ByteArrayAddressOfElementAt(array, index));
-  return result;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KFloat>(thiz, index);
 }
 
 KDouble Kotlin_ByteArray_getDoubleAt(KConstRef thiz, KInt index) {
-  const ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 7 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-#if KONAN_NO_UNALIGNED_ACCESS
-  const uint8_t* address = reinterpret_cast<const uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  union {
-      KDouble d;
-      uint8_t b[8];
-  } u;
-#if __BIG_ENDIAN__
-  u.b[0] = address[7];
-  u.b[1] = address[6];
-  u.b[2] = address[5];
-  u.b[3] = address[4];
-  u.b[4] = address[3];
-  u.b[5] = address[2];
-  u.b[6] = address[1];
-  u.b[7] = address[0];
-#else
-  u.b[0] = address[0];
-  u.b[1] = address[1];
-  u.b[2] = address[2];
-  u.b[3] = address[3];
-  u.b[4] = address[4];
-  u.b[5] = address[5];
-  u.b[6] = address[6];
-  u.b[7] = address[7];
-#endif  // __BIG_ENDIAN__
-  return u.d;
-#else
-  return *reinterpret_cast<const KDouble*>(ByteArrayAddressOfElementAt(array, index));
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  return byteArrayGetAt<KDouble>(thiz, index);
 }
 
 void Kotlin_ByteArray_setCharAt(KRef thiz, KInt index, KChar value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 1 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  address[0] = (value >> 0) & 0xff;
-  address[1] = (value >> 8) & 0xff;
-#else
-#if __BIG_ENDIAN__
-   value = __builtin_bswap16(value);
-#endif  // __BIG_ENDIAN__
-  *reinterpret_cast<KChar*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 void Kotlin_ByteArray_setShortAt(KRef thiz, KInt index, KShort value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 1 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  address[0] = (value >> 0) & 0xff;
-  address[1] = (value >> 8) & 0xff;
-#else
-#if __BIG_ENDIAN__
-  value = __builtin_bswap16(value);
-#endif
-  *reinterpret_cast<KShort*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 void Kotlin_ByteArray_setIntAt(KRef thiz, KInt index, KInt value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 3 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  address[0] = (value >>  0) & 0xff;
-  address[1] = (value >>  8) & 0xff;
-  address[2] = (value >> 16) & 0xff;
-  address[3] = (value >> 24) & 0xff;
-#else
-#if __BIG_ENDIAN__
-  value = __builtin_bswap32(value);
-#endif  // __BIG_ENDIAN__
-  *reinterpret_cast<KInt*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 void Kotlin_ByteArray_setLongAt(KRef thiz, KInt index, KLong value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 7 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  address[0] = (value >>  0) & 0xff;
-  address[1] = (value >>  8) & 0xff;
-  address[2] = (value >> 16) & 0xff;
-  address[3] = (value >> 24) & 0xff;
-  address[4] = (value >> 32) & 0xff;
-  address[5] = (value >> 40) & 0xff;
-  address[6] = (value >> 48) & 0xff;
-  address[7] = (value >> 56) & 0xff;
-#else
-#if __BIG_ENDIAN__
-  value = __builtin_bswap64(value);
-#endif // __BIG_ENDIAN__
-  *reinterpret_cast<KLong*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 void Kotlin_ByteArray_setFloatAt(KRef thiz, KInt index, KFloat value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 3 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  union {
-     KFloat f;
-     uint8_t b[4];
-  } u;
-  u.f = value;
-  address[0] = u.b[0];
-  address[1] = u.b[1];
-  address[2] = u.b[2];
-  address[3] = u.b[3];
-#else
-  *reinterpret_cast<KFloat*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 void Kotlin_ByteArray_setDoubleAt(KRef thiz, KInt index, KDouble value) {
-  ArrayHeader* array = thiz->array();
-  if (index < 0 || static_cast<uint32_t>(index) + 7 >= array->count_) {
-    ThrowArrayIndexOutOfBoundsException();
-  }
-  mutabilityCheck(thiz);
-#if KONAN_NO_UNALIGNED_ACCESS
-  uint8_t* address = reinterpret_cast<uint8_t*>(ByteArrayAddressOfElementAt(array, index));
-  union {
-     KDouble d;
-     uint8_t b[8];
-  } u;
-  u.d = value;
-  address[0] = u.b[0];
-  address[1] = u.b[1];
-  address[2] = u.b[2];
-  address[3] = u.b[3];
-  address[4] = u.b[4];
-  address[5] = u.b[5];
-  address[6] = u.b[6];
-  address[7] = u.b[7];
-#else
-  *reinterpret_cast<KDouble*>(ByteArrayAddressOfElementAt(array, index)) = value;
-#endif  // KONAN_NO_UNALIGNED_ACCESS
+  byteArraySetAt(thiz, index, value);
 }
 
 KChar Kotlin_CharArray_get(KConstRef thiz, KInt index) {
@@ -523,6 +827,229 @@ void Kotlin_BooleanArray_fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, KBool
   fillImpl<KBoolean>(thiz, fromIndex, toIndex, value);
 }
 
+void Kotlin_ByteArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KByte* range = sortableRange<KByte>(thiz, fromIndex, toIndex, &count);
+  sortKernel(range, count);
+}
+
+void Kotlin_ShortArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KShort* range = sortableRange<KShort>(thiz, fromIndex, toIndex, &count);
+  sortKernel(range, count);
+}
+
+void Kotlin_CharArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KChar* range = sortableRange<KChar>(thiz, fromIndex, toIndex, &count);
+  sortKernel(range, count);
+}
+
+void Kotlin_IntArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KInt* range = sortableRange<KInt>(thiz, fromIndex, toIndex, &count);
+  if (count >= kSortRadixCutoff
+      && radixSortSigned(reinterpret_cast<uint32_t*>(range), count)) {
+    return;
+  }
+  sortKernel(range, count);
+}
+
+void Kotlin_LongArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KLong* range = sortableRange<KLong>(thiz, fromIndex, toIndex, &count);
+  if (count >= kSortRadixCutoff
+      && radixSortSigned(reinterpret_cast<uint64_t*>(range), count)) {
+    return;
+  }
+  sortKernel(range, count);
+}
+
+void Kotlin_FloatArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KFloat* range = sortableRange<KFloat>(thiz, fromIndex, toIndex, &count);
+  KInt sortable = partitionNansBack(range, count);
+  auto* keys = reinterpret_cast<uint32_t*>(range);
+  for (KInt i = 0; i < sortable; i++) keys[i] = floatSortKey(keys[i]);
+  if (sortable < kSortRadixCutoff || !radixSortUnsigned(keys, sortable)) {
+    sortKernel(keys, sortable);
+  }
+  for (KInt i = 0; i < sortable; i++) keys[i] = floatSortKeyInverse(keys[i]);
+}
+
+void Kotlin_DoubleArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KDouble* range = sortableRange<KDouble>(thiz, fromIndex, toIndex, &count);
+  KInt sortable = partitionNansBack(range, count);
+  auto* keys = reinterpret_cast<uint64_t*>(range);
+  for (KInt i = 0; i < sortable; i++) keys[i] = doubleSortKey(keys[i]);
+  if (sortable < kSortRadixCutoff || !radixSortUnsigned(keys, sortable)) {
+    sortKernel(keys, sortable);
+  }
+  for (KInt i = 0; i < sortable; i++) keys[i] = doubleSortKeyInverse(keys[i]);
+}
+
+void Kotlin_BooleanArray_sortImpl(KRef thiz, KInt fromIndex, KInt toIndex) {
+  KInt count;
+  KBoolean* range = sortableRange<KBoolean>(thiz, fromIndex, toIndex, &count);
+  sortKernel(range, count);
+}
+
+KInt Kotlin_IntArray_sum(KConstRef thiz) {
+  uint32_t count;
+  const KInt* data = reductionRange<KInt>(thiz, &count);
+  return sumIntegerKernel<KInt, uint32_t>(data, count);
+}
+
+KLong Kotlin_LongArray_sum(KConstRef thiz) {
+  uint32_t count;
+  const KLong* data = reductionRange<KLong>(thiz, &count);
+  return sumIntegerKernel<KLong, uint64_t>(data, count);
+}
+
+KFloat Kotlin_FloatArray_sum(KConstRef thiz) {
+  uint32_t count;
+  const KFloat* data = reductionRange<KFloat>(thiz, &count);
+  return sumFloatKernel(data, count);
+}
+
+KDouble Kotlin_DoubleArray_sum(KConstRef thiz) {
+  uint32_t count;
+  const KDouble* data = reductionRange<KDouble>(thiz, &count);
+  return sumDoubleKernel(data, count);
+}
+
+// The min/max entry points expect a non-empty array; the Kotlin wrappers check.
+
+KInt Kotlin_IntArray_min(KConstRef thiz) {
+  uint32_t count;
+  const KInt* data = reductionRange<KInt>(thiz, &count);
+  return minIntegerKernel(data, count);
+}
+
+KInt Kotlin_IntArray_max(KConstRef thiz) {
+  uint32_t count;
+  const KInt* data = reductionRange<KInt>(thiz, &count);
+  return maxIntegerKernel(data, count);
+}
+
+KLong Kotlin_LongArray_min(KConstRef thiz) {
+  uint32_t count;
+  const KLong* data = reductionRange<KLong>(thiz, &count);
+  return minIntegerKernel(data, count);
+}
+
+KLong Kotlin_LongArray_max(KConstRef thiz) {
+  uint32_t count;
+  const KLong* data = reductionRange<KLong>(thiz, &count);
+  return maxIntegerKernel(data, count);
+}
+
+KFloat Kotlin_FloatArray_min(KConstRef thiz) {
+  uint32_t count;
+  const KFloat* data = reductionRange<KFloat>(thiz, &count);
+  return minMaxFloatKernel(data, count, true);
+}
+
+KFloat Kotlin_FloatArray_max(KConstRef thiz) {
+  uint32_t count;
+  const KFloat* data = reductionRange<KFloat>(thiz, &count);
+  return minMaxFloatKernel(data, count, false);
+}
+
+KDouble Kotlin_DoubleArray_min(KConstRef thiz) {
+  uint32_t count;
+  const KDouble* data = reductionRange<KDouble>(thiz, &count);
+  return minMaxDoubleKernel(data, count, true);
+}
+
+KDouble Kotlin_DoubleArray_max(KConstRef thiz) {
+  uint32_t count;
+  const KDouble* data = reductionRange<KDouble>(thiz, &count);
+  return minMaxDoubleKernel(data, count, false);
+}
+
+KBoolean Kotlin_ByteArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KByte>(thiz, other);
+}
+
+KBoolean Kotlin_ShortArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KShort>(thiz, other);
+}
+
+KBoolean Kotlin_CharArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KChar>(thiz, other);
+}
+
+KBoolean Kotlin_IntArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KInt>(thiz, other);
+}
+
+KBoolean Kotlin_LongArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KLong>(thiz, other);
+}
+
+KBoolean Kotlin_FloatArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return floatingContentEqualsImpl<KFloat>(thiz, other);
+}
+
+KBoolean Kotlin_DoubleArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return floatingContentEqualsImpl<KDouble>(thiz, other);
+}
+
+KBoolean Kotlin_BooleanArray_contentEqualsImpl(KConstRef thiz, KConstRef other) {
+  return contentEqualsImpl<KBoolean>(thiz, other);
+}
+
+// Element hashes below match the hashCode() of the corresponding Kotlin type.
+
+KInt Kotlin_ByteArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KByte>(thiz,
+      [](KByte value) { return static_cast<uint32_t>(static_cast<KInt>(value)); });
+}
+
+KInt Kotlin_ShortArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KShort>(thiz,
+      [](KShort value) { return static_cast<uint32_t>(static_cast<KInt>(value)); });
+}
+
+KInt Kotlin_CharArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KChar>(thiz,
+      [](KChar value) { return static_cast<uint32_t>(value); });
+}
+
+KInt Kotlin_IntArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KInt>(thiz,
+      [](KInt value) { return static_cast<uint32_t>(value); });
+}
+
+KInt Kotlin_LongArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KLong>(thiz, [](KLong value) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(value) >> 32) ^ static_cast<uint64_t>(value));
+  });
+}
+
+KInt Kotlin_FloatArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KFloat>(thiz, [](KFloat value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  });
+}
+
+KInt Kotlin_DoubleArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KDouble>(thiz, [](KDouble value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return static_cast<uint32_t>((bits >> 32) ^ bits);
+  });
+}
+
+KInt Kotlin_BooleanArray_contentHashCodeImpl(KConstRef thiz) {
+  return contentHashCodeImpl<KBoolean>(thiz,
+      [](KBoolean value) { return value ? 1u : 0u; });
+}
+
 void Kotlin_ByteArray_copyImpl(KConstRef thiz, KInt fromIndex,
                               KRef destination, KInt toIndex, KInt count) {
   copyImpl<KByte>(thiz, fromIndex, destination, toIndex, count);
@@ -659,6 +1186,22 @@ KNativePtr Kotlin_Arrays_getByteArrayAddressOfElement(KRef thiz, KInt index) {
   return AddressOfElementAt<KByte>(array, index);
 }
 
+// Zero-copy I/O pinning: one call takes a reference-count hold on the array
+// and returns the element address, so read(2)/write(2) can target the array's
+// storage directly and per-call pinning costs a pair of RC operations only.
+KNativePtr Kotlin_ByteArray_pin(KRef thiz, KInt index) {
+  ArrayHeader* array = thiz->array();
+  boundsCheck(array, index);
+  // The caller holds the array for the duration of the pin, so it is alive
+  // here and taking another reference cannot fail.
+  TryAddHeapRef(thiz);
+  return AddressOfElementAt<KByte>(array, index);
+}
+
+void Kotlin_ByteArray_unpin(KRef thiz) {
+  ReleaseHeapRef(thiz);
+}
+
 KNativePtr Kotlin_Arrays_getCharArrayAddressOfElement (KRef thiz, KInt index) {
   ArrayHeader* array = thiz->array();
   boundsCheck(array, index);
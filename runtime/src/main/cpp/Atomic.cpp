@@ -18,6 +18,8 @@
 #include "Common.h"
 #include "Exceptions.h"
 #include "Memory.h"
+#include "Natives.h"
+#include "Porting.h"
 #include "Types.h"
 
 namespace {
@@ -68,6 +70,35 @@ inline AtomicReferenceLayout* asAtomicReference(KRef thiz) {
     return reinterpret_cast<AtomicReferenceLayout*>(thiz);
 }
 
+// Cells of the striped counter (see StripedLongCounter in Atomics.kt). Each cell gets
+// its own cache line, so threads incrementing through different cells do not share a
+// hot line; a read sums all cells.
+constexpr size_t kStripedCounterCellCount = 16;
+
+struct alignas(64) StripedCounterCell {
+    volatile KLong value_;
+};
+
+THREAD_LOCAL_VARIABLE int stripedCounterThreadAnchor = 0;
+
+inline StripedCounterCell* stripedCounterCellForThisThread(KNativePtr cells) {
+    // Hash the address of a thread-local to pick this thread's cell, the same way
+    // the interop holder cache picks its shard.
+    auto value = reinterpret_cast<uintptr_t>(&stripedCounterThreadAnchor);
+    return reinterpret_cast<StripedCounterCell*>(cells) + ((value >> 6) % kStripedCounterCellCount);
+}
+
+// Element location for the array element atomics below; same bounds discipline
+// as the accessors in Arrays.cpp, but no mutability check: mutating shared
+// frozen storage atomically is the whole point of these operations.
+template <typename T> inline volatile T* atomicElementLocation(KRef thiz, KInt index) {
+    ArrayHeader* array = thiz->array();
+    if (static_cast<uint32_t>(index) >= array->count_) {
+        ThrowArrayIndexOutOfBoundsException();
+    }
+    return reinterpret_cast<volatile T*>(PrimitiveArrayAddressOfElementAt<T>(array, index));
+}
+
 }  // namespace
 
 extern "C" {
@@ -159,6 +190,52 @@ KLong Kotlin_AtomicLong_get(KRef thiz) {
 #endif
 }
 
+KNativePtr Kotlin_StripedLongCounter_createCells() {
+    return konan::calloc_aligned(kStripedCounterCellCount, sizeof(StripedCounterCell),
+        alignof(StripedCounterCell));
+}
+
+void Kotlin_StripedLongCounter_disposeCells(KNativePtr cells) {
+    konan::free(cells);
+}
+
+void Kotlin_StripedLongCounter_add(KNativePtr cells, KLong delta) {
+#if KONAN_NO_64BIT_ATOMIC
+    // Potentially huge performance penalty, but correct.
+    while (compareAndSwap(&lock64, 0, 1) != 0);
+    stripedCounterCellForThisThread(cells)->value_ += delta;
+    compareAndSwap(&lock64, 1, 0);
+#else
+    atomicAdd(&stripedCounterCellForThisThread(cells)->value_, delta);
+#endif
+}
+
+KLong Kotlin_StripedLongCounter_sum(KNativePtr cells) {
+    auto* cell = reinterpret_cast<StripedCounterCell*>(cells);
+    KLong result = 0;
+#if KONAN_NO_64BIT_ATOMIC
+    // Potentially huge performance penalty, but correct.
+    while (compareAndSwap(&lock64, 0, 1) != 0);
+    for (size_t i = 0; i < kStripedCounterCellCount; i++) result += cell[i].value_;
+    compareAndSwap(&lock64, 1, 0);
+#else
+    for (size_t i = 0; i < kStripedCounterCellCount; i++) result += atomicGet(&cell[i].value_);
+#endif
+    return result;
+}
+
+KInt Kotlin_IntArray_atomicGet(KRef thiz, KInt index) {
+    return atomicGet(atomicElementLocation<KInt>(thiz, index));
+}
+
+KInt Kotlin_IntArray_atomicAdd(KRef thiz, KInt index, KInt delta) {
+    return atomicAdd(atomicElementLocation<KInt>(thiz, index), delta);
+}
+
+KBoolean Kotlin_IntArray_atomicCompareAndSet(KRef thiz, KInt index, KInt expectedValue, KInt newValue) {
+    return compareAndSet(atomicElementLocation<KInt>(thiz, index), expectedValue, newValue);
+}
+
 KNativePtr Kotlin_AtomicNativePtr_compareAndSwap(KRef thiz, KNativePtr expectedValue, KNativePtr newValue) {
     return compareAndSwapImpl(thiz, expectedValue, newValue);
 }
@@ -193,6 +270,14 @@ KBoolean Kotlin_AtomicReference_compareAndSet(KRef thiz, KRef expectedValue, KRe
     Kotlin_AtomicReference_checkIfFrozen(newValue);
     // See Kotlin_AtomicReference_get() for explanations, why locking is needed.
     AtomicReferenceLayout* ref = asAtomicReference(thiz);
+    // Lock-free failure fast path: a CAS retry loop under contention mostly observes
+    // a value someone else already installed. Such an attempt is going to fail anyway,
+    // and failing does not return or retain the current value, so it needs neither the
+    // spinlock nor any collector interaction. A stale read here just reports a failure
+    // that the concurrent mutation justifies.
+    if (atomicGet(reinterpret_cast<KRef volatile*>(&ref->value_)) != expectedValue) {
+        return false;
+    }
     ObjHolder holder;
     auto old = SwapHeapRefLocked(&ref->value_, expectedValue, newValue,
         &ref->lock_, &ref->cookie_, holder.slot());
@@ -5,6 +5,7 @@
 
 #include "Cleaner.h"
 
+#include "Alloc.h"
 #include "Memory.h"
 #include "Runtime.h"
 #include "Worker.h"
@@ -12,6 +13,8 @@
 // Defined in Cleaner.kt
 extern "C" void Kotlin_CleanerImpl_shutdownCleanerWorker(KInt, bool);
 extern "C" KInt Kotlin_CleanerImpl_createCleanerWorker();
+// Defined in Worker.kt
+extern "C" OBJ_GETTER(WorkerLaunchpad, KRef);
 
 namespace {
 
@@ -26,6 +29,38 @@ constexpr KInt kCleanerWorkerShutdown = -2;
 
 KInt globalCleanerWorker = kCleanerWorkerUninitialized;
 
+// Cleaner blocks are batched into segments and executed by a single drain job, so a GC
+// cycle that kills many cleaners pays per-drain, not per-cleaner, scheduling cost.
+constexpr uint32_t kCleanerSegmentSize = 256;
+
+struct CleanerSegment {
+    KNativePtr blocks[kCleanerSegmentSize];
+    uint32_t count;
+    CleanerSegment* next;
+};
+
+int32_t cleanersLock = 0;
+CleanerSegment* pendingCleanersHead = nullptr;
+CleanerSegment* pendingCleanersTail = nullptr;
+// Exhausted segments are kept for reuse instead of being freed.
+CleanerSegment* freeCleanerSegments = nullptr;
+// Set while a drain job is queued on the cleaner worker or running; armed by the block
+// that finds it clear.
+int32_t drainScheduled = 0;
+// Permanent stable pointer to the drain operation (see [createCleanerWorker]).
+KNativePtr cleanerDrain = nullptr;
+// Backpressure stats, guarded by cleanersLock.
+KLong cleanersScheduledCount = 0;
+KLong cleanersExecutedCount = 0;
+
+inline void lockCleaners() {
+    while (!compareAndSet(&cleanersLock, 0, 1)) {}
+}
+
+inline void unlockCleaners() {
+    atomicSet(&cleanersLock, 0);
+}
+
 void disposeCleaner(CleanerImpl* thiz) {
     auto worker = atomicGet(&globalCleanerWorker);
     RuntimeAssert(
@@ -44,12 +79,125 @@ void disposeCleaner(CleanerImpl* thiz) {
 
     RuntimeAssert(worker > 0, "Cleaner worker must be fully initialized here");
 
-    bool result = WorkerSchedule(worker, thiz->cleanerStablePtr);
-    RuntimeAssert(result, "Couldn't find Cleaner worker");
+    bool needDrain = false;
+    lockCleaners();
+    CleanerSegment* tail = pendingCleanersTail;
+    if (tail == nullptr || tail->count == kCleanerSegmentSize) {
+        CleanerSegment* segment = freeCleanerSegments;
+        if (segment != nullptr) {
+            freeCleanerSegments = segment->next;
+            segment->next = nullptr;
+        } else {
+            segment = konanConstructInstance<CleanerSegment>();
+        }
+        if (tail == nullptr) {
+            pendingCleanersHead = segment;
+        } else {
+            tail->next = segment;
+        }
+        pendingCleanersTail = segment;
+        tail = segment;
+    }
+    tail->blocks[tail->count++] = thiz->cleanerStablePtr;
+    cleanersScheduledCount++;
+    if (drainScheduled == 0) {
+        drainScheduled = 1;
+        needDrain = true;
+    }
+    unlockCleaners();
+
+    if (needDrain) {
+        ObjHolder drainHolder;
+        KRef drain = DerefStablePointer(cleanerDrain, drainHolder.slot());
+        bool result = WorkerSchedule(worker, CreateStablePointer(drain));
+        RuntimeAssert(result, "Couldn't find Cleaner worker");
+    }
+}
+
+// Scoped cleanables: a per-scope intrusive list of cleanup blocks released in bulk
+// by a single runtime call when the scope is left (see CleanerScope in Cleaner.kt).
+// Scopes are confined to their owner thread, so the lists need no locking; only a
+// detached block (see [Kotlin_CleanerScope_detach]) ever leaves the thread, wrapped
+// into a regular Cleaner and falling back to the cleaner worker.
+
+struct ScopedCleanableEntry {
+    KNativePtr block;
+    ScopedCleanableEntry* next;
+    ScopedCleanableEntry* prev;
+};
+
+struct CleanerScope {
+    ScopedCleanableEntry* head;
+    CleanerScope* parent;
+};
+
+THREAD_LOCAL_VARIABLE CleanerScope* currentCleanerScope = nullptr;
+
+void runScopedCleanable(KNativePtr block) {
+    ObjHolder blockHolder, resultHolder;
+    KRef blockRef = DerefStablePointer(block, blockHolder.slot());
+#if KONAN_NO_EXCEPTIONS
+    WorkerLaunchpad(blockRef, resultHolder.slot());
+#else
+    try {
+        WorkerLaunchpad(blockRef, resultHolder.slot());
+    } catch (ExceptionObjHolder&) {
+        // Match the cleaner worker: unhandled exceptions in cleanup blocks are dropped.
+    }
+#endif
+    DisposeStablePointer(block);
 }
 
 } // namespace
 
+KNativePtr Kotlin_CleanerScope_enter() {
+    auto* scope = konanConstructInstance<CleanerScope>();
+    scope->parent = currentCleanerScope;
+    currentCleanerScope = scope;
+    return scope;
+}
+
+KNativePtr Kotlin_CleanerScope_attach(KNativePtr scopeRaw, KNativePtr block) {
+    auto* scope = reinterpret_cast<CleanerScope*>(scopeRaw);
+    RuntimeAssert(scope == currentCleanerScope, "Cleanables can only be attached to the innermost scope");
+    auto* entry = konanConstructInstance<ScopedCleanableEntry>();
+    entry->block = block;
+    entry->next = scope->head;
+    if (scope->head != nullptr) scope->head->prev = entry;
+    scope->head = entry;
+    return entry;
+}
+
+KNativePtr Kotlin_CleanerScope_detach(KNativePtr scopeRaw, KNativePtr entryRaw) {
+    auto* scope = reinterpret_cast<CleanerScope*>(scopeRaw);
+    RuntimeAssert(scope == currentCleanerScope, "Cleanables can only escape while their scope is active");
+    auto* entry = reinterpret_cast<ScopedCleanableEntry*>(entryRaw);
+    if (entry->prev != nullptr)
+        entry->prev->next = entry->next;
+    else
+        scope->head = entry->next;
+    if (entry->next != nullptr) entry->next->prev = entry->prev;
+    KNativePtr block = entry->block;
+    konanDestructInstance(entry);
+    return block;
+}
+
+void Kotlin_CleanerScope_leave(KNativePtr scopeRaw) {
+    auto* scope = reinterpret_cast<CleanerScope*>(scopeRaw);
+    RuntimeAssert(scope == currentCleanerScope, "Scopes must be left in reverse entry order");
+    // Pop first: a cleanup block that registers new cleanables attaches them to the
+    // parent scope rather than to the one being torn down.
+    currentCleanerScope = scope->parent;
+    ScopedCleanableEntry* entry = scope->head;
+    while (entry != nullptr) {
+        ScopedCleanableEntry* next = entry->next;
+        runScopedCleanable(entry->block);
+        konanDestructInstance(entry);
+        entry = next;
+    }
+    konanDestructInstance(scope);
+}
+
 RUNTIME_NOTHROW void DisposeCleaner(KRef thiz) {
 #if KONAN_NO_EXCEPTIONS
     disposeCleaner(reinterpret_cast<CleanerImpl*>(thiz));
@@ -125,6 +273,79 @@ extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker() {
     return worker;
 }
 
-void ResetCleanerWorkerForTests() {
+// Executes all batched cleaner blocks. Runs on the cleaner worker as a regular job
+// (see [createCleanerWorker]); blocks scheduled while it runs are picked up too.
+extern "C" void Kotlin_CleanerImpl_drainCleaners() {
+    while (true) {
+        CleanerSegment* segment = nullptr;
+        lockCleaners();
+        segment = pendingCleanersHead;
+        if (segment != nullptr) {
+            pendingCleanersHead = segment->next;
+            if (pendingCleanersHead == nullptr) pendingCleanersTail = nullptr;
+            segment->next = nullptr;
+        } else {
+            // Fully drained: the next scheduled block arms a new drain job.
+            drainScheduled = 0;
+        }
+        unlockCleaners();
+        if (segment == nullptr) return;
+
+        for (uint32_t i = 0; i < segment->count; i++) {
+            KNativePtr block = segment->blocks[i];
+            ObjHolder blockHolder, resultHolder;
+            KRef blockRef = DerefStablePointer(block, blockHolder.slot());
+#if KONAN_NO_EXCEPTIONS
+            WorkerLaunchpad(blockRef, resultHolder.slot());
+#else
+            try {
+                WorkerLaunchpad(blockRef, resultHolder.slot());
+            } catch (ExceptionObjHolder&) {
+                // Same as a per-cleaner job on this worker: it is started with error
+                // reporting disabled, so unhandled exceptions in blocks are dropped.
+            }
+#endif
+            DisposeStablePointer(block);
+        }
+
+        lockCleaners();
+        cleanersExecutedCount += segment->count;
+        segment->count = 0;
+        segment->next = freeCleanerSegments;
+        freeCleanerSegments = segment;
+        unlockCleaners();
+    }
+}
+
+extern "C" void Kotlin_CleanerImpl_registerCleanerDrain(KNativePtr drain) {
+    // Can only be non-null after ResetCleanerWorkerForTests().
+    if (cleanerDrain != nullptr) DisposeStablePointer(cleanerDrain);
+    cleanerDrain = drain;
+}
+
+extern "C" KLong Kotlin_CleanerImpl_getScheduledCleaners() {
+    lockCleaners();
+    KLong result = cleanersScheduledCount;
+    unlockCleaners();
+    return result;
+}
+
+extern "C" KLong Kotlin_CleanerImpl_getPendingCleaners() {
+    lockCleaners();
+    KLong result = cleanersScheduledCount - cleanersExecutedCount;
+    unlockCleaners();
+    return result;
+}
+
+void ResetCleanerWorker() {
     atomicSet(&globalCleanerWorker, kCleanerWorkerUninitialized);
+    // Let the next scheduled block arm a drain job on the new worker; segments still
+    // pending from the old worker are drained by it as well.
+    lockCleaners();
+    drainScheduled = 0;
+    unlockCleaners();
+}
+
+void ResetCleanerWorkerForTests() {
+    ResetCleanerWorker();
 }
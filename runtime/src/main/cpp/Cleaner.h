@@ -15,6 +15,19 @@ void ShutdownCleaners(bool executeScheduledCleaners);
 
 extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker();
 
+// Scoped deterministic cleanup (see CleanerScope in Cleaner.kt). A scope is a
+// thread-confined intrusive list of cleanup blocks; leaving it runs the remaining
+// blocks on the calling thread in reverse attach order, in one runtime call.
+// A detached block escapes the scope and is wrapped into a regular Cleaner instead.
+extern "C" KNativePtr Kotlin_CleanerScope_enter();
+extern "C" void Kotlin_CleanerScope_leave(KNativePtr scope);
+extern "C" KNativePtr Kotlin_CleanerScope_attach(KNativePtr scope, KNativePtr block);
+extern "C" KNativePtr Kotlin_CleanerScope_detach(KNativePtr scope, KNativePtr entry);
+
+// Re-arms cleaners after ShutdownCleaners: the next scheduled cleaner lazily
+// creates a fresh worker. Pending segments carry over and are drained by it.
+void ResetCleanerWorker();
+
 void ResetCleanerWorkerForTests();
 
 #endif // RUNTIME_CLEANER_H
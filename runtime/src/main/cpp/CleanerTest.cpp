@@ -78,3 +78,27 @@ TEST(CleanerTest, ShutdownWithCreation) {
     EXPECT_CALL(*shutdownCleanerWorkerMock, Call(workerId, executeScheduledCleaners));
     ShutdownCleaners(executeScheduledCleaners);
 }
+
+TEST(CleanerScopeTest, DetachReturnsBlock) {
+    KNativePtr scope = Kotlin_CleanerScope_enter();
+    // Never dereferenced: the entry is detached before the scope is left.
+    KNativePtr block = reinterpret_cast<KNativePtr>(static_cast<uintptr_t>(0x1234));
+    KNativePtr entry = Kotlin_CleanerScope_attach(scope, block);
+    EXPECT_THAT(Kotlin_CleanerScope_detach(scope, entry), block);
+    Kotlin_CleanerScope_leave(scope);
+}
+
+TEST(CleanerScopeTest, NestedScopesDetachIndependently) {
+    KNativePtr outer = Kotlin_CleanerScope_enter();
+    KNativePtr outerBlock = reinterpret_cast<KNativePtr>(static_cast<uintptr_t>(0x1));
+    KNativePtr outerEntry = Kotlin_CleanerScope_attach(outer, outerBlock);
+
+    KNativePtr inner = Kotlin_CleanerScope_enter();
+    KNativePtr innerBlock = reinterpret_cast<KNativePtr>(static_cast<uintptr_t>(0x2));
+    KNativePtr innerEntry = Kotlin_CleanerScope_attach(inner, innerBlock);
+    EXPECT_THAT(Kotlin_CleanerScope_detach(inner, innerEntry), innerBlock);
+    Kotlin_CleanerScope_leave(inner);
+
+    EXPECT_THAT(Kotlin_CleanerScope_detach(outer, outerEntry), outerBlock);
+    Kotlin_CleanerScope_leave(outer);
+}
@@ -13,6 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string.h>
+
+#if !KONAN_WINDOWS && !KONAN_WASM && !KONAN_ZEPHYR
+#define KONAN_CAN_MMAP_STDIN 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "KAssert.h"
 #include "Memory.h"
 #include "Natives.h"
@@ -22,6 +31,111 @@
 #include "Exceptions.h"
 
 #include "utf8.h"
+#include "Utils.h"
+
+namespace {
+
+// Runtime-managed standard output buffer. Disabled by default, so every print
+// maps to one write as before; line-oriented producers can enable it through
+// Console.setOutputBuffer to batch many prints per syscall.
+SimpleMutex outputLock;
+char* outputBuffer = nullptr;
+uint32_t outputBufferCapacity = 0;
+uint32_t outputBufferUsed = 0;
+bool flushOnNewline = false;
+
+// Must be called with outputLock held.
+void flushOutputBufferLocked() {
+  if (outputBufferUsed != 0) {
+    konan::consoleWriteUtf8(outputBuffer, outputBufferUsed);
+    outputBufferUsed = 0;
+  }
+}
+
+void writeOutput(const char* data, uint32_t size) {
+  LockGuard<SimpleMutex> guard(outputLock);
+  if (outputBufferCapacity == 0) {
+    konan::consoleWriteUtf8(data, size);
+    return;
+  }
+  if (size >= outputBufferCapacity) {
+    // Too big to ever fit: emit pending bytes and the new chunk in one syscall.
+    konan::consoleWriteUtf8Pair(outputBuffer, outputBufferUsed, data, size);
+    outputBufferUsed = 0;
+    return;
+  }
+  if (size > outputBufferCapacity - outputBufferUsed) {
+    flushOutputBufferLocked();
+  }
+  memcpy(outputBuffer + outputBufferUsed, data, size);
+  outputBufferUsed += size;
+  if (flushOnNewline && memchr(data, '\n', size) != nullptr) {
+    flushOutputBufferLocked();
+  }
+}
+
+// Runtime-managed standard input reader. Input is consumed in large chunks -
+// or straight from a mapping of stdin when it is a regular file - and split
+// into lines here, so a line costs no syscall in the common case.
+SimpleMutex inputLock;
+constexpr uint32_t kInputBufferSize = 64 * 1024;
+
+char* inputBuffer = nullptr;
+uint32_t inputBufferCapacity = 0;
+uint32_t inputStart = 0;  // First unconsumed byte.
+uint32_t inputEnd = 0;    // One past the last valid byte.
+bool inputEof = false;
+bool inputInitialized = false;
+
+#if KONAN_CAN_MMAP_STDIN
+const char* inputMapped = nullptr;
+size_t inputMappedSize = 0;
+size_t inputMappedPosition = 0;
+#endif
+
+// Must be called with inputLock held.
+void initInputLocked() {
+  inputInitialized = true;
+#if KONAN_CAN_MMAP_STDIN
+  struct stat statBuffer;
+  if (::fstat(STDIN_FILENO, &statBuffer) == 0 && S_ISREG(statBuffer.st_mode)
+      && statBuffer.st_size > 0) {
+    void* mapped = ::mmap(nullptr, statBuffer.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+    if (mapped != MAP_FAILED) {
+      ::madvise(mapped, statBuffer.st_size, MADV_SEQUENTIAL);
+      inputMapped = static_cast<const char*>(mapped);
+      inputMappedSize = static_cast<size_t>(statBuffer.st_size);
+    }
+  }
+#endif
+}
+
+// Must be called with inputLock held. Ensures room to read more bytes after inputEnd.
+void makeInputRoomLocked() {
+  if (inputBuffer == nullptr) {
+    inputBufferCapacity = kInputBufferSize;
+    inputBuffer = reinterpret_cast<char*>(konan::calloc(1, inputBufferCapacity));
+    RuntimeCheck(inputBuffer != nullptr, "Cannot allocate console input buffer");
+    return;
+  }
+  if (inputStart != 0) {
+    memmove(inputBuffer, inputBuffer + inputStart, inputEnd - inputStart);
+    inputEnd -= inputStart;
+    inputStart = 0;
+  }
+  if (inputEnd == inputBufferCapacity) {
+    // The pending line is longer than the whole buffer.
+    uint32_t newCapacity = inputBufferCapacity * 2;
+    char* newBuffer = reinterpret_cast<char*>(konan::calloc(1, newCapacity));
+    RuntimeCheck(newBuffer != nullptr, "Cannot allocate console input buffer");
+    memcpy(newBuffer, inputBuffer, inputEnd);
+    konan::free(inputBuffer);
+    inputBuffer = newBuffer;
+    inputBufferCapacity = newCapacity;
+  }
+}
+
+}  // namespace
 
 extern "C" {
 
@@ -36,7 +150,7 @@ void Kotlin_io_Console_print(KString message) {
   utf8.reserve(message->count_);
   // Replace incorrect sequences with a default codepoint (see utf8::with_replacement::default_replacement)
   utf8::with_replacement::utf16to8(utf16, utf16 + message->count_, back_inserter(utf8));
-  konan::consoleWriteUtf8(utf8.c_str(), utf8.size());
+  writeOutput(utf8.c_str(), utf8.size());
 }
 
 void Kotlin_io_Console_println(KString message) {
@@ -48,15 +162,84 @@ void Kotlin_io_Console_println(KString message) {
 }
 
 void Kotlin_io_Console_println0() {
-  konan::consoleWriteUtf8("\n", 1);
+  writeOutput("\n", 1);
+}
+
+void Kotlin_io_Console_flush() {
+  LockGuard<SimpleMutex> guard(outputLock);
+  flushOutputBufferLocked();
+}
+
+void Kotlin_io_Console_setOutputBuffer(KInt sizeBytes, KBoolean autoFlushOnNewline) {
+  LockGuard<SimpleMutex> guard(outputLock);
+  flushOutputBufferLocked();
+  if (outputBuffer != nullptr) {
+    konan::free(outputBuffer);
+    outputBuffer = nullptr;
+  }
+  outputBufferCapacity = sizeBytes > 0 ? static_cast<uint32_t>(sizeBytes) : 0;
+  if (outputBufferCapacity != 0) {
+    outputBuffer = reinterpret_cast<char*>(konan::calloc(1, outputBufferCapacity));
+    if (outputBuffer == nullptr) {
+      outputBufferCapacity = 0;
+    }
+  }
+  flushOnNewline = autoFlushOnNewline;
 }
 
 OBJ_GETTER0(Kotlin_io_Console_readLine) {
-  char data[4096];
-  if (konan::consoleReadUtf8(data, sizeof(data)) < 0) {
-    RETURN_OBJ(nullptr);
+  // Make any buffered prompt visible before blocking on input.
+  Kotlin_io_Console_flush();
+  LockGuard<SimpleMutex> guard(inputLock);
+  if (!inputInitialized) initInputLocked();
+
+#if KONAN_CAN_MMAP_STDIN
+  if (inputMapped != nullptr) {
+    if (inputMappedPosition >= inputMappedSize) {
+      RETURN_OBJ(nullptr);
+    }
+    const char* begin = inputMapped + inputMappedPosition;
+    size_t remaining = inputMappedSize - inputMappedPosition;
+    const char* newline = static_cast<const char*>(memchr(begin, '\n', remaining));
+    size_t lineBytes = newline != nullptr ? static_cast<size_t>(newline - begin) : remaining;
+    inputMappedPosition += lineBytes + (newline != nullptr ? 1 : 0);
+    if (lineBytes > 0 && begin[lineBytes - 1] == '\r') lineBytes--;
+    RETURN_RESULT_OF(CreateStringFromUtf8, begin, static_cast<uint32_t>(lineBytes));
+  }
+#endif
+
+  while (true) {
+    if (inputEnd > inputStart) {
+      char* begin = inputBuffer + inputStart;
+      char* newline = static_cast<char*>(memchr(begin, '\n', inputEnd - inputStart));
+      if (newline != nullptr) {
+        uint32_t lineBytes = newline - begin;
+        inputStart += lineBytes + 1;
+        if (lineBytes > 0 && begin[lineBytes - 1] == '\r') lineBytes--;
+        RETURN_RESULT_OF(CreateStringFromUtf8, begin, lineBytes);
+      }
+    }
+    if (inputEof) {
+      // Let a later call try the descriptor again, e.g. after Ctrl-D on a terminal.
+      inputEof = false;
+      if (inputEnd == inputStart) {
+        RETURN_OBJ(nullptr);
+      }
+      // Last line of the input, no terminator.
+      char* begin = inputBuffer + inputStart;
+      uint32_t lineBytes = inputEnd - inputStart;
+      inputStart = inputEnd;
+      if (lineBytes > 0 && begin[lineBytes - 1] == '\r') lineBytes--;
+      RETURN_RESULT_OF(CreateStringFromUtf8, begin, lineBytes);
+    }
+    makeInputRoomLocked();
+    int32_t got = konan::consoleReadUtf8Chunk(inputBuffer + inputEnd, inputBufferCapacity - inputEnd);
+    if (got < 0) {
+      inputEof = true;
+    } else {
+      inputEnd += got;
+    }
   }
-  RETURN_RESULT_OF(CreateStringFromCString, data);
 }
 
 } // extern "C"
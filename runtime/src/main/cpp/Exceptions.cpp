@@ -34,12 +34,22 @@
 #endif
 #endif // OMIT_BACKTRACE
 
+// Frame-pointer chain walking is possible where the ABI keeps the saved frame
+// pointer and the return address adjacent on the stack. It only yields usable
+// traces in binaries built without -fomit-frame-pointer, so it stays opt-in.
+#if !defined(OMIT_BACKTRACE) && (KONAN_X64 || KONAN_ARM64) && !KONAN_WINDOWS
+#define USE_FRAME_POINTER_UNWIND 1
+#else
+#define USE_FRAME_POINTER_UNWIND 0
+#endif
+
 #include "KAssert.h"
 #include "Exceptions.h"
 #include "ExecFormat.h"
 #include "Memory.h"
 #include "Natives.h"
 #include "KString.h"
+#include "RuntimeConfig.h"
 #include "SourceInfo.h"
 #include "Types.h"
 #include "Utils.h"
@@ -55,36 +65,37 @@ KRef currentUnhandledExceptionHook = nullptr;
 int32_t currentUnhandledExceptionHookLock = 0;
 int32_t currentUnhandledExceptionHookCookie = 0;
 
+#ifndef OMIT_BACKTRACE
+// Upper bound of the on-stack capture buffers below; the stackTraceDepth knob
+// in the runtime config can lower the capture depth but never exceed this.
+constexpr int kMaxCapturedFrames = 256;
+// Depth of the unwinder-based captures when the config does not say otherwise.
+constexpr int kDefaultBacktraceFrames = 32;
+
+// Effective capture depth: the deployment config when set, otherwise the
+// default of the capture mechanism at hand.
+int stackTraceDepth(int defaultDepth) {
+  int32_t configured = konanRuntimeConfig().stackTraceDepth;
+  if (configured <= 0) return defaultDepth;
+  return configured < kMaxCapturedFrames ? configured : kMaxCapturedFrames;
+}
+#endif  // !OMIT_BACKTRACE
+
 #if USE_GCC_UNWIND
+// Capture must stay cheap: exceptions are sometimes used for control flow, so
+// raw PCs are collected into a bounded on-stack buffer in a single unwind pass
+// and the Kotlin array is allocated only once the frame count is known. All
+// symbolication happens later, in GetStackTraceStrings.
 struct Backtrace {
-  Backtrace(int count, int skip) : index(0), skipCount(skip) {
-    uint32_t size = count - skipCount;
-    if (size < 0) {
-      size = 0;
-    }
-    auto result = AllocArrayInstance(theNativePtrArrayTypeInfo, size, arrayHolder.slot());
-    // TODO: throw cached OOME?
-    RuntimeCheck(result != nullptr, "Cannot create backtrace array");
-  }
-
-  void setNextElement(_Unwind_Ptr element) {
-    Kotlin_NativePtrArray_set(obj(), index++, (KNativePtr) element);
-  }
-
-  ObjHeader* obj() { return arrayHolder.obj(); }
+  explicit Backtrace(int skip)
+      : skipCount(skip), maxCount(stackTraceDepth(kDefaultBacktraceFrames)) {}
 
-  int index;
+  _Unwind_Ptr frames[kMaxCapturedFrames];
+  int count = 0;
   int skipCount;
-  ObjHolder arrayHolder;
+  int maxCount;
 };
 
-_Unwind_Reason_Code depthCountCallback(
-    struct _Unwind_Context * context, void* arg) {
-  int* result = reinterpret_cast<int*>(arg);
-  (*result)++;
-  return _URC_NO_REASON;
-}
-
 _Unwind_Reason_Code unwindCallback(
     struct _Unwind_Context* context, void* arg) {
   Backtrace* backtrace = reinterpret_cast<Backtrace*>(arg);
@@ -92,18 +103,60 @@ _Unwind_Reason_Code unwindCallback(
     backtrace->skipCount--;
     return _URC_NO_REASON;
   }
+  if (backtrace->count >= backtrace->maxCount) {
+    return _URC_END_OF_STACK;
+  }
 
 #if (__MINGW32__ || __MINGW64__)
   _Unwind_Ptr address = _Unwind_GetRegionStart(context);
 #else
   _Unwind_Ptr address = _Unwind_GetIP(context);
 #endif
-  backtrace->setNextElement(address);
+  backtrace->frames[backtrace->count++] = address;
 
   return _URC_NO_REASON;
 }
 #endif
 
+#if USE_FRAME_POINTER_UNWIND
+// Default depth of the fast path; deeper than the unwinder default since the
+// walk is so much cheaper per frame.
+constexpr int kMaxFramePointerFrames = 64;
+
+// Stack frame layout shared by the System V x86-64 and AAPCS64 ABIs:
+// the saved caller frame pointer, immediately followed by the return address.
+struct FrameRecord {
+  FrameRecord* next;
+  void* returnAddress;
+};
+
+// Walks the frame pointer chain instead of running the unwinder. Two orders of
+// magnitude cheaper than _Unwind_Backtrace, but sees only frames of code
+// compiled with frame pointers preserved.
+NO_INLINE int framePointerBacktrace(void** frames, int maxFrames, int skipCount) {
+  auto* frame = reinterpret_cast<FrameRecord*>(__builtin_frame_address(0));
+  int count = 0;
+  while (frame != nullptr && count < maxFrames) {
+    void* pc = frame->returnAddress;
+    if (pc == nullptr) break;
+    if (skipCount > 0) {
+      skipCount--;
+    } else {
+      frames[count++] = pc;
+    }
+    FrameRecord* next = frame->next;
+    // The stack grows down, so the chain must be strictly increasing and
+    // pointer-aligned; anything else means a frame without a frame pointer.
+    if (next <= frame || (reinterpret_cast<uintptr_t>(next) & (sizeof(void*) - 1)) != 0) break;
+    frame = next;
+  }
+  return count;
+}
+#endif  // USE_FRAME_POINTER_UNWIND
+
+// See Konan_Platform_setFastStackTraceCapture.
+bool g_fastStackTraceCapture = false;
+
 THREAD_LOCAL_VARIABLE bool disallowSourceInfo = false;
 
 SourceInfo getSourceInfo(KConstRef stackTrace, int index) {
@@ -112,8 +165,64 @@ SourceInfo getSourceInfo(KConstRef stackTrace, int index) {
       : Kotlin_getSourceInfo(*PrimitiveArrayAddressOfElementAt<KNativePtr>(stackTrace->array(), index));
 }
 
+#ifndef OMIT_BACKTRACE
+// Cache of formatted frame lines keyed by PC. Exception funnels symbolize the
+// same few hundred frames all day, and a PC always formats to the same line,
+// so repeated symbolication becomes a hash lookup instead of a symtab search.
+// Values are frozen strings kept alive forever via stable pointers and the
+// table is bounded, following the string intern table discipline (KString.cpp).
+constexpr size_t kMaxCachedFrameStrings = 2048;
+
+int32_t frameStringCacheLock = 0;
+KStdUnorderedMap<KNativePtr, KNativePtr>* frameStringCache = nullptr;
+
+void lockFrameStringCache() {
+  while (!compareAndSet(&frameStringCacheLock, 0, 1)) {}
+}
+
+void unlockFrameStringCache() {
+  atomicSet(&frameStringCacheLock, 0);
+}
+
+KNativePtr cachedFrameString(KNativePtr pc) {
+  KNativePtr result = nullptr;
+  lockFrameStringCache();
+  if (frameStringCache != nullptr) {
+    auto it = frameStringCache->find(pc);
+    if (it != frameStringCache->end()) result = it->second;
+  }
+  unlockFrameStringCache();
+  return result;
+}
+
+void rememberFrameString(KNativePtr pc, KRef line) {
+  // Shared between whoever symbolizes the same PC, freeze to make that safe
+  // across threads.
+  FreezeSubgraph(line);
+  lockFrameStringCache();
+  if (frameStringCache == nullptr)
+    frameStringCache = konanConstructInstance<KStdUnorderedMap<KNativePtr, KNativePtr>>();
+  if (frameStringCache->size() < kMaxCachedFrameStrings) {
+    auto insertion = frameStringCache->emplace(pc, nullptr);
+    // Another thread could have published the same PC in between, keep its entry.
+    if (insertion.second)
+      insertion.first->second = CreateStablePointer(line);
+  }
+  unlockFrameStringCache();
+}
+#endif  // !OMIT_BACKTRACE
+
 }  // namespace
 
+NO_INLINE int FramePointerBacktrace(void** frames, int maxFrames, int skipCount) {
+#if USE_FRAME_POINTER_UNWIND
+  // One extra frame to skip: this wrapper itself.
+  return framePointerBacktrace(frames, maxFrames, skipCount + 1);
+#else
+  return 0;
+#endif
+}
+
 // TODO: this implementation is just a hack, e.g. the result is inexact;
 // however it is better to have an inexact stacktrace than not to have any.
 NO_INLINE OBJ_GETTER0(Kotlin_getCurrentStackTrace) {
@@ -122,19 +231,33 @@ NO_INLINE OBJ_GETTER0(Kotlin_getCurrentStackTrace) {
 #else
   // Skips first 2 elements as irrelevant: this function and primary Throwable constructor.
   constexpr int kSkipFrames = 2;
+#if USE_FRAME_POINTER_UNWIND
+  if (g_fastStackTraceCapture) {
+    void* frames[kMaxCapturedFrames];
+    // One extra frame to skip: framePointerBacktrace itself.
+    int count = framePointerBacktrace(frames, stackTraceDepth(kMaxFramePointerFrames), kSkipFrames + 1);
+    ObjHolder fastResultHolder;
+    ObjHeader* fastResult =
+        AllocArrayInstance(theNativePtrArrayTypeInfo, count, fastResultHolder.slot());
+    for (int index = 0; index < count; ++index) {
+      Kotlin_NativePtrArray_set(fastResult, index, (KNativePtr) frames[index]);
+    }
+    RETURN_OBJ(fastResult);
+  }
+#endif
 #if USE_GCC_UNWIND
-  int depth = 0;
-  _Unwind_Backtrace(depthCountCallback, &depth);
-  Backtrace result(depth, kSkipFrames);
-  if (result.obj()->array()->count_ > 0) {
-    _Unwind_Backtrace(unwindCallback, &result);
+  Backtrace backtrace(kSkipFrames);
+  _Unwind_Backtrace(unwindCallback, &backtrace);
+  ObjHolder resultHolder;
+  ObjHeader* result = AllocArrayInstance(theNativePtrArrayTypeInfo, backtrace.count, resultHolder.slot());
+  for (int index = 0; index < backtrace.count; ++index) {
+    Kotlin_NativePtrArray_set(result, index, (KNativePtr) backtrace.frames[index]);
   }
-  RETURN_OBJ(result.obj());
+  RETURN_OBJ(result);
 #else
-  const int maxSize = 32;
-  void* buffer[maxSize];
+  void* buffer[kMaxCapturedFrames];
 
-  int size = backtrace(buffer, maxSize);
+  int size = backtrace(buffer, stackTraceDepth(kDefaultBacktraceFrames));
   if (size < kSkipFrames)
     return AllocArrayInstance(theNativePtrArrayTypeInfo, 0, OBJ_RESULT);
 
@@ -148,6 +271,24 @@ NO_INLINE OBJ_GETTER0(Kotlin_getCurrentStackTrace) {
 #endif  // !OMIT_BACKTRACE
 }
 
+// For Throwable classes that opt out of stack trace capture (see
+// kotlin.native.NoStackTrace).
+OBJ_GETTER0(Kotlin_emptyStackTrace) {
+  RETURN_RESULT_OF(AllocArrayInstance, theNativePtrArrayTypeInfo, 0);
+}
+
+extern "C" KBoolean Konan_Platform_getFastStackTraceCapture() {
+  return g_fastStackTraceCapture;
+}
+
+extern "C" void Konan_Platform_setFastStackTraceCapture(KBoolean value) {
+#if USE_FRAME_POINTER_UNWIND
+  g_fastStackTraceCapture = value;
+#endif
+  // On targets without frame pointer unwinding the flag stays off and stack
+  // traces keep using the unwinder.
+}
+
 OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace) {
 #if OMIT_BACKTRACE
   ObjHeader* result = AllocArrayInstance(theArrayTypeInfo, 1, OBJ_RESULT);
@@ -162,25 +303,37 @@ OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace) {
 #if USE_GCC_UNWIND
   for (uint32_t index = 0; index < size; ++index) {
     KNativePtr address = Kotlin_NativePtrArray_get(stackTrace, index);
-    char symbol[512];
-    if (!AddressToSymbol((const void*) address, symbol, sizeof(symbol))) {
-      // Make empty string:
-      symbol[0] = '\0';
-    }
-    char line[512];
-    konan::snprintf(line, sizeof(line) - 1, "%s (%p)", symbol, (void*)(intptr_t)address);
     ObjHolder holder;
-    CreateStringFromCString(line, holder.slot());
+    KNativePtr cached = cachedFrameString(address);
+    if (cached != nullptr) {
+      DerefStablePointer(cached, holder.slot());
+    } else {
+      char symbol[512];
+      if (!AddressToSymbol((const void*) address, symbol, sizeof(symbol))) {
+        // Make empty string:
+        symbol[0] = '\0';
+      }
+      char line[512];
+      konan::snprintf(line, sizeof(line) - 1, "%s (%p)", symbol, (void*)(intptr_t)address);
+      CreateStringFromCString(line, holder.slot());
+      rememberFrameString(address, holder.obj());
+    }
     UpdateHeapRef(ArrayAddressOfElementAt(strings->array(), index), holder.obj());
   }
 #else
-  if (size > 0) {
-    char **symbols = backtrace_symbols(PrimitiveArrayAddressOfElementAt<KNativePtr>(stackTrace->array(), 0), size);
-    RuntimeCheck(symbols != nullptr, "Not enough memory to retrieve the stacktrace");
-
-    for (uint32_t index = 0; index < size; ++index) {
+  for (uint32_t index = 0; index < size; ++index) {
+    KNativePtr address = Kotlin_NativePtrArray_get(stackTrace, index);
+    ObjHolder holder;
+    // Suppressed source info changes the formatting, bypass the cache then.
+    bool cacheUsable = !disallowSourceInfo;
+    KNativePtr cached = cacheUsable ? cachedFrameString(address) : nullptr;
+    if (cached != nullptr) {
+      DerefStablePointer(cached, holder.slot());
+    } else {
+      char** symbols = backtrace_symbols(&address, 1);
+      RuntimeCheck(symbols != nullptr, "Not enough memory to retrieve the stacktrace");
       auto sourceInfo = getSourceInfo(stackTrace, index);
-      const char* symbol = symbols[index];
+      const char* symbol = symbols[0];
       const char* result;
       char line[1024];
       if (sourceInfo.fileName != nullptr) {
@@ -194,12 +347,12 @@ OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace) {
       } else {
         result = symbol;
       }
-      ObjHolder holder;
       CreateStringFromCString(result, holder.slot());
-      UpdateHeapRef(ArrayAddressOfElementAt(strings->array(), index), holder.obj());
+      // Not konan::free. Frees memory allocated in backtrace_symbols where malloc is used.
+      free(symbols);
+      if (cacheUsable) rememberFrameString(address, holder.obj());
     }
-    // Not konan::free. Used to free memory allocated in backtrace_symbols where malloc is used.
-    free(symbols);
+    UpdateHeapRef(ArrayAddressOfElementAt(strings->array(), index), holder.obj());
   }
 #endif
   RETURN_OBJ(strings);
@@ -213,6 +366,12 @@ void ThrowException(KRef exception) {
   PrintThrowable(exception);
   RuntimeCheck(false, "Exceptions unsupported");
 #else
+  // Preallocated control-flow exceptions are frozen singletons that outlive
+  // any unwind, so rethrowing them need not touch reference counts.
+  if ((exception->type_info()->flags_ & TF_CONTROL_FLOW_EXCEPTION) != 0 &&
+      isPermanentOrFrozen(exception)) {
+    throw ExceptionObjHolder(exception, ExceptionObjHolder::NoRetainTag::kNoRetain);
+  }
   throw ExceptionObjHolder(exception);
 #endif
 }
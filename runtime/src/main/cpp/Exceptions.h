@@ -31,7 +31,7 @@ OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace);
 OBJ_GETTER(Kotlin_setUnhandledExceptionHook, KRef hook);
 
 // Throws arbitrary exception.
-void ThrowException(KRef exception);
+void RUNTIME_NORETURN ThrowException(KRef exception);
 
 void OnUnhandledException(KRef throwable);
 
@@ -74,4 +74,10 @@ void PrintThrowable(KRef);
 // It's not always safe to extract SourceInfo during unhandled exception termination.
 void DisallowSourceInfo();
 
+// Cheap frame-pointer chain capture of raw return addresses, skipping [skipCount]
+// frames above the immediate caller. Returns the number of frames stored, or 0 on
+// platforms without frame-pointer unwinding. Only sees frames of code compiled
+// with frame pointers preserved.
+int FramePointerBacktrace(void** frames, int maxFrames, int skipCount);
+
 #endif // RUNTIME_NAMES_H
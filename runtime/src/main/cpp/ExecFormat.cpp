@@ -18,6 +18,87 @@
 #include "ExecFormat.h"
 #include "Types.h"
 
+#include <stdint.h>
+#include <string.h>
+
+namespace {
+
+// Compact symbol table emitted at link time (see CompactSymbolTable.kt in the
+// compiler, enabled with -Xcompact-symbol-table). It survives stripping and
+// ships in a few hundred kilobytes even for large applications, so release
+// binaries - most notably iOS ones, which otherwise need dSYMs - can symbolize
+// their own Kotlin frames. The header is followed by three uint32_t arrays of
+// [count] elements (function start offsets sorted ascending, function sizes,
+// name offsets) and a NUL-separated name blob.
+//
+// All PC values are stored relative to codeStart, itself anchored to the
+// link-time address of AddressToSymbol: computing the anchor's displacement at
+// runtime cancels both the ASLR slide and any uniform shift introduced by the
+// relink that adds this table.
+struct CompactSymtabHeader {
+  uint32_t magic;             // kCompactSymtabMagic, 0 in the weak default.
+  uint32_t version;
+  uint32_t count;
+  uint32_t namesSize;
+  uint64_t anchorLinkAddress; // Link-time address of AddressToSymbol.
+  int64_t codeStartDelta;     // codeStart - anchorLinkAddress.
+};
+
+constexpr uint32_t kCompactSymtabMagic = 0x4B53594D;  // "KSYM"
+
+}  // namespace
+
+// Weak default meaning "no table"; the link-time-generated object overrides it
+// with the real payload.
+extern "C" __attribute__((weak)) const CompactSymtabHeader Konan_compactSymtab = {};
+
+namespace {
+
+const char* compactSymtabLookup(const void* address) {
+  const CompactSymtabHeader* header = &Konan_compactSymtab;
+  if (header->magic != kCompactSymtabMagic || header->version != 1 || header->count == 0)
+    return nullptr;
+  auto* arrays = reinterpret_cast<const uint32_t*>(header + 1);
+  const uint32_t* starts = arrays;
+  const uint32_t* sizes = arrays + header->count;
+  const uint32_t* nameOffsets = arrays + 2 * static_cast<size_t>(header->count);
+  const char* names = reinterpret_cast<const char*>(arrays + 3 * static_cast<size_t>(header->count));
+
+  uintptr_t anchor = reinterpret_cast<uintptr_t>(&AddressToSymbol);
+  uintptr_t slide = anchor - static_cast<uintptr_t>(header->anchorLinkAddress);
+  uintptr_t codeStart = static_cast<uintptr_t>(header->anchorLinkAddress + header->codeStartDelta) + slide;
+  uintptr_t pc = reinterpret_cast<uintptr_t>(address);
+  if (pc < codeStart) return nullptr;
+  uintptr_t delta = pc - codeStart;
+  if (delta > 0xFFFFFFFFu) return nullptr;
+  uint32_t value = static_cast<uint32_t>(delta);
+
+  // Binary search for the last start <= value.
+  uint32_t lo = 0;
+  uint32_t hi = header->count;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (starts[mid] <= value) lo = mid + 1; else hi = mid;
+  }
+  if (lo == 0) return nullptr;
+  uint32_t index = lo - 1;
+  if (value - starts[index] >= sizes[index]) return nullptr;
+  if (nameOffsets[index] >= header->namesSize) return nullptr;
+  return names + nameOffsets[index];
+}
+
+// Copies a compact-table hit into the caller's buffer; false when the table is
+// absent or does not cover the address.
+bool compactSymtabResolve(const void* address, char* resultBuffer, size_t resultBufferSize) {
+  const char* name = compactSymtabLookup(address);
+  if (name == nullptr) return false;
+  strncpy(resultBuffer, name, resultBufferSize);
+  resultBuffer[resultBufferSize - 1] = '\0';
+  return true;
+}
+
+}  // namespace
+
 #if USE_ELF_SYMBOLS
 
 #include <dlfcn.h>
@@ -29,6 +110,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "KAssert.h"
@@ -51,15 +133,17 @@ namespace {
 #error "Impossible ELFSIZE"
 #endif
 
-struct SymRecord {
-  Elf_Sym* symtabBegin;
-  Elf_Sym* symtabEnd;
-  char* strtab;
+// A PC range covered by one symbol. The index is sorted by start address once,
+// so every lookup is a binary search instead of a table scan or a dladdr call.
+struct FunctionRange {
+  unsigned long start;
+  unsigned long end;
+  const char* name;
 };
 
-typedef KStdVector<SymRecord> SymRecordList;
+typedef KStdVector<FunctionRange> FunctionIndex;
 
-SymRecordList* symbols = nullptr;
+FunctionIndex* functionIndex = nullptr;
 
 // Unfortunately, symbol tables are stored in ELF sections not mapped
 // during regular execution, so we have to map binary ourselves.
@@ -74,64 +158,66 @@ Elf_Ehdr* findElfHeader() {
 }
 
 void initSymbols() {
-  RuntimeAssert(symbols == nullptr, "Init twice");
-  symbols = konanConstructInstance<SymRecordList>();
+  RuntimeAssert(functionIndex == nullptr, "Init twice");
+  functionIndex = konanConstructInstance<FunctionIndex>();
   Elf_Ehdr* ehdr = findElfHeader();
   if (ehdr == nullptr) return;
   RuntimeAssert(strncmp((const char*)ehdr->e_ident, ELFMAG, SELFMAG) == 0, "Must be an ELF");
   char* mapAddress = (char*)ehdr;
   Elf_Shdr* shdr = (Elf_Shdr*)(mapAddress + ehdr->e_shoff);
   for (int i = 0; i < ehdr->e_shnum; i++) {
-    if (shdr[i].sh_type == SHT_SYMTAB) {   // Static symbol table.
-      SymRecord record;
-      record.symtabBegin = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
-      record.symtabEnd = (Elf_Sym*)((char*)record.symtabBegin + shdr[i].sh_size);
-      record.strtab = (char *)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
-      symbols->push_back(record);
-    }
-    if (shdr[i].sh_type == SHT_DYNSYM) {   // Dynamic symbol table.
-      SymRecord record;
-      record.symtabBegin = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
-      record.symtabEnd = (Elf_Sym*)((char*)record.symtabBegin + shdr[i].sh_size);
-      record.strtab = (char*)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
-      symbols->push_back(record);
+    // Static and dynamic symbol tables.
+    if (shdr[i].sh_type != SHT_SYMTAB && shdr[i].sh_type != SHT_DYNSYM) continue;
+    Elf_Sym* sym = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
+    Elf_Sym* symEnd = (Elf_Sym*)((char*)sym + shdr[i].sh_size);
+    char* strtab = (char*)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
+    for (; sym < symEnd; sym++) {
+      if (sym->st_size == 0 || sym->st_name == 0) continue;
+      // st_value is load address adjusted.
+      FunctionRange range = {
+          (unsigned long)sym->st_value,
+          (unsigned long)(sym->st_value + sym->st_size),
+          &strtab[sym->st_name]};
+      functionIndex->push_back(range);
     }
   }
+  std::sort(functionIndex->begin(), functionIndex->end(),
+            [](const FunctionRange& a, const FunctionRange& b) { return a.start < b.start; });
 }
 
 const char* addressToSymbol(const void* address) {
   if (address == nullptr) return nullptr;
 
-  // First, look up in dynamically loaded symbols.
-  Dl_info info;
-  if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
-    return info.dli_sname;
-  }
-
-  // Otherwise, consult symbol table of the file.
-  if (symbols == nullptr) {
+  // Consult the sorted per-image index, built once on first symbolication.
+  if (functionIndex == nullptr) {
     initSymbols();
   }
 
   unsigned long addressValue = (unsigned long)address;
 
-  for (auto record : *symbols) {
-    auto begin = record.symtabBegin;
-    auto end = record.symtabEnd;
-    while (begin < end) {
-      // st_value is load address adjusted.
-      if (addressValue >= begin->st_value && addressValue < begin->st_value + begin->st_size) {
-        return &record.strtab[begin->st_name];
-      }
-      begin++;
+  auto it = std::upper_bound(
+      functionIndex->begin(), functionIndex->end(), addressValue,
+      [](unsigned long value, const FunctionRange& range) { return value < range.start; });
+  if (it != functionIndex->begin()) {
+    --it;
+    if (addressValue >= it->start && addressValue < it->end) {
+      return it->name;
     }
   }
+
+  // The index only covers the executable itself; ask the dynamic loader about
+  // addresses in shared libraries.
+  Dl_info info;
+  if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+    return info.dli_sname;
+  }
   return nullptr;
 }
 
 }  // namespace
 
 extern "C" bool AddressToSymbol(const void* address, char* resultBuffer, size_t resultBufferSize) {
+  if (compactSymtabResolve(address, resultBuffer, resultBufferSize)) return true;
   const char* result = addressToSymbol(address);
   if (result == nullptr) {
     return false;
@@ -312,6 +398,7 @@ SymbolTable* theExeSymbolTable = nullptr;
 }  // namespace
 
 extern "C" bool AddressToSymbol(const void* address, char* resultBuffer, size_t resultBufferSize) {
+  if (compactSymtabResolve(address, resultBuffer, resultBufferSize)) return true;
   if (theExeSymbolTable == nullptr) {
     // Note: do not protecting the lazy initialization by critical sections for simplicity;
     // this doesn't have any serious consequences.
@@ -326,8 +413,10 @@ extern "C" bool AddressToSymbol(const void* address, char* resultBuffer, size_t
 
 #else
 
+// No native symbol table to consult after stripping (notably Apple targets);
+// the compact table is the only source of names here.
 extern "C" bool AddressToSymbol(const void* address, char* resultBuffer, size_t resultBufferSize) {
-  return false;
+  return compactSymtabResolve(address, resultBuffer, resultBufferSize);
 }
 
 #endif // USE_ELF_SYMBOLS
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "Alloc.h"
+#include "Common.h"
+#include "KAssert.h"
+#include "Types.h"
+
+// Flat open-addressing hash table from 64-bit keys to 64-bit values, the
+// backing store of kotlin.native.internal.FlatLongMap. Keys and values live in
+// plain native arrays, so operations neither box nor touch reference counts.
+//
+// The layout follows the SwissTable scheme: a control byte per slot holds
+// either a sentinel (empty/deleted, high bit set) or the low 7 bits of the
+// key's hash, and lookups scan the control bytes a 16-wide group at a time -
+// with one SSE2 comparison per group where available - before touching the key
+// array at all, so almost all probe traffic stays within a couple of cache
+// lines of control bytes.
+
+namespace {
+
+constexpr uint8_t kCtrlEmpty = 0x80;
+constexpr uint8_t kCtrlDeleted = 0xFE;
+constexpr size_t kGroupWidth = 16;
+constexpr size_t kMinCapacity = 16;
+
+struct FlatLongMap {
+  // capacity + kGroupWidth bytes: the first kGroupWidth bytes are mirrored past
+  // the end, so a group load starting at any slot never needs to wrap.
+  uint8_t* ctrl;
+  KLong* keys;
+  KLong* values;
+  size_t capacity;  // Power of two.
+  size_t size;      // Live entries.
+  size_t used;      // Live entries plus deleted slots; drives rehashing.
+};
+
+// Finalization step of MurmurHash3 for 64-bit values: full avalanche, so
+// sequential keys spread over both the group index and the control tag.
+inline uint64_t mixHash(KLong key) {
+  uint64_t h = static_cast<uint64_t>(key);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// The 7 hash bits stored in the control byte; the rest pick the start group.
+inline uint8_t ctrlTag(uint64_t hash) { return hash & 0x7f; }
+
+inline void setCtrl(FlatLongMap* map, size_t slot, uint8_t value) {
+  map->ctrl[slot] = value;
+  if (slot < kGroupWidth) map->ctrl[map->capacity + slot] = value;
+}
+
+void allocateStorage(FlatLongMap* map, size_t capacity) {
+  map->capacity = capacity;
+  map->size = 0;
+  map->used = 0;
+  map->ctrl = konanAllocArray<uint8_t>(capacity + kGroupWidth);
+  memset(map->ctrl, kCtrlEmpty, capacity + kGroupWidth);
+  map->keys = konanAllocArray<KLong>(capacity);
+  map->values = konanAllocArray<KLong>(capacity);
+}
+
+void freeStorage(FlatLongMap* map) {
+  konanFreeMemory(map->ctrl);
+  konanFreeMemory(map->keys);
+  konanFreeMemory(map->values);
+}
+
+// Slot of [key], or -1. Keys always occupy a slot before the first empty one of
+// their probe sequence, so the scan stops at the first empty control byte.
+intptr_t findSlot(const FlatLongMap* map, KLong key, uint64_t hash) {
+  size_t mask = map->capacity - 1;
+  size_t index = (hash >> 7) & mask;
+  uint8_t tag = ctrlTag(hash);
+  while (true) {
+#if defined(__SSE2__)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(map->ctrl + index));
+    int match = _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag))));
+    while (match != 0) {
+      size_t slot = (index + __builtin_ctz(match)) & mask;
+      if (map->keys[slot] == key) return slot;
+      match &= match - 1;
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(kCtrlEmpty)))) != 0)
+      return -1;
+#else
+    for (size_t offset = 0; offset < kGroupWidth; offset++) {
+      uint8_t ctrl = map->ctrl[index + offset];
+      if (ctrl == tag) {
+        size_t slot = (index + offset) & mask;
+        if (map->keys[slot] == key) return slot;
+      } else if (ctrl == kCtrlEmpty) {
+        return -1;
+      }
+    }
+#endif
+    index = (index + kGroupWidth) & mask;
+  }
+}
+
+// First reusable (empty or deleted) slot of the probe sequence of [hash].
+size_t findInsertSlot(const FlatLongMap* map, uint64_t hash) {
+  size_t mask = map->capacity - 1;
+  size_t index = (hash >> 7) & mask;
+  while (true) {
+#if defined(__SSE2__)
+    // Sentinels are exactly the bytes with the high bit set.
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(map->ctrl + index));
+    int free = _mm_movemask_epi8(group);
+    if (free != 0) return (index + __builtin_ctz(free)) & mask;
+#else
+    for (size_t offset = 0; offset < kGroupWidth; offset++) {
+      if (map->ctrl[index + offset] & 0x80) return (index + offset) & mask;
+    }
+#endif
+    index = (index + kGroupWidth) & mask;
+  }
+}
+
+void insertNoResize(FlatLongMap* map, KLong key, KLong value, uint64_t hash) {
+  size_t slot = findInsertSlot(map, hash);
+  if (map->ctrl[slot] == kCtrlEmpty) map->used++;
+  setCtrl(map, slot, ctrlTag(hash));
+  map->keys[slot] = key;
+  map->values[slot] = value;
+  map->size++;
+}
+
+void rehash(FlatLongMap* map, size_t newCapacity) {
+  FlatLongMap old = *map;
+  allocateStorage(map, newCapacity);
+  for (size_t slot = 0; slot < old.capacity; slot++) {
+    if ((old.ctrl[slot] & 0x80) == 0)
+      insertNoResize(map, old.keys[slot], old.values[slot], mixHash(old.keys[slot]));
+  }
+  freeStorage(&old);
+}
+
+inline FlatLongMap* asMap(KNativePtr pointer) {
+  RuntimeAssert(pointer != nullptr, "Uninitialized or disposed FlatLongMap");
+  return reinterpret_cast<FlatLongMap*>(pointer);
+}
+
+}  // namespace
+
+extern "C" {
+
+KNativePtr Kotlin_FlatLongMap_create(KInt initialCapacity) {
+  size_t capacity = kMinCapacity;
+  // Size for the load factor up front, so warm-up does not rehash.
+  while (capacity * 7 / 8 < static_cast<size_t>(initialCapacity)) capacity *= 2;
+  FlatLongMap* map = konanConstructInstance<FlatLongMap>();
+  allocateStorage(map, capacity);
+  return map;
+}
+
+void Kotlin_FlatLongMap_dispose(KNativePtr pointer) {
+  FlatLongMap* map = asMap(pointer);
+  freeStorage(map);
+  konanDestructInstance(map);
+}
+
+KInt Kotlin_FlatLongMap_size(KNativePtr pointer) {
+  return asMap(pointer)->size;
+}
+
+KBoolean Kotlin_FlatLongMap_put(KNativePtr pointer, KLong key, KLong value) {
+  FlatLongMap* map = asMap(pointer);
+  uint64_t hash = mixHash(key);
+  intptr_t existing = findSlot(map, key, hash);
+  if (existing >= 0) {
+    map->values[existing] = value;
+    return false;
+  }
+  // Keep at least a group's worth of empty slots, so probe sequences terminate.
+  if (map->used >= map->capacity * 7 / 8) rehash(map, map->capacity * 2);
+  insertNoResize(map, key, value, hash);
+  return true;
+}
+
+KLong Kotlin_FlatLongMap_get(KNativePtr pointer, KLong key, KLong defaultValue) {
+  FlatLongMap* map = asMap(pointer);
+  intptr_t slot = findSlot(map, key, mixHash(key));
+  return slot >= 0 ? map->values[slot] : defaultValue;
+}
+
+KBoolean Kotlin_FlatLongMap_contains(KNativePtr pointer, KLong key) {
+  FlatLongMap* map = asMap(pointer);
+  return findSlot(map, key, mixHash(key)) >= 0;
+}
+
+KBoolean Kotlin_FlatLongMap_remove(KNativePtr pointer, KLong key) {
+  FlatLongMap* map = asMap(pointer);
+  intptr_t slot = findSlot(map, key, mixHash(key));
+  if (slot < 0) return false;
+  // The slot stays a tombstone until the next rehash: turning it back into
+  // empty would cut probe sequences passing through it short.
+  setCtrl(map, slot, kCtrlDeleted);
+  map->size--;
+  return true;
+}
+
+void Kotlin_FlatLongMap_clear(KNativePtr pointer) {
+  FlatLongMap* map = asMap(pointer);
+  memset(map->ctrl, kCtrlEmpty, map->capacity + kGroupWidth);
+  map->size = 0;
+  map->used = 0;
+}
+
+}  // extern "C"
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Format.h"
+
+#include <string.h>
+
+namespace konan {
+
+namespace {
+
+// Pairs of decimal digits "00".."99", so the radix-10 loops below emit two
+// digits per division instead of going through konan::snprintf.
+const char kTwoDigits[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+}  // namespace
+
+char* formatDecimalDigits(uint64_t value, char* end) {
+  char* pos = end;
+  while (value >= 100) {
+    const uint32_t index = static_cast<uint32_t>(value % 100) * 2;
+    value /= 100;
+    *--pos = kTwoDigits[index + 1];
+    *--pos = kTwoDigits[index];
+  }
+  if (value >= 10) {
+    const uint32_t index = static_cast<uint32_t>(value) * 2;
+    *--pos = kTwoDigits[index + 1];
+    *--pos = kTwoDigits[index];
+  } else {
+    *--pos = '0' + static_cast<char>(value);
+  }
+  return pos;
+}
+
+FormatBuffer& FormatBuffer::appendBytes(const char* bytes, size_t count) {
+  if (size_ == 0) return *this;
+  size_t room = size_ - 1 - position_;
+  if (count > room) count = room;
+  ::memcpy(buffer_ + position_, bytes, count);
+  position_ += count;
+  buffer_[position_] = '\0';
+  return *this;
+}
+
+FormatBuffer& FormatBuffer::append(const char* string) {
+  if (string == nullptr) return append("<null>");
+  return appendBytes(string, ::strlen(string));
+}
+
+FormatBuffer& FormatBuffer::append(char value) {
+  return appendBytes(&value, 1);
+}
+
+FormatBuffer& FormatBuffer::append(int64_t value) {
+  // Negate in unsigned arithmetic so that the minimum value does not overflow.
+  const uint64_t magnitude =
+      value < 0 ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* begin = formatDecimalDigits(magnitude, end);
+  if (value < 0) *--begin = '-';
+  return appendBytes(begin, end - begin);
+}
+
+FormatBuffer& FormatBuffer::append(uint64_t value) {
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* begin = formatDecimalDigits(value, end);
+  return appendBytes(begin, end - begin);
+}
+
+FormatBuffer& FormatBuffer::appendHex(uint64_t value) {
+  char digits[16];
+  char* pos = digits + sizeof(digits);
+  do {
+    uint32_t nibble = value & 0xf;
+    *--pos = nibble < 10 ? '0' + nibble : 'a' + (nibble - 10);
+    value >>= 4;
+  } while (value != 0);
+  return appendBytes(pos, digits + sizeof(digits) - pos);
+}
+
+}  // namespace konan
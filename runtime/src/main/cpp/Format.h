@@ -0,0 +1,51 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_FORMAT_H
+#define RUNTIME_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace konan {
+
+// Writes the decimal digits of value immediately before end and returns a
+// pointer to the first digit written. Emits two digits per division.
+char* formatDecimalDigits(uint64_t value, char* end);
+
+// Typed formatting into a caller-supplied buffer. Each value type has its own
+// overload resolved at compile time, so nothing parses a format string at
+// runtime; konan::snprintf stays for genuinely dynamic formats such as
+// precision-controlled floats. Appends never overflow: output is truncated if
+// the buffer runs out and is always NUL-terminated.
+class FormatBuffer {
+ public:
+  FormatBuffer(char* buffer, size_t size) : buffer_(buffer), size_(size), position_(0) {
+    if (size_ != 0) buffer_[0] = '\0';
+  }
+
+  FormatBuffer& append(const char* string);
+  FormatBuffer& append(char value);
+  FormatBuffer& append(int64_t value);
+  FormatBuffer& append(uint64_t value);
+  FormatBuffer& append(int32_t value) { return append(static_cast<int64_t>(value)); }
+  FormatBuffer& append(uint32_t value) { return append(static_cast<uint64_t>(value)); }
+  FormatBuffer& appendHex(uint64_t value);
+
+  const char* data() const { return buffer_; }
+  // Length of the formatted output, not counting the terminating NUL.
+  size_t size() const { return position_; }
+
+ private:
+  FormatBuffer& appendBytes(const char* bytes, size_t count);
+
+  char* buffer_;
+  size_t size_;
+  size_t position_;
+};
+
+}  // namespace konan
+
+#endif  // RUNTIME_FORMAT_H
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "GCLog.h"
+
+#ifndef KONAN_NO_THREADS
+#include <pthread.h>
+#include "PthreadUtils.h"
+#endif
+
+#include "Atomic.h"
+#include "Format.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Porting.h"
+
+namespace {
+
+// Power of two, so a sequence number maps to its slot with a mask.
+constexpr KInt kLogCapacity = 1024;
+// Longs per event in the flat snapshot handed out to Kotlin.
+constexpr KInt kEventLongs = 7;
+
+struct LogSlot {
+  // The claimed sequence number while the payload is consistent, -1 while it
+  // is being written. Readers reject a slot whose sequence does not match the
+  // one they expect both before and after copying the payload.
+  volatile KLong sequence;
+  GCLogEvent event;
+};
+
+int32_t g_enabled = 0;
+KLong g_nextSequence = 0;
+LogSlot g_slots[kLogCapacity];
+
+#ifndef KONAN_NO_THREADS
+
+int32_t g_writerStarted = 0;
+KLong g_writerPeriodMicros = 0;
+
+const char* phaseName(KInt phase) {
+  switch (phase) {
+    case GCLOG_PHASE_TOTAL: return "total";
+    case GCLOG_PHASE_PROCESS_DECREMENTS: return "decrements";
+    case GCLOG_PHASE_DECREMENT_STACK: return "stack";
+    case GCLOG_PHASE_FINALIZERS: return "finalizers";
+    case GCLOG_PHASE_COLLECT_CYCLES: return "cycles";
+    default: return "unknown";
+  }
+}
+
+void* writerRoutine(void*) {
+  // Never signalled: the timed wait below is just a portable periodic sleep.
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  pthread_mutex_init(&lock, nullptr);
+  pthread_cond_init(&cond, nullptr);
+  KStdVector<GCLogEvent> events(kLogCapacity);
+  KLong lastPrinted = 0;
+  while (true) {
+    pthread_mutex_lock(&lock);
+    WaitOnCondVar(&cond, &lock, static_cast<uint64_t>(g_writerPeriodMicros) * 1000ULL);
+    pthread_mutex_unlock(&lock);
+    KInt count = GCLogSnapshot(events.data(), kLogCapacity);
+    for (KInt i = 0; i < count; i++) {
+      const GCLogEvent& event = events[i];
+      if (event.sequence <= lastPrinted) continue;
+      char line[256];
+      if (lastPrinted != 0 && event.sequence != lastPrinted + 1) {
+        konan::FormatBuffer out(line, sizeof(line));
+        out.append("[gc] ").append(event.sequence - lastPrinted - 1)
+           .append(" events overwritten before they were written out\n");
+        konan::consoleWriteUtf8(out.data(), out.size());
+      }
+      konan::FormatBuffer out(line, sizeof(line));
+      out.append("[gc] #").append(event.sequence)
+         .append(" epoch ").append(event.epoque)
+         .append(' ').append(phaseName(event.phase))
+         .append(": start ").append(event.startMicros)
+         .append(" us, took ").append(event.durationMicros)
+         .append(" us, freed ").append(event.objectsFreed)
+         .append(", detail ").append(event.detail).append('\n');
+      konan::consoleWriteUtf8(out.data(), out.size());
+      lastPrinted = event.sequence;
+    }
+  }
+  return nullptr;
+}
+
+#endif  // !KONAN_NO_THREADS
+
+}  // namespace
+
+extern "C" {
+
+bool GCLogEnabled() {
+  return atomicGet(&g_enabled) != 0;
+}
+
+void GCLogSetEnabled(bool enabled) {
+  atomicSet(&g_enabled, enabled ? 1 : 0);
+}
+
+void GCLogRecord(KInt phase, KInt epoque, KLong startMicros, KLong durationMicros,
+                 KLong objectsFreed, KLong detail) {
+  if (atomicGet(&g_enabled) == 0) return;
+  KLong sequence = atomicAdd(&g_nextSequence, KLong(1));
+  LogSlot* slot = &g_slots[(sequence - 1) & (kLogCapacity - 1)];
+  atomicSet(&slot->sequence, KLong(-1));
+  slot->event.phase = phase;
+  slot->event.epoque = epoque;
+  slot->event.startMicros = startMicros;
+  slot->event.durationMicros = durationMicros;
+  slot->event.objectsFreed = objectsFreed;
+  slot->event.detail = detail;
+  atomicSet(&slot->sequence, sequence);
+}
+
+KInt GCLogSnapshot(GCLogEvent* out, KInt capacity) {
+  KLong newest = atomicGet(&g_nextSequence);
+  if (newest == 0 || capacity <= 0) return 0;
+  KLong window = capacity < kLogCapacity ? capacity : kLogCapacity;
+  KLong first = newest - window + 1;
+  if (first < 1) first = 1;
+  KInt count = 0;
+  for (KLong sequence = first; sequence <= newest; ++sequence) {
+    LogSlot* slot = &g_slots[(sequence - 1) & (kLogCapacity - 1)];
+    if (atomicGet(&slot->sequence) != sequence) continue;
+    GCLogEvent copy = slot->event;
+    // Reread after copying: an unchanged sequence means the payload was stable.
+    if (atomicGet(&slot->sequence) != sequence) continue;
+    copy.sequence = sequence;
+    out[count++] = copy;
+  }
+  return count;
+}
+
+bool GCLogStartWriter(KLong periodMicros) {
+#ifdef KONAN_NO_THREADS
+  return false;
+#else
+  if (periodMicros <= 0) return false;
+  if (!compareAndSet(&g_writerStarted, 0, 1)) return false;
+  g_writerPeriodMicros = periodMicros;
+  pthread_t thread;
+  pthread_create(&thread, nullptr, writerRoutine, nullptr);
+  return true;
+#endif
+}
+
+KBoolean Kotlin_native_internal_GC_getLogging(KRef) {
+  return GCLogEnabled();
+}
+
+void Kotlin_native_internal_GC_setLogging(KRef, KBoolean value) {
+  GCLogSetEnabled(value);
+}
+
+OBJ_GETTER(Kotlin_native_internal_GC_logSnapshot, KRef) {
+  KStdVector<GCLogEvent> events(kLogCapacity);
+  KInt count = GCLogSnapshot(events.data(), kLogCapacity);
+  ObjHolder resultHolder;
+  ObjHeader* result =
+      AllocArrayInstance(theLongArrayTypeInfo, count * kEventLongs, resultHolder.slot());
+  for (KInt i = 0; i < count; i++) {
+    KLong* element = PrimitiveArrayAddressOfElementAt<KLong>(result->array(), i * kEventLongs);
+    element[0] = events[i].sequence;
+    element[1] = events[i].phase;
+    element[2] = events[i].epoque;
+    element[3] = events[i].startMicros;
+    element[4] = events[i].durationMicros;
+    element[5] = events[i].objectsFreed;
+    element[6] = events[i].detail;
+  }
+  RETURN_OBJ(result);
+}
+
+KBoolean Kotlin_native_internal_GC_startLogWriter(KRef, KLong periodMicros) {
+  return GCLogStartWriter(periodMicros);
+}
+
+}  // extern "C"
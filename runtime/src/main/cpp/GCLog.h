@@ -0,0 +1,60 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_GCLOG_H
+#define RUNTIME_GCLOG_H
+
+#include "Common.h"
+#include "Types.h"
+
+// Phases recorded by the GC event log. TOTAL covers a whole collection, the
+// other phases partition it; each memory manager decides which it reports.
+enum GCLogPhase {
+  GCLOG_PHASE_TOTAL = 0,
+  GCLOG_PHASE_PROCESS_DECREMENTS = 1,
+  GCLOG_PHASE_DECREMENT_STACK = 2,
+  GCLOG_PHASE_FINALIZERS = 3,
+  GCLOG_PHASE_COLLECT_CYCLES = 4,
+};
+
+// One structured GC log record. [detail] is phase-specific: queue depth for
+// the reference counting phases, stack reference count for stack decrements,
+// cycle candidate count for cycle collection, and bytes allocated since the
+// previous collection for TOTAL.
+struct GCLogEvent {
+  KLong sequence;
+  KInt phase;
+  KInt epoque;
+  KLong startMicros;
+  KLong durationMicros;
+  KLong objectsFreed;
+  KLong detail;
+};
+
+extern "C" {
+
+// Whether events are recorded; the recording call sites check this first, so a
+// disabled log costs one load per potential event.
+bool GCLogEnabled();
+void GCLogSetEnabled(bool enabled);
+
+// Appends one event. Thread-safe and lock-free: a writer claims its slot with
+// a single atomic increment, and the oldest events are overwritten.
+void GCLogRecord(KInt phase, KInt epoque, KLong startMicros, KLong durationMicros,
+                 KLong objectsFreed, KLong detail);
+
+// Copies up to [capacity] most recent events into [out], oldest first, and
+// returns how many were copied. Events overwritten or still being written
+// while the snapshot runs are skipped.
+KInt GCLogSnapshot(GCLogEvent* out, KInt capacity);
+
+// Starts the optional writer thread printing every recorded event to the
+// console as a single line, draining the ring every [periodMicros]. Returns
+// false if a writer already runs or threads are not available.
+bool GCLogStartWriter(KLong periodMicros);
+
+}  // extern "C"
+
+#endif  // RUNTIME_GCLOG_H
@@ -26,19 +26,19 @@
 extern "C" {
 
 KNativePtr Kotlin_Interop_createStablePointer(KRef any) {
-  KRefSharedHolder* holder = konanConstructInstance<KRefSharedHolder>();
+  KRefSharedHolder* holder = AllocKRefSharedHolder();
   holder->init(any);
-  return holder;
+  return TagKRefSharedHolder(holder);
 }
 
 void Kotlin_Interop_disposeStablePointer(KNativePtr pointer) {
-  KRefSharedHolder* holder = reinterpret_cast<KRefSharedHolder*>(pointer);
+  KRefSharedHolder* holder = UntagKRefSharedHolder(pointer);
   holder->dispose();
-  konanDestructInstance(holder);
+  FreeKRefSharedHolder(holder);
 }
 
 OBJ_GETTER(Kotlin_Interop_derefStablePointer, KNativePtr pointer) {
-  KRefSharedHolder* holder = reinterpret_cast<KRefSharedHolder*>(pointer);
+  KRefSharedHolder* holder = UntagKRefSharedHolder(pointer);
   RETURN_OBJ(holder->ref<ErrorPolicy::kThrow>());
 }
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "Natives.h"
 #include "Porting.h"
 #include "Types.h"
 
@@ -21,6 +22,16 @@ typedef KInt Arena;
 typedef KInt Object;
 typedef KInt Pointer;
 
+extern "C" {
+
+// Address of the backing store of an IntArray, so Kotlin code can build
+// linear-memory command buffers that the JS side decodes in one pass.
+const KInt* Kotlin_JSInterop_intArrayPointer(KRef buffer) {
+  return PrimitiveArrayAddressOfElementAt<KInt>(buffer->array(), 0);
+}
+
+}; // extern "C"
+
 #ifndef KONAN_WASM
 
 extern "C" {
@@ -76,6 +87,11 @@ RUNTIME_NORETURN void Konan_js_setString(Arena arena,
   konan::abort();
 }
 
+RUNTIME_NORETURN void Konan_js_dispatchBatch(Pointer commandsPtr, KInt commandCount) {
+  RuntimeAssert(false, "JavaScript interop is disabled");
+  konan::abort();
+}
+
 }; // extern "C"
 
 #endif // #ifndef KONAN_WASM
@@ -15,15 +15,16 @@
  */
 
 #include "KAssert.h"
+#include "Format.h"
 #include "Porting.h"
 
 void RuntimeAssertFailed(const char* location, const char* message) {
   // TODO: produce stacktrace and such.
   char buf[1024];
+  konan::FormatBuffer out(buf, sizeof(buf));
   if (location != nullptr)
-      konan::snprintf(buf, sizeof(buf), "%s: runtime assert: %s\n", location, message);
-  else
-      konan::snprintf(buf, sizeof(buf), "runtime assert: %s\n", message);
-  konan::consoleErrorUtf8(buf, konan::strnlen(buf, sizeof(buf)));
+      out.append(location).append(": ");
+  out.append("runtime assert: ").append(message).append('\n');
+  konan::consoleErrorUtf8(out.data(), out.size());
   konan::abort();
 }
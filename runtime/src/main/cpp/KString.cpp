@@ -17,6 +17,8 @@
 #include <limits>
 #include <string.h>
 
+#include "Alloc.h"
+#include "Atomic.h"
 #include "KAssert.h"
 #include "City.h"
 #include "Exceptions.h"
@@ -24,16 +26,151 @@
 #include "Natives.h"
 #include "KString.h"
 #include "Porting.h"
+#include "RuntimeCounters.h"
 #include "Types.h"
 
 #include "utf8.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace {
 
 typedef std::back_insert_iterator<KStdString> KStdStringInserter;
+
+// All string instances are born here, so this is where they are counted.
+// The char area comes back uninitialized: every caller computes all [charCount]
+// chars before the string escapes, so zeroing it first would be pure overhead.
+ALWAYS_INLINE ArrayHeader* allocString(uint32_t charCount, ObjHeader** OBJ_RESULT) {
+  CounterIncrement(RTC_STRING_ALLOCS);
+  CounterAdd(RTC_STRING_CHARS, charCount);
+  return AllocArrayInstanceUninitialized(theStringTypeInfo, charCount, OBJ_RESULT)->array();
+}
 typedef KChar* utf8to16(const char*, const char*, KChar*);
 typedef KStdStringInserter utf16to8(const KChar*,const KChar*, KStdStringInserter);
 
+// Returns the number of leading bytes of [start, end) which are plain ASCII.
+// ASCII needs neither validation nor actual decoding, so such prefixes are probed
+// a vector (or machine word) at a time instead of the byte-by-byte library walk.
+size_t asciiPrefixLength(const char* start, const char* end) {
+  const char* p = start;
+#if defined(__SSE2__)
+  while (p + 16 <= end) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (_mm_movemask_epi8(chunk) != 0) break;
+    p += 16;
+  }
+#endif
+  while (p + 8 <= end) {
+    uint64_t word;
+    ::memcpy(&word, p, 8);
+    if ((word & 0x8080808080808080ULL) != 0) break;
+    p += 8;
+  }
+  while (p < end && (*p & 0x80) == 0) p++;
+  return p - start;
+}
+
+// Same as above for UTF-16 input: the number of leading chars representable as a single ASCII byte.
+size_t asciiPrefixLength(const KChar* start, const KChar* end) {
+  const KChar* p = start;
+#if defined(__SSE2__)
+  while (p + 8 <= end) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (_mm_movemask_epi8(_mm_cmpgt_epi16(chunk, _mm_set1_epi16(0x7F))) != 0 ||
+        _mm_movemask_epi8(_mm_cmplt_epi16(chunk, _mm_setzero_si128())) != 0)
+      break;
+    p += 8;
+  }
+#endif
+  while (p + 4 <= end) {
+    uint64_t word;
+    ::memcpy(&word, p, 8);
+    if ((word & 0xFF80FF80FF80FF80ULL) != 0) break;
+    p += 4;
+  }
+  while (p < end && *p < 0x80) p++;
+  return p - start;
+}
+
+constexpr uint64_t kSwarLaneHighBits = 0x8000800080008000ULL;
+
+constexpr uint64_t swarReplicate(uint16_t value) {
+  return value * 0x0001000100010001ULL;
+}
+
+// Per-lane mask (lane high bit set) of the chars falling into [first, last].
+// Only valid for words whose every lane is ASCII: then the additions cannot
+// carry across lanes.
+inline uint64_t swarRangeMask(uint64_t word, KChar first, KChar last) {
+  uint64_t atLeast = word + swarReplicate(0x8000 - first);
+  uint64_t above = word + swarReplicate(0x8000 - last - 1);
+  return (atLeast & ~above) & kSwarLaneHighBits;
+}
+
+#if defined(__SSE2__)
+inline __m128i sseCaseFlip(__m128i chunk, KChar first, KChar last) {
+  __m128i mask = _mm_and_si128(_mm_cmpgt_epi16(chunk, _mm_set1_epi16(first - 1)),
+                               _mm_cmplt_epi16(chunk, _mm_set1_epi16(last + 1)));
+  return _mm_xor_si128(chunk, _mm_and_si128(mask, _mm_set1_epi16(0x20)));
+}
+#endif
+
+// Case-flips an all-ASCII region a vector (or machine word) at a time: chars in
+// [first, last] get bit 0x20 toggled ('a'..'z' and 'A'..'Z' differ only in it),
+// the rest are copied through. Callers guarantee the region is ASCII.
+void flipAsciiCase(const KChar* from, KChar* to, size_t count, KChar first, KChar last) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 8 <= count; i += 8) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), sseCaseFlip(chunk, first, last));
+  }
+#endif
+  for (; i + 4 <= count; i += 4) {
+    uint64_t word;
+    ::memcpy(&word, from + i, 8);
+    // A lane mask bit at 0x8000 shifted down by 10 lands on the case bit 0x20.
+    word ^= swarRangeMask(word, first, last) >> 10;
+    ::memcpy(to + i, &word, 8);
+  }
+  for (; i < count; i++) {
+    KChar ch = from[i];
+    to[i] = (ch >= first && ch <= last) ? (ch ^ 0x20) : ch;
+  }
+}
+
+// Case-insensitive comparison of two all-ASCII regions, without materializing
+// lowercased copies: both sides are normalized lane-wise and compared in place.
+bool asciiRegionsEqualIgnoreCase(const KChar* a, const KChar* b, size_t count) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 8 <= count; i += 8) {
+    __m128i chunkA = sseCaseFlip(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), 'A', 'Z');
+    __m128i chunkB = sseCaseFlip(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), 'A', 'Z');
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(chunkA, chunkB)) != 0xFFFF) return false;
+  }
+#endif
+  for (; i + 4 <= count; i += 4) {
+    uint64_t wordA;
+    uint64_t wordB;
+    ::memcpy(&wordA, a + i, 8);
+    ::memcpy(&wordB, b + i, 8);
+    wordA ^= swarRangeMask(wordA, 'A', 'Z') >> 10;
+    wordB ^= swarRangeMask(wordB, 'A', 'Z') >> 10;
+    if (wordA != wordB) return false;
+  }
+  for (; i < count; i++) {
+    KChar chA = a[i];
+    KChar chB = b[i];
+    if (chA >= 'A' && chA <= 'Z') chA ^= 0x20;
+    if (chB >= 'A' && chB <= 'Z') chB ^= 0x20;
+    if (chA != chB) return false;
+  }
+  return true;
+}
+
 KStdStringInserter utf16toUtf8OrThrow(const KChar* start, const KChar* end, KStdStringInserter result) {
   TRY_CATCH(result = utf8::utf16to8(start, end, result),
             result = utf8::unchecked::utf16to8(start, end, result),
@@ -44,9 +181,12 @@ KStdStringInserter utf16toUtf8OrThrow(const KChar* start, const KChar* end, KStd
 template<utf8to16 conversion>
 OBJ_GETTER(utf8ToUtf16Impl, const char* rawString, const char* end, uint32_t charCount) {
   if (rawString == nullptr) RETURN_OBJ(nullptr);
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, charCount, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(charCount, OBJ_RESULT);
   KChar* rawResult = CharArrayAddressOfElementAt(result, 0);
-  conversion(rawString, end, rawResult);
+  size_t asciiPrefix = asciiPrefixLength(rawString, end);
+  for (size_t i = 0; i < asciiPrefix; i++)
+    rawResult[i] = static_cast<KChar>(rawString[i]);
+  conversion(rawString + asciiPrefix, end, rawResult + asciiPrefix);
   RETURN_OBJ(result->obj());
 }
 
@@ -54,6 +194,14 @@ template<utf16to8 conversion>
 OBJ_GETTER(unsafeUtf16ToUtf8Impl, KString thiz, KInt start, KInt size) {
   RuntimeAssert(thiz->type_info() == theStringTypeInfo, "Must use String");
   const KChar* utf16 = CharArrayAddressOfElementAt(thiz, start);
+  if (asciiPrefixLength(utf16, utf16 + size) == static_cast<size_t>(size)) {
+    // Pure ASCII: narrow directly into the result, no intermediate buffer needed.
+    ArrayHeader* result = AllocArrayInstance(theByteArrayTypeInfo, size, OBJ_RESULT)->array();
+    KByte* rawResult = ByteArrayAddressOfElementAt(result, 0);
+    for (KInt i = 0; i < size; i++)
+      rawResult[i] = static_cast<KByte>(utf16[i]);
+    RETURN_OBJ(result->obj());
+  }
   KStdString utf8;
   utf8.reserve(size);
   conversion(utf16, utf16 + size, back_inserter(utf8));
@@ -64,16 +212,19 @@ OBJ_GETTER(unsafeUtf16ToUtf8Impl, KString thiz, KInt start, KInt size) {
 
 OBJ_GETTER(utf8ToUtf16OrThrow, const char* rawString, size_t rawStringLength) {
   const char* end = rawString + rawStringLength;
-  uint32_t charCount;
-  TRY_CATCH(charCount = utf8::utf16_length(rawString, end),
-            charCount = utf8::unchecked::utf16_length(rawString, end),
+  const char* tail = rawString + asciiPrefixLength(rawString, end);
+  uint32_t tailCharCount;
+  TRY_CATCH(tailCharCount = utf8::utf16_length(tail, end),
+            tailCharCount = utf8::unchecked::utf16_length(tail, end),
             ThrowCharacterCodingException());
+  uint32_t charCount = (tail - rawString) + tailCharCount;
   RETURN_RESULT_OF(utf8ToUtf16Impl<utf8::unchecked::utf8to16>, rawString, end, charCount);
 }
 
 OBJ_GETTER(utf8ToUtf16, const char* rawString, size_t rawStringLength) {
   const char* end = rawString + rawStringLength;
-  uint32_t charCount = utf8::with_replacement::utf16_length(rawString, end);
+  const char* tail = rawString + asciiPrefixLength(rawString, end);
+  uint32_t charCount = (tail - rawString) + utf8::with_replacement::utf16_length(tail, end);
   RETURN_RESULT_OF(utf8ToUtf16Impl<utf8::with_replacement::utf8to16>, rawString, end, charCount);
 }
 
@@ -571,7 +722,7 @@ KInt getType(KChar ch) {
   return UNASSIGNED;
 }
 
-KChar towupper_Konan(KChar ch) {
+KChar towupperSlow(KChar ch) {
   // Optimized case for ASCII.
   if ('a' <= ch && ch <= 'z') {
     return ch - ('a' - 'A');
@@ -602,7 +753,7 @@ KChar towupper_Konan(KChar ch) {
   return ch;
 }
 
-KChar towlower_Konan(KChar ch) {
+KChar towlowerSlow(KChar ch) {
   // Optimized case for ASCII.
   if ('A' <= ch && ch <= 'Z') {
     return ch + ('a' - 'A');
@@ -634,6 +785,96 @@ KChar towlower_Konan(KChar ch) {
   return ch;
 }
 
+// Case conversion as two dependent loads instead of a binary search over the range
+// keys above: a 256-way first level selects a 256-character block of deltas (the
+// conversion result minus the character, wrapping mod 2^16), the second level adds
+// the delta. Blocks where nothing converts all share the zero identity block, so a
+// table comes to a few kilobytes. Built once on first use from the range tables;
+// ignoreCase scanning then costs the same per character as case-sensitive scanning.
+constexpr KChar identityCaseBlock[256] = {};
+
+class CaseConversionTable {
+ public:
+  explicit CaseConversionTable(KChar (*slow)(KChar)) : slow_(slow) {
+    KChar deltas[256];
+    uint32_t converting = 0;
+    bool blockConverts[256];
+    for (uint32_t block = 0; block < 256; block++) {
+      blockConverts[block] = false;
+      for (uint32_t low = 0; low < 256; low++) {
+        KChar ch = static_cast<KChar>((block << 8) | low);
+        if (slow(ch) != ch) {
+          blockConverts[block] = true;
+          converting++;
+          break;
+        }
+      }
+    }
+    storage_ = reinterpret_cast<KChar*>(konan::calloc(converting * 256, sizeof(KChar)));
+    KChar* nextBlock = storage_;
+    for (uint32_t block = 0; block < 256; block++) {
+      if (!blockConverts[block]) {
+        blocks_[block] = identityCaseBlock;
+      } else if (storage_ == nullptr) {
+        // Allocation failure: convert() falls back to the binary search.
+        blocks_[block] = nullptr;
+      } else {
+        for (uint32_t low = 0; low < 256; low++) {
+          KChar ch = static_cast<KChar>((block << 8) | low);
+          deltas[low] = static_cast<KChar>(slow(ch) - ch);
+        }
+        ::memcpy(nextBlock, deltas, sizeof(deltas));
+        blocks_[block] = nextBlock;
+        nextBlock += 256;
+      }
+    }
+  }
+
+  ALWAYS_INLINE KChar convert(KChar ch) const {
+    const KChar* block = blocks_[ch >> 8];
+    if (block == nullptr) return slow_(ch);
+    return static_cast<KChar>(ch + block[ch & 0xFFu]);
+  }
+
+ private:
+  KChar (*slow_)(KChar);
+  const KChar* blocks_[256];
+  KChar* storage_;
+};
+
+int32_t caseTablesLock = 0;
+CaseConversionTable* uppercaseTable = nullptr;
+CaseConversionTable* lowercaseTable = nullptr;
+
+CaseConversionTable* caseTable(CaseConversionTable** slot, KChar (*slow)(KChar)) {
+  CaseConversionTable* table = atomicGet(slot);
+  if (table != nullptr) return table;
+  while (!compareAndSet(&caseTablesLock, 0, 1)) {}
+  table = *slot;
+  if (table == nullptr) {
+    table = konanConstructInstance<CaseConversionTable>(slow);
+    atomicSet(slot, table);
+  }
+  atomicSet(&caseTablesLock, 0);
+  return table;
+}
+
+KChar towupper_Konan(KChar ch) {
+  // ASCII stays out of the tables entirely.
+  if (ch < 0x80) {
+    return ('a' <= ch && ch <= 'z') ? ch - ('a' - 'A') : ch;
+  }
+  return caseTable(&uppercaseTable, &towupperSlow)->convert(ch);
+}
+
+KChar towlower_Konan(KChar ch) {
+  // ASCII stays out of the tables entirely.
+  if (ch < 0x80) {
+    return ('A' <= ch && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+  }
+  return caseTable(&lowercaseTable, &towlowerSlow)->convert(ch);
+}
+
 int iswdigit_Konan(KChar ch) {
   // Optimized case for ASCII.
   if ('0' <= ch && ch <= '9') {
@@ -700,6 +941,70 @@ int iswlower_Konan(KChar ch) {
   return getType(ch) == LOWERCASE_LETTER;
 }
 
+// Streaming UTF-8 decoding: carries the bytes of a codepoint split across
+// chunk boundaries, so readers can decode network frames as they arrive
+// instead of rebuffering a whole body for one shot through
+// Kotlin_ByteArray_unsafeStringFromUtf8. Invalid input becomes the
+// replacement character, matching the whole-buffer conversion.
+struct Utf8StreamDecoder {
+  // A stashed lead byte plus its valid trail bytes seen so far; at most a
+  // 4-byte sequence missing its last byte.
+  uint8_t pending[4];
+  int32_t pendingSize;
+};
+
+void utf16Append(KStdVector<KChar>& out, uint32_t cp) {
+  if (cp > 0xffff) {
+    out.push_back(static_cast<KChar>((cp >> 10) + utf8::internal::LEAD_OFFSET));
+    out.push_back(static_cast<KChar>((cp & 0x3ff) + utf8::internal::TRAIL_SURROGATE_MIN));
+  } else {
+    out.push_back(static_cast<KChar>(cp));
+  }
+}
+
+// Decodes whatever the stash holds as if it were the end of the input and
+// empties it.
+void utf8StreamDecodePending(Utf8StreamDecoder* decoder, KStdVector<KChar>& out) {
+  const uint8_t* it = decoder->pending;
+  const uint8_t* pendingEnd = decoder->pending + decoder->pendingSize;
+  while (it < pendingEnd)
+    utf16Append(out, utf8::with_replacement::next(it, pendingEnd,
+                                                  utf8::with_replacement::default_replacement));
+  decoder->pendingSize = 0;
+}
+
+void utf8StreamDecode(Utf8StreamDecoder* decoder, const uint8_t* data, int32_t size,
+                      KStdVector<KChar>& out) {
+  const uint8_t* pos = data;
+  const uint8_t* end = data + size;
+  if (decoder->pendingSize != 0) {
+    // Take trail bytes until the stashed sequence is complete. Only trails:
+    // anything else could start a new sequence and must stay in the chunk.
+    const int32_t expected = utf8::internal::sequence_length(decoder->pending);
+    while (decoder->pendingSize < expected && pos < end && utf8::internal::is_trail(*pos))
+      decoder->pending[decoder->pendingSize++] = *pos++;
+    if (decoder->pendingSize < expected && pos == end) return;  // Wait for more input.
+    // The stash is either complete or cannot continue; decode it in place.
+    // After the first codepoint (or replacement) any leftover stash bytes are
+    // trails, each its own replacement - just as whole-buffer decoding emits.
+    utf8StreamDecodePending(decoder, out);
+  }
+  while (pos < end) {
+    const uint8_t* probe = pos;
+    uint32_t unused = 0;
+    if (utf8::internal::validate_next(probe, end, unused) == utf8::internal::NOT_ENOUGH_ROOM) {
+      // Valid so far but cut off by the chunk boundary: stash the tail and let
+      // the next chunk complete it. Sequences that are already known invalid -
+      // bad trail, overlong, out of domain - decode right away instead, since
+      // more input cannot make them valid.
+      while (pos < end) decoder->pending[decoder->pendingSize++] = *pos++;
+      return;
+    }
+    utf16Append(out, utf8::with_replacement::next(pos, end,
+                                                  utf8::with_replacement::default_replacement));
+  }
+}
+
 } // namespace
 
 extern "C" {
@@ -712,6 +1017,72 @@ OBJ_GETTER(CreateStringFromUtf8, const char* utf8, uint32_t lengthBytes) {
   RETURN_RESULT_OF(utf8ToUtf16, utf8, lengthBytes);
 }
 
+namespace {
+
+// Intern table for strings repeatedly created from the same C data, see
+// CreateStringFromUtf8Interned. Guarded by a spinlock, values are frozen strings
+// kept alive forever via stable pointers. Bounded, so a pathological workload
+// degrades to the non-interned path instead of growing the table indefinitely.
+constexpr size_t kMaxInternedStrings = 8192;
+
+// std::hash has no specialization for strings with a custom allocator, hash the bytes
+// with the same CityHash the string hash code uses.
+struct InternTableHash {
+  size_t operator()(const KStdString& value) const {
+    return static_cast<size_t>(CityHash64(value.data(), value.size()));
+  }
+};
+
+using InternTableMap = std::unordered_map<KStdString, KNativePtr, InternTableHash,
+    std::equal_to<KStdString>, KonanAllocator<std::pair<const KStdString, KNativePtr>>>;
+
+int32_t internTableLock = 0;
+InternTableMap* internedStrings = nullptr;
+
+void lockInternTable() {
+  while (!compareAndSet(&internTableLock, 0, 1)) {}
+}
+
+void unlockInternTable() {
+  atomicSet(&internTableLock, 0);
+}
+
+}  // namespace
+
+OBJ_GETTER(CreateStringFromUtf8Interned, const char* utf8, uint32_t lengthBytes) {
+  if (utf8 == nullptr) RETURN_OBJ(nullptr);
+  KNativePtr interned = nullptr;
+  lockInternTable();
+  if (internedStrings != nullptr) {
+    auto it = internedStrings->find(KStdString(utf8, lengthBytes));
+    if (it != internedStrings->end())
+      interned = it->second;
+  }
+  unlockInternTable();
+  if (interned != nullptr) {
+    RETURN_RESULT_OF(DerefStablePointer, interned);
+  }
+  KRef result = utf8ToUtf16(utf8, lengthBytes, OBJ_RESULT);
+  // Interned strings are shared between whoever converts the same bytes, freeze
+  // to make that safe across threads.
+  FreezeSubgraph(result);
+  lockInternTable();
+  if (internedStrings == nullptr)
+    internedStrings = konanConstructInstance<InternTableMap>();
+  if (internedStrings->size() < kMaxInternedStrings) {
+    auto insertion = internedStrings->emplace(KStdString(utf8, lengthBytes), nullptr);
+    // Another thread could have published the same bytes in between, keep its entry.
+    if (insertion.second)
+      insertion.first->second = CreateStablePointer(result);
+  }
+  unlockInternTable();
+  return result;
+}
+
+OBJ_GETTER(CreateStringFromCStringInterned, const char* cstring) {
+  RETURN_RESULT_OF(CreateStringFromUtf8Interned, cstring, cstring ? strlen(cstring) : 0);
+}
+
 char* CreateCStringFromString(KConstRef kref) {
   if (kref == nullptr) return nullptr;
   KString kstring = kref->array();
@@ -731,7 +1102,7 @@ void DisposeCString(char* cstring) {
 // String.kt
 OBJ_GETTER(Kotlin_String_replace, KString thiz, KChar oldChar, KChar newChar, KBoolean ignoreCase) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(count, OBJ_RESULT);
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
   if (ignoreCase) {
@@ -756,12 +1127,21 @@ OBJ_GETTER(Kotlin_String_plusImpl, KString thiz, KString other) {
   RuntimeAssert(other->type_info() == theStringTypeInfo, "Must be a string");
   RuntimeAssert(thiz->count_ <= static_cast<uint32_t>(std::numeric_limits<int32_t>::max()), "this cannot be this large");
   RuntimeAssert(other->count_ <= static_cast<uint32_t>(std::numeric_limits<int32_t>::max()), "other cannot be this large");
+  // Concatenation with an empty operand needs no copy: strings are immutable,
+  // so the other operand can be returned as is. Repeated appends of short pieces
+  // hit this for the first piece and on empty separators/prefixes.
+  if (thiz->count_ == 0) {
+    RETURN_OBJ_ROOTED(const_cast<ObjHeader*>(other->obj()));
+  }
+  if (other->count_ == 0) {
+    RETURN_OBJ_ROOTED(const_cast<ObjHeader*>(thiz->obj()));
+  }
   // Since thiz and other sizes are bounded by int32_t max value, their sum cannot exceed uint32_t max value - 1.
   uint32_t result_length = thiz->count_ + other->count_;
   if (result_length > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
     ThrowArrayIndexOutOfBoundsException();
   }
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, result_length, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(result_length, OBJ_RESULT);
   memcpy(
       CharArrayAddressOfElementAt(result, 0),
       CharArrayAddressOfElementAt(thiz, 0),
@@ -775,22 +1155,38 @@ OBJ_GETTER(Kotlin_String_plusImpl, KString thiz, KString other) {
 
 OBJ_GETTER(Kotlin_String_toUpperCase, KString thiz) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(count, OBJ_RESULT);
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
-  for (uint32_t index = 0; index < count; ++index) {
-    *resultRaw++ = towupper_Konan(*thizRaw++);
+  // ASCII runs are case-flipped in bulk; only the rest goes through the
+  // Unicode mapping tables.
+  uint32_t index = 0;
+  while (index < count) {
+    size_t ascii = asciiPrefixLength(thizRaw + index, thizRaw + count);
+    flipAsciiCase(thizRaw + index, resultRaw + index, ascii, 'a', 'z');
+    index += ascii;
+    while (index < count && thizRaw[index] >= 0x80) {
+      resultRaw[index] = towupper_Konan(thizRaw[index]);
+      ++index;
+    }
   }
   RETURN_OBJ(result->obj());
 }
 
 OBJ_GETTER(Kotlin_String_toLowerCase, KString thiz) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(count, OBJ_RESULT);
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
-  for (uint32_t index = 0; index < count; ++index) {
-    *resultRaw++ = towlower_Konan(*thizRaw++);
+  uint32_t index = 0;
+  while (index < count) {
+    size_t ascii = asciiPrefixLength(thizRaw + index, thizRaw + count);
+    flipAsciiCase(thizRaw + index, resultRaw + index, ascii, 'A', 'Z');
+    index += ascii;
+    while (index < count && thizRaw[index] >= 0x80) {
+      resultRaw[index] = towlower_Konan(thizRaw[index]);
+      ++index;
+    }
   }
   RETURN_OBJ(result->obj());
 }
@@ -803,15 +1199,40 @@ OBJ_GETTER(Kotlin_String_unsafeStringFromCharArray, KConstRef thiz, KInt start,
     RETURN_RESULT_OF0(TheEmptyString);
   }
 
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, size, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(size, OBJ_RESULT);
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(array, start),
          size * sizeof(KChar));
   RETURN_OBJ(result->obj());
 }
 
+// Takes over a fully-used char array and re-tags it as a String without copying;
+// see StringBuilder.toString. String and CharArray share the ArrayHeader layout,
+// so only the type word changes, and the caller drops its own reference right
+// after the call, leaving the string as the single owner of the storage. Falls
+// back to copying when the re-tag could be observed: a shareable array may be
+// read concurrently, tag bits mean the object is not a plain heap one, and a
+// meta object pins the array's identity as a CharArray.
+OBJ_GETTER(Kotlin_String_unsafeStringHandoffCharArray, KRef thiz) {
+  ArrayHeader* array = thiz->array();
+  RuntimeAssert(array->type_info() == theCharArrayTypeInfo, "Must use a char array");
+
+  if (array->count_ == 0) {
+    RETURN_RESULT_OF0(TheEmptyString);
+  }
+
+  if (getPointerBits(thiz->typeInfoOrMeta_, OBJECT_TAG_MASK) == 0 &&
+      !thiz->has_meta_object() && !isShareable(thiz)) {
+    thiz->typeInfoOrMeta_ = const_cast<TypeInfo*>(theStringTypeInfo);
+    RETURN_OBJ(thiz);
+  }
+
+  RETURN_RESULT_OF(Kotlin_String_unsafeStringFromCharArray, thiz, 0, array->count_);
+}
+
 OBJ_GETTER(Kotlin_String_toCharArray, KString string, KInt start, KInt size) {
-  ArrayHeader* result = AllocArrayInstance(theCharArrayTypeInfo, size, OBJ_RESULT)->array();
+  // The copy below fills the whole array, so skip the allocator's zeroing.
+  ArrayHeader* result = AllocArrayInstanceUninitialized(theCharArrayTypeInfo, size, OBJ_RESULT)->array();
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(string, start),
          size * sizeof(KChar));
@@ -827,18 +1248,63 @@ OBJ_GETTER(Kotlin_String_subSequence, KString thiz, KInt startIndex, KInt endInd
     RETURN_RESULT_OF0(TheEmptyString);
   }
   KInt length = endIndex - startIndex;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  ArrayHeader* result = allocString(length, OBJ_RESULT);
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(thiz, startIndex),
          length * sizeof(KChar));
   RETURN_OBJ(result->obj());
 }
 
+namespace {
+
+// Lexicographic comparison of two equally long char sequences, 0 if they are
+// equal. Long common prefixes (sort keys, URLs) are skipped a vector or a
+// machine word at a time; the first differing char inside a chunk is then
+// located from the comparison mask instead of re-scanning. The difference
+// itself is compared as KChars: a byte-wise memcmp of UTF-16 payload would
+// order by the low byte first on little-endian targets.
+KInt compareCharPrefixes(const KChar* left, const KChar* right, uint32_t count) {
+  uint32_t index = 0;
+#if defined(__SSE2__)
+  for (; index + 8 <= count; index += 8) {
+    __m128i chunkLeft = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + index));
+    __m128i chunkRight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + index));
+    int equalMask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunkLeft, chunkRight));
+    if (equalMask != 0xFFFF) {
+      index += __builtin_ctz(~equalMask & 0xFFFF) / 2;
+      return static_cast<KInt>(left[index]) - static_cast<KInt>(right[index]);
+    }
+  }
+#endif
+#ifndef __BIG_ENDIAN__
+  for (; index + 4 <= count; index += 4) {
+    uint64_t wordLeft;
+    uint64_t wordRight;
+    ::memcpy(&wordLeft, left + index, sizeof(wordLeft));
+    ::memcpy(&wordRight, right + index, sizeof(wordRight));
+    if (wordLeft != wordRight) {
+      // Little-endian: the lowest addressed char sits in the least significant
+      // bits, so trailing zeros of the XOR give the first difference.
+      index += __builtin_ctzll(wordLeft ^ wordRight) / 16;
+      return static_cast<KInt>(left[index]) - static_cast<KInt>(right[index]);
+    }
+  }
+#endif
+  for (; index < count; index++) {
+    if (left[index] != right[index]) {
+      return static_cast<KInt>(left[index]) - static_cast<KInt>(right[index]);
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
 KInt Kotlin_String_compareTo(KString thiz, KString other) {
-  int result = memcmp(
-    CharArrayAddressOfElementAt(thiz, 0),
-    CharArrayAddressOfElementAt(other, 0),
-    (thiz->count_ < other->count_ ? thiz->count_ : other->count_) * sizeof(KChar));
+  KInt result = compareCharPrefixes(
+      CharArrayAddressOfElementAt(thiz, 0),
+      CharArrayAddressOfElementAt(other, 0),
+      thiz->count_ < other->count_ ? thiz->count_ : other->count_);
   if (result != 0) return result;
   int diff = thiz->count_ - other->count_;
   if (diff == 0) return 0;
@@ -908,6 +1374,47 @@ OBJ_GETTER(Kotlin_String_unsafeStringToUtf8, KString thiz, KInt start, KInt size
   RETURN_RESULT_OF(unsafeUtf16ToUtf8Impl<utf8::with_replacement::utf16to8>, thiz, start, size);
 }
 
+KNativePtr Kotlin_Utf8StreamDecoder_create() {
+  Utf8StreamDecoder* decoder = konanConstructInstance<Utf8StreamDecoder>();
+  decoder->pendingSize = 0;
+  return decoder;
+}
+
+void Kotlin_Utf8StreamDecoder_dispose(KNativePtr pointer) {
+  konanDestructInstance(reinterpret_cast<Utf8StreamDecoder*>(pointer));
+}
+
+OBJ_GETTER(Kotlin_Utf8StreamDecoder_decode, KNativePtr pointer, KConstRef chunk, KInt start, KInt size) {
+  auto* decoder = reinterpret_cast<Utf8StreamDecoder*>(pointer);
+  KStdVector<KChar> chars;
+  chars.reserve(size);
+  if (size != 0) {
+    const uint8_t* data =
+        reinterpret_cast<const uint8_t*>(unsafeByteArrayAsCString(chunk, start, size));
+    utf8StreamDecode(decoder, data, size, chars);
+  }
+  if (chars.empty()) {
+    RETURN_RESULT_OF0(TheEmptyString);
+  }
+  ArrayHeader* result = allocString(chars.size(), OBJ_RESULT);
+  ::memcpy(CharArrayAddressOfElementAt(result, 0), chars.data(), chars.size() * sizeof(KChar));
+  RETURN_OBJ(result->obj());
+}
+
+OBJ_GETTER(Kotlin_Utf8StreamDecoder_flush, KNativePtr pointer) {
+  auto* decoder = reinterpret_cast<Utf8StreamDecoder*>(pointer);
+  if (decoder->pendingSize == 0) {
+    RETURN_RESULT_OF0(TheEmptyString);
+  }
+  // End of input: the unfinished sequence decodes to replacement characters,
+  // as whole-buffer decoding would have emitted for a truncated tail.
+  KStdVector<KChar> chars;
+  utf8StreamDecodePending(decoder, chars);
+  ArrayHeader* result = allocString(chars.size(), OBJ_RESULT);
+  ::memcpy(CharArrayAddressOfElementAt(result, 0), chars.data(), chars.size() * sizeof(KChar));
+  RETURN_OBJ(result->obj());
+}
+
 OBJ_GETTER(Kotlin_String_unsafeStringToUtf8OrThrow, KString thiz, KInt start, KInt size) {
   RETURN_RESULT_OF(unsafeUtf16ToUtf8Impl<utf16toUtf8OrThrow>, thiz, start, size);
 }
@@ -922,19 +1429,58 @@ KInt Kotlin_StringBuilder_insertString(KRef builder, KInt distIndex, KString fro
   return count;
 }
 
-KInt Kotlin_StringBuilder_insertInt(KRef builder, KInt position, KInt value) {
+namespace {
+
+// Pairs of decimal digits "00".."99", emitting two digits per division - the
+// same scheme as the toString kernels in ToString.cpp, but writing UTF-16
+// units straight into the builder's backing array.
+const char kDecimalDigitPairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+KInt insertDecimal(KRef builder, KInt position, uint64_t magnitude, bool negative) {
   auto toArray = builder->array();
-  RuntimeAssert(toArray->count_ >= static_cast<uint32_t>(11 + position), "must be true");
-  char cstring[12];
-  auto length = konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RuntimeAssert(length >= 0, "This should never happen"); // may be overkill
-  RuntimeAssert(static_cast<size_t>(length) < sizeof(cstring), "Unexpectedly large value"); // Can't be, but this is what sNprintf for
-  auto* from = &cstring[0];
-  auto* to = CharArrayAddressOfElementAt(toArray, position);
-  while (*from) {
-    *to++ = *from++;
+  KChar buffer[24];
+  KChar* end = buffer + 24;
+  KChar* pos = end;
+  while (magnitude >= 100) {
+    const uint32_t index = static_cast<uint32_t>(magnitude % 100) * 2;
+    magnitude /= 100;
+    *--pos = kDecimalDigitPairs[index + 1];
+    *--pos = kDecimalDigitPairs[index];
+  }
+  if (magnitude >= 10) {
+    const uint32_t index = static_cast<uint32_t>(magnitude) * 2;
+    *--pos = kDecimalDigitPairs[index + 1];
+    *--pos = kDecimalDigitPairs[index];
+  } else {
+    *--pos = '0' + static_cast<KChar>(magnitude);
   }
-  return from - cstring;
+  if (negative) {
+    *--pos = '-';
+  }
+  const KInt length = end - pos;
+  RuntimeAssert(position >= 0 && static_cast<uint32_t>(position + length) <= toArray->count_, "must be true");
+  memcpy(CharArrayAddressOfElementAt(toArray, position), pos, length * sizeof(KChar));
+  return length;
+}
+
+}  // namespace
+
+KInt Kotlin_StringBuilder_insertInt(KRef builder, KInt position, KInt value) {
+  // Negate in unsigned arithmetic so that the minimum value does not overflow.
+  const uint64_t magnitude = value < 0 ?
+      ~static_cast<uint64_t>(static_cast<KLong>(value)) + 1 : static_cast<uint64_t>(value);
+  return insertDecimal(builder, position, magnitude, value < 0);
+}
+
+KInt Kotlin_StringBuilder_insertLong(KRef builder, KInt position, KLong value) {
+  const uint64_t magnitude = value < 0 ?
+      ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+  return insertDecimal(builder, position, magnitude, value < 0);
 }
 
 
@@ -943,10 +1489,16 @@ KBoolean Kotlin_String_equals(KString thiz, KConstRef other) {
   // Important, due to literal internalization.
   KString otherString = other->array();
   if (thiz == otherString) return true;
-  return thiz->count_ == otherString->count_ &&
-      memcmp(CharArrayAddressOfElementAt(thiz, 0),
-             CharArrayAddressOfElementAt(otherString, 0),
-             thiz->count_ * sizeof(KChar)) == 0;
+  auto count = thiz->count_;
+  if (count != otherString->count_) return false;
+  if (count == 0) return true;
+  const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
+  const KChar* otherRaw = CharArrayAddressOfElementAt(otherString, 0);
+  // Probe both ends first: equal-length unequal strings in sorted or keyed data mostly
+  // differ there, and this avoids the memcmp call overhead for them. The bulk
+  // comparison stays with memcmp, which is already vectorized by libc.
+  if (thizRaw[0] != otherRaw[0] || thizRaw[count - 1] != otherRaw[count - 1]) return false;
+  return memcmp(thizRaw, otherRaw, count * sizeof(KChar)) == 0;
 }
 
 KBoolean Kotlin_String_equalsIgnoreCase(KString thiz, KConstRef other) {
@@ -959,8 +1511,20 @@ KBoolean Kotlin_String_equalsIgnoreCase(KString thiz, KConstRef other) {
   auto count = thiz->count_;
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   const KChar* otherRaw = CharArrayAddressOfElementAt(otherString, 0);
-  for (uint32_t index = 0; index < count; ++index) {
-    if (towlower_Konan(*thizRaw++) != towlower_Konan(*otherRaw++)) return false;
+  // Stretches where both sides are ASCII are compared in bulk, normalized
+  // lane-wise instead of materializing lowercased copies; the Unicode mapping
+  // tables only see chars outside those stretches.
+  uint32_t index = 0;
+  while (index < count) {
+    size_t ascii = asciiPrefixLength(thizRaw + index, thizRaw + count);
+    size_t asciiOther = asciiPrefixLength(otherRaw + index, otherRaw + count);
+    if (asciiOther < ascii) ascii = asciiOther;
+    if (!asciiRegionsEqualIgnoreCase(thizRaw + index, otherRaw + index, ascii)) return false;
+    index += ascii;
+    while (index < count && (thizRaw[index] >= 0x80 || otherRaw[index] >= 0x80)) {
+      if (towlower_Konan(thizRaw[index]) != towlower_Konan(otherRaw[index])) return false;
+      ++index;
+    }
   }
   return true;
 }
@@ -1076,6 +1640,31 @@ KInt Kotlin_Char_digitOfChecked(KChar ch, KInt radix) {
   return result;
 }
 
+namespace {
+
+// Shared by the string and the char-array region entry points.
+KInt indexOfCharInRange(const KChar* data, KInt count, KChar ch) {
+  KInt index = 0;
+#if defined(__SSE2__)
+  // Compare eight UTF-16 units at a time; find/scan workloads spend most of their
+  // time here, so this is worth vectorizing like asciiPrefixLength above.
+  const __m128i pattern = _mm_set1_epi16(static_cast<int16_t>(ch));
+  while (index + 8 <= count) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, pattern));
+    if (mask != 0) return index + (__builtin_ctz(mask) >> 1);
+    index += 8;
+  }
+#endif
+  while (index < count) {
+    if (data[index] == ch) return index;
+    index++;
+  }
+  return -1;
+}
+
+}  // namespace
+
 KInt Kotlin_String_indexOfChar(KString thiz, KChar ch, KInt fromIndex) {
   if (fromIndex < 0) {
     fromIndex = 0;
@@ -1083,13 +1672,9 @@ KInt Kotlin_String_indexOfChar(KString thiz, KChar ch, KInt fromIndex) {
   if (static_cast<uint32_t>(fromIndex) > thiz->count_) {
     return -1;
   }
-  KInt count = thiz->count_;
-  const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, fromIndex);
-  while (fromIndex < count) {
-    if (*thizRaw++ == ch) return fromIndex;
-    fromIndex++;
-  }
-  return -1;
+  KInt result = indexOfCharInRange(
+      CharArrayAddressOfElementAt(thiz, fromIndex), thiz->count_ - fromIndex, ch);
+  return result < 0 ? -1 : fromIndex + result;
 }
 
 KInt Kotlin_String_lastIndexOfChar(KString thiz, KChar ch, KInt fromIndex) {
@@ -1108,7 +1693,212 @@ KInt Kotlin_String_lastIndexOfChar(KString thiz, KChar ch, KInt fromIndex) {
   return -1;
 }
 
-// TODO: or code up Knuth-Moris-Pratt.
+// Single-char split in one pass over the payload: the delimiters are located
+// with the vectorized char search above, the result array is allocated once
+// with the exact piece count and each piece gets exactly one allocation of
+// its exact size - no list growth, no re-copies. [limit] follows the stdlib
+// split() contract: a positive limit caps the number of pieces, with the
+// remainder (delimiters included) in the last one; 0 means no limit.
+OBJ_GETTER(Kotlin_String_splitByChar, KString thiz, KChar delimiter, KInt limit) {
+  const KChar* data = CharArrayAddressOfElementAt(thiz, 0);
+  KInt count = thiz->count_;
+  // First pass: count the pieces.
+  KInt pieces = 1;
+  KInt scanFrom = 0;
+  while (limit <= 0 || pieces < limit) {
+    KInt found = indexOfCharInRange(data + scanFrom, count - scanFrom, delimiter);
+    if (found < 0) break;
+    pieces++;
+    scanFrom = scanFrom + found + 1;
+  }
+  ObjHolder resultHolder;
+  ObjHeader* result = AllocArrayInstance(theArrayTypeInfo, pieces, resultHolder.slot());
+  // Second pass: cut the pieces out. The heap does not move objects, so [data]
+  // stays valid across the allocations.
+  KInt start = 0;
+  for (KInt piece = 0; piece < pieces; piece++) {
+    KInt end;
+    if (piece == pieces - 1) {
+      end = count;
+    } else {
+      end = start + indexOfCharInRange(data + start, count - start, delimiter);
+    }
+    ObjHolder pieceHolder;
+    Kotlin_String_subSequence(thiz, start, end, pieceHolder.slot());
+    UpdateHeapRef(ArrayAddressOfElementAt(result->array(), piece), pieceHolder.obj());
+    start = end + 1;
+  }
+  RETURN_OBJ(result);
+}
+
+namespace {
+
+// Two-Way (Crochemore-Perrin) matching state of a needle, as used by modern
+// memmem: guarantees linear search time in constant space, so pathological
+// needles cannot degrade to the quadratic behavior of the naive loop.
+struct TwoWayFactorization {
+  KInt cut;      // Length of the left factor of the critical factorization.
+  KInt period;   // Shift applied when the whole needle matched up to a left-factor mismatch.
+  bool periodic; // Whether the needle is periodic with [period].
+};
+
+// One order of the maximal-suffix computation; the critical factorization is
+// the later of the two orders' maximal suffixes.
+KInt maximalSuffix(const KChar* needle, KInt count, bool inverted, KInt* periodOut) {
+  KInt ms = -1;
+  KInt j = 0;
+  KInt k = 1;
+  KInt p = 1;
+  while (j + k < count) {
+    KChar a = needle[j + k];
+    KChar b = needle[ms + k];
+    bool ordered = inverted ? (a > b) : (a < b);
+    if (ordered) {
+      j += k;
+      k = 1;
+      p = j - ms;
+    } else if (a == b) {
+      if (k != p) {
+        ++k;
+      } else {
+        j += p;
+        k = 1;
+      }
+    } else {
+      ms = j;
+      j = ms + 1;
+      k = 1;
+      p = 1;
+    }
+  }
+  *periodOut = p;
+  return ms;
+}
+
+TwoWayFactorization factorizeNeedle(const KChar* needle, KInt count) {
+  KInt forwardPeriod;
+  KInt backwardPeriod;
+  KInt forward = maximalSuffix(needle, count, false, &forwardPeriod);
+  KInt backward = maximalSuffix(needle, count, true, &backwardPeriod);
+  TwoWayFactorization result;
+  if (forward >= backward) {
+    result.cut = forward + 1;
+    result.period = forwardPeriod;
+  } else {
+    result.cut = backward + 1;
+    result.period = backwardPeriod;
+  }
+  result.periodic = result.cut + result.period <= count &&
+      ::memcmp(needle, needle + result.period, result.cut * sizeof(KChar)) == 0;
+  if (!result.periodic) {
+    KInt right = count - result.cut;
+    result.period = (result.cut > right ? result.cut : right) + 1;
+  }
+  return result;
+}
+
+// Precompiled searchers for permanent needles: repeated searches with the same
+// literal (delimiter splitting and the like) reuse the factorization. Same
+// caching discipline as the hash cache of permanent strings below.
+constexpr int kStringSearcherCacheSize = 64;
+
+struct StringSearcherCacheEntry {
+  KString needle;
+  TwoWayFactorization factorization;
+};
+
+THREAD_LOCAL_VARIABLE StringSearcherCacheEntry stringSearcherCache[kStringSearcherCacheSize];
+
+TwoWayFactorization factorizationFor(KString other, const KChar* needle, KInt count) {
+  StringSearcherCacheEntry* entry = nullptr;
+  if (other->obj()->permanent()) {
+    entry = stringSearcherCache +
+        ((reinterpret_cast<uintptr_t>(other) >> 4) & (kStringSearcherCacheSize - 1));
+    if (entry->needle == other) return entry->factorization;
+  }
+  TwoWayFactorization result = factorizeNeedle(needle, count);
+  if (entry != nullptr) {
+    entry->needle = other;
+    entry->factorization = result;
+  }
+  return result;
+}
+
+KInt twoWaySearch(const KChar* hay, KInt hayCount, const KChar* needle, KInt needleCount,
+                  const TwoWayFactorization& factorization) {
+  KInt j = 0;
+  // Number of leading chars known to match after a periodic shift.
+  KInt memory = 0;
+  while (j <= hayCount - needleCount) {
+    KInt i = factorization.cut > memory ? factorization.cut : memory;
+    while (i < needleCount && needle[i] == hay[j + i]) ++i;
+    if (i >= needleCount) {
+      i = factorization.cut - 1;
+      while (i >= memory && needle[i] == hay[j + i]) --i;
+      if (i < memory) return j;
+      j += factorization.period;
+      memory = factorization.periodic ? needleCount - factorization.period : 0;
+    } else {
+      j += i - factorization.cut + 1;
+      memory = 0;
+    }
+  }
+  return -1;
+}
+
+// Sentinel of the filtered search below: not decided within the budget, the
+// caller continues with Two-Way from the handover position.
+constexpr KInt kSearchHandover = -2;
+
+#if defined(__SSE2__)
+// First/last-char filter as in modern memmem: a candidate position is where
+// both the first and the last needle char match, probed eight positions at a
+// time; candidates are verified with memcmp. A work budget proportional to the
+// haystack bounds the damage of needles with many false candidates.
+KInt filteredSearch(const KChar* hay, KInt hayCount, const KChar* needle, KInt needleCount,
+                    KInt* handoverPos) {
+  const __m128i first = _mm_set1_epi16(static_cast<int16_t>(needle[0]));
+  const __m128i last = _mm_set1_epi16(static_cast<int16_t>(needle[needleCount - 1]));
+  int64_t budget = 2 * static_cast<int64_t>(hayCount) + 64;
+  KInt lastStart = hayCount - needleCount;
+  KInt pos = 0;
+  while (pos + 7 <= lastStart) {
+    __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + pos));
+    __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + pos + needleCount - 1));
+    int mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi16(blockFirst, first), _mm_cmpeq_epi16(blockLast, last)));
+    while (mask != 0) {
+      KInt offset = __builtin_ctz(mask) >> 1;
+      if (::memcmp(hay + pos + offset + 1, needle + 1, (needleCount - 2) * sizeof(KChar)) == 0)
+        return pos + offset;
+      budget -= needleCount;
+      if (budget < 0) {
+        *handoverPos = pos;
+        return kSearchHandover;
+      }
+      // Each 16-bit lane owns two mask bits; drop both of the candidate's.
+      mask &= mask - 1;
+      mask &= mask - 1;
+    }
+    budget -= 8;
+    pos += 8;
+  }
+  for (; pos <= lastStart; ++pos) {
+    if (hay[pos] == needle[0] && hay[pos + needleCount - 1] == needle[needleCount - 1] &&
+        ::memcmp(hay + pos + 1, needle + 1, (needleCount - 2) * sizeof(KChar)) == 0)
+      return pos;
+    budget -= needleCount;
+    if (budget < 0) {
+      *handoverPos = pos;
+      return kSearchHandover;
+    }
+  }
+  return -1;
+}
+#endif
+
+}  // namespace
+
 KInt Kotlin_String_indexOfString(KString thiz, KString other, KInt fromIndex) {
   if (fromIndex < 0) {
     fromIndex = 0;
@@ -1123,14 +1913,28 @@ KInt Kotlin_String_indexOfString(KString thiz, KString other, KInt fromIndex) {
   if (other->count_ == 0) {
     return fromIndex;
   }
-  const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, fromIndex);
-  const KChar* otherRaw = CharArrayAddressOfElementAt(other, 0);
-  void* result = konan::memmem(thizRaw, (thiz->count_ - fromIndex) * sizeof(KChar),
-                               otherRaw, other->count_ * sizeof(KChar));
-  if (result == nullptr) return -1;
-
-  return (reinterpret_cast<intptr_t>(result) - reinterpret_cast<intptr_t>(
-      CharArrayAddressOfElementAt(thiz, 0))) / sizeof(KChar);
+  const KChar* hay = CharArrayAddressOfElementAt(thiz, fromIndex);
+  const KChar* needle = CharArrayAddressOfElementAt(other, 0);
+  KInt hayCount = thiz->count_ - fromIndex;
+  KInt needleCount = other->count_;
+  if (needleCount == 1) {
+    return Kotlin_String_indexOfChar(thiz, *needle, fromIndex);
+  }
+#if defined(__SSE2__)
+  KInt handover = 0;
+  KInt result = filteredSearch(hay, hayCount, needle, needleCount, &handover);
+  if (result != kSearchHandover) {
+    return result < 0 ? -1 : fromIndex + result;
+  }
+  // Too many false candidates: finish with the linear-time loop.
+  result = twoWaySearch(hay + handover, hayCount - handover, needle, needleCount,
+      factorizationFor(other, needle, needleCount));
+  return result < 0 ? -1 : fromIndex + handover + result;
+#else
+  KInt result = twoWaySearch(hay, hayCount, needle, needleCount,
+      factorizationFor(other, needle, needleCount));
+  return result < 0 ? -1 : fromIndex + result;
+#endif
 }
 
 KInt Kotlin_String_lastIndexOfString(KString thiz, KString other, KInt fromIndex) {
@@ -1163,12 +1967,136 @@ KInt Kotlin_String_lastIndexOfString(KString thiz, KString other, KInt fromIndex
   }
 }
 
+namespace {
+
+// Cache of hash codes of permanent strings. Literals are never deallocated, so their
+// address is a stable identity and entries cannot go stale. Thread-local direct-mapped,
+// read and written without synchronization.
+constexpr int kStringHashCacheSize = 256;
+
+struct StringHashCacheEntry {
+  KString string;
+  KInt hash;
+};
+
+THREAD_LOCAL_VARIABLE StringHashCacheEntry stringHashCache[kStringHashCacheSize];
+
+}  // namespace
+
 KInt Kotlin_String_hashCode(KString thiz) {
-  // TODO: consider caching strings hashes.
   // TODO: maybe use some simpler hashing algorithm?
   // Note that we don't use Java's string hash.
-  return CityHash64(
+  StringHashCacheEntry* entry = nullptr;
+  if (thiz->obj()->permanent()) {
+    entry = stringHashCache +
+        ((reinterpret_cast<uintptr_t>(thiz) >> 4) & (kStringHashCacheSize - 1));
+    if (entry->string == thiz) return entry->hash;
+  }
+  KInt result = CityHash64(
     CharArrayAddressOfElementAt(thiz, 0), thiz->count_ * sizeof(KChar));
+  if (entry != nullptr) {
+    entry->string = thiz;
+    entry->hash = result;
+  }
+  return result;
+}
+
+// Hash of a character range, matching Kotlin_String_hashCode of the copied-out
+// range. Used by string views, so a view and its materialized string agree.
+KInt Kotlin_String_regionHashCode(KString thiz, KInt start, KInt length) {
+  RuntimeAssert(start >= 0 && length >= 0 &&
+                static_cast<uint32_t>(start + length) <= thiz->count_, "Invalid string region");
+  return CityHash64(
+    CharArrayAddressOfElementAt(thiz, start), length * sizeof(KChar));
+}
+
+namespace {
+
+// The char-array region operations below accept strings as well: the two share
+// the element layout, which is what lets a string builder compare against a
+// string without materializing either side.
+const KChar* charRegionAddress(KConstRef sequence, KInt offset, KInt length) {
+  const ArrayHeader* array = sequence->array();
+  RuntimeAssert(array->type_info() == theCharArrayTypeInfo ||
+                array->type_info() == theStringTypeInfo, "Must use a char array or a string");
+  RuntimeAssert(offset >= 0 && length >= 0 &&
+                static_cast<uint32_t>(offset + length) <= array->count_, "Invalid character region");
+  return CharArrayAddressOfElementAt(array, offset);
+}
+
+TwoWayFactorization regionFactorizationFor(KConstRef other, KInt offset, const KChar* needle, KInt count) {
+  const ArrayHeader* array = other->array();
+  // Whole permanent strings go through the searcher cache above; other regions
+  // have no stable identity to key it with.
+  if (offset == 0 && array->type_info() == theStringTypeInfo &&
+      static_cast<uint32_t>(count) == array->count_) {
+    return factorizationFor(array, needle, count);
+  }
+  return factorizeNeedle(needle, count);
+}
+
+}  // namespace
+
+// Region counterparts of Kotlin_String_compareTo/hashCode/indexOfString, so the
+// stdlib can implement CharSequence operations on char-array backed sequences
+// without copying the region out into a temporary string first.
+KInt Kotlin_CharArray_regionCompareTo(KConstRef thiz, KInt thizOffset, KInt thizLength,
+                                      KConstRef other, KInt otherOffset, KInt otherLength) {
+  const KChar* thizRaw = charRegionAddress(thiz, thizOffset, thizLength);
+  const KChar* otherRaw = charRegionAddress(other, otherOffset, otherLength);
+  KInt result = compareCharPrefixes(thizRaw, otherRaw,
+      thizLength < otherLength ? thizLength : otherLength);
+  if (result != 0) return result;
+  int diff = thizLength - otherLength;
+  if (diff == 0) return 0;
+  return diff < 0 ? -1 : 1;
+}
+
+// Matches Kotlin_String_hashCode of the materialized region, so a builder and
+// the string built from it agree on hash buckets.
+KInt Kotlin_CharArray_regionHashCode(KConstRef thiz, KInt offset, KInt length) {
+  return CityHash64(charRegionAddress(thiz, offset, length), length * sizeof(KChar));
+}
+
+KInt Kotlin_CharArray_regionIndexOf(KConstRef thiz, KInt thizOffset, KInt thizLength,
+                                    KConstRef other, KInt otherOffset, KInt otherLength,
+                                    KInt fromIndex) {
+  const KChar* hay = charRegionAddress(thiz, thizOffset, thizLength);
+  const KChar* needle = charRegionAddress(other, otherOffset, otherLength);
+  if (fromIndex < 0) {
+    fromIndex = 0;
+  }
+  if (fromIndex >= thizLength) {
+    return (otherLength == 0) ? thizLength : -1;
+  }
+  if (otherLength > thizLength - fromIndex) {
+    return -1;
+  }
+  // An empty needle can be always found.
+  if (otherLength == 0) {
+    return fromIndex;
+  }
+  hay += fromIndex;
+  KInt hayCount = thizLength - fromIndex;
+  if (otherLength == 1) {
+    KInt result = indexOfCharInRange(hay, hayCount, *needle);
+    return result < 0 ? -1 : fromIndex + result;
+  }
+#if defined(__SSE2__)
+  KInt handover = 0;
+  KInt result = filteredSearch(hay, hayCount, needle, otherLength, &handover);
+  if (result != kSearchHandover) {
+    return result < 0 ? -1 : fromIndex + result;
+  }
+  // Too many false candidates: finish with the linear-time loop.
+  result = twoWaySearch(hay + handover, hayCount - handover, needle, otherLength,
+      regionFactorizationFor(other, otherOffset, needle, otherLength));
+  return result < 0 ? -1 : fromIndex + handover + result;
+#else
+  KInt result = twoWaySearch(hay, hayCount, needle, otherLength,
+      regionFactorizationFor(other, otherOffset, needle, otherLength));
+  return result < 0 ? -1 : fromIndex + result;
+#endif
 }
 
 const KChar* Kotlin_String_utf16pointer(KString message) {
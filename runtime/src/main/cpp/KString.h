@@ -28,6 +28,10 @@ extern "C" {
 
 OBJ_GETTER(CreateStringFromCString, const char* cstring);
 OBJ_GETTER(CreateStringFromUtf8, const char* utf8, uint32_t lengthBytes);
+// As above, but identical byte sequences return the same frozen string with no
+// allocation after the first call. Intended for C data known to repeat a lot.
+OBJ_GETTER(CreateStringFromCStringInterned, const char* cstring);
+OBJ_GETTER(CreateStringFromUtf8Interned, const char* utf8, uint32_t lengthBytes);
 char* CreateCStringFromString(KConstRef kstring);
 void DisposeCString(char* cstring);
 
@@ -21,6 +21,7 @@
 #include "DoubleConversions.h"
 #include "Exceptions.h"
 #include "KotlinMath.h"
+#include "Natives.h"
 #include "ReturnSlot.h"
 #include "Types.h"
 
@@ -463,6 +464,46 @@ KLong Kotlin_math_absl(KLong x) { return (x >= 0) ? x : -x; }
 
 #endif // #ifndef KONAN_WASM
 
+// region Bulk array math.
+
+// Array variants evaluate one function over contiguous array storage in a single
+// runtime call: the per-element cost is the math kernel itself instead of a
+// Kotlin -> C transition per element, and the counted loops are vectorizable by
+// the C compiler on targets whose toolchain provides SIMD math kernels.
+
+#define KOTLIN_MATH_BULK_OP(name, elemType, scalar)                            \
+  void Kotlin_math_##name(KConstRef srcRef, KRef dstRef, KInt n) {             \
+    const ArrayHeader* src = srcRef->array();                                  \
+    ArrayHeader* dst = dstRef->array();                                        \
+    if (n < 0 || static_cast<uint32_t>(n) > src->count_                        \
+              || static_cast<uint32_t>(n) > dst->count_) {                     \
+      ThrowArrayIndexOutOfBoundsException();                                   \
+    }                                                                          \
+    const elemType* from = PrimitiveArrayAddressOfElementAt<elemType>(src, 0); \
+    elemType* to = PrimitiveArrayAddressOfElementAt<elemType>(dst, 0);         \
+    for (KInt i = 0; i < n; ++i) {                                             \
+      to[i] = scalar(from[i]);                                                 \
+    }                                                                          \
+  }
+
+KOTLIN_MATH_BULK_OP(sinArray, KDouble, Kotlin_math_sin)
+KOTLIN_MATH_BULK_OP(cosArray, KDouble, Kotlin_math_cos)
+KOTLIN_MATH_BULK_OP(tanArray, KDouble, Kotlin_math_tan)
+KOTLIN_MATH_BULK_OP(expArray, KDouble, Kotlin_math_exp)
+KOTLIN_MATH_BULK_OP(lnArray, KDouble, Kotlin_math_ln)
+KOTLIN_MATH_BULK_OP(sqrtArray, KDouble, Kotlin_math_sqrt)
+
+KOTLIN_MATH_BULK_OP(sinArrayf, KFloat, Kotlin_math_sinf)
+KOTLIN_MATH_BULK_OP(cosArrayf, KFloat, Kotlin_math_cosf)
+KOTLIN_MATH_BULK_OP(tanArrayf, KFloat, Kotlin_math_tanf)
+KOTLIN_MATH_BULK_OP(expArrayf, KFloat, Kotlin_math_expf)
+KOTLIN_MATH_BULK_OP(lnArrayf, KFloat, Kotlin_math_lnf)
+KOTLIN_MATH_BULK_OP(sqrtArrayf, KFloat, Kotlin_math_sqrtf)
+
+#undef KOTLIN_MATH_BULK_OP
+
+// endregion
+
 #else // KONAN_NO_MATH defined - we have no patform math library. Throw NotImplementedError from math functions.
 
 namespace {
@@ -575,6 +616,24 @@ KLong Kotlin_math_absl(KLong x) { NotImplemented(); }
 KLong Kotlin_math_minl(KLong a, KLong b) { NotImplemented(); }
 KLong Kotlin_math_maxl(KLong a, KLong b) { NotImplemented(); }
 
+// region Bulk array math.
+
+void Kotlin_math_sinArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_cosArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_tanArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_expArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_lnArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_sqrtArray(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+
+void Kotlin_math_sinArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_cosArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_tanArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_expArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_lnArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+void Kotlin_math_sqrtArrayf(KConstRef src, KRef dst, KInt n) { NotImplemented(); }
+
+// endregion
+
 #endif // #ifndef KONAN_NO_MATH
 
 } // extern "C"
@@ -119,12 +119,30 @@ extern "C" {
     ObjHeader* __result = name(__VA_ARGS__, OBJ_RESULT);  \
     return __result;                                      \
   }
+// Leaf variant of RETURN_OBJ for results that need no rooting through the return
+// slot: permanent objects, and aliases of a reference the caller provably keeps
+// alive across the call (e.g. an argument returned unchanged). The result travels
+// in the return register only; the slot keeps its previous value, which still owns
+// whatever it roots until the frame is left.
+#define RETURN_OBJ_ROOTED(value) return (value);
 
 struct MemoryState;
 
 MemoryState* InitMemory();
 void DeinitMemory(MemoryState*);
 void RestoreMemory(MemoryState*);
+// Detaches the memory state (and the current frame chain) from this thread and
+// returns it, so another runtime's state can be attached; ResumeMemory is the
+// counterpart. Used to interleave isolated runtimes on one host thread, see
+// Kotlin_suspendCurrentRuntime in Runtime.h.
+MemoryState* SuspendMemory();
+void ResumeMemory(MemoryState*);
+// Returns the memory state of the calling thread. Generated code fetches it once
+// per function and threads it through the WithState entry points below, so hot
+// allocation and reference counting paths pay a single thread-local lookup (one
+// __tls_get_addr call in dynamically linked deployments) instead of one per
+// runtime call.
+MemoryState* GetMemoryState() RUNTIME_NOTHROW;
 
 //
 // Object allocation.
@@ -142,6 +160,47 @@ OBJ_GETTER(AllocInstance, const TypeInfo* type_info) RUNTIME_NOTHROW;
 
 OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements);
 
+// Like AllocArrayInstance, but the element area may be left uninitialized.
+// Only valid for arrays of non-reference elements (the GC would trace garbage
+// otherwise), and only when the caller overwrites every element before the
+// array can be observed by anything else. Selected per allocation site when
+// zeroing is provably redundant.
+OBJ_GETTER(AllocArrayInstanceUninitialized, const TypeInfo* type_info, int32_t elements);
+
+// Like AllocArrayInstance, but requests that the element data start on an
+// [alignment]-byte boundary (a power of two between the default object
+// alignment and a page), e.g. 32 for AVX payloads or 64 to keep a hot array
+// out of its neighbours' cache lines. Best effort: allocators without offset
+// alignment support fall back to the default alignment. Types carrying
+// TF_ALIGNED_PAYLOAD get cache-line alignment without this entry point.
+OBJ_GETTER(AllocArrayInstanceAligned, const TypeInfo* type_info, int32_t elements, int32_t alignment);
+
+// Like AllocInstance/AllocArrayInstance, but with the calling thread's memory
+// state (see GetMemoryState) passed explicitly instead of being looked up.
+OBJ_GETTER(AllocInstanceWithState, MemoryState* state, const TypeInfo* type_info) RUNTIME_NOTHROW;
+
+OBJ_GETTER(AllocArrayInstanceWithState, MemoryState* state, const TypeInfo* type_info, int32_t elements);
+
+// Tries to grow [array] to [newCount] elements in place, using allocator slack
+// behind its storage; new elements are zeroed. Only succeeds for plain unshared
+// heap containers, so the caller must guarantee single ownership of the array.
+bool TryGrowArrayInPlace(ArrayHeader* array, int32_t newCount) RUNTIME_NOTHROW;
+
+// Allocates an instance in the frame-local slab when escape analysis proved the
+// object does not outlive its owner frame. [auxSlot] designates the frame (it is
+// a slot inside the frame's overlay); the slab is released wholesale on frame
+// exit. Falls back to a regular heap allocation when the slab cannot be grown.
+OBJ_GETTER(AllocInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info) RUNTIME_NOTHROW;
+
+OBJ_GETTER(AllocArrayInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info, int32_t elements);
+
+// Promotes a stack-allocated object into a fresh heap container when a reference
+// is about to escape its frame; returns the object itself when it already lives
+// in the heap. The copy has a new identity, so the compiler shall call this while
+// it still sees every alias, and promote escaping subgraphs leaf-first so that
+// promoted objects only refer to heap objects.
+OBJ_GETTER(PromoteObjectToHeap, ObjHeader* object) RUNTIME_NOTHROW;
+
 OBJ_GETTER(InitInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
@@ -187,6 +246,14 @@ void ZeroStackRef(ObjHeader** location) RUNTIME_NOTHROW;
 void UpdateStackRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
 // Updates heap/static data location.
 void UpdateHeapRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
+// Like UpdateHeapRef, but with the calling thread's memory state passed explicitly.
+void UpdateHeapRefWithState(MemoryState* state, ObjHeader** location,
+    const ObjHeader* object) RUNTIME_NOTHROW;
+// Coalesced form of UpdateHeapRef for initialization bursts: stores `count` values into
+// distinct unset fields of one freshly allocated, not yet published object, checking the
+// thread state once and batching reference count adjustments.
+void UpdateHeapRefsBulk(const ObjHeader* object, ObjHeader** const locations[],
+    const ObjHeader* const values[], int count) RUNTIME_NOTHROW;
 // Updates location if it is null, atomically.
 void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
 // Updates reference in return slot.
@@ -204,10 +271,22 @@ OBJ_GETTER(ReadHeapRefLocked, ObjHeader** location, int32_t* spinlock, int32_t*
 void EnterFrame(ObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
 // Called on frame leave, if it has object slots.
 void LeaveFrame(ObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
+// Enters an arena scope on the current thread: until the matching LeaveArenaScope
+// allocations are placed into a per-scope slab which is released wholesale on leave,
+// bypassing per-object reclamation. Scopes nest; the caller must guarantee that no
+// references into the scope survive it.
+void* EnterArenaScope() RUNTIME_NOTHROW;
+// Leaves an arena scope, releasing all objects allocated in it at once.
+void LeaveArenaScope(void* scope) RUNTIME_NOTHROW;
 // Clears object subgraph references from memory subsystem, and optionally
 // checks if subgraph referenced by given root is disjoint from the rest of
 // object graph, i.e. no external references exists.
 bool ClearSubgraphReferences(ObjHeader* root, bool checked) RUNTIME_NOTHROW;
+// Copies the objects of a detached subgraph (stable pointer as produced along with
+// ClearSubgraphReferences) into contiguous memory in traversal order, improving the
+// cache and TLB locality of later traversals. Returns the stable pointer of the
+// compacted graph; may return the argument unchanged where compaction cannot help.
+void* CompactSubgraph(void* stable) RUNTIME_NOTHROW;
 // Creates stable pointer out of the object.
 void* CreateStablePointer(ObjHeader* obj) RUNTIME_NOTHROW;
 // Disposes stable pointer to the object.
@@ -223,6 +302,16 @@ void CheckLifetimesConstraint(ObjHeader* obj, ObjHeader* pointee) RUNTIME_NOTHRO
 void FreezeSubgraph(ObjHeader* obj);
 // Ensure this object shall block freezing.
 void EnsureNeverFrozen(ObjHeader* obj);
+// Registers a death hook: [hook] is invoked with [entry] by the memory manager when
+// [obj] is deallocated, before its memory is reused. Hooks run on the deallocating
+// thread in no particular order; they must not allocate Kotlin objects or throw.
+// Permanent objects never die, so hooks on them are silently dropped. Weak-keyed
+// tables are built on top of this, see WeakKeyedTable.h.
+void AddObjectDeathHook(ObjHeader* obj, void (*hook)(void* entry), void* entry) RUNTIME_NOTHROW;
+// Removes the death hook identified by [entry]. Returns false when the hook is
+// absent - never registered, or already claimed by a concurrent deallocation of
+// [obj]; in the latter case the hook invocation is still in flight and owns [entry].
+bool RemoveObjectDeathHook(ObjHeader* obj, void* entry) RUNTIME_NOTHROW;
 // Add TLS object storage, called by the generated code.
 void AddTLSRecord(MemoryState* memory, void** key, int size) RUNTIME_NOTHROW;
 // Clear TLS object storage, called by the generated code.
@@ -234,6 +323,11 @@ ObjHeader** LookupTLS(void** key, int index) RUNTIME_NOTHROW;
 void GC_RegisterWorker(void* worker) RUNTIME_NOTHROW;
 void GC_UnregisterWorker(void* worker) RUNTIME_NOTHROW;
 void GC_CollectorCallback(void* worker) RUNTIME_NOTHROW;
+// Donates the calling thread to one bounded slice of its own deferred memory
+// work (queued decrements, sweep backlog, finalizers, cycle candidates).
+// Returns true when another slice would still find work. Called from worker
+// idle paths, so memory work happens off the mutators' critical path.
+bool GC_PerformIdleSlice() RUNTIME_NOTHROW;
 
 bool Kotlin_Any_isShareable(ObjHeader* thiz);
 void PerformFullGC() RUNTIME_NOTHROW;
@@ -302,12 +396,20 @@ class ObjHolder {
 //! TODO Follow the Rule of Zero to prevent dangling on unintented copy ctor
 class ExceptionObjHolder {
  public:
+   enum class NoRetainTag { kNoRetain };
+
    explicit ExceptionObjHolder(const ObjHeader* obj) {
      ::SetHeapRef(&obj_, obj);
    }
 
+   // For preallocated frozen exceptions thrown as control flow
+   // (TF_CONTROL_FLOW_EXCEPTION): the singleton outlives any unwind,
+   // so no reference is retained or released.
+   ExceptionObjHolder(const ObjHeader* obj, NoRetainTag)
+       : obj_(const_cast<ObjHeader*>(obj)), retained_(false) {}
+
    ~ExceptionObjHolder() {
-     ZeroHeapRef(&obj_);
+     if (retained_) ZeroHeapRef(&obj_);
    }
 
    ObjHeader* obj() { return obj_; }
@@ -316,6 +418,7 @@ class ExceptionObjHolder {
 
  private:
    ObjHeader* obj_;
+   bool retained_ = true;
 };
 
 #endif // RUNTIME_MEMORY_H
@@ -3,6 +3,10 @@
  * that can be found in the LICENSE file.
  */
 
+#include <string.h>
+
+#include "Alloc.h"
+#include "Atomic.h"
 #include "Exceptions.h"
 #include "MemorySharedRefs.hpp"
 #include "Runtime.h"
@@ -68,24 +72,149 @@ bool ensureRefAccessible<ErrorPolicy::kIgnore>(ObjHeader* object, ForeignRefCont
   return true;
 }
 
+// Storage block of the holder allocation cache; free blocks chain through their
+// own storage.
+struct HolderBlock {
+  union {
+    KRefSharedHolder holder;
+    HolderBlock* next;
+  };
+  // Bumped on every free. The low bits are stamped into handles given out for
+  // this block, so a handle that outlived its disposal can be detected cheaply.
+  uint32_t generation;
+};
+
+// Holders are pointer-aligned, leaving the low bits of a handle free for the
+// generation stamp.
+constexpr uintptr_t kHolderGenerationMask = alignof(KRefSharedHolder) - 1;
+static_assert(alignof(KRefSharedHolder) >= 8, "Too few free low bits for the generation stamp");
+
+constexpr size_t kHolderShardCount = 16;
+// How many cached blocks a thread keeps before spilling half of them to a shard.
+constexpr size_t kHolderMagazineCapacity = 64;
+
+// Global overflow pool. Shards are cache-line-padded, so threads spilling or
+// refilling concurrently do not false-share the locks.
+struct alignas(64) HolderShard {
+  int32_t lock;
+  HolderBlock* blocks;
+};
+
+HolderShard holderShards[kHolderShardCount];
+
+THREAD_LOCAL_VARIABLE HolderBlock* holderMagazine = nullptr;
+THREAD_LOCAL_VARIABLE size_t holderMagazineSize = 0;
+
+inline HolderShard& holderShardForThisThread() {
+  auto value = reinterpret_cast<uintptr_t>(&holderMagazine);
+  return holderShards[(value >> 6) % kHolderShardCount];
+}
+
+inline void holderShardLock(HolderShard* shard) {
+  while (!compareAndSet(&shard->lock, 0, 1)) {}
+}
+
+inline void holderShardUnlock(HolderShard* shard) {
+  atomicSet(&shard->lock, 0);
+}
+
 }  // namespace
 
+KRefSharedHolder* AllocKRefSharedHolder() {
+  HolderBlock* block = holderMagazine;
+  if (block == nullptr) {
+    // Refill half a magazine from this thread's shard in one lock acquisition.
+    auto& shard = holderShardForThisThread();
+    holderShardLock(&shard);
+    HolderBlock* taken = shard.blocks;
+    if (taken != nullptr) {
+      size_t count = 1;
+      HolderBlock* last = taken;
+      while (last->next != nullptr && count < kHolderMagazineCapacity / 2) {
+        last = last->next;
+        count++;
+      }
+      shard.blocks = last->next;
+      last->next = nullptr;
+      holderMagazine = taken;
+      holderMagazineSize = count;
+    }
+    holderShardUnlock(&shard);
+    block = holderMagazine;
+    if (block == nullptr) {
+      return &konanConstructInstance<HolderBlock>()->holder;
+    }
+  }
+  holderMagazine = block->next;
+  holderMagazineSize--;
+  // Callers expect the same zeroed storage a fresh konanConstructInstance() gives.
+  // The generation stamp must survive reuse, so only the holder storage is zeroed.
+  memset(static_cast<void*>(&block->holder), 0, sizeof(KRefSharedHolder));
+  return &block->holder;
+}
+
+void FreeKRefSharedHolder(KRefSharedHolder* holder) {
+  HolderBlock* block = reinterpret_cast<HolderBlock*>(holder);
+  block->generation++;
+  block->next = holderMagazine;
+  holderMagazine = block;
+  if (++holderMagazineSize <= kHolderMagazineCapacity) return;
+  // Spill half of the magazine in one lock acquisition, amortizing the shared pool
+  // work over many disposals.
+  HolderBlock* spillHead = holderMagazine;
+  HolderBlock* spillTail = spillHead;
+  for (size_t i = 1; i < kHolderMagazineCapacity / 2; ++i) {
+    spillTail = spillTail->next;
+  }
+  holderMagazine = spillTail->next;
+  holderMagazineSize -= kHolderMagazineCapacity / 2;
+  auto& shard = holderShardForThisThread();
+  holderShardLock(&shard);
+  spillTail->next = shard.blocks;
+  shard.blocks = spillHead;
+  holderShardUnlock(&shard);
+}
+
+void* TagKRefSharedHolder(KRefSharedHolder* holder) {
+  auto* block = reinterpret_cast<HolderBlock*>(holder);
+  return reinterpret_cast<void*>(
+      reinterpret_cast<uintptr_t>(block) | (block->generation & kHolderGenerationMask));
+}
+
+KRefSharedHolder* UntagKRefSharedHolder(void* handle) {
+  auto value = reinterpret_cast<uintptr_t>(handle);
+  auto* block = reinterpret_cast<HolderBlock*>(value & ~kHolderGenerationMask);
+  RuntimeCheck((value & kHolderGenerationMask) == (block->generation & kHolderGenerationMask),
+      "Stale stable pointer: the handle was disposed and its slot reused");
+  return &block->holder;
+}
+
 void KRefSharedHolder::initLocal(ObjHeader* obj) {
   RuntimeAssert(obj != nullptr, "must not be null");
   context_ = InitLocalForeignRef(obj);
   obj_ = obj;
+  knownShareable_ = false;
 }
 
 void KRefSharedHolder::init(ObjHeader* obj) {
   RuntimeAssert(obj != nullptr, "must not be null");
   context_ = InitForeignRef(obj);
   obj_ = obj;
+  knownShareable_ = false;
 }
 
 template <ErrorPolicy errorPolicy>
 ObjHeader* KRefSharedHolder::ref() const {
-  if (!ensureRefAccessible<errorPolicy>(obj_, context_)) {
-    return nullptr;
+  if (knownShareable_) {
+    // The object was observed shareable by an earlier access, which cannot revert,
+    // so the ownership check is skipped. The runtime must still be attached: the
+    // adoption below and the caller both need an execution context on this thread.
+    Kotlin_initRuntimeIfNeeded();
+  } else {
+    if (!ensureRefAccessible<errorPolicy>(obj_, context_)) {
+      return nullptr;
+    }
+    if (Kotlin_Any_isShareable(obj_)) knownShareable_ = true;
   }
 
   AdoptReferenceFromSharedVariable(obj_);
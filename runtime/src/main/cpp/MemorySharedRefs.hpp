@@ -35,11 +35,30 @@ class KRefSharedHolder {
  private:
   ObjHeader* obj_;
   ForeignRefContext context_;
+  // Memoizes a successful shareability verdict of the accessibility check: freezing
+  // is irreversible, so once the object was observed shareable every later access
+  // from any thread is accessible and [ref] skips the full check. Monotonic; racy
+  // readers seeing a stale false merely repeat the check.
+  mutable bool knownShareable_;
 };
 
 static_assert(std::is_trivially_destructible<KRefSharedHolder>::value,
     "KRefSharedHolder destructor is not guaranteed to be called.");
 
+// Allocation cache for KRefSharedHolder instances churned by interop: per-thread
+// magazines backed by cache-line-padded global shards, so that creating and disposing
+// stable pointers on many threads does not contend on the allocator. A thread that
+// exits leaves at most one magazine worth of blocks cached.
+KRefSharedHolder* AllocKRefSharedHolder();
+void FreeKRefSharedHolder(KRefSharedHolder* holder);
+
+// Stamps the slot's generation counter into the low (alignment) bits of the handle
+// handed out for `holder`, and checks it back on the way in: a handle used after its
+// slot was disposed and reused fails the check instead of silently aliasing the new
+// occupant. Only code that interprets stable pointer handles may untag them.
+void* TagKRefSharedHolder(KRefSharedHolder* holder);
+KRefSharedHolder* UntagKRefSharedHolder(void* handle);
+
 class BackRefFromAssociatedObject {
  public:
   void initAndAddRef(ObjHeader* obj);
@@ -25,8 +25,11 @@
 #include "Exceptions.h"
 #include "Memory.h"
 #include "Natives.h"
+#include "Runtime.h"
 #include "Types.h"
 
+extern "C" void Kotlin_io_Console_flush();
+
 extern "C" {
 
 // Any.kt
@@ -35,9 +38,16 @@ KBoolean Kotlin_Any_equals(KConstRef thiz, KConstRef other) {
 }
 
 KInt Kotlin_Any_hashCode(KConstRef thiz) {
+  // The identity hash is derived from the address: no allocation, no header mutation.
+  // Raw addresses hash poorly - object alignment zeroes the low bits and nearby
+  // allocations share the high ones - so mix the bits (splitmix64 finalizer) before
+  // truncating to give map-key-heavy code a well-distributed value.
   // Here we will use different mechanism for stable hashcode, using meta-objects
   // if moving collector will be used.
-  return reinterpret_cast<uintptr_t>(thiz);
+  uint64_t x = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(thiz));
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return static_cast<KInt>(x ^ (x >> 31));
 }
 
 OBJ_GETTER(Kotlin_getStackTraceStrings, KConstRef stackTrace) {
@@ -70,6 +80,12 @@ void Kotlin_interop_free(void* ptr) {
 }
 
 void Kotlin_system_exitProcess(KInt status) {
+  if (Kotlin_fastShutdownEnabled()) {
+    // The OS reclaims the heap anyway; skip the final GC, finalizers, worker
+    // teardown and atexit handlers, but do not lose buffered output.
+    Kotlin_io_Console_flush();
+    konan::exitUnclean(status);
+  }
   konan::exit(status);
 }
 
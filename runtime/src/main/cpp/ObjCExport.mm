@@ -38,6 +38,7 @@
 #import "ObjCExportInit.h"
 #import "ObjCExportPrivate.h"
 #import "ObjCMMAPI.h"
+#import "Atomic.h"
 #import "Runtime.h"
 #import "Utils.h"
 #import "Exceptions.h"
@@ -142,10 +143,50 @@ extern "C" id Kotlin_ObjCExport_convertUnit(ObjHeader* unitInstance) {
   return instance;
 }
 
+// On 64-bit platforms Foundation stores short ASCII strings directly in the pointer.
+// Creating such a string allocates nothing, and retain/release/autorelease on it are no-ops,
+// so it doesn't need to be cached in the associated object slot.
+static const uint32_t maxTaggedPointerStringLength = 9;
+
+static inline bool isTaggedPointer(id obj) {
+#if defined(__x86_64__)
+  return (reinterpret_cast<uintptr_t>(obj) & 1) != 0;
+#elif defined(__aarch64__)
+  return (reinterpret_cast<uintptr_t>(obj) & (1ull << 63)) != 0;
+#else
+  return false;
+#endif
+}
+
+static id createTaggedNSString(const KChar* utf16Chars, uint32_t count) {
+#if defined(__x86_64__) || defined(__aarch64__)
+  if (count == 0 || count > maxTaggedPointerStringLength) return nullptr;
+  char ascii[maxTaggedPointerStringLength];
+  for (uint32_t i = 0; i < count; ++i) {
+    KChar ch = utf16Chars[i];
+    if (ch >= 0x80) return nullptr;
+    ascii[i] = (char)ch;
+  }
+  NSString* candidate = [[NSString alloc] initWithBytes:ascii length:count encoding:NSASCIIStringEncoding];
+  if (isTaggedPointer(candidate)) return candidate;
+  // The OS didn't tag it; release and take the regular caching path instead.
+  objc_release(candidate);
+#endif
+  return nullptr;
+}
+
 extern "C" id Kotlin_ObjCExport_CreateNSStringFromKString(ObjHeader* str) {
   KChar* utf16Chars = CharArrayAddressOfElementAt(str->array(), 0);
   auto numBytes = str->array()->count_ * sizeof(KChar);
 
+  if (id cached = (id)GetAssociatedObject(str)) {
+    return objc_retainAutoreleaseReturnValue(cached);
+  }
+
+  if (id tagged = createTaggedNSString(utf16Chars, str->array()->count_)) {
+    return [tagged autorelease];
+  }
+
   if (str->permanent()) {
     return [[[NSString alloc] initWithBytesNoCopy:utf16Chars
         length:numBytes
@@ -170,12 +211,80 @@ extern "C" id Kotlin_ObjCExport_CreateNSStringFromKString(ObjHeader* str) {
     return objc_retainAutoreleaseReturnValue(candidate);
   }
 }
+// Must produce exactly the same values as adapterNameHash in ObjCExportCodeGenerator.kt (32-bit FNV-1a).
+static uint32_t adapterNameHash(const char* name) {
+  uint32_t hash = 0x811C9DC5u;
+  for (const unsigned char* p = (const unsigned char*)name; *p != 0; ++p) {
+    hash = (hash ^ *p) * 16777619u;
+  }
+  return hash;
+}
+
+// Must produce exactly the same values as adapterNameHash64 in ObjCExportCodeGenerator.kt (64-bit FNV-1a).
+static uint64_t adapterNameHash64(const char* name) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const unsigned char* p = (const unsigned char*)name; *p != 0; ++p) {
+    hash = (hash ^ *p) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
 static const ObjCTypeAdapter* findAdapterByName(
       const char* name,
       const ObjCTypeAdapter** sortedAdapters,
+      const uint32_t* nameHashes,
+      const int32_t* hashIndices,
+      const int32_t* phDisplacements,
+      const int32_t* phIndices,
+      int phBucketsNum,
       int adapterNum
 ) {
 
+  if (phDisplacements != nullptr && phIndices != nullptr && phBucketsNum > 0 && adapterNum > 0) {
+    // Compiler-built CHD perfect hash: the displacement of the name's bucket derives
+    // the unique candidate slot, so the lookup is O(1) with a single strcmp. Slot
+    // derivation must mirror buildPerfectHash in PerfectHash.kt: the low hash half
+    // positions the key, the high half (forced odd) is the displacement step, all in
+    // 32-bit wrapping arithmetic.
+    uint64_t hash = adapterNameHash64(name);
+    uint32_t position = (uint32_t)hash;
+    uint32_t step = ((uint32_t)(hash >> 32)) | 1u;
+    int32_t displacement = phDisplacements[position % (uint32_t)phBucketsNum];
+    uint32_t slot = displacement < 0
+        ? (uint32_t)(-displacement - 1)
+        : (position + (uint32_t)displacement * step) % (uint32_t)adapterNum;
+    const ObjCTypeAdapter* candidate = sortedAdapters[phIndices[slot]];
+    return strcmp(name, candidate->objCName) == 0 ? candidate : nullptr;
+  }
+
+  if (nameHashes != nullptr && hashIndices != nullptr) {
+    // Compiler-precomputed index: hashes sorted ascending, with a parallel array mapping
+    // each one back to the name-sorted adapter array. Search by integer comparisons and
+    // run strcmp only on the (almost always single) hash match.
+    uint32_t hash = adapterNameHash(name);
+    int left = 0, right = adapterNum - 1;
+
+    while (right >= left) {
+      int mid = (left + right) / 2;
+      uint32_t midHash = nameHashes[mid];
+      if (hash < midHash) {
+        right = mid - 1;
+      } else if (hash > midHash) {
+        left = mid + 1;
+      } else {
+        int first = mid;
+        while (first > 0 && nameHashes[first - 1] == hash) --first;
+        for (int i = first; i < adapterNum && nameHashes[i] == hash; ++i) {
+          const ObjCTypeAdapter* candidate = sortedAdapters[hashIndices[i]];
+          if (strcmp(name, candidate->objCName) == 0) return candidate;
+        }
+        return nullptr;
+      }
+    }
+
+    return nullptr;
+  }
+
   int left = 0, right = adapterNum - 1;
 
   while (right >= left) {
@@ -195,15 +304,30 @@ static const ObjCTypeAdapter* findAdapterByName(
 
 __attribute__((weak)) const ObjCTypeAdapter** Kotlin_ObjCExport_sortedClassAdapters = nullptr;
 __attribute__((weak)) int Kotlin_ObjCExport_sortedClassAdaptersNum = 0;
+__attribute__((weak)) const uint32_t* Kotlin_ObjCExport_sortedClassAdaptersNameHashes = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedClassAdaptersHashIndices = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedClassAdaptersPhDisplacements = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedClassAdaptersPhIndices = nullptr;
+__attribute__((weak)) int Kotlin_ObjCExport_sortedClassAdaptersPhBucketsNum = 0;
 
 __attribute__((weak)) const ObjCTypeAdapter** Kotlin_ObjCExport_sortedProtocolAdapters = nullptr;
 __attribute__((weak)) int Kotlin_ObjCExport_sortedProtocolAdaptersNum = 0;
+__attribute__((weak)) const uint32_t* Kotlin_ObjCExport_sortedProtocolAdaptersNameHashes = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedProtocolAdaptersHashIndices = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedProtocolAdaptersPhDisplacements = nullptr;
+__attribute__((weak)) const int32_t* Kotlin_ObjCExport_sortedProtocolAdaptersPhIndices = nullptr;
+__attribute__((weak)) int Kotlin_ObjCExport_sortedProtocolAdaptersPhBucketsNum = 0;
 
 __attribute__((weak)) bool Kotlin_ObjCExport_initTypeAdapters = false;
 
 static const ObjCTypeAdapter* findClassAdapter(Class clazz) {
   return findAdapterByName(class_getName(clazz),
         Kotlin_ObjCExport_sortedClassAdapters,
+        Kotlin_ObjCExport_sortedClassAdaptersNameHashes,
+        Kotlin_ObjCExport_sortedClassAdaptersHashIndices,
+        Kotlin_ObjCExport_sortedClassAdaptersPhDisplacements,
+        Kotlin_ObjCExport_sortedClassAdaptersPhIndices,
+        Kotlin_ObjCExport_sortedClassAdaptersPhBucketsNum,
         Kotlin_ObjCExport_sortedClassAdaptersNum
   );
 }
@@ -211,6 +335,11 @@ static const ObjCTypeAdapter* findClassAdapter(Class clazz) {
 static const ObjCTypeAdapter* findProtocolAdapter(Protocol* prot) {
   return findAdapterByName(protocol_getName(prot),
         Kotlin_ObjCExport_sortedProtocolAdapters,
+        Kotlin_ObjCExport_sortedProtocolAdaptersNameHashes,
+        Kotlin_ObjCExport_sortedProtocolAdaptersHashIndices,
+        Kotlin_ObjCExport_sortedProtocolAdaptersPhDisplacements,
+        Kotlin_ObjCExport_sortedProtocolAdaptersPhIndices,
+        Kotlin_ObjCExport_sortedProtocolAdaptersPhBucketsNum,
         Kotlin_ObjCExport_sortedProtocolAdaptersNum
   );
 }
@@ -254,6 +383,43 @@ extern "C" const TypeInfo* Kotlin_ObjCInterop_getTypeInfoForProtocol(Protocol* p
 
 static const TypeInfo* getOrCreateTypeInfo(Class clazz);
 
+namespace {
+
+// Selector (and encoding) strings in adapter tables are interned by the compiler,
+// so the same spelling is the same pointer across all exported classes. Cache
+// [sel_registerName] results keyed by that pointer: common selectors appear in
+// thousands of classes, and the cache replaces re-hashing the spelling each time
+// with a single pointer comparison.
+constexpr size_t adapterSelectorCacheSize = 1024; // Must be a power of two.
+
+struct AdapterSelectorCacheEntry {
+  const char* volatile name;
+  SEL volatile selector;
+};
+
+AdapterSelectorCacheEntry adapterSelectorCache[adapterSelectorCacheSize] = {};
+
+SEL registerAdapterSelector(const char* name) {
+  size_t index = (reinterpret_cast<uintptr_t>(name) >> 4) & (adapterSelectorCacheSize - 1);
+  AdapterSelectorCacheEntry* entry = &adapterSelectorCache[index];
+
+  if (atomicGet(&entry->name) == name) {
+    SEL cached = atomicGet(&entry->selector);
+    // [selector] is published after [name]; fall through if it isn't visible yet.
+    if (cached != nullptr) return cached;
+  }
+
+  SEL selector = sel_registerName(name);
+  if (compareAndSwap(&entry->name, static_cast<const char*>(nullptr), name) == nullptr) {
+    // Only the thread that claimed the slot publishes the selector,
+    // so [name] and [selector] can't come from different strings.
+    atomicSet(&entry->selector, selector);
+  }
+  return selector;
+}
+
+} // namespace
+
 extern "C" void Kotlin_ObjCExport_initializeClass(Class clazz) {
   const ObjCTypeAdapter* typeAdapter = findClassAdapter(clazz);
   if (typeAdapter == nullptr) {
@@ -269,14 +435,14 @@ extern "C" void Kotlin_ObjCExport_initializeClass(Class clazz) {
 
   for (int i = 0; i < typeAdapter->directAdapterNum; ++i) {
     const ObjCToKotlinMethodAdapter* adapter = typeAdapter->directAdapters + i;
-    SEL selector = sel_registerName(adapter->selector);
+    SEL selector = registerAdapterSelector(adapter->selector);
     BOOL added = class_addMethod(clazz, selector, adapter->imp, adapter->encoding);
     RuntimeAssert(added, "Unexpected selector clash");
   }
 
   for (int i = 0; i < typeAdapter->classAdapterNum; ++i) {
     const ObjCToKotlinMethodAdapter* adapter = typeAdapter->classAdapters + i;
-    SEL selector = sel_registerName(adapter->selector);
+    SEL selector = registerAdapterSelector(adapter->selector);
     BOOL added = class_addMethod(object_getClass(clazz), selector, adapter->imp, adapter->encoding);
     RuntimeAssert(added, "Unexpected selector clash");
   }
@@ -999,7 +1165,7 @@ static int anonymousClassNextId = 0;
 static void addVirtualAdapters(Class clazz, const ObjCTypeAdapter* typeAdapter) {
   for (int i = 0; i < typeAdapter->virtualAdapterNum; ++i) {
     const ObjCToKotlinMethodAdapter* adapter = typeAdapter->virtualAdapters + i;
-    SEL selector = sel_registerName(adapter->selector);
+    SEL selector = registerAdapterSelector(adapter->selector);
 
     class_addMethod(clazz, selector, adapter->imp, adapter->encoding);
   }
@@ -7,3 +7,7 @@
 
 extern "C" id Kotlin_ObjCExport_ExceptionAsNSError(KRef exception, const TypeInfo** types);
 extern "C" OBJ_GETTER(Kotlin_ObjCExport_NSErrorAsException, id error);
+
+// Lightweight error path, see ObjCExportErrors.mm.
+extern "C" void Kotlin_ObjCExport_setPendingNSError(KInt code, KRef message);
+extern "C" KBoolean Kotlin_ObjCExport_takePendingNSError(id* outError);
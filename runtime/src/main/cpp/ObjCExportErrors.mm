@@ -89,6 +89,35 @@ extern "C" void Kotlin_ObjCExport_RethrowExceptionAsNSError(KRef exception, id*
     if (outError != nullptr) *outError = error;
 }
 
+// Lightweight error path: a function opted in with @ReportsPendingNSError reports an expected
+// failure by storing a code+message payload here and returning normally; its generated bridge
+// hands the payload to the caller as NSError. No exception object is constructed and nothing
+// unwinds, so a failure costs little more than the NSError itself.
+static THREAD_LOCAL_VARIABLE NSError* pendingNSError = nullptr;
+
+extern "C" void Kotlin_ObjCExport_setPendingNSError(KInt code, KRef message) {
+  NSDictionary<NSErrorUserInfoKey, id>* userInfo = nullptr;
+  NSString* description = Kotlin_Interop_CreateNSStringFromKString(message);
+  if (description != nullptr) {
+    userInfo = @{NSLocalizedDescriptionKey: description};
+  }
+  NSError* error = [[NSError alloc] initWithDomain:@"KotlinError" code:code userInfo:userInfo];
+  [pendingNSError release];
+  pendingNSError = error;
+}
+
+extern "C" KBoolean Kotlin_ObjCExport_takePendingNSError(id* outError) {
+  NSError* error = pendingNSError;
+  if (error == nullptr) return false;
+  pendingNSError = nullptr;
+  if (outError != nullptr) {
+    *outError = [error autorelease];
+  } else {
+    [error release];
+  }
+  return true;
+}
+
 extern "C" OBJ_GETTER(Kotlin_ObjCExport_NSErrorAsExceptionImpl, KRef message, KRef error);
 
 extern "C" OBJ_GETTER(Kotlin_ObjCExport_NSErrorAsException, id error) {
@@ -26,6 +26,9 @@
 #include <pthread.h>
 #endif
 #include <unistd.h>
+#if !(defined(KONAN_ANDROID) || KONAN_WINDOWS || KONAN_WASM || KONAN_ZEPHYR)
+#include <sys/uio.h>
+#endif
 #if KONAN_WINDOWS
 #include <windows.h>
 #endif
@@ -68,6 +71,21 @@ void consoleWriteUtf8(const void* utf8, uint32_t sizeBytes) {
 #endif
 }
 
+void consoleWriteUtf8Pair(const void* utf8First, uint32_t firstSizeBytes,
+                          const void* utf8Second, uint32_t secondSizeBytes) {
+#if defined(KONAN_ANDROID) || KONAN_WINDOWS || KONAN_WASM || KONAN_ZEPHYR
+  consoleWriteUtf8(utf8First, firstSizeBytes);
+  consoleWriteUtf8(utf8Second, secondSizeBytes);
+#else
+  struct iovec iov[2];
+  iov[0].iov_base = const_cast<void*>(utf8First);
+  iov[0].iov_len = firstSizeBytes;
+  iov[1].iov_base = const_cast<void*>(utf8Second);
+  iov[1].iov_len = secondSizeBytes;
+  ::writev(STDOUT_FILENO, iov, 2);
+#endif
+}
+
 void consoleErrorUtf8(const void* utf8, uint32_t sizeBytes) {
 #ifdef KONAN_ANDROID
   // TODO: use sizeBytes!
@@ -91,39 +109,45 @@ int getLastErrorMessage(char* message, uint32_t size) {
 }
 #endif
 
-int32_t consoleReadUtf8(void* utf8, uint32_t maxSizeBytes) {
+int32_t consoleReadUtf8Chunk(void* utf8, uint32_t maxSizeBytes) {
 #ifdef KONAN_ZEPHYR
-  return 0;
+  return -1;
 #elif KONAN_WINDOWS
   auto length = 0;
   void *stdInHandle = ::GetStdHandle(STD_INPUT_HANDLE);
   if (::GetFileType(stdInHandle) == FILE_TYPE_CHAR) {
     unsigned long bufferRead;
     // In UTF-16 there are surrogate pairs that a 2 * 16-bit long (4 bytes).
-    auto bufferLength = maxSizeBytes / 4 - 1;
+    auto bufferLength = maxSizeBytes / 4;
     wchar_t buffer[bufferLength];
     if (::ReadConsoleW(stdInHandle, buffer, bufferLength, &bufferRead, NULL)) {
       length = ::WideCharToMultiByte(CP_UTF8, 0, buffer, bufferRead, (char*) utf8,
-                                     maxSizeBytes - 1, NULL, NULL);
+                                     maxSizeBytes, NULL, NULL);
       if (!length && KonanNeedDebugInfo) {
         char msg[512];
         auto errCode = getLastErrorMessage(msg, sizeof(msg));
         consoleErrorf("UTF-16 to UTF-8 conversion error %d: %s", errCode, msg);
       }
-      ((char*) utf8)[length] = 0;
     } else if (KonanNeedDebugInfo) {
       char msg[512];
       auto errCode = getLastErrorMessage(msg, sizeof(msg));
       consoleErrorf("Console read failure: %d %s", errCode, msg);
     }
   } else {
-    length = ::read(STDIN_FILENO, utf8, maxSizeBytes - 1);
+    length = ::read(STDIN_FILENO, utf8, maxSizeBytes);
   }
+  return length <= 0 ? -1 : length;
 #else
-  auto length = ::read(STDIN_FILENO, utf8, maxSizeBytes - 1);
+  auto length = ::read(STDIN_FILENO, utf8, maxSizeBytes);
+  return length <= 0 ? -1 : static_cast<int32_t>(length);
 #endif
+}
+
+int32_t consoleReadUtf8(void* utf8, uint32_t maxSizeBytes) {
+  int32_t length = consoleReadUtf8Chunk(utf8, maxSizeBytes - 1);
   if (length <= 0) return -1;
   char* start = reinterpret_cast<char*>(utf8);
+  start[length] = 0;
   char* current = start + length - 1;
   bool isTrimming = true;
   while (current >= start && isTrimming) {
@@ -247,10 +271,16 @@ void abort(void) {
 void exit(int32_t status) {
   Konan_exit(status);
 }
+void exitUnclean(int32_t status) {
+  Konan_exit(status);
+}
 #else
 void exit(int32_t status) {
   ::exit(status);
 }
+void exitUnclean(int32_t status) {
+  ::_exit(status);
+}
 #endif
 
 // String/byte operations.
@@ -285,32 +315,193 @@ size_t strnlen(const char* buffer, size_t maxSize) {
 // Memory operations.
 #if KONAN_INTERNAL_DLMALLOC
 extern "C" void* dlcalloc(size_t, size_t);
+extern "C" void* dlmalloc(size_t);
 extern "C" void dlfree(void*);
+
+#if KONAN_NO_THREADS || KONAN_WASM || KONAN_ZEPHYR
+// Single-threaded dlmalloc builds take no lock, so there is nothing to cache for.
+extern "C" size_t dlmalloc_usable_size(void*);
 #define calloc_impl dlcalloc
+#define malloc_impl dlmalloc
 #define free_impl dlfree
 #define calloc_aligned_impl(count, size, alignment) dlcalloc(count, size)
+#define calloc_aligned_at_impl(count, size, alignment, offset) dlcalloc(count, size)
+#define usable_size_impl dlmalloc_usable_size
+#else
+
+extern "C" void** dlindependent_calloc(size_t, size_t, void**);
+extern "C" size_t dlbulk_free(void**, size_t);
+extern "C" size_t dlmalloc_usable_size(void*);
+
+namespace {
+
+// Per-thread front-end cache over dlmalloc. dlmalloc serializes every public
+// call on one global lock, so with many workers allocating concurrently the
+// allocator itself becomes the bottleneck. Small allocations - nearly all
+// Kotlin objects - are served from thread-local free lists segregated by size
+// class instead, and dlmalloc is only entered in batches: one
+// dlindependent_calloc to refill a list, one dlbulk_free to flush an
+// overgrown one, each a single lock acquisition for kCacheRefill blocks.
+//
+// Blocks enter a list zeroed (by dlmalloc on refill, by memset on free), so
+// popping one only rewrites the word used as the list link, keeping calloc
+// semantics. Blocks cached by an exiting thread are leaked, the same trade-off
+// the mimalloc-fronting allocator makes.
+constexpr size_t kCacheClassCount = 16;
+constexpr size_t kCacheGranularity = 16;  // Class i serves sizes up to (i + 1) * this.
+constexpr size_t kMaxCachedSize = kCacheClassCount * kCacheGranularity;
+constexpr size_t kCacheRefill = 32;
+constexpr size_t kMaxCachedPerClass = 128;
+
+struct CachedBlock {
+  CachedBlock* next;
+};
+
+THREAD_LOCAL_VARIABLE CachedBlock* cacheFreeLists[kCacheClassCount];
+THREAD_LOCAL_VARIABLE size_t cacheFreeCounts[kCacheClassCount];
+
+// What dlmalloc_usable_size reports for blocks of each class, learned on the
+// first refill. All threads see the same layout, so the benign write race
+// always stores the same value; zero means the class was never refilled and
+// thus no block of it can be in flight.
+size_t cacheClassUsableSize[kCacheClassCount];
+
+inline size_t cacheClassSize(size_t index) {
+  return (index + 1) * kCacheGranularity;
+}
+
+void* cachedCalloc(size_t n_elements, size_t elem_size) {
+  if (elem_size != 0 && n_elements > kMaxCachedSize / elem_size) {
+    return dlcalloc(n_elements, elem_size);
+  }
+  size_t size = n_elements * elem_size;
+  size_t index = size == 0 ? 0 : (size - 1) / kCacheGranularity;
+  CachedBlock* block = cacheFreeLists[index];
+  if (block == nullptr) {
+    void* chunks[kCacheRefill];
+    if (dlindependent_calloc(kCacheRefill, cacheClassSize(index), chunks) == nullptr) {
+      return nullptr;
+    }
+    cacheClassUsableSize[index] = dlmalloc_usable_size(chunks[0]);
+    for (size_t i = 1; i < kCacheRefill; i++) {
+      auto* chained = static_cast<CachedBlock*>(chunks[i]);
+      chained->next = cacheFreeLists[index];
+      cacheFreeLists[index] = chained;
+    }
+    cacheFreeCounts[index] += kCacheRefill - 1;
+    return chunks[0];
+  }
+  cacheFreeLists[index] = block->next;
+  cacheFreeCounts[index]--;
+  // The rest of the block is already zero.
+  block->next = nullptr;
+  return block;
+}
+
+void cachedFree(void* mem) {
+  if (mem != nullptr) {
+    size_t usableSize = dlmalloc_usable_size(mem);
+    for (size_t index = 0; index < kCacheClassCount; index++) {
+      if (cacheClassUsableSize[index] != usableSize) continue;
+      if (cacheFreeCounts[index] >= kMaxCachedPerClass) {
+        // Flush half of the list in one dlmalloc call, keeping the rest warm.
+        void* chunks[kMaxCachedPerClass / 2];
+        for (size_t i = 0; i < kMaxCachedPerClass / 2; i++) {
+          CachedBlock* head = cacheFreeLists[index];
+          cacheFreeLists[index] = head->next;
+          chunks[i] = head;
+        }
+        cacheFreeCounts[index] -= kMaxCachedPerClass / 2;
+        dlbulk_free(chunks, kMaxCachedPerClass / 2);
+      }
+      // Zero here, not on allocation: callers expect calloc semantics.
+      memset(mem, 0, cacheClassSize(index));
+      auto* block = static_cast<CachedBlock*>(mem);
+      block->next = cacheFreeLists[index];
+      cacheFreeLists[index] = block;
+      cacheFreeCounts[index]++;
+      return;
+    }
+  }
+  dlfree(mem);
+}
+
+}  // namespace
+
+#define calloc_impl cachedCalloc
+// Non-zeroed blocks bypass the cache: popping a cached block relies on its
+// content already being zero, and cachedFree re-zeroes anything it keeps, so a
+// dlmalloc'ed block can still be freed through the cached path.
+#define malloc_impl dlmalloc
+#define free_impl cachedFree
+#define calloc_aligned_impl(count, size, alignment) cachedCalloc(count, size)
+#define calloc_aligned_at_impl(count, size, alignment, offset) cachedCalloc(count, size)
+#define usable_size_impl dlmalloc_usable_size
+#endif
 
 #else
 extern "C" void* konan_calloc_impl(size_t, size_t);
+extern "C" void* konan_malloc_impl(size_t);
 extern "C" void konan_free_impl(void*);
 extern "C" void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment);
+extern "C" void* konan_calloc_aligned_at_impl(size_t count, size_t size, size_t alignment, size_t offset);
+extern "C" size_t konan_usable_size_impl(void*);
 #define calloc_impl konan_calloc_impl
+#define malloc_impl konan_malloc_impl
 #define free_impl konan_free_impl
 #define calloc_aligned_impl konan_calloc_aligned_impl
+#define calloc_aligned_at_impl konan_calloc_aligned_at_impl
+#define usable_size_impl konan_usable_size_impl
 #endif
 
 void* calloc(size_t count, size_t size) {
   return calloc_impl(count, size);
 }
 
+void* malloc(size_t size) {
+  return malloc_impl(size);
+}
+
 void* calloc_aligned(size_t count, size_t size, size_t alignment) {
   return calloc_aligned_impl(count, size, alignment);
 }
 
+void* calloc_aligned_at(size_t count, size_t size, size_t alignment, size_t offset) {
+  return calloc_aligned_at_impl(count, size, alignment, offset);
+}
+
 void free(void* pointer) {
   free_impl(pointer);
 }
 
+size_t usableSize(void* pointer) {
+  return pointer == nullptr ? 0 : usable_size_impl(pointer);
+}
+
+#if KONAN_INTERNAL_DLMALLOC
+// dlmalloc has one global heap; the per-thread cache above needs no setup and
+// cannot be attributed or reclaimed per thread.
+void threadHeapInit() {}
+void threadHeapDeinit() {}
+size_t threadHeapUsed() { return 0; }
+#else
+extern "C" void konan_thread_heap_init_impl();
+extern "C" void konan_thread_heap_deinit_impl();
+extern "C" size_t konan_thread_heap_used_impl();
+
+void threadHeapInit() {
+  konan_thread_heap_init_impl();
+}
+
+void threadHeapDeinit() {
+  konan_thread_heap_deinit_impl();
+}
+
+size_t threadHeapUsed() {
+  return konan_thread_heap_used_impl();
+}
+#endif
+
 #if KONAN_INTERNAL_NOW
 
 #ifdef KONAN_ZEPHYR
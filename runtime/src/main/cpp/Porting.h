@@ -29,14 +29,23 @@ void consoleInit();
 void consolePrintf(const char* format, ...);
 void consoleErrorf(const char* format, ...);
 void consoleWriteUtf8(const void* utf8, uint32_t sizeBytes);
+// Writes both chunks to the standard output in one syscall where the platform
+// allows (writev), falling back to two sequential writes elsewhere.
+void consoleWriteUtf8Pair(const void* utf8First, uint32_t firstSizeBytes,
+                          const void* utf8Second, uint32_t secondSizeBytes);
 void consoleErrorUtf8(const void* utf8, uint32_t sizeBytes);
 // Negative return value denotes that read wasn't successful.
 int32_t consoleReadUtf8(void* utf8, uint32_t maxSizeBytes);
+// Reads the next chunk of standard input as is, without trimming line
+// terminators or NUL-terminating. Returns the byte count, or -1 at EOF.
+int32_t consoleReadUtf8Chunk(void* utf8, uint32_t maxSizeBytes);
 void consoleFlush();
 
 // Process control.
 RUNTIME_NORETURN void abort(void);
 RUNTIME_NORETURN void exit(int32_t status);
+// Terminates immediately, skipping atexit handlers and static destructors.
+RUNTIME_NORETURN void exitUnclean(int32_t status);
 
 // Thread control.
 void onThreadExit(void (*destructor)(void*), void* destructorParameter);
@@ -78,7 +87,30 @@ void *memset(void *b, int c, size_t len);
 // Memory operations.
 void* calloc(size_t count, size_t size);
 void* calloc_aligned(size_t count, size_t size, size_t alignment);
+// Like [calloc_aligned], but aligns the address [offset] bytes into the block
+// rather than its start, so a payload behind a fixed-size header can land on a
+// cache line or vector boundary. Only the mimalloc-backed allocator honours
+// the request; the others fall back to plain [calloc].
+void* calloc_aligned_at(size_t count, size_t size, size_t alignment, size_t offset);
+// Like [calloc], but without the zeroing guarantee: the block content is
+// undefined and the caller must overwrite every byte it reads. Freed with the
+// same [free] as calloc'ed blocks.
+void* malloc(size_t size);
 void free(void* ptr);
+// Usable size of a block returned by [calloc], including any allocator slack
+// behind the requested size; 0 when the active allocator cannot tell.
+size_t usableSize(void* ptr);
+
+// Thread heap operations, hooked up to worker lifecycles. Allocator variants
+// without per-thread heaps implement these as no-ops.
+// Gives the calling thread a dedicated heap, so its allocations can be
+// attributed and reclaimed as a unit.
+void threadHeapInit();
+// Returns the calling thread's heap to the allocator in O(1); blocks that
+// escaped the thread stay valid.
+void threadHeapDeinit();
+// The number of bytes currently allocated from the calling thread's heap.
+size_t threadHeapUsed();
 
 // Time operations.
 uint64_t getTimeMillis();
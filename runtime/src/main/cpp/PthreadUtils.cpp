@@ -5,13 +5,39 @@
 
 #include "PthreadUtils.h"
 
+#include <errno.h>
 #include <pthread.h>
 #include <sys/time.h>
 
+#if KONAN_LINUX || KONAN_ANDROID
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "Atomic.h"
+
+#if KONAN_MACOSX || KONAN_IOS || KONAN_TVOS || KONAN_WATCHOS
+// Private Darwin syscalls backing libdispatch and os_unfair_lock; stable in
+// practice and the only futex equivalent the platform has.
+extern "C" int __ulock_wait(uint32_t operation, void* addr, uint64_t value, uint32_t timeoutMicroseconds);
+extern "C" int __ulock_wake(uint32_t operation, void* addr, uint64_t wakeValue);
+#define UL_COMPARE_AND_WAIT 1
+#define ULF_WAKE_ALL 0x00000100
+#endif
+
 namespace {
 
 constexpr int64_t kNanosecondsInASecond = 1000000000LL;
 
+#if !(KONAN_LINUX || KONAN_ANDROID || KONAN_MACOSX || KONAN_IOS || KONAN_TVOS || KONAN_WATCHOS)
+// One shared pair serves every wait word: wakes broadcast and waiters re-check
+// their predicate, which is correct, just less selective than a real futex.
+pthread_mutex_t fallbackLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t fallbackCond = PTHREAD_COND_INITIALIZER;
+#endif
+
 }  // namespace
 
 int WaitOnCondVar(
@@ -40,3 +66,66 @@ int WaitOnCondVar(
 
   return result;
 }
+
+int FutexWait(int32_t* word, int32_t expected, int64_t timeoutNanoseconds) {
+#if KONAN_LINUX || KONAN_ANDROID
+  struct timespec ts;
+  struct timespec* tsPtr = nullptr;
+  if (timeoutNanoseconds >= 0) {
+    ts.tv_sec = timeoutNanoseconds / kNanosecondsInASecond;
+    ts.tv_nsec = timeoutNanoseconds % kNanosecondsInASecond;
+    tsPtr = &ts;
+  }
+  long result = syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, tsPtr, nullptr, 0);
+  return (result != 0 && errno == ETIMEDOUT) ? ETIMEDOUT : 0;
+#elif KONAN_MACOSX || KONAN_IOS || KONAN_TVOS || KONAN_WATCHOS
+  uint32_t timeoutMicroseconds = 0;  // Zero waits forever.
+  if (timeoutNanoseconds >= 0) {
+    uint64_t micros = (static_cast<uint64_t>(timeoutNanoseconds) + 999) / 1000;
+    if (micros == 0) micros = 1;
+    if (micros > 0xFFFFFFFFULL) micros = 0xFFFFFFFFULL;
+    timeoutMicroseconds = static_cast<uint32_t>(micros);
+  }
+  int result = __ulock_wait(UL_COMPARE_AND_WAIT, word, static_cast<uint64_t>(static_cast<uint32_t>(expected)),
+                            timeoutMicroseconds);
+  return (result < 0 && errno == ETIMEDOUT) ? ETIMEDOUT : 0;
+#else
+  int result = 0;
+  pthread_mutex_lock(&fallbackLock);
+  if (atomicGet(word) == expected) {
+    if (timeoutNanoseconds >= 0) {
+      result = WaitOnCondVar(&fallbackCond, &fallbackLock, static_cast<uint64_t>(timeoutNanoseconds));
+    } else {
+      pthread_cond_wait(&fallbackCond, &fallbackLock);
+    }
+  }
+  pthread_mutex_unlock(&fallbackLock);
+  return result == ETIMEDOUT ? ETIMEDOUT : 0;
+#endif
+}
+
+void FutexWakeOne(int32_t* word) {
+#if KONAN_LINUX || KONAN_ANDROID
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif KONAN_MACOSX || KONAN_IOS || KONAN_TVOS || KONAN_WATCHOS
+  __ulock_wake(UL_COMPARE_AND_WAIT, word, 0);
+#else
+  // The lock orders this wake after a concurrent waiter's predicate check;
+  // broadcasting compensates for all words sharing one condition variable.
+  pthread_mutex_lock(&fallbackLock);
+  pthread_cond_broadcast(&fallbackCond);
+  pthread_mutex_unlock(&fallbackLock);
+#endif
+}
+
+void FutexWakeAll(int32_t* word) {
+#if KONAN_LINUX || KONAN_ANDROID
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 0x7FFFFFFF, nullptr, nullptr, 0);
+#elif KONAN_MACOSX || KONAN_IOS || KONAN_TVOS || KONAN_WATCHOS
+  __ulock_wake(UL_COMPARE_AND_WAIT | ULF_WAKE_ALL, word, 0);
+#else
+  pthread_mutex_lock(&fallbackLock);
+  pthread_cond_broadcast(&fallbackCond);
+  pthread_mutex_unlock(&fallbackLock);
+#endif
+}
@@ -17,4 +17,19 @@ int WaitOnCondVar(
     uint64_t timeoutNanoseconds,
     uint64_t* microsecondsPassed = nullptr);
 
+// Lightweight waiting on a plain 4-byte word, backed by futex on Linux/Android
+// and __ulock on Darwin, with a shared mutex+condvar pair as the portable
+// fallback. No kernel object exists per word, and an uncontended wake is much
+// cheaper than signalling a condition variable.
+//
+// Blocks while *word == expected. May wake up spuriously, so callers must
+// re-check their predicate in a loop. A negative timeout waits forever.
+// Returns ETIMEDOUT when the timeout elapsed, 0 otherwise.
+int FutexWait(int32_t* word, int32_t expected, int64_t timeoutNanoseconds);
+
+// Wakes one or all threads blocked in FutexWait on the given word. The word
+// itself must be updated before calling, or the wakeup can be missed.
+void FutexWakeOne(int32_t* word);
+void FutexWakeAll(int32_t* word);
+
 #endif  // RUNTIME_PTHREAD_UTILS_H
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
+
 #include "Alloc.h"
 #include "Atomic.h"
 #include "Cleaner.h"
@@ -23,18 +25,38 @@
 #include "ObjCExportInit.h"
 #include "Porting.h"
 #include "Runtime.h"
+#include "RuntimeConfig.h"
 #include "Worker.h"
 
+extern "C" void Kotlin_io_Console_flush();
+extern "C" void Kotlin_io_Console_setOutputBuffer(KInt sizeBytes, KBoolean autoFlushOnNewline);
+// Defined in Time.cpp.
+extern "C" void Kotlin_system_checkpointTimeBases();
+extern "C" void Kotlin_system_rebaseTimeAfterRestore();
+
 typedef void (*Initializer)(int initialize, MemoryState* memory);
 struct InitNode {
   Initializer init;
   InitNode* next;
 };
 
+// A lazily initialized counterpart of InitNode: the global init phase of [node.init]
+// only runs on the first EnsureGlobalsInitialized() call, the other phases follow the
+// regular initializer list protocol.
+struct LazyInitNode {
+  InitNode node;
+  // Non-zero once the global init phase ran; the only load on the hot path.
+  int32_t initialized;
+  // Taken by the thread running the initializer.
+  int32_t initializing;
+};
+
 namespace {
 
 InitNode* initHeadNode = nullptr;
 InitNode* initTailNode = nullptr;
+LazyInitNode* lazyInitHeadNode = nullptr;
+LazyInitNode* lazyInitTailNode = nullptr;
 
 enum class RuntimeStatus {
     kUninitialized,
@@ -55,16 +77,39 @@ enum {
   DEINIT_GLOBALS = 3
 };
 
+// Note on startup snapshots: it was considered to serialize the post-init global state
+// into a mappable image and skip these initializers on subsequent launches. This cannot
+// be done from the runtime alone: initialized values live in heap containers referenced
+// from compiler-emitted global storage, so an image needs pointer relocation and a
+// compiler-side manifest of global slots, and initializers are free to have side effects
+// beyond the object graph. If this is ever revisited it has to start in the compiler
+// (emitting initializer results as permanent objects where they are provably constant),
+// with this loop only skipping nodes the image already covers.
 void InitOrDeinitGlobalVariables(int initialize, MemoryState* memory) {
   InitNode* currentNode = initHeadNode;
   while (currentNode != nullptr) {
     currentNode->init(initialize, memory);
     currentNode = currentNode->next;
   }
+  // Lazy nodes skip the global init phase here (that is their point), take part in the
+  // thread local phases as usual, and are deinitialized only if they ever ran.
+  if (initialize == INIT_GLOBALS) return;
+  LazyInitNode* currentLazyNode = lazyInitHeadNode;
+  while (currentLazyNode != nullptr) {
+    if (initialize != DEINIT_GLOBALS || atomicGet(&currentLazyNode->initialized) != 0) {
+      currentLazyNode->node.init(initialize, memory);
+    }
+    currentLazyNode = reinterpret_cast<LazyInitNode*>(currentLazyNode->node.next);
+  }
 }
 
 KBoolean g_checkLeaks = KonanNeedDebugInfo;
 KBoolean g_checkLeakedCleaners = KonanNeedDebugInfo;
+// Fast shutdown skips the final GC, finalizer cascades and worker teardown on
+// process exit, letting the OS reclaim the heap; buffered console output is
+// still flushed. -1 means "not decided yet": the first query consults the
+// KONAN_FAST_SHUTDOWN environment variable.
+int32_t g_fastShutdown = -1;
 
 constexpr RuntimeState* kInvalidRuntime = nullptr;
 
@@ -79,6 +124,9 @@ volatile int aliveRuntimesCount = 0;
 
 RuntimeState* initRuntime() {
   SetKonanTerminateHandler();
+  // Force the one-time config parse before anything consulting it runs; the
+  // worker constructed below already reads the spin parameters.
+  const KonanRuntimeConfig& config = konanRuntimeConfig();
   RuntimeState* result = konanConstructInstance<RuntimeState>();
   if (!result) return kInvalidRuntime;
   RuntimeCheck(!isValidRuntime(), "No active runtimes allowed");
@@ -90,6 +138,9 @@ RuntimeState* initRuntime() {
   if (firstRuntime) {
     isMainThread = 1;
     konan::consoleInit();
+    if (config.consoleOutputBufferBytes > 0) {
+      Kotlin_io_Console_setOutputBuffer(config.consoleOutputBufferBytes, true);
+    }
 #if KONAN_OBJC_INTEROP
     Kotlin_ObjCExport_initialize();
 #endif
@@ -107,6 +158,8 @@ void deinitRuntime(RuntimeState* state) {
   // This may be called after TLS is zeroed out, so ::memoryState in Memory cannot be trusted.
   RestoreMemory(state->memoryState);
   bool lastRuntime = atomicAdd(&aliveRuntimesCount, -1) == 0;
+  if (lastRuntime)
+    Kotlin_io_Console_flush();
   InitOrDeinitGlobalVariables(DEINIT_THREAD_LOCAL_GLOBALS, state->memoryState);
   if (lastRuntime)
     InitOrDeinitGlobalVariables(DEINIT_GLOBALS, state->memoryState);
@@ -136,6 +189,27 @@ void AppendToInitializersTail(InitNode *next) {
   initTailNode = next;
 }
 
+void AppendToLazyInitializersTail(LazyInitNode* next) {
+  if (lazyInitHeadNode == nullptr) {
+    lazyInitHeadNode = next;
+  } else {
+    lazyInitTailNode->node.next = &next->node;
+  }
+  lazyInitTailNode = next;
+}
+
+void EnsureGlobalsInitialized(LazyInitNode* node) {
+  if (atomicGet(&node->initialized) != 0) return;
+  if (compareAndSet(&node->initializing, 0, 1)) {
+    node->node.init(INIT_GLOBALS, ::runtimeState->memoryState);
+    atomicSet(&node->initialized, 1);
+  } else {
+    // Some other thread runs the initializer, wait for it. A cycle between file
+    // initializers would spin here forever; breaking those up is on the compiler.
+    while (atomicGet(&node->initialized) == 0) {}
+  }
+}
+
 void Kotlin_initRuntimeIfNeeded() {
   if (!isValidRuntime()) {
     initRuntime();
@@ -151,6 +225,51 @@ void Kotlin_deinitRuntimeIfNeeded() {
   }
 }
 
+void* Kotlin_suspendCurrentRuntime() {
+  RuntimeCheck(isValidRuntime(), "Runtime must be active on the current thread");
+  RuntimeState* state = ::runtimeState;
+  RuntimeAssert(state->status == RuntimeStatus::kRunning, "Runtime must be in the running state");
+  SuspendMemory();
+  Worker* worker = WorkerSuspend();
+  RuntimeAssert(worker == state->worker, "Bound worker must belong to the suspended runtime");
+  ::runtimeState = kInvalidRuntime;
+  return state;
+}
+
+void Kotlin_resumeRuntime(void* handle) {
+  RuntimeCheck(!isValidRuntime(), "Another runtime is active on the current thread");
+  RuntimeState* state = reinterpret_cast<RuntimeState*>(handle);
+  RuntimeCheck(state != nullptr && state->status == RuntimeStatus::kRunning,
+               "Handle must refer to a suspended runtime");
+  ::runtimeState = state;
+  ResumeMemory(state->memoryState);
+  WorkerResume(state->worker);
+}
+
+void Kotlin_checkpointRuntime() {
+  RuntimeCheck(isValidRuntime(), "Runtime must be active on the checkpointing thread");
+  Kotlin_io_Console_flush();
+  // Compact the heap so the dumped image carries no garbage.
+  PerformFullGC();
+  // Execute pending cleaners and stop the cleaner worker thread;
+  // restore re-arms it lazily.
+  ShutdownCleaners(true);
+  // Wait for threads of already terminated workers to exit. Workers the program
+  // still keeps running are its own responsibility to quiesce before dumping.
+  WaitNativeWorkersTermination();
+  Kotlin_system_checkpointTimeBases();
+}
+
+void Kotlin_restoreRuntimeAfterCheckpoint() {
+  RuntimeCheck(isValidRuntime(), "Runtime must be active on the restoring thread");
+  // The monotonic clock base is generally different after resurrection,
+  // possibly on another boot of another machine.
+  Kotlin_system_rebaseTimeAfterRestore();
+  konan::consoleInit();
+  // The next scheduled cleaner lazily creates a fresh worker thread.
+  ResetCleanerWorker();
+}
+
 void CheckIsMainThread() {
   if (!isMainThread)
     ThrowIncorrectDereferenceException();
@@ -240,6 +359,28 @@ bool Kotlin_cleanersLeakCheckerEnabled() {
     return g_checkLeakedCleaners;
 }
 
+bool Kotlin_fastShutdownEnabled() {
+  int32_t current = atomicGet(&g_fastShutdown);
+  if (current == -1) {
+#if KONAN_WASM || KONAN_ZEPHYR
+    current = 0;
+#else
+    const char* value = ::getenv("KONAN_FAST_SHUTDOWN");
+    current = (value != nullptr && value[0] == '1') ? 1 : 0;
+#endif
+    atomicSet(&g_fastShutdown, current);
+  }
+  return current != 0;
+}
+
+KBoolean Konan_Platform_getFastShutdown() {
+  return Kotlin_fastShutdownEnabled();
+}
+
+void Konan_Platform_setFastShutdown(KBoolean value) {
+  atomicSet(&g_fastShutdown, value ? 1 : 0);
+}
+
 KBoolean Konan_Platform_getCleanersLeakChecker() {
     return g_checkLeakedCleaners;
 }
@@ -20,6 +20,7 @@
 #include "Porting.h"
 
 struct InitNode;
+struct LazyInitNode;
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,13 +29,55 @@ extern "C" {
 void Kotlin_initRuntimeIfNeeded();
 void Kotlin_deinitRuntimeIfNeeded();
 
+// Several isolated runtimes may coexist in one process: each init creates a private
+// heap (MemoryState) and worker, while compiler-emitted permanent data (TypeInfos,
+// string literals, permanent objects) is read-only and shared among all of them for
+// free. A host thread embedding more than one Kotlin library interleaves them by
+// detaching the active runtime and re-attaching it later:
+//
+//   void* handle = Kotlin_suspendCurrentRuntime();  // detach library A
+//   Kotlin_initRuntimeIfNeeded();                   // or resume library B, call into it
+//   ...
+//   Kotlin_resumeRuntime(handle);                   // back to library A
+//
+// Both calls are cheap thread-local pointer swaps. They must be made outside any
+// Kotlin frame (not from a Kotlin callback), at most one runtime may be attached to
+// a thread at a time, and a suspended runtime must be resumed on the same thread
+// before it is deinitialized or the thread exits.
+void* Kotlin_suspendCurrentRuntime();
+void Kotlin_resumeRuntime(void* handle);
+
+// Quiesces the runtime so the process image can be checkpointed (e.g. with CRIU):
+// flushes console output, compacts the heap, runs and stops the cleaner worker, and
+// waits for threads of terminated workers to exit. Workers the program keeps running
+// must be quiesced by the caller before dumping. Call on the main thread.
+void Kotlin_checkpointRuntime();
+
+// Counterpart of Kotlin_checkpointRuntime, to be called right after the process is
+// resurrected from its image: re-arms the cleaner worker and rebases monotonic
+// clocks so Kotlin-visible time continues from its checkpointed values.
+void Kotlin_restoreRuntimeAfterCheckpoint();
+
 // Appends given node to an initializer list.
 void AppendToInitializersTail(struct InitNode*);
 
+// Appends given node to the lazy initializer list: its global init phase is deferred
+// until the first EnsureGlobalsInitialized() call for the node, while thread local
+// and deinit phases keep running with the regular initializer list.
+void AppendToLazyInitializersTail(struct LazyInitNode*);
+
+// Runs the global init phase of the node if it has not run yet. The initialized
+// fast path is a single load; initialization cycles between files are the caller's
+// (i.e. the compiler's) responsibility.
+void EnsureGlobalsInitialized(struct LazyInitNode*);
+
 bool Kotlin_memoryLeakCheckerEnabled();
 
 bool Kotlin_cleanersLeakCheckerEnabled();
 
+// Whether process exit skips heap teardown entirely, see Platform.isFastShutdownEnabled.
+bool Kotlin_fastShutdownEnabled();
+
 #ifdef __cplusplus
 }
 #endif
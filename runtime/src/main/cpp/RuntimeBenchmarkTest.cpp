@@ -0,0 +1,116 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// Microbenchmarks for runtime primitives. These ride the regular gtest runner, so they
+// can be executed per target without building a full Kotlin application; each case
+// prints ns/op to compare releases. They only assert basic sanity of the results,
+// wall-clock numbers are reported, not enforced.
+
+#include <cstdio>
+
+#include "gtest/gtest.h"
+
+#include "KString.h"
+#include "Memory.h"
+#include "Porting.h"
+#include "Runtime.h"
+#include "TypeInfo.h"
+#include "Types.h"
+
+extern "C" OBJ_GETTER(Kotlin_String_plusImpl, KString thiz, KString other);
+
+namespace {
+
+constexpr int kIterations = 100000;
+
+// Runs op() kIterations times after a short warmup and reports the average cost.
+template <typename F>
+void reportBenchmark(const char* name, F op) {
+  for (int i = 0; i < kIterations / 10 + 1; ++i) op();
+  uint64_t start = konan::getTimeMicros();
+  for (int i = 0; i < kIterations; ++i) op();
+  uint64_t elapsedMicros = konan::getTimeMicros() - start;
+  std::printf("[ BENCH    ] %s: %.1f ns/op (%d ops in %lld us)\n",
+      name, elapsedMicros * 1000.0 / kIterations, kIterations,
+      static_cast<long long>(elapsedMicros));
+}
+
+// The compiler-generated type infos in the test support library are zero-filled,
+// so element sizes needed by string/array allocation are patched in once here.
+void ensureTypeInfosUsable() {
+  auto* stringType = const_cast<TypeInfo*>(theStringTypeInfo);
+  if (stringType->typeInfo_ == nullptr) {
+    stringType->typeInfo_ = stringType;
+    stringType->instanceSize_ = -static_cast<int32_t>(sizeof(KChar));
+  }
+}
+
+// A plain object type with a few primitive fields and no references.
+TypeInfo benchObjectTypeInfo() {
+  TypeInfo result = {};
+  result.typeInfo_ = nullptr;
+  result.instanceSize_ = 48;
+  result.objOffsetsCount_ = 0;
+  return result;
+}
+
+}  // namespace
+
+TEST(RuntimeBenchmark, AllocInstance) {
+  Kotlin_initRuntimeIfNeeded();
+  static TypeInfo type = benchObjectTypeInfo();
+  type.typeInfo_ = &type;
+  reportBenchmark("AllocInstance(48 bytes)", []() {
+    ObjHolder holder;
+    AllocInstance(&type, holder.slot());
+    ASSERT_NE(holder.obj(), nullptr);
+  });
+}
+
+TEST(RuntimeBenchmark, UpdateHeapRef) {
+  Kotlin_initRuntimeIfNeeded();
+  static TypeInfo type = benchObjectTypeInfo();
+  type.typeInfo_ = &type;
+  ObjHolder holder;
+  AllocInstance(&type, holder.slot());
+  static ObjHeader* location = nullptr;
+  KRef obj = holder.obj();
+  reportBenchmark("UpdateHeapRef", [obj]() {
+    UpdateHeapRef(&location, obj);
+    UpdateHeapRef(&location, nullptr);
+  });
+}
+
+TEST(RuntimeBenchmark, StringPlus) {
+  Kotlin_initRuntimeIfNeeded();
+  ensureTypeInfosUsable();
+  ObjHolder leftHolder, rightHolder;
+  CreateStringFromCString("benchmark left operand ", leftHolder.slot());
+  CreateStringFromCString("and the right one", rightHolder.slot());
+  KString left = leftHolder.obj()->array();
+  KString right = rightHolder.obj()->array();
+  reportBenchmark("Kotlin_String_plusImpl", [left, right]() {
+    ObjHolder result;
+    Kotlin_String_plusImpl(left, right, result.slot());
+    ASSERT_NE(result.obj(), nullptr);
+  });
+}
+
+TEST(RuntimeBenchmark, LookupInterfaceTableRecord) {
+  constexpr int tableSize = 64;
+  InterfaceTableRecord table[tableSize] = {};
+  for (int i = 0; i < tableSize; ++i) {
+    table[i].id = (i + 1) * 2;
+  }
+  int found = 0;
+  reportBenchmark("LookupInterfaceTableRecord(64 entries)", [&table, &found]() {
+    // Mix of ids present in the table, hitting different probe paths.
+    for (ClassId id = 2; id <= tableSize * 2; id += 14) {
+      auto const* record = LookupInterfaceTableRecord(table, tableSize, id);
+      if (record->id == id) ++found;
+    }
+  });
+  EXPECT_GT(found, 0);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "RuntimeConfig.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Format.h"
+#include "KString.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "Porting.h"
+#include "Types.h"
+
+extern "C" {
+KInt Kotlin_native_internal_GC_getThreshold(KRef);
+KLong Kotlin_native_internal_GC_getThresholdAllocations(KRef);
+}
+
+namespace {
+
+KonanRuntimeConfig g_config;
+bool g_configInitialized = false;
+
+#if !KONAN_WASM && !KONAN_ZEPHYR
+
+constexpr int64_t kMaxInt32 = 0x7FFFFFFF;
+constexpr size_t kMaxConfigFileSize = 16 * 1024;
+
+bool parseInteger(const char* text, int64_t* result) {
+  char* end = nullptr;
+  long long parsed = strtoll(text, &end, 10);
+  if (end == text || *end != '\0') return false;
+  *result = parsed;
+  return true;
+}
+
+// Accepts values in [min, max]; anything else is reported and keeps the default.
+bool checkRange(const char* key, int64_t value, int64_t min, int64_t max) {
+  if (value >= min && value <= max) return true;
+  konan::consoleErrorf("Ignored runtime config entry out of range: %s=%lld\n",
+                       key, static_cast<long long>(value));
+  return false;
+}
+
+void applyEntry(const char* key, const char* valueText) {
+  int64_t value;
+  if (!parseInteger(valueText, &value)) {
+    konan::consoleErrorf("Ignored runtime config entry with non-integer value: %s=%s\n", key, valueText);
+    return;
+  }
+  if (strcmp(key, "gcThreshold") == 0) {
+    if (checkRange(key, value, 1, kMaxInt32)) g_config.gcThreshold = static_cast<int32_t>(value);
+  } else if (strcmp(key, "gcThresholdAllocations") == 0) {
+    if (checkRange(key, value, 1, INT64_MAX)) g_config.gcThresholdAllocations = value;
+  } else if (strcmp(key, "workerSpinIterations") == 0) {
+    if (checkRange(key, value, 0, kMaxInt32)) g_config.workerSpinIterations = static_cast<int32_t>(value);
+  } else if (strcmp(key, "workerSpinGapMicroseconds") == 0) {
+    if (checkRange(key, value, 0, INT64_MAX)) g_config.workerSpinGapMicroseconds = value;
+  } else if (strcmp(key, "consoleOutputBufferBytes") == 0) {
+    if (checkRange(key, value, 0, kMaxInt32)) g_config.consoleOutputBufferBytes = static_cast<int32_t>(value);
+  } else if (strcmp(key, "deferredRefCounting") == 0) {
+    if (checkRange(key, value, 0, 1)) g_config.deferredRefCounting = static_cast<int32_t>(value);
+  } else if (strcmp(key, "stackTraceDepth") == 0) {
+    if (checkRange(key, value, 1, kMaxInt32)) g_config.stackTraceDepth = static_cast<int32_t>(value);
+  } else {
+    konan::consoleErrorf("Ignored unknown runtime config key: %s\n", key);
+  }
+}
+
+// Destructively tokenizes text into key=value entries separated by commas,
+// semicolons or newlines, with surrounding whitespace stripped.
+void parseEntries(char* text) {
+  char* cursor = text;
+  while (*cursor != '\0') {
+    char* entry = cursor;
+    while (*cursor != '\0' && *cursor != ',' && *cursor != ';' && *cursor != '\n') cursor++;
+    if (*cursor != '\0') *cursor++ = '\0';
+    while (*entry == ' ' || *entry == '\t' || *entry == '\r') entry++;
+    char* entryEnd = entry + strlen(entry);
+    while (entryEnd > entry
+           && (entryEnd[-1] == ' ' || entryEnd[-1] == '\t' || entryEnd[-1] == '\r')) {
+      *--entryEnd = '\0';
+    }
+    if (*entry == '\0') continue;
+    char* equals = strchr(entry, '=');
+    if (equals == nullptr) {
+      konan::consoleErrorf("Ignored malformed runtime config entry: %s\n", entry);
+      continue;
+    }
+    *equals = '\0';
+    // Also allow whitespace around the '=' itself.
+    char* keyEnd = equals;
+    while (keyEnd > entry && (keyEnd[-1] == ' ' || keyEnd[-1] == '\t')) *--keyEnd = '\0';
+    char* value = equals + 1;
+    while (*value == ' ' || *value == '\t') value++;
+    applyEntry(entry, value);
+  }
+}
+
+void parseFile(const char* path) {
+  FILE* file = ::fopen(path, "rb");
+  if (file == nullptr) {
+    konan::consoleErrorf("Cannot open runtime config file: %s\n", path);
+    return;
+  }
+  char* contents = reinterpret_cast<char*>(konan::calloc(1, kMaxConfigFileSize + 1));
+  if (contents != nullptr) {
+    size_t size = ::fread(contents, 1, kMaxConfigFileSize, file);
+    contents[size] = '\0';
+    parseEntries(contents);
+    konan::free(contents);
+  }
+  ::fclose(file);
+}
+
+#endif  // !KONAN_WASM && !KONAN_ZEPHYR
+
+void initializeConfig() {
+  g_configInitialized = true;
+#if !KONAN_WASM && !KONAN_ZEPHYR
+  // The environment variable takes precedence over the file, so a single
+  // process can be tuned without editing a shared deployment config.
+  const char* filePath = ::getenv("KONAN_RUNTIME_CONFIG_FILE");
+  if (filePath != nullptr && filePath[0] != '\0') parseFile(filePath);
+  const char* env = ::getenv("KONAN_RUNTIME_CONFIG");
+  if (env != nullptr && env[0] != '\0') {
+    size_t length = strlen(env);
+    char* copy = reinterpret_cast<char*>(konan::calloc(1, length + 1));
+    if (copy != nullptr) {
+      memcpy(copy, env, length);
+      parseEntries(copy);
+      konan::free(copy);
+    }
+  }
+#endif
+}
+
+}  // namespace
+
+const KonanRuntimeConfig& konanRuntimeConfig() {
+  // The first runtime initialization calls this before any other thread can
+  // exist, so the lazy parse is effectively single-threaded.
+  if (!g_configInitialized) initializeConfig();
+  return g_config;
+}
+
+extern "C" {
+
+// Effective tuning values in the same key=value syntax the config accepts.
+// GC values are queried live, so adjustments made through the GC API after
+// startup are reflected here.
+OBJ_GETTER0(Konan_Platform_getRuntimeConfiguration) {
+  const KonanRuntimeConfig& config = konanRuntimeConfig();
+  char buffer[256];
+  konan::FormatBuffer out(buffer, sizeof(buffer));
+  out.append("gcThreshold=").append(Kotlin_native_internal_GC_getThreshold(nullptr));
+  out.append(",gcThresholdAllocations=").append(Kotlin_native_internal_GC_getThresholdAllocations(nullptr));
+  out.append(",workerSpinIterations=").append(config.workerSpinIterations);
+  out.append(",workerSpinGapMicroseconds=").append(config.workerSpinGapMicroseconds);
+  out.append(",consoleOutputBufferBytes=").append(config.consoleOutputBufferBytes);
+  out.append(",stackTraceDepth=").append(config.stackTraceDepth);
+  RETURN_RESULT_OF(CreateStringFromCString, out.data());
+}
+
+}  // extern "C"
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_RUNTIME_CONFIG_H
+#define RUNTIME_RUNTIME_CONFIG_H
+
+#include <stdint.h>
+
+// Consolidated runtime tuning knobs, read once when the first runtime
+// initializes from the KONAN_RUNTIME_CONFIG environment variable, or from the
+// file named by KONAN_RUNTIME_CONFIG_FILE. Both use the same syntax: key=value
+// entries separated by commas, semicolons or newlines, e.g.
+//
+//   KONAN_RUNTIME_CONFIG="gcThreshold=16000,workerSpinIterations=0"
+//
+// Unknown keys and unparsable values are reported to stderr and ignored, so a
+// stale deployment config never prevents startup. Absent keys keep the
+// defaults below, which match the previously hardcoded values.
+struct KonanRuntimeConfig {
+  // Objects allocated between GC cycle collection attempts (legacy MM).
+  // Applied through the regular GC API; -1 keeps the memory manager default.
+  int32_t gcThreshold = -1;
+  // Allocation count triggering a GC (legacy MM); -1 keeps the default.
+  int64_t gcThresholdAllocations = -1;
+  // How long a worker polls its inbox before parking, and up to which average
+  // queue-refill gap the polling is considered worthwhile. See
+  // Worker::waitForQueueLocked; zero iterations disable spinning entirely.
+  int32_t workerSpinIterations = 1024;
+  int64_t workerSpinGapMicroseconds = 128;
+  // Runtime-managed stdout buffer size; 0 keeps output unbuffered. A buffer
+  // configured here flushes on newlines, see Console.setOutputBuffer.
+  int32_t consoleOutputBufferBytes = 0;
+  // Starts every thread with deferred reference counting (legacy strict MM),
+  // the cheapest per-thread regime the memory model choice leaves open at
+  // runtime; 0/1, -1 keeps it off. Individual threads can still flip it
+  // through the GC API, e.g. off for threads running untrusted plugin code.
+  int32_t deferredRefCounting = -1;
+  // Frame cap for stack trace capture, bounded by the runtime's on-stack
+  // buffers (256 frames); -1 keeps the capture mechanism's own default
+  // (32 frames, 64 for fast frame-pointer capture), see Exceptions.cpp.
+  int32_t stackTraceDepth = -1;
+};
+
+// The effective configuration. The first call parses the environment; the
+// first runtime initialization makes that call before any worker exists, so
+// later concurrent readers only ever see the final values.
+const KonanRuntimeConfig& konanRuntimeConfig();
+
+#endif  // RUNTIME_RUNTIME_CONFIG_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "RuntimeCounters.h"
+
+#include <stdio.h>
+
+#include "Exceptions.h"
+#include "KString.h"
+#include "Memory.h"
+#include "Types.h"
+
+int64_t g_runtimeCounters[RTC_COUNTERS_COUNT] = {};
+
+namespace {
+
+// Kept in sync with RuntimeCounter; names double as JSON keys.
+const char* const kCounterNames[RTC_COUNTERS_COUNT] = {
+    "alloc_up_to_32",
+    "alloc_up_to_256",
+    "alloc_up_to_4k",
+    "alloc_large",
+    "rc_atomic_inc",
+    "rc_atomic_dec",
+    "gc_count",
+    "gc_pause_total_micros",
+    "gc_last_pause_micros",
+    "gc_last_start_micros",
+    "worker_jobs_enqueued",
+    "worker_jobs_executed",
+    "workers_started",
+    "string_allocs",
+    "string_chars",
+};
+
+}  // namespace
+
+extern "C" {
+
+int32_t Kotlin_native_internal_runtimeCountersCount() {
+  return RTC_COUNTERS_COUNT;
+}
+
+int64_t Kotlin_native_internal_runtimeCounterValue(int32_t index) {
+  if (index < 0 || index >= RTC_COUNTERS_COUNT)
+    ThrowArrayIndexOutOfBoundsException();
+  return CounterGet(static_cast<RuntimeCounter>(index));
+}
+
+const char* RuntimeCounterName(int32_t index) {
+  RuntimeAssert(index >= 0 && index < RTC_COUNTERS_COUNT, "Counter index out of range");
+  return kCounterNames[index];
+}
+
+OBJ_GETTER(Kotlin_native_internal_runtimeCounterName, KInt index) {
+  if (index < 0 || index >= RTC_COUNTERS_COUNT)
+    ThrowArrayIndexOutOfBoundsException();
+  RETURN_RESULT_OF(CreateStringFromCString, kCounterNames[index]);
+}
+
+OBJ_GETTER0(Kotlin_native_internal_runtimeCountersJson) {
+  KStdString json;
+  json.reserve(RTC_COUNTERS_COUNT * 32);
+  json += "{";
+  char buffer[64];
+  for (int32_t i = 0; i < RTC_COUNTERS_COUNT; i++) {
+    snprintf(buffer, sizeof(buffer), "%s\"%s\":%lld", i == 0 ? "" : ",",
+             kCounterNames[i],
+             static_cast<long long>(CounterGet(static_cast<RuntimeCounter>(i))));
+    json += buffer;
+  }
+  json += "}";
+  RETURN_RESULT_OF(CreateStringFromCString, json.c_str());
+}
+
+}  // extern "C"
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_RUNTIMECOUNTERS_H
+#define RUNTIME_RUNTIMECOUNTERS_H
+
+#include <stdint.h>
+
+#include "Common.h"
+
+// Always-on, always-cheap event counters for the runtime hot paths. Each counter is
+// a single relaxed atomic increment, so instrumentation stays affordable in release
+// builds; readers observe values that may lag concurrent writers by a few events.
+enum RuntimeCounter {
+  // Object/container allocations bucketed by size.
+  RTC_ALLOC_UP_TO_32 = 0,
+  RTC_ALLOC_UP_TO_256,
+  RTC_ALLOC_UP_TO_4K,
+  RTC_ALLOC_LARGE,
+  // Atomic reference count operations (shared objects only).
+  RTC_RC_ATOMIC_INC,
+  RTC_RC_ATOMIC_DEC,
+  // Garbage collection.
+  RTC_GC_COUNT,
+  RTC_GC_PAUSE_TOTAL_MICROS,
+  RTC_GC_LAST_PAUSE_MICROS,
+  RTC_GC_LAST_START_MICROS,
+  // Workers: queue depth is jobs enqueued minus jobs executed.
+  RTC_WORKER_JOBS_ENQUEUED,
+  RTC_WORKER_JOBS_EXECUTED,
+  RTC_WORKERS_STARTED,
+  // String conversions.
+  RTC_STRING_ALLOCS,
+  RTC_STRING_CHARS,
+
+  RTC_COUNTERS_COUNT
+};
+
+extern int64_t g_runtimeCounters[RTC_COUNTERS_COUNT];
+
+ALWAYS_INLINE inline void CounterAdd(RuntimeCounter counter, int64_t value) {
+  __atomic_fetch_add(&g_runtimeCounters[counter], value, __ATOMIC_RELAXED);
+}
+
+ALWAYS_INLINE inline void CounterIncrement(RuntimeCounter counter) {
+  CounterAdd(counter, 1);
+}
+
+// For gauges like "last pause": plain overwrite, still relaxed.
+ALWAYS_INLINE inline void CounterSet(RuntimeCounter counter, int64_t value) {
+  __atomic_store_n(&g_runtimeCounters[counter], value, __ATOMIC_RELAXED);
+}
+
+ALWAYS_INLINE inline int64_t CounterGet(RuntimeCounter counter) {
+  return __atomic_load_n(&g_runtimeCounters[counter], __ATOMIC_RELAXED);
+}
+
+// Records an allocation of `size` bytes in the matching size-class bucket.
+ALWAYS_INLINE inline void CounterRecordAllocation(uint64_t size) {
+  if (size <= 32) CounterIncrement(RTC_ALLOC_UP_TO_32);
+  else if (size <= 256) CounterIncrement(RTC_ALLOC_UP_TO_256);
+  else if (size <= 4096) CounterIncrement(RTC_ALLOC_UP_TO_4K);
+  else CounterIncrement(RTC_ALLOC_LARGE);
+}
+
+extern "C" {
+
+int32_t Kotlin_native_internal_runtimeCountersCount() RUNTIME_NOTHROW;
+int64_t Kotlin_native_internal_runtimeCounterValue(int32_t index);
+const char* RuntimeCounterName(int32_t index) RUNTIME_NOTHROW;
+
+}  // extern "C"
+
+#endif // RUNTIME_RUNTIMECOUNTERS_H
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// Stress scenarios for the runtime C++ API: multi-threaded allocation storms,
+// freeze churn and atomic-reference contention. They ride the regular gtest
+// runner like the microbenchmarks, but run for a configurable wall-clock
+// duration and track per-batch latencies, so the same binary serves both as a
+// quick smoke test and as a soak run before a runtime upgrade:
+//
+//   KONAN_STRESS_SECONDS           duration per scenario (default 1, hours for soak)
+//   KONAN_STRESS_THREADS           mutator threads per scenario (default 4)
+//   KONAN_STRESS_RECORD_BASELINE   file to append measured p99 values to
+//   KONAN_STRESS_BASELINE_FILE     recorded baselines; when set, a scenario fails
+//                                  if its p99 exceeds the baseline by over 25%
+//
+// Without a baseline file the numbers are only reported, like the benchmarks.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "KString.h"
+#include "Memory.h"
+#include "Porting.h"
+#include "Runtime.h"
+#include "TypeInfo.h"
+#include "Types.h"
+
+namespace {
+
+constexpr int kBatchOps = 256;
+constexpr double kBaselineSlack = 1.25;
+
+double stressSeconds() {
+  const char* env = ::getenv("KONAN_STRESS_SECONDS");
+  double value = env != nullptr ? ::atof(env) : 0.0;
+  return value > 0.0 ? value : 1.0;
+}
+
+int stressThreads() {
+  const char* env = ::getenv("KONAN_STRESS_THREADS");
+  int value = env != nullptr ? ::atoi(env) : 0;
+  return value > 0 ? value : 4;
+}
+
+// Bounded-memory latency histogram: 16 linear sub-buckets per power of two,
+// giving ~6% value resolution however long the run is. Small values are exact.
+class LatencyHistogram {
+ public:
+  void add(uint64_t ns) { counts_[bucketIndex(ns)]++; }
+
+  void merge(const LatencyHistogram& other) {
+    for (int i = 0; i < kBucketCount; i++) counts_[i] += other.counts_[i];
+  }
+
+  uint64_t totalCount() const {
+    uint64_t total = 0;
+    for (int i = 0; i < kBucketCount; i++) total += counts_[i];
+    return total;
+  }
+
+  // Upper bound of the bucket holding the q-th quantile, in nanoseconds.
+  uint64_t percentile(double q) const {
+    uint64_t total = totalCount();
+    if (total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(total * q);
+    if (rank >= total) rank = total - 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+      seen += counts_[i];
+      if (seen > rank) return bucketUpperBound(i);
+    }
+    return bucketUpperBound(kBucketCount - 1);
+  }
+
+ private:
+  static constexpr int kMinorBits = 4;
+  static constexpr int kMinors = 1 << kMinorBits;
+  static constexpr int kBucketCount = (64 - kMinorBits + 1) * kMinors;
+
+  static int bucketIndex(uint64_t ns) {
+    int major = 63 - __builtin_clzll(ns | 1);
+    if (major < kMinorBits) return static_cast<int>(ns);
+    int minor = static_cast<int>((ns >> (major - kMinorBits)) & (kMinors - 1));
+    return (major - kMinorBits + 1) * kMinors + minor;
+  }
+
+  static uint64_t bucketUpperBound(int index) {
+    if (index < kMinors) return static_cast<uint64_t>(index);
+    int major = index / kMinors + kMinorBits - 1;
+    int minor = index % kMinors;
+    return ((static_cast<uint64_t>(kMinors + minor) + 1) << (major - kMinorBits)) - 1;
+  }
+
+  uint64_t counts_[kBucketCount] = {0};
+};
+
+// Looks up [name] in the recorded baselines; negative when absent or unset.
+int64_t baselineP99Nanos(const char* name) {
+  const char* path = ::getenv("KONAN_STRESS_BASELINE_FILE");
+  if (path == nullptr || path[0] == '\0') return -1;
+  FILE* file = ::fopen(path, "r");
+  if (file == nullptr) return -1;
+  int64_t result = -1;
+  char line[256];
+  size_t nameLength = strlen(name);
+  while (::fgets(line, sizeof(line), file) != nullptr) {
+    if (strncmp(line, name, nameLength) == 0 && line[nameLength] == '=') {
+      result = ::strtoll(line + nameLength + 1, nullptr, 10);
+      break;
+    }
+  }
+  ::fclose(file);
+  return result;
+}
+
+void recordBaselineP99Nanos(const char* name, uint64_t p99) {
+  const char* path = ::getenv("KONAN_STRESS_RECORD_BASELINE");
+  if (path == nullptr || path[0] == '\0') return;
+  FILE* file = ::fopen(path, "a");
+  if (file == nullptr) return;
+  ::fprintf(file, "%s=%llu\n", name, static_cast<unsigned long long>(p99));
+  ::fclose(file);
+}
+
+// Runs [op] (one kBatchOps-operation batch per call) on [threads] threads until
+// the deadline, merges per-thread batch latencies, reports throughput and p99
+// per-op cost, and enforces the recorded baseline when one is configured.
+template <typename F>
+void runStressScenario(const char* name, F op) {
+  int threads = stressThreads();
+  uint64_t deadline = konan::getTimeMicros()
+      + static_cast<uint64_t>(stressSeconds() * 1000000.0);
+  std::vector<LatencyHistogram> histograms(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      Kotlin_initRuntimeIfNeeded();
+      auto& histogram = histograms[t];
+      while (konan::getTimeMicros() < deadline) {
+        uint64_t start = konan::getTimeNanos();
+        op();
+        histogram.add((konan::getTimeNanos() - start) / kBatchOps);
+      }
+      Kotlin_deinitRuntimeIfNeeded();
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  LatencyHistogram merged;
+  for (auto& histogram : histograms) merged.merge(histogram);
+  uint64_t batches = merged.totalCount();
+  ASSERT_GT(batches, static_cast<uint64_t>(0));
+  uint64_t p99 = merged.percentile(0.99);
+  double opsPerSecond = batches * static_cast<double>(kBatchOps) / stressSeconds();
+  std::printf("[ STRESS   ] %s: %d threads, %.0f ops/s, p50 %llu ns/op, p99 %llu ns/op\n",
+      name, threads, opsPerSecond,
+      static_cast<unsigned long long>(merged.percentile(0.5)),
+      static_cast<unsigned long long>(p99));
+  recordBaselineP99Nanos(name, p99);
+  int64_t baseline = baselineP99Nanos(name);
+  if (baseline >= 0) {
+    EXPECT_LE(p99, static_cast<uint64_t>(baseline * kBaselineSlack))
+        << name << ": p99 regressed against recorded baseline " << baseline << " ns";
+  }
+}
+
+// The stress types mirror benchObjectTypeInfo in RuntimeBenchmarkTest: minimal
+// type infos the allocator and GC accept without a compiled Kotlin program.
+TypeInfo plainObjectTypeInfo() {
+  TypeInfo result = {};
+  result.instanceSize_ = 48;
+  return result;
+}
+
+// An object with a single reference field right after the header, enough to
+// build chains the cycle collector and freeze machinery have to traverse.
+struct NodeLayout {
+  ObjHeader header;
+  KRef next;
+};
+
+constexpr int32_t kNodeOffsets[1] = { static_cast<int32_t>(offsetof(NodeLayout, next)) };
+
+TypeInfo nodeTypeInfo() {
+  TypeInfo result = {};
+  result.instanceSize_ = sizeof(NodeLayout);
+  result.objOffsets_ = kNodeOffsets;
+  result.objOffsetsCount_ = 1;
+  return result;
+}
+
+TypeInfo charArrayTypeInfo() {
+  TypeInfo result = {};
+  result.instanceSize_ = -static_cast<int32_t>(sizeof(KChar));
+  return result;
+}
+
+KRef allocNode(const TypeInfo* type, KRef next, ObjHeader** OBJ_RESULT) {
+  KRef node = AllocInstance(type, OBJ_RESULT);
+  UpdateHeapRef(&reinterpret_cast<NodeLayout*>(node)->next, next);
+  return node;
+}
+
+}  // namespace
+
+// Object and array allocation from every thread at once: the RC slow paths,
+// the per-thread allocator front ends and the GC trigger all under pressure.
+TEST(RuntimeStress, AllocationStorm) {
+  Kotlin_initRuntimeIfNeeded();
+  static TypeInfo objectType = plainObjectTypeInfo();
+  objectType.typeInfo_ = &objectType;
+  static TypeInfo arrayType = charArrayTypeInfo();
+  arrayType.typeInfo_ = &arrayType;
+  runStressScenario("AllocationStorm", []() {
+    for (int i = 0; i < kBatchOps / 2; i++) {
+      ObjHolder objectHolder;
+      AllocInstance(&objectType, objectHolder.slot());
+      ObjHolder arrayHolder;
+      AllocArrayInstance(&arrayType, 16 + (i & 15), arrayHolder.slot());
+    }
+  });
+}
+
+// Builds short reference chains and freezes them, so graphs keep migrating
+// from thread-local to shared state while other threads do the same.
+TEST(RuntimeStress, FreezeChurn) {
+  Kotlin_initRuntimeIfNeeded();
+  static TypeInfo nodeType = nodeTypeInfo();
+  nodeType.typeInfo_ = &nodeType;
+  runStressScenario("FreezeChurn", []() {
+    for (int i = 0; i < kBatchOps / 4; i++) {
+      ObjHolder first, second, third, root;
+      allocNode(&nodeType, nullptr, first.slot());
+      allocNode(&nodeType, first.obj(), second.slot());
+      allocNode(&nodeType, second.obj(), third.slot());
+      allocNode(&nodeType, third.obj(), root.slot());
+      FreezeSubgraph(root.obj());
+    }
+  });
+}
+
+// All threads hammer one locked shared slot, alternating publication and
+// clearing with reads: the spinlock convoying case behind production RC
+// contention collapses.
+TEST(RuntimeStress, AtomicReferenceContention) {
+  Kotlin_initRuntimeIfNeeded();
+  static ObjHeader* sharedLocation = nullptr;
+  static int32_t spinlock = 0;
+  static int32_t cookie = 0;
+  // The published value must be shareable; a frozen string is the simplest one.
+  ObjHolder valueHolder;
+  CreateStringFromCString("stress shared value", valueHolder.slot());
+  FreezeSubgraph(valueHolder.obj());
+  KRef value = valueHolder.obj();
+  runStressScenario("AtomicReferenceContention", [value]() {
+    for (int i = 0; i < kBatchOps / 4; i++) {
+      SetHeapRefLocked(&sharedLocation, value, &spinlock, &cookie);
+      {
+        ObjHolder readHolder;
+        ReadHeapRefLocked(&sharedLocation, &spinlock, &cookie, readHolder.slot());
+      }
+      SetHeapRefLocked(&sharedLocation, nullptr, &spinlock, &cookie);
+      {
+        ObjHolder readHolder;
+        ReadHeapRefLocked(&sharedLocation, &spinlock, &cookie, readHolder.slot());
+      }
+    }
+  });
+  SetHeapRefLocked(&sharedLocation, nullptr, &spinlock, &cookie);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "SafePoint.h"
+
+#include "Atomic.h"
+#include "KAssert.h"
+
+#if !KONAN_NO_THREADS
+#include <pthread.h>
+#endif
+
+int32_t g_safePointRequest = 0;
+
+#if KONAN_NO_THREADS
+
+// Single mutator: there is nobody to handshake with.
+void SafePointRegisterThread() {}
+void SafePointUnregisterThread() {}
+void SafePointArm() {}
+void SafePointResume() {}
+void SafePointEnterNative() {}
+void SafePointLeaveNative() {}
+void Kotlin_native_internal_safePoint() {}
+
+#else
+
+namespace {
+
+pthread_mutex_t safePointLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t safePointCond = PTHREAD_COND_INITIALIZER;
+// All guarded by safePointLock.
+int registeredThreads = 0;
+// Threads currently parked in the poll slow path or inside a native region.
+int quiescentThreads = 0;
+int armCount = 0;
+
+THREAD_LOCAL_VARIABLE bool threadRegistered = false;
+THREAD_LOCAL_VARIABLE bool threadInNative = false;
+
+// Requires safePointLock. The arming thread itself is not expected to be registered
+// (collector threads are not mutators); a registered armer must enter native first.
+inline bool allQuiescentUnlocked() {
+  return quiescentThreads == registeredThreads;
+}
+
+void parkAtSafePointSlowPath() {
+  pthread_mutex_lock(&safePointLock);
+  quiescentThreads++;
+  pthread_cond_broadcast(&safePointCond);
+  while (armCount > 0)
+    pthread_cond_wait(&safePointCond, &safePointLock);
+  quiescentThreads--;
+  pthread_mutex_unlock(&safePointLock);
+}
+
+}  // namespace
+
+void SafePointRegisterThread() {
+  RuntimeAssert(!threadRegistered, "Thread is already registered for safepoints");
+  pthread_mutex_lock(&safePointLock);
+  registeredThreads++;
+  pthread_mutex_unlock(&safePointLock);
+  threadRegistered = true;
+}
+
+void SafePointUnregisterThread() {
+  if (!threadRegistered) return;
+  pthread_mutex_lock(&safePointLock);
+  registeredThreads--;
+  // An armed handshake may be waiting for this thread.
+  pthread_cond_broadcast(&safePointCond);
+  pthread_mutex_unlock(&safePointLock);
+  threadRegistered = false;
+}
+
+void SafePointArm() {
+  RuntimeAssert(!threadRegistered || threadInNative,
+      "A registered thread must enter native state before arming a safepoint");
+  pthread_mutex_lock(&safePointLock);
+  armCount++;
+  if (armCount == 1)
+    atomicSet(&g_safePointRequest, 1);
+  while (!allQuiescentUnlocked())
+    pthread_cond_wait(&safePointCond, &safePointLock);
+  pthread_mutex_unlock(&safePointLock);
+}
+
+void SafePointResume() {
+  pthread_mutex_lock(&safePointLock);
+  RuntimeAssert(armCount > 0, "Unbalanced safepoint resume");
+  armCount--;
+  if (armCount == 0) {
+    atomicSet(&g_safePointRequest, 0);
+    pthread_cond_broadcast(&safePointCond);
+  }
+  pthread_mutex_unlock(&safePointLock);
+}
+
+void SafePointEnterNative() {
+  if (!threadRegistered || threadInNative) return;
+  pthread_mutex_lock(&safePointLock);
+  quiescentThreads++;
+  pthread_cond_broadcast(&safePointCond);
+  pthread_mutex_unlock(&safePointLock);
+  threadInNative = true;
+}
+
+void SafePointLeaveNative() {
+  if (!threadRegistered || !threadInNative) return;
+  pthread_mutex_lock(&safePointLock);
+  while (armCount > 0)
+    pthread_cond_wait(&safePointCond, &safePointLock);
+  quiescentThreads--;
+  pthread_mutex_unlock(&safePointLock);
+  threadInNative = false;
+}
+
+void Kotlin_native_internal_safePoint() {
+  if (atomicGet(&g_safePointRequest) == 0) return;
+  if (!threadRegistered || threadInNative) return;
+  parkAtSafePointSlowPath();
+}
+
+#endif  // KONAN_NO_THREADS
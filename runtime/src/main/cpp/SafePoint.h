@@ -0,0 +1,45 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_SAFEPOINT_H
+#define RUNTIME_SAFEPOINT_H
+
+#include <stdint.h>
+
+#include "Common.h"
+
+extern "C" {
+
+// Global safepoint poll word. Testing it is a single aligned load of a fixed address,
+// cheap enough for compiler-inserted polls on loop back-edges; generated code and
+// runtime hot paths call Kotlin_native_internal_safePoint() (or inline its fast path)
+// and only take the slow path while a handshake is armed.
+extern int32_t g_safePointRequest;
+
+// Registers/unregisters the calling thread as a mutator participating in safepoint
+// handshakes. Registered threads must either poll regularly or mark blocking regions
+// with SafePointEnterNative()/SafePointLeaveNative().
+void SafePointRegisterThread() RUNTIME_NOTHROW;
+void SafePointUnregisterThread() RUNTIME_NOTHROW;
+
+// Arms the poll word and returns once every registered thread is parked in the poll
+// slow path or in a native region, i.e. no mutator touches the Kotlin heap. Arming
+// nests; each arm must be paired with SafePointResume().
+void SafePointArm() RUNTIME_NOTHROW;
+// Disarms one level; the last resume clears the poll word and releases parked threads.
+void SafePointResume() RUNTIME_NOTHROW;
+
+// Marks a region where the calling thread does not touch the Kotlin heap (blocking
+// waits, slow syscalls): such threads do not delay handshakes. Leaving the region
+// blocks while a handshake is armed.
+void SafePointEnterNative() RUNTIME_NOTHROW;
+void SafePointLeaveNative() RUNTIME_NOTHROW;
+
+// The poll itself: tests the poll word and parks until resumed when it is armed.
+void Kotlin_native_internal_safePoint() RUNTIME_NOTHROW;
+
+}  // extern "C"
+
+#endif // RUNTIME_SAFEPOINT_H
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Alloc.h"
+#include "Atomic.h"
+#include "Memory.h"
+#include "Porting.h"
+#include "Types.h"
+
+extern "C" {
+// Defined in Atomic.cpp; shared frozen map entries follow the same publication rules.
+void Kotlin_AtomicReference_checkIfFrozen(KRef value);
+// Defined in SharedHashMap.kt: value-based key comparison.
+KBoolean Kotlin_SharedMap_keysEqual(KRef first, KRef second);
+}  // extern "C"
+
+namespace {
+
+// A hash table shared between workers, for frozen keys and values.
+//
+// Readers never take the map-wide lock: they probe the currently published table,
+// and each key/value slot is accessed through the same spinlock-plus-cookie
+// machinery AtomicReference uses ([ReadHeapRefLocked]/[SetHeapRefLocked]), so a
+// reference cannot be released between being read and being counted. Writers
+// serialize on a map-wide spinlock.
+//
+// Resizing is copy-on-write: the writer builds the next power-of-two table aside,
+// publishes it with one atomic store, then scrubs the references out of the old
+// generation. A reader still probing the old table at that point only observes
+// nulls, notices the table pointer changed, and retries; the old entry array
+// itself stays allocated (chained through retired_) until the map is disposed,
+// so no reader can ever touch freed memory. Generations grow geometrically,
+// hence retired arrays together stay smaller than the live one.
+
+struct SharedMapEntry {
+  KRef key_;    // Null while the slot was never used; never reset in a live table.
+  KRef value_;  // Null marks a removed entry (the key stays as a tombstone).
+  KInt keyHash_;
+  KInt keyLock_;
+  KInt keyCookie_;
+  KInt valueLock_;
+  KInt valueCookie_;
+};
+
+struct SharedMapTable {
+  KInt capacityMask_;
+  // Slots with a key set, including tombstones; maintained under the writer lock.
+  KInt occupied_;
+  // Previous generation, kept for readers still probing it. Freed on dispose only.
+  SharedMapTable* retired_;
+
+  SharedMapEntry* entries() {
+    return reinterpret_cast<SharedMapEntry*>(this + 1);
+  }
+};
+
+struct SharedMap {
+  SharedMapTable* table_;
+  KInt lock_;
+  KInt size_;
+};
+
+class SpinLocker {
+ public:
+  explicit SpinLocker(KInt* lock) : lock_(lock) {
+    while (compareAndSwap(lock_, 0, 1) != 0) {}
+  }
+  ~SpinLocker() {
+    compareAndSwap(lock_, 1, 0);
+  }
+
+ private:
+  KInt* lock_;
+};
+
+inline SharedMap* asSharedMap(KNativePtr map) {
+  return reinterpret_cast<SharedMap*>(map);
+}
+
+SharedMapTable* allocTable(KInt capacity) {
+  auto* table = reinterpret_cast<SharedMapTable*>(
+      konan::calloc(1, sizeof(SharedMapTable) + capacity * sizeof(SharedMapEntry)));
+  table->capacityMask_ = capacity - 1;
+  return table;
+}
+
+// Matches [key] against [entry] under the assumption the entry key was already
+// read (and thus pinned) by the caller. Identity matches short-circuit the
+// callback into Kotlin equals().
+inline bool keyMatches(SharedMapEntry* entry, KRef storedKey, KRef key, KInt keyHash) {
+  if (storedKey == key) return true;
+  return entry->keyHash_ == keyHash && Kotlin_SharedMap_keysEqual(storedKey, key);
+}
+
+// Grows the table to the next generation, called under the writer lock. Live
+// entries move over, tombstones are left behind, so occupancy resets to the
+// actual size.
+SharedMapTable* growTable(SharedMap* map) {
+  SharedMapTable* oldTable = map->table_;
+  KInt oldCapacity = oldTable->capacityMask_ + 1;
+  SharedMapTable* newTable = allocTable(oldCapacity * 2);
+  KInt newMask = newTable->capacityMask_;
+
+  for (KInt i = 0; i < oldCapacity; ++i) {
+    SharedMapEntry* oldEntry = oldTable->entries() + i;
+    // Only this thread mutates entries, so plain reads are fine here.
+    if (oldEntry->key_ == nullptr || oldEntry->value_ == nullptr) continue;
+    for (KInt probe = 0; probe <= newMask; ++probe) {
+      SharedMapEntry* newEntry = newTable->entries() + ((oldEntry->keyHash_ + probe) & newMask);
+      if (newEntry->key_ != nullptr) continue;
+      newEntry->keyHash_ = oldEntry->keyHash_;
+      SetHeapRefLocked(&newEntry->key_, oldEntry->key_, &newEntry->keyLock_, &newEntry->keyCookie_);
+      SetHeapRefLocked(&newEntry->value_, oldEntry->value_, &newEntry->valueLock_, &newEntry->valueCookie_);
+      newTable->occupied_++;
+      break;
+    }
+  }
+
+  newTable->retired_ = oldTable;
+  atomicSet(&map->table_, newTable);
+
+  // From here readers racing the switch find nulls in the old generation and
+  // retry against the new one; locked setters keep them safe mid-read.
+  for (KInt i = 0; i < oldCapacity; ++i) {
+    SharedMapEntry* oldEntry = oldTable->entries() + i;
+    if (oldEntry->key_ == nullptr) continue;
+    SetHeapRefLocked(&oldEntry->value_, nullptr, &oldEntry->valueLock_, &oldEntry->valueCookie_);
+    SetHeapRefLocked(&oldEntry->key_, nullptr, &oldEntry->keyLock_, &oldEntry->keyCookie_);
+  }
+
+  return newTable;
+}
+
+}  // namespace
+
+extern "C" {
+
+KNativePtr Kotlin_SharedMap_create(KInt initialCapacity) {
+  KInt capacity = 16;
+  while (capacity < initialCapacity) capacity <<= 1;
+  auto* map = reinterpret_cast<SharedMap*>(konan::calloc(1, sizeof(SharedMap)));
+  map->table_ = allocTable(capacity);
+  return map;
+}
+
+void Kotlin_SharedMap_dispose(KNativePtr mapPtr) {
+  auto* map = asSharedMap(mapPtr);
+  SharedMapTable* table = map->table_;
+  while (table != nullptr) {
+    for (KInt i = 0; i <= table->capacityMask_; ++i) {
+      SharedMapEntry* entry = table->entries() + i;
+      ZeroHeapRef(&entry->value_);
+      ZeroHeapRef(&entry->key_);
+    }
+    SharedMapTable* retired = table->retired_;
+    konan::free(table);
+    table = retired;
+  }
+  konan::free(map);
+}
+
+KInt Kotlin_SharedMap_size(KNativePtr mapPtr) {
+  return atomicGet(&asSharedMap(mapPtr)->size_);
+}
+
+OBJ_GETTER(Kotlin_SharedMap_get, KNativePtr mapPtr, KRef key, KInt keyHash) {
+  auto* map = asSharedMap(mapPtr);
+  while (true) {
+    SharedMapTable* table = atomicGet(&map->table_);
+    KInt mask = table->capacityMask_;
+    for (KInt probe = 0; probe <= mask; ++probe) {
+      SharedMapEntry* entry = table->entries() + ((keyHash + probe) & mask);
+      ObjHolder keyHolder;
+      KRef storedKey = ReadHeapRefLocked(&entry->key_, &entry->keyLock_, &entry->keyCookie_, keyHolder.slot());
+      if (storedKey == nullptr) break;  // Never-used slot terminates the probe.
+      if (keyMatches(entry, storedKey, key, keyHash)) {
+        ObjHolder valueHolder;
+        KRef value = ReadHeapRefLocked(&entry->value_, &entry->valueLock_, &entry->valueCookie_, valueHolder.slot());
+        // The holder still pins the value, so checking that no resize was
+        // published meanwhile and returning is safe in this order.
+        if (atomicGet(&map->table_) == table) RETURN_OBJ(value);
+        break;
+      }
+    }
+    if (atomicGet(&map->table_) == table) RETURN_OBJ(nullptr);
+    // The table was swapped under this probe: retry on the new generation.
+  }
+}
+
+OBJ_GETTER(Kotlin_SharedMap_put, KNativePtr mapPtr, KRef key, KInt keyHash, KRef value) {
+  Kotlin_AtomicReference_checkIfFrozen(key);
+  Kotlin_AtomicReference_checkIfFrozen(value);
+  auto* map = asSharedMap(mapPtr);
+  SpinLocker locker(&map->lock_);
+
+  SharedMapTable* table = map->table_;
+  if ((table->occupied_ + 1) * 4 > (table->capacityMask_ + 1) * 3) {
+    table = growTable(map);
+  }
+
+  KInt mask = table->capacityMask_;
+  for (KInt probe = 0; probe <= mask; ++probe) {
+    SharedMapEntry* entry = table->entries() + ((keyHash + probe) & mask);
+    KRef storedKey = entry->key_;
+    if (storedKey == nullptr) {
+      entry->keyHash_ = keyHash;
+      SetHeapRefLocked(&entry->key_, key, &entry->keyLock_, &entry->keyCookie_);
+      SetHeapRefLocked(&entry->value_, value, &entry->valueLock_, &entry->valueCookie_);
+      table->occupied_++;
+      atomicAdd(&map->size_, 1);
+      RETURN_OBJ(nullptr);
+    }
+    if (keyMatches(entry, storedKey, key, keyHash)) {
+      if (entry->value_ == nullptr) atomicAdd(&map->size_, 1);  // Revives a tombstone.
+      RETURN_RESULT_OF(SwapHeapRefLocked, &entry->value_, entry->value_, value,
+          &entry->valueLock_, &entry->valueCookie_);
+    }
+  }
+  RuntimeCheck(false, "Shared map table overflow despite load factor");
+}
+
+OBJ_GETTER(Kotlin_SharedMap_remove, KNativePtr mapPtr, KRef key, KInt keyHash) {
+  auto* map = asSharedMap(mapPtr);
+  SpinLocker locker(&map->lock_);
+
+  SharedMapTable* table = map->table_;
+  KInt mask = table->capacityMask_;
+  for (KInt probe = 0; probe <= mask; ++probe) {
+    SharedMapEntry* entry = table->entries() + ((keyHash + probe) & mask);
+    KRef storedKey = entry->key_;
+    if (storedKey == nullptr) break;
+    if (keyMatches(entry, storedKey, key, keyHash)) {
+      if (entry->value_ == nullptr) break;  // Already removed.
+      atomicAdd(&map->size_, -1);
+      RETURN_RESULT_OF(SwapHeapRefLocked, &entry->value_, entry->value_, nullptr,
+          &entry->valueLock_, &entry->valueCookie_);
+    }
+  }
+  RETURN_OBJ(nullptr);
+}
+
+}  // extern "C"
@@ -29,6 +29,10 @@ extern "C" {
 
 struct SourceInfo Kotlin_getSourceInfo(void* addr);
 
+// Resolves [count] addresses in one go, filling [results]. Shares one resolution
+// cache across the batch, so symbolicating a whole trace costs setup only once.
+void Kotlin_getSourceInfoBulk(void** addresses, int count, struct SourceInfo* results);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
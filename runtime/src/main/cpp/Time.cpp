@@ -14,22 +14,198 @@
  * limitations under the License.
  */
 
+#include "Atomic.h"
 #include "Natives.h"
 #include "Porting.h"
 #include "Types.h"
 
+namespace {
+
+#if defined(__x86_64__) || defined(__aarch64__)
+#define KONAN_HAS_CYCLE_CLOCK 1
+#endif
+
+#if KONAN_HAS_CYCLE_CLOCK
+
+// Raw CPU cycle counter: invariant TSC on x86-64, the architected counter on
+// ARM64. Both tick at a constant rate across frequency scaling and are
+// synchronized across cores on the hardware we target.
+ALWAYS_INLINE inline uint64_t cycleClockNow() {
+#if defined(__aarch64__)
+  uint64_t value;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+#if defined(__aarch64__)
+ALWAYS_INLINE inline uint64_t cycleClockFrequency() {
+  uint64_t value;
+  __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(value));
+  return value;
+}
+#endif
+
+// Anchor tying the cycle counter to the portable clock: a reading is
+// anchorNanos plus the cycles elapsed since anchorCycles, scaled by
+// cycleScaleFix (nanoseconds per cycle, 32.32 fixed point; zero until
+// calibrated). Published under a sequence lock: writers make the counter odd
+// while updating, readers retry on a changed or odd counter.
+int32_t cycleAnchorSeq = 0;
+KLong cycleAnchorNanos = 0;
+uint64_t cycleAnchorCycles = 0;
+uint64_t cycleScaleFix = 0;
+
+// Extrapolation past the anchor is bounded so a slightly off scale cannot
+// accumulate visible error; beyond the bound readers re-anchor on the portable
+// clock. With calibration jitter well under a microsecond over the calibration
+// window, the drift per window stays in the tens of nanoseconds.
+constexpr KLong kReanchorNanos = 250 * 1000 * 1000;
+// Portable-clock interval the calibration window has to span on x86-64
+// (ARM64 advertises the counter frequency and needs no calibration).
+constexpr KLong kCalibrationNanos = 10 * 1000 * 1000;
+
+// Cache for the coarse clock, refreshed by coarse readers themselves when its
+// cycle stamp is older than kCoarseMaxAgeCycles (on the order of a millisecond;
+// the bound is deliberately frequency-agnostic, only its magnitude matters).
+KLong coarseNanos = 0;
+uint64_t coarseCycles = 0;
+constexpr uint64_t kCoarseMaxAgeCycles = 1ULL << 21;
+
+// Takes a portable-clock reading and moves the anchor to it, calibrating the
+// scale once enough of a window has elapsed. Concurrent re-anchoring threads
+// simply keep their own portable reading.
+KLong reanchorCycleClock() {
+  uint64_t cycles = cycleClockNow();
+  KLong nanos = static_cast<KLong>(konan::getTimeNanos());
+  int32_t seq = atomicGet(&cycleAnchorSeq);
+  if ((seq & 1) == 0 && compareAndSet(&cycleAnchorSeq, seq, seq + 1)) {
+    uint64_t scale = cycleScaleFix;
+    if (scale == 0) {
+#if defined(__aarch64__)
+      scale = (1000000000ULL << 32) / cycleClockFrequency();
+#else
+      // First call only plants the anchor; the scale is derived on a later
+      // call from the cycles and nanoseconds elapsed since.
+      if (cycleAnchorCycles != 0 && nanos - cycleAnchorNanos >= kCalibrationNanos) {
+        scale = ((static_cast<unsigned __int128>(nanos - cycleAnchorNanos)) << 32)
+            / (cycles - cycleAnchorCycles);
+      }
+#endif
+      cycleScaleFix = scale;
+      if (scale != 0 || cycleAnchorCycles == 0) {
+        cycleAnchorNanos = nanos;
+        cycleAnchorCycles = cycles;
+      }
+    } else {
+      cycleAnchorNanos = nanos;
+      cycleAnchorCycles = cycles;
+    }
+    atomicSet(&cycleAnchorSeq, seq + 2);
+  }
+  return nanos;
+}
+
+#endif  // KONAN_HAS_CYCLE_CLOCK
+
+// Monotonic nanoseconds from the cycle counter where one is available, falling
+// back to (and periodically re-anchoring on) the portable clock.
+KLong getMonotonicNanos() {
+#if KONAN_HAS_CYCLE_CLOCK
+  int32_t seq = atomicGet(&cycleAnchorSeq);
+  if ((seq & 1) == 0) {
+    uint64_t scale = cycleScaleFix;
+    KLong anchorNanos = cycleAnchorNanos;
+    uint64_t anchorCycles = cycleAnchorCycles;
+    if (atomicGet(&cycleAnchorSeq) == seq && scale != 0) {
+      uint64_t delta = cycleClockNow() - anchorCycles;
+      KLong deltaNanos =
+          static_cast<KLong>(static_cast<uint64_t>((static_cast<unsigned __int128>(delta) * scale) >> 32));
+      if (deltaNanos < kReanchorNanos) return anchorNanos + deltaNanos;
+    }
+  }
+  return reanchorCycleClock();
+#else
+  return static_cast<KLong>(konan::getTimeNanos());
+#endif
+}
+
+// Monotonic clock bases are not preserved across process checkpoint/restore: the
+// restored process may run on another boot entirely, so the raw values can jump
+// arbitrarily, including backwards. The offsets below keep Kotlin-visible time
+// monotonic — after a restore the clocks continue from their checkpointed values,
+// as if no time passed while the process image was dormant.
+KLong timeOffsetMillis = 0;
+KLong timeOffsetMicros = 0;
+KLong timeOffsetNanos = 0;
+
+KLong checkpointMillis = 0;
+KLong checkpointMicros = 0;
+KLong checkpointNanos = 0;
+
+}  // namespace
+
 extern "C" {
 
 KLong Kotlin_system_getTimeMillis() {
-  return konan::getTimeMillis();
+  return konan::getTimeMillis() + timeOffsetMillis;
 }
 
 KLong Kotlin_system_getTimeNanos() {
-  return konan::getTimeNanos();
+  return getMonotonicNanos() + timeOffsetNanos;
+}
+
+// Coarse variant of Kotlin_system_getTimeNanos: accurate to about a
+// millisecond, but usually costing just a cycle counter read and a compare.
+// For call sites taking timestamps far more often than they need precision.
+KLong Kotlin_system_getTimeNanosCoarse() {
+#if KONAN_HAS_CYCLE_CLOCK
+  uint64_t cycles = cycleClockNow();
+  KLong cached = atomicGet(&coarseNanos);
+  if (cached != 0 && cycles - atomicGet(&coarseCycles) < kCoarseMaxAgeCycles)
+    return cached + timeOffsetNanos;
+  KLong nanos = getMonotonicNanos();
+  atomicSet(&coarseNanos, nanos);
+  atomicSet(&coarseCycles, cycles);
+  return nanos + timeOffsetNanos;
+#else
+  return Kotlin_system_getTimeNanos();
+#endif
 }
 
 KLong Kotlin_system_getTimeMicros() {
-  return konan::getTimeMicros();
+  return konan::getTimeMicros() + timeOffsetMicros;
+}
+
+// Called by Kotlin_checkpointRuntime right before the process image is dumped.
+void Kotlin_system_checkpointTimeBases() {
+  checkpointMillis = Kotlin_system_getTimeMillis();
+  checkpointMicros = Kotlin_system_getTimeMicros();
+  checkpointNanos = Kotlin_system_getTimeNanos();
+}
+
+// Called by Kotlin_restoreRuntimeAfterCheckpoint after process resurrection.
+void Kotlin_system_rebaseTimeAfterRestore() {
+#if KONAN_HAS_CYCLE_CLOCK
+  // The cycle counter base (and, on another machine, its rate) changed with
+  // the process image; drop the anchor and calibration so they are rebuilt.
+  int32_t seq;
+  do {
+    seq = atomicGet(&cycleAnchorSeq);
+  } while ((seq & 1) != 0 || !compareAndSet(&cycleAnchorSeq, seq, seq + 1));
+  cycleAnchorNanos = 0;
+  cycleAnchorCycles = 0;
+  cycleScaleFix = 0;
+  atomicSet(&cycleAnchorSeq, seq + 2);
+  atomicSet(&coarseNanos, KLong(0));
+#endif
+  timeOffsetMillis = checkpointMillis - konan::getTimeMillis();
+  timeOffsetMicros = checkpointMicros - konan::getTimeMicros();
+  timeOffsetNanos = checkpointNanos - getMonotonicNanos();
 }
 
 }  // extern "C"
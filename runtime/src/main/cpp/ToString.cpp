@@ -20,6 +20,7 @@
 
 #include "KAssert.h"
 #include "Exceptions.h"
+#include "Format.h"
 #include "Memory.h"
 #include "Natives.h"
 #include "KString.h"
@@ -28,6 +29,20 @@
 
 namespace {
 
+template <typename T> OBJ_GETTER(Kotlin_toStringDecimal, T value) {
+  char cstring[24];
+  char* end = cstring + sizeof(cstring) - 1;
+  *end = '\0';
+  // Negate in unsigned arithmetic so that the minimum value does not overflow.
+  const uint64_t magnitude =
+      value < 0 ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+  char* begin = konan::formatDecimalDigits(magnitude, end);
+  if (value < 0) {
+    *--begin = '-';
+  }
+  RETURN_RESULT_OF(CreateStringFromCString, begin);
+}
+
 char int_to_digit(uint32_t value) {
   if (value < 10) {
     return '0' + value;
@@ -70,9 +85,7 @@ template <typename T> OBJ_GETTER(Kotlin_toStringRadix, T value, KInt radix) {
 extern "C" {
 
 OBJ_GETTER(Kotlin_Byte_toString, KByte value) {
-  char cstring[8];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KByte>, value);
 }
 
 OBJ_GETTER(Kotlin_Char_toString, KChar value) {
@@ -82,15 +95,11 @@ OBJ_GETTER(Kotlin_Char_toString, KChar value) {
 }
 
 OBJ_GETTER(Kotlin_Short_toString, KShort value) {
-  char cstring[8];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KShort>, value);
 }
 
 OBJ_GETTER(Kotlin_Int_toString, KInt value) {
-  char cstring[16];
-  konan::snprintf(cstring, sizeof(cstring), "%d", value);
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KInt>, value);
 }
 
 OBJ_GETTER(Kotlin_Int_toStringRadix, KInt value, KInt radix) {
@@ -98,9 +107,7 @@ OBJ_GETTER(Kotlin_Int_toStringRadix, KInt value, KInt radix) {
 }
 
 OBJ_GETTER(Kotlin_Long_toString, KLong value) {
-  char cstring[32];
-  konan::snprintf(cstring, sizeof(cstring), "%lld", static_cast<long long>(value));
-  RETURN_RESULT_OF(CreateStringFromCString, cstring);
+  RETURN_RESULT_OF(Kotlin_toStringDecimal<KLong>, value);
 }
 
 OBJ_GETTER(Kotlin_Long_toStringRadix, KLong value, KInt radix) {
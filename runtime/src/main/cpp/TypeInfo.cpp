@@ -14,13 +14,148 @@
  * limitations under the License.
  */
 
+#include "Atomic.h"
+#include "City.h"
 #include "KAssert.h"
+#include "Natives.h"
+#include "Porting.h"
 #include "TypeInfo.h"
 
 // If one shall use binary search when looking up methods and fields.
 // TODO: maybe select strategy basing on number of elements.
 #define USE_BINARY_SEARCH 1
 
+// If interface table lookups shall be cached, so megamorphic call sites hitting
+// the same (itable, interface) pair repeatedly cost one load and compare.
+#define USE_ITABLE_CACHE 1
+
+#if USE_ITABLE_CACHE
+
+namespace {
+
+// Direct-mapped cache of recent interface table lookups. Thread-local, so entries
+// can be read and written without synchronization or torn record pointers.
+constexpr int kItableCacheBits = 6;
+constexpr int kItableCacheSize = 1 << kItableCacheBits;
+
+struct ItableCacheEntry {
+  InterfaceTableRecord const* interfaceTable;
+  ClassId interfaceId;
+  InterfaceTableRecord const* record;
+};
+
+THREAD_LOCAL_VARIABLE ItableCacheEntry itableCache[kItableCacheSize];
+
+ALWAYS_INLINE inline int itableCacheIndex(InterfaceTableRecord const* interfaceTable, ClassId interfaceId) {
+  // Tables are at least pointer-aligned, fold the low bits away before mixing in the id.
+  auto table = reinterpret_cast<uintptr_t>(interfaceTable);
+  return static_cast<int>((table >> 4) ^ static_cast<uintptr_t>(interfaceId)) & (kItableCacheSize - 1);
+}
+
+}  // namespace
+
+#endif  // USE_ITABLE_CACHE
+
+// TypeInfo unification across dynamically loaded Kotlin libraries. Every library
+// carries its own copy of the type tables for the classes it links in, so a type
+// like kotlin.String exists once per loaded image and pointer identity breaks
+// across image boundaries. Each library registers its table at load; types whose
+// fully qualified name matches an already registered one get that one as their
+// canonical representative, which the slow paths of type checks consult. The
+// tables themselves stay where the loader mapped them - references to them are
+// baked all over the image - so this canonicalizes behavior, not storage.
+namespace {
+
+int32_t typeInfoRegistryLock = 0;
+
+inline void lockRegistry() {
+  while (compareAndSwap(&typeInfoRegistryLock, 0, 1) != 0) {}
+}
+
+inline void unlockRegistry() {
+  compareAndSwap(&typeInfoRegistryLock, 1, 0);
+}
+
+// Open addressing tables with linear probing, grown by doubling. Allocated with
+// konan::calloc, as registration may run from library load hooks before any
+// runtime or memory state exists.
+struct TypeInfoNameEntry {
+  uint64_t nameHash;
+  const TypeInfo* canonical;
+};
+
+struct TypeInfoAliasEntry {
+  const TypeInfo* typeInfo;
+  const TypeInfo* canonical;
+};
+
+TypeInfoNameEntry* nameTable = nullptr;
+uint32_t nameTableSize = 0;
+uint32_t nameTableCount = 0;
+TypeInfoAliasEntry* aliasTable = nullptr;
+uint32_t aliasTableSize = 0;
+uint32_t aliasTableCount = 0;
+// Read without the lock on fast paths.
+int32_t duplicateTypeInfoCount = 0;
+
+// Hash of the fully qualified name, or 0 for local and anonymous classes, which
+// are never unified.
+uint64_t typeInfoNameHash(const TypeInfo* typeInfo) {
+  if (typeInfo->relativeName_ == nullptr) return 0;
+  const ArrayHeader* relativeName = typeInfo->relativeName_->array();
+  uint64_t hash = CityHash64(
+      CharArrayAddressOfElementAt(relativeName, 0), relativeName->count_ * sizeof(KChar));
+  if (typeInfo->packageName_ != nullptr) {
+    const ArrayHeader* packageName = typeInfo->packageName_->array();
+    uint64_t packageHash = CityHash64(
+        CharArrayAddressOfElementAt(packageName, 0), packageName->count_ * sizeof(KChar));
+    hash ^= packageHash + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+  }
+  return hash != 0 ? hash : 1;
+}
+
+inline uint32_t pointerHash(const TypeInfo* typeInfo) {
+  return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(typeInfo) >> 4) * 0x9e3779b97f4a7c15ULL >> 32);
+}
+
+void insertNameEntry(TypeInfoNameEntry* table, uint32_t size, TypeInfoNameEntry entry) {
+  uint32_t index = static_cast<uint32_t>(entry.nameHash) & (size - 1);
+  while (table[index].canonical != nullptr) index = (index + 1) & (size - 1);
+  table[index] = entry;
+}
+
+void insertAliasEntry(TypeInfoAliasEntry* table, uint32_t size, TypeInfoAliasEntry entry) {
+  uint32_t index = pointerHash(entry.typeInfo) & (size - 1);
+  while (table[index].typeInfo != nullptr) index = (index + 1) & (size - 1);
+  table[index] = entry;
+}
+
+void ensureNameTableCapacity() {
+  if (nameTable != nullptr && (nameTableCount + 1) * 3 < nameTableSize * 2) return;
+  uint32_t newSize = nameTable == nullptr ? 1024 : nameTableSize * 2;
+  auto* newTable = reinterpret_cast<TypeInfoNameEntry*>(konan::calloc(newSize, sizeof(TypeInfoNameEntry)));
+  for (uint32_t i = 0; i < nameTableSize; i++) {
+    if (nameTable[i].canonical != nullptr) insertNameEntry(newTable, newSize, nameTable[i]);
+  }
+  konan::free(nameTable);
+  nameTable = newTable;
+  nameTableSize = newSize;
+}
+
+void ensureAliasTableCapacity() {
+  if (aliasTable != nullptr && (aliasTableCount + 1) * 3 < aliasTableSize * 2) return;
+  uint32_t newSize = aliasTable == nullptr ? 1024 : aliasTableSize * 2;
+  auto* newTable = reinterpret_cast<TypeInfoAliasEntry*>(konan::calloc(newSize, sizeof(TypeInfoAliasEntry)));
+  for (uint32_t i = 0; i < aliasTableSize; i++) {
+    if (aliasTable[i].typeInfo != nullptr) insertAliasEntry(newTable, newSize, aliasTable[i]);
+  }
+  konan::free(aliasTable);
+  aliasTable = newTable;
+  aliasTableSize = newSize;
+}
+
+}  // namespace
+
 extern "C" {
 #if USE_BINARY_SEARCH
 
@@ -66,6 +201,11 @@ InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord cons
     for (i = 0; i < interfaceTableSize - 1 && interfaceTable[i].id < interfaceId; ++i);
     return interfaceTable + i;
   }
+#if USE_ITABLE_CACHE
+  ItableCacheEntry* entry = itableCache + itableCacheIndex(interfaceTable, interfaceId);
+  if (entry->interfaceTable == interfaceTable && entry->interfaceId == interfaceId)
+    return entry->record;
+#endif  // USE_ITABLE_CACHE
   int l = 0, r = interfaceTableSize - 1;
   while (l < r) {
     int m = (l + r) / 2;
@@ -73,7 +213,98 @@ InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord cons
       l = m + 1;
     else r = m;
   }
+#if USE_ITABLE_CACHE
+  // Failed lookups are cached as well: the result is deterministic for a given
+  // table, and the caller checks the record id anyway.
+  entry->interfaceTable = interfaceTable;
+  entry->interfaceId = interfaceId;
+  entry->record = interfaceTable + l;
+#endif  // USE_ITABLE_CACHE
   return interfaceTable + l;
 }
 
+// Monomorphic call-site cache for interface dispatch from generated bridges.
+// [cacheSlots] points to a zero-initialized {TypeInfo*, entry point} pair owned by the
+// call site. The pair is locked to the first receiver class seen there: the entry point
+// is claimed with a CAS and the type info published after it, so a reader can never pair
+// a type info with another class's entry point. Call sites that later see other classes
+// fall through to the regular interface table lookup.
+void* LookupInterfaceMethodCached(const TypeInfo* typeInfo, void* volatile* cacheSlots,
+                                  ClassId interfaceId, int itableIndex) {
+  if (atomicGet(&cacheSlots[0]) == static_cast<void*>(const_cast<TypeInfo*>(typeInfo))) {
+    void* cached = atomicGet(&cacheSlots[1]);
+    if (cached != nullptr) return cached;
+  }
+
+  int interfaceTableSize = typeInfo->interfaceTableSize_;
+  InterfaceTableRecord const* record = (interfaceTableSize >= 0)
+      // The fastest optimistic version, see ClassLayoutBuilder.
+      ? typeInfo->interfaceTable_ + (interfaceId & interfaceTableSize)
+      : LookupInterfaceTableRecord(typeInfo->interfaceTable_, -interfaceTableSize, interfaceId);
+
+  void* impl = const_cast<void*>(record->vtable[itableIndex]);
+  if (compareAndSwap(&cacheSlots[1], static_cast<void*>(nullptr), impl) == nullptr) {
+    atomicSet(&cacheSlots[0], static_cast<void*>(const_cast<TypeInfo*>(typeInfo)));
+  }
+  return impl;
+}
+
+void RegisterTypeInfoTable(const TypeInfo* const* typeInfos, int count) {
+  lockRegistry();
+  for (int i = 0; i < count; i++) {
+    const TypeInfo* typeInfo = typeInfos[i];
+    if (typeInfo == nullptr) continue;
+    uint64_t nameHash = typeInfoNameHash(typeInfo);
+    if (nameHash == 0) continue;
+    ensureNameTableCapacity();
+    uint32_t index = static_cast<uint32_t>(nameHash) & (nameTableSize - 1);
+    while (true) {
+      TypeInfoNameEntry* entry = nameTable + index;
+      if (entry->canonical == nullptr) {
+        // First registration of this name becomes the canonical representative.
+        entry->nameHash = nameHash;
+        entry->canonical = typeInfo;
+        nameTableCount++;
+        break;
+      }
+      if (entry->nameHash == nameHash) {
+        if (entry->canonical != typeInfo &&
+            entry->canonical->instanceSize_ == typeInfo->instanceSize_ &&
+            entry->canonical->flags_ == typeInfo->flags_) {
+          // Same name from another library with a matching shape: unify. Shape
+          // mismatches (a renamed type colliding, or incompatible library
+          // versions) are left as distinct types.
+          ensureAliasTableCapacity();
+          insertAliasEntry(aliasTable, aliasTableSize, {typeInfo, entry->canonical});
+          aliasTableCount++;
+          atomicAdd(&duplicateTypeInfoCount, 1);
+        }
+        break;
+      }
+      index = (index + 1) & (nameTableSize - 1);
+    }
+  }
+  unlockRegistry();
+}
+
+const TypeInfo* CanonicalTypeInfo(const TypeInfo* typeInfo) {
+  if (typeInfo == nullptr || atomicGet(&duplicateTypeInfoCount) == 0) return typeInfo;
+  const TypeInfo* result = typeInfo;
+  lockRegistry();
+  uint32_t index = pointerHash(typeInfo) & (aliasTableSize - 1);
+  while (aliasTable[index].typeInfo != nullptr) {
+    if (aliasTable[index].typeInfo == typeInfo) {
+      result = aliasTable[index].canonical;
+      break;
+    }
+    index = (index + 1) & (aliasTableSize - 1);
+  }
+  unlockRegistry();
+  return result;
+}
+
+bool HasDuplicateTypeInfos() {
+  return atomicGet(&duplicateTypeInfoCount) != 0;
+}
+
 }
@@ -63,12 +63,30 @@ enum Konan_TypeFlags {
   TF_LEAK_DETECTOR_CANDIDATE = 1 << 4,
   TF_SUSPEND_FUNCTION = 1 << 5,
   TF_HAS_FINALIZER = 1 << 6,
+  // Preallocated frozen instances of this Throwable are rethrown for control
+  // flow; ThrowException does not retain a reference to them.
+  TF_CONTROL_FLOW_EXCEPTION = 1 << 7,
+  // Small immutable class whose instances carry no observable identity, so a
+  // future compiler may store them flattened (no per-element ObjHeader or
+  // container) inside arrays and enclosing objects. Reserved: the runtime does
+  // not act on it yet, and until the codegen side lands, hand-flattened layouts
+  // are served by the ByteArray typed accessors (see TypedArrays.kt).
+  TF_VALUE_CLASS_CANDIDATE = 1 << 8,
+  // Instances get a cache-line aligned, padded container; for arrays the
+  // element data itself lands on the boundary, so SIMD kernels see aligned
+  // payloads and adjacent containers do not share a line. Best effort: only
+  // the mimalloc-backed allocator honours the alignment.
+  TF_ALIGNED_PAYLOAD = 1 << 9,
 };
 
 // Flags per object instance.
 enum Konan_MetaFlags {
   // If freeze attempt happens on such an object - throw an exception.
   MF_NEVER_FROZEN = 1 << 0,
+  // The object was frozen. Used by the experimental memory manager, where freezing
+  // is not a sharing precondition and only the immutability contract is recorded;
+  // the legacy manager keeps this state in the container header instead.
+  MF_FROZEN = 1 << 1,
 };
 
 // Extended information about a type.
@@ -174,6 +192,21 @@ void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) RUNTI
 InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord const* interfaceTable,
                                                        int interfaceTableSize, ClassId interfaceId) RUNTIME_CONST;
 
+// Registers the TypeInfo table a dynamically loaded Kotlin library carries. Types
+// duplicating an already registered one (matched by fully qualified name) get that
+// one as their canonical representative, so type checks recognize instances whose
+// class was linked into another library. Safe to call from library load hooks
+// before any runtime exists.
+void RegisterTypeInfoTable(const TypeInfo* const* typeInfos, int count) RUNTIME_NOTHROW;
+
+// Returns the canonical representative of [typeInfo]; [typeInfo] itself when no
+// duplicate of it was ever registered.
+const TypeInfo* CanonicalTypeInfo(const TypeInfo* typeInfo) RUNTIME_NOTHROW;
+
+// Cheap check whether any duplicate TypeInfo was registered at all, to keep the
+// single-library case free of lookups.
+bool HasDuplicateTypeInfos() RUNTIME_NOTHROW;
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
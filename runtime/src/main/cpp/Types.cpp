@@ -23,19 +23,52 @@ KBoolean IsInstance(const ObjHeader* obj, const TypeInfo* type_info) {
   // We assume null check is handled by caller.
   RuntimeAssert(obj != nullptr, "must not be null");
   const TypeInfo* obj_type_info = obj->type_info();
+  if (obj_type_info == type_info) return 1;
   // If it is an interface - check in list of implemented interfaces.
   if ((type_info->flags_ & TF_INTERFACE) != 0) {
+    // When the receiver class has an interface table, the check is O(1): look the
+    // interface id up exactly like interface dispatch does (see classId_ of
+    // interfaces in RTTIGenerator) and compare the record id, instead of walking
+    // implementedInterfaces_.
+    ClassId interfaceId = type_info->classId_;
+    if (interfaceId != kInvalidInterfaceId && obj_type_info->interfaceTable_ != nullptr) {
+      int interfaceTableSize = obj_type_info->interfaceTableSize_;
+      InterfaceTableRecord const* record = (interfaceTableSize >= 0)
+          ? obj_type_info->interfaceTable_ + (interfaceId & interfaceTableSize)
+          : LookupInterfaceTableRecord(obj_type_info->interfaceTable_, -interfaceTableSize, interfaceId);
+      if (record->id == interfaceId) return 1;
+      // Interface ids are assigned per compilation, so a miss is only final when
+      // the interface cannot stem from another loaded library.
+      if (!HasDuplicateTypeInfos()) return 0;
+    }
     for (int i = 0; i < obj_type_info->implementedInterfacesCount_; ++i) {
       if (obj_type_info->implementedInterfaces_[i] == type_info) {
         return 1;
       }
     }
+    if (HasDuplicateTypeInfos()) {
+      const TypeInfo* canonical = CanonicalTypeInfo(type_info);
+      for (int i = 0; i < obj_type_info->implementedInterfacesCount_; ++i) {
+        if (CanonicalTypeInfo(obj_type_info->implementedInterfaces_[i]) == canonical) {
+          return 1;
+        }
+      }
+    }
     return 0;
   }
   while (obj_type_info != nullptr && obj_type_info != type_info) {
     obj_type_info = obj_type_info->superType_;
   }
-  return obj_type_info != nullptr;
+  if (obj_type_info != nullptr) return 1;
+  // The class may have been linked into another loaded library, in which case its
+  // TypeInfo pointer differs; compare canonical representatives along the chain.
+  if (HasDuplicateTypeInfos()) {
+    const TypeInfo* canonical = CanonicalTypeInfo(type_info);
+    for (auto* current = obj->type_info(); current != nullptr; current = current->superType_) {
+      if (CanonicalTypeInfo(current) == canonical) return 1;
+    }
+  }
+  return 0;
 }
 
 KBoolean IsInstanceOfClassFast(const ObjHeader* obj, int32_t lo, int32_t hi) {
@@ -84,11 +117,30 @@ OBJ_GETTER(Kotlin_TypeInfo_findAssociatedObject, KNativePtr typeInfo, KNativePtr
 }
 
 bool IsSubInterface(const TypeInfo* thiz, const TypeInfo* other) {
+  if (thiz == other) return true;
+  // Same O(1) interface table shortcut as in IsInstance.
+  ClassId interfaceId = other->classId_;
+  if (interfaceId != kInvalidInterfaceId && thiz->interfaceTable_ != nullptr) {
+    int interfaceTableSize = thiz->interfaceTableSize_;
+    InterfaceTableRecord const* record = (interfaceTableSize >= 0)
+        ? thiz->interfaceTable_ + (interfaceId & interfaceTableSize)
+        : LookupInterfaceTableRecord(thiz->interfaceTable_, -interfaceTableSize, interfaceId);
+    if (record->id == interfaceId) return true;
+    if (!HasDuplicateTypeInfos()) return false;
+  }
   for (int i = 0; i < thiz->implementedInterfacesCount_; ++i) {
     if (thiz->implementedInterfaces_[i] == other) {
       return true;
     }
   }
+  if (HasDuplicateTypeInfos()) {
+    const TypeInfo* canonical = CanonicalTypeInfo(other);
+    for (int i = 0; i < thiz->implementedInterfacesCount_; ++i) {
+      if (CanonicalTypeInfo(thiz->implementedInterfaces_[i]) == canonical) {
+        return true;
+      }
+    }
+  }
 
   return false;
 }
@@ -85,7 +85,25 @@ OBJ_GETTER(Konan_WeakReferenceCounter_get, ObjHeader* counter) {
   RETURN_OBJ(*referredAddress);
 #else
   auto* weakCounter = asWeakReferenceCounter(counter);
-  RETURN_RESULT_OF(ReadHeapRefLocked, referredAddress,  &weakCounter->lock,  &weakCounter->cookie);
+  // Read-mostly fast path: materializing a live weak is an acquire load plus a
+  // conditional reference count increment, no lock. The increment pins the object:
+  // clearing only happens past the last strong release (see freeContainer()), so a
+  // successful TryAddHeapRef guarantees the object stays alive until the balancing
+  // release below.
+  ObjHeader* referred = __atomic_load_n(referredAddress, __ATOMIC_ACQUIRE);
+  if (referred == nullptr) {
+    RETURN_OBJ(nullptr);
+  }
+  if (TryAddHeapRef(referred)) {
+    UpdateReturnRef(OBJ_RESULT, referred);
+    AdoptReferenceFromSharedVariable(referred);
+    ReleaseHeapRefNoCollect(referred);  // Balance TryAddHeapRef.
+    return referred;
+  }
+  // The object is in its terminal release and the counter is about to be cleared:
+  // take the slow path, which serializes with WeakReferenceCounterClear on the
+  // spinlock, exactly as all reads used to.
+  RETURN_RESULT_OF(ReadHeapRefLocked, referredAddress, &weakCounter->lock, &weakCounter->cookie);
 #endif
 }
 
@@ -96,9 +114,10 @@ void WeakReferenceCounterClear(ObjHeader* counter) {
   *referredAddress = nullptr;
 #else
   int32_t* lockAddress = &asWeakReferenceCounter(counter)->lock;
-  // Spinlock.
+  // Spinlock, serializing with the slow path of Konan_WeakReferenceCounter_get;
+  // the release store publishes null to its lock-free fast path.
   lock(lockAddress);
-  *referredAddress = nullptr;
+  __atomic_store_n(referredAddress, nullptr, __ATOMIC_RELEASE);
   unlock(lockAddress);
 #endif
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "WeakKeyedTable.h"
+
+#include "Alloc.h"
+#include "Atomic.h"
+
+namespace {
+
+inline void lock(int32_t* spinlock) {
+  while (compareAndSwap(spinlock, 0, 1) != 0) {}
+}
+
+inline void unlock(int32_t* spinlock) {
+  compareAndSwap(spinlock, 1, 0);
+}
+
+}  // namespace
+
+struct WeakKeyedTable::Entry {
+  WeakKeyedTable* owner_;
+  KRef key_;
+  void* value_;
+  Entry* nextDead_;
+};
+
+WeakKeyedTable::WeakKeyedTable() : lock_(0), deadHead_(nullptr) {}
+
+WeakKeyedTable::~WeakKeyedTable() {
+  lock(&lock_);
+  for (auto& it: entries_) {
+    RemoveObjectDeathHook(it.first, it.second);
+    konanFreeMemory(it.second);
+  }
+  entries_.clear();
+  Entry* dead = deadHead_;
+  deadHead_ = nullptr;
+  unlock(&lock_);
+  while (dead != nullptr) {
+    Entry* next = dead->nextDead_;
+    konanFreeMemory(dead);
+    dead = next;
+  }
+}
+
+void* WeakKeyedTable::put(KRef key, void* value) {
+  lock(&lock_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    void* oldValue = it->second->value_;
+    it->second->value_ = value;
+    unlock(&lock_);
+    return oldValue;
+  }
+  auto* entry = konanConstructInstance<Entry>();
+  entry->owner_ = this;
+  entry->key_ = key;
+  entry->value_ = value;
+  entries_.emplace(key, entry);
+  // Registered under the table lock, so the death hook (which takes it as well)
+  // cannot observe a half-inserted entry.
+  AddObjectDeathHook(key, onKeyDeath, entry);
+  unlock(&lock_);
+  return nullptr;
+}
+
+void* WeakKeyedTable::get(KRef key) {
+  lock(&lock_);
+  auto it = entries_.find(key);
+  void* result = it != entries_.end() ? it->second->value_ : nullptr;
+  unlock(&lock_);
+  return result;
+}
+
+void* WeakKeyedTable::remove(KRef key) {
+  lock(&lock_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    unlock(&lock_);
+    return nullptr;
+  }
+  Entry* entry = it->second;
+  entries_.erase(it);
+  void* value = entry->value_;
+  if (RemoveObjectDeathHook(key, entry)) {
+    konanFreeMemory(entry);
+  } else {
+    // The key is being deallocated concurrently and its hook already claimed the
+    // entry; clear the value so that the in-flight hook queues an empty entry.
+    entry->value_ = nullptr;
+  }
+  unlock(&lock_);
+  return value;
+}
+
+void WeakKeyedTable::sweepDeadEntries(void (*callback)(void* value, void* argument), void* argument) {
+  lock(&lock_);
+  Entry* dead = deadHead_;
+  deadHead_ = nullptr;
+  unlock(&lock_);
+  while (dead != nullptr) {
+    Entry* next = dead->nextDead_;
+    // Entries claimed by a concurrent remove() carry no value any more.
+    if (callback != nullptr && dead->value_ != nullptr) callback(dead->value_, argument);
+    konanFreeMemory(dead);
+    dead = next;
+  }
+}
+
+void WeakKeyedTable::onKeyDeath(void* rawEntry) {
+  Entry* entry = reinterpret_cast<Entry*>(rawEntry);
+  WeakKeyedTable* owner = entry->owner_;
+  lock(&owner->lock_);
+  auto it = owner->entries_.find(entry->key_);
+  if (it != owner->entries_.end() && it->second == entry) owner->entries_.erase(it);
+  entry->key_ = nullptr;
+  entry->nextDead_ = owner->deadHead_;
+  owner->deadHead_ = entry;
+  unlock(&owner->lock_);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_WEAK_KEYED_TABLE_H
+#define RUNTIME_WEAK_KEYED_TABLE_H
+
+#include "Memory.h"
+#include "Types.h"
+
+// A weak-keyed table (ephemeron map) for runtime-internal registries: keys are Kotlin
+// objects which the table does not keep alive, values are arbitrary native pointers.
+// When a key dies its entry is unlinked by an object death hook - O(1) per dead key -
+// and queued for sweepDeadEntries(), which hands the queued values to a batch callback;
+// no timer-driven scan over live entries is ever needed.
+//
+// All operations are thread-safe. Entries with permanent keys are effectively strong
+// (permanent objects never die). Death hooks run on the deallocating thread, so value
+// destructors invoked from sweepDeadEntries() and the hooks themselves must not
+// allocate Kotlin objects or throw.
+class WeakKeyedTable {
+ public:
+  WeakKeyedTable();
+  ~WeakKeyedTable();
+
+  WeakKeyedTable(const WeakKeyedTable&) = delete;
+  WeakKeyedTable& operator=(const WeakKeyedTable&) = delete;
+
+  // Associates [value] with [key]; returns the previous value or nullptr.
+  void* put(KRef key, void* value);
+  // Returns the value associated with [key], or nullptr.
+  void* get(KRef key);
+  // Removes the entry for [key]; returns its value or nullptr.
+  void* remove(KRef key);
+  // Invokes [callback] with the value of every entry whose key died since the
+  // previous sweep, then frees those entries. O(number of dead entries).
+  void sweepDeadEntries(void (*callback)(void* value, void* argument), void* argument);
+
+ private:
+  struct Entry;
+
+  static void onKeyDeath(void* rawEntry);
+
+  int32_t lock_;
+  KStdUnorderedMap<KRef, Entry*> entries_;
+  Entry* deadHead_;
+};
+
+#endif // RUNTIME_WEAK_KEYED_TABLE_H
@@ -23,16 +23,43 @@
 #include <stdio.h>
 
 #if WITH_WORKERS
+#include <limits.h>
 #include <pthread.h>
 #include "PthreadUtils.h"
 #endif
 
+// Hard CPU affinity is only a Linux concept; elsewhere the affinity API
+// reports itself unsupported.
+#if WITH_WORKERS && KONAN_LINUX
+#define WITH_CPU_AFFINITY 1
+#include <sched.h>
+#endif
+
+#if !KONAN_WINDOWS && !KONAN_WASM && !KONAN_ZEPHYR
+#include <unistd.h>
+#endif
+
+// A self-pipe is used to make future completion observable by external event loops
+// (epoll/kqueue/poll); not available where pipes are not POSIX.
+#if WITH_WORKERS && !KONAN_WINDOWS
+#define WITH_COMPLETION_FD 1
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "Alloc.h"
+#include "Atomic.h"
 #include "Exceptions.h"
 #include "KAssert.h"
 #include "Memory.h"
+#include "Natives.h"
 #include "ObjCMMAPI.h"
+#include "Porting.h"
 #include "Runtime.h"
+#include "RuntimeConfig.h"
+#include "RuntimeCounters.h"
+#include "SafePoint.h"
 #include "Types.h"
 #include "Worker.h"
 
@@ -44,6 +71,24 @@ OBJ_GETTER(WorkerLaunchpad, KRef);
 
 }  // extern "C"
 
+namespace {
+
+// Lanes of a worker's job queue; lower values are dispatched first. Values must
+// match JobPriority in Worker.kt.
+enum JobPriority {
+  JOB_PRIORITY_HIGH = 0,
+  JOB_PRIORITY_NORMAL = 1,
+  JOB_PRIORITY_BULK = 2,
+};
+
+constexpr int kPriorityLanes = 3;
+
+// After this many consecutive picks from higher lanes while a lower lane has
+// jobs waiting, the waiting lane gets one job through, bounding its starvation.
+constexpr uint32_t kLaneStarvationBound = 16;
+
+}  // namespace
+
 #if WITH_WORKERS
 
 namespace {
@@ -79,6 +124,14 @@ enum class WorkerKind {
 
 struct Job {
   enum JobKind kind;
+  // Lane the job is dispatched from, one of JobPriority. Stamped at submission.
+  int32_t priority;
+  // Absolute time the job should be running by, in konan::getTimeMicros() terms,
+  // or 0 for none. A job still queued past this point jumps ahead of every lane.
+  uint64_t deadlineMicros;
+  // When the job entered the queue, for the time-in-queue statistics. Stamped
+  // by the put* methods; delayed jobs are restamped once their deadline expires.
+  uint64_t submitTimeMicros;
   union {
     struct {
       KRef (*function)(KRef, ObjHeader**);
@@ -95,18 +148,158 @@ struct Job {
     struct {
       KNativePtr operation;
       uint64_t whenExecute;
+      // Worker the job was scheduled on, routes it out of the shared timer wheel.
+      KInt ownerId;
     } executeAfter;
   };
 };
 
-struct JobCompare {
-  bool operator() (const Job& lhs, const Job& rhs) const {
-    RuntimeAssert(lhs.kind == JOB_EXECUTE_AFTER && rhs.kind == JOB_EXECUTE_AFTER, "Must be delayed jobs");
-    return lhs.executeAfter.whenExecute < rhs.executeAfter.whenExecute;
+// A hashed timer wheel holding delayed jobs, the storage of the shared timer
+// service (see DelayedJobTimer). Insertion is O(1):
+// a job lands into the bucket its deadline hashes to, and buckets keep unsorted
+// lists, so jobs whose deadline is more than a wheel round away share buckets with
+// near ones and simply stay there for another round. The dispatch side only scans
+// the buckets between the cursor and the current time; a cached earliest deadline
+// bounds how long the worker may sleep and avoids spinning over empty buckets.
+class DelayedJobWheel {
+ public:
+  DelayedJobWheel() {
+    for (uint32_t i = 0; i < kWheelSize; ++i) bucketMin_[i] = kNoDeadline;
+  }
+
+  size_t size() const { return size_; }
+
+  void insert(const Job& job) {
+    RuntimeAssert(job.kind == JOB_EXECUTE_AFTER, "Must be a delayed job");
+    uint64_t when = job.executeAfter.whenExecute;
+    if (size_ == 0) {
+      // Rebase the cursor, so that a long idle wheel is not scanned through
+      // every tick passed since the previous expiry.
+      currentTick_ = konan::getTimeMicros() / kTickMicroseconds;
+    }
+    uint64_t tick = when / kTickMicroseconds;
+    if (tick < currentTick_) tick = currentTick_;
+    uint32_t index = tick % kWheelSize;
+    buckets_[index].push_back(job);
+    if (when < bucketMin_[index]) bucketMin_[index] = when;
+    if (when < nextDeadline_) nextDeadline_ = when;
+    size_++;
+  }
+
+  // Moves jobs whose deadline has passed into [ready], returns how many moved.
+  // Whenever the earliest deadline has passed at least one job is moved.
+  uint32_t moveExpired(uint64_t nowMicroseconds, KStdDeque<Job>* ready) {
+    if (size_ == 0 || nowMicroseconds < nextDeadline_) return 0;
+    uint32_t moved = 0;
+    uint64_t nowTick = nowMicroseconds / kTickMicroseconds;
+    // A full circle covers the whole wheel, no point in visiting buckets twice.
+    uint64_t lastTick = nowTick;
+    if (lastTick - currentTick_ >= kWheelSize) lastTick = currentTick_ + kWheelSize - 1;
+    for (uint64_t tick = currentTick_; tick <= lastTick; ++tick) {
+      uint32_t index = tick % kWheelSize;
+      auto& bucket = buckets_[index];
+      uint64_t min = kNoDeadline;
+      for (size_t i = 0; i < bucket.size();) {
+        uint64_t when = bucket[i].executeAfter.whenExecute;
+        if (when <= nowMicroseconds) {
+          ready->push_back(bucket[i]);
+          bucket[i] = bucket.back();
+          bucket.pop_back();
+          moved++;
+        } else {
+          if (when < min) min = when;
+          i++;
+        }
+      }
+      bucketMin_[index] = min;
+    }
+    currentTick_ = nowTick;
+    size_ -= moved;
+    nextDeadline_ = kNoDeadline;
+    for (uint32_t i = 0; i < kWheelSize; ++i) {
+      if (bucketMin_[i] < nextDeadline_) nextDeadline_ = bucketMin_[i];
+    }
+    return moved;
+  }
+
+  // Earliest pending deadline; only meaningful while size() != 0.
+  uint64_t nextDeadline() const { return nextDeadline_; }
+
+  // Calls [process] for every pending job.
+  template <typename func>
+  void forEach(func process) {
+    for (uint32_t i = 0; i < kWheelSize; ++i) {
+      for (auto& job: buckets_[i]) process(job);
+    }
+  }
+
+  // Extracts every job [predicate] accepts into [out], recomputing the cached
+  // deadlines; used when a worker goes away with jobs still pending.
+  template <typename Pred>
+  void extractIf(Pred predicate, KStdVector<Job>* out) {
+    for (uint32_t index = 0; index < kWheelSize; ++index) {
+      auto& bucket = buckets_[index];
+      uint64_t min = kNoDeadline;
+      for (size_t i = 0; i < bucket.size();) {
+        if (predicate(bucket[i])) {
+          out->push_back(bucket[i]);
+          bucket[i] = bucket.back();
+          bucket.pop_back();
+          size_--;
+        } else {
+          uint64_t when = bucket[i].executeAfter.whenExecute;
+          if (when < min) min = when;
+          i++;
+        }
+      }
+      bucketMin_[index] = min;
+    }
+    nextDeadline_ = kNoDeadline;
+    for (uint32_t i = 0; i < kWheelSize; ++i) {
+      if (bucketMin_[i] < nextDeadline_) nextDeadline_ = bucketMin_[i];
+    }
   }
+
+ private:
+  static constexpr uint64_t kTickMicroseconds = 1000;
+  static constexpr uint32_t kWheelSize = 256;
+  static constexpr uint64_t kNoDeadline = ~static_cast<uint64_t>(0);
+
+  KStdVector<Job> buckets_[kWheelSize];
+  // Earliest deadline per bucket, [kNoDeadline] for empty ones.
+  uint64_t bucketMin_[kWheelSize];
+  // The tick the dispatch side has processed up to.
+  uint64_t currentTick_ = 0;
+  uint64_t nextDeadline_ = kNoDeadline;
+  size_t size_ = 0;
 };
 
-typedef KStdOrderedSet<Job, JobCompare> DelayedJobSet;
+// How long an idle pool member waits on its own queue before trying to steal from siblings.
+constexpr KLong kJobStealPollMicroseconds = 500;
+
+// How many queued jobs a worker moves into its private buffer per lock acquisition,
+// so that tiny jobs do not pay a lock roundtrip each.
+constexpr size_t kMaxJobPrefetch = 64;
+
+// The spin-before-park parameters (how many pause-hinted polling iterations,
+// and up to which average queue-refill gap spinning is worthwhile) live in
+// KonanRuntimeConfig as workerSpinIterations / workerSpinGapMicroseconds, so
+// deployments can tune them without recompiling.
+
+// Processor hint for spin loops, a no-op where not supported.
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// Node of the lock-free submission stack, see Worker::putJob.
+struct InboxNode {
+  Job job;
+  InboxNode* next;
+};
 
 }  // namespace
 
@@ -118,7 +311,7 @@ class Worker {
         errorReporting_(errorReporting) {
     name_ = customName != nullptr ? CreateStablePointer(customName) : nullptr;
     pthread_mutex_init(&lock_, nullptr);
-    pthread_cond_init(&cond_, nullptr);
+    CounterIncrement(RTC_WORKERS_STARTED);
   }
 
   ~Worker();
@@ -126,20 +319,55 @@ class Worker {
   void startEventLoop();
 
   void putJob(Job job, bool toFront);
-  void putDelayedJob(Job job);
+  // Publishes the whole batch as a single linked inbox segment with one
+  // compare-and-swap and at most one wakeup, preserving the order of [jobs].
+  void putJobBatch(const KStdVector<Job>& jobs);
 
   bool waitDelayed(bool blocking);
 
   Job getJob(bool blocking);
 
-  KLong checkDelayedLocked();
+  // Takes a stealable job from the back of the queue, or JOB_NONE.
+  Job trySteal();
+
+  size_t queueSize();
+
+  // Moves everything published to inbox_ to the back of its lane. Callers must hold lock_.
+  void drainInboxLocked();
+
+  // Total number of queued jobs across the lanes. Callers must hold lock_.
+  size_t queuedCountLocked() const;
+
+  // Routes [job] to the lane its priority names. Callers must hold lock_.
+  void pushJobLocked(Job job, bool toFront);
+
+  // Picks the next job to run, honoring expired deadlines, lane priorities and
+  // the starvation bound. Queue must be non-empty; callers must hold lock_.
+  Job popJobLocked();
+
+  // Moves up to kMaxJobPrefetch jobs from the lanes to prefetched_. Callers must hold lock_.
+  void prefetchLocked();
 
   bool waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining);
 
+  // Feeds the empty-queue duration EWMA driving the adaptive spin, see
+  // waitForQueueLocked. Only called by the worker thread.
+  void noteQueueEmptyGap(uint64_t emptySinceMicros);
+
   JobKind processQueueElement(bool blocking);
 
+  // Enqueues [continuation] behind pending jobs if there are any, in the lane of
+  // the job being executed. Returns false and schedules nothing on an empty queue.
+  // Only called by the worker thread itself, from inside a job.
+  bool yieldJob(KRef continuation);
+
   bool park(KLong timeoutMicroseconds, bool process);
 
+  // Returns a descriptor becoming readable whenever a job is put on this worker's
+  // queue, for integration with external event loops (CFRunLoop/epoll/kqueue), or
+  // -1 if not supported. Created lazily, lives as long as the worker.
+  KInt notificationFd();
+
   KInt id() const { return id_; }
 
   bool errorReporting() const { return errorReporting_; }
@@ -150,20 +378,68 @@ class Worker {
 
   pthread_t thread() const { return thread_; }
 
+  KInt poolId() const { return poolId_; }
+
+  // Only called between worker creation and startEventLoop().
+  void setPoolId(KInt poolId) { poolId_ = poolId; }
+
+  // Time-in-queue histogram buckets: bucket i counts jobs that waited less
+  // than 2^i microseconds, the last bucket collects everything above.
+  static constexpr int kTimeInQueueBuckets = 16;
+  // Stats layout: jobs enqueued, jobs processed, histogram buckets.
+  static constexpr int kStatsSize = 2 + kTimeInQueueBuckets;
+
+  // Fills [stats] (of kStatsSize elements) from the relaxed counters.
+  void getStats(KLong* stats);
+
  private:
+  // Writes one byte to the notification pipe if one was requested. Called by
+  // producers after publishing a job, so it must not take lock_.
+  void signalNotificationFd();
+
   KInt id_;
   WorkerKind kind_;
-  KStdDeque<Job> queue_;
-  DelayedJobSet delayed_;
+  // Pool this worker belongs to, or 0 for standalone workers.
+  KInt poolId_ = 0;
+  // Lock-free submission stack: producers push with a single CAS, drained into
+  // the lanes under lock_ by whoever inspects the queue. Most recent job first.
+  InboxNode* inbox_ = nullptr;
+  // Wait word the worker parks on (see FutexWait): non-zero while it is about to
+  // sleep, so producers know when a wakeup is needed and clear it to wake.
+  int32_t sleeping_ = 0;
+  // Job queue, split into priority lanes; see popJobLocked for the dispatch order.
+  KStdDeque<Job> lanes_[kPriorityLanes];
+  // How many times each non-empty lane was passed over in favor of a higher one,
+  // reset whenever the lane gets a job through. Drives the starvation bound.
+  uint32_t lanePassedOver_[kPriorityLanes] = {};
+  // Jobs already claimed from the queue by this worker, served without taking lock_.
+  // Only ever touched by the worker thread itself.
+  KStdDeque<Job> prefetched_;
   // Stable pointer with worker's name.
   KNativePtr name_;
-  // Lock and condition for waiting on the queue.
+  // Lock guarding the queue; waiting happens on the sleeping_ word.
   pthread_mutex_t lock_;
-  pthread_cond_t cond_;
   // If errors to be reported on console.
   bool errorReporting_;
   bool terminated_ = false;
   pthread_t thread_ = 0;
+  // Lane and deadline of the job currently being executed, captured by yieldJob
+  // so a yielded continuation resumes where the original job was queued. Only
+  // touched by the worker thread.
+  int32_t runningJobPriority_ = JOB_PRIORITY_NORMAL;
+  uint64_t runningJobDeadline_ = 0;
+  // Lazily created self-pipe signalled on every job submission, see notificationFd().
+  // The write end is read by producers without the lock, hence the atomic accesses.
+  int32_t notifyReadFd_ = -1;
+  int32_t notifyWriteFd_ = -1;
+  // EWMA of how long the queue stays empty, microseconds. Only touched by the
+  // worker thread.
+  uint64_t emptyQueueGapEwmaMicros_ =
+      static_cast<uint64_t>(konanRuntimeConfig().workerSpinGapMicroseconds);
+  // Load statistics: plain relaxed counters, read via Kotlin_Worker_getStatsInternal.
+  KLong enqueuedJobsCount_ = 0;
+  KLong processedJobsCount_ = 0;
+  KLong timeInQueue_[kTimeInQueueBuckets] = {};
 };
 
 #endif  // WITH_WORKERS
@@ -174,6 +450,13 @@ namespace {
 
 THREAD_LOCAL_VARIABLE Worker* g_worker = nullptr;
 
+// Stack size for worker threads started from now on, in bytes; zero keeps the
+// platform default. Default pthread stacks reserve 8MiB each, so pools of
+// thousands of short-lived workers pay gigabytes of virtual memory and the
+// setup cost of mapping them; a deliberately smaller stack lets the pthread
+// implementation recycle cached stacks across worker generations.
+KInt pendingWorkerStackSize = 0;
+
 KNativePtr transfer(ObjHolder* holder, KInt mode) {
   void* result = CreateStablePointer(holder->obj());
   if (!ClearSubgraphReferences(holder->obj(), mode == CHECKED)) {
@@ -197,17 +480,192 @@ class Locker {
   pthread_mutex_t* lock_;
 };
 
+// Single-producer single-consumer ring of detached object graphs. Each slot
+// holds a stable pointer produced by transfer(), so a message costs one detach
+// plus a couple of atomic accesses instead of a full detach/attach round trip
+// through shared state. head_ is only written by the producer, tail_ only by
+// the consumer; capacity is rounded up to a power of two so indices wrap by
+// masking.
+class ObjectChannel {
+ public:
+  explicit ObjectChannel(KInt id, uint32_t capacity) : id_(id), head_(0), tail_(0) {
+    capacity_ = 1;
+    while (capacity_ < capacity) capacity_ <<= 1;
+    slots_ = konanAllocArray<KNativePtr>(capacity_);
+  }
+
+  ~ObjectChannel() {
+    konanFreeMemory(slots_);
+  }
+
+  KInt id() const { return id_; }
+
+  // Producer side. Checking fullness is separate from pushing, so that the
+  // caller only detaches the message once a slot is certain to be available:
+  // with a single producer nobody else can claim it in between.
+  bool full() {
+    return head_ - atomicGet(&tail_) >= static_cast<int32_t>(capacity_);
+  }
+
+  void send(KNativePtr stable) {
+    int32_t head = head_;
+    slots_[head & (capacity_ - 1)] = stable;
+    // Publishes the slot: atomicSet is a full barrier, so the consumer seeing
+    // the new head also sees the slot contents.
+    atomicSet(&head_, head + 1);
+  }
+
+  // Consumer side. Returns nullptr when the ring is empty.
+  KNativePtr tryReceive() {
+    int32_t tail = tail_;
+    if (tail == atomicGet(&head_)) return nullptr;
+    KNativePtr result = slots_[tail & (capacity_ - 1)];
+    atomicSet(&tail_, tail + 1);
+    return result;
+  }
+
+ private:
+  KInt id_;
+  uint32_t capacity_;
+  KNativePtr* slots_;
+  int32_t head_;
+  int32_t tail_;
+};
+
+// Routes a job whose deadline has passed back to the worker it was scheduled
+// on. Defined after State, which owns the worker registry.
+void postExpiredDelayedJob(Job job);
+
+// A single runtime-wide service thread dispatching the delayed jobs of all
+// workers: with per-worker timers every worker holding pending [executeAfter]
+// jobs wakes up for its own deadlines, while one shared wheel consolidates
+// those wakeups, and a configurable coalescing window additionally lets nearby
+// deadlines share one. Due jobs return to their owner's queue through the
+// regular submission path.
+class DelayedJobTimer {
+ public:
+  DelayedJobTimer() {
+    pthread_mutex_init(&lock_, nullptr);
+    pthread_cond_init(&cond_, nullptr);
+  }
+
+  // Accepts a delayed job on behalf of [ownerId]; the service thread is created
+  // on first use, so programs never delaying jobs do not pay for it.
+  void submit(KInt ownerId, Job job) {
+    job.executeAfter.ownerId = ownerId;
+    Locker locker(&lock_);
+    bool earlier = wheel_.size() == 0 || job.executeAfter.whenExecute < wheel_.nextDeadline();
+    wheel_.insert(job);
+    if (!started_) {
+      started_ = true;
+      pthread_create(&thread_, nullptr, serviceRoutine, this);
+    } else if (earlier) {
+      // Only a new earliest deadline has to move the next wakeup forward.
+      pthread_cond_signal(&cond_);
+    }
+  }
+
+  // Whether [ownerId] still has jobs waiting in the wheel: a terminating worker
+  // honouring scheduled jobs keeps its event loop alive until they came back.
+  bool hasDelayedFor(KInt ownerId) {
+    Locker locker(&lock_);
+    bool found = false;
+    wheel_.forEach([ownerId, &found](const Job& job) {
+      if (job.executeAfter.ownerId == ownerId) found = true;
+    });
+    return found;
+  }
+
+  // Extracts and disposes the pending jobs of a worker going away without
+  // draining them. Runs on the terminating thread, which still has a runtime.
+  void cancelJobsFor(KInt ownerId) {
+    KStdVector<Job> cancelled;
+    {
+      Locker locker(&lock_);
+      wheel_.extractIf(
+          [ownerId](const Job& job) { return job.executeAfter.ownerId == ownerId; }, &cancelled);
+    }
+    for (auto& job : cancelled) DisposeStablePointer(job.executeAfter.operation);
+  }
+
+  // Window by which a dispatch may be delayed past its deadline so that nearby
+  // deadlines share a single wakeup. Zero (the default) still consolidates the
+  // wakeups of coinciding deadlines, just without stretching any.
+  void setCoalescingWindow(KLong microseconds) {
+    atomicSet(&coalescingMicros_, microseconds >= 0 ? microseconds : KLong(0));
+  }
+
+ private:
+  static void* serviceRoutine(void* argument) {
+    // Jobs whose worker is gone by their deadline are disposed right on this
+    // thread, hence the full runtime, as on any native thread entering Kotlin.
+    Kotlin_initRuntimeIfNeeded();
+    reinterpret_cast<DelayedJobTimer*>(argument)->run();
+    return nullptr;
+  }
+
+  void run() {
+    KStdDeque<Job> ready;
+    while (true) {
+      {
+        Locker locker(&lock_);
+        while (true) {
+          if (wheel_.size() == 0) {
+            SafePointEnterNative();
+            pthread_cond_wait(&cond_, &lock_);
+            SafePointLeaveNative();
+            continue;
+          }
+          uint64_t now = konan::getTimeMicros();
+          if (wheel_.moveExpired(now, &ready) > 0) break;
+          uint64_t wakeAt =
+              wheel_.nextDeadline() + static_cast<uint64_t>(atomicGet(&coalescingMicros_));
+          SafePointEnterNative();
+          WaitOnCondVar(&cond_, &lock_, (wakeAt - now) * 1000ULL);
+          SafePointLeaveNative();
+        }
+      }
+      // Dispatch outside the lock: posting takes the registry and queue locks.
+      for (auto& job : ready) postExpiredDelayedJob(job);
+      ready.clear();
+    }
+  }
+
+  pthread_mutex_t lock_;
+  pthread_cond_t cond_;
+  pthread_t thread_ = 0;
+  bool started_ = false;
+  KLong coalescingMicros_ = 0;
+  DelayedJobWheel wheel_;
+};
+
+DelayedJobTimer* theDelayedJobTimer() {
+  static DelayedJobTimer* timer = nullptr;
+
+  if (timer != nullptr) {
+    return timer;
+  }
+
+  DelayedJobTimer* result = konanConstructInstance<DelayedJobTimer>();
+
+  DelayedJobTimer* old = __sync_val_compare_and_swap(&timer, nullptr, result);
+  if (old != nullptr) {
+    konanDestructInstance(result);
+    // Someone else inited this data.
+    return old;
+  }
+  return timer;
+}
+
 class Future {
  public:
   Future(KInt id) : state_(SCHEDULED), id_(id) {
     pthread_mutex_init(&lock_, nullptr);
-    pthread_cond_init(&cond_, nullptr);
   }
 
   ~Future() {
     clear();
     pthread_mutex_destroy(&lock_);
-    pthread_cond_destroy(&cond_);
   }
 
   void clear() {
@@ -220,10 +678,15 @@ class Future {
   }
 
   OBJ_GETTER0(consumeResultUnlocked) {
-    Locker locker(&lock_);
-    while (state_ == SCHEDULED) {
-      pthread_cond_wait(&cond_, &lock_);
+    // Wait on the state word itself: an already completed future costs one load
+    // and no kernel round trip at all.
+    while (atomicGet(&state_) == static_cast<KInt>(SCHEDULED)) {
+      // A thread blocked on a future result does not delay safepoint handshakes.
+      SafePointEnterNative();
+      FutexWait(&state_, SCHEDULED, -1);
+      SafePointLeaveNative();
     }
+    Locker locker(&lock_);
     // TODO: maybe use message from exception?
     if (state_ == THROWN)
         ThrowIllegalStateException();
@@ -232,6 +695,19 @@ class Future {
     return result;
   }
 
+  // Lock-free check whether a result was successfully stored: pairs with the
+  // atomic state store in storeResultUnlocked, so a true answer also makes the
+  // stored result visible to the caller.
+  bool computed() { return atomicGet(&state_) == static_cast<KInt>(COMPUTED); }
+
+  // Adopts the result of a COMPUTED future already unpublished from the registry:
+  // this thread owns the future exclusively, so no lock is taken at all.
+  OBJ_GETTER0(consumeComputedResult) {
+    auto result = AdoptStablePointer(result_, OBJ_RESULT);
+    result_ = nullptr;
+    return result;
+  }
+
   void storeResultUnlocked(KNativePtr result, bool ok);
 
   void cancelUnlocked();
@@ -241,15 +717,14 @@ class Future {
   KInt id() const { return id_; }
 
  private:
-  // State of future execution.
+  // State of future execution, doubling as the wait word (see FutexWait).
   KInt state_;
   // Integer id of the future.
   KInt id_;
   // Stable pointer with future's result.
   KNativePtr result_;
-  // Lock and condition for waiting on the future.
+  // Lock guarding the result; waiting happens on the state word.
   pthread_mutex_t lock_;
-  pthread_cond_t cond_;
 };
 
 class State {
@@ -260,13 +735,24 @@ class State {
 
     currentWorkerId_ = 1;
     currentFutureId_ = 1;
+    currentPoolId_ = 1;
+    currentChannelId_ = 1;
     currentVersion_ = 0;
+    waitersCount_ = 0;
+    completionReadFd_ = -1;
+    completionWriteFd_ = -1;
   }
 
   ~State() {
     // TODO: some sanity check here?
     pthread_mutex_destroy(&lock_);
     pthread_cond_destroy(&cond_);
+#if WITH_COMPLETION_FD
+    if (completionReadFd_ != -1) {
+      close(completionReadFd_);
+      close(completionWriteFd_);
+    }
+#endif  // WITH_COMPLETION_FD
   }
 
   Worker* addWorkerUnlocked(bool errorReporting, KRef customName, WorkerKind kind) {
@@ -289,10 +775,80 @@ class State {
     if (worker->kind() == WorkerKind::kNative) {
       terminating_native_workers_[id] = worker->thread();
     }
+    removeFromPoolLocked(worker);
     workers_.erase(it);
   }
 
+  KInt createPoolUnlocked(KInt size, bool errorReporting) {
+    KStdVector<Worker*> members;
+    for (KInt i = 0; i < size; i++) {
+      Worker* worker = addWorkerUnlocked(errorReporting, nullptr, WorkerKind::kNative);
+      if (worker == nullptr) return -1;
+      members.push_back(worker);
+    }
+    KInt poolId;
+    {
+      Locker locker(&lock_);
+      poolId = nextPoolId();
+      for (auto* member : members) member->setPoolId(poolId);
+      pools_[poolId] = members;
+    }
+    for (auto* member : members) member->startEventLoop();
+    return poolId;
+  }
+
+  // Picks the pool member next job shall be submitted to, -1 if pool is unknown.
+  KInt poolScheduleUnlocked(KInt poolId) {
+    Locker locker(&lock_);
+    auto it = pools_.find(poolId);
+    if (it == pools_.end() || it->second.size() == 0) return -1;
+    // Prefer the member with the shortest queue, work stealing evens out mistakes.
+    Worker* target = nullptr;
+    size_t known = 0;
+    for (auto* member : it->second) {
+      size_t depth = member->queueSize();
+      if (target == nullptr || depth < known) {
+        target = member;
+        known = depth;
+      }
+    }
+    return target->id();
+  }
+
+  KInt poolSizeUnlocked(KInt poolId) {
+    Locker locker(&lock_);
+    auto it = pools_.find(poolId);
+    if (it == pools_.end()) return -1;
+    return it->second.size();
+  }
+
+  KInt poolMemberUnlocked(KInt poolId, KInt index) {
+    Locker locker(&lock_);
+    auto it = pools_.find(poolId);
+    if (it == pools_.end()) return -1;
+    if (index < 0 || static_cast<size_t>(index) >= it->second.size()) return -1;
+    return it->second[index]->id();
+  }
+
+  // Takes a job from the back of some sibling's queue. Keeping the state lock here ensures
+  // victims cannot be destroyed mid-steal, lock order (state, then worker) matches putJob paths.
+  Job stealJobForWorkerUnlocked(Worker* thief) {
+    Locker locker(&lock_);
+    auto it = pools_.find(thief->poolId());
+    if (it != pools_.end()) {
+      for (auto* victim : it->second) {
+        if (victim == thief) continue;
+        Job job = victim->trySteal();
+        if (job.kind != JOB_NONE) return job;
+      }
+    }
+    return Job { .kind = JOB_NONE };
+  }
+
   void destroyWorkerUnlocked(Worker* worker) {
+    // Jobs still ticking for this worker in the timer service would otherwise
+    // hold their stable pointers until their deadline passes.
+    theDelayedJobTimer()->cancelJobsFor(worker->id());
     {
       Locker locker(&lock_);
       auto id = worker->id();
@@ -319,6 +875,8 @@ class State {
     futures_[future->id()] = future;
 
     Job job;
+    job.priority = JOB_PRIORITY_NORMAL;
+    job.deadlineMicros = 0;
     if (jobFunction == nullptr) {
       job.kind = JOB_TERMINATE;
       job.terminationRequest.future = future;
@@ -336,11 +894,14 @@ class State {
     return future;
   }
 
-  bool executeJobAfterInWorkerUnlocked(KInt id, KRef operation, KLong afterMicroseconds) {
+  bool executeJobAfterInWorkerUnlocked(KInt id, KRef operation, KLong afterMicroseconds,
+                                       KInt priority, KLong deadlineMicroseconds) {
     Worker* worker = nullptr;
     Locker locker(&lock_);
 
     RuntimeAssert(afterMicroseconds >= 0, "afterMicroseconds cannot be negative");
+    RuntimeAssert(priority >= 0 && priority < kPriorityLanes, "Invalid job priority");
+    RuntimeAssert(deadlineMicroseconds >= 0, "deadlineMicroseconds cannot be negative");
 
     auto it = workers_.find(id);
     if (it == workers_.end()) {
@@ -349,16 +910,53 @@ class State {
     worker = it->second;
     Job job;
     job.kind = JOB_EXECUTE_AFTER;
+    job.priority = priority;
+    job.deadlineMicros =
+        deadlineMicroseconds == 0 ? 0 : konan::getTimeMicros() + deadlineMicroseconds;
     job.executeAfter.operation = CreateStablePointer(operation);
     if (afterMicroseconds == 0) {
       worker->putJob(job, false);
     } else {
       job.executeAfter.whenExecute = konan::getTimeMicros() + afterMicroseconds;
-      worker->putDelayedJob(job);
+      theDelayedJobTimer()->submit(id, job);
     }
     return true;
   }
 
+  // Accepts a delayed job back from the timer service once its deadline passed.
+  // Returns false if the worker is gone; the caller owns the operation then.
+  bool postDelayedJobToWorkerUnlocked(KInt id, Job job) {
+    Locker locker(&lock_);
+    auto it = workers_.find(id);
+    if (it == workers_.end()) return false;
+    it->second->putJob(job, false);
+    return true;
+  }
+
+  bool executeJobsBatchInWorkerUnlocked(KInt id, KRef operations) {
+    Worker* worker = nullptr;
+    Locker locker(&lock_);
+
+    auto it = workers_.find(id);
+    if (it == workers_.end()) {
+      return false;
+    }
+    worker = it->second;
+    const ArrayHeader* array = operations->array();
+    KStdVector<Job> jobs;
+    jobs.reserve(array->count_);
+    for (uint32_t index = 0; index < array->count_; index++) {
+      Job job;
+      job.kind = JOB_EXECUTE_AFTER;
+      job.priority = JOB_PRIORITY_NORMAL;
+      job.deadlineMicros = 0;
+      job.executeAfter.operation = CreateStablePointer(*ArrayAddressOfElementAt(array, index));
+      jobs.push_back(job);
+    }
+    worker->putJobBatch(jobs);
+    return true;
+  }
+
   bool scheduleJobInWorkerUnlocked(KInt id, KNativePtr operationStablePtr) {
       Worker* worker = nullptr;
       Locker locker(&lock_);
@@ -371,6 +969,8 @@ class State {
 
       Job job;
       job.kind = JOB_EXECUTE_AFTER;
+      job.priority = JOB_PRIORITY_NORMAL;
+      job.deadlineMicros = 0;
       job.executeAfter.operation = operationStablePtr;
       worker->putJob(job, false);
       return true;
@@ -384,12 +984,29 @@ class State {
     return kind != JOB_NONE && kind != JOB_TERMINATE;
   }
 
+  // Returns `true` if [continuation] was enqueued behind pending jobs of the
+  // current worker, `false` if its queue is empty and the caller should go on.
+  bool yieldJobUnlocked(KInt id, KRef continuation) {
+    // Can only yield on the current worker.
+    if (::g_worker == nullptr || id != ::g_worker->id()) ThrowWorkerInvalidState();
+    return ::g_worker->yieldJob(continuation);
+  }
+
   bool parkUnlocked(KInt id, KLong timeoutMicroseconds, KBoolean process) {
       // Can only park current worker.
       if (::g_worker == nullptr || id != ::g_worker->id()) ThrowWorkerInvalidState();
       return ::g_worker->park(timeoutMicroseconds, process);
   }
 
+  KInt workerNotificationFdUnlocked(KInt id) {
+    // The registry lock is held across the call so the worker cannot be destroyed
+    // mid-creation; lock order (state, then worker) matches the putJob paths.
+    Locker locker(&lock_);
+    auto it = workers_.find(id);
+    if (it == workers_.end()) ThrowWorkerInvalidState();
+    return it->second->notificationFd();
+  }
+
   KInt stateOfFutureUnlocked(KInt id) {
     Locker locker(&lock_);
     auto it = futures_.find(id);
@@ -399,12 +1016,25 @@ class State {
 
   OBJ_GETTER(consumeFutureUnlocked, KInt id) {
     Future* future = nullptr;
+    bool computed = false;
     {
       Locker locker(&lock_);
       auto it = futures_.find(id);
       if (it == futures_.end()) ThrowWorkerInvalidState();
       future = it->second;
+      // A future computed long ago is the common case in pipelined designs.
+      // Unpublish it right away, making this thread its exclusive owner: the
+      // result is then consumed without the future's lock, without waiting
+      // machinery and without a second registry pass. Thrown, cancelled and
+      // still pending futures keep the general path below.
+      computed = future->computed();
+      if (computed) futures_.erase(it);
+    }
 
+    if (computed) {
+      KRef result = future->consumeComputedResult(OBJ_RESULT);
+      konanDestructInstance(future);
+      return result;
     }
 
     KRef result = future->consumeResultUnlocked(OBJ_RESULT);
@@ -421,6 +1051,38 @@ class State {
     return result;
   }
 
+  void getWorkerStatsUnlocked(KInt id, KLong* stats) {
+    Locker locker(&lock_);
+    auto it = workers_.find(id);
+    if (it == workers_.end()) {
+      ThrowWorkerInvalidState();
+    }
+    it->second->getStats(stats);
+  }
+
+  // Pins the thread of a started worker to the given CPU indices. Returns false
+  // where hard affinity is not supported or for workers without an own thread.
+  bool setWorkerCpuAffinityUnlocked(KInt id, const KStdVector<KInt>& cpus) {
+    Locker locker(&lock_);
+    auto it = workers_.find(id);
+    if (it == workers_.end()) {
+      ThrowWorkerInvalidState();
+    }
+#if WITH_CPU_AFFINITY
+    pthread_t thread = it->second->thread();
+    if (thread == 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (KInt cpu : cpus) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+      CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+  }
+
   OBJ_GETTER(getWorkerNameUnlocked, KInt id) {
     ObjHolder nameHolder;
     {
@@ -438,22 +1100,64 @@ class State {
     Locker locker(&lock_);
     if (version != currentVersion_) return false;
 
+    waitersCount_++;
+    SafePointEnterNative();
     if (millis < 0) {
       pthread_cond_wait(&cond_, &lock_);
+      SafePointLeaveNative();
+      waitersCount_--;
       return true;
     }
 
     uint64_t nsDelta = millis * 1000000LL;
     WaitOnCondVar(&cond_, &lock_, nsDelta);
+    SafePointLeaveNative();
+    waitersCount_--;
     return true;
   }
 
   void signalAnyFuture() {
+    bool hasWaiters;
+    int writeFd;
     {
       Locker locker(&lock_);
       currentVersion_++;
+      hasWaiters = waitersCount_ > 0;
+      writeFd = completionWriteFd_;
+    }
+    // Only poke the condition variable when somebody actually waits on it: consumers
+    // waiting on a concrete future or on the completion fd then cost no wakeups.
+    if (hasWaiters) pthread_cond_broadcast(&cond_);
+#if WITH_COMPLETION_FD
+    if (writeFd != -1) {
+      char dummy = 0;
+      // The pipe is non-blocking; a full pipe already guarantees readability,
+      // so EAGAIN can be safely ignored here.
+      while (write(writeFd, &dummy, 1) < 0 && errno == EINTR) {}
     }
-    pthread_cond_broadcast(&cond_);
+#endif  // WITH_COMPLETION_FD
+  }
+
+  // Returns a descriptor becoming readable whenever some future is ready, for
+  // integration with external event loops, or -1 if not supported. Created lazily,
+  // lives as long as the process.
+  KInt completionFd() {
+#if WITH_COMPLETION_FD
+    Locker locker(&lock_);
+    if (completionReadFd_ == -1) {
+      int fds[2];
+      if (pipe(fds) != 0) return -1;
+      // Signalling must never block the worker which completed a future, and
+      // readiness is level-triggered anyway, so both ends are non-blocking.
+      fcntl(fds[0], F_SETFL, O_NONBLOCK);
+      fcntl(fds[1], F_SETFL, O_NONBLOCK);
+      completionReadFd_ = fds[0];
+      completionWriteFd_ = fds[1];
+    }
+    return completionReadFd_;
+#else
+    return -1;
+#endif  // WITH_COMPLETION_FD
   }
 
   KInt versionToken() {
@@ -461,9 +1165,60 @@ class State {
     return currentVersion_;
   }
 
+  KInt createChannelUnlocked(KInt capacity) {
+    Locker locker(&lock_);
+    KInt id = nextChannelId();
+    channels_[id] = konanConstructInstance<ObjectChannel>(id, capacity > 0 ? capacity : 1);
+    return id;
+  }
+
+  // The lock only guards the registry lookup; ring operations themselves are
+  // lock-free, so concurrent producer and consumer never serialize on it.
+  ObjectChannel* channelByIdUnlocked(KInt id) {
+    Locker locker(&lock_);
+    auto it = channels_.find(id);
+    if (it == channels_.end()) ThrowWorkerInvalidState();
+    return it->second;
+  }
+
+  // Must not race with sends or receives on the same channel: callers stop
+  // both ends first, the same discipline the single-producer contract already
+  // imposes. Undelivered messages are disposed, dropping their subgraphs.
+  void closeChannelUnlocked(KInt id) {
+    ObjectChannel* channel = nullptr;
+    {
+      Locker locker(&lock_);
+      auto it = channels_.find(id);
+      if (it == channels_.end()) return;
+      channel = it->second;
+      channels_.erase(it);
+    }
+    KNativePtr stable;
+    while ((stable = channel->tryReceive()) != nullptr) {
+      DisposeStablePointer(stable);
+    }
+    konanDestructInstance(channel);
+  }
+
   // All those called with lock taken.
   KInt nextWorkerId() { return currentWorkerId_++; }
   KInt nextFutureId() { return currentFutureId_++; }
+  KInt nextPoolId() { return currentPoolId_++; }
+  KInt nextChannelId() { return currentChannelId_++; }
+
+  void removeFromPoolLocked(Worker* worker) {
+    if (worker->poolId() == 0) return;
+    auto it = pools_.find(worker->poolId());
+    if (it == pools_.end()) return;
+    auto& members = it->second;
+    for (auto member = members.begin(); member != members.end(); ++member) {
+      if (*member == worker) {
+        members.erase(member);
+        break;
+      }
+    }
+    if (members.size() == 0) pools_.erase(it);
+  }
 
   void destroyWorkerThreadDataUnlocked(KInt id) {
     Locker locker(&lock_);
@@ -524,10 +1279,19 @@ class State {
   pthread_cond_t cond_;
   KStdUnorderedMap<KInt, Future*> futures_;
   KStdUnorderedMap<KInt, Worker*> workers_;
+  KStdUnorderedMap<KInt, KStdVector<Worker*>> pools_;
+  KStdUnorderedMap<KInt, ObjectChannel*> channels_;
   KStdUnorderedMap<KInt, pthread_t> terminating_native_workers_;
   KInt currentWorkerId_;
   KInt currentFutureId_;
+  KInt currentPoolId_;
+  KInt currentChannelId_;
   KInt currentVersion_;
+  // Number of threads blocked in waitForAnyFuture().
+  KInt waitersCount_;
+  // Lazily created self-pipe signalled on any future completion, see completionFd().
+  int completionReadFd_;
+  int completionWriteFd_;
 };
 
 State* theState() {
@@ -548,26 +1312,30 @@ State* theState() {
   return state;
 }
 
+void postExpiredDelayedJob(Job job) {
+  if (!theState()->postDelayedJobToWorkerUnlocked(job.executeAfter.ownerId, job))
+    DisposeStablePointer(job.executeAfter.operation);
+}
+
 void Future::storeResultUnlocked(KNativePtr result, bool ok) {
   {
     Locker locker(&lock_);
-    state_ = ok ? COMPUTED : THROWN;
+    // The result must be visible before the state word flips: consumers only
+    // take the lock after observing a non-SCHEDULED state.
     result_ = result;
-    // Beware here: although manual clearly says that pthread_cond_broadcast() could be called outside
-    // of the taken lock, it's not on macOS (as of 10.13.1). If moved outside of the lock,
-    // some notifications are missing.
-    pthread_cond_broadcast(&cond_);
+    atomicSet(&state_, static_cast<KInt>(ok ? COMPUTED : THROWN));
   }
+  FutexWakeAll(&state_);
   theState()->signalAnyFuture();
 }
 
 void Future::cancelUnlocked() {
   {
     Locker locker(&lock_);
-    state_ = CANCELLED;
     result_ = nullptr;
-    pthread_cond_broadcast(&cond_);
+    atomicSet(&state_, static_cast<KInt>(CANCELLED));
   }
+  FutexWakeAll(&state_);
   theState()->signalAnyFuture();
 }
 
@@ -581,6 +1349,30 @@ KInt startWorker(KBoolean errorReporting, KRef customName) {
   return worker->id();
 }
 
+KInt startWorkerPool(KInt size, KBoolean errorReporting) {
+  KInt poolId = theState()->createPoolUnlocked(size, errorReporting != 0);
+  if (poolId < 0) ThrowWorkerInvalidState();
+  return poolId;
+}
+
+KInt workerPoolSchedule(KInt poolId) {
+  KInt id = theState()->poolScheduleUnlocked(poolId);
+  if (id < 0) ThrowWorkerInvalidState();
+  return id;
+}
+
+KInt workerPoolSize(KInt poolId) {
+  KInt size = theState()->poolSizeUnlocked(poolId);
+  if (size < 0) ThrowWorkerInvalidState();
+  return size;
+}
+
+KInt workerPoolMember(KInt poolId, KInt index) {
+  KInt id = theState()->poolMemberUnlocked(poolId, index);
+  if (id < 0) ThrowWorkerInvalidState();
+  return id;
+}
+
 KInt currentWorker() {
   if (g_worker == nullptr) ThrowWorkerInvalidState();
   return ::g_worker->id();
@@ -595,8 +1387,13 @@ KInt execute(KInt id, KInt transferMode, KRef producer, KNativePtr jobFunction)
   return future->id();
 }
 
-void executeAfter(KInt id, KRef job, KLong afterMicroseconds) {
-  if (!theState()->executeJobAfterInWorkerUnlocked(id, job, afterMicroseconds))
+void executeAfter(KInt id, KRef job, KLong afterMicroseconds, KInt priority, KLong deadlineMicroseconds) {
+  if (!theState()->executeJobAfterInWorkerUnlocked(id, job, afterMicroseconds, priority, deadlineMicroseconds))
+    ThrowWorkerInvalidState();
+}
+
+void executeBatch(KInt id, KRef operations) {
+  if (!theState()->executeJobsBatchInWorkerUnlocked(id, operations))
     ThrowWorkerInvalidState();
 }
 
@@ -604,10 +1401,18 @@ KBoolean processQueue(KInt id) {
    return theState()->processQueueUnlocked(id);
 }
 
+KBoolean workerYield(KInt id, KRef continuation) {
+   return theState()->yieldJobUnlocked(id, continuation);
+}
+
 KBoolean park(KInt id, KLong timeoutMicroseconds, KBoolean process) {
    return theState()->parkUnlocked(id, timeoutMicroseconds, process);
 }
 
+KInt workerNotificationFd(KInt id) {
+  return theState()->workerNotificationFdUnlocked(id);
+}
+
 KInt stateOfFuture(KInt id) {
   return theState()->stateOfFutureUnlocked(id);
 }
@@ -620,6 +1425,36 @@ OBJ_GETTER(getWorkerName, KInt id) {
   RETURN_RESULT_OF(theState()->getWorkerNameUnlocked, id);
 }
 
+OBJ_GETTER(getWorkerStats, KInt id) {
+  KLong stats[Worker::kStatsSize];
+  theState()->getWorkerStatsUnlocked(id, stats);
+  ObjHolder resultHolder;
+  ObjHeader* result = AllocArrayInstance(theLongArrayTypeInfo, Worker::kStatsSize, resultHolder.slot());
+  for (int i = 0; i < Worker::kStatsSize; i++) {
+    *PrimitiveArrayAddressOfElementAt<KLong>(result->array(), i) = stats[i];
+  }
+  RETURN_OBJ(result);
+}
+
+void setDelayedJobsCoalescing(KLong windowMicroseconds) {
+  theDelayedJobTimer()->setCoalescingWindow(windowMicroseconds);
+}
+
+void setWorkerStackSize(KInt bytes) {
+  if (bytes < 0) ThrowIllegalArgumentException();
+  atomicSet(&pendingWorkerStackSize, bytes);
+}
+
+KBoolean setWorkerCpuAffinity(KInt id, KConstRef cpuArray) {
+  const ArrayHeader* array = cpuArray->array();
+  KStdVector<KInt> cpus;
+  cpus.reserve(array->count_);
+  for (uint32_t index = 0; index < array->count_; index++) {
+    cpus.push_back(*PrimitiveArrayAddressOfElementAt<KInt>(array, index));
+  }
+  return theState()->setWorkerCpuAffinityUnlocked(id, cpus);
+}
+
 KInt requestTermination(KInt id, KBoolean processScheduledJobs) {
   Future* future = theState()->addJobToWorkerUnlocked(
       id, nullptr, nullptr, /* toFront = */ !processScheduledJobs, UNCHECKED);
@@ -635,6 +1470,10 @@ KInt versionToken() {
   return theState()->versionToken();
 }
 
+KInt completionFd() {
+  return theState()->completionFd();
+}
+
 OBJ_GETTER(attachObjectGraphInternal, KNativePtr stable) {
   RETURN_RESULT_OF(AdoptStablePointer, stable);
 }
@@ -649,12 +1488,58 @@ KNativePtr detachObjectGraphInternal(KInt transferMode, KRef producer) {
    }
 }
 
+KNativePtr compactObjectGraphInternal(KNativePtr stable) {
+  return CompactSubgraph(stable);
+}
+
+KInt channelCreate(KInt capacity) {
+  return theState()->createChannelUnlocked(capacity);
+}
+
+KBoolean channelSend(KInt id, KInt transferMode, KRef producer) {
+  ObjectChannel* channel = theState()->channelByIdUnlocked(id);
+  // The fullness check happens before the message is detached: a full ring then
+  // leaves the produced object attached, and the holder releases it normally.
+  if (channel->full()) return false;
+  ObjHolder result;
+  WorkerLaunchpad(producer, result.slot());
+  if (result.obj() == nullptr) ThrowWorkerInvalidState();
+  channel->send(transfer(&result, transferMode));
+  return true;
+}
+
+OBJ_GETTER(channelReceive, KInt id) {
+  KNativePtr stable = theState()->channelByIdUnlocked(id)->tryReceive();
+  if (stable == nullptr) RETURN_OBJ(nullptr);
+  RETURN_RESULT_OF(AdoptStablePointer, stable);
+}
+
+void channelClose(KInt id) {
+  theState()->closeChannelUnlocked(id);
+}
+
 #else
 
 KInt startWorker(KBoolean errorReporting, KRef customName) {
   ThrowWorkerUnsupported();
 }
 
+KInt startWorkerPool(KInt size, KBoolean errorReporting) {
+  ThrowWorkerUnsupported();
+}
+
+KInt workerPoolSchedule(KInt poolId) {
+  ThrowWorkerUnsupported();
+}
+
+KInt workerPoolSize(KInt poolId) {
+  ThrowWorkerUnsupported();
+}
+
+KInt workerPoolMember(KInt poolId, KInt index) {
+  ThrowWorkerUnsupported();
+}
+
 KInt stateOfFuture(KInt id) {
   ThrowWorkerUnsupported();
 }
@@ -663,7 +1548,11 @@ KInt execute(KInt id, KInt transferMode, KRef producer, KNativePtr jobFunction)
   ThrowWorkerUnsupported();
 }
 
-void executeAfter(KInt id, KRef job, KLong afterMicroseconds) {
+void executeAfter(KInt id, KRef job, KLong afterMicroseconds, KInt priority, KLong deadlineMicroseconds) {
+  ThrowWorkerUnsupported();
+}
+
+void executeBatch(KInt id, KRef operations) {
   ThrowWorkerUnsupported();
 }
 
@@ -671,10 +1560,18 @@ KBoolean processQueue(KInt id) {
   ThrowWorkerUnsupported();
 }
 
+KBoolean workerYield(KInt id, KRef continuation) {
+  ThrowWorkerUnsupported();
+}
+
 KBoolean park(KInt id, KLong timeoutMicroseconds, KBoolean process) {
    ThrowWorkerUnsupported();
 }
 
+KInt workerNotificationFd(KInt id) {
+  ThrowWorkerUnsupported();
+}
+
 KInt currentWorker() {
   ThrowWorkerUnsupported();
 }
@@ -687,6 +1584,22 @@ OBJ_GETTER(getWorkerName, KInt id) {
   ThrowWorkerUnsupported();
 }
 
+OBJ_GETTER(getWorkerStats, KInt id) {
+  ThrowWorkerUnsupported();
+}
+
+void setDelayedJobsCoalescing(KLong windowMicroseconds) {
+  ThrowWorkerUnsupported();
+}
+
+void setWorkerStackSize(KInt bytes) {
+  ThrowWorkerUnsupported();
+}
+
+KBoolean setWorkerCpuAffinity(KInt id, KConstRef cpuArray) {
+  ThrowWorkerUnsupported();
+}
+
 KInt requestTermination(KInt id, KBoolean processScheduledJobs) {
   ThrowWorkerUnsupported();
 }
@@ -699,6 +1612,10 @@ KInt versionToken() {
   ThrowWorkerUnsupported();
 }
 
+KInt completionFd() {
+  return -1;
+}
+
 OBJ_GETTER(attachObjectGraphInternal, KNativePtr stable) {
   ThrowWorkerUnsupported();
 }
@@ -707,6 +1624,26 @@ KNativePtr detachObjectGraphInternal(KInt transferMode, KRef producer) {
    ThrowWorkerUnsupported();
 }
 
+KNativePtr compactObjectGraphInternal(KNativePtr stable) {
+  ThrowWorkerUnsupported();
+}
+
+KInt channelCreate(KInt capacity) {
+  ThrowWorkerUnsupported();
+}
+
+KBoolean channelSend(KInt id, KInt transferMode, KRef producer) {
+  ThrowWorkerUnsupported();
+}
+
+OBJ_GETTER(channelReceive, KInt id) {
+  ThrowWorkerUnsupported();
+}
+
+void channelClose(KInt id) {
+  ThrowWorkerUnsupported();
+}
+
 #endif  // WITH_WORKERS
 
 }  // namespace
@@ -722,6 +1659,9 @@ KInt GetWorkerId(Worker* worker) {
 Worker* WorkerInit(KBoolean errorReporting) {
 #if WITH_WORKERS
   if (::g_worker != nullptr) return ::g_worker;
+  // Give the thread its own allocator heap, so its memory can be attributed to
+  // this worker and returned as a unit on deinit.
+  konan::threadHeapInit();
   Worker* worker = theState()->addWorkerUnlocked(errorReporting != 0, nullptr, WorkerKind::kOther);
   ::g_worker = worker;
   return worker;
@@ -734,6 +1674,24 @@ void WorkerDeinit(Worker* worker) {
 #if WITH_WORKERS
   ::g_worker = nullptr;
   theState()->destroyWorkerUnlocked(worker);
+  konan::threadHeapDeinit();
+#endif  // WITH_WORKERS
+}
+
+Worker* WorkerSuspend() {
+#if WITH_WORKERS
+  Worker* result = ::g_worker;
+  ::g_worker = nullptr;
+  return result;
+#else
+  return nullptr;
+#endif  // WITH_WORKERS
+}
+
+void WorkerResume(Worker* worker) {
+#if WITH_WORKERS
+  RuntimeAssert(::g_worker == nullptr, "Another worker is bound to this thread");
+  ::g_worker = worker;
 #endif  // WITH_WORKERS
 }
 
@@ -766,8 +1724,19 @@ bool WorkerSchedule(KInt id, KNativePtr jobStablePtr) {
 #if WITH_WORKERS
 
 Worker::~Worker() {
+  {
+    // Collect whatever was published but not yet drained. No concurrent submitters
+    // can exist at this point, the lock is taken to please drainInboxLocked() only.
+    Locker locker(&lock_);
+    drainInboxLocked();
+  }
+  // Jobs claimed but not processed are cleaned up together with the queued ones.
+  for (int lane = 0; lane < kPriorityLanes; lane++) {
+    prefetched_.insert(prefetched_.end(), lanes_[lane].begin(), lanes_[lane].end());
+    lanes_[lane].clear();
+  }
   // Cleanup jobs in the queue.
-  for (auto job : queue_) {
+  for (auto job : prefetched_) {
     switch (job.kind) {
       case JOB_REGULAR:
         DisposeStablePointer(job.regularJob.argument);
@@ -790,15 +1759,16 @@ Worker::~Worker() {
     }
   }
 
-  for (auto job : delayed_) {
-    RuntimeAssert(job.kind == JOB_EXECUTE_AFTER, "Must be delayed");
-    DisposeStablePointer(job.executeAfter.operation);
-  }
-
   if (name_ != nullptr) DisposeStablePointer(name_);
 
+#if WITH_COMPLETION_FD
+  if (notifyReadFd_ != -1) {
+    close(notifyReadFd_);
+    close(notifyWriteFd_);
+  }
+#endif  // WITH_COMPLETION_FD
+
   pthread_mutex_destroy(&lock_);
-  pthread_cond_destroy(&cond_);
 }
 
 namespace {
@@ -821,68 +1791,338 @@ void* workerRoutine(void* argument) {
 }  // namespace
 
 void Worker::startEventLoop() {
+  KInt stackSize = atomicGet(&pendingWorkerStackSize);
+  if (stackSize > 0) {
+    size_t size = static_cast<size_t>(stackSize);
+#ifdef PTHREAD_STACK_MIN
+    if (size < static_cast<size_t>(PTHREAD_STACK_MIN)) size = PTHREAD_STACK_MIN;
+#endif
+    // Some platforms (e.g. Darwin) require a page-aligned stack size.
+    size = (size + 4095) & ~static_cast<size_t>(4095);
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, size);
+    pthread_create(&thread_, &attr, workerRoutine, this);
+    pthread_attr_destroy(&attr);
+    return;
+  }
   pthread_create(&thread_, nullptr, workerRoutine, this);
 }
 
 void Worker::putJob(Job job, bool toFront) {
-  Locker locker(&lock_);
-  if (toFront)
-    queue_.push_front(job);
-  else
-    queue_.push_back(job);
-  pthread_cond_signal(&cond_);
+  CounterIncrement(RTC_WORKER_JOBS_ENQUEUED);
+  atomicAdd(&enqueuedJobsCount_, static_cast<KLong>(1));
+  job.submitTimeMicros = konan::getTimeMicros();
+  if (!toFront) {
+    // Lock-free fast path: publish the job with a single CAS, the worker drains
+    // the inbox under its lock whenever it looks at the queue.
+    InboxNode* node = konanConstructInstance<InboxNode>();
+    node->job = job;
+    InboxNode* head;
+    do {
+      head = atomicGet(&inbox_);
+      node->next = head;
+    } while (!compareAndSet(&inbox_, head, node));
+    // Only wake the worker up when it announced it is going to sleep. The worker
+    // re-checks the inbox after setting the word, so the wakeup cannot be lost.
+    if (atomicGet(&sleeping_) != 0) {
+      atomicSet(&sleeping_, 0);
+      FutexWakeOne(&sleeping_);
+    }
+    signalNotificationFd();
+    return;
+  }
+  {
+    Locker locker(&lock_);
+    pushJobLocked(job, true);
+  }
+  if (atomicGet(&sleeping_) != 0) {
+    atomicSet(&sleeping_, 0);
+    FutexWakeOne(&sleeping_);
+  }
+  signalNotificationFd();
+}
+
+void Worker::putJobBatch(const KStdVector<Job>& jobs) {
+  if (jobs.size() == 0) return;
+  CounterAdd(RTC_WORKER_JOBS_ENQUEUED, jobs.size());
+  atomicAdd(&enqueuedJobsCount_, static_cast<KLong>(jobs.size()));
+  uint64_t now = konan::getTimeMicros();
+  // Link the segment up locally, first job of the batch deepest, so that the usual
+  // inbox reversal in drainInboxLocked() restores the batch order.
+  InboxNode* segmentHead = nullptr;
+  InboxNode* segmentTail = nullptr;
+  for (auto& job: jobs) {
+    InboxNode* node = konanConstructInstance<InboxNode>();
+    node->job = job;
+    node->job.submitTimeMicros = now;
+    node->next = segmentHead;
+    segmentHead = node;
+    if (segmentTail == nullptr) segmentTail = node;
+  }
+  InboxNode* head;
+  do {
+    head = atomicGet(&inbox_);
+    segmentTail->next = head;
+  } while (!compareAndSet(&inbox_, head, segmentHead));
+  if (atomicGet(&sleeping_) != 0) {
+    atomicSet(&sleeping_, 0);
+    FutexWakeOne(&sleeping_);
+  }
+  signalNotificationFd();
 }
 
-void Worker::putDelayedJob(Job job) {
+KInt Worker::notificationFd() {
+#if WITH_COMPLETION_FD
   Locker locker(&lock_);
-  delayed_.insert(job);
-  pthread_cond_signal(&cond_);
+  if (notifyReadFd_ == -1) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    // Signalling must never block a producer, and readiness is level-triggered
+    // anyway, so both ends are non-blocking.
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    notifyReadFd_ = fds[0];
+    // Published last, with an atomic store: producers signalling from the
+    // lock-free submission path read it without taking the lock.
+    atomicSet(&notifyWriteFd_, fds[1]);
+  }
+  return notifyReadFd_;
+#else
+  return -1;
+#endif  // WITH_COMPLETION_FD
+}
+
+void Worker::signalNotificationFd() {
+#if WITH_COMPLETION_FD
+  int fd = atomicGet(&notifyWriteFd_);
+  if (fd != -1) {
+    char dummy = 0;
+    // The pipe is non-blocking; a full pipe already guarantees readability,
+    // so EAGAIN can be safely ignored here.
+    while (write(fd, &dummy, 1) < 0 && errno == EINTR) {}
+  }
+#endif  // WITH_COMPLETION_FD
 }
 
 bool Worker::waitDelayed(bool blocking) {
+  // Delayed jobs wait in the shared timer service and come back through the
+  // regular queue once due, so any still outstanding keep the event loop alive.
+  if (!theDelayedJobTimer()->hasDelayedFor(id_)) return false;
   Locker locker(&lock_);
-  if (delayed_.size() == 0) return false;
   if (blocking) waitForQueueLocked(-1, nullptr);
   return true;
 }
 
 Job Worker::getJob(bool blocking) {
+  // Jobs claimed by an earlier lock acquisition are served without touching the lock:
+  // only the worker thread itself reads [prefetched_].
+  if (prefetched_.size() > 0) {
+    auto result = prefetched_.front();
+    prefetched_.pop_front();
+    return result;
+  }
+  {
+    Locker locker(&lock_);
+    RuntimeAssert(!terminated_, "Must not be terminated");
+    drainInboxLocked();
+    if (queuedCountLocked() == 0 && !blocking) return Job { .kind = JOB_NONE };
+    if (poolId_ == 0) {
+      waitForQueueLocked(-1, nullptr);
+      auto result = popJobLocked();
+      prefetchLocked();
+      return result;
+    }
+  }
+  // Pool members alternate between waiting on the own queue and stealing from siblings,
+  // so that an idle member picks up the load of a backed up one.
+  while (true) {
+    {
+      Locker locker(&lock_);
+      if (waitForQueueLocked(kJobStealPollMicroseconds, nullptr)) {
+        auto result = popJobLocked();
+        prefetchLocked();
+        return result;
+      }
+    }
+    Job stolen = theState()->stealJobForWorkerUnlocked(this);
+    if (stolen.kind != JOB_NONE) return stolen;
+  }
+}
+
+Job Worker::trySteal() {
   Locker locker(&lock_);
-  RuntimeAssert(!terminated_, "Must not be terminated");
-  if (queue_.size() == 0 && !blocking) return Job { .kind = JOB_NONE };
-  waitForQueueLocked(-1, nullptr);
-  auto result = queue_.front();
-  queue_.pop_front();
+  if (terminated_) return Job { .kind = JOB_NONE };
+  drainInboxLocked();
+  // Steal from the back of the lowest-priority non-empty lane, leaving the owner's
+  // hot jobs in place. Only future-based jobs can migrate: termination requests and
+  // [executeAfter] jobs are bound to their worker.
+  for (int lane = kPriorityLanes - 1; lane >= 0; lane--) {
+    if (lanes_[lane].size() == 0) continue;
+    Job job = lanes_[lane].back();
+    if (job.kind != JOB_REGULAR) return Job { .kind = JOB_NONE };
+    lanes_[lane].pop_back();
+    return job;
+  }
+  return Job { .kind = JOB_NONE };
+}
+
+size_t Worker::queueSize() {
+  Locker locker(&lock_);
+  drainInboxLocked();
+  return queuedCountLocked();
+}
+
+void Worker::getStats(KLong* stats) {
+  stats[0] = atomicGet(&enqueuedJobsCount_);
+  stats[1] = atomicGet(&processedJobsCount_);
+  for (int i = 0; i < kTimeInQueueBuckets; i++) {
+    stats[2 + i] = atomicGet(&timeInQueue_[i]);
+  }
+}
+
+void Worker::drainInboxLocked() {
+  InboxNode* head;
+  do {
+    head = atomicGet(&inbox_);
+    if (head == nullptr) return;
+  } while (!compareAndSet(&inbox_, head, static_cast<InboxNode*>(nullptr)));
+  // The stack is most recent first - reverse it to keep FIFO submission order.
+  InboxNode* reversed = nullptr;
+  while (head != nullptr) {
+    InboxNode* next = head->next;
+    head->next = reversed;
+    reversed = head;
+    head = next;
+  }
+  while (reversed != nullptr) {
+    InboxNode* next = reversed->next;
+    pushJobLocked(reversed->job, false);
+    konanDestructInstance(reversed);
+    reversed = next;
+  }
+}
+
+size_t Worker::queuedCountLocked() const {
+  size_t result = 0;
+  for (int lane = 0; lane < kPriorityLanes; lane++) result += lanes_[lane].size();
   return result;
 }
 
-KLong Worker::checkDelayedLocked() {
-  if (delayed_.size() == 0) {
-    return -1;
+void Worker::pushJobLocked(Job job, bool toFront) {
+  RuntimeAssert(job.priority >= 0 && job.priority < kPriorityLanes, "Invalid job priority");
+  auto& lane = lanes_[job.priority];
+  if (toFront)
+    lane.push_front(job);
+  else
+    lane.push_back(job);
+}
+
+Job Worker::popJobLocked() {
+  // A job queued past its deadline runs first, whatever its lane; lanes are FIFO,
+  // so checking the fronts catches the oldest candidate of every lane.
+  uint64_t now = konan::getTimeMicros();
+  int picked = -1;
+  uint64_t earliestExpired = 0;
+  for (int lane = 0; lane < kPriorityLanes; lane++) {
+    if (lanes_[lane].size() == 0) continue;
+    uint64_t deadline = lanes_[lane].front().deadlineMicros;
+    if (deadline != 0 && deadline <= now && (picked == -1 || deadline < earliestExpired)) {
+      picked = lane;
+      earliestExpired = deadline;
+    }
   }
-  auto it = delayed_.begin();
-  auto job = *it;
-  RuntimeAssert(job.kind == JOB_EXECUTE_AFTER, "Must be delayed job");
-  auto now = konan::getTimeMicros();
-  if (job.executeAfter.whenExecute <= now) {
-    delayed_.erase(it);
-    queue_.push_back(job);
-    return 0;
-  } else {
-    return job.executeAfter.whenExecute - now;
+  if (picked == -1) {
+    // Serve the highest non-empty lane, unless a lower one has already been passed
+    // over kLaneStarvationBound times: then it gets one job through.
+    for (int lane = 0; lane < kPriorityLanes; lane++) {
+      if (lanes_[lane].size() == 0) continue;
+      if (picked == -1) {
+        picked = lane;
+      } else if (lanePassedOver_[lane] >= kLaneStarvationBound) {
+        picked = lane;
+        break;
+      }
+    }
+  }
+  RuntimeAssert(picked != -1, "Queue must be non-empty");
+  for (int lane = 0; lane < kPriorityLanes; lane++) {
+    if (lane == picked)
+      lanePassedOver_[lane] = 0;
+    else if (lanes_[lane].size() != 0)
+      lanePassedOver_[lane]++;
   }
+  Job result = lanes_[picked].front();
+  lanes_[picked].pop_front();
+  return result;
+}
+
+void Worker::prefetchLocked() {
+  while (queuedCountLocked() > 0 && prefetched_.size() < kMaxJobPrefetch) {
+    prefetched_.push_back(popJobLocked());
+  }
+}
+
+void Worker::noteQueueEmptyGap(uint64_t emptySinceMicros) {
+  uint64_t gap = konan::getTimeMicros() - emptySinceMicros;
+  emptyQueueGapEwmaMicros_ = (3 * emptyQueueGapEwmaMicros_ + gap) / 4;
 }
 
 bool Worker::waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining) {
-  while (queue_.size() == 0) {
-    KLong closestToRunMicroseconds = checkDelayedLocked();
-    if (closestToRunMicroseconds == 0) {
-        continue;
+  drainInboxLocked();
+  if (queuedCountLocked() != 0) return true;
+  uint64_t emptySinceMicros = konan::getTimeMicros();
+  // Under a steady stream of small jobs a condition wait costs a futex round
+  // trip per job. When the queue has been refilling quickly, poll the lock-free
+  // inbox with pause hints for a bounded while before parking. The lock stays
+  // held, which only delays front-insertions and steal attempts - both pointless
+  // against an empty queue.
+  const KonanRuntimeConfig& config = konanRuntimeConfig();
+  if (config.workerSpinIterations > 0
+      && emptyQueueGapEwmaMicros_ <= static_cast<uint64_t>(config.workerSpinGapMicroseconds)) {
+    for (int32_t i = 0; i < config.workerSpinIterations; i++) {
+      if (atomicGet(&inbox_) != nullptr) break;
+      cpuRelax();
     }
-    if (timeoutMicroseconds >= 0) {
-        closestToRunMicroseconds = (timeoutMicroseconds < closestToRunMicroseconds || closestToRunMicroseconds < 0)
-          ? timeoutMicroseconds
-          : closestToRunMicroseconds;
+    drainInboxLocked();
+    if (queuedCountLocked() != 0) {
+      noteQueueEmptyGap(emptySinceMicros);
+      return true;
+    }
+  }
+  // About to sleep with no deadline to honour: donate the thread to its own
+  // deferred memory work (see GC_PerformIdleSlice), re-checking the inbox
+  // between bounded slices. The lock is released while a slice runs, as GC
+  // work must not hold up front-insertions or steal attempts. This moves
+  // release and finalization work into idle gaps, away from the allocation
+  // slow paths of the jobs themselves.
+  if (timeoutMicroseconds < 0) {
+    while (queuedCountLocked() == 0) {
+      pthread_mutex_unlock(&lock_);
+      bool moreGcWork = GC_PerformIdleSlice();
+      pthread_mutex_lock(&lock_);
+      drainInboxLocked();
+      if (!moreGcWork) break;
+    }
+    if (queuedCountLocked() != 0) {
+      noteQueueEmptyGap(emptySinceMicros);
+      return true;
+    }
+  }
+  while (queuedCountLocked() == 0) {
+    // Delayed jobs tick in the shared timer service (see DelayedJobTimer), so
+    // the only deadline to honour here is the caller's timeout.
+    KLong closestToRunMicroseconds = timeoutMicroseconds;
+    // Announce the intent to sleep and re-check the inbox: a fast path producer either
+    // published its job before the word was set (and we pick it up here), or sees the
+    // word and wakes it - the lock is held from the re-check until the park below, so
+    // a front-inserting producer cannot slip a job in between either.
+    atomicSet(&sleeping_, 1);
+    drainInboxLocked();
+    if (queuedCountLocked() != 0) {
+      atomicSet(&sleeping_, 0);
+      noteQueueEmptyGap(emptySinceMicros);
+      return true;
     }
     if (closestToRunMicroseconds == 0) {
       // Just no wait at all here.
@@ -891,17 +2131,34 @@ bool Worker::waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining) {
       if (closestToRunMicroseconds > 10LL * 1000 * 1000 * 1000 * 1000)
         closestToRunMicroseconds = 10LL * 1000 * 1000 * 1000 * 1000;
       uint64_t nsDelta = closestToRunMicroseconds * 1000LL;
-      uint64_t microsecondsPassed = 0;
-      WaitOnCondVar(&cond_, &lock_, nsDelta, remaining ? &microsecondsPassed : nullptr);
+      uint64_t beforeMicros = konan::getTimeMicros();
+      // Park on the sleeping_ word itself; the lock is released first, so an idle
+      // worker blocks neither front-insertions nor steal attempts. An idle worker
+      // does not delay safepoint handshakes either.
+      pthread_mutex_unlock(&lock_);
+      SafePointEnterNative();
+      FutexWait(&sleeping_, 1, static_cast<int64_t>(nsDelta));
+      SafePointLeaveNative();
+      pthread_mutex_lock(&lock_);
       if (remaining) {
-        *remaining = timeoutMicroseconds - microsecondsPassed;
+        *remaining = timeoutMicroseconds - static_cast<KLong>(konan::getTimeMicros() - beforeMicros);
       }
     } else {
-      pthread_cond_wait(&cond_, &lock_);
+      pthread_mutex_unlock(&lock_);
+      SafePointEnterNative();
+      FutexWait(&sleeping_, 1, -1);
+      SafePointLeaveNative();
+      pthread_mutex_lock(&lock_);
       if (remaining) *remaining = 0;
     }
-    if (timeoutMicroseconds >= 0) return queue_.size() != 0;
+    atomicSet(&sleeping_, 0);
+    drainInboxLocked();
+    if (timeoutMicroseconds >= 0) {
+      noteQueueEmptyGap(emptySinceMicros);
+      return queuedCountLocked() != 0;
+    }
   }
+  noteQueueEmptyGap(emptySinceMicros);
   return true;
 }
 
@@ -911,11 +2168,13 @@ bool Worker::park(KLong timeoutMicroseconds, bool process) {
     if (terminated_) {
       return false;
     }
-    auto arrived = false;
+    // Jobs already claimed into the prefetch buffer count as arrived work.
+    auto arrived = prefetched_.size() > 0;
     KLong remaining = timeoutMicroseconds;
-    do {
+    while (!arrived) {
       arrived = waitForQueueLocked(remaining, &remaining);
-    } while (remaining > 0 && !arrived);
+      if (remaining <= 0) break;
+    }
     if (!process) {
       return arrived;
     }
@@ -932,6 +2191,17 @@ JobKind Worker::processQueueElement(bool blocking) {
   ObjHolder resultHolder;
   if (terminated_) return JOB_TERMINATE;
   Job job = getJob(blocking);
+  // Queue depth readable via counters is jobs enqueued minus jobs executed.
+  if (job.kind != JOB_NONE) {
+    CounterIncrement(RTC_WORKER_JOBS_EXECUTED);
+    atomicAdd(&processedJobsCount_, static_cast<KLong>(1));
+    uint64_t waited = konan::getTimeMicros() - job.submitTimeMicros;
+    int bucket = 0;
+    while (bucket < kTimeInQueueBuckets - 1 && waited >= (1ull << bucket)) bucket++;
+    atomicAdd(&timeInQueue_[bucket], static_cast<KLong>(1));
+    runningJobPriority_ = job.priority;
+    runningJobDeadline_ = job.deadlineMicros;
+  }
   switch (job.kind) {
     case JOB_NONE: {
       break;
@@ -992,6 +2262,24 @@ JobKind Worker::processQueueElement(bool blocking) {
   return job.kind;
 }
 
+bool Worker::yieldJob(KRef continuation) {
+  // Claimed but unprocessed jobs count as pending work, too.
+  if (prefetched_.size() == 0) {
+    Locker locker(&lock_);
+    drainInboxLocked();
+    if (queuedCountLocked() == 0) return false;
+  }
+  Job job;
+  job.kind = JOB_EXECUTE_AFTER;
+  // Resume in the lane and with the deadline of the job being executed, so
+  // yielding neither demotes nor promotes the computation.
+  job.priority = runningJobPriority_;
+  job.deadlineMicros = runningJobDeadline_;
+  job.executeAfter.operation = CreateStablePointer(continuation);
+  putJob(job, false);
+  return true;
+}
+
 #endif  // WITH_WORKERS
 
 extern "C" {
@@ -1004,6 +2292,22 @@ KInt Kotlin_Worker_currentInternal() {
   return currentWorker();
 }
 
+KInt Kotlin_WorkerPool_startInternal(KInt size, KBoolean errorReporting) {
+  return startWorkerPool(size, errorReporting);
+}
+
+KInt Kotlin_WorkerPool_scheduleInternal(KInt poolId) {
+  return workerPoolSchedule(poolId);
+}
+
+KInt Kotlin_WorkerPool_sizeInternal(KInt poolId) {
+  return workerPoolSize(poolId);
+}
+
+KInt Kotlin_WorkerPool_memberInternal(KInt poolId, KInt index) {
+  return workerPoolMember(poolId, index);
+}
+
 KInt Kotlin_Worker_requestTerminationWorkerInternal(KInt id, KBoolean processScheduledJobs) {
   return requestTermination(id, processScheduledJobs);
 }
@@ -1013,21 +2317,67 @@ KInt Kotlin_Worker_executeInternal(KInt id, KInt transferMode, KRef producer, KN
 }
 
 void Kotlin_Worker_executeAfterInternal(KInt id, KRef job, KLong afterMicroseconds) {
-  executeAfter(id, job, afterMicroseconds);
+  executeAfter(id, job, afterMicroseconds, JOB_PRIORITY_NORMAL, 0);
+}
+
+void Kotlin_Worker_executeAfterWithPriorityInternal(
+    KInt id, KRef job, KLong afterMicroseconds, KInt priority, KLong deadlineMicroseconds) {
+  executeAfter(id, job, afterMicroseconds, priority, deadlineMicroseconds);
+}
+
+void Kotlin_Worker_executeBatchInternal(KInt id, KRef operations) {
+  executeBatch(id, operations);
 }
 
 KBoolean Kotlin_Worker_processQueueInternal(KInt id) {
   return processQueue(id);
 }
 
+KBoolean Kotlin_Worker_yieldInternal(KInt id, KRef continuation) {
+  return workerYield(id, continuation);
+}
+
 KBoolean Kotlin_Worker_parkInternal(KInt id, KLong timeoutMicroseconds, KBoolean process) {
   return park(id, timeoutMicroseconds, process);
 }
 
+KInt Kotlin_Worker_notificationFdInternal(KInt id) {
+  return workerNotificationFd(id);
+}
+
 OBJ_GETTER(Kotlin_Worker_getNameInternal, KInt id) {
   RETURN_RESULT_OF(getWorkerName, id);
 }
 
+OBJ_GETTER(Kotlin_Worker_getStatsInternal, KInt id) {
+  RETURN_RESULT_OF(getWorkerStats, id);
+}
+
+KLong Kotlin_Worker_localHeapBytesInternal() {
+  return konan::threadHeapUsed();
+}
+
+void Kotlin_Worker_setDelayedCoalescingInternal(KLong windowMicroseconds) {
+  setDelayedJobsCoalescing(windowMicroseconds);
+}
+
+void Kotlin_Worker_setStackSizeInternal(KInt bytes) {
+  setWorkerStackSize(bytes);
+}
+
+KBoolean Kotlin_Worker_setCpuAffinityInternal(KInt id, KRef cpus) {
+  return setWorkerCpuAffinity(id, cpus);
+}
+
+KInt Kotlin_Worker_availableProcessorsInternal() {
+#if defined(_SC_NPROCESSORS_ONLN)
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? static_cast<KInt>(count) : 1;
+#else
+  return 1;
+#endif
+}
+
 KInt Kotlin_Worker_stateOfFuture(KInt id) {
   return stateOfFuture(id);
 }
@@ -1044,6 +2394,10 @@ KInt Kotlin_Worker_versionToken() {
   return versionToken();
 }
 
+KInt Kotlin_Worker_completionFd() {
+  return completionFd();
+}
+
 OBJ_GETTER(Kotlin_Worker_attachObjectGraphInternal, KNativePtr stable) {
   RETURN_RESULT_OF(attachObjectGraphInternal, stable);
 }
@@ -1052,6 +2406,26 @@ KNativePtr Kotlin_Worker_detachObjectGraphInternal(KInt transferMode, KRef produ
   return detachObjectGraphInternal(transferMode, producer);
 }
 
+KNativePtr Kotlin_Worker_compactObjectGraphInternal(KNativePtr stable) {
+  return compactObjectGraphInternal(stable);
+}
+
+KInt Kotlin_Worker_channelCreateInternal(KInt capacity) {
+  return channelCreate(capacity);
+}
+
+KBoolean Kotlin_Worker_channelSendInternal(KInt id, KInt transferMode, KRef producer) {
+  return channelSend(id, transferMode, producer);
+}
+
+OBJ_GETTER(Kotlin_Worker_channelReceiveInternal, KInt id) {
+  RETURN_RESULT_OF(channelReceive, id);
+}
+
+void Kotlin_Worker_channelCloseInternal(KInt id) {
+  channelClose(id);
+}
+
 void Kotlin_Worker_freezeInternal(KRef object) {
   if (object != nullptr)
     FreezeSubgraph(object);
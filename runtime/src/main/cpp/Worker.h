@@ -10,6 +10,10 @@ KInt GetWorkerId(Worker* worker);
 
 Worker* WorkerInit(KBoolean errorReporting);
 void WorkerDeinit(Worker* worker);
+// Detach/attach the worker bound to the current thread, so isolated runtimes can
+// be interleaved on one host thread. See Kotlin_suspendCurrentRuntime in Runtime.h.
+Worker* WorkerSuspend();
+void WorkerResume(Worker* worker);
 // Clean up all associated thread state, if this was a native worker.
 void WorkerDestroyThreadDataIfNeeded(KInt id);
 // Wait until all terminating native workers finish termination. Expected to be called at most once.
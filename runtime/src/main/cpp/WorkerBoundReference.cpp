@@ -6,6 +6,7 @@
 #include "WorkerBoundReference.h"
 
 #include "Alloc.h"
+#include "Atomic.h"
 #include "Memory.h"
 #include "MemorySharedRefs.hpp"
 
@@ -20,14 +21,42 @@ WorkerBoundReference* asWorkerBoundReference(KRef thiz) {
   return reinterpret_cast<WorkerBoundReference*>(thiz);
 }
 
+// The reference is bound to one worker for its whole lifetime and nearly all
+// dereferences come from that worker, so accesses are biased towards it: the
+// owning thread's token is remembered at creation, and a deref matching it
+// returns the cached object after one thread-local compare, skipping the
+// accessibility machinery of KRefSharedHolder::ref(). Tokens are drawn from a
+// monotonic counter rather than thread identifiers, so a thread created after
+// the owner exits can never alias the owner and sneak past the check. There is
+// nothing to revoke: the binding never moves, and every other thread simply
+// takes the shared path.
+struct BoundReferenceState {
+  KRefSharedHolder holder;
+  intptr_t ownerToken;
+  KRef obj;
+};
+
+intptr_t nextBoundThreadToken = 1;
+THREAD_LOCAL_VARIABLE intptr_t boundThreadToken = 0;
+
+inline intptr_t currentBoundThreadToken() {
+  intptr_t token = boundThreadToken;
+  if (token == 0) {
+    token = atomicAdd(&nextBoundThreadToken, static_cast<intptr_t>(1));
+    boundThreadToken = token;
+  }
+  return token;
+}
+
 }  // namespace
 
 RUNTIME_NOTHROW void DisposeWorkerBoundReference(KRef thiz) {
   // DisposeSharedRef is only called when all references to thiz are gone.
   // Can be null if WorkerBoundReference wasn't frozen.
   if (auto* holder = asWorkerBoundReference(thiz)->holder) {
-    holder->dispose();
-    konanDestructInstance(holder);
+    auto* state = reinterpret_cast<BoundReferenceState*>(holder);
+    state->holder.dispose();
+    konanDestructInstance(state);
   }
 }
 
@@ -41,13 +70,25 @@ RUNTIME_NOTHROW void WorkerBoundReferenceFreezeHook(KRef thiz) {
 extern "C" {
 
 KNativePtr Kotlin_WorkerBoundReference_create(KRef value) {
-  auto* holder = konanConstructInstance<KRefSharedHolder>();
-  holder->init(value);
-  return holder;
+  // Runs on the owning worker (the freeze hook fires before the reference can
+  // leave it), so the bias is established here.
+  auto* state = konanConstructInstance<BoundReferenceState>();
+  state->holder.init(value);
+  state->ownerToken = currentBoundThreadToken();
+  state->obj = value;
+  return state;
 }
 
 OBJ_GETTER(Kotlin_WorkerBoundReference_deref, KNativePtr holder) {
-  RETURN_OBJ(reinterpret_cast<KRefSharedHolder*>(holder)->ref<ErrorPolicy::kDefaultValue>());
+  auto* state = reinterpret_cast<BoundReferenceState*>(holder);
+  if (state->ownerToken == boundThreadToken) {
+    // Owner fast path: no accessibility check needed on the thread the object
+    // is owned by. The adopt is kept - it is what tells the cycle collector
+    // about shared containers handed out, and is a cheap tag check otherwise.
+    AdoptReferenceFromSharedVariable(state->obj);
+    RETURN_OBJ(state->obj);
+  }
+  RETURN_OBJ(state->holder.ref<ErrorPolicy::kDefaultValue>());
 }
 
 OBJ_GETTER(Kotlin_WorkerBoundReference_describe, KNativePtr holder) {
@@ -17,6 +17,8 @@
 
 #include <string.h>
 #include "cbigint.h"
+#include "../Common.h"
+#include "../Porting.h"
 
 #if defined(LINUX) || defined(FREEBSD) || defined(ZOS) || defined(MACOSX) || defined(AIX)
 #define USE_LL
@@ -902,3 +904,40 @@ simpleMultiplyHighPrecision64 (U_64 * arg1, IDATA length, U_64 arg2)
   while (++index < length);
   return intermediate;
 }
+
+/* Per-thread scratch arena backing the big-integer working storage of the
+ * parse slow paths in dblparse.cpp and fltparse.cpp. The approximation loops
+ * there allocate and release four buffers per iteration; serving them from a
+ * fixed thread-local block makes the steady-state slow path allocation-free.
+ * Oversized requests (huge decimal exponents) fall back to the heap, and the
+ * arena rewinds once every buffer taken from it has been released. */
+#define BIGNUM_SCRATCH_U64S 512
+
+THREAD_LOCAL_VARIABLE U_64 bignumScratch[BIGNUM_SCRATCH_U64S];
+THREAD_LOCAL_VARIABLE UDATA bignumScratchUsed = 0;
+THREAD_LOCAL_VARIABLE UDATA bignumScratchLive = 0;
+
+U_64 *
+allocateBignumScratch (UDATA u64Count)
+{
+  U_64 *result;
+  if (bignumScratchUsed + u64Count > BIGNUM_SCRATCH_U64S)
+    return (U_64 *) konan::calloc (u64Count, sizeof (U_64));
+  result = bignumScratch + bignumScratchUsed;
+  memset (result, 0, u64Count * sizeof (U_64));
+  bignumScratchUsed += u64Count;
+  bignumScratchLive++;
+  return result;
+}
+
+void
+releaseBignumScratch (U_64 * buffer)
+{
+  if (buffer >= bignumScratch && buffer < bignumScratch + BIGNUM_SCRATCH_U64S)
+    {
+      if (--bignumScratchLive == 0)
+        bignumScratchUsed = 0;
+      return;
+    }
+  konan::free (buffer);
+}
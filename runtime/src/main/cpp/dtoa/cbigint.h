@@ -51,6 +51,9 @@ extern "C"
   U_64 simpleMultiplyHighPrecision64 (U_64 * arg1, IDATA length, U_64 arg2);
   IDATA simpleAddHighPrecision (U_64 * arg1, IDATA length, U_64 arg2);
   IDATA floatExponent (KFloat z);
+  /* Per-thread scratch arena for parse working storage, see cbigint.cpp. */
+  U_64 *allocateBignumScratch (UDATA u64Count);
+  void releaseBignumScratch (U_64 * buffer);
 #if defined(__cplusplus)
 }
 #endif
@@ -20,6 +20,8 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "eisel_lemire.h"
+#include "ryu.h"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -173,8 +175,8 @@ static const KDouble tens[] = {
         }
 #define ERROR_OCCURED(x) (HIGH_I32_FROM_VAR(x) < 0)
 
-#define allocateU64(x, n) if (!((x) = (U_64*) konan::calloc(1, (n) * sizeof(U_64)))) goto OutOfMemory;
-#define release(r) if ((r)) konan::free((r));
+#define allocateU64(x, n) if (!((x) = allocateBignumScratch ((n)))) goto OutOfMemory;
+#define release(r) if ((r)) releaseBignumScratch((r));
 
 /*NB the Number converter methods are synchronized so it is possible to
  *have global data for use by bigIntDigitGenerator */
@@ -185,6 +187,29 @@ KDouble createDouble (const char *s, KInt e)
 {
   /* assumes s is a null terminated string with at least one
    * character in it */
+
+  /* Fast path: a significand of at most 19 digits fits in a 64-bit integer, so
+   * typical inputs round correctly via Eisel-Lemire without any high-precision
+   * arithmetic. Failure (overlong input, subnormal or out-of-range results,
+   * ambiguous rounding) falls through to the code below unchanged. */
+  {
+    uint64_t w = 0;
+    const char *scan = s;
+    int digitCount = 0;
+    while (*scan >= '0' && *scan <= '9' && digitCount < 19)
+      {
+        w = w * 10 + (U_32) (*scan - '0');
+        ++scan;
+        ++digitCount;
+      }
+    if (*scan == '\0' && digitCount > 0)
+      {
+        double fastResult;
+        if (EiselLemireDouble (w, e, &fastResult))
+          return fastResult;
+      }
+  }
+
   U_64 def[DEFAULT_WIDTH];
   U_64 defBackup[DEFAULT_WIDTH];
   U_64 *f, *fNoOverflow, *g, *tempBackup;
@@ -707,6 +732,27 @@ void Kotlin_native_NumberConverter_bigIntDigitGeneratorInstImpl (KRef results,
 
   U_64 R[RM_SIZE], S[STemp_SIZE], mplus[RM_SIZE], mminus[RM_SIZE], Temp[STemp_SIZE];
 
+  /* Fast path: Ryu produces the same digits without multi-word arithmetic. The
+   * boundary argument mirrors the `f != (2 << (p - 1))` tests below, which are
+   * evaluated in int width, so for double (p == 52) the comparison never matches
+   * and the rounding interval stays symmetric. */
+  {
+    int32_t ryuDigits[20];
+    int32_t ryuFirstK;
+    int ryuCount = RyuDigitGenerator ((uint64_t) f, e,
+                                      !isDenormalized && p < 31 && f == (2 << (p - 1)),
+                                      ryuDigits, &ryuFirstK);
+    if (ryuCount > 0)
+      {
+        for (i = 0; i < ryuCount; ++i)
+          Kotlin_IntArray_set(uArray, i, ryuDigits[i]);
+        Kotlin_IntArray_set(results, 0, ryuCount);
+        Kotlin_IntArray_set(results, 1, 0);
+        Kotlin_IntArray_set(results, 2, ryuFirstK);
+        return;
+      }
+  }
+
   memset (R, 0, RM_SIZE * sizeof (U_64));
   memset (S, 0, STemp_SIZE * sizeof (U_64));
   memset (mplus, 0, RM_SIZE * sizeof (U_64));
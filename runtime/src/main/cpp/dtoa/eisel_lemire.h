@@ -0,0 +1,20 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_DTOA_EISEL_LEMIRE_H
+#define RUNTIME_DTOA_EISEL_LEMIRE_H
+
+#include <stdint.h>
+
+// Computes the correctly rounded double (or float) nearest to w * 10^q using the
+// Eisel-Lemire algorithm: one or two 64x64->128 bit multiplications against a
+// precomputed power-of-five table instead of arbitrary-precision arithmetic.
+// Returns false when the result cannot be produced with certainty (subnormal
+// results, exponents outside the table, ambiguous rounding, or no 128-bit
+// arithmetic in this build); the caller must then fall back to the slow path.
+bool EiselLemireDouble(uint64_t w, int q, double* out);
+bool EiselLemireFloat(uint64_t w, int q, float* out);
+
+#endif  // RUNTIME_DTOA_EISEL_LEMIRE_H
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "eisel_lemire.h"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -116,12 +117,32 @@ static const U_32 tens[] = {
         } \
     }
 
-#define allocateU64(x, n) if (!((x) = (U_64*) konan::calloc(1, (n) * sizeof(U_64)))) goto OutOfMemory;
-#define release(r) if ((r)) konan::free((r));
+#define allocateU64(x, n) if (!((x) = allocateBignumScratch ((n)))) goto OutOfMemory;
+#define release(r) if ((r)) releaseBignumScratch((r));
 
 KFloat createFloat(const char *s, KInt e) {
   /* assumes s is a null terminated string with at least one
    * character in it */
+
+  /* Fast path: see the matching block in createDouble (dblparse.cpp). */
+  {
+    uint64_t w = 0;
+    const char *scan = s;
+    int digitCount = 0;
+    while (*scan >= '0' && *scan <= '9' && digitCount < 19)
+      {
+        w = w * 10 + (U_32) (*scan - '0');
+        ++scan;
+        ++digitCount;
+      }
+    if (*scan == '\0' && digitCount > 0)
+      {
+        float fastResult;
+        if (EiselLemireFloat (w, e, &fastResult))
+          return fastResult;
+      }
+  }
+
   U_64 def[DEFAULT_WIDTH];
   U_64 defBackup[DEFAULT_WIDTH];
   U_64 *f, *fNoOverflow, *g, *tempBackup;
@@ -0,0 +1,21 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_DTOA_RYU_H
+#define RUNTIME_DTOA_RYU_H
+
+#include <stdint.h>
+
+// Generates the shortest decimal digit sequence for the value f * 2^e using the Ryu
+// algorithm, reproducing the output of the Harmony big-integer digit generator.
+// When [boundary] is set the lower rounding margin is a quarter ulp instead of a
+// half ulp (the value sits on a power-of-two normalization boundary); the caller
+// decides this the same way the big-integer path does. Writes the digits most
+// significant first and the decimal position of the leading digit to *firstK;
+// returns the digit count, or -1 when this build cannot use the fast path (no
+// 128-bit arithmetic) and the caller must fall back.
+int RyuDigitGenerator(uint64_t f, int e, bool boundary, int32_t* digits, int32_t* firstK);
+
+#endif  // RUNTIME_DTOA_RYU_H
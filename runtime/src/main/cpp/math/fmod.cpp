@@ -28,6 +28,27 @@ double fmod(double x, double y)
 		return x;
 	}
 
+#if defined(FP_FAST_FMA) || defined(__aarch64__) || defined(__FMA__)
+	/* Both operands normal: reduce with one hardware division instead of
+	   the bit-at-a-time loop below. While q = floor(|x|/|y|) fits the
+	   significand, the true remainder |x| - q*|y| is a multiple of the
+	   ulp grid of |y| smaller than |y|, hence exactly representable, and
+	   a fused multiply-add computes it without rounding. The rounded
+	   division may land on a neighbouring integer; the fma result then
+	   has the wrong sign or exceeds |y|, and one recomputation with the
+	   adjusted quotient is again exact. */
+	if (ex && ey && ex - ey <= 50) {
+		double ax = __builtin_fabs(x), ay = __builtin_fabs(y);
+		double q = __builtin_trunc(ax / ay);
+		double r = __builtin_fma(-q, ay, ax);
+		if (r < 0)
+			r = __builtin_fma(-(q - 1), ay, ax);
+		else if (r >= ay)
+			r = __builtin_fma(-(q + 1), ay, ax);
+		return sx ? -r : r;
+	}
+#endif
+
 	/* normalize x and y */
 	if (!ex) {
 		for (i = uxi<<12; i>>63 == 0; ex--, i <<= 1);
@@ -25,6 +25,23 @@ float fmodf(float x, float y)
 		return x;
 	}
 
+	/* Both operands normal: while q = floor(|x|/|y|) has at most 29 bits,
+	   q, every product and every remainder below fit a double significand
+	   exactly, so one hardware division replaces the bit-at-a-time loop.
+	   The rounded division may land on a neighbouring integer; the
+	   remainder then has the wrong sign or exceeds |y| and one exact
+	   correction step restores it. */
+	if (ex && ey && ex - ey <= 28) {
+		double ax = __builtin_fabs((double)x), ay = __builtin_fabs((double)y);
+		double q = __builtin_trunc(ax / ay);
+		double r = ax - q * ay;
+		if (r < 0)
+			r += ay;
+		else if (r >= ay)
+			r -= ay;
+		return (float)(sx ? -r : r);
+	}
+
 	/* normalize x and y */
 	if (!ex) {
 		for (i = uxi<<9; i>>31 == 0; ex--, i <<= 1);
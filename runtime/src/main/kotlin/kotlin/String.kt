@@ -7,6 +7,7 @@ package kotlin
 
 import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.Frozen
+import kotlin.text.StringView
 
 @ExportTypeInfo("theStringTypeInfo")
 @Frozen
@@ -36,8 +37,18 @@ public final class String : Comparable<String>, CharSequence {
     @SymbolName("Kotlin_String_get")
     external override public fun get(index: Int): Char
 
-    @SymbolName("Kotlin_String_subSequence")
-    external override public fun subSequence(startIndex: Int, endIndex: Int): CharSequence
+    /**
+     * Returns a view of the character range of this string, without copying the characters.
+     * Strings are immutable, so the view stays valid as long as it is reachable; converting
+     * it back to a [String] with `toString()` copies the range out.
+     */
+    override public fun subSequence(startIndex: Int, endIndex: Int): CharSequence {
+        if (startIndex < 0 || endIndex > length || startIndex > endIndex)
+            throw IndexOutOfBoundsException("startIndex: $startIndex, endIndex: $endIndex, length: $length")
+        if (startIndex == 0 && endIndex == length) return this
+        if (startIndex == endIndex) return ""
+        return StringView(this, startIndex, endIndex - startIndex)
+    }
 
     @SymbolName("Kotlin_String_compareTo")
     override external public fun compareTo(other: String): Int
@@ -27,7 +27,8 @@ public open class Throwable(open val message: String?, open val cause: Throwable
     constructor() : this(null, null)
 
     @get:ExportForCppRuntime("Kotlin_Throwable_getStackTrace")
-    private val stackTrace: NativePtrArray = getCurrentStackTrace()
+    private val stackTrace: NativePtrArray =
+            if (this is kotlin.native.NoStackTrace) emptyStackTrace() else getCurrentStackTrace()
 
     private val stackTraceStrings: Array<String> by lazy {
         getStackTraceStrings(stackTrace).freeze()
@@ -142,6 +143,9 @@ public open class Throwable(open val message: String?, open val cause: Throwable
 @SymbolName("Kotlin_getCurrentStackTrace")
 private external fun getCurrentStackTrace(): NativePtrArray
 
+@SymbolName("Kotlin_emptyStackTrace")
+private external fun emptyStackTrace(): NativePtrArray
+
 @SymbolName("Kotlin_getStackTraceStrings")
 private external fun getStackTraceStrings(stackTrace: NativePtrArray): Array<String>
 
@@ -146,7 +146,10 @@ actual class ArrayList<E> private constructor(
         if (backing != null) throw IllegalStateException() // just in case somebody casts subList to ArrayList
         if (minCapacity > array.size) {
             val newSize = ArrayDeque.newCapacity(array.size, minCapacity)
-            array = array.copyOfUninitializedElements(newSize)
+            // The backing array is private to this list, so when the allocator has slack
+            // behind it the growth happens in place, skipping the allocation and the copy.
+            if (!array.tryGrowInPlace(newSize))
+                array = array.copyOfUninitializedElements(newSize)
         }
     }
 
@@ -75,6 +75,15 @@ internal fun <E> Array<E>.resetAt(index: Int) {
     (@Suppress("UNCHECKED_CAST")(this as Array<Any?>))[index] = null
 }
 
+/**
+ * Tries to grow this array to [newSize] elements in place, using allocator slack behind
+ * its storage. Returns true on success, in which case this very array now has [newSize]
+ * elements, the new ones _uninitialized_. The caller must be the only owner of the array:
+ * on success its identity and contents stay intact, but its size visibly changes.
+ */
+@SymbolName("Kotlin_Array_tryGrowInPlace")
+internal external fun <E> Array<E>.tryGrowInPlace(newSize: Int): Boolean
+
 @SymbolName("Kotlin_Array_fillImpl")
 @PointsTo(0x3000, 0x0000, 0x0000, 0x0000) // array.intestines -> value
 internal external fun <T> arrayFill(array: Array<T>, fromIndex: Int, toIndex: Int, value: T)
@@ -118,3 +118,55 @@ public actual inline fun <reified T> Collection<T>.toTypedArray(): Array<T> {
     @Suppress("UNCHECKED_CAST")
     return result as Array<T>
 }
+
+// Bulk kernels behind contentEquals/contentHashCode of primitive arrays: one
+// size check plus a memcmp, and an unrolled polynomial hash. Element equality
+// and hashes match the primitive types' own equals()/hashCode().
+
+@SymbolName("Kotlin_ByteArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: ByteArray, other: ByteArray): Boolean
+
+@SymbolName("Kotlin_ShortArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: ShortArray, other: ShortArray): Boolean
+
+@SymbolName("Kotlin_CharArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: CharArray, other: CharArray): Boolean
+
+@SymbolName("Kotlin_IntArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: IntArray, other: IntArray): Boolean
+
+@SymbolName("Kotlin_LongArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: LongArray, other: LongArray): Boolean
+
+@SymbolName("Kotlin_FloatArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: FloatArray, other: FloatArray): Boolean
+
+@SymbolName("Kotlin_DoubleArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: DoubleArray, other: DoubleArray): Boolean
+
+@SymbolName("Kotlin_BooleanArray_contentEqualsImpl")
+internal external fun contentEqualsImpl(thiz: BooleanArray, other: BooleanArray): Boolean
+
+@SymbolName("Kotlin_ByteArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: ByteArray): Int
+
+@SymbolName("Kotlin_ShortArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: ShortArray): Int
+
+@SymbolName("Kotlin_CharArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: CharArray): Int
+
+@SymbolName("Kotlin_IntArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: IntArray): Int
+
+@SymbolName("Kotlin_LongArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: LongArray): Int
+
+@SymbolName("Kotlin_FloatArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: FloatArray): Int
+
+@SymbolName("Kotlin_DoubleArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: DoubleArray): Int
+
+@SymbolName("Kotlin_BooleanArray_contentHashCodeImpl")
+internal external fun contentHashCodeImpl(thiz: BooleanArray): Int
@@ -27,6 +27,14 @@ actual class HashMap<K, V> private constructor(
 
     private var isReadOnly: Boolean = false
 
+    // Per-map key-shape cache, one of the KEY_SHAPE_* constants. Most maps are
+    // monomorphic (overwhelmingly string-keyed), while hashCode()/equals() on a
+    // K-typed key dispatches through the vtable on every probe. While this says
+    // strings, every stored non-null key is known to be a String and hashing and
+    // comparison call the final String implementations directly. Maintained on
+    // the mutation path only, so lookups on frozen maps stay write-free.
+    private var keyShape = KEY_SHAPE_UNKNOWN
+
     // ---------------------------- functions ----------------------------
 
     actual constructor() : this(INITIAL_CAPACITY)
@@ -202,7 +210,33 @@ actual class HashMap<K, V> private constructor(
     }
 
     // Null-check for escaping extra boxing for non-nullable keys.
-    private fun hash(key: K) = if (key == null) 0 else (key.hashCode() * MAGIC) ushr hashShift
+    private fun hash(key: K): Int {
+        if (key == null) return 0
+        // Monomorphic shortcut: one typeinfo check replaces the virtual dispatch
+        // with a direct call to the final String.hashCode.
+        if (keyShape == KEY_SHAPE_STRING && key is String) return stringHash(key)
+        return (key.hashCode() * MAGIC) ushr hashShift
+    }
+
+    private fun stringHash(key: String) = (key.hashCode() * MAGIC) ushr hashShift
+
+    // Key comparison with the same monomorphic shortcut as [hash]: while the map is
+    // string-keyed, a matching probe costs a direct String.equals instead of a
+    // virtual call. A null key may still be stored, hence the safe cast.
+    private fun keyEquals(stored: K, key: K): Boolean {
+        if (keyShape == KEY_SHAPE_STRING && key is String) return (stored as? String)?.equals(key) ?: false
+        return stored == key
+    }
+
+    // Maintains [keyShape]. Only called from mutating operations, so that reads
+    // never write and stay safe on frozen maps.
+    private fun updateKeyShape(key: K) {
+        when {
+            key == null -> {}
+            key is String -> if (keyShape == KEY_SHAPE_UNKNOWN) keyShape = KEY_SHAPE_STRING
+            else -> if (keyShape != KEY_SHAPE_MIXED) keyShape = KEY_SHAPE_MIXED
+        }
+    }
 
     private fun compact() {
         var i = 0
@@ -260,7 +294,7 @@ actual class HashMap<K, V> private constructor(
         while (true) {
             val index = hashArray[hash]
             if (index == 0) return TOMBSTONE
-            if (index > 0 && keysArray[index - 1] == key) return index - 1
+            if (index > 0 && keyEquals(keysArray[index - 1], key)) return index - 1
             if (--probesLeft < 0) return TOMBSTONE
             if (hash-- == 0) hash = hashSize - 1
         }
@@ -277,6 +311,7 @@ actual class HashMap<K, V> private constructor(
 
     internal fun addKey(key: K): Int {
         checkIsMutable()
+        updateKeyShape(key)
         retry@ while (true) {
             var hash = hash(key)
             // put is allowed to grow maxProbeDistance with some limits (resize hash on reaching limits)
@@ -297,7 +332,7 @@ actual class HashMap<K, V> private constructor(
                     if (probeDistance > maxProbeDistance) maxProbeDistance = probeDistance
                     return putIndex
                 }
-                if (keysArray[index - 1] == key) {
+                if (keyEquals(keysArray[index - 1], key)) {
                     return -index
                 }
                 if (++probeDistance > tentativeMaxProbeDistance) {
@@ -470,6 +505,11 @@ actual class HashMap<K, V> private constructor(
         private const val INITIAL_MAX_PROBE_DISTANCE = 2
         private const val TOMBSTONE = -1
 
+        // States of the per-map key-shape cache, see [keyShape].
+        private const val KEY_SHAPE_UNKNOWN = 0
+        private const val KEY_SHAPE_STRING = 1
+        private const val KEY_SHAPE_MIXED = 2
+
         @OptIn(ExperimentalStdlibApi::class)
         private fun computeHashSize(capacity: Int): Int = (capacity.coerceAtLeast(1) * 3).takeHighestOneBit()
 
@@ -27,6 +27,25 @@ public actual fun println(message: Any?) {
 @SymbolName("Kotlin_io_Console_println0")
 external public actual fun println()
 
+/**
+ * Configures the runtime-managed standard output buffer used by [print] and [println].
+ *
+ * With a positive [sizeBytes] output is accumulated and written out once the buffer
+ * fills up, on [flush], before [readLine] blocks and when the runtime shuts down.
+ * When [autoFlushOnNewline] is set, any printed line separator also flushes the buffer.
+ * A [sizeBytes] of zero (the default) keeps the unbuffered one-write-per-print behavior.
+ */
+public fun setOutputBuffer(sizeBytes: Int, autoFlushOnNewline: Boolean = false) {
+    setOutputBufferImpl(sizeBytes, autoFlushOnNewline)
+}
+
+@SymbolName("Kotlin_io_Console_setOutputBuffer")
+private external fun setOutputBufferImpl(sizeBytes: Int, autoFlushOnNewline: Boolean)
+
+/** Writes out any output buffered by [print] and [println]. */
+@SymbolName("Kotlin_io_Console_flush")
+external public fun flush()
+
 /**
  * Reads a line of input from the standard input stream.
  *
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2010-2018 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.math
+
+// Bulk variants of the math functions above: each evaluates its function over the
+// first [n] elements of [src] in a single runtime call, storing results into [dst],
+// so tight numeric loops pay no per-element transition into the runtime.
+// [src] and [dst] may be the same array for in-place evaluation.
+
+// region ================ DoubleArray Math ===================================
+
+/** Computes [sin] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_sinArray")
+external public fun sinArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+/** Computes [cos] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_cosArray")
+external public fun cosArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+/** Computes [tan] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_tanArray")
+external public fun tanArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+/** Computes [exp] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_expArray")
+external public fun expArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+/** Computes [ln] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_lnArray")
+external public fun lnArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+/** Computes [sqrt] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_sqrtArray")
+external public fun sqrtArray(src: DoubleArray, dst: DoubleArray, n: Int)
+
+// endregion
+
+// region ================ FloatArray Math ====================================
+
+/** Computes [sin] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_sinArrayf")
+external public fun sinArray(src: FloatArray, dst: FloatArray, n: Int)
+
+/** Computes [cos] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_cosArrayf")
+external public fun cosArray(src: FloatArray, dst: FloatArray, n: Int)
+
+/** Computes [tan] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_tanArrayf")
+external public fun tanArray(src: FloatArray, dst: FloatArray, n: Int)
+
+/** Computes [exp] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_expArrayf")
+external public fun expArray(src: FloatArray, dst: FloatArray, n: Int)
+
+/** Computes [ln] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_lnArrayf")
+external public fun lnArray(src: FloatArray, dst: FloatArray, n: Int)
+
+/** Computes [sqrt] of the first [n] elements of [src], storing results into [dst]. */
+@SymbolName("Kotlin_math_sqrtArrayf")
+external public fun sqrtArray(src: FloatArray, dst: FloatArray, n: Int)
+
+// endregion
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native
+
+import kotlin.native.SymbolName
+
+/**
+ * Vectorized whole-array reductions. The stdlib `sum()`/`min()`/`max()` extensions
+ * compile to element-by-element loops; the entry points below reduce the raw array
+ * storage in the runtime with bounds established once and SIMD lanes where the
+ * target provides them, which matters for reduction-heavy numeric pipelines.
+ */
+
+/**
+ * Returns the sum of all elements, accumulated with wrap-around on overflow
+ * like the stdlib `sum()`.
+ */
+@SymbolName("Kotlin_IntArray_sum")
+public external fun IntArray.fastSum(): Int
+
+/**
+ * Returns the sum of all elements, accumulated with wrap-around on overflow
+ * like the stdlib `sum()`.
+ */
+@SymbolName("Kotlin_LongArray_sum")
+public external fun LongArray.fastSum(): Long
+
+/**
+ * Returns the sum of all elements.
+ *
+ * Unlike the stdlib `sum()` the elements are accumulated in several independent
+ * lanes, so the rounding of the result may differ from that of a strictly
+ * sequential summation (and is typically closer to the exact value).
+ */
+@SymbolName("Kotlin_FloatArray_sum")
+public external fun FloatArray.fastSum(): Float
+
+/**
+ * Returns the sum of all elements.
+ *
+ * Unlike the stdlib `sum()` the elements are accumulated in several independent
+ * lanes, so the rounding of the result may differ from that of a strictly
+ * sequential summation (and is typically closer to the exact value).
+ */
+@SymbolName("Kotlin_DoubleArray_sum")
+public external fun DoubleArray.fastSum(): Double
+
+/**
+ * Returns the smallest element.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun IntArray.fastMin(): Int {
+    if (isEmpty()) throw NoSuchElementException()
+    return minImpl(this)
+}
+
+/**
+ * Returns the largest element.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun IntArray.fastMax(): Int {
+    if (isEmpty()) throw NoSuchElementException()
+    return maxImpl(this)
+}
+
+/**
+ * Returns the smallest element.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun LongArray.fastMin(): Long {
+    if (isEmpty()) throw NoSuchElementException()
+    return minImpl(this)
+}
+
+/**
+ * Returns the largest element.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun LongArray.fastMax(): Long {
+    if (isEmpty()) throw NoSuchElementException()
+    return maxImpl(this)
+}
+
+/**
+ * Returns the smallest element. If any element is `NaN`, returns `NaN`.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun FloatArray.fastMin(): Float {
+    if (isEmpty()) throw NoSuchElementException()
+    return minImpl(this)
+}
+
+/**
+ * Returns the largest element. If any element is `NaN`, returns `NaN`.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun FloatArray.fastMax(): Float {
+    if (isEmpty()) throw NoSuchElementException()
+    return maxImpl(this)
+}
+
+/**
+ * Returns the smallest element. If any element is `NaN`, returns `NaN`.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun DoubleArray.fastMin(): Double {
+    if (isEmpty()) throw NoSuchElementException()
+    return minImpl(this)
+}
+
+/**
+ * Returns the largest element. If any element is `NaN`, returns `NaN`.
+ *
+ * @throws NoSuchElementException if the array is empty.
+ */
+public fun DoubleArray.fastMax(): Double {
+    if (isEmpty()) throw NoSuchElementException()
+    return maxImpl(this)
+}
+
+// Implementation details.
+
+@SymbolName("Kotlin_IntArray_min")
+private external fun minImpl(array: IntArray): Int
+
+@SymbolName("Kotlin_IntArray_max")
+private external fun maxImpl(array: IntArray): Int
+
+@SymbolName("Kotlin_LongArray_min")
+private external fun minImpl(array: LongArray): Long
+
+@SymbolName("Kotlin_LongArray_max")
+private external fun maxImpl(array: LongArray): Long
+
+@SymbolName("Kotlin_FloatArray_min")
+private external fun minImpl(array: FloatArray): Float
+
+@SymbolName("Kotlin_FloatArray_max")
+private external fun maxImpl(array: FloatArray): Float
+
+@SymbolName("Kotlin_DoubleArray_min")
+private external fun minImpl(array: DoubleArray): Double
+
+@SymbolName("Kotlin_DoubleArray_max")
+private external fun maxImpl(array: DoubleArray): Double
@@ -96,6 +96,42 @@ public object Platform {
     public var isCleanersLeakCheckerActive: Boolean
         get() = Platform_getCleanersLeakChecker()
         set(value) = Platform_setCleanersLeakChecker(value)
+
+    /**
+     * When enabled, exception stack traces are captured by walking the frame pointer
+     * chain instead of running the unwinder, which is orders of magnitude faster.
+     *
+     * Only frames of code compiled with frame pointers preserved are visible to this
+     * walker, so it should be enabled only in binaries built accordingly (e.g. profiling
+     * builds). On targets without frame pointer support the setter has no effect.
+     */
+    public var isFastStackTraceCaptureActive: Boolean
+        get() = Platform_getFastStackTraceCapture()
+        set(value) = Platform_setFastStackTraceCapture(value)
+
+    /**
+     * When enabled, process exit skips the final GC, finalizer cascades and worker
+     * teardown and terminates immediately after flushing buffered console output,
+     * letting the operating system reclaim the heap. This can save seconds on exit
+     * for large heaps, at the cost of not running any cleanup.
+     *
+     * Can also be enabled by setting the `KONAN_FAST_SHUTDOWN` environment variable
+     * to `1`. Leak checkers see no leaks on such an exit, as nothing is torn down.
+     */
+    public var isFastShutdownEnabled: Boolean
+        get() = Platform_getFastShutdown()
+        set(value) = Platform_setFastShutdown(value)
+
+    /**
+     * Effective runtime tuning values as `key=value` pairs, in the same syntax
+     * the `KONAN_RUNTIME_CONFIG` environment variable (or the file named by
+     * `KONAN_RUNTIME_CONFIG_FILE`) accepts: GC pacing thresholds, worker spin
+     * parameters, console buffering and stack trace depth. Intended for
+     * verifying what a deployment actually runs with; `-1` marks knobs left at
+     * their built-in defaults.
+     */
+    public val runtimeConfiguration: String
+        get() = Platform_getRuntimeConfiguration()
 }
 
 @SymbolName("Konan_Platform_canAccessUnaligned")
@@ -127,3 +163,18 @@ private external fun Platform_getCleanersLeakChecker(): Boolean
 
 @SymbolName("Konan_Platform_setCleanersLeakChecker")
 private external fun Platform_setCleanersLeakChecker(value: Boolean): Unit
+
+@SymbolName("Konan_Platform_getFastStackTraceCapture")
+private external fun Platform_getFastStackTraceCapture(): Boolean
+
+@SymbolName("Konan_Platform_setFastStackTraceCapture")
+private external fun Platform_setFastStackTraceCapture(value: Boolean): Unit
+
+@SymbolName("Konan_Platform_getFastShutdown")
+private external fun Platform_getFastShutdown(): Boolean
+
+@SymbolName("Konan_Platform_setFastShutdown")
+private external fun Platform_setFastShutdown(value: Boolean): Unit
+
+@SymbolName("Konan_Platform_getRuntimeConfiguration")
+private external fun Platform_getRuntimeConfiguration(): String
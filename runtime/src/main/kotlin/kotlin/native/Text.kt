@@ -150,8 +150,16 @@ internal external fun String.unsafeStringToUtf8OrThrow(start: Int, size: Int) :
 @SymbolName("Kotlin_String_unsafeStringFromCharArray")
 internal external fun unsafeStringFromCharArray(array: CharArray, start: Int, size: Int) : String
 
+// Re-tags the fully-used [array] as a String when possible instead of copying it.
+// The caller must drop its own reference to [array] right after the call.
+@SymbolName("Kotlin_String_unsafeStringHandoffCharArray")
+internal external fun unsafeStringHandoffCharArray(array: CharArray) : String
+
 @SymbolName("Kotlin_StringBuilder_insertString")
 internal external fun insertString(array: CharArray, distIndex: Int, value: String, sourceIndex: Int, count: Int): Int
 
 @SymbolName("Kotlin_StringBuilder_insertInt")
-internal external fun insertInt(array: CharArray, start: Int, value: Int): Int
\ No newline at end of file
+internal external fun insertInt(array: CharArray, start: Int, value: Int): Int
+
+@SymbolName("Kotlin_StringBuilder_insertLong")
+internal external fun insertLong(array: CharArray, start: Int, value: Long): Int
\ No newline at end of file
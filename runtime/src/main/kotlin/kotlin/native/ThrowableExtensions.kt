@@ -10,3 +10,12 @@ package kotlin.native
  */
 public fun Throwable.getStackTraceAddresses(): List<Long> =
         this.getStackTraceAddressesInternal()
+
+/**
+ * Marker interface: [Throwable] classes implementing it skip stack trace capture
+ * on construction, making them cheap to throw.
+ *
+ * Intended for exceptions used as control flow, where the trace is never looked at.
+ * [Throwable.getStackTrace] and the printed trace of such an exception are empty.
+ */
+public interface NoStackTrace
@@ -7,6 +7,7 @@ package kotlin.native.concurrent
 
 import kotlin.native.internal.ExportTypeInfo
 import kotlin.native.internal.Frozen
+import kotlin.native.internal.createCleaner
 import kotlin.native.internal.LeakDetectorCandidate
 import kotlin.native.internal.NoReorderFields
 import kotlin.native.SymbolName
@@ -380,3 +381,97 @@ public class FreezableAtomicReference<T>(private var value_: T) {
     @SymbolName("Kotlin_AtomicReference_compareAndSet")
     private external fun compareAndSetImpl(expected: Any?, new: Any?): Boolean
 }
+
+/**
+ * A striped counter for values incremented from many threads and read rarely,
+ * such as global metrics.
+ *
+ * [AtomicLong.addAndGet] keeps a single cache line hot among all incrementing
+ * cores. This counter spreads increments over a set of cache-line-padded cells,
+ * so that under contention each thread mostly increments a line of its own;
+ * [sum] folds the cells back together. In exchange, [sum] is not an atomic
+ * snapshot with respect to concurrent increments - each added delta is counted
+ * exactly once, but a sum racing with increments may or may not include them.
+ *
+ * The counter can be frozen and shared between workers.
+ */
+@Frozen
+@OptIn(ExperimentalStdlibApi::class)
+public class StripedLongCounter {
+    private val cells: NativePtr = createCells()
+
+    @Suppress("unused")
+    private val cleaner = createCleaner(cells) { disposeCells(it) }
+
+    /**
+     * Adds [delta] to this counter.
+     */
+    public fun add(delta: Long): Unit = addImpl(cells, delta)
+
+    /**
+     * Increments this counter by one.
+     */
+    public fun increment(): Unit = add(1L)
+
+    /**
+     * Returns the sum of all increments so far.
+     */
+    public fun sum(): Long = sumImpl(cells)
+
+    /**
+     * Returns the string representation of this object.
+     *
+     * @return string representation of this object
+     */
+    public override fun toString(): String = sum().toString()
+
+    // Implementation details.
+    companion object {
+        @SymbolName("Kotlin_StripedLongCounter_createCells")
+        private external fun createCells(): NativePtr
+
+        @SymbolName("Kotlin_StripedLongCounter_disposeCells")
+        private external fun disposeCells(cells: NativePtr)
+
+        @SymbolName("Kotlin_StripedLongCounter_add")
+        private external fun addImpl(cells: NativePtr, delta: Long)
+
+        @SymbolName("Kotlin_StripedLongCounter_sum")
+        private external fun sumImpl(cells: NativePtr): Long
+    }
+}
+
+/**
+ * Atomically reads the element at [index].
+ *
+ * Together with [atomicAdd] and [atomicCompareAndSet] this makes a frozen [IntArray]
+ * usable as a dense set of concurrent counters (histogram buckets, statistics slots),
+ * with better locality and no per-element object overhead compared to an array of
+ * [AtomicInt] boxes.
+ *
+ * @throws IndexOutOfBoundsException if [index] is out of bounds.
+ */
+@SymbolName("Kotlin_IntArray_atomicGet")
+external public fun IntArray.atomicGet(index: Int): Int
+
+/**
+ * Atomically adds [delta] to the element at [index] and returns the new value.
+ *
+ * Unlike the regular element store this is allowed on a frozen array: the update
+ * is atomic, so concurrent adds from multiple workers are each counted exactly once.
+ *
+ * @throws IndexOutOfBoundsException if [index] is out of bounds.
+ */
+@SymbolName("Kotlin_IntArray_atomicAdd")
+external public fun IntArray.atomicAdd(index: Int, delta: Int): Int
+
+/**
+ * Atomically sets the element at [index] to [new] if it equals [expected],
+ * returning whether the exchange happened.
+ *
+ * Unlike the regular element store this is allowed on a frozen array.
+ *
+ * @throws IndexOutOfBoundsException if [index] is out of bounds.
+ */
+@SymbolName("Kotlin_IntArray_atomicCompareAndSet")
+external public fun IntArray.atomicCompareAndSet(index: Int, expected: Int, new: Int): Boolean
@@ -101,4 +101,15 @@ public fun <T> waitForMultipleFutures(futures: Collection<Future<T>>, timeoutMil
     }
 
     return result
-}
\ No newline at end of file
+}
+
+/**
+ * Returns a file descriptor which becomes readable whenever some future becomes ready,
+ * suitable for registration with an external event loop (e.g. epoll or kqueue).
+ * After draining the descriptor check the states of the futures of interest, for example
+ * with [waitForMultipleFutures] passing zero timeout.
+ *
+ * The descriptor is owned by the runtime and stays valid for the lifetime of the process.
+ * Returns -1 if such notification is not supported on this platform.
+ */
+public fun futureCompletionFd(): Int = completionFd()
\ No newline at end of file
@@ -28,6 +28,9 @@ external internal fun waitForAnyFuture(versionToken: Int, millis: Int): Boolean
 @SymbolName("Kotlin_Worker_versionToken")
 external internal fun versionToken(): Int
 
+@SymbolName("Kotlin_Worker_completionFd")
+external internal fun completionFd(): Int
+
 @kotlin.native.internal.ExportForCompiler
 internal fun executeImpl(worker: Worker, mode: TransferMode, producer: () -> Any?,
                          job: CPointer<CFunction<*>>): Future<Any?> =
@@ -49,15 +52,58 @@ external internal fun executeInternal(
 @SymbolName("Kotlin_Worker_executeAfterInternal")
 external internal fun executeAfterInternal(id: Int, operation: () -> Unit, afterMicroseconds: Long): Unit
 
+@SymbolName("Kotlin_Worker_executeAfterWithPriorityInternal")
+external internal fun executeAfterWithPriorityInternal(
+        id: Int, operation: () -> Unit, afterMicroseconds: Long, priority: Int, deadlineMicroseconds: Long): Unit
+
+@SymbolName("Kotlin_Worker_executeBatchInternal")
+external internal fun executeBatchInternal(id: Int, operations: Array<() -> Unit>): Unit
+
 @SymbolName("Kotlin_Worker_processQueueInternal")
 external internal fun processQueueInternal(id: Int): Boolean
 
+@SymbolName("Kotlin_Worker_yieldInternal")
+external internal fun yieldInternal(id: Int, continuation: () -> Unit): Boolean
+
 @SymbolName("Kotlin_Worker_parkInternal")
 external internal fun parkInternal(id: Int, timeoutMicroseconds: Long, process: Boolean): Boolean
 
+@SymbolName("Kotlin_Worker_notificationFdInternal")
+external internal fun notificationFdInternal(id: Int): Int
+
 @SymbolName("Kotlin_Worker_getNameInternal")
 external internal fun getWorkerNameInternal(id: Int): String?
 
+@SymbolName("Kotlin_Worker_getStatsInternal")
+external internal fun getWorkerStatsInternal(id: Int): LongArray
+
+@SymbolName("Kotlin_Worker_localHeapBytesInternal")
+external internal fun localHeapBytesInternal(): Long
+
+@SymbolName("Kotlin_Worker_setStackSizeInternal")
+external internal fun setWorkerStackSizeInternal(bytes: Int)
+
+@SymbolName("Kotlin_Worker_setDelayedCoalescingInternal")
+external internal fun setDelayedCoalescingInternal(windowMicroseconds: Long)
+
+@SymbolName("Kotlin_Worker_setCpuAffinityInternal")
+external internal fun setCpuAffinityInternal(id: Int, cpus: IntArray): Boolean
+
+@SymbolName("Kotlin_Worker_availableProcessorsInternal")
+external internal fun availableProcessorsInternal(): Int
+
+@SymbolName("Kotlin_WorkerPool_startInternal")
+external internal fun startPoolInternal(size: Int, errorReporting: Boolean): Int
+
+@SymbolName("Kotlin_WorkerPool_scheduleInternal")
+external internal fun poolScheduleInternal(poolId: Int): Int
+
+@SymbolName("Kotlin_WorkerPool_sizeInternal")
+external internal fun poolSizeInternal(poolId: Int): Int
+
+@SymbolName("Kotlin_WorkerPool_memberInternal")
+external internal fun poolMemberInternal(poolId: Int, index: Int): Int
+
 @ExportForCppRuntime
 internal fun ThrowWorkerUnsupported(): Unit =
         throw UnsupportedOperationException("Workers are not supported")
@@ -73,10 +119,25 @@ internal fun WorkerLaunchpad(function: () -> Any?) = function()
 @SymbolName("Kotlin_Worker_detachObjectGraphInternal")
 external internal fun detachObjectGraphInternal(mode: Int, producer: () -> Any?): NativePtr
 
+@SymbolName("Kotlin_Worker_compactObjectGraphInternal")
+external internal fun compactObjectGraphInternal(stable: NativePtr): NativePtr
+
 @PublishedApi
 @SymbolName("Kotlin_Worker_attachObjectGraphInternal")
 external internal fun attachObjectGraphInternal(stable: NativePtr): Any?
 
+@SymbolName("Kotlin_Worker_channelCreateInternal")
+external internal fun channelCreateInternal(capacity: Int): Int
+
+@SymbolName("Kotlin_Worker_channelSendInternal")
+external internal fun channelSendInternal(id: Int, mode: Int, producer: () -> Any?): Boolean
+
+@SymbolName("Kotlin_Worker_channelReceiveInternal")
+external internal fun channelReceiveInternal(id: Int): Any?
+
+@SymbolName("Kotlin_Worker_channelCloseInternal")
+external internal fun channelCloseInternal(id: Int)
+
 @SymbolName("Kotlin_Worker_freezeInternal")
 internal external fun freezeInternal(it: Any?)
 
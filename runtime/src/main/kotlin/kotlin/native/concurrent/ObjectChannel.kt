@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.concurrent
+
+import kotlin.native.internal.Frozen
+
+/**
+ * Single-producer single-consumer channel of detached object subgraphs.
+ *
+ * Messages are detached on send exactly like [DetachedObjectGraph] and reattached on
+ * receive, but travel through a fixed-capacity ring buffer, so a producer worker can
+ * stream messages to a consumer without a shared-state rendezvous per message. At most
+ * one thread may send and at most one thread may receive at any time; the channel
+ * object itself is frozen and can be safely shared with both.
+ *
+ * The same transfer rules apply as for [DetachedObjectGraph]: in [TransferMode.SAFE]
+ * each message subgraph is checked to be unreachable from the producer, and an
+ * [IllegalStateException] is thrown otherwise.
+ */
+@Frozen
+public class ObjectChannel<T : Any> public constructor(capacity: Int = 1024) {
+    private val id: Int = channelCreateInternal(capacity)
+
+    /**
+     * Detaches the object subgraph produced by [producer] and enqueues it, ensuring the
+     * subgraph is disjoint in the specified [mode] ([TransferMode.SAFE] by default).
+     * Returns `false` without invoking [producer] when the channel is full.
+     */
+    public fun trySend(mode: TransferMode = TransferMode.SAFE, producer: () -> T): Boolean =
+            @Suppress("UNCHECKED_CAST")
+            channelSendInternal(id, mode.value, producer as () -> Any?)
+
+    /**
+     * Dequeues and attaches the oldest pending message, or returns `null` when the
+     * channel is empty.
+     */
+    public fun tryReceive(): T? =
+            @Suppress("UNCHECKED_CAST")
+            (channelReceiveInternal(id) as T?)
+
+    /**
+     * Closes the channel, discarding undelivered messages. Must not be called
+     * concurrently with [trySend] or [tryReceive]; further operations on a closed
+     * channel throw an [IllegalStateException].
+     */
+    public fun close(): Unit = channelCloseInternal(id)
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.concurrent
+
+import kotlin.native.internal.ExportForCppRuntime
+import kotlin.native.internal.Frozen
+import kotlin.native.internal.createCleaner
+import kotlin.native.SymbolName
+import kotlinx.cinterop.NativePtr
+
+/**
+ * A hash map of frozen keys and values, shareable between workers.
+ *
+ * Unlike building a shared map from [AtomicReference] and copying the whole map on
+ * every update, this map updates in place: [get] is lock-free and [put]/[remove]
+ * are O(1), with writers serialized on an internal lock. Key comparison is
+ * value-based, via [Any.equals] and [Any.hashCode].
+ *
+ * Both keys and values must be frozen (or permanent) objects, the same rule
+ * [AtomicReference] imposes on shared state; [put] throws
+ * [InvalidMutabilityException] otherwise. The map itself is frozen on creation.
+ */
+@Frozen
+@OptIn(ExperimentalStdlibApi::class)
+public class SharedHashMap<K : Any, V : Any> public constructor(initialCapacity: Int = 16) {
+    private val map: NativePtr = createMap(initialCapacity)
+
+    @Suppress("unused")
+    private val cleaner = createCleaner(map) { disposeMap(it) }
+
+    /**
+     * The number of entries in the map. Concurrent updates make this an
+     * instantaneous approximation, as for any concurrent container.
+     */
+    public val size: Int
+        get() = sizeImpl(map)
+
+    /**
+     * Returns the value associated with [key], or `null` if the key is absent.
+     */
+    public fun get(key: K): V? =
+            @Suppress("UNCHECKED_CAST")
+            (getImpl(map, key, key.hashCode()) as V?)
+
+    /**
+     * Associates [value] with [key] and returns the previously associated value,
+     * or `null` if the key was absent. Both must be frozen or permanent objects.
+     *
+     * @throws InvalidMutabilityException if [key] or [value] is not frozen
+     */
+    public fun put(key: K, value: V): V? =
+            @Suppress("UNCHECKED_CAST")
+            (putImpl(map, key, key.hashCode(), value) as V?)
+
+    /**
+     * Removes the entry for [key] and returns the value it held, or `null` if the
+     * key was absent.
+     */
+    public fun remove(key: K): V? =
+            @Suppress("UNCHECKED_CAST")
+            (removeImpl(map, key, key.hashCode()) as V?)
+
+    // Implementation details.
+    companion object {
+        @SymbolName("Kotlin_SharedMap_create")
+        private external fun createMap(initialCapacity: Int): NativePtr
+
+        @SymbolName("Kotlin_SharedMap_dispose")
+        private external fun disposeMap(map: NativePtr)
+
+        @SymbolName("Kotlin_SharedMap_size")
+        private external fun sizeImpl(map: NativePtr): Int
+
+        @SymbolName("Kotlin_SharedMap_get")
+        private external fun getImpl(map: NativePtr, key: Any, keyHash: Int): Any?
+
+        @SymbolName("Kotlin_SharedMap_put")
+        private external fun putImpl(map: NativePtr, key: Any, keyHash: Int, value: Any): Any?
+
+        @SymbolName("Kotlin_SharedMap_remove")
+        private external fun removeImpl(map: NativePtr, key: Any, keyHash: Int): Any?
+    }
+}
+
+@ExportForCppRuntime
+internal fun Kotlin_SharedMap_keysEqual(first: Any?, second: Any?): Boolean = first == second
@@ -23,6 +23,17 @@ import kotlinx.cinterop.*
  * workers as needed.
  */
 
+/**
+ * Priority lane of a job scheduled on a [Worker]. Each worker dispatches [HIGH]
+ * jobs before queued [NORMAL] ones and [NORMAL] before [BULK] ones, letting a
+ * bounded number of lower priority jobs through so that no lane starves completely.
+ */
+public enum class JobPriority(val value: Int) {
+    HIGH(0),
+    NORMAL(1),
+    BULK(2)
+}
+
 /**
  * Class representing worker.
  */
@@ -59,6 +70,47 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
         @Deprecated("Use kotlinx.cinterop.StableRef instead", level = DeprecationLevel.WARNING)
         public fun fromCPointer(pointer: COpaquePointer?): Worker =
                 if (pointer != null) Worker(pointer.toLong().toInt()) else throw IllegalArgumentException()
+
+        /**
+         * Sets the coalescing window for jobs scheduled with [executeAfter], in microseconds.
+         *
+         * Delayed jobs of all workers are dispatched by a single timer thread. With a non-zero
+         * window a job may run up to [windowMicroseconds] later than requested, so that deadlines
+         * close to each other share one wakeup — trading timer accuracy for fewer interrupts,
+         * e.g. on battery-sensitive deployments. The default window is zero.
+         */
+        public fun setDelayedJobsCoalescing(windowMicroseconds: Long) =
+                setDelayedCoalescingInternal(windowMicroseconds)
+
+        /**
+         * Number of processors currently online, for planning worker pool sizes
+         * and [setCpuAffinity] masks. Returns 1 where the query is unsupported.
+         */
+        public val availableProcessors: Int
+            get() = availableProcessorsInternal()
+
+        /**
+         * Sets the stack size, in bytes, for workers started after this call.
+         *
+         * The platform default stack (commonly 8MiB of reserve) is wasteful for pools of
+         * many short-lived workers; a deliberately small stack shrinks their virtual
+         * memory footprint and lets the threading implementation recycle cached stacks
+         * across worker generations, cutting spawn latency. The value is rounded up to
+         * the platform's minimum and page size; zero restores the platform default.
+         *
+         * @throws [IllegalArgumentException] if [bytes] is negative.
+         */
+        public fun setDefaultStackSize(bytes: Int) = setWorkerStackSizeInternal(bytes)
+
+        /**
+         * The number of bytes currently allocated from the calling thread's heap.
+         *
+         * Each worker allocates from a heap of its own, so this attributes memory use to
+         * the worker it is read on - run a small job per worker to profile a pool. Returns
+         * zero on allocators without per-thread heaps (the non-mimalloc variants).
+         */
+        public val localHeapBytes: Long
+            get() = localHeapBytesInternal()
     }
 
     /**
@@ -111,6 +163,47 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
         executeAfterInternal(id, operation, afterMicroseconds)
     }
 
+    /**
+     * Plan job for further execution in the worker at the given [priority]: a latency-critical
+     * job scheduled as [JobPriority.HIGH] is dispatched before queued [JobPriority.NORMAL] and
+     * [JobPriority.BULK] work instead of waiting behind it. A non-zero [deadlineMicroseconds]
+     * is a soft deadline relative to now: a job still queued once it passes is dispatched
+     * ahead of everything, whatever its priority. [operation] parameter must be either frozen,
+     * or execution to be planned on the current worker. Otherwise [IllegalStateException]
+     * will be thrown.
+     *
+     * @param afterMicroseconds defines after how many microseconds delay execution shall happen, 0 means immediately.
+     * @throws [IllegalArgumentException] on negative values of [afterMicroseconds] or [deadlineMicroseconds].
+     * @throws [IllegalStateException] if [operation] parameter is not frozen and worker is not current.
+     */
+    public fun executeAfter(afterMicroseconds: Long, priority: JobPriority,
+                            deadlineMicroseconds: Long = 0, operation: () -> Unit): Unit {
+        val current = currentInternal()
+        if (current != id && !operation.isFrozen) throw IllegalStateException("Job for another worker must be frozen")
+        if (afterMicroseconds < 0) throw IllegalArgumentException("Timeout parameter must be non-negative")
+        if (deadlineMicroseconds < 0) throw IllegalArgumentException("Deadline parameter must be non-negative")
+        executeAfterWithPriorityInternal(id, operation, afterMicroseconds, priority.value, deadlineMicroseconds)
+    }
+
+    /**
+     * Plan the whole batch of jobs for immediate execution in the worker, in the order of
+     * the [operations] array. The batch is enqueued and the worker is woken up once, which
+     * amortizes the per-job queueing cost of [executeAfter] for large numbers of small jobs.
+     * Every operation must be either frozen, or execution must be planned on the current
+     * worker, same as for [executeAfter].
+     *
+     * @throws [IllegalStateException] if some operation is not frozen and worker is not current.
+     */
+    public fun executeBatch(operations: Array<() -> Unit>): Unit {
+        val current = currentInternal()
+        if (current != id) {
+            for (operation in operations) {
+                if (!operation.isFrozen) throw IllegalStateException("Job for another worker must be frozen")
+            }
+        }
+        executeBatchInternal(id, operations)
+    }
+
     /**
      * Process pending job(s) on the queue of this worker.
      * Note that jobs scheduled with [executeAfter] using non-zero timeout are
@@ -122,6 +215,18 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
      */
     public fun processQueue(): Boolean = processQueueInternal(id)
 
+    /**
+     * Cooperative yield point for long-running jobs. If other jobs are pending on this
+     * worker's queue, [continuation] is enqueued behind them, in the lane of the currently
+     * executing job, and `true` is returned: the running job should return promptly, and
+     * the computation effectively resumes when [continuation] is dispatched. If nothing
+     * is pending, nothing is scheduled and `false` is returned, so the caller simply
+     * continues - checkpointing stays free while the worker is not contended.
+     *
+     * @throws [IllegalStateException] if this request is executed on non-current [Worker].
+     */
+    public fun yield(continuation: () -> Unit): Boolean = yieldInternal(id, continuation)
+
     /**
      * Park execution of the current worker until a new request arrives or timeout specified in
      * [timeoutMicroseconds] elapsed. If [process] is true, pending queue elements are processed,
@@ -139,6 +244,50 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
         return parkInternal(id, timeoutMicroseconds, process)
     }
 
+    /**
+     * Returns a file descriptor becoming readable whenever a job is put on this worker's
+     * queue, or -1 on platforms without file descriptors.
+     *
+     * This allows a single thread to multiplex Kotlin jobs and operating system events
+     * without polling: register the descriptor with an external event loop (a `CFRunLoop`
+     * source, `epoll`, `kqueue`, `poll` and the likes) and, whenever it becomes readable,
+     * drain it and call [processQueue] until it returns `false`. Jobs arriving after the
+     * drain write to the descriptor again, so no wakeup is ever lost. The descriptor is
+     * created lazily on first call, stays valid until the worker terminates and must not
+     * be closed by the caller.
+     *
+     * @throws [IllegalStateException] if this request is executed on an invalid worker.
+     */
+    public fun notificationFd(): Int = notificationFdInternal(id)
+
+    /**
+     * Returns a snapshot of this worker's load statistics.
+     *
+     * Element 0 is the total number of jobs enqueued and element 1 the total number of
+     * jobs processed, so their difference is the current queue depth, and deltas between
+     * snapshots give the enqueue and processing rates. The remaining 16 elements form a
+     * time-in-queue histogram: element `2 + i` counts processed jobs that waited less
+     * than `2^i` microseconds, with the last bucket collecting everything above.
+     *
+     * The counters are updated without synchronization, so the snapshot is approximate.
+     *
+     * @throws [IllegalStateException] if this request is executed on an invalid worker.
+     */
+    public fun stats(): LongArray = getWorkerStatsInternal(id)
+
+    /**
+     * Pins this worker's thread to the given CPU indices (as counted by the operating
+     * system, see [availableProcessors]).
+     *
+     * On NUMA machines pinning a worker to the CPUs of a single node also makes its
+     * allocations node-local: runtime allocation is per-thread and the operating system
+     * places memory on first touch. Returns `false` on platforms without hard affinity
+     * (anything but Linux), for workers without an own thread, or if the mask is invalid.
+     *
+     * @throws [IllegalStateException] if this request is executed on an invalid worker.
+     */
+    public fun setCpuAffinity(cpus: IntArray): Boolean = setCpuAffinityInternal(id, cpus)
+
     /**
      * Name of the worker, as specified in [Worker.start] or "worker $id" by default,
      *
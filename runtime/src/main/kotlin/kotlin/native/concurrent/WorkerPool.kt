@@ -0,0 +1,77 @@
+/*
+ * Copyright 2010-2019 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.concurrent
+
+import kotlin.native.internal.VolatileLambda
+
+/**
+ * A fixed-size pool of [Worker]s sharing the load of submitted jobs.
+ *
+ * Unlike a standalone [Worker], whose jobs stay in its own queue, pool members steal pending
+ * jobs from each other, so a burst of submissions is spread over all members automatically.
+ * Jobs scheduled with [Worker.executeAfter] on an individual member, as well as termination
+ * requests, are never stolen and always run on the worker they were submitted to.
+ */
+@Suppress("NON_PUBLIC_PRIMARY_CONSTRUCTOR_OF_INLINE_CLASS")
+public inline class WorkerPool @PublishedApi internal constructor(val id: Int) {
+    companion object {
+        /**
+         * Start new worker pool with [size] members, each being a regular [Worker].
+         *
+         * @param size number of workers in the pool.
+         * @param errorReporting controls if an uncaught exceptions in the pool workers will be printed out.
+         * @return pool object, usable across multiple concurrent contexts.
+         * @throws [IllegalArgumentException] on non-positive [size].
+         */
+        public fun start(size: Int, errorReporting: Boolean = true): WorkerPool {
+            if (size <= 0) throw IllegalArgumentException("Pool size must be positive")
+            return WorkerPool(startPoolInternal(size, errorReporting))
+        }
+    }
+
+    /**
+     * Number of workers currently in the pool. Decreases as members are terminated.
+     *
+     * @throws [IllegalStateException] if the pool is invalid or fully terminated.
+     */
+    public val size: Int
+        get() = poolSizeInternal(id)
+
+    /**
+     * Plan job for further execution in the pool. Semantics is the same as in [Worker.execute],
+     * except that the least loaded pool member is selected for execution, and other idle members
+     * may steal the job before it started.
+     *
+     * @return the future with the computation result of [job].
+     */
+    public fun <T1, T2> execute(mode: TransferMode, producer: () -> T1, @VolatileLambda job: (T1) -> T2): Future<T2> =
+            nextWorker().execute(mode, producer, job)
+
+    /**
+     * Select the pool member next job shall be submitted to, currently the one with the
+     * shortest queue. Can be used to call [Worker.executeAfter] on some pool member.
+     *
+     * @throws [IllegalStateException] if the pool is invalid or fully terminated.
+     */
+    public fun nextWorker(): Worker = Worker(poolScheduleInternal(id))
+
+    /**
+     * Requests termination of all workers in the pool.
+     *
+     * @param processScheduledJobs controls is we shall wait until all scheduled jobs processed,
+     * or terminate members immediately.
+     * @return futures, one per pool member, completed once that member is terminated.
+     */
+    public fun requestTermination(processScheduledJobs: Boolean = true): List<Future<Unit>> {
+        val members = IntArray(size) { poolMemberInternal(id, it) }
+        return members.map { Future<Unit>(requestTerminationInternal(it, processScheduledJobs)) }
+    }
+
+    /**
+     * String representation of the worker pool.
+     */
+    override public fun toString(): String = "Worker pool $id"
+}
@@ -139,6 +139,33 @@ public annotation class CanBePrecreated
 @Target(AnnotationTarget.CLASS)
 internal annotation class HasFinalizer
 
+/**
+ * Marks a class whose instances get cache-line aligned, padded containers: for arrays the
+ * element data itself starts on the boundary, so SIMD kernels see aligned payloads and
+ * adjacent containers don't share a cache line. Best effort - only honoured by allocators
+ * with offset alignment support (mimalloc).
+ */
+@Target(AnnotationTarget.CLASS)
+internal annotation class AlignedPayload
+
+/**
+ * Marks a [Throwable] class whose preallocated frozen instances are thrown for control flow:
+ * the runtime rethrows them without retaining a reference, so a throw costs no allocation
+ * or reference counting. Such classes should also implement [kotlin.native.NoStackTrace]
+ * to skip stack trace capture on construction.
+ */
+@Target(AnnotationTarget.CLASS)
+@PublishedApi internal annotation class ControlFlowException
+
+/**
+ * Marks a function exported to Objective-C/Swift whose bridge checks for an error payload
+ * stored with [setPendingNSError] after a normal return and hands it to the caller as an
+ * `NSError`, without any exception being constructed or thrown. The function must only be
+ * exported with an `NSError` out-parameter, i.e. carry a `@Throws` annotation.
+ */
+@Target(AnnotationTarget.FUNCTION)
+public annotation class ReportsPendingNSError
+
 /**
  * Marks a declaration that is internal for Kotlin/Native and shouldn't be used externally.
  */
@@ -87,6 +87,99 @@ fun <T> createCleaner(argument: T, block: (T) -> Unit): Cleaner {
     return CleanerImpl(cleanPtr).freeze()
 }
 
+/**
+ * A scope for deterministic resource cleanup, see [withCleanerScope].
+ *
+ * Cleanup blocks registered with [cleanable] run when the scope is left, in reverse
+ * registration order, on the thread that owns the scope - without waiting for the
+ * memory manager or the cleaner worker. The scope is confined to the thread that
+ * created it.
+ */
+@ExperimentalStdlibApi
+public class CleanerScope internal constructor(internal val handle: NativePtr) {
+    /**
+     * Registers a cleanup to run with [argument] when the scope is left.
+     *
+     * [argument] and [block] carry the same restrictions as in [createCleaner]:
+     * [argument] must be shareable, [block] must not capture anything and must not
+     * refer back to the returned cleanable.
+     */
+    public fun <T> cleanable(argument: T, block: (T) -> Unit): ScopedCleanable {
+        if (!argument.isShareable())
+            throw IllegalArgumentException("$argument must be shareable")
+
+        val clean = {
+            block(argument)
+        }.freeze()
+
+        return ScopedCleanableImpl(this, attachScopedCleanable(handle, createStablePointer(clean)))
+    }
+}
+
+/**
+ * A cleanup registered in a [CleanerScope].
+ */
+@ExperimentalStdlibApi
+public interface ScopedCleanable {
+    /**
+     * Detaches the cleanup from its scope, so leaving the scope no longer runs it.
+     *
+     * The cleanup falls back to the memory manager instead: the returned [Cleaner]
+     * eventually runs it on the cleaner worker after being deallocated, exactly as
+     * if it was created with [createCleaner]. Must be called at most once, while
+     * the owning scope is still active.
+     */
+    public fun escape(): Cleaner
+}
+
+@ExperimentalStdlibApi
+private class ScopedCleanableImpl(
+        private val scope: CleanerScope,
+        private val entry: NativePtr,
+) : ScopedCleanable {
+    private var detached = false
+
+    override fun escape(): Cleaner {
+        if (detached)
+            throw IllegalStateException("Cleanable already escaped its scope")
+        detached = true
+        // The fallback path disposes through the cleaner worker, same as createCleaner.
+        getCleanerWorker()
+        return CleanerImpl(detachScopedCleanable(scope.handle, entry)).freeze()
+    }
+}
+
+/**
+ * Runs [body] with a fresh [CleanerScope] and releases every cleanup still registered
+ * in it on exit, whether [body] returns or throws.
+ *
+ * This is the deterministic counterpart of [createCleaner] for resources with
+ * stack-like lifetimes (file handles and alike): release happens at a known point
+ * and in bulk, instead of whenever the memory manager gets to the cleaner. Scopes
+ * nest; cleanup blocks that register new cleanables attach them to the parent scope.
+ */
+@ExperimentalStdlibApi
+public fun <R> withCleanerScope(body: (CleanerScope) -> R): R {
+    val scope = CleanerScope(enterCleanerScope())
+    try {
+        return body(scope)
+    } finally {
+        leaveCleanerScope(scope.handle)
+    }
+}
+
+@SymbolName("Kotlin_CleanerScope_enter")
+external private fun enterCleanerScope(): NativePtr
+
+@SymbolName("Kotlin_CleanerScope_leave")
+external private fun leaveCleanerScope(scope: NativePtr)
+
+@SymbolName("Kotlin_CleanerScope_attach")
+external private fun attachScopedCleanable(scope: NativePtr, block: NativePtr): NativePtr
+
+@SymbolName("Kotlin_CleanerScope_detach")
+external private fun detachScopedCleanable(scope: NativePtr, entry: NativePtr): NativePtr
+
 /**
  * Perform GC on a worker that executes Cleaner blocks.
  */
@@ -115,9 +208,39 @@ private fun shutdownCleanerWorker(worker: Worker, executeScheduledCleaners: Bool
 
 @ExportForCppRuntime("Kotlin_CleanerImpl_createCleanerWorker")
 private fun createCleanerWorker(): Worker {
+    // Cleaner blocks are batched on the C++ side and executed by this drain operation,
+    // scheduled as a single job per batch. Register it before the worker is published.
+    registerCleanerDrain(createStablePointer({ drainCleaners() }.freeze()))
     return Worker.start(errorReporting = false, name = "Cleaner worker")
 }
 
+/**
+ * Total number of cleaner blocks scheduled for execution since program start.
+ */
+@InternalForKotlinNative
+fun scheduledCleaners(): Long = getScheduledCleaners()
+
+/**
+ * Number of cleaner blocks scheduled but not yet executed.
+ *
+ * Steady growth of this value means cleaner debt is accumulating: blocks are being
+ * scheduled faster than the cleaner worker runs them.
+ */
+@InternalForKotlinNative
+fun pendingCleaners(): Long = getPendingCleaners()
+
+@SymbolName("Kotlin_CleanerImpl_drainCleaners")
+external private fun drainCleaners()
+
+@SymbolName("Kotlin_CleanerImpl_registerCleanerDrain")
+external private fun registerCleanerDrain(drain: NativePtr)
+
+@SymbolName("Kotlin_CleanerImpl_getScheduledCleaners")
+external private fun getScheduledCleaners(): Long
+
+@SymbolName("Kotlin_CleanerImpl_getPendingCleaners")
+external private fun getPendingCleaners(): Long
+
 @NoReorderFields
 @ExportTypeInfo("theCleanerImplTypeInfo")
 @HasFinalizer
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Flat open-addressing hash map from [Long] keys to [Long] values, backed by native memory.
+ *
+ * Unlike [HashMap], neither keys nor values are boxed and no Kotlin objects are touched per
+ * operation, so lookups and updates carry no allocation and no reference-counting traffic.
+ * The backing store uses SwissTable-style control bytes probed a 16-wide group per step
+ * (one SIMD comparison where available). Any primitive key that embeds into a [Long] -
+ * [Int], [Short], [Char] and friends - can be served through widening.
+ *
+ * This is a storage engine, not a collection: there are no iterators or views, the map must
+ * be explicitly [dispose]d when done (its memory is invisible to the garbage collector),
+ * and an instance must be owned by one thread at a time - operations take no locks. Using
+ * a disposed map traps in a debug runtime and is undefined otherwise.
+ */
+@InternalForKotlinNative
+public class FlatLongMap(initialCapacity: Int = 0) {
+    private var ptr: NativePtr = flatLongMapCreate(initialCapacity)
+
+    public val size: Int
+        get() = flatLongMapSize(ptr)
+
+    /** Associates [value] with [key]; returns `true` if [key] was not present before. */
+    public fun put(key: Long, value: Long): Boolean = flatLongMapPut(ptr, key, value)
+
+    /** Value associated with [key], or [defaultValue] if the key is absent. */
+    public fun get(key: Long, defaultValue: Long): Long = flatLongMapGet(ptr, key, defaultValue)
+
+    public operator fun contains(key: Long): Boolean = flatLongMapContains(ptr, key)
+
+    /** Removes [key]; returns `true` if it was present. */
+    public fun remove(key: Long): Boolean = flatLongMapRemove(ptr, key)
+
+    /** Removes all entries, keeping the current capacity. */
+    public fun clear(): Unit = flatLongMapClear(ptr)
+
+    /** Frees the native storage. The map must not be used afterwards. */
+    public fun dispose() {
+        flatLongMapDispose(ptr)
+        ptr = NativePtr.NULL
+    }
+}
+
+@SymbolName("Kotlin_FlatLongMap_create")
+private external fun flatLongMapCreate(initialCapacity: Int): NativePtr
+
+@SymbolName("Kotlin_FlatLongMap_dispose")
+private external fun flatLongMapDispose(ptr: NativePtr)
+
+@SymbolName("Kotlin_FlatLongMap_size")
+private external fun flatLongMapSize(ptr: NativePtr): Int
+
+@SymbolName("Kotlin_FlatLongMap_put")
+private external fun flatLongMapPut(ptr: NativePtr, key: Long, value: Long): Boolean
+
+@SymbolName("Kotlin_FlatLongMap_get")
+private external fun flatLongMapGet(ptr: NativePtr, key: Long, defaultValue: Long): Long
+
+@SymbolName("Kotlin_FlatLongMap_contains")
+private external fun flatLongMapContains(ptr: NativePtr, key: Long): Boolean
+
+@SymbolName("Kotlin_FlatLongMap_remove")
+private external fun flatLongMapRemove(ptr: NativePtr, key: Long): Boolean
+
+@SymbolName("Kotlin_FlatLongMap_clear")
+private external fun flatLongMapClear(ptr: NativePtr)
@@ -100,6 +100,193 @@ object GC {
         get() = getCyclicCollectorEnabled()
         set(value) = setCyclicCollectorEnabled(value)
 
+    /**
+     * If the concurrent cyclic collector shall finish an analysis invalidated by heavy atomic
+     * reference mutation with a short stop-the-world fixup instead of restarting it over and over.
+     * Bounds collector latency at the cost of briefly blocking atomic reference updates.
+     */
+    var cyclicCollectorFixupEnabled: Boolean
+        get() = getCyclicCollectorFixup()
+        set(value) = setCyclicCollectorFixup(value)
+
+    /**
+     * Number of consecutive cyclic collector passes an externally retained object of
+     * the atomic rootset closure may survive before the leak detector reports it with
+     * its shortest retention path, naming what keeps it alive. Zero (the default)
+     * turns the detector off. Reports are printed to the console as `[leak]` lines.
+     * Requires [cyclicCollectorEnabled].
+     */
+    var leakDetectionCycles: Int
+        get() = getLeakDetectionCycles()
+        set(value) = setLeakDetectionCycles(value)
+
+    /**
+     * If reference count updates of thread-local objects shall be buffered and only
+     * reconciled at safepoints. Trades slightly longer GC pauses for cheaper loads and
+     * stores of locals on the hot path. Only available in the strict memory model.
+     */
+    var deferredReferenceCounting: Boolean
+        get() = getDeferredRefCounting()
+        set(value) = setDeferredRefCounting(value)
+
+    /**
+     * If garbage shall be swept incrementally: non-forced collections then release
+     * dead objects in bounded time slices (roughly half a millisecond each) and
+     * continue at allocation safepoints, instead of pausing for the whole backlog at
+     * once. Explicit [collect] calls still run to completion. Only available in the
+     * strict memory model.
+     */
+    var incremental: Boolean
+        get() = getIncremental()
+        set(value) = setIncremental(value)
+
+    /**
+     * If the adaptive GC pacer is active. When enabled it supersedes [autotune]: after
+     * every collection the thresholds are rescaled from allocation-rate and pause-time
+     * history, so that pauses approach [pauseBudgetMicroseconds] and the heap grows at
+     * most by [heapGrowthFactor] between collections.
+     */
+    var pacerEnabled: Boolean
+        get() = getPacer()
+        set(value) = setPacer(value)
+
+    /**
+     * Pause budget for the adaptive pacer, in microseconds. Only effective together
+     * with [pacerEnabled].
+     */
+    var pauseBudgetMicroseconds: Long
+        get() = getPauseBudget()
+        set(value) = setPauseBudget(value)
+
+    /**
+     * Allowed heap growth between collections for the adaptive pacer. Must be greater
+     * than 1. Only effective together with [pacerEnabled].
+     */
+    var heapGrowthFactor: Double
+        get() = getHeapGrowthFactor()
+        set(value) = setHeapGrowthFactor(value)
+
+    /**
+     * Bytes currently held by arrays big enough to be memory-mapped directly, bypassing
+     * the general allocator. Not included in the regular heap accounting.
+     */
+    val mmappedArraysTotalBytes: Long
+        get() = getMmappedArraysTotalBytes()
+
+    /**
+     * Number of currently live memory-mapped arrays.
+     */
+    val mmappedArraysCount: Int
+        get() = getMmappedArraysCount()
+
+    /**
+     * Of [mmappedArraysTotalBytes], how many bytes live in mappings advised to be backed
+     * by transparent huge pages. Dividing the two gives the hugepage coverage of the
+     * memory-mapped heap. Zero where the OS has no such advice.
+     */
+    val hugePageAdvisedBytes: Long
+        get() = getHugePageAdvisedBytes()
+
+    /**
+     * If freezing deduplicates immutable leaf values. When enabled, each
+     * [freeze][kotlin.native.concurrent.freeze] pass hash-conses strings and immutable
+     * reference-free values in the newly frozen subgraph, so structurally equal values
+     * share one frozen object. Shrinks large frozen snapshots at the cost of a slower
+     * freeze; canonical values are retained for the rest of the process.
+     *
+     * Note that deduplicated values are no longer distinguishable by identity.
+     */
+    var freezeDeduplication: Boolean
+        get() = getFreezeDeduplication()
+        set(value) = setFreezeDeduplication(value)
+
+    /**
+     * Writes a binary heap dump to [path] for offline analysis, streaming every
+     * object reachable from the roots the runtime can enumerate on the calling
+     * thread (its thread-local variables and the collector's candidate queues):
+     * type identities and names, per-object container state, shallow sizes and
+     * the full reference graph, from which retained sizes and dominators can be
+     * computed offline. Returns `false` if the file cannot be written.
+     */
+    @SymbolName("Kotlin_native_internal_GC_dumpHeap")
+    external fun dumpHeap(path: String): Boolean
+
+    /**
+     * If sampled allocation-site profiling is active. When enabled every
+     * [allocationProfilingPeriod]th allocation of a thread captures a compact stack
+     * trace, and allocation counts and bytes are aggregated per call site. At the
+     * default period the overhead is low enough for production use. Captured stacks
+     * rely on frame pointers, so profile binaries built without
+     * `-fomit-frame-pointer`.
+     */
+    var allocationProfilingEnabled: Boolean
+        get() = getAllocationProfiling()
+        set(value) = setAllocationProfiling(value)
+
+    /**
+     * Sampling period of the allocation profiler: every Nth allocation is sampled.
+     * Aggregated values are scaled back by the period, so reported counts and bytes
+     * estimate the real totals. Must be positive; the default is 512.
+     */
+    var allocationProfilingPeriod: Int
+        get() = getAllocationProfilingPeriod()
+        set(value) = setAllocationProfilingPeriod(value)
+
+    /**
+     * Writes the aggregated allocation sites to [path] in the pprof heap profile
+     * text format, suitable for `pprof <binary> <path>`. Returns `false` if the
+     * file cannot be written. Profiling keeps running; the profile accumulates
+     * from the moment [allocationProfilingEnabled] was first set.
+     */
+    @SymbolName("Kotlin_native_internal_GC_dumpAllocationProfile")
+    external fun dumpAllocationProfile(path: String): Boolean
+
+    /**
+     * If structured GC event logging is active. When enabled every collection records
+     * its phases into a fixed-size in-memory ring, readable with [logSnapshot] or
+     * printed by the writer thread started with [startLogWriter]. Recording is
+     * lock-free and cheap enough to keep enabled in production.
+     */
+    var loggingEnabled: Boolean
+        get() = getLogging()
+        set(value) = setLogging(value)
+
+    /**
+     * Returns the most recent GC log events, oldest first, as a flat array of
+     * 7 longs per event: sequence number, phase, GC epoch, start time and duration
+     * (both in microseconds), objects freed, and a phase-specific detail value.
+     * Events overwritten concurrently are skipped.
+     */
+    @SymbolName("Kotlin_native_internal_GC_logSnapshot")
+    external fun logSnapshot(): LongArray
+
+    /**
+     * Starts a background thread printing every GC log event to the console,
+     * draining the log every [periodMicroseconds]. Returns `false` if a writer
+     * is already running or threads are unavailable on this platform.
+     */
+    @SymbolName("Kotlin_native_internal_GC_startLogWriter")
+    external fun startLogWriter(periodMicroseconds: Long): Boolean
+
+    /**
+     * Serializes the frozen subgraph reachable from [root] into a relocatable file
+     * that sibling processes running the same binary can load with [mapHeapSegment].
+     * All objects reachable from [root] must be frozen. Returns `false` if the
+     * subgraph contains mutable state or the file cannot be written.
+     */
+    @SymbolName("Kotlin_native_internal_GC_writeHeapSegment")
+    external fun writeHeapSegment(root: Any, path: String): Boolean
+
+    /**
+     * Maps a file written by [writeHeapSegment] as a read-only segment of permanent
+     * objects and returns its root, or `null` if the file cannot be mapped. The pages
+     * are shared between all processes mapping the same file, and the segment stays
+     * mapped until process exit. Only works in processes running the same binary
+     * that wrote the segment.
+     */
+    @SymbolName("Kotlin_native_internal_GC_mapHeapSegment")
+    external fun mapHeapSegment(path: String): Any?
+
     /**
      * Detect cyclic references going via atomic references and return list of cycle-inducing objects
      * or `null` if the leak detector is not available. Use [Platform.isMemoryLeakCheckerActive] to check
@@ -132,15 +319,90 @@ object GC {
     @SymbolName("Kotlin_native_internal_GC_setThresholdAllocations")
     private external fun setThresholdAllocations(value: Long)
 
+    @SymbolName("Kotlin_native_internal_GC_getIncremental")
+    private external fun getIncremental(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setIncremental")
+    private external fun setIncremental(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getPacer")
+    private external fun getPacer(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setPacer")
+    private external fun setPacer(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getPauseBudget")
+    private external fun getPauseBudget(): Long
+
+    @SymbolName("Kotlin_native_internal_GC_setPauseBudget")
+    private external fun setPauseBudget(value: Long)
+
+    @SymbolName("Kotlin_native_internal_GC_getHeapGrowthFactor")
+    private external fun getHeapGrowthFactor(): Double
+
+    @SymbolName("Kotlin_native_internal_GC_setHeapGrowthFactor")
+    private external fun setHeapGrowthFactor(value: Double)
+
+    @SymbolName("Kotlin_native_internal_GC_getMmappedArraysTotalBytes")
+    private external fun getMmappedArraysTotalBytes(): Long
+
+    @SymbolName("Kotlin_native_internal_GC_getMmappedArraysCount")
+    private external fun getMmappedArraysCount(): Int
+
+    @SymbolName("Kotlin_native_internal_GC_getHugePageAdvisedBytes")
+    private external fun getHugePageAdvisedBytes(): Long
+
     @SymbolName("Kotlin_native_internal_GC_getTuneThreshold")
     private external fun getTuneThreshold(): Boolean
 
     @SymbolName("Kotlin_native_internal_GC_setTuneThreshold")
     private external fun setTuneThreshold(value: Boolean)
 
+    @SymbolName("Kotlin_native_internal_GC_getDeferredRefCounting")
+    private external fun getDeferredRefCounting(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setDeferredRefCounting")
+    private external fun setDeferredRefCounting(value: Boolean)
+
     @SymbolName("Kotlin_native_internal_GC_getCyclicCollector")
     private external fun getCyclicCollectorEnabled(): Boolean
 
     @SymbolName("Kotlin_native_internal_GC_setCyclicCollector")
     private external fun setCyclicCollectorEnabled(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getCyclicCollectorFixup")
+    private external fun getCyclicCollectorFixup(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setCyclicCollectorFixup")
+    private external fun setCyclicCollectorFixup(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getLeakDetectionCycles")
+    private external fun getLeakDetectionCycles(): Int
+
+    @SymbolName("Kotlin_native_internal_GC_setLeakDetectionCycles")
+    private external fun setLeakDetectionCycles(value: Int)
+
+    @SymbolName("Kotlin_native_internal_GC_getFreezeDeduplication")
+    private external fun getFreezeDeduplication(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setFreezeDeduplication")
+    private external fun setFreezeDeduplication(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getAllocationProfiling")
+    private external fun getAllocationProfiling(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setAllocationProfiling")
+    private external fun setAllocationProfiling(value: Boolean)
+
+    @SymbolName("Kotlin_native_internal_GC_getAllocationProfilingPeriod")
+    private external fun getAllocationProfilingPeriod(): Int
+
+    @SymbolName("Kotlin_native_internal_GC_setAllocationProfilingPeriod")
+    private external fun setAllocationProfilingPeriod(value: Int)
+
+    @SymbolName("Kotlin_native_internal_GC_getLogging")
+    private external fun getLogging(): Boolean
+
+    @SymbolName("Kotlin_native_internal_GC_setLogging")
+    private external fun setLogging(value: Boolean)
 }
@@ -37,7 +37,7 @@ class NumberConverter {
 
     private var firstK: Int = 0
 
-    private fun convertDouble(inputNumber: Double): String {
+    private fun convertDoubleInto(array: CharArray, offset: Int, inputNumber: Double): Int {
         val p = 1023 + 52 // The power offset (precision).
         @Suppress("INTEGER_OVERFLOW")
         val signMask = 0x7FFFFFFFFFFFFFFFL + 1 // The mask to get the sign of.
@@ -48,7 +48,10 @@ class NumberConverter {
         // Bits.
         val inputNumberBits = inputNumber.bits()
         // The value of the sign... 0 is positive, ~0 is negative.
-        val signString = if (inputNumberBits and signMask == 0L) "" else "-"
+        val negative = inputNumberBits and signMask != 0L
+        // The position the next character is to be inserted into array.
+        var pos = offset
+        if (negative) array[pos++] = '-'
         // The value of the 'power bits' of the inputNumber.
         val e = (inputNumberBits and eMask shr 52).toInt()
         // The value of the 'significand bits' of the inputNumber.
@@ -57,14 +60,17 @@ class NumberConverter {
         var pow: Int
         var numBits = 52
 
-        if (e == 2047)
-            return if (mantissaIsZero) signString + "Infinity" else "NaN"
+        if (e == 2047) {
+            // NaN carries no sign: overwrite the '-' possibly emitted above.
+            return if (mantissaIsZero) pos - offset + insertString(array, pos, "Infinity")
+                   else insertString(array, offset, "NaN")
+        }
         if (e == 0) {
             if (mantissaIsZero)
-                return signString + "0.0"
+                return pos - offset + insertString(array, pos, "0.0")
             if (f == 1L)
             // Special case to increase precision even though 2 * Double.MIN_VALUE is 1.0e-323.
-                return signString + "4.9E-324"
+                return pos - offset + insertString(array, pos, "4.9E-324")
             pow = 1 - p // A denormalized number.
             var ff = f
             while (ff and 0x0010000000000000L == 0L) {
@@ -85,12 +91,12 @@ class NumberConverter {
 
         if (inputNumber >= 1e7 || inputNumber <= -1e7
                 || inputNumber > -1e-3 && inputNumber < 1e-3)
-            return signString + freeFormatExponential()
+            return pos - offset + freeFormatExponentialInto(array, pos)
 
-        return signString + freeFormat()
+        return pos - offset + freeFormatInto(array, pos)
     }
 
-    private fun convertFloat(inputNumber: Float): String {
+    private fun convertFloatInto(array: CharArray, offset: Int, inputNumber: Float): Int {
         val p = 127 + 23 // The power offset (precision).
         @Suppress("INTEGER_OVERFLOW")
         val signMask = 0x7FFFFFFF + 1 // The mask to get the sign of the number.
@@ -99,7 +105,10 @@ class NumberConverter {
 
         val inputNumberBits = inputNumber.bits()
         // The value of the sign... 0 is positive, ~0 is negative.
-        val signString = if (inputNumberBits and signMask == 0) "" else "-"
+        val negative = inputNumberBits and signMask != 0
+        // The position the next character is to be inserted into array.
+        var pos = offset
+        if (negative) array[pos++] = '-'
         // The value of the 'power bits' of the inputNumber.
         val e = inputNumberBits and eMask shr 23
         // The value of the 'significand bits' of the inputNumber.
@@ -108,11 +117,14 @@ class NumberConverter {
         var pow: Int
         var numBits = 23
 
-        if (e == 255)
-            return if (mantissaIsZero) signString + "Infinity" else "NaN"
+        if (e == 255) {
+            // NaN carries no sign: overwrite the '-' possibly emitted above.
+            return if (mantissaIsZero) pos - offset + insertString(array, pos, "Infinity")
+                   else insertString(array, offset, "NaN")
+        }
         if (e == 0) {
             if (mantissaIsZero)
-                return signString + "0.0"
+                return pos - offset + insertString(array, pos, "0.0")
             pow = 1 - p // A denormalized number.
             if (f < 8) { // Want more precision with smallest values.
                 f = f shl 2
@@ -136,18 +148,17 @@ class NumberConverter {
             bigIntDigitGeneratorInstImpl(f.toLong(), pow, e == 0, mantissaIsZero, numBits)
         if (inputNumber >= 1e7f || inputNumber <= -1e7f
                 || inputNumber > -1e-3f && inputNumber < 1e-3f)
-            return signString + freeFormatExponential()
+            return pos - offset + freeFormatExponentialInto(array, pos)
 
-        return signString + freeFormat()
+        return pos - offset + freeFormatInto(array, pos)
     }
 
-    private fun freeFormatExponential(): String {
+    private fun freeFormatExponentialInto(array: CharArray, offset: Int): Int {
         // Corresponds to process "Free-Format Exponential".
-        val formattedDecimal = CharArray(25)
-        formattedDecimal[0] = ('0' + uArray[getCount++])
-        formattedDecimal[1] = '.'
-        // The position the next character is to be inserted into formattedDecimal.
-        var charPos = 2
+        array[offset] = ('0' + uArray[getCount++])
+        array[offset + 1] = '.'
+        // The position the next character is to be inserted into array.
+        var charPos = offset + 2
 
         var k = firstK
         val expt = k
@@ -156,43 +167,43 @@ class NumberConverter {
             if (getCount >= setCount)
                 break
 
-            formattedDecimal[charPos++] = ('0' + uArray[getCount++])
+            array[charPos++] = ('0' + uArray[getCount++])
         }
 
         if (k == expt - 1)
-            formattedDecimal[charPos++] = '0'
-        formattedDecimal[charPos++] = 'E'
-        return unsafeStringFromCharArray(formattedDecimal, 0, charPos) + expt.toString()
+            array[charPos++] = '0'
+        array[charPos++] = 'E'
+        charPos += insertInt(array, charPos, expt)
+        return charPos - offset
     }
 
-    private fun freeFormat(): String {
+    private fun freeFormatInto(array: CharArray, offset: Int): Int {
         // Corresponds to process "Free-Format".
-        val formattedDecimal = CharArray(25)
-        // The position the next character is to be inserted into formattedDecimal.
-        var charPos = 0
+        // The position the next character is to be inserted into array.
+        var charPos = offset
         var k = firstK
         if (k < 0) {
-            formattedDecimal[0] = '0'
-            formattedDecimal[1] = '.'
+            array[offset] = '0'
+            array[offset + 1] = '.'
             charPos += 2
             for (i in k + 1 .. -1)
-                formattedDecimal[charPos++] = '0'
+                array[charPos++] = '0'
         }
 
         var u = uArray[getCount++]
         do {
             if (u != -1)
-                formattedDecimal[charPos++] = ('0' + u)
+                array[charPos++] = ('0' + u)
             else if (k >= -1)
-                formattedDecimal[charPos++] = '0'
+                array[charPos++] = '0'
 
             if (k == 0)
-                formattedDecimal[charPos++] = '.'
+                array[charPos++] = '.'
 
             k--
             u = if (getCount < setCount) uArray[getCount++] else -1
         } while (u != -1 || k >= -1)
-        return unsafeStringFromCharArray(formattedDecimal, 0, charPos)
+        return charPos - offset
     }
 
     private fun bigIntDigitGeneratorInstImpl(f: Long, e: Int,
@@ -304,12 +315,31 @@ class NumberConverter {
         private val converter: NumberConverter
             get() = NumberConverter()
 
+        // Worst case: sign, free-format digits (bounded by 25 as in the original
+        // Harmony code) and the exponent of the exponential form.
+        internal const val MAX_CHARS = 32
+
         fun convert(input: Double): String {
-            return converter.convertDouble(input)
+            val buffer = CharArray(MAX_CHARS)
+            val length = converter.convertDoubleInto(buffer, 0, input)
+            return unsafeStringFromCharArray(buffer, 0, length)
         }
 
         fun convert(input: Float): String {
-            return converter.convertFloat(input)
+            val buffer = CharArray(MAX_CHARS)
+            val length = converter.convertFloatInto(buffer, 0, input)
+            return unsafeStringFromCharArray(buffer, 0, length)
         }
+
+        /**
+         * Writes the string representation of [input] into [array] starting at [offset]
+         * and returns the number of characters written. The caller must reserve at least
+         * [MAX_CHARS] characters of room.
+         */
+        fun convertInto(array: CharArray, offset: Int, input: Double): Int =
+                converter.convertDoubleInto(array, offset, input)
+
+        fun convertInto(array: CharArray, offset: Int, input: Float): Int =
+                converter.convertFloatInto(array, offset, input)
     }
 }
\ No newline at end of file
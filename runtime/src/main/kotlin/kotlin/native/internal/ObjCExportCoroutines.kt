@@ -14,15 +14,67 @@ import kotlin.native.concurrent.*
 private fun Kotlin_ObjCExport_createContinuationArgumentImpl(
         completionHolder: Any,
         exceptionTypes: NativePtr
-): Continuation<Any?> = createContinuationArgumentFromCallback(EmptyCompletion) { result ->
-    result.fold(
-            onSuccess = { value ->
-                runCompletionSuccess(completionHolder, value)
-            },
-            onFailure = { exception ->
-                runCompletionFailure(completionHolder, exception, exceptionTypes)
-            }
-    )
+): Continuation<Any?> {
+    val pool = completionContinuationPool
+    val continuation = if (pool.isEmpty()) ObjCCompletionContinuation() else pool.removeAt(pool.size - 1)
+    continuation.prepare(completionHolder, exceptionTypes)
+    return continuation
+}
+
+private const val completionContinuationPoolSize = 8
+
+// [Kotlin_ObjCExport_createContinuationArgument] allows calling Kotlin suspend functions
+// from Objective-C on main thread only, so the pool used on the allocation path is effectively
+// single-threaded. Completions resumed on other threads just recycle into those threads' pools.
+@ThreadLocal
+private val completionContinuationPool = ArrayList<ObjCCompletionContinuation>(completionContinuationPoolSize)
+
+/**
+ * Reusable continuation passed to Kotlin suspend functions called from Objective-C.
+ *
+ * When resumed, it invokes the Objective-C completion handler (kept alive by [completionHolder])
+ * and returns itself to [completionContinuationPool], so repeated suspend calls don't allocate
+ * a fresh continuation each time.
+ */
+@Suppress("UNCHECKED_CAST")
+private class ObjCCompletionContinuation : ContinuationImpl(EmptyCompletion as Continuation<Any?>) {
+    private var completionHolder: Any? = null
+    private var exceptionTypes: NativePtr = NativePtr.NULL
+
+    fun prepare(completionHolder: Any, exceptionTypes: NativePtr) {
+        this.completionHolder = completionHolder
+        this.exceptionTypes = exceptionTypes
+    }
+
+    override fun invokeSuspend(result: Result<Any?>): Any? {
+        val completionHolder = this.completionHolder ?: error("This coroutine had already completed")
+        val exceptionTypes = this.exceptionTypes
+        this.completionHolder = null
+        this.exceptionTypes = NativePtr.NULL
+        result.fold(
+                onSuccess = { value ->
+                    runCompletionSuccess(completionHolder, value)
+                },
+                onFailure = { exception ->
+                    runCompletionFailure(completionHolder, exception, exceptionTypes)
+                }
+        )
+        recycle()
+        return Unit
+    }
+
+    override fun releaseIntercepted() {
+        // [EmptyCompletion] has [EmptyCoroutineContext], so there is no interceptor to release;
+        // the default implementation would mark the instance completed and make it single-use.
+    }
+
+    private fun recycle() {
+        if (this.isFrozen) return // [prepare] wouldn't be able to reinitialize it.
+        val pool = completionContinuationPool
+        if (pool.size < completionContinuationPoolSize) {
+            pool.add(this)
+        }
+    }
 }
 
 private object EmptyCompletion : Continuation<Any?> {
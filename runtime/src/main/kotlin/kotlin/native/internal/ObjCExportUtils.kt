@@ -5,6 +5,7 @@
 
 package kotlin.native.internal
 
+import kotlin.native.concurrent.isFrozen
 import kotlin.native.internal.ExportForCppRuntime
 import kotlin.native.internal.KonanSet
 import kotlin.native.internal.ReportUnhandledException
@@ -20,11 +21,27 @@ internal class NSArrayAsKList : AbstractList<Any?>(), ObjCObjectWrapper {
 
     override val size: Int get() = getSize()
 
+    // The underlying NSArray is used as immutable here, so an index always bridges to the
+    // same element, and converted elements can be memoized. The map is sparse on purpose:
+    // callers receiving large arrays typically read only a few entries.
+    private var memoizedElements: HashMap<Int, Any?>? = null
+
     @SymbolName("Kotlin_NSArrayAsKList_getSize")
     private external fun getSize(): Int
 
     @SymbolName("Kotlin_NSArrayAsKList_get")
-    external override fun get(index: Int): Any?
+    private external fun getElement(index: Int): Any?
+
+    override fun get(index: Int): Any? {
+        if (this.isFrozen) return getElement(index)
+
+        val cache = memoizedElements ?: HashMap<Int, Any?>().also { memoizedElements = it }
+        if (cache.containsKey(index)) return cache[index]
+
+        val element = getElement(index)
+        cache[index] = element
+        return element
+    }
 }
 
 internal class NSMutableArrayAsKMutableList : AbstractMutableList<Any?>(), ObjCObjectWrapper {
@@ -99,8 +116,23 @@ internal class NSDictionaryAsKMap : Map<Any?, Any?>, ObjCObjectWrapper {
     @SymbolName("Kotlin_NSDictionaryAsKMap_containsValue")
     override external fun containsValue(value: Any?): Boolean
 
+    // Same memoization as in [NSArrayAsKList]: the dictionary is used as immutable,
+    // so a key always bridges to the same value.
+    private var memoizedValues: HashMap<Any?, Any?>? = null
+
     @SymbolName("Kotlin_NSDictionaryAsKMap_get")
-    external override operator fun get(key: Any?): Any?
+    private external fun getValue(key: Any?): Any?
+
+    override operator fun get(key: Any?): Any? {
+        if (this.isFrozen) return getValue(key)
+
+        val cache = memoizedValues ?: HashMap<Any?, Any?>().also { memoizedValues = it }
+        if (cache.containsKey(key)) return cache[key]
+
+        val value = getValue(key)
+        cache[key] = value
+        return value
+    }
 
     @SymbolName("Kotlin_NSDictionaryAsKMap_getOrThrowConcurrentModification")
     private external fun getOrThrowConcurrentModification(key: Any?): Any?
@@ -283,6 +315,15 @@ class ObjCErrorException(
 @ExportForCppRuntime
 internal external fun trapOnUndeclaredException(exception: Throwable)
 
+/**
+ * Reports an expected failure to the Objective-C/Swift caller of the current function without
+ * throwing: [code] and [message] bridge straight to the `NSError` out-parameter when the
+ * function returns. Only effective inside a function annotated with [ReportsPendingNSError];
+ * the function is still responsible for returning its failure value (`nil`/`false`/zero).
+ */
+@SymbolName("Kotlin_ObjCExport_setPendingNSError")
+public external fun setPendingNSError(code: Int, message: String?)
+
 @ExportForCppRuntime
 private fun Kotlin_Throwable_getMessage(throwable: Throwable): String? = throwable.message
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Always-on event counters maintained by the runtime on its hot paths: allocations
+ * by size class, atomic reference count traffic, GC pauses, worker queue activity
+ * and string conversions. Each counter costs a single relaxed increment, so reading
+ * them is safe in production; values may lag concurrent writers by a few events.
+ */
+@InternalForKotlinNative
+object RuntimeCounters {
+    /**
+     * Number of counters maintained by this runtime.
+     */
+    val count: Int
+        get() = countersCount()
+
+    /**
+     * Stable name of the counter at [index], also used as its JSON key.
+     */
+    fun name(index: Int): String = counterName(index)
+
+    /**
+     * Current value of the counter at [index].
+     */
+    fun value(index: Int): Long = counterValue(index)
+
+    /**
+     * All counters as a single-line JSON object, e.g. `{"gc_count":3,...}`.
+     */
+    fun dumpJson(): String = countersJson()
+
+    @SymbolName("Kotlin_native_internal_runtimeCountersCount")
+    private external fun countersCount(): Int
+
+    @SymbolName("Kotlin_native_internal_runtimeCounterName")
+    private external fun counterName(index: Int): String
+
+    @SymbolName("Kotlin_native_internal_runtimeCounterValue")
+    private external fun counterValue(index: Int): Long
+
+    @SymbolName("Kotlin_native_internal_runtimeCountersJson")
+    private external fun countersJson(): String
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2010-2021 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Incremental UTF-8 decoder: feed byte chunks as they arrive and get the decoded characters
+ * back per chunk, without buffering the whole input first.
+ *
+ * A codepoint split across a chunk boundary is carried over and completed by the next chunk,
+ * so chunks may be cut anywhere - mid-sequence included. Invalid input turns into the Unicode
+ * replacement character, matching [ByteArray.stringFromUtf8]. Call [flush] after the last
+ * chunk to surface a trailing unfinished sequence.
+ *
+ * The decoder holds native state and must be explicitly [dispose]d; an instance must be owned
+ * by one thread at a time.
+ */
+@InternalForKotlinNative
+public class Utf8StreamDecoder {
+    private var ptr: NativePtr = utf8StreamDecoderCreate()
+
+    /** Decodes [size] bytes of [chunk] starting at [start], returning the completed characters. */
+    public fun decode(chunk: ByteArray, start: Int = 0, size: Int = chunk.size - start): String {
+        if (start < 0 || size < 0 || start + size > chunk.size) throw IndexOutOfBoundsException()
+        return utf8StreamDecoderDecode(ptr, chunk, start, size)
+    }
+
+    /** Ends the input: a pending unfinished sequence becomes one replacement character. */
+    public fun flush(): String = utf8StreamDecoderFlush(ptr)
+
+    /** Frees the native state. The decoder must not be used afterwards. */
+    public fun dispose() {
+        utf8StreamDecoderDispose(ptr)
+        ptr = NativePtr.NULL
+    }
+}
+
+@SymbolName("Kotlin_Utf8StreamDecoder_create")
+private external fun utf8StreamDecoderCreate(): NativePtr
+
+@SymbolName("Kotlin_Utf8StreamDecoder_dispose")
+private external fun utf8StreamDecoderDispose(ptr: NativePtr)
+
+@SymbolName("Kotlin_Utf8StreamDecoder_decode")
+private external fun utf8StreamDecoderDecode(ptr: NativePtr, chunk: ByteArray, start: Int, size: Int): String
+
+@SymbolName("Kotlin_Utf8StreamDecoder_flush")
+private external fun utf8StreamDecoderFlush(ptr: NativePtr): String
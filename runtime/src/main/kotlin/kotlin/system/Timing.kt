@@ -26,6 +26,14 @@ public external fun getTimeNanos() : Long
 @SymbolName("Kotlin_system_getTimeMicros")
 public external fun getTimeMicros() : Long
 
+/**
+ * Coarse variant of [getTimeNanos]: accurate only to about a millisecond, but
+ * considerably cheaper to read. Intended for call sites taking timestamps far
+ * more often than they need precision, e.g. tracing (Kotlin/Native only).
+ */
+@SymbolName("Kotlin_system_getTimeNanosCoarse")
+public external fun getTimeNanosCoarse() : Long
+
 /** Executes the given [block] and returns elapsed time in milliseconds. */
 public inline fun measureTimeMillis(block: () -> Unit) : Long {
     val start = getTimeMillis()
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.text
+
+// Region counterparts of the String runtime operations, for char-array backed
+// CharSequence implementations such as [StringBuilder]: comparing, hashing and
+// searching a region directly avoids copying it out into a temporary string.
+
+@SymbolName("Kotlin_CharArray_regionCompareTo")
+internal external fun regionCompareTo(array: CharArray, offset: Int, length: Int,
+                                      other: CharArray, otherOffset: Int, otherLength: Int): Int
+
+/** Matches the hash of the string materialized from the region, like [regionHashCode] for strings. */
+@SymbolName("Kotlin_CharArray_regionHashCode")
+internal external fun regionHashCode(array: CharArray, offset: Int, length: Int): Int
+
+@SymbolName("Kotlin_CharArray_regionIndexOf")
+internal external fun regionIndexOf(array: CharArray, offset: Int, length: Int,
+                                    needle: CharArray, needleOffset: Int, needleLength: Int,
+                                    fromIndex: Int): Int
+
+/** The runtime accepts a [String] needle directly: strings and char arrays share their layout. */
+@SymbolName("Kotlin_CharArray_regionIndexOf")
+internal external fun regionIndexOf(array: CharArray, offset: Int, length: Int,
+                                    needle: String, needleOffset: Int, needleLength: Int,
+                                    fromIndex: Int): Int
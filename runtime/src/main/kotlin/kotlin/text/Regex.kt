@@ -5,6 +5,8 @@
 
 package kotlin.text
 
+import kotlin.native.concurrent.ThreadLocal
+import kotlin.native.concurrent.isFrozen
 import kotlin.text.regex.*
 
 @PublishedApi
@@ -66,6 +68,38 @@ public actual enum class RegexOption(override val value: Int, override val mask:
  */
 public actual data class MatchGroup(actual val value: String, val range: IntRange)
 
+/**
+ * Per-thread cache of compiled patterns.
+ *
+ * A `Regex` literal in source compiles to a plain constructor call, so a pattern sitting in
+ * a loop or a frequently called function is re-parsed and re-compiled on every evaluation.
+ * Compiled [Pattern] programs are immutable apart from match-time scratch in the
+ * decomposed-char sets, so constructing a [Regex] for an already seen pattern becomes
+ * a map lookup instead of a parse.
+ *
+ * Patterns with scratch-bearing sets cannot be shared at all: freezing one `Regex` would
+ * freeze the aliased [Pattern] and make every other instance built from the same cache
+ * entry throw on its next match. Such sets only come from [Pattern.CANON_EQ] decomposition,
+ * so canonical-equivalence patterns bypass the cache and get a private [Pattern] each.
+ */
+@ThreadLocal
+private object PatternCache {
+    private const val CAPACITY = 64
+    private val patterns = HashMap<String, Pattern>()
+
+    fun compile(pattern: String, flags: Int): Pattern {
+        if ((flags and Pattern.CANON_EQ) != 0) return Pattern(pattern, flags)
+        val key = "$flags:$pattern"
+        // A frozen entry is abandoned, so that future instances stay freezable
+        // independently of the already frozen ones.
+        patterns[key]?.takeIf { !it.isFrozen }?.let { return it }
+        if (patterns.size >= CAPACITY) patterns.clear()
+        val compiled = Pattern(pattern, flags)
+        patterns[key] = compiled
+        return compiled
+    }
+}
+
 /**
  * Represents a compiled regular expression.
  * Provides functions to match strings in text with a pattern, replace the found occurrences and split text around matches.
@@ -77,13 +111,13 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
     }
 
     /** Creates a regular expression from the specified [pattern] string and the default options.  */
-    actual constructor(pattern: String): this(Pattern(pattern))
+    actual constructor(pattern: String): this(PatternCache.compile(pattern, 0))
 
     /** Creates a regular expression from the specified [pattern] string and the specified single [option].  */
-    actual constructor(pattern: String, option: RegexOption): this(Pattern(pattern, ensureUnicodeCase(option.value)))
+    actual constructor(pattern: String, option: RegexOption): this(PatternCache.compile(pattern, ensureUnicodeCase(option.value)))
 
     /** Creates a regular expression from the specified [pattern] string and the specified set of [options].  */
-    actual constructor(pattern: String, options: Set<RegexOption>): this(Pattern(pattern, ensureUnicodeCase(options.toInt())))
+    actual constructor(pattern: String, options: Set<RegexOption>): this(PatternCache.compile(pattern, ensureUnicodeCase(options.toInt())))
 
 
     /** The pattern string of this regular expression. */
@@ -92,6 +126,21 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
 
     private val startNode = nativePattern.startNode
 
+    /**
+     * Lazy-DFA engine for boolean questions; `null` when the pattern needs backtracking.
+     * Its transition cache grows at match time, so it is unusable once this regex is
+     * frozen and shared between threads — [dfaOrNull] falls back in that case.
+     */
+    private val dfa = DfaMatcher.compile(nativePattern.pattern, nativePattern.flags)
+
+    private fun dfaOrNull(): DfaMatcher? = if (dfa != null && !dfa.isFrozen) dfa else null
+
+    /**
+     * Characters a match must start with, used by [find] to skip positions where no
+     * match can begin instead of invoking the matcher at every index.
+     */
+    private val findPrefilter = dfa?.findPrefilter()
+
     /** The set of options that were used to create this regular expression.  */
     actual val options: Set<RegexOption> = fromInt(nativePattern.flags)
 
@@ -145,10 +194,16 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
     }
 
     /** Indicates whether the regular expression matches the entire [input]. */
-    actual infix fun matches(input: CharSequence): Boolean = doMatch(input, Mode.MATCH) != null
+    actual infix fun matches(input: CharSequence): Boolean {
+        dfaOrNull()?.matches(input)?.let { return it }
+        return doMatch(input, Mode.MATCH) != null
+    }
 
     /** Indicates whether the regular expression can find at least one match in the specified [input]. */
-    actual fun containsMatchIn(input: CharSequence): Boolean = find(input) != null
+    actual fun containsMatchIn(input: CharSequence): Boolean {
+        dfaOrNull()?.containsMatchIn(input)?.let { return it }
+        return find(input) != null
+    }
 
     /**
      * Returns the first match of a regular expression in the [input], beginning at the specified [startIndex].
@@ -164,6 +219,23 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
         val matchResult = MatchResultImpl(input, this)
         matchResult.mode = Mode.FIND
         matchResult.startIndex = startIndex
+        val prefilter = findPrefilter
+        if (prefilter != null) {
+            // Skip scan: only attempt the matcher where a match can actually start.
+            var index = startIndex
+            while (index <= input.length) {
+                index = prefilter.nextCandidate(input, index)
+                if (index < 0) {
+                    return null
+                }
+                if (startNode.matches(index, input, matchResult) >= 0) {
+                    matchResult.finalizeMatch()
+                    return matchResult
+                }
+                index++
+            }
+            return null
+        }
         val foundIndex = startNode.find(startIndex, input, matchResult)
         if (foundIndex >= 0) {
             matchResult.finalizeMatch()
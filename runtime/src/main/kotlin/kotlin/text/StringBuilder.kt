@@ -5,6 +5,9 @@
 
 package kotlin.text
 
+import kotlin.native.concurrent.isFrozen
+import kotlin.native.internal.NumberConverter
+
 /**
  * A mutable sequence of characters.
  *
@@ -151,18 +154,29 @@ actual class StringBuilder private constructor (
      * The overall effect is exactly as if the [value] were converted to a string by the `value.toString()` method,
      * and then that string was appended to this string builder.
      */
-    // TODO: optimize those!
     actual fun append(value: Boolean): StringBuilder = append(value.toString())
-    fun append(value: Byte): StringBuilder = append(value.toString())
-    fun append(value: Short): StringBuilder = append(value.toString())
+    fun append(value: Byte): StringBuilder = append(value.toInt())
+    fun append(value: Short): StringBuilder = append(value.toInt())
     fun append(value: Int): StringBuilder {
         ensureExtraCapacity(11)
         _length += insertInt(array, _length, value)
         return this
     }
-    fun append(value: Long): StringBuilder = append(value.toString())
-    fun append(value: Float): StringBuilder = append(value.toString())
-    fun append(value: Double): StringBuilder = append(value.toString())
+    fun append(value: Long): StringBuilder {
+        ensureExtraCapacity(20)
+        _length += insertLong(array, _length, value)
+        return this
+    }
+    fun append(value: Float): StringBuilder {
+        ensureExtraCapacity(NumberConverter.MAX_CHARS)
+        _length += NumberConverter.convertInto(array, _length, value)
+        return this
+    }
+    fun append(value: Double): StringBuilder {
+        ensureExtraCapacity(NumberConverter.MAX_CHARS)
+        _length += NumberConverter.convertInto(array, _length, value)
+        return this
+    }
 
     /**
      * Appends characters in the specified character array [value] to this string builder and returns this instance.
@@ -415,7 +429,29 @@ actual class StringBuilder private constructor (
             array = array.copyOf(_length)
     }
 
-    override fun toString(): String = unsafeStringFromCharArray(array, 0, _length)
+    override fun toString(): String {
+        if (_length > 0 && _length == array.size && !isFrozen) {
+            // Exact-sized builder, the dominant pattern when the result length is known
+            // upfront: hand the backing array over to the string instead of copying it.
+            // Dropping the reference here leaves the string as the single owner of the
+            // storage; a builder reused after toString() starts from a fresh allocation.
+            val result = unsafeStringHandoffCharArray(array)
+            array = CharArray(0)
+            return result
+        }
+        return unsafeStringFromCharArray(array, 0, _length)
+    }
+
+    /** Compares the contents with [other] lexicographically, without materializing either side. */
+    internal fun contentCompareTo(other: StringBuilder): Int =
+            regionCompareTo(array, 0, _length, other.array, 0, other._length)
+
+    /** Hashes as the built string would, so a builder and its [toString] agree on hash buckets. */
+    internal fun contentHashCode(): Int = regionHashCode(array, 0, _length)
+
+    /** Returns the index of the first occurrence of [string] at or after [fromIndex], or `-1`. */
+    internal fun indexOf(string: String, fromIndex: Int = 0): Int =
+            regionIndexOf(array, 0, _length, string, 0, string.length, fromIndex)
 
     /**
      * Sets the character at the specified [index] to the specified [value].
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.text
+
+/**
+ * A copy-free view of a character range of a [String], returned by [String.subSequence].
+ *
+ * Strings are immutable (and frozen by construction), so a view never goes stale; it
+ * keeps the parent string alive instead. `toString()` is the escape hatch that copies
+ * the range out into an independent string, e.g. before storing a small piece of a
+ * large parsed document.
+ *
+ * Views compare equal to other views with the same content; like on other platforms,
+ * a `CharSequence` is never `equals` to a [String].
+ */
+internal class StringView(
+        private val string: String,
+        private val offset: Int,
+        override val length: Int) : CharSequence {
+
+    override fun get(index: Int): Char {
+        if (index < 0 || index >= length)
+            throw IndexOutOfBoundsException("index: $index, length: $length")
+        return string[offset + index]
+    }
+
+    override fun subSequence(startIndex: Int, endIndex: Int): CharSequence {
+        if (startIndex < 0 || endIndex > length || startIndex > endIndex)
+            throw IndexOutOfBoundsException("startIndex: $startIndex, endIndex: $endIndex, length: $length")
+        if (startIndex == 0 && endIndex == length) return this
+        return string.subSequence(offset + startIndex, offset + endIndex)
+    }
+
+    override fun toString(): String = string.substringCopy(offset, offset + length)
+
+    override fun equals(other: Any?): Boolean =
+            other is StringView && other.length == length &&
+                    other.string.regionMatches(other.offset, string, offset, length)
+
+    // Matches the hash of the materialized string, so a view and its toString()
+    // hit the same bucket.
+    override fun hashCode(): Int = regionHashCode(string, offset, length)
+}
+
+@SymbolName("Kotlin_String_regionHashCode")
+internal external fun regionHashCode(string: String, offset: Int, length: Int): Int
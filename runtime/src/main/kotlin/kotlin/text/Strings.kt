@@ -96,14 +96,42 @@ public actual fun CharSequence.isBlank(): Boolean = length == 0 || indices.all {
  */
 @kotlin.internal.InlineOnly
 public actual inline fun String.substring(startIndex: Int, endIndex: Int): String =
-        subSequence(startIndex, endIndex) as String
+        substringCopy(startIndex, endIndex)
 
 /**
  * Returns a substring of this string that starts at the specified [startIndex] and continues to the end of the string.
  */
 @kotlin.internal.InlineOnly
 public actual inline fun String.substring(startIndex: Int): String =
-        subSequence(startIndex, this.length) as String
+        substringCopy(startIndex, this.length)
+
+/**
+ * Copies out the given character range as a new string. [String.subSequence] returns a view
+ * into the original string instead, so `substring` materializes explicitly.
+ */
+@PublishedApi
+@SymbolName("Kotlin_String_subSequence")
+internal external fun String.substringCopy(startIndex: Int, endIndex: Int): String
+
+/**
+ * Splits this string around occurrences of the [delimiter] character and returns the pieces
+ * as an array.
+ *
+ * Unlike `split`, which grows a list and boxes each delimiter lookup, the whole operation
+ * runs in the runtime: the delimiters are located in one vectorized pass, the result array
+ * is allocated once with the exact piece count, and every piece is created with its exact
+ * size.
+ *
+ * @param limit the maximum number of pieces to return; the last piece contains the rest of
+ * the string, delimiters included. Zero means no limit.
+ */
+public fun String.splitToArray(delimiter: Char, limit: Int = 0): Array<String> {
+    require(limit >= 0) { "Limit must be non-negative, but was $limit" }
+    return splitByChar(delimiter, limit)
+}
+
+@SymbolName("Kotlin_String_splitByChar")
+internal external fun String.splitByChar(delimiter: Char, limit: Int): Array<String>
 
 /**
  * Returns `true` if this string starts with the specified prefix.
@@ -0,0 +1,564 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.text.regex
+
+/**
+ * A lazy-DFA execution engine for the subset of patterns that need no backtracking.
+ *
+ * Patterns without backreferences, lookaround, anchors and possessive quantifiers are
+ * lowered to a Thompson NFA at compile time; at match time DFA states (sets of NFA
+ * states) are materialized on demand and cached, so matching consumes each input
+ * character exactly once regardless of the pattern. This avoids the worst-case
+ * exponential behavior of the backtracking interpreter and is substantially faster
+ * even on benign patterns.
+ *
+ * The engine answers boolean questions only — it tracks no group boundaries — so
+ * [Regex] consults it from [Regex.matches] and [Regex.containsMatchIn] and keeps the
+ * backtracking engine for everything that returns a [MatchResult].
+ *
+ * [compile] returns `null` for patterns outside the supported subset, and the match
+ * methods return `null` when they give up mid-run (DFA state budget exhausted, or
+ * surrogate input where code-unit-level matching could disagree with the
+ * code-point-level engine); callers must then fall back to the backtracking engine.
+ */
+/**
+ * Skips input positions that cannot start a match, so find-style scans only invoke the
+ * full matcher at candidate positions. [ranges] holds inclusive (low, high) pairs of
+ * the characters a match may start with; a single one-character range degenerates to
+ * [String.indexOf], which searches with a vectorized character scan in the runtime.
+ * Immutable after construction, so safe to use on a frozen [Regex].
+ */
+internal class FindPrefilter(private val ranges: CharArray) {
+    private val singleChar: Char? =
+            if (ranges.size == 2 && ranges[0] == ranges[1]) ranges[0] else null
+
+    /** The next index at or after [from] where a match could start, or -1 if none. */
+    fun nextCandidate(input: CharSequence, from: Int): Int {
+        val single = singleChar
+        if (single != null && input is String) return input.indexOf(single, from)
+        var i = from
+        while (i < input.length) {
+            val ch = input[i]
+            var j = 0
+            while (j < ranges.size) {
+                if (ch >= ranges[j] && ch <= ranges[j + 1]) return i
+                j += 2
+            }
+            i++
+        }
+        return -1
+    }
+}
+
+internal class DfaMatcher private constructor(
+        private val kind: IntArray,
+        private val ranges: Array<CharArray?>,
+        private val negate: BooleanArray,
+        private val out1: IntArray,
+        private val out2: IntArray,
+        startState: Int) {
+
+    /**
+     * A materialized DFA state: a sorted set of NFA states plus a transition cache.
+     * Search states (unanchored matching) re-add the start closure on every step, so
+     * they form a separate state space from anchored ones and never share caches.
+     */
+    private class DState(val accepting: Boolean, val nfaStates: IntArray, val search: Boolean) {
+        /** Cached transitions for ASCII input; [DfaMatcher.dead] marks a computed empty successor. */
+        val asciiNext = arrayOfNulls<DState>(ASCII_LIMIT)
+        /** Cached transitions for the rest of the BMP, filled on demand. */
+        var otherNext: HashMap<Char, DState>? = null
+    }
+
+    private val dead = DState(false, IntArray(0), search = false)
+    private val dstateCache = HashMap<String, DState>()
+    private val startClosure: IntArray = closureOf(intArrayOf(startState))
+    private val startDState: DState = dstateFor(startClosure, search = false)
+    private val searchDState: DState = dstateFor(startClosure, search = true)
+    private var budgetExhausted = false
+
+    /** Whether the whole [input] matches; `null` if the DFA gave up. */
+    fun matches(input: CharSequence): Boolean? {
+        var state = startDState
+        for (i in 0 until input.length) {
+            val ch = input[i]
+            if (ch.isSurrogate()) return null
+            state = step(state, ch) ?: return null
+            if (state === dead) return false
+        }
+        return state.accepting
+    }
+
+    /** Whether [input] contains a match anywhere; `null` if the DFA gave up. */
+    fun containsMatchIn(input: CharSequence): Boolean? {
+        var state = searchDState
+        if (state.accepting) return true
+        for (i in 0 until input.length) {
+            val ch = input[i]
+            if (ch.isSurrogate()) return null
+            state = step(state, ch) ?: return null
+            if (state.accepting) return true
+        }
+        return false
+    }
+
+    private fun step(state: DState, ch: Char): DState? {
+        if (budgetExhausted) return null
+        val code = ch.toInt()
+        if (code < ASCII_LIMIT) {
+            state.asciiNext[code]?.let { return it }
+        } else {
+            state.otherNext?.get(ch)?.let { return it }
+        }
+        val next = computeStep(state, ch)
+        if (next == null) {
+            budgetExhausted = true
+            return null
+        }
+        if (code < ASCII_LIMIT) {
+            state.asciiNext[code] = next
+        } else {
+            val map = state.otherNext ?: HashMap<Char, DState>().also { state.otherNext = it }
+            map[ch] = next
+        }
+        return next
+    }
+
+    private fun computeStep(state: DState, ch: Char): DState? {
+        val moved = ArrayList<Int>()
+        for (s in state.nfaStates) {
+            if (kind[s] == KIND_CONSUME && matchesClass(s, ch)) {
+                moved.add(out1[s])
+            }
+        }
+        if (state.search) {
+            for (s in startClosure) moved.add(s)
+        }
+        if (moved.isEmpty()) return dead
+        val closure = closureOf(moved.toIntArray())
+        if (closure.isEmpty()) return dead
+        if (dstateCache.size >= MAX_DSTATES) return null
+        return dstateFor(closure, state.search)
+    }
+
+    /**
+     * A prefilter for find-style scans, or `null` when one would not help. Built from
+     * the NFA start closure: every non-empty match must begin with a character accepted
+     * by one of the closure's consuming states, so scanning for those characters and
+     * only invoking the matcher at candidate positions preserves semantics. Unusable
+     * when the pattern matches the empty string (a match starts anywhere), when a
+     * leading class is negated (it accepts nearly everything, so skipping wins nothing),
+     * or when the leading alternatives are too numerous to test cheaply per character.
+     */
+    fun findPrefilter(): FindPrefilter? {
+        var accepting = false
+        for (s in startClosure) if (kind[s] == KIND_ACCEPT) accepting = true
+        if (accepting) return null
+        val merged = ArrayList<Char>()
+        for (s in startClosure) {
+            if (negate[s]) return null
+            val r = ranges[s]!!
+            for (c in r) merged.add(c)
+            if (merged.size > MAX_PREFILTER_RANGES * 2) return null
+        }
+        if (merged.isEmpty()) return null
+        return FindPrefilter(merged.toCharArray())
+    }
+
+    private fun matchesClass(s: Int, ch: Char): Boolean {
+        val r = ranges[s]!!
+        var inside = false
+        var i = 0
+        while (i < r.size) {
+            if (ch >= r[i] && ch <= r[i + 1]) {
+                inside = true
+                break
+            }
+            i += 2
+        }
+        return inside != negate[s]
+    }
+
+    /** Epsilon closure of [states], deduplicated and sorted for use as a cache key. */
+    private fun closureOf(states: IntArray): IntArray {
+        val seen = HashSet<Int>()
+        val work = ArrayList<Int>()
+        for (s in states) if (seen.add(s)) work.add(s)
+        var i = 0
+        while (i < work.size) {
+            val s = work[i++]
+            if (kind[s] == KIND_SPLIT) {
+                if (seen.add(out1[s])) work.add(out1[s])
+                if (seen.add(out2[s])) work.add(out2[s])
+            }
+        }
+        // Split states contribute nothing once expanded.
+        val result = work.filter { kind[it] != KIND_SPLIT }.toIntArray()
+        result.sort()
+        return result
+    }
+
+    private fun dstateFor(closure: IntArray, search: Boolean): DState {
+        val key = (if (search) "S" else "A") + String(CharArray(closure.size) { closure[it].toChar() })
+        dstateCache[key]?.let { return it }
+        var accepting = false
+        for (s in closure) {
+            if (kind[s] == KIND_ACCEPT) {
+                accepting = true
+                break
+            }
+        }
+        val state = DState(accepting, closure, search)
+        dstateCache[key] = state
+        return state
+    }
+
+    companion object {
+        private const val ASCII_LIMIT = 128
+        /** DFA states materialized per matcher before giving up (RE2-style cap). */
+        private const val MAX_DSTATES = 1024
+        /** Ranges a [FindPrefilter] may test per input character. */
+        private const val MAX_PREFILTER_RANGES = 8
+
+        private const val KIND_CONSUME = 0
+        private const val KIND_SPLIT = 1
+        private const val KIND_ACCEPT = 2
+
+        /**
+         * Compiles [pattern] or returns `null` if it uses features beyond the DFA subset
+         * or non-default [flags].
+         */
+        fun compile(pattern: String, flags: Int): DfaMatcher? {
+            if (flags != 0) return null
+            return try {
+                Builder(pattern).build()
+            } catch (e: UnsupportedPattern) {
+                null
+            }
+        }
+    }
+
+    /** Thrown by [Builder] when the pattern falls outside the supported subset. */
+    private class UnsupportedPattern : Exception()
+
+    /**
+     * Recursive descent parser performing Thompson construction. Kept independent from
+     * [Lexer]: it recognizes a conservative subset and bails out on anything else, while
+     * [Lexer] is entangled with the backtracking node hierarchy.
+     */
+    private class Builder(private val pattern: String) {
+        private val kind = ArrayList<Int>()
+        private val ranges = ArrayList<CharArray?>()
+        private val negate = ArrayList<Boolean>()
+        private val out1 = ArrayList<Int>()
+        private val out2 = ArrayList<Int>()
+        private var pos = 0
+
+        /** Dangling out-edges to patch, each encoded as state index * 2 + (0 for out1, 1 for out2). */
+        private class Fragment(val start: Int, val dangling: ArrayList<Int>)
+
+        fun build(): DfaMatcher {
+            val fragment = parseAlternation()
+            if (pos != pattern.length) bail() // Unbalanced ')'.
+            val accept = newState(KIND_ACCEPT, null, false)
+            patch(fragment.dangling, accept)
+            return DfaMatcher(kind.toIntArray(), ranges.toTypedArray(),
+                    negate.toBooleanArray(), out1.toIntArray(), out2.toIntArray(),
+                    fragment.start)
+        }
+
+        private fun bail(): Nothing = throw UnsupportedPattern()
+
+        private fun newState(k: Int, r: CharArray?, neg: Boolean): Int {
+            kind.add(k)
+            ranges.add(r)
+            negate.add(neg)
+            out1.add(-1)
+            out2.add(-1)
+            if (kind.size > MAX_NFA_STATES) bail()
+            return kind.size - 1
+        }
+
+        private fun patch(dangling: List<Int>, target: Int) {
+            for (edge in dangling) {
+                if (edge and 1 == 0) out1[edge shr 1] = target else out2[edge shr 1] = target
+            }
+        }
+
+        private fun peek(): Char = pattern[pos]
+        private fun more(): Boolean = pos < pattern.length
+
+        private fun parseAlternation(): Fragment {
+            var result = parseConcatenation()
+            while (more() && peek() == '|') {
+                pos++
+                val right = parseConcatenation()
+                val split = newState(KIND_SPLIT, null, false)
+                out1[split] = result.start
+                out2[split] = right.start
+                result.dangling.addAll(right.dangling)
+                result = Fragment(split, result.dangling)
+            }
+            return result
+        }
+
+        private fun parseConcatenation(): Fragment {
+            var result: Fragment? = null
+            while (more() && peek() != '|' && peek() != ')') {
+                val piece = parseQuantified()
+                result = append(result, piece)
+            }
+            if (result == null) {
+                // An empty branch matches the empty string: a split whose both edges
+                // dangle to the continuation acts as an epsilon transition.
+                val split = newState(KIND_SPLIT, null, false)
+                val dangling = ArrayList<Int>()
+                dangling.add(split * 2)
+                dangling.add(split * 2 + 1)
+                result = Fragment(split, dangling)
+            }
+            return result
+        }
+
+        private fun append(left: Fragment?, right: Fragment): Fragment {
+            if (left == null) return right
+            patch(left.dangling, right.start)
+            return Fragment(left.start, right.dangling)
+        }
+
+        private fun parseQuantified(): Fragment {
+            val atomStart = pos
+            var fragment = parseAtom()
+            if (!more()) return fragment
+            when (peek()) {
+                '*' -> { pos++; fragment = star(fragment) }
+                '+' -> { pos++; fragment = plus(fragment) }
+                '?' -> { pos++; fragment = optional(fragment) }
+                '{' -> fragment = counted(fragment, atomStart)
+                else -> return fragment
+            }
+            // Reluctant quantifiers match the same language, so they are safe to accept
+            // for boolean questions; possessive ones are not.
+            if (more() && peek() == '?') pos++
+            if (more() && peek() == '+') bail()
+            return fragment
+        }
+
+        private fun star(fragment: Fragment): Fragment {
+            val split = newState(KIND_SPLIT, null, false)
+            out1[split] = fragment.start
+            patch(fragment.dangling, split)
+            val dangling = ArrayList<Int>()
+            dangling.add(split * 2 + 1)
+            return Fragment(split, dangling)
+        }
+
+        private fun plus(fragment: Fragment): Fragment {
+            val split = newState(KIND_SPLIT, null, false)
+            out1[split] = fragment.start
+            patch(fragment.dangling, split)
+            val dangling = ArrayList<Int>()
+            dangling.add(split * 2 + 1)
+            return Fragment(fragment.start, dangling)
+        }
+
+        private fun optional(fragment: Fragment): Fragment {
+            val split = newState(KIND_SPLIT, null, false)
+            out1[split] = fragment.start
+            val dangling = ArrayList<Int>(fragment.dangling)
+            dangling.add(split * 2 + 1)
+            return Fragment(split, dangling)
+        }
+
+        /** `{n}`, `{n,}` and `{n,m}`: expanded by re-parsing the atom, with capped bounds. */
+        private fun counted(fragment: Fragment, atomStart: Int): Fragment {
+            pos++ // '{'
+            var min = 0
+            var sawDigit = false
+            while (more() && peek() in '0'..'9') { min = min * 10 + (peek() - '0'); pos++; sawDigit = true }
+            if (!sawDigit) bail()
+            var max = min
+            if (more() && peek() == ',') {
+                pos++
+                if (more() && peek() == '}') {
+                    max = -1
+                } else {
+                    max = 0
+                    while (more() && peek() in '0'..'9') { max = max * 10 + (peek() - '0'); pos++ }
+                }
+            }
+            if (!more() || peek() != '}') bail()
+            pos++
+            if (min > MAX_COUNTED || (max != -1 && (max > MAX_COUNTED || max < min))) bail()
+            var copiesLeft = min
+            var result: Fragment? = null
+            var first: Fragment? = fragment
+            while (copiesLeft > 0) {
+                result = append(result, first ?: reparseAtom(atomStart))
+                first = null
+                copiesLeft--
+            }
+            if (max == -1) {
+                result = append(result, star(first ?: reparseAtom(atomStart)))
+            } else {
+                for (i in min until max) {
+                    result = append(result, optional(first ?: reparseAtom(atomStart)))
+                    first = null
+                }
+            }
+            if (result == null) {
+                // {0}: matches only the empty string; the parsed atom is left unreachable.
+                val split = newState(KIND_SPLIT, null, false)
+                val dangling = ArrayList<Int>()
+                dangling.add(split * 2)
+                dangling.add(split * 2 + 1)
+                return Fragment(split, dangling)
+            }
+            return result
+        }
+
+        private fun reparseAtom(atomStart: Int): Fragment {
+            val savedPos = pos
+            pos = atomStart
+            val fragment = parseAtom()
+            pos = savedPos
+            return fragment
+        }
+
+        private fun parseAtom(): Fragment {
+            if (!more()) bail()
+            val ch = peek()
+            return when (ch) {
+                '(' -> {
+                    pos++
+                    if (more() && peek() == '?') {
+                        pos++
+                        // Only non-capturing groups: lookaround, atomic groups and inline
+                        // flags all need the backtracking engine.
+                        if (!more() || peek() != ':') bail()
+                        pos++
+                    }
+                    val fragment = parseAlternation()
+                    if (!more() || peek() != ')') bail()
+                    pos++
+                    fragment
+                }
+                '[' -> parseCharClass()
+                '.' -> {
+                    pos++
+                    // Everything but line terminators, as the backtracking DotSet matches.
+                    consuming(charArrayOf('\n', '\n', '\r', '\r',
+                            '\u0085', '\u0085', '\u2028', '\u2029'), true)
+                }
+                '\\' -> parseEscape()
+                '^', '$', '*', '+', '?', '{', ')' -> bail()
+                else -> {
+                    pos++
+                    consuming(charArrayOf(ch, ch), false)
+                }
+            }
+        }
+
+        private fun consuming(r: CharArray, neg: Boolean): Fragment {
+            val state = newState(KIND_CONSUME, r, neg)
+            val dangling = ArrayList<Int>()
+            dangling.add(state * 2)
+            return Fragment(state, dangling)
+        }
+
+        private fun parseEscape(): Fragment {
+            pos++ // '\\'
+            if (!more()) bail()
+            val ch = peek()
+            pos++
+            val r = escapeRanges(ch) ?: bail()
+            return consuming(r.first, r.second)
+        }
+
+        /** Ranges for an escape as (ranges, negated), or `null` if unsupported. */
+        private fun escapeRanges(ch: Char): Pair<CharArray, Boolean>? = when (ch) {
+            'd' -> Pair(charArrayOf('0', '9'), false)
+            'D' -> Pair(charArrayOf('0', '9'), true)
+            'w' -> Pair(WORD_RANGES, false)
+            'W' -> Pair(WORD_RANGES, true)
+            's' -> Pair(SPACE_RANGES, false)
+            'S' -> Pair(SPACE_RANGES, true)
+            't' -> Pair(charArrayOf('\t', '\t'), false)
+            'n' -> Pair(charArrayOf('\n', '\n'), false)
+            'r' -> Pair(charArrayOf('\r', '\r'), false)
+            'f' -> Pair(charArrayOf('\u000C', '\u000C'), false)
+            'a' -> Pair(charArrayOf('\u0007', '\u0007'), false)
+            'e' -> Pair(charArrayOf('\u001B', '\u001B'), false)
+            else ->
+                // Escaped punctuation is a literal; remaining alphanumerics are octal/hex
+                // escapes, backreferences or anchors — all left to the backtracking engine.
+                if (ch.isLetterOrDigit()) null else Pair(charArrayOf(ch, ch), false)
+        }
+
+        private fun parseCharClass(): Fragment {
+            pos++ // '['
+            var negated = false
+            if (more() && peek() == '^') {
+                negated = true
+                pos++
+            }
+            val ranges = ArrayList<Char>()
+            var first = true
+            while (true) {
+                if (!more()) bail()
+                val ch = peek()
+                if (ch == ']' && !first) break
+                first = false
+                when {
+                    ch == '[' -> bail() // Nested classes and POSIX names.
+                    ch == '&' && pos + 1 < pattern.length && pattern[pos + 1] == '&' -> bail() // Intersections.
+                    ch == '\\' -> {
+                        pos++
+                        if (!more()) bail()
+                        val escaped = peek()
+                        pos++
+                        val r = escapeRanges(escaped) ?: bail()
+                        // Negated escapes inside a class would need set subtraction.
+                        if (r.second) bail()
+                        if (r.first.size == 2 && r.first[0] == r.first[1]
+                                && maybeRange(r.first[0], ranges)) continue
+                        for (c in r.first) ranges.add(c)
+                        continue
+                    }
+                    else -> pos++
+                }
+                if (maybeRange(ch, ranges)) continue
+                ranges.add(ch)
+                ranges.add(ch)
+            }
+            pos++ // ']'
+            if (ranges.isEmpty()) bail()
+            return consuming(ranges.toCharArray(), negated)
+        }
+
+        /** Consumes `-x` after a single class member if present, adding the range `lo-x`. */
+        private fun maybeRange(lo: Char, ranges: ArrayList<Char>): Boolean {
+            if (pos + 1 < pattern.length && peek() == '-' && pattern[pos + 1] != ']') {
+                pos++
+                val hi = peek()
+                if (hi == '\\') bail() // Ranges with escaped endpoints: bail for simplicity.
+                pos++
+                if (hi < lo) bail()
+                ranges.add(lo)
+                ranges.add(hi)
+                return true
+            }
+            return false
+        }
+
+        companion object {
+            private const val MAX_NFA_STATES = 4096
+            private const val MAX_COUNTED = 64
+            private val WORD_RANGES = charArrayOf('0', '9', 'A', 'Z', '_', '_', 'a', 'z')
+            private val SPACE_RANGES = charArrayOf('\t', '\r', ' ', ' ')
+        }
+    }
+}
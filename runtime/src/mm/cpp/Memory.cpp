@@ -0,0 +1,741 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <string.h>
+
+#if !KONAN_NO_THREADS
+#include <pthread.h>
+#endif
+
+#include "Alloc.h"
+#include "Atomic.h"
+#include "Exceptions.h"
+#include "KAssert.h"
+#include "Memory.h"
+#include "MemoryPrivate.hpp"
+#include "Natives.h"
+#include "Porting.h"
+#include "Types.h"
+#include "Weak.h"
+
+#include "ObjCMMAPI.h"
+
+/**
+ * Theory of operations:
+ *
+ * The experimental memory manager trades the legacy reference counting scheme for a
+ * single heap shared by all threads and a tracing collector. The mutator protocol is
+ * deliberately trivial: reference updates are plain stores, there is no counter traffic,
+ * no containers and no freeze requirement for sharing - any thread may read and write
+ * any object. Freezing is retained only for its user-observable immutability contract
+ * (a flag in the meta-object checked by MutationCheck), not as a sharing precondition.
+ *
+ * The current milestone implements the shared heap with precise root bookkeeping but
+ * without the collector itself: allocations are linked into per-thread chunk lists that
+ * are spliced into the process-wide heap in bulk, frames form per-thread chains exactly
+ * like the strict legacy model, and stable/foreign references are tracked in an explicit
+ * root registry. Memory is reclaimed wholesale when the last thread detaches. The
+ * tracing collector - safepoint-based stop-the-world marking over the frame chains,
+ * TLS records and the root registry, with a nursery generation carved out of the
+ * per-thread chunk lists - can then be dropped in behind this mutator protocol without
+ * changing it; global variable roots additionally require registration support from
+ * the compiler. The variant is selectable per binary via the experimental_memory_manager
+ * runtime module in the runtime Gradle build.
+ */
+
+namespace {
+
+THREAD_LOCAL_VARIABLE MemoryState* memoryState = nullptr;
+THREAD_LOCAL_VARIABLE FrameOverlay* currentFrame = nullptr;
+
+inline void lock(int32_t* spinlock) {
+  while (compareAndSwap(spinlock, 0, 1) != 0) {}
+}
+
+inline void unlock(int32_t* spinlock) {
+  RuntimeCheck(compareAndSwap(spinlock, 1, 0) == 1, "Must succeed");
+}
+
+// The process-wide heap: all chunks ever allocated, plus the explicit roots the
+// future collector shall treat as strong references (stable pointers, foreign
+// references, heap references handed out to interop).
+struct GlobalHeap {
+  int32_t chunksLock;
+  HeapChunk* chunks;
+  int32_t rootsLock;
+  KStdUnorderedMap<const ObjHeader*, int>* roots;
+  int32_t aliveStates;
+};
+
+GlobalHeap globalHeap = { 0, nullptr, 0, nullptr, 0 };
+
+void spliceIntoGlobalHeap(HeapChunk* head, HeapChunk* tail) {
+  if (head == nullptr) return;
+  lock(&globalHeap.chunksLock);
+  tail->next = globalHeap.chunks;
+  globalHeap.chunks = head;
+  unlock(&globalHeap.chunksLock);
+}
+
+void addRoot(const ObjHeader* object) {
+  if (object == nullptr || object->permanent()) return;
+  lock(&globalHeap.rootsLock);
+  (*globalHeap.roots)[object]++;
+  unlock(&globalHeap.rootsLock);
+}
+
+void removeRoot(const ObjHeader* object) {
+  if (object == nullptr || object->permanent()) return;
+  lock(&globalHeap.rootsLock);
+  auto it = globalHeap.roots->find(object);
+  RuntimeAssert(it != globalHeap.roots->end(), "Must be a registered root");
+  if (--it->second == 0)
+    globalHeap.roots->erase(it);
+  unlock(&globalHeap.rootsLock);
+}
+
+int32_t deathHooksLock = 0;
+
+// Runs and frees the death hooks of a dying object. The list is detached under
+// the lock, but the hooks themselves run outside of it, so they may touch the
+// structures that register and remove hooks (e.g. a weak-keyed table clearing
+// its entry for the dying key).
+void runObjectDeathHooks(MetaObjHeader* meta) {
+  if (meta->DeathHooks.head_ == nullptr) return;
+  lock(&deathHooksLock);
+  ObjectDeathHook* node = meta->DeathHooks.head_;
+  meta->DeathHooks.head_ = nullptr;
+  unlock(&deathHooksLock);
+  while (node != nullptr) {
+    node->hook_(node->entry_);
+    ObjectDeathHook* next = node->next_;
+    konanFreeMemory(node);
+    node = next;
+  }
+}
+
+ObjHeader* allocateHeapObject(MemoryState* state, uint32_t size) {
+  auto* chunk = reinterpret_cast<HeapChunk*>(konanAllocMemory(sizeof(HeapChunk) + size));
+  if (chunk == nullptr) ThrowOutOfMemoryError();
+  if (state != nullptr) {
+    // Common case: link into the per-thread list, handed over in bulk.
+    chunk->next = state->allocatedHead;
+    state->allocatedHead = chunk;
+    if (state->allocatedTail == nullptr) state->allocatedTail = chunk;
+  } else {
+    // Instances can be allocated before actual runtime init - be prepared for that.
+    spliceIntoGlobalHeap(chunk, chunk);
+  }
+  return objectInChunk(chunk);
+}
+
+inline int32_t metaFlags(const ObjHeader* obj) {
+  auto* mutableObj = const_cast<ObjHeader*>(obj);
+  return mutableObj->has_meta_object() ? mutableObj->meta_object()->flags_ : 0;
+}
+
+inline bool isFrozenImpl(const ObjHeader* obj) {
+  return obj->permanent() || (metaFlags(obj) & MF_FROZEN) != 0;
+}
+
+void freeHeapObject(HeapChunk* chunk) {
+  ObjHeader* obj = objectInChunk(chunk);
+  if (obj->has_meta_object())
+    ObjHeader::destroyMetaObject(&obj->typeInfoOrMeta_);
+  konanFreeMemory(chunk);
+}
+
+}  // namespace
+
+ALWAYS_INLINE bool isFrozen(const ObjHeader* obj) {
+  return isFrozenImpl(obj);
+}
+
+ALWAYS_INLINE bool isPermanentOrFrozen(const ObjHeader* obj) {
+  return isFrozenImpl(obj);
+}
+
+ALWAYS_INLINE bool isShareable(const ObjHeader* obj) {
+  // The heap is shared: every object is accessible from every thread.
+  return true;
+}
+
+MetaObjHeader* ObjHeader::createMetaObject(TypeInfo** location) {
+  TypeInfo* typeInfo = *location;
+  RuntimeCheck(!hasPointerBits(typeInfo, OBJECT_TAG_MASK), "Object must not be tagged");
+
+#if !KONAN_NO_THREADS
+  if (typeInfo->typeInfo_ != typeInfo) {
+    // Someone installed a new meta-object since the check.
+    return reinterpret_cast<MetaObjHeader*>(typeInfo);
+  }
+#endif
+
+  MetaObjHeader* meta = konanConstructInstance<MetaObjHeader>();
+  meta->typeInfo_ = typeInfo;
+#if KONAN_NO_THREADS
+  *location = reinterpret_cast<TypeInfo*>(meta);
+#else
+  TypeInfo* old = __sync_val_compare_and_swap(location, typeInfo, reinterpret_cast<TypeInfo*>(meta));
+  if (old != typeInfo) {
+    // Someone installed a new meta-object since the check.
+    konanFreeMemory(meta);
+    meta = reinterpret_cast<MetaObjHeader*>(old);
+  }
+#endif
+  return meta;
+}
+
+void ObjHeader::destroyMetaObject(TypeInfo** location) {
+  MetaObjHeader* meta = clearPointerBits(*(reinterpret_cast<MetaObjHeader**>(location)), OBJECT_TAG_MASK);
+  *const_cast<const TypeInfo**>(location) = meta->typeInfo_;
+  if (meta->WeakReference.counter_ != nullptr) {
+    WeakReferenceCounterClear(meta->WeakReference.counter_);
+    ZeroHeapRef(&meta->WeakReference.counter_);
+  }
+  runObjectDeathHooks(meta);
+
+#ifdef KONAN_OBJC_INTEROP
+  Kotlin_ObjCExport_releaseAssociatedObject(meta->associatedObject_);
+#endif
+
+  konanFreeMemory(meta);
+}
+
+ObjHeader** ObjHeader::GetWeakCounterLocation() {
+  return &meta_object()->WeakReference.counter_;
+}
+
+#ifdef KONAN_OBJC_INTEROP
+
+void* ObjHeader::GetAssociatedObject() {
+  if (!has_meta_object()) {
+    return nullptr;
+  }
+  return *GetAssociatedObjectLocation();
+}
+
+void** ObjHeader::GetAssociatedObjectLocation() {
+  return &meta_object()->associatedObject_;
+}
+
+void ObjHeader::SetAssociatedObject(void* obj) {
+  *GetAssociatedObjectLocation() = obj;
+}
+
+#endif // KONAN_OBJC_INTEROP
+
+extern "C" {
+
+MemoryState* InitMemory() {
+  RuntimeAssert(memoryState == nullptr, "Memory state must be clear");
+  MemoryState* state = konanConstructInstance<MemoryState>();
+  state->tlsMap = konanConstructInstance<KThreadLocalStorageMap>();
+  lock(&globalHeap.rootsLock);
+  if (globalHeap.roots == nullptr)
+    globalHeap.roots = konanConstructInstance<KStdUnorderedMap<const ObjHeader*, int>>();
+  unlock(&globalHeap.rootsLock);
+  atomicAdd(&globalHeap.aliveStates, 1);
+  memoryState = state;
+  return state;
+}
+
+void DeinitMemory(MemoryState* state) {
+  RuntimeAssert(state == memoryState, "Must be called on the owner thread");
+  RuntimeAssert(state->tlsMap->size() == 0, "Must be already cleared");
+  konanDestructInstance(state->tlsMap);
+  spliceIntoGlobalHeap(state->allocatedHead, state->allocatedTail);
+  if (atomicAdd(&globalHeap.aliveStates, -1) == 0) {
+    // The last thread detaches: reclaim the whole heap. With the shared heap no
+    // per-object liveness is known without tracing, so memory is returned wholesale.
+    lock(&globalHeap.chunksLock);
+    HeapChunk* chunk = globalHeap.chunks;
+    globalHeap.chunks = nullptr;
+    unlock(&globalHeap.chunksLock);
+    while (chunk != nullptr) {
+      HeapChunk* next = chunk->next;
+      freeHeapObject(chunk);
+      chunk = next;
+    }
+  }
+  konanDestructInstance(state);
+  memoryState = nullptr;
+  currentFrame = nullptr;
+}
+
+void RestoreMemory(MemoryState* state) {
+  RuntimeCheck(memoryState == nullptr || memoryState == state, "Cannot schedule on existing state");
+  memoryState = state;
+}
+
+MemoryState* SuspendMemory() {
+  MemoryState* result = ::memoryState;
+  if (result != nullptr) {
+    result->suspendedFrame = ::currentFrame;
+  }
+  ::memoryState = nullptr;
+  ::currentFrame = nullptr;
+  return result;
+}
+
+void ResumeMemory(MemoryState* state) {
+  RuntimeAssert(::memoryState == nullptr, "Must not resume a memory state over an active one");
+  ::memoryState = state;
+  ::currentFrame = state != nullptr ? state->suspendedFrame : nullptr;
+}
+
+RUNTIME_NOTHROW MemoryState* GetMemoryState() {
+  return ::memoryState;
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(AllocInstanceWithState, MemoryState* state, const TypeInfo* type_info) {
+  RuntimeAssert(type_info->instanceSize_ >= 0, "must be an object");
+  ObjHeader* obj = allocateHeapObject(state, objectSize(type_info, 0));
+  obj->typeInfoOrMeta_ = const_cast<TypeInfo*>(type_info);
+  RETURN_OBJ(obj);
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(AllocInstance, const TypeInfo* type_info) {
+  RETURN_RESULT_OF(AllocInstanceWithState, memoryState, type_info);
+}
+
+OBJ_GETTER(AllocArrayInstanceWithState, MemoryState* state, const TypeInfo* type_info, int32_t elements) {
+  RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
+  if (elements < 0) ThrowIllegalArgumentException();
+  ObjHeader* obj = allocateHeapObject(state, arrayObjectSize(type_info, elements));
+  obj->typeInfoOrMeta_ = const_cast<TypeInfo*>(type_info);
+  obj->array()->count_ = elements;
+  RETURN_OBJ(obj);
+}
+
+OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements) {
+  RETURN_RESULT_OF(AllocArrayInstanceWithState, memoryState, type_info, elements);
+}
+
+OBJ_GETTER(AllocArrayInstanceUninitialized, const TypeInfo* type_info, int32_t elements) {
+  // This model's allocator zeroes unconditionally; nothing to elide yet.
+  RETURN_RESULT_OF(AllocArrayInstanceWithState, memoryState, type_info, elements);
+}
+
+OBJ_GETTER(AllocArrayInstanceAligned, const TypeInfo* type_info, int32_t elements, int32_t alignment) {
+  // This model's allocator has no aligned path yet; best effort means the
+  // default alignment here.
+  RETURN_RESULT_OF(AllocArrayInstanceWithState, memoryState, type_info, elements);
+}
+
+RUNTIME_NOTHROW bool TryGrowArrayInPlace(ArrayHeader* array, int32_t newCount) {
+  // The object layout of this model's heap is not queryable for slack yet;
+  // callers fall back to copying.
+  return false;
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(AllocInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info) {
+  // No frame-local slabs yet: the contract allows falling back to the heap. The
+  // nursery generation shall serve this case.
+  RETURN_RESULT_OF(AllocInstance, type_info);
+}
+
+OBJ_GETTER(AllocArrayInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* type_info, int32_t elements) {
+  RETURN_RESULT_OF(AllocArrayInstance, type_info, elements);
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(PromoteObjectToHeap, ObjHeader* object) {
+  // Every object already lives in the shared heap.
+  RETURN_OBJ(object);
+}
+
+OBJ_GETTER(InitInstance, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+  ObjHeader* value = *location;
+  if (value != nullptr) {
+    // OK'ish, inited by someone else.
+    RETURN_OBJ(value);
+  }
+  ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
+  UpdateHeapRef(location, object);
+#if KONAN_NO_EXCEPTIONS
+  ctor(object);
+  return object;
+#else
+  try {
+    ctor(object);
+    return object;
+  } catch (...) {
+    UpdateReturnRef(OBJ_RESULT, nullptr);
+    ZeroHeapRef(location);
+    throw;
+  }
+#endif
+}
+
+OBJ_GETTER(InitSharedInstance, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
+#if KONAN_NO_THREADS
+  ObjHeader* value = *location;
+  if (value != nullptr) {
+    // OK'ish, inited by someone else.
+    RETURN_OBJ(value);
+  }
+  ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
+  UpdateHeapRef(location, object);
+#if KONAN_NO_EXCEPTIONS
+  ctor(object);
+  return object;
+#else
+  try {
+    ctor(object);
+    return object;
+  } catch (...) {
+    UpdateReturnRef(OBJ_RESULT, nullptr);
+    ZeroHeapRef(location);
+    throw;
+  }
+#endif  // KONAN_NO_EXCEPTIONS
+#else  // KONAN_NO_THREADS
+  auto* state = memoryState;
+  // Search from the top of the stack.
+  for (auto it = state->initializingSingletons.rbegin(); it != state->initializingSingletons.rend(); ++it) {
+    if (it->first == location) {
+      RETURN_OBJ(it->second);
+    }
+  }
+
+  ObjHeader* initializing = reinterpret_cast<ObjHeader*>(1);
+
+  // Spin lock.
+  ObjHeader* value = nullptr;
+  while ((value = __sync_val_compare_and_swap(location, nullptr, initializing)) == initializing);
+  if (value != nullptr) {
+    // OK'ish, inited by someone else.
+    RETURN_OBJ(value);
+  }
+  ObjHeader* object = AllocInstance(typeInfo, OBJ_RESULT);
+  state->initializingSingletons.push_back(std::make_pair(location, object));
+  // Note: no freezing; the heap is shared and the singleton stays mutable.
+#if KONAN_NO_EXCEPTIONS
+  ctor(object);
+  UpdateHeapRef(location, object);
+  state->initializingSingletons.pop_back();
+  return object;
+#else  // KONAN_NO_EXCEPTIONS
+  try {
+    ctor(object);
+    UpdateHeapRef(location, object);
+    state->initializingSingletons.pop_back();
+    return object;
+  } catch (...) {
+    UpdateReturnRef(OBJ_RESULT, nullptr);
+    ZeroHeapRef(location);
+    state->initializingSingletons.pop_back();
+    throw;
+  }
+#endif  // KONAN_NO_EXCEPTIONS
+#endif  // KONAN_NO_THREADS
+}
+
+extern const bool IsStrictMemoryModel = true;
+
+RUNTIME_NOTHROW void SetStackRef(ObjHeader** location, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+RUNTIME_NOTHROW void SetHeapRef(ObjHeader** location, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+RUNTIME_NOTHROW void ZeroHeapRef(ObjHeader** location) {
+  *location = nullptr;
+}
+
+RUNTIME_NOTHROW void ZeroArrayRefs(ArrayHeader* array) {
+  for (uint32_t index = 0; index < array->count_; ++index) {
+    *ArrayAddressOfElementAt(array, index) = nullptr;
+  }
+}
+
+RUNTIME_NOTHROW void ZeroStackRef(ObjHeader** location) {
+  *location = nullptr;
+}
+
+RUNTIME_NOTHROW void UpdateStackRef(ObjHeader** location, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+RUNTIME_NOTHROW void UpdateHeapRef(ObjHeader** location, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+RUNTIME_NOTHROW void UpdateHeapRefWithState(MemoryState* state, ObjHeader** location, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(location) = object;
+}
+
+RUNTIME_NOTHROW void UpdateHeapRefsBulk(
+    const ObjHeader* object, ObjHeader** const locations[], const ObjHeader* const values[], int count) {
+  for (int index = 0; index < count; ++index) {
+    RuntimeAssert(*locations[index] == nullptr, "Bulk updated field must be unset");
+    *const_cast<const ObjHeader**>(locations[index]) = values[index];
+  }
+}
+
+RUNTIME_NOTHROW void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
+  if (object == nullptr) return;
+#if KONAN_NO_THREADS
+  if (*location == nullptr)
+    *const_cast<const ObjHeader**>(location) = object;
+#else
+  __sync_val_compare_and_swap(location, nullptr, const_cast<ObjHeader*>(object));
+#endif
+}
+
+RUNTIME_NOTHROW void UpdateReturnRef(ObjHeader** returnSlot, const ObjHeader* object) {
+  *const_cast<const ObjHeader**>(returnSlot) = object;
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(
+        SwapHeapRefLocked, ObjHeader** location, ObjHeader* expectedValue, ObjHeader* newValue, int32_t* spinlock, int32_t* cookie) {
+  lock(spinlock);
+  ObjHeader* oldValue = *location;
+  if (oldValue == expectedValue) {
+    *location = newValue;
+  }
+  UpdateReturnRef(OBJ_RESULT, oldValue);
+  unlock(spinlock);
+  return oldValue;
+}
+
+RUNTIME_NOTHROW void SetHeapRefLocked(ObjHeader** location, ObjHeader* newValue, int32_t* spinlock, int32_t* cookie) {
+  lock(spinlock);
+  *location = newValue;
+  unlock(spinlock);
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(ReadHeapRefLocked, ObjHeader** location, int32_t* spinlock, int32_t* cookie) {
+  lock(spinlock);
+  ObjHeader* value = *location;
+  UpdateReturnRef(OBJ_RESULT, value);
+  unlock(spinlock);
+  return value;
+}
+
+RUNTIME_NOTHROW void EnterFrame(ObjHeader** start, int parameters, int count) {
+  FrameOverlay* frame = reinterpret_cast<FrameOverlay*>(start);
+  frame->previous = currentFrame;
+  currentFrame = frame;
+  frame->parameters = parameters;
+  frame->count = count;
+}
+
+RUNTIME_NOTHROW void LeaveFrame(ObjHeader** start, int parameters, int count) {
+  FrameOverlay* frame = reinterpret_cast<FrameOverlay*>(start);
+  currentFrame = frame->previous;
+}
+
+RUNTIME_NOTHROW void* EnterArenaScope() {
+  // No per-scope slabs: scope allocations go to the shared heap and are reclaimed
+  // by the collector like any others.
+  return nullptr;
+}
+
+RUNTIME_NOTHROW void LeaveArenaScope(void* scope) {
+  RuntimeAssert(scope == nullptr, "Must match EnterArenaScope");
+}
+
+RUNTIME_NOTHROW bool ClearSubgraphReferences(ObjHeader* root, bool checked) {
+  // Any thread may access any object, so transferring a subgraph between workers
+  // requires no detachment; there is nothing to clear or to verify.
+  return true;
+}
+
+RUNTIME_NOTHROW void* CompactSubgraph(void* stable) {
+  // Compaction is an optional optimization; keeping the graph as is is valid.
+  return stable;
+}
+
+RUNTIME_NOTHROW void* CreateStablePointer(ObjHeader* obj) {
+  if (obj != nullptr) addRoot(obj);
+  return obj;
+}
+
+RUNTIME_NOTHROW void DisposeStablePointer(void* pointer) {
+  if (pointer != nullptr) removeRoot(reinterpret_cast<ObjHeader*>(pointer));
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(DerefStablePointer, void* pointer) {
+  RETURN_OBJ(reinterpret_cast<ObjHeader*>(pointer));
+}
+
+RUNTIME_NOTHROW OBJ_GETTER(AdoptStablePointer, void* pointer) {
+  ObjHeader* obj = reinterpret_cast<ObjHeader*>(pointer);
+  UpdateReturnRef(OBJ_RESULT, obj);
+  if (obj != nullptr) removeRoot(obj);
+  return obj;
+}
+
+void MutationCheck(ObjHeader* obj) {
+  if (obj->local()) return;
+  if (isFrozenImpl(obj)) ThrowInvalidMutabilityException(obj);
+}
+
+RUNTIME_NOTHROW void CheckLifetimesConstraint(ObjHeader* obj, ObjHeader* pointee) {
+  // All objects are heap objects with a shared lifetime.
+}
+
+void FreezeSubgraph(ObjHeader* root) {
+  if (root == nullptr) return;
+  // Sharing needs no freezing here; only the user-visible immutability contract is
+  // recorded. Find a blocker first, so that a failed freeze leaves no object frozen.
+  KStdUnorderedSet<ObjHeader*> visited;
+  KStdVector<ObjHeader*> toVisit;
+  toVisit.push_back(root);
+  while (!toVisit.empty()) {
+    ObjHeader* obj = toVisit.back();
+    toVisit.pop_back();
+    if (obj->permanent() || !visited.insert(obj).second) continue;
+    if ((metaFlags(obj) & MF_NEVER_FROZEN) != 0)
+      ThrowFreezingException(root, obj);
+    traverseObjectFields(obj, [&toVisit](ObjHeader** location) {
+      ObjHeader* ref = *location;
+      if (ref != nullptr) toVisit.push_back(ref);
+    });
+  }
+  for (auto* obj: visited) {
+    obj->meta_object()->flags_ |= MF_FROZEN;
+  }
+}
+
+void EnsureNeverFrozen(ObjHeader* object) {
+  if (isFrozenImpl(object))
+    ThrowFreezingException(object, object);
+  object->meta_object()->flags_ |= MF_NEVER_FROZEN;
+}
+
+RUNTIME_NOTHROW void AddObjectDeathHook(ObjHeader* obj, void (*hook)(void*), void* entry) {
+  // Permanent objects never die, so there is nothing to hook. Note that heap
+  // objects die only at heap teardown until the tracing collector lands.
+  if (obj->permanent()) return;
+  auto* meta = obj->meta_object();
+  auto* node = konanConstructInstance<ObjectDeathHook>();
+  node->hook_ = hook;
+  node->entry_ = entry;
+  lock(&deathHooksLock);
+  node->next_ = meta->DeathHooks.head_;
+  meta->DeathHooks.head_ = node;
+  unlock(&deathHooksLock);
+}
+
+RUNTIME_NOTHROW bool RemoveObjectDeathHook(ObjHeader* obj, void* entry) {
+  if (obj->permanent() || !obj->has_meta_object()) return false;
+  auto* meta = obj->meta_object();
+  ObjectDeathHook* node;
+  lock(&deathHooksLock);
+  ObjectDeathHook** prev = &meta->DeathHooks.head_;
+  node = *prev;
+  while (node != nullptr && node->entry_ != entry) {
+    prev = &node->next_;
+    node = node->next_;
+  }
+  if (node != nullptr) *prev = node->next_;
+  unlock(&deathHooksLock);
+  if (node == nullptr) return false;
+  konanFreeMemory(node);
+  return true;
+}
+
+RUNTIME_NOTHROW void AddTLSRecord(MemoryState* memory, void** key, int size) {
+  auto* tlsMap = memory->tlsMap;
+  auto it = tlsMap->find(key);
+  if (it != tlsMap->end()) {
+    RuntimeAssert(it->second.second == size, "Size must be consistent");
+    return;
+  }
+  KRef* start = reinterpret_cast<KRef*>(konanAllocMemory(size * sizeof(KRef)));
+  tlsMap->emplace(key, std::make_pair(start, size));
+}
+
+RUNTIME_NOTHROW void ClearTLSRecord(MemoryState* memory, void** key) {
+  auto* tlsMap = memory->tlsMap;
+  auto it = tlsMap->find(key);
+  if (it != tlsMap->end()) {
+    konanFreeMemory(it->second.first);
+    tlsMap->erase(it);
+  }
+  if (memory->tlsMapLastKey == key) {
+    memory->tlsMapLastKey = nullptr;
+    memory->tlsMapLastStart = nullptr;
+  }
+}
+
+RUNTIME_NOTHROW ObjHeader** LookupTLS(void** key, int index) {
+  auto* state = memoryState;
+  // In many cases there is only one module, so this one element cache.
+  if (state->tlsMapLastKey == key) {
+    return state->tlsMapLastStart + index;
+  }
+  auto it = state->tlsMap->find(key);
+  RuntimeAssert(it != state->tlsMap->end(), "Must be there");
+  KRef* start = it->second.first;
+  state->tlsMapLastKey = key;
+  state->tlsMapLastStart = start;
+  return start + index;
+}
+
+RUNTIME_NOTHROW void GC_RegisterWorker(void* worker) {
+  // The collector thread is not implemented yet.
+}
+
+RUNTIME_NOTHROW void GC_UnregisterWorker(void* worker) {
+}
+
+RUNTIME_NOTHROW void GC_CollectorCallback(void* worker) {
+}
+
+RUNTIME_NOTHROW bool GC_PerformIdleSlice() {
+  // No deferred per-thread memory work to donate idle time to yet.
+  return false;
+}
+
+bool Kotlin_Any_isShareable(ObjHeader* thiz) {
+  return true;
+}
+
+RUNTIME_NOTHROW void PerformFullGC() {
+  // Tracing is not implemented yet; the heap is reclaimed when the last thread
+  // detaches. This is the natural entry point for the stop-the-world collection.
+}
+
+bool TryAddHeapRef(const ObjHeader* object) {
+  addRoot(object);
+  return true;
+}
+
+RUNTIME_NOTHROW void ReleaseHeapRef(const ObjHeader* object) {
+  removeRoot(object);
+}
+
+RUNTIME_NOTHROW void ReleaseHeapRefNoCollect(const ObjHeader* object) {
+  removeRoot(object);
+}
+
+ForeignRefContext InitLocalForeignRef(ObjHeader* object) {
+  // The reference is rooted in the current frame for its whole local lifetime.
+  return nullptr;
+}
+
+ForeignRefContext InitForeignRef(ObjHeader* object) {
+  addRoot(object);
+  return nullptr;
+}
+
+void DeinitForeignRef(ObjHeader* object, ForeignRefContext context) {
+  removeRoot(object);
+}
+
+bool IsForeignRefAccessible(ObjHeader* object, ForeignRefContext context) {
+  return true;
+}
+
+void AdoptReferenceFromSharedVariable(ObjHeader* object) {
+  // No delayed reference counting: reading a shared variable needs no adoption.
+}
+
+} // extern "C"
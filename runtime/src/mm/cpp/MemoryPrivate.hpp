@@ -0,0 +1,122 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_MM_MEMORYPRIVATE_HPP
+#define RUNTIME_MM_MEMORYPRIVATE_HPP
+
+#include "Alloc.h"
+#include "Memory.h"
+#include "Natives.h"
+#include "TypeInfo.h"
+#include "Types.h"
+
+#include <utility>
+
+// Every heap object is prefixed with this header, linking it into the heap-wide
+// object list the tracing collector will sweep. [color] and [flags] are reserved
+// for the collector's mark state and generation bits; until the collector lands
+// they stay zero.
+struct HeapChunk {
+  HeapChunk* next;
+  uint32_t color;
+  uint32_t flags;
+  uint32_t padding_;
+  // The object data follows the header.
+};
+
+constexpr uint32_t kObjectAlignment = 8;
+static_assert(sizeof(HeapChunk) % kObjectAlignment == 0, "sizeof(HeapChunk) is not aligned");
+
+inline HeapChunk* chunkFor(const ObjHeader* obj) {
+  return reinterpret_cast<HeapChunk*>(reinterpret_cast<uintptr_t>(obj) - sizeof(HeapChunk));
+}
+
+inline ObjHeader* objectInChunk(HeapChunk* chunk) {
+  return reinterpret_cast<ObjHeader*>(chunk + 1);
+}
+
+// Meta-objects are lazily created extensions of the object header. Unlike the
+// legacy memory manager there is no container pointer: object lifetime metadata
+// lives in the heap chunk instead.
+struct MetaObjHeader {
+  // Pointer to the type info. Must be first, to match ArrayHeader and ObjHeader layout.
+  const TypeInfo* typeInfo_;
+
+#ifdef KONAN_OBJC_INTEROP
+  void* associatedObject_;
+#endif
+
+  // Flags for the object state, see MetaFlags.
+  int32_t flags_;
+
+  struct {
+    // Strong reference to the counter object.
+    ObjHeader* counter_;
+  } WeakReference;
+
+  struct {
+    // Intrusive list of parties to notify when this object is deallocated,
+    // see AddObjectDeathHook().
+    struct ObjectDeathHook* head_;
+  } DeathHooks;
+};
+
+// A node of the per-object death notification list.
+struct ObjectDeathHook {
+  void (*hook_)(void*);
+  void* entry_;
+  ObjectDeathHook* next_;
+};
+
+typedef KStdUnorderedMap<void**, std::pair<KRef*, int>> KThreadLocalStorageMap;
+
+// Per-thread state. Until the collector needs stop-the-world handshakes this is
+// mostly bookkeeping: locally allocated chunks (spliced into the global heap in
+// bulk), the thread local storage map and the singleton initialization stack.
+struct MemoryState {
+  // Chunks allocated by this thread and not yet handed over to the global heap.
+  HeapChunk* allocatedHead;
+  HeapChunk* allocatedTail;
+  // Saved frame chain while this state is detached, see SuspendMemory().
+  FrameOverlay* suspendedFrame;
+  // Thread local storage, see AddTLSRecord().
+  KThreadLocalStorageMap* tlsMap;
+  KRef* tlsMapLastStart;
+  void* tlsMapLastKey;
+  // Singletons under construction on this thread, to handle recursive access.
+  KStdVector<std::pair<ObjHeader**, ObjHeader*>> initializingSingletons;
+};
+
+inline uint32_t arrayObjectSize(const TypeInfo* typeInfo, uint32_t count) {
+  // Note: array body is aligned, but for size computation it is enough to align the sum.
+  static_assert(kObjectAlignment % alignof(KLong) == 0, "");
+  static_assert(kObjectAlignment % alignof(KDouble) == 0, "");
+  return alignUp(sizeof(ArrayHeader) - typeInfo->instanceSize_ * count, kObjectAlignment);
+}
+
+inline uint32_t objectSize(const TypeInfo* typeInfo, uint32_t elements) {
+  uint32_t size = typeInfo->instanceSize_ < 0 ?
+      arrayObjectSize(typeInfo, elements) : static_cast<uint32_t>(typeInfo->instanceSize_);
+  return alignUp(size, kObjectAlignment);
+}
+
+template <typename func>
+inline void traverseObjectFields(ObjHeader* obj, func process) {
+  const TypeInfo* typeInfo = obj->type_info();
+  if (typeInfo != theArrayTypeInfo) {
+    for (int index = 0; index < typeInfo->objOffsetsCount_; index++) {
+      ObjHeader** location = reinterpret_cast<ObjHeader**>(
+          reinterpret_cast<uintptr_t>(obj) + typeInfo->objOffsets_[index]);
+      process(location);
+    }
+  } else {
+    ArrayHeader* array = obj->array();
+    for (uint32_t index = 0; index < array->count_; index++) {
+      process(ArrayAddressOfElementAt(array, index));
+    }
+  }
+}
+
+#endif // RUNTIME_MM_MEMORYPRIVATE_HPP
@@ -4,21 +4,167 @@
  */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 extern "C" {
 void* mi_calloc(size_t, size_t);
+void* mi_malloc(size_t);
 void mi_free(void*);
 void* mi_calloc_aligned(size_t count, size_t size, size_t alignment);
+void* mi_calloc_aligned_at(size_t count, size_t size, size_t alignment, size_t offset);
+size_t mi_usable_size(const void*);
+
+typedef struct mi_heap_s mi_heap_t;
+typedef struct mi_heap_area_s {
+  void* blocks;
+  size_t reserved;
+  size_t committed;
+  size_t used;
+  size_t block_size;
+} mi_heap_area_t;
+typedef bool (mi_block_visit_fun)(const mi_heap_t*, const mi_heap_area_t*, void*, size_t, void*);
+
+mi_heap_t* mi_heap_new(void);
+mi_heap_t* mi_heap_set_default(mi_heap_t*);
+mi_heap_t* mi_heap_get_backing(void);
+void mi_heap_delete(mi_heap_t*);
+bool mi_heap_visit_blocks(const mi_heap_t*, bool visit_all_blocks, mi_block_visit_fun*, void*);
+}  // extern "C"
+
+namespace {
+
+// Per-thread segregated free lists in front of mimalloc for the hottest Kotlin object
+// size classes (measured from instanceSize_ distributions). Blocks are zeroed when they
+// enter a list, off the allocation path; popping one only rewrites the word used as the
+// list link, which for Kotlin containers is the header word the caller rewrites anyway.
+constexpr size_t kSmallClassCount = 4;
+constexpr size_t kSmallClassSizes[kSmallClassCount] = {16, 24, 32, 48};
+constexpr size_t kMaxSmallSize = 48;
+// Caps per-thread retention at ~120KiB; blocks cached by an exiting thread are leaked.
+constexpr size_t kMaxCachedPerClass = 1024;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+__thread FreeBlock* smallFreeLists[kSmallClassCount];
+__thread size_t smallFreeCounts[kSmallClassCount];
+
+inline int smallClassIndex(size_t size) {
+  if (size <= 16) return 0;
+  if (size <= 24) return 1;
+  if (size <= 32) return 2;
+  if (size <= 48) return 3;
+  return -1;
+}
+
+// Only blocks whose usable size is exactly a class size are recycled, so every list
+// holds uniform blocks and the rounding done on allocation stays exact.
+inline int smallClassIndexExact(size_t usableSize) {
+  for (size_t i = 0; i < kSmallClassCount; i++) {
+    if (kSmallClassSizes[i] == usableSize) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+}  // namespace
+
+extern "C" {
 
 void* konan_calloc_impl(size_t n_elements, size_t elem_size) {
- return mi_calloc(n_elements, elem_size);
+  if (elem_size == 0 || n_elements <= kMaxSmallSize / elem_size) {
+    int index = smallClassIndex(n_elements * elem_size);
+    FreeBlock* block = smallFreeLists[index];
+    if (block != nullptr) {
+      smallFreeLists[index] = block->next;
+      smallFreeCounts[index]--;
+      // The rest of the block was zeroed when it entered the list.
+      block->next = nullptr;
+      return block;
+    }
+    // Round up to the class size, so the block lands back on this list when freed.
+    return mi_calloc(1, kSmallClassSizes[index]);
+  }
+  return mi_calloc(n_elements, elem_size);
 }
 
 void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment) {
   return mi_calloc_aligned(count, size, alignment);
 }
 
+void* konan_calloc_aligned_at_impl(size_t count, size_t size, size_t alignment, size_t offset) {
+  return mi_calloc_aligned_at(count, size, alignment, offset);
+}
+
+void* konan_malloc_impl(size_t size) {
+  // Bypasses the small-class lists: their blocks are already zeroed, so handing
+  // one out here would give up nothing, and freeing re-zeroes anyway.
+  return mi_malloc(size);
+}
+
+size_t konan_usable_size_impl(void* mem) {
+  return mi_usable_size(mem);
+}
+
 void konan_free_impl (void* mem) {
+  if (mem != nullptr) {
+    int index = smallClassIndexExact(mi_usable_size(mem));
+    if (index >= 0 && smallFreeCounts[index] < kMaxCachedPerClass) {
+      // Zero here, not on allocation: callers expect calloc semantics.
+      memset(mem, 0, kSmallClassSizes[index]);
+      auto* block = static_cast<FreeBlock*>(mem);
+      block->next = smallFreeLists[index];
+      smallFreeLists[index] = block;
+      smallFreeCounts[index]++;
+      return;
+    }
+  }
   mi_free(mem);
 }
+
+// Dedicated mimalloc heap per worker thread, so a worker's allocations can be
+// attributed to it and handed back to the allocator as a unit when it
+// terminates. The heap is deleted, not destroyed: runtime allocations
+// routinely outlive their worker (frozen objects, detached graphs, stable
+// pointers), so remaining pages migrate to the backing heap in O(pages)
+// instead of their blocks being freed blindly.
+
+namespace {
+
+__thread mi_heap_t* threadHeap = nullptr;
+
+bool addAreaUsed(const mi_heap_t*, const mi_heap_area_t* area, void*, size_t, void* arg) {
+  // In this mimalloc, area->used counts blocks, not bytes.
+  *static_cast<size_t*>(arg) += area->used * area->block_size;
+  return true;
+}
+
+}  // namespace
+
+void konan_thread_heap_init_impl() {
+  if (threadHeap != nullptr) return;
+  mi_heap_t* heap = mi_heap_new();
+  if (heap == nullptr) return;  // Keep going on the default heap.
+  threadHeap = heap;
+  mi_heap_set_default(heap);
+}
+
+void konan_thread_heap_deinit_impl() {
+  mi_heap_t* heap = threadHeap;
+  if (heap == nullptr) return;
+  threadHeap = nullptr;
+  mi_heap_set_default(mi_heap_get_backing());
+  // Blocks still cached in the small free lists above stay valid: deletion
+  // migrates their pages to the backing heap.
+  mi_heap_delete(heap);
+}
+
+size_t konan_thread_heap_used_impl() {
+  mi_heap_t* heap = threadHeap;
+  if (heap == nullptr) return 0;
+  size_t used = 0;
+  mi_heap_visit_blocks(heap, false, &addAreaUsed, &used);
+  return used;
+}
+
 }  // extern "C"
@@ -26,3 +26,283 @@ int lprofGetHostName(char *hostName, int length) {
 }
 
 #endif
+
+// Hooks for profile-guided optimization of the runtime itself. When the
+// runtime bitcode is built with -PruntimeProfileInstrument (see
+// runtime/build.gradle.kts), clang instruments every runtime function with
+// LLVM profile counters and the final binary links the compiler-rt profile
+// runtime. Each process then writes its counters to the file named by the
+// LLVM_PROFILE_FILE environment variable on exit; the calls below allow
+// flushing them explicitly, e.g. right after a warmed-up benchmark phase,
+// without waiting for exit. Merge the raw files with `llvm-profdata merge`,
+// inspect the hottest functions with `llvm-profdata show -topn`, and rebuild
+// with -PruntimeProfileData=<merged.profdata> to apply the profile.
+#ifdef KONAN_PGO_INSTRUMENT
+
+#include <stdint.h>
+
+// compiler-rt profile runtime, linked in by -fprofile-instr-generate.
+extern "C" void __llvm_profile_set_filename(const char* name);
+extern "C" int __llvm_profile_write_file(void);
+extern "C" void __llvm_profile_reset_counters(void);
+
+extern "C" {
+
+// Writes the accumulated counters to path (or the configured default when
+// path is null). Returns 0 on success.
+int Konan_Profiler_writeLLVMProfile(const char* path) {
+  if (path != nullptr) {
+    __llvm_profile_set_filename(path);
+  }
+  return __llvm_profile_write_file();
+}
+
+// Discards counters gathered so far, so a dump can cover only the steady
+// state and not the warm-up.
+void Konan_Profiler_resetLLVMProfile() {
+  __llvm_profile_reset_counters();
+}
+
+}  // extern "C"
+
+#endif  // KONAN_PGO_INSTRUMENT
+
+// A minimal signal-based sampling profiler. SIGPROF samples capture the frame
+// pointer chain (the unwinder is not async-signal-safe) and are aggregated in a
+// fixed-size lock-free hash table keyed by the call stack. The dump is written
+// in the legacy pprof CPU profile format with /proc/self/maps appended, so
+// `pprof` can symbolize Kotlin frames using the symbols the binary already has.
+//
+// Usage from cinterop or C glue:
+//   Konan_Profiler_start(intervalUs) / Konan_Profiler_stop() /
+//   Konan_Profiler_dump(path).
+#if !defined(KONAN_WINDOWS) && !defined(KONAN_WASM) && !defined(KONAN_ZEPHYR)
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include <atomic>
+
+namespace {
+
+constexpr int kMaxSampleFrames = 32;
+constexpr int kSampleTableSize = 4096;  // Power of two.
+constexpr int kMaxProbes = 16;
+
+// Stack frame layout shared by the System V x86-64 and AAPCS64 ABIs.
+struct FrameRecord {
+  FrameRecord* next;
+  void* returnAddress;
+};
+
+struct SampleEntry {
+  std::atomic<uintptr_t> hash;   // 0 means free.
+  std::atomic<uint64_t> count;
+  std::atomic<int> depth;        // 0 until frames[] is fully written.
+  uintptr_t frames[kMaxSampleFrames];
+};
+
+SampleEntry sampleTable[kSampleTableSize];
+std::atomic<bool> profilingActive(false);
+std::atomic<uint64_t> totalSamples(0);
+std::atomic<uint64_t> lostSamples(0);
+long samplePeriodUs = 0;
+struct sigaction previousSigprofAction;
+
+// Extracts the program counter and frame pointer of the interrupted thread
+// from the signal context, so the sample starts at the leaf function rather
+// than inside the handler. Returns false on targets where the register
+// layout is unknown.
+bool interruptedState(void* context, uintptr_t* pc, FrameRecord** fp) {
+  auto* ucontext = static_cast<ucontext_t*>(context);
+#if defined(__linux__) && defined(__x86_64__)
+  *pc = (uintptr_t)ucontext->uc_mcontext.gregs[REG_RIP];
+  *fp = reinterpret_cast<FrameRecord*>(ucontext->uc_mcontext.gregs[REG_RBP]);
+  return true;
+#elif defined(__linux__) && defined(__aarch64__)
+  *pc = (uintptr_t)ucontext->uc_mcontext.pc;
+  *fp = reinterpret_cast<FrameRecord*>(ucontext->uc_mcontext.regs[29]);
+  return true;
+#elif defined(__APPLE__) && defined(__x86_64__)
+  *pc = (uintptr_t)ucontext->uc_mcontext->__ss.__rip;
+  *fp = reinterpret_cast<FrameRecord*>(ucontext->uc_mcontext->__ss.__rbp);
+  return true;
+#elif defined(__APPLE__) && defined(__aarch64__)
+  *pc = (uintptr_t)ucontext->uc_mcontext->__ss.__pc;
+  *fp = reinterpret_cast<FrameRecord*>(ucontext->uc_mcontext->__ss.__fp);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Only touches the given stack chain and the locals: safe in a signal handler.
+int captureFrames(void* context, uintptr_t* frames, int maxFrames) {
+  uintptr_t leafPC;
+  FrameRecord* frame;
+  int count = 0;
+  if (interruptedState(context, &leafPC, &frame)) {
+    frames[count++] = leafPC;
+  } else {
+    // Unknown register layout; the handler frames below the signal trampoline
+    // are still better than nothing.
+    frame = reinterpret_cast<FrameRecord*>(__builtin_frame_address(0));
+  }
+  while (frame != nullptr && count < maxFrames) {
+    void* pc = frame->returnAddress;
+    if (pc == nullptr) break;
+    frames[count++] = reinterpret_cast<uintptr_t>(pc);
+    FrameRecord* next = frame->next;
+    if (next <= frame || (reinterpret_cast<uintptr_t>(next) & (sizeof(void*) - 1)) != 0) break;
+    frame = next;
+  }
+  return count;
+}
+
+uintptr_t hashFrames(const uintptr_t* frames, int depth) {
+  // FNV-1a over the PCs; 0 is reserved for free slots.
+  uintptr_t hash = 0xcbf29ce484222325ul;
+  for (int i = 0; i < depth; i++) {
+    hash = (hash ^ frames[i]) * 0x100000001b3ul;
+  }
+  return hash == 0 ? 1 : hash;
+}
+
+void sigprofHandler(int sig, siginfo_t* info, void* context) {
+  if (!profilingActive.load(std::memory_order_relaxed)) return;
+
+  uintptr_t frames[kMaxSampleFrames];
+  int depth = captureFrames(context, frames, kMaxSampleFrames);
+  if (depth == 0) return;
+  uintptr_t hash = hashFrames(frames, depth);
+  totalSamples.fetch_add(1, std::memory_order_relaxed);
+
+  for (int probe = 0; probe < kMaxProbes; probe++) {
+    SampleEntry* entry = &sampleTable[(hash + probe) & (kSampleTableSize - 1)];
+    uintptr_t seen = entry->hash.load(std::memory_order_acquire);
+    if (seen == hash) {
+      // Published entries only: an entry being written by another thread
+      // (depth still 0) is counted as lost rather than waited for.
+      if (entry->depth.load(std::memory_order_acquire) == depth &&
+          memcmp(entry->frames, frames, depth * sizeof(uintptr_t)) == 0) {
+        entry->count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      continue;  // Hash collision, keep probing.
+    }
+    if (seen == 0) {
+      uintptr_t expected = 0;
+      if (entry->hash.compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
+        memcpy(entry->frames, frames, depth * sizeof(uintptr_t));
+        entry->count.store(1, std::memory_order_relaxed);
+        entry->depth.store(depth, std::memory_order_release);
+        return;
+      }
+      // Lost the race; retry the same slot as a match or move on.
+      probe--;
+      continue;
+    }
+  }
+  lostSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+extern "C" {
+
+// Starts sampling every intervalUs microseconds of CPU time. Returns false if
+// the profiler is already running or the timer cannot be installed.
+bool Konan_Profiler_start(int intervalUs) {
+  if (profilingActive.load(std::memory_order_acquire)) return false;
+  if (intervalUs <= 0) return false;
+  memset(sampleTable, 0, sizeof(sampleTable));
+  totalSamples.store(0, std::memory_order_relaxed);
+  lostSamples.store(0, std::memory_order_relaxed);
+  samplePeriodUs = intervalUs;
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = sigprofHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &previousSigprofAction) != 0) return false;
+
+  profilingActive.store(true, std::memory_order_release);
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = intervalUs / 1000000;
+  timer.it_interval.tv_usec = intervalUs % 1000000;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    profilingActive.store(false, std::memory_order_release);
+    sigaction(SIGPROF, &previousSigprofAction, nullptr);
+    return false;
+  }
+  return true;
+}
+
+void Konan_Profiler_stop() {
+  if (!profilingActive.load(std::memory_order_acquire)) return;
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  profilingActive.store(false, std::memory_order_release);
+  sigaction(SIGPROF, &previousSigprofAction, nullptr);
+}
+
+// Writes the aggregated samples in the legacy pprof CPU profile format.
+// Call after Konan_Profiler_stop(). Returns the number of samples written,
+// or -1 if the file cannot be created.
+long Konan_Profiler_dump(const char* path) {
+  FILE* out = fopen(path, "wb");
+  if (out == nullptr) return -1;
+
+  // Header: count 0, header words 3, format version 0, sampling period in
+  // microseconds, padding 0.
+  uintptr_t header[5] = {0, 3, 0, (uintptr_t)samplePeriodUs, 0};
+  fwrite(header, sizeof(uintptr_t), 5, out);
+
+  long written = 0;
+  for (int i = 0; i < kSampleTableSize; i++) {
+    SampleEntry* entry = &sampleTable[i];
+    int depth = entry->depth.load(std::memory_order_acquire);
+    if (depth == 0) continue;
+    uintptr_t record[2] = {(uintptr_t)entry->count.load(std::memory_order_relaxed),
+                           (uintptr_t)depth};
+    fwrite(record, sizeof(uintptr_t), 2, out);
+    fwrite(entry->frames, sizeof(uintptr_t), depth, out);
+    written += (long)record[0];
+  }
+
+  uintptr_t trailer[3] = {0, 1, 0};
+  fwrite(trailer, sizeof(uintptr_t), 3, out);
+
+  // The mapping section lets pprof resolve addresses in shared libraries.
+  FILE* maps = fopen("/proc/self/maps", "r");
+  if (maps != nullptr) {
+    char buffer[4096];
+    size_t bytes;
+    while ((bytes = fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+      fwrite(buffer, 1, bytes, out);
+    }
+    fclose(maps);
+  }
+  fclose(out);
+  return written;
+}
+
+uint64_t Konan_Profiler_totalSamples() {
+  return totalSamples.load(std::memory_order_relaxed);
+}
+
+uint64_t Konan_Profiler_lostSamples() {
+  return lostSamples.load(std::memory_order_relaxed);
+}
+
+}  // extern "C"
+
+#endif  // !KONAN_WINDOWS && !KONAN_WASM && !KONAN_ZEPHYR
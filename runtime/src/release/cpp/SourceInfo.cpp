@@ -18,4 +18,9 @@
 
 struct SourceInfo Kotlin_getSourceInfo(void* addr) {
   return (SourceInfo) { .fileName = nullptr, .lineNumber = -1, .column = -1 };
+}
+
+void Kotlin_getSourceInfoBulk(void** addresses, int count, struct SourceInfo* results) {
+  for (int i = 0; i < count; i++)
+    results[i] = Kotlin_getSourceInfo(addresses[i]);
 }
\ No newline at end of file
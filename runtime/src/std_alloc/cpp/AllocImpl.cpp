@@ -16,8 +16,27 @@ void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment) {
   return calloc(count, size);
 }
 
+void* konan_calloc_aligned_at_impl(size_t count, size_t size, size_t alignment, size_t offset) {
+  // Offset alignment is not supported by std alloc - use mimalloc
+  return calloc(count, size);
+}
+
+void* konan_malloc_impl(size_t size) {
+  return malloc(size);
+}
+
+size_t konan_usable_size_impl(void* mem) {
+  // The system allocator has no portable usable-size query; report "unknown".
+  return 0;
+}
+
 void konan_free_impl (void* mem) {
   free(mem);
 }
+
+// The system allocator has no per-thread heap notion to attribute or reclaim.
+void konan_thread_heap_init_impl() {}
+void konan_thread_heap_deinit_impl() {}
+size_t konan_thread_heap_used_impl() { return 0; }
 }
 
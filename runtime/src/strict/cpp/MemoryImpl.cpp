@@ -19,6 +19,26 @@ OBJ_GETTER(AllocArrayInstance, const TypeInfo* typeInfo, int32_t elements) {
   RETURN_RESULT_OF(AllocArrayInstanceStrict, typeInfo, elements);
 }
 
+OBJ_GETTER(AllocArrayInstanceUninitialized, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(AllocArrayInstanceUninitializedStrict, typeInfo, elements);
+}
+
+OBJ_GETTER(AllocArrayInstanceAligned, const TypeInfo* typeInfo, int32_t elements, int32_t alignment) {
+  RETURN_RESULT_OF(AllocArrayInstanceAlignedStrict, typeInfo, elements, alignment);
+}
+
+OBJ_GETTER(AllocInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* typeInfo) {
+  RETURN_RESULT_OF(AllocInstanceInFrameStrict, auxSlot, typeInfo);
+}
+
+OBJ_GETTER(AllocArrayInstanceInFrame, ObjHeader** auxSlot, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(AllocArrayInstanceInFrameStrict, auxSlot, typeInfo, elements);
+}
+
+OBJ_GETTER(PromoteObjectToHeap, ObjHeader* object) {
+  RETURN_RESULT_OF(PromoteObjectToHeapStrict, object);
+}
+
 OBJ_GETTER(InitInstance,
     ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
   RETURN_RESULT_OF(InitInstanceStrict, location, typeInfo, ctor);
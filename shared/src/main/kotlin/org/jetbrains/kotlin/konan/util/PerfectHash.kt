@@ -0,0 +1,86 @@
+package org.jetbrains.kotlin.konan.util
+
+/**
+ * Result of [buildPerfectHash].
+ *
+ * [displacements] has one entry per bucket. A non-negative entry `d` places the
+ * bucket's keys at `(low32(hash) + d * (high32(hash) or 1)) mod slotToKey.size`
+ * (32-bit wrapping arithmetic); a negative entry `-slot - 1` places the bucket's
+ * single key directly at `slot`. [slotToKey] maps every table slot back to the index
+ * of the key occupying it, so consumers can keep their payload arrays in any order.
+ */
+class PerfectHashTable(val displacements: IntArray, val slotToKey: IntArray)
+
+private fun bucketOf(hash: Long, bucketCount: Int): Int =
+        ((hash and 0xFFFFFFFFL) % bucketCount).toInt()
+
+// The low half of the hash positions the key, the high half (forced odd) is its
+// displacement step; the halves must be independent or same-bucket keys can be
+// permanently inseparable. Mixing deliberately wraps like uint32_t arithmetic:
+// lookup code in C mirrors this expression verbatim (see findAdapterByName in
+// ObjCExport.mm).
+private fun slotOf(hash: Long, displacement: Int, slotCount: Int): Int {
+    val mixed = hash.toInt() + displacement * ((hash ushr 32).toInt() or 1)
+    return ((mixed.toLong() and 0xFFFFFFFFL) % slotCount).toInt()
+}
+
+/**
+ * Builds a minimal perfect hash table over precomputed 64-bit key hashes using the
+ * "hash, displace and compress" construction: keys fall into `keyCount / 2` buckets
+ * by hash, the largest buckets pick a displacement moving all their keys into free
+ * slots, and single-key buckets take the leftover slots directly. Lookup is one
+ * displacement read, one slot read and one payload comparison, with no probing.
+ *
+ * Returns null when the table cannot be built - two keys share a full 64-bit hash
+ * (no displacement can separate them), or the displacement search fails. Callers
+ * are expected to fall back to a non-perfect scheme in that case.
+ */
+fun buildPerfectHash(hashes: LongArray): PerfectHashTable? {
+    val slotCount = hashes.size
+    if (slotCount == 0) return PerfectHashTable(IntArray(0), IntArray(0))
+    if (hashes.distinct().size != slotCount) return null
+
+    val bucketCount = (slotCount + 1) / 2
+    val buckets = Array(bucketCount) { mutableListOf<Int>() }
+    for (index in hashes.indices) {
+        buckets[bucketOf(hashes[index], bucketCount)].add(index)
+    }
+
+    val displacements = IntArray(bucketCount)
+    val slotToKey = IntArray(slotCount) { -1 }
+    val singletons = mutableListOf<Int>()
+
+    for (bucket in buckets.indices.sortedByDescending { buckets[it].size }) {
+        val keys = buckets[bucket]
+        when {
+            keys.isEmpty() -> {}
+            keys.size == 1 -> singletons.add(bucket)
+            else -> {
+                val limit = slotCount * 16 + 256
+                var displacement = 0
+                while (displacement < limit) {
+                    val slots = keys.map { slotOf(hashes[it], displacement, slotCount) }
+                    if (slots.distinct().size == keys.size && slots.all { slotToKey[it] < 0 }) {
+                        keys.zip(slots).forEach { (key, slot) -> slotToKey[slot] = key }
+                        displacements[bucket] = displacement
+                        break
+                    }
+                    displacement++
+                }
+                if (displacement == limit) return null
+            }
+        }
+    }
+
+    // Single-key buckets take the remaining slots directly, encoded as -slot - 1;
+    // this is what makes the table minimal without long displacement searches.
+    var nextFree = 0
+    for (bucket in singletons) {
+        while (slotToKey[nextFree] >= 0) nextFree++
+        slotToKey[nextFree] = buckets[bucket].single()
+        displacements[bucket] = -nextFree - 1
+        nextFree++
+    }
+
+    return PerfectHashTable(displacements, slotToKey)
+}